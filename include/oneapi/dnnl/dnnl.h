@@ -314,6 +314,97 @@ dnnl_status_t DNNL_API dnnl_primitive_attr_get_scratchpad_mode(
 dnnl_status_t DNNL_API dnnl_primitive_attr_set_scratchpad_mode(
         dnnl_primitive_attr_t attr, dnnl_scratchpad_mode_t mode);
 
+/// Returns the primitive attributes scratchpad limit.
+///
+/// @param attr Primitive attributes.
+/// @param limit Output scratchpad limit in bytes. Zero means no limit.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_scratchpad_limit(
+        const_dnnl_primitive_attr_t attr, size_t *limit);
+
+/// Sets primitive attributes scratchpad limit. The limit is a hint: the
+/// library prefers implementations whose scratchpad does not exceed the given
+/// amount of memory, for instance by processing the problem in smaller
+/// pieces. Primitives that cannot reduce their scratchpad ignore the limit.
+///
+/// @param attr Primitive attributes.
+/// @param limit Scratchpad limit in bytes. Zero (default) means no limit.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_scratchpad_limit(
+        dnnl_primitive_attr_t attr, size_t limit);
+
+/// Returns the destination statistics primitive attribute.
+///
+/// @param attr Primitive attributes.
+/// @param value Output value: a non-zero value means that the primitive
+///     computes per-channel sums and sums of squares of the destination tensor.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_dst_stats(
+        const_dnnl_primitive_attr_t attr, int *value);
+
+/// Sets the destination statistics primitive attribute. When set, the
+/// primitive computes per-channel sums and sums of squares of the destination
+/// tensor and stores them to the memory passed at execution time as an
+/// argument with index #DNNL_ARG_ATTR_DST_STATS. Only convolution forward
+/// propagation and matrix multiplication support the attribute.
+///
+/// @param attr Primitive attributes.
+/// @param value Attribute value: zero (default) or non-zero.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_dst_stats(
+        dnnl_primitive_attr_t attr, int value);
+
+/// Returns the source pre-scale factor primitive attribute.
+///
+/// @param attr Primitive attributes.
+/// @param scale Output source pre-scale factor.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_src_prescale(
+        const_dnnl_primitive_attr_t attr, float *scale);
+
+/// Sets the source pre-scale factor primitive attribute. The source tensor is
+/// multiplied by the factor before the primitive operation is applied. Only
+/// softmax forward propagation supports the attribute.
+///
+/// @param attr Primitive attributes.
+/// @param scale Source pre-scale factor. The default value is 1.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_src_prescale(
+        dnnl_primitive_attr_t attr, float scale);
+
+/// Returns the source mask primitive attribute.
+///
+/// @param attr Primitive attributes.
+/// @param mask_desc Output memory descriptor of the additive source mask. A
+///     zero memory descriptor is returned if the mask is not set.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_src_mask(
+        const_dnnl_primitive_attr_t attr, const_dnnl_memory_desc_t *mask_desc);
+
+/// Sets the source mask primitive attribute. The mask is added to the source
+/// tensor after the pre-scale factor is applied and before the primitive
+/// operation. The mask must have the same number of dimensions as the source
+/// tensor and each of its dimensions must either match the source one or be
+/// equal to 1, in which case the mask is broadcast along it. The mask is
+/// passed at execution time as an argument with index
+/// #DNNL_ARG_ATTR_SRC_MASK. Only softmax forward propagation supports the
+/// attribute.
+///
+/// @param attr Primitive attributes.
+/// @param mask_desc Memory descriptor of the mask. Passing a zero memory
+///     descriptor or NULL resets the mask.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_src_mask(
+        dnnl_primitive_attr_t attr, const_dnnl_memory_desc_t mask_desc);
+
 /// Sets primitive attributes scaling factors for primitive operations for a
 /// given memory argument. The scaling factors must be passed at execution time
 /// as an argument with index #DNNL_ARG_ATTR_SCALES | arg.
@@ -1111,6 +1202,37 @@ dnnl_status_t DNNL_API dnnl_binary_primitive_desc_create(
         const_dnnl_memory_desc_t src1_desc, const_dnnl_memory_desc_t dst_desc,
         const_dnnl_primitive_attr_t attr);
 
+/// Creates a primitive descriptor for a binary primitive with an optional
+/// third source, which is required by the select algorithm.
+///
+/// @note
+///     Memory descriptors @p src1_desc, @p src2_desc and @p dst_desc are
+///     alloweded to be initialized with #dnnl_format_tag_any or with
+///     format_kind set to #dnnl_format_kind_any.
+///
+/// @note
+///     All memory descriptors must have the same number of dimensions.
+///     For #dnnl_binary_select, every source may be broadcast along the
+///     dimensions where its size is equal to 1.
+///
+/// @param primitive_desc Output primitive descriptor.
+/// @param engine Engine to use.
+/// @param alg_kind Algorithm kind. Valid values are the values accepted by
+///     #dnnl_binary_primitive_desc_create and #dnnl_binary_select.
+/// @param src0_desc Source 0 memory descriptor.
+/// @param src1_desc Source 1 memory descriptor.
+/// @param src2_desc Source 2 memory descriptor holding the select condition.
+///     Must be NULL or a zero memory descriptor for all other algorithms.
+/// @param dst_desc Destination memory descriptor.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_binary_primitive_desc_create_v2(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_alg_kind_t alg_kind, const_dnnl_memory_desc_t src0_desc,
+        const_dnnl_memory_desc_t src1_desc, const_dnnl_memory_desc_t src2_desc,
+        const_dnnl_memory_desc_t dst_desc, const_dnnl_primitive_attr_t attr);
+
 /// @} dnnl_api_binary
 
 /// @addtogroup dnnl_api_convolution
@@ -1860,6 +1982,68 @@ dnnl_status_t DNNL_API dnnl_layer_normalization_backward_primitive_desc_create(
 
 /// @} dnnl_api_layer_normalization
 
+/// @addtogroup dnnl_api_group_normalization
+/// @{
+
+/// Creates a primitive descriptor for a group normalization forward propagation
+///     primitive.
+///
+/// @note
+///     In-place operation is supported: the dst can refer to the same memory
+///     as the src.
+///
+/// @param primitive_desc Output primitive_descriptor.
+/// @param engine Engine to use.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_forward_training and #dnnl_forward_inference.
+/// @param src_desc Source memory descriptor.
+/// @param dst_desc Destination memory descriptor.
+/// @param groups Group normalization groups parameter. The channel dimension
+///     must be divisible by it.
+/// @param epsilon Group normalization epsilon parameter.
+/// @param flags Group normalization flags (@ref dnnl_normalization_flags_t).
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_group_normalization_forward_primitive_desc_create(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_prop_kind_t prop_kind, const_dnnl_memory_desc_t src_desc,
+        const_dnnl_memory_desc_t dst_desc, dnnl_dim_t groups, float epsilon,
+        unsigned flags, const_dnnl_primitive_attr_t attr);
+
+/// Creates a primitive descriptor for a group normalization backward
+///     propagation primitive.
+///
+/// @note
+///     In-place operation is supported: the diff_dst can refer to the same
+///     memory as the diff_src.
+///
+/// @param primitive_desc Output primitive_descriptor.
+/// @param engine Engine to use.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_backward_data and #dnnl_backward (diffs for all parameters are
+///     computed in this case).
+/// @param diff_src_desc Diff source memory descriptor.
+/// @param diff_dst_desc Diff destination memory descriptor.
+/// @param src_desc Source memory descriptor.
+/// @param groups Group normalization groups parameter.
+/// @param epsilon Group normalization epsilon parameter.
+/// @param flags Group normalization flags (@ref dnnl_normalization_flags_t).
+/// @param hint_fwd_pd Primitive descriptor for a respective forward propagation
+///     primitive.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_group_normalization_backward_primitive_desc_create(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_prop_kind_t prop_kind, const_dnnl_memory_desc_t diff_src_desc,
+        const_dnnl_memory_desc_t diff_dst_desc,
+        const_dnnl_memory_desc_t src_desc, dnnl_dim_t groups, float epsilon,
+        unsigned flags, const_dnnl_primitive_desc_t hint_fwd_pd,
+        const_dnnl_primitive_attr_t attr);
+
+/// @} dnnl_api_group_normalization
+
 /// @addtogroup dnnl_api_inner_product
 /// @{
 
@@ -2994,6 +3178,41 @@ dnnl_status_t DNNL_API dnnl_reduction_primitive_desc_create(
 
 /// @} dnnl_api_reduction
 
+/// @addtogroup dnnl_api_embedding_bag Embedding Bag
+/// @{
+
+/// Creates a primitive descriptor for an embedding bag primitive.
+///
+/// @note
+///     Destination, indices, offsets and weights memory descriptors are
+///     allowed to be initialized with #dnnl_format_tag_any or with
+///     format_kind set to #dnnl_format_kind_any.
+///
+/// @param primitive_desc Output primitive descriptor.
+/// @param engine Engine to use.
+/// @param alg_kind Embedding bag algorithm kind. Possible values:
+///     #dnnl_embedding_bag_sum, #dnnl_embedding_bag_mean,
+///     #dnnl_embedding_bag_max.
+/// @param src_desc Embedding table memory descriptor.
+/// @param indices_desc Indices memory descriptor.
+/// @param offsets_desc Offsets memory descriptor. Bag `b` pools the rows
+///     referred to by indices from `offsets[b]` up to `offsets[b + 1]`.
+/// @param weights_desc Per-sample weights memory descriptor (can be NULL).
+///     Only supported with #dnnl_embedding_bag_sum.
+/// @param dst_desc Destination memory descriptor.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_embedding_bag_primitive_desc_create(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_alg_kind_t alg_kind, const_dnnl_memory_desc_t src_desc,
+        const_dnnl_memory_desc_t indices_desc,
+        const_dnnl_memory_desc_t offsets_desc,
+        const_dnnl_memory_desc_t weights_desc,
+        const_dnnl_memory_desc_t dst_desc, const_dnnl_primitive_attr_t attr);
+
+/// @} dnnl_api_embedding_bag
+
 /// @} dnnl_api_primitives
 
 /// @addtogroup dnnl_api_primitive_cache
@@ -146,6 +146,10 @@ struct primitive : public handle<dnnl_primitive_t> {
         softmax = dnnl_softmax,
         /// A layer normalization primitive.
         layer_normalization = dnnl_layer_normalization,
+        /// A group normalization primitive.
+        group_normalization = dnnl_group_normalization,
+        /// An embedding bag primitive.
+        embedding_bag = dnnl_embedding_bag,
     };
 
     using handle::handle;
@@ -451,6 +455,8 @@ enum class algorithm {
     binary_eq = dnnl_binary_eq,
     /// Binary not equal
     binary_ne = dnnl_binary_ne,
+    /// Binary select
+    binary_select = dnnl_binary_select,
     /// Nearest Neighbor resampling method
     resampling_nearest = dnnl_resampling_nearest,
     /// Linear (Bilinear, Trilinear) resampling method
@@ -477,6 +483,12 @@ enum class algorithm {
     softmax_accurate = dnnl_softmax_accurate,
     /// LogSoftmax, numerically stable
     softmax_log = dnnl_softmax_log,
+    /// Embedding bag using sum operation
+    embedding_bag_sum = dnnl_embedding_bag_sum,
+    /// Embedding bag using mean operation
+    embedding_bag_mean = dnnl_embedding_bag_mean,
+    /// Embedding bag using max operation
+    embedding_bag_max = dnnl_embedding_bag_max,
 };
 
 /// Converts algorithm kind enum value from C++ API to C API type.
@@ -528,6 +540,34 @@ enum class normalization_flags : unsigned {
     /// On training, normalization will require the workspace to implement
     /// backward propagation. On inference, the workspace is not required.
     fuse_norm_add_relu = dnnl_fuse_norm_add_relu,
+
+    /// Use precomputed sums. If specified, the user is expected to pass
+    /// per-channel sums and sums of squares of the source tensor as an input
+    /// with index #DNNL_ARG_ATTR_DST_STATS on forward propagation, and the
+    /// library derives mean and variance from them instead of reading the
+    /// source tensor. Cannot be combined with
+    /// #dnnl::normalization_flags::use_global_stats.
+    use_precomputed_sums = dnnl_use_precomputed_sums,
+
+    /// Use root mean square normalization. If specified, the mean is not
+    /// subtracted and the variance is replaced with the mean of squares of
+    /// the source tensor. The mean is not used. Supported only by layer
+    /// normalization.
+    rms_norm = dnnl_rms_norm,
+
+    /// Fuse normalization with a residual Add. If specified, the user is
+    /// expected to pass a tensor with index #DNNL_ARG_SRC_1 that is added to
+    /// the source before normalization; the sum is stored to the tensor with
+    /// index #DNNL_ARG_DST_1 if one is passed. Supported only by layer
+    /// normalization forward propagation.
+    fuse_residual_add = dnnl_fuse_residual_add,
+
+    /// Compute mean and variance in a single pass over the source tensor
+    /// using Welford's algorithm with pairwise merges of partial results.
+    /// Supported only by batch normalization forward propagation. Cannot be
+    /// combined with #dnnl::normalization_flags::use_global_stats or
+    /// #dnnl::normalization_flags::use_precomputed_sums.
+    welford_stats = dnnl_welford_stats,
 };
 
 /// Converts normalization flags enum value from C++ API to C API type.
@@ -545,7 +585,10 @@ inline dnnl_normalization_flags_t convert_to_c(normalization_flags flags) {
 /// RNN cell flags.
 enum class rnn_flags : unsigned {
     /// Undefined RNN flags
-    undef = dnnl_rnn_flags_undef
+    undef = dnnl_rnn_flags_undef,
+    /// Stateful (streaming) execution: hidden and cell states are kept in
+    /// the workspace between executions.
+    stateful = dnnl_rnn_flags_stateful
 };
 
 /// Converts RNN cell flags enum value from C++ API to C API type.
@@ -673,6 +716,8 @@ enum class query {
     kernel = dnnl_query_kernel,
     /// Shuffle parameter group size
     group_size_s64 = dnnl_query_group_size_s64,
+    /// Group normalization parameter number of groups
+    num_groups_s64 = dnnl_query_num_groups_s64,
 
     /// source memory desc
     src_md = dnnl_query_src_md,
@@ -3234,6 +3279,66 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
                 "could not set fpmath mode primitive attribute");
     }
 
+    /// Returns whether the primitive computes destination statistics.
+    bool get_dst_stats() const {
+        int result;
+        error::wrap_c_api(dnnl_primitive_attr_get_dst_stats(get(), &result),
+                "could not get dst stats primitive attribute");
+        return result;
+    }
+
+    /// Sets the destination statistics attribute. When set, the primitive
+    /// computes per-channel sums and sums of squares of the destination
+    /// tensor and stores them to the memory passed at execution time as an
+    /// argument with index #DNNL_ARG_ATTR_DST_STATS.
+    ///
+    /// @param value Specified attribute value.
+    void set_dst_stats(bool value) {
+        error::wrap_c_api(dnnl_primitive_attr_set_dst_stats(get(), value),
+                "could not set dst stats primitive attribute");
+    }
+
+    /// Returns the source pre-scale factor.
+    float get_src_prescale() const {
+        float result;
+        error::wrap_c_api(dnnl_primitive_attr_get_src_prescale(get(), &result),
+                "could not get src prescale primitive attribute");
+        return result;
+    }
+
+    /// Sets the source pre-scale factor. The source tensor is multiplied by
+    /// the factor before the primitive operation is applied.
+    ///
+    /// @param scale Source pre-scale factor.
+    void set_src_prescale(float scale) {
+        error::wrap_c_api(dnnl_primitive_attr_set_src_prescale(get(), scale),
+                "could not set src prescale primitive attribute");
+    }
+
+    /// Returns the memory descriptor of the additive source mask. The
+    /// descriptor is a zero one if the mask is not set.
+    memory::desc get_src_mask() const {
+        const_dnnl_memory_desc_t cdesc;
+        error::wrap_c_api(dnnl_primitive_attr_get_src_mask(get(), &cdesc),
+                "could not get src mask primitive attribute");
+        dnnl_memory_desc_t cloned_md = nullptr;
+        error::wrap_c_api(dnnl_memory_desc_clone(&cloned_md, cdesc),
+                "could not clone a memory descriptor");
+        return memory::desc(cloned_md);
+    }
+
+    /// Sets the additive source mask. The mask is added to the pre-scaled
+    /// source tensor and is broadcast along its dimensions equal to 1. The
+    /// mask is passed at execution time as an argument with index
+    /// #DNNL_ARG_ATTR_SRC_MASK.
+    ///
+    /// @param mask_desc Memory descriptor of the mask.
+    void set_src_mask(const memory::desc &mask_desc) {
+        error::wrap_c_api(
+                dnnl_primitive_attr_set_src_mask(get(), mask_desc.get(true)),
+                "could not set src mask primitive attribute");
+    }
+
     /// Returns the scratchpad mode.
     scratchpad_mode get_scratchpad_mode() const {
         dnnl_scratchpad_mode_t result;
@@ -3252,6 +3357,26 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
                 "could not set scratchpad mode primitive attribute");
     }
 
+    /// Returns the scratchpad limit in bytes. Zero means no limit.
+    size_t get_scratchpad_limit() const {
+        size_t result;
+        error::wrap_c_api(
+                dnnl_primitive_attr_get_scratchpad_limit(get(), &result),
+                "could not get scratchpad limit primitive attribute");
+        return result;
+    }
+
+    /// Sets the scratchpad limit. The limit is a hint: the library prefers
+    /// implementations whose scratchpad does not exceed the given amount of
+    /// memory. Primitives that cannot reduce their scratchpad ignore it.
+    ///
+    /// @param limit Scratchpad limit in bytes. Zero means no limit.
+    void set_scratchpad_limit(size_t limit) {
+        error::wrap_c_api(
+                dnnl_primitive_attr_set_scratchpad_limit(get(), limit),
+                "could not set scratchpad limit primitive attribute");
+    }
+
     /// Sets scaling factors for primitive operations for a given memory
     /// argument. The scaling factors must be passed at execution time
     /// as an argument with index #DNNL_ARG_ATTR_SCALES | arg.
@@ -7476,6 +7601,284 @@ struct layer_normalization_backward : public primitive {
 
 /// @} dnnl_api_layer_normalization
 
+/// @addtogroup dnnl_api_group_normalization Group Normalization
+///
+/// A primitive to perform group normalization. Channels are split into groups
+/// of equal size and normalization is performed over every group and all
+/// spatial dimensions of each image.
+///
+/// Both forward and backward propagation primitives support in-place
+/// operation; that is, src and dst can refer to the same memory for forward
+/// propagation, and diff_dst and diff_src can refer to the same memory for
+/// backward propagation.
+///
+/// The group normalization primitives computations can be controlled by
+/// specifying different @ref dnnl::normalization_flags values.
+///
+/// @sa @ref dev_guide_group_normalization in developer guide
+///
+/// @{
+
+/// Group normalization forward propagation primitive.
+struct group_normalization_forward : public primitive {
+    /// Primitive descriptor for a group normalization forward propagation
+    /// primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for a group normalization forward
+        /// propagation primitive.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param src_desc Source memory descriptor.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param groups Group normalization groups parameter.
+        /// @param epsilon Group normalization epsilon parameter.
+        /// @param flags Group normalization flags (@ref
+        ///     dnnl::normalization_flags).
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                const memory::desc &src_desc, const memory::desc &dst_desc,
+                memory::dim groups, float epsilon, normalization_flags flags,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status
+                    = dnnl_group_normalization_forward_primitive_desc_create(
+                            &pd, aengine.get(), dnnl::convert_to_c(aprop_kind),
+                            src_desc.get(), dst_desc.get(), groups, epsilon,
+                            convert_to_c(flags), attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for a group "
+                        "normalization forward propagation primitive");
+            reset(pd);
+        }
+
+        /// Constructs a primitive descriptor for a group normalization
+        /// forward propagation primitive from a C API primitive descriptor
+        /// that must have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for a group normalization
+        ///     forward propagation primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd,
+                    dnnl::primitive::kind::group_normalization,
+                    dnnl::prop_kind::forward_training,
+                    dnnl::prop_kind::forward_inference) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::weights_desc()const
+        memory::desc weights_desc() const { return base::weights_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::workspace_desc()const
+        memory::desc workspace_desc() const { return base::workspace_desc(); }
+
+        /// @copydoc dnnl::batch_normalization_forward::primitive_desc::mean_desc()const
+        memory::desc mean_desc() const { return stat_desc(mean); }
+
+        /// @copydoc dnnl::batch_normalization_forward::primitive_desc::variance_desc()const
+        memory::desc variance_desc() const { return stat_desc(var); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_prop_kind()const
+        dnnl::prop_kind get_prop_kind() const { return base::get_prop_kind(); }
+
+        /// Returns the number of groups.
+        /// @return Number of groups.
+        memory::dim get_groups() const {
+            return base::query_s64(query::num_groups_s64);
+        }
+
+        /// @copydoc dnnl::primitive_desc_base::get_epsilon()const
+        float get_epsilon() const { return base::get_epsilon(); }
+
+        /// Returns normalization flags.
+        /// @return Normalization flags.
+        normalization_flags get_flags() const {
+            return base::get_flags<normalization_flags>();
+        }
+
+    private:
+        enum {
+            mean = 1,
+            var = 2,
+        };
+        memory::desc stat_desc(int kind) const {
+            const bool use_global_stats
+                    = (get_flags() & normalization_flags::use_global_stats)
+                    != normalization_flags::none;
+            return query_md(
+                    use_global_stats ? query::src_md : query::dst_md, kind);
+        }
+    };
+
+    /// Default constructor. Produces an empty object.
+    group_normalization_forward() = default;
+
+    /// Constructs a group normalization forward propagation primitive.
+    /// @param pd Primitive descriptor for a group normalization forward
+    ///     propagation primitive.
+    group_normalization_forward(const primitive_desc &pd) : primitive(pd) {}
+
+    /// Constructs a group normalization forward propagation primitive from
+    ///     a cache blob.
+    /// @param pd Primitive descriptor for a group normalization forward
+    ///     propagation primitive.
+    /// @param cache_blob Cache blob.
+    group_normalization_forward(
+            const primitive_desc &pd, const std::vector<uint8_t> &cache_blob)
+        : primitive(pd, cache_blob) {}
+};
+
+/// Group normalization backward propagation primitive.
+struct group_normalization_backward : public primitive {
+    /// Primitive descriptor for a group normalization backward propagation
+    /// primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for a group normalization backward
+        /// propagation primitive.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::backward_data and #dnnl::prop_kind::backward
+        ///     (diffs for all parameters are computed in this case).
+        /// @param diff_src_desc Diff source memory descriptor.
+        /// @param diff_dst_desc Diff destination memory descriptor.
+        /// @param src_desc Source memory descriptor.
+        /// @param groups Group normalization groups parameter.
+        /// @param epsilon Group normalization epsilon parameter.
+        /// @param flags Group normalization flags (@ref
+        ///     dnnl::normalization_flags).
+        /// @param hint_fwd_pd Primitive descriptor for a group normalization
+        ///     forward propagation primitive. It is used as a hint for
+        ///     deciding which memory format to use.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                const memory::desc &diff_src_desc,
+                const memory::desc &diff_dst_desc, const memory::desc &src_desc,
+                memory::dim groups, float epsilon, normalization_flags flags,
+                const group_normalization_forward::primitive_desc &hint_fwd_pd,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status
+                    = dnnl_group_normalization_backward_primitive_desc_create(
+                            &pd, aengine.get(), dnnl::convert_to_c(aprop_kind),
+                            diff_src_desc.get(), diff_dst_desc.get(),
+                            src_desc.get(), groups, epsilon,
+                            convert_to_c(flags), hint_fwd_pd.get(), attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for a group "
+                        "normalization backward propagation primitive");
+            reset(pd);
+        }
+
+        /// Constructs a primitive descriptor for a group normalization
+        /// backward propagation primitive from a C API primitive descriptor
+        /// that must have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for a group normalization
+        ///     backward propagation primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd,
+                    dnnl::primitive::kind::group_normalization,
+                    dnnl::prop_kind::backward, dnnl::prop_kind::backward_data) {
+        }
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::weights_desc()const
+        memory::desc weights_desc() const { return base::weights_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::diff_src_desc()const
+        memory::desc diff_src_desc() const { return base::diff_src_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::diff_dst_desc()const
+        memory::desc diff_dst_desc() const { return base::diff_dst_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::diff_weights_desc()const
+        memory::desc diff_weights_desc() const {
+            return base::diff_weights_desc(0);
+        }
+
+        /// @copydoc dnnl::batch_normalization_forward::primitive_desc::mean_desc()const
+        memory::desc mean_desc() const { return query_md(query::src_md, 1); }
+
+        /// @copydoc dnnl::batch_normalization_forward::primitive_desc::variance_desc()const
+        memory::desc variance_desc() const {
+            return query_md(query::src_md, 2);
+        }
+
+        /// @copydoc dnnl::primitive_desc_base::workspace_desc()const
+        memory::desc workspace_desc() const { return base::workspace_desc(); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_prop_kind()const
+        dnnl::prop_kind get_prop_kind() const { return base::get_prop_kind(); }
+
+        /// @copydoc dnnl::group_normalization_forward::primitive_desc::get_groups()const
+        memory::dim get_groups() const {
+            return base::query_s64(query::num_groups_s64);
+        }
+
+        /// @copydoc dnnl::primitive_desc_base::get_epsilon()const
+        float get_epsilon() const { return base::get_epsilon(); }
+
+        /// Returns normalization flags.
+        /// @return Normalization flags.
+        normalization_flags get_flags() const {
+            return base::get_flags<normalization_flags>();
+        }
+    };
+
+    /// Default constructor. Produces an empty object.
+    group_normalization_backward() = default;
+
+    /// Constructs a group normalization backward propagation primitive.
+    /// @param pd Primitive descriptor for a group normalization backward
+    ///     propagation primitive.
+    group_normalization_backward(const primitive_desc &pd) : primitive(pd) {}
+
+    /// Constructs a group normalization backward propagation primitive from
+    ///     a cache blob.
+    /// @param pd Primitive descriptor for a group normalization backward
+    ///     propagation primitive.
+    /// @param cache_blob Cache blob.
+    group_normalization_backward(
+            const primitive_desc &pd, const std::vector<uint8_t> &cache_blob)
+        : primitive(pd, cache_blob) {}
+};
+
+/// @} dnnl_api_group_normalization
+
 /// @addtogroup dnnl_api_inner_product Inner Product
 ///
 /// A primitive to compute an inner product.
@@ -9066,6 +9469,49 @@ struct lstm_forward : public primitive {
                     bias_desc, dst_layer_desc, dst_iter_desc, &dst_iter_c_desc,
                     rnn_flags::undef, 0.0f, 0.0f, attr, allow_empty) {}
 
+        /// Constructs a primitive descriptor for a stateful LSTM forward
+        ///     propagation primitive.
+        ///
+        /// The recurrent hidden and cell states are not passed explicitly.
+        /// They are kept in the workspace between executions instead, so
+        /// that each execution continues the sequences from where the
+        /// previous one stopped. The workspace must be zero-initialized to
+        /// start new sequences.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. The only possible value is
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param direction RNN direction. The only possible value is
+        ///     #dnnl::rnn_direction::unidirectional_left2right.
+        /// @param src_layer_desc Memory descriptor for the input vector.
+        /// @param weights_layer_desc Memory descriptor for the weights
+        ///     applied to the layer input.
+        /// @param weights_iter_desc Memory descriptor for the weights applied
+        ///     to the recurrent input.
+        /// @param bias_desc Bias memory descriptor.
+        /// @param dst_layer_desc Memory descriptor for the output vector.
+        /// @param flags RNN cell flags. Must be #dnnl::rnn_flags::stateful.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                rnn_direction direction, const memory::desc &src_layer_desc,
+                const memory::desc &weights_layer_desc,
+                const memory::desc &weights_iter_desc,
+                const memory::desc &bias_desc,
+                const memory::desc &dst_layer_desc, rnn_flags flags,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false)
+            : rnn_primitive_desc_base(aengine, algorithm::vanilla_lstm,
+                    aprop_kind, algorithm::undef, direction, src_layer_desc,
+                    memory::desc(), nullptr, nullptr, weights_layer_desc,
+                    weights_iter_desc, nullptr, nullptr, bias_desc,
+                    dst_layer_desc, memory::desc(), nullptr, flags, 0.0f,
+                    0.0f, attr, allow_empty) {}
+
         /// Constructs a primitive descriptor for an LSTM forward propagation
         /// primitive from a C API primitive descriptor that must have a
         /// matching kind.
@@ -9706,6 +10152,48 @@ struct gru_forward : public primitive {
                     dst_layer_desc, dst_iter_desc, nullptr, rnn_flags::undef,
                     0.0f, 0.0f, attr, allow_empty) {}
 
+        /// Constructs a primitive descriptor for a stateful GRU forward
+        ///     propagation primitive.
+        ///
+        /// The recurrent hidden state is not passed explicitly. It is kept in
+        /// the workspace between executions instead, so that each execution
+        /// continues the sequences from where the previous one stopped. The
+        /// workspace must be zero-initialized to start new sequences.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. The only possible value is
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param direction RNN direction. The only possible value is
+        ///     #dnnl::rnn_direction::unidirectional_left2right.
+        /// @param src_layer_desc Memory descriptor for the input vector.
+        /// @param weights_layer_desc Memory descriptor for the weights
+        ///     applied to the layer input.
+        /// @param weights_iter_desc Memory descriptor for the weights applied
+        ///     to the recurrent input.
+        /// @param bias_desc Bias memory descriptor.
+        /// @param dst_layer_desc Memory descriptor for the output vector.
+        /// @param flags RNN cell flags. Must be #dnnl::rnn_flags::stateful.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                rnn_direction direction, const memory::desc &src_layer_desc,
+                const memory::desc &weights_layer_desc,
+                const memory::desc &weights_iter_desc,
+                const memory::desc &bias_desc,
+                const memory::desc &dst_layer_desc, rnn_flags flags,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false)
+            : rnn_primitive_desc_base(aengine, algorithm::vanilla_gru,
+                    aprop_kind, algorithm::undef, direction, src_layer_desc,
+                    memory::desc(), nullptr, nullptr, weights_layer_desc,
+                    weights_iter_desc, nullptr, nullptr, bias_desc,
+                    dst_layer_desc, memory::desc(), nullptr, flags, 0.0f,
+                    0.0f, attr, allow_empty) {}
+
         /// Constructs a primitive descriptor for a GRU forward propagation
         /// primitive from a C API primitive descriptor that must have a
         /// matching kind.
@@ -10037,6 +10525,48 @@ struct lbr_gru_forward : public primitive {
                     nullptr, nullptr, bias_desc, dst_layer_desc, dst_iter_desc,
                     nullptr, rnn_flags::undef, 0.0f, 0.0f, attr, allow_empty) {}
 
+        /// Constructs a primitive descriptor for a stateful LBR GRU
+        ///     forward propagation primitive.
+        ///
+        /// The recurrent hidden state is not passed explicitly. It is kept in
+        /// the workspace between executions instead, so that each execution
+        /// continues the sequences from where the previous one stopped. The
+        /// workspace must be zero-initialized to start new sequences.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aprop_kind Propagation kind. The only possible value is
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param direction RNN direction. The only possible value is
+        ///     #dnnl::rnn_direction::unidirectional_left2right.
+        /// @param src_layer_desc Memory descriptor for the input vector.
+        /// @param weights_layer_desc Memory descriptor for the weights
+        ///     applied to the layer input.
+        /// @param weights_iter_desc Memory descriptor for the weights applied
+        ///     to the recurrent input.
+        /// @param bias_desc Bias memory descriptor.
+        /// @param dst_layer_desc Memory descriptor for the output vector.
+        /// @param flags RNN cell flags. Must be #dnnl::rnn_flags::stateful.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, prop_kind aprop_kind,
+                rnn_direction direction, const memory::desc &src_layer_desc,
+                const memory::desc &weights_layer_desc,
+                const memory::desc &weights_iter_desc,
+                const memory::desc &bias_desc,
+                const memory::desc &dst_layer_desc, rnn_flags flags,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false)
+            : rnn_primitive_desc_base(aengine, algorithm::lbr_gru,
+                    aprop_kind, algorithm::undef, direction, src_layer_desc,
+                    memory::desc(), nullptr, nullptr, weights_layer_desc,
+                    weights_iter_desc, nullptr, nullptr, bias_desc,
+                    dst_layer_desc, memory::desc(), nullptr, flags, 0.0f,
+                    0.0f, attr, allow_empty) {}
+
         /// Constructs a primitive descriptor for a LBR GRU forward propagation
         /// primitive from a C API primitive descriptor that must have a
         /// matching kind.
@@ -11247,6 +11777,40 @@ struct binary : public primitive {
             reset(pd);
         }
 
+        /// Constructs a primitive descriptor for a ternary binary operator
+        /// primitive. Only the #dnnl::algorithm::binary_select algorithm
+        /// takes the third source, which holds the condition.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aalgorithm Elementwise binary algorithm.
+        /// @param src0 Memory descriptor for source tensor #0.
+        /// @param src1 Memory descriptor for source tensor #1.
+        /// @param src2 Memory descriptor for source tensor #2.
+        /// @param dst Memory descriptor for destination tensor.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, algorithm aalgorithm,
+                const memory::desc &src0, const memory::desc &src1,
+                const memory::desc &src2, const memory::desc &dst,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status = dnnl_binary_primitive_desc_create_v2(&pd,
+                    aengine.get(), dnnl::convert_to_c(aalgorithm), src0.get(),
+                    src1.get(), src2.get(), dst.get(), attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for a binary "
+                        "operation primitive");
+            reset(pd);
+        }
+
         /// Constructs a primitive descriptor for a binary primitive from a C
         /// API primitive descriptor that must have a matching kind.
         ///
@@ -11263,6 +11827,9 @@ struct binary : public primitive {
         /// Returns the memory descriptor for source #1.
         memory::desc src1_desc() const { return base::src_desc(1); }
 
+        /// Returns the memory descriptor for source #2.
+        memory::desc src2_desc() const { return base::src_desc(2); }
+
         /// @copydoc dnnl::primitive_desc_base::dst_desc()const
         memory::desc dst_desc() const { return base::dst_desc(0); }
 
@@ -12235,6 +12802,133 @@ struct reduction : public primitive {
 
 /// @} dnnl_api_reduction
 
+/// @addtogroup dnnl_api_embedding_bag Embedding Bag
+///
+/// A primitive to pool rows of an embedding table into bags using sum, mean
+/// or max operations.
+///
+/// @sa @ref dev_guide_embedding_bag in developer guide
+///
+/// @{
+
+/// Embedding bag.
+struct embedding_bag : public primitive {
+    /// Primitive descriptor for an embedding bag primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for an embedding bag primitive
+        ///     with per-sample weights.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aalgorithm Embedding bag algorithm kind. Possible values:
+        ///     #dnnl::algorithm::embedding_bag_sum,
+        ///     #dnnl::algorithm::embedding_bag_mean,
+        ///     #dnnl::algorithm::embedding_bag_max.
+        /// @param src_desc Embedding table memory descriptor.
+        /// @param indices_desc Indices memory descriptor.
+        /// @param offsets_desc Offsets memory descriptor.
+        /// @param weights_desc Per-sample weights memory descriptor. Passing
+        ///     a zero memory descriptor disables per-sample weights.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, algorithm aalgorithm,
+                const memory::desc &src_desc, const memory::desc &indices_desc,
+                const memory::desc &offsets_desc,
+                const memory::desc &weights_desc, const memory::desc &dst_desc,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status = dnnl_embedding_bag_primitive_desc_create(
+                    &pd, aengine.get(), convert_to_c(aalgorithm),
+                    src_desc.get(), indices_desc.get(), offsets_desc.get(),
+                    weights_desc.get(), dst_desc.get(), attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for an "
+                        "embedding bag primitive");
+            reset(pd);
+        }
+
+        /// Constructs a primitive descriptor for an embedding bag primitive.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aalgorithm Embedding bag algorithm kind. Possible values:
+        ///     #dnnl::algorithm::embedding_bag_sum,
+        ///     #dnnl::algorithm::embedding_bag_mean,
+        ///     #dnnl::algorithm::embedding_bag_max.
+        /// @param src_desc Embedding table memory descriptor.
+        /// @param indices_desc Indices memory descriptor.
+        /// @param offsets_desc Offsets memory descriptor.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, algorithm aalgorithm,
+                const memory::desc &src_desc, const memory::desc &indices_desc,
+                const memory::desc &offsets_desc, const memory::desc &dst_desc,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false)
+            : primitive_desc(aengine, aalgorithm, src_desc, indices_desc,
+                    offsets_desc, memory::desc(), dst_desc, attr,
+                    allow_empty) {}
+
+        /// Constructs a primitive descriptor for an embedding bag primitive
+        /// from a C API primitive descriptor that must have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for an embedding bag
+        ///     primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd, dnnl::primitive::kind::embedding_bag) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// Returns a memory descriptor for indices.
+        /// @returns Indices memory descriptor.
+        memory::desc indices_desc() const { return base::src_desc(1); }
+
+        /// Returns a memory descriptor for offsets.
+        /// @returns Offsets memory descriptor.
+        memory::desc offsets_desc() const { return base::src_desc(2); }
+
+        /// @copydoc dnnl::primitive_desc_base::weights_desc()const
+        memory::desc weights_desc() const { return base::weights_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_algorithm()const
+        algorithm get_algorithm() const { return base::get_algorithm(); }
+    };
+
+    /// Default constructor. Produces an empty object.
+    embedding_bag() = default;
+
+    /// Constructs an embedding bag primitive.
+    /// @param pd Primitive descriptor for an embedding bag primitive.
+    embedding_bag(const primitive_desc &pd) : primitive(pd) {}
+
+    /// Constructs an embedding bag primitive from a cache blob.
+    /// @param pd Primitive descriptor for an embedding bag primitive.
+    /// @param cache_blob Cache blob.
+    embedding_bag(
+            const primitive_desc &pd, const std::vector<uint8_t> &cache_blob)
+        : primitive(pd, cache_blob) {}
+};
+
+/// @} dnnl_api_embedding_bag
+
 /// @} dnnl_api_primitives
 
 /// @addtogroup dnnl_api_service Service
@@ -382,7 +382,10 @@ dnnl_status_t DNNL_API dnnl_graph_partition_get_id(
 /// compilation will deduce the output shapes according to input shapes. The
 /// output logical tensors can also have layout type `any`. The compilation will
 /// choose the optimal layout for output tensors. The optimal layout will be
-/// represented as an opaque layout ID saved in the output logical tensor.
+/// represented as an opaque layout ID saved in the output logical tensor. The
+/// input logical tensors can contain unknown dimensions as well. For this case,
+/// the code generation is deferred to execution, where the tensors must have
+/// concrete dimensions and strides.
 ///
 /// @param partition The target partition.
 /// @param compiled_partition Output compiled partition.
@@ -399,6 +402,27 @@ dnnl_status_t DNNL_API dnnl_graph_partition_compile(
         const dnnl_graph_logical_tensor_t **inputs, size_t out_num,
         const dnnl_graph_logical_tensor_t **outputs, dnnl_engine_t engine);
 
+/// Creates a compiled partition from a cache blob returned by
+/// #dnnl_graph_compiled_partition_get_cache_blob. The cache blob must be
+/// created from a compilation of the same partition, with the same version of
+/// the library and on an engine of the same kind and CPU ISA. Loading skips
+/// the graph transformations and the layout selection of the compilation. The
+/// input and output logical tensors of the compilation can be queried from the
+/// compiled partition.
+///
+/// @param partition The target partition.
+/// @param compiled_partition Output compiled partition.
+/// @param size The size of the cache blob in bytes.
+/// @param cache_blob The cache blob.
+/// @param engine The target engine of the compilation.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise. #dnnl_unimplemented is returned if the cache blob was
+///     created by another version of the library or for another engine.
+dnnl_status_t DNNL_API dnnl_graph_partition_compile_from_cache_blob(
+        dnnl_graph_partition_t partition,
+        dnnl_graph_compiled_partition_t compiled_partition, size_t size,
+        const uint8_t *cache_blob, dnnl_engine_t engine);
+
 /// Returns the number of input logical tensors of a partition.
 ///
 /// @param partition The target partition.
@@ -535,8 +559,178 @@ dnnl_status_t DNNL_API dnnl_graph_compiled_partition_get_inplace_ports(
         size_t *num_inplace_pairs,
         const dnnl_graph_inplace_pair_t **inplace_pairs);
 
+/// Retrieves a cache blob of a compiled partition. The cache blob holds the
+/// transformed graph of the compilation and the chosen memory layouts. If the
+/// compiled partition was executed on a CPU engine with the constant tensor
+/// cache enabled, the cache blob also holds the prepared constant tensors.
+/// If @p cache_blob is NULL, the size of the cache blob is returned in
+/// @p size. Otherwise, @p size must be equal to that size.
+///
+/// @param compiled_partition The handle of target compiled partition.
+/// @param size The size of the cache blob in bytes.
+/// @param cache_blob The output cache blob.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise. #dnnl_unimplemented is returned if the compiled partition
+///     doesn't support cache blobs.
+dnnl_status_t DNNL_API dnnl_graph_compiled_partition_get_cache_blob(
+        const_dnnl_graph_compiled_partition_t compiled_partition, size_t *size,
+        uint8_t *cache_blob);
+
 /// @} dnnl_graph_api_compiled_partition
 
+/// @addtogroup dnnl_graph_api_execution_plan
+/// @{
+
+/// Creates an execution plan for a list of compiled partitions which are
+/// executed in the given order. The tensors produced by a partition of the
+/// list are intermediates unless their IDs are given in @p output_ids. The
+/// intermediates are placed in one arena buffer, where tensors which are not
+/// alive at the same time share memory. All other tensors are provided by the
+/// user at execution. The compiled partitions must outlive the plan.
+///
+/// @param plan The handle of output execution plan.
+/// @param num_partitions The number of compiled partitions.
+/// @param partitions A list of compiled partitions in execution order.
+/// @param num_outputs The number of graph output tensor IDs.
+/// @param output_ids A list of IDs of the tensors which are produced by the
+///     partitions and required by the user after the execution.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_execution_plan_create(
+        dnnl_graph_execution_plan_t *plan, size_t num_partitions,
+        const_dnnl_graph_compiled_partition_t *partitions, size_t num_outputs,
+        const size_t *output_ids);
+
+/// Destroys an execution plan.
+///
+/// @param plan The execution plan to be destroyed.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_execution_plan_destroy(
+        dnnl_graph_execution_plan_t plan);
+
+/// Returns the size in bytes of the arena buffer required by an execution
+/// plan.
+///
+/// @param plan The target execution plan.
+/// @param size Output size of the arena in bytes.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_execution_plan_get_arena_size(
+        const_dnnl_graph_execution_plan_t plan, size_t *size);
+
+/// Returns the offset of an intermediate tensor in the arena buffer. If the
+/// tensor ID doesn't belong to an intermediate tensor of the plan, an error
+/// status #dnnl_invalid_arguments will be returned by the API.
+///
+/// @param plan The target execution plan.
+/// @param tid The unique id of the tensor.
+/// @param offset Output offset of the tensor in bytes.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_execution_plan_query_offset(
+        const_dnnl_graph_execution_plan_t plan, size_t tid, size_t *offset);
+
+/// Executes the compiled partitions of an execution plan in order. The
+/// intermediate tensors are taken from the arena buffer. The inputs and
+/// outputs are matched with the partition ports by their logical tensor IDs.
+///
+/// @param plan The target execution plan.
+/// @param stream The stream used for execution.
+/// @param arena The arena buffer of at least the size returned by
+///     #dnnl_graph_execution_plan_get_arena_size. On the CPU engine, or when
+///     using USM, this is a pointer to the allocated memory.
+/// @param num_inputs The number of input tensors.
+/// @param inputs A list of graph input tensors.
+/// @param num_outputs The number of output tensors.
+/// @param outputs A list of graph output tensors.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_execution_plan_execute(
+        const_dnnl_graph_execution_plan_t plan, dnnl_stream_t stream,
+        void *arena, size_t num_inputs, const_dnnl_graph_tensor_t *inputs,
+        size_t num_outputs, const_dnnl_graph_tensor_t *outputs);
+
+/// @} dnnl_graph_api_execution_plan
+
+/// @addtogroup dnnl_graph_api_batching_executor
+/// @{
+
+/// Creates a batching executor for a partition. The executor collects the
+/// concurrent execution requests which arrive within a time window, packs
+/// their inputs along dimension 0 and runs them as one execution of the
+/// partition compiled for the total batch size. The outputs are then copied
+/// back to every request. The total batch size is rounded up to a power of
+/// two, capped by @p max_batch, and the missing samples are filled with zeros,
+/// so the partition has to process the samples independently.
+///
+/// The logical tensors describe the tensors of one request. They must have
+/// concrete dimensions and a strided layout in which dimension 0 is the
+/// outermost one and the tensor is dense. Inputs with the constant property
+/// are not batched: they are shared by all requests. Only CPU engines with a
+/// non-SYCL runtime are supported.
+///
+/// @param executor The handle of output batching executor.
+/// @param partition The target partition. Only its handle is copied, the
+///     partition can be destroyed after the call.
+/// @param num_inputs The number of input logical tensors.
+/// @param inputs A list of input logical tensors of one request.
+/// @param num_outputs The number of output logical tensors.
+/// @param outputs A list of output logical tensors of one request.
+/// @param engine The target engine of the compilation and execution.
+/// @param max_batch The maximum total batch size of one execution. A batch
+///     is executed as soon as it reaches this size.
+/// @param window_us The time in microseconds the first request of a batch
+///     waits for other requests before the batch is executed.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_batching_executor_create(
+        dnnl_graph_batching_executor_t *executor,
+        const_dnnl_graph_partition_t partition, size_t num_inputs,
+        const dnnl_graph_logical_tensor_t **inputs, size_t num_outputs,
+        const dnnl_graph_logical_tensor_t **outputs, dnnl_engine_t engine,
+        size_t max_batch, size_t window_us);
+
+/// Destroys a batching executor. No execution may be in progress.
+///
+/// @param executor The batching executor to be destroyed.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_batching_executor_destroy(
+        dnnl_graph_batching_executor_t executor);
+
+/// Returns the number of batch sizes for which the partition has been
+/// compiled by a batching executor.
+///
+/// @param executor The target batching executor.
+/// @param num Output number of compiled batch sizes.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_batching_executor_get_num_compiled_batches(
+        const_dnnl_graph_batching_executor_t executor, size_t *num);
+
+/// Executes one request with a batching executor. The call may be made
+/// concurrently from several threads and returns once the batch containing
+/// the request is executed and the outputs of the request are written. The
+/// tensors follow the order of the logical tensors given at creation, and the
+/// size of dimension 0 of the non-constant tensors is the batch size of the
+/// request. Batches are executed on the stream of their first request.
+///
+/// @param executor The target batching executor.
+/// @param stream The stream used for execution.
+/// @param num_inputs The number of input tensors.
+/// @param inputs A list of input tensors.
+/// @param num_outputs The number of output tensors.
+/// @param outputs A list of output tensors.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_batching_executor_execute(
+        const_dnnl_graph_batching_executor_t executor, dnnl_stream_t stream,
+        size_t num_inputs, const_dnnl_graph_tensor_t *inputs,
+        size_t num_outputs, const_dnnl_graph_tensor_t *outputs);
+
+/// @} dnnl_graph_api_batching_executor
+
 /// @addtogroup dnnl_graph_api_graph
 /// @{
 
@@ -675,6 +869,12 @@ dnnl_status_t DNNL_API dnnl_graph_set_compiled_partition_cache_capacity(
 /// be called once before compilation stage. By default, constant tensor cache is
 /// enabled in the library.
 ///
+/// The cached constant tensors are looked up by the data handles of the
+/// constant inputs of a partition. While a compiled partition using the cache
+/// is alive, the memory of its constant inputs must not be freed or filled
+/// with other data: a new constant input at the same address would be
+/// treated as the same input and get the stale cached tensors.
+///
 /// @param flag Set to positive value to enable the cache and set to 0 to
 /// disable the cache. Negative values are invalid.
 /// @returns #dnnl_invalid_arguments if the @p flag value is
@@ -688,6 +888,32 @@ dnnl_status_t DNNL_API dnnl_graph_set_constant_tensor_cache(int flag);
 /// nullptr, and #dnnl_success on success.
 dnnl_status_t DNNL_API dnnl_graph_get_constant_tensor_cache(int *flag);
 
+/// Set the directory where the constant tensor cache shares the constant
+/// tensors with other processes. A process stores the constant tensors it
+/// prepares into files of the directory, and the processes running the same
+/// partitions with the same constant input contents map these files
+/// read-only instead of preparing the tensors again. The initial directory
+/// is taken from the `ONEDNN_GRAPH_CONSTANT_TENSOR_CACHE_DIR` environment
+/// variable. Only the constant tensors in host memory are shared. The files
+/// written by another library build or for another cpu isa, and the files
+/// whose contents don't match their checksum, are ignored.
+///
+/// @param dir The directory. Set to nullptr or an empty string to disable
+/// the sharing.
+/// @returns #dnnl_unimplemented if the sharing is not supported on the
+/// platform, and #dnnl_success on success.
+dnnl_status_t DNNL_API dnnl_graph_set_constant_tensor_cache_dir(
+        const char *dir);
+
+/// Return the memory held by the constant tensor cache. The constant tensors
+/// which are still being computed are not counted.
+///
+/// @param size The size of the cached constant tensors in bytes.
+/// @returns #dnnl_invalid_arguments if the @p size value is
+/// nullptr, and #dnnl_success on success.
+dnnl_status_t DNNL_API dnnl_graph_get_constant_tensor_cache_footprint(
+        size_t *size);
+
 /// @} dnnl_graph_api_constant_tensor_cache
 
 /// @} dnnl_graph_api
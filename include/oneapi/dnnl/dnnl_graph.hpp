@@ -80,6 +80,20 @@ struct graph_handle_traits<dnnl_graph_compiled_partition_t> {
     }
 };
 
+template <>
+struct graph_handle_traits<dnnl_graph_execution_plan_t> {
+    static dnnl_status_t destructor(dnnl_graph_execution_plan_t p) {
+        return dnnl_graph_execution_plan_destroy(p);
+    }
+};
+
+template <>
+struct graph_handle_traits<dnnl_graph_batching_executor_t> {
+    static dnnl_status_t destructor(dnnl_graph_batching_executor_t p) {
+        return dnnl_graph_batching_executor_destroy(p);
+    }
+};
+
 template <>
 struct graph_handle_traits<dnnl_graph_allocator_t> {
     static dnnl_status_t destructor(dnnl_graph_allocator_t p) {
@@ -96,6 +110,8 @@ DNNL_GRAPH_HANDLE_ALIAS(graph);
 DNNL_GRAPH_HANDLE_ALIAS(op);
 DNNL_GRAPH_HANDLE_ALIAS(tensor);
 DNNL_GRAPH_HANDLE_ALIAS(compiled_partition);
+DNNL_GRAPH_HANDLE_ALIAS(execution_plan);
+DNNL_GRAPH_HANDLE_ALIAS(batching_executor);
 DNNL_GRAPH_HANDLE_ALIAS(partition);
 
 #undef DNNL_GRAPH_HANDLE_ALIAS
@@ -220,6 +236,7 @@ class logical_tensor {
     friend class tensor;
     friend class partition;
     friend class compiled_partition;
+    friend class batching_executor;
 
     dnnl_graph_logical_tensor_t data;
 
@@ -653,6 +670,28 @@ public:
         return inplace_options;
     }
 
+    /// Returns a cache blob of the compiled partition. The cache blob can be
+    /// used to create the compiled partition again without the graph
+    /// transformations, see partition::compile(). If the compiled partition
+    /// was executed on a CPU engine with the constant tensor cache enabled,
+    /// the cache blob also holds the prepared constant tensors.
+    ///
+    /// @returns The cache blob.
+    std::vector<uint8_t> get_cache_blob() const {
+        size_t size = 0;
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_get_cache_blob(
+                        get(), &size, nullptr),
+                "could not get the cache blob size from a compiled partition");
+
+        std::vector<uint8_t> cache_blob(size);
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_get_cache_blob(
+                        get(), &size, cache_blob.data()),
+                "could not get the cache blob from a compiled partition");
+        return cache_blob;
+    }
+
     /// Execute a compiled partition.
     ///
     /// @param astream Stream object to run over.
@@ -681,6 +720,102 @@ public:
 
 /// @} dnnl_graph_api_compiled_partition
 
+/// @addtogroup dnnl_graph_api_execution_plan Execution Plan
+///
+/// An execution plan runs a sequence of compiled partitions, for example all
+/// partitions of a model, and serves their intermediate tensors from one
+/// arena buffer. The tensors which are not alive at the same time share the
+/// memory of the arena, so the peak activation memory is reduced and no
+/// allocation is needed for the intermediates at execution.
+///
+/// @{
+
+/// An execution plan object.
+class execution_plan : public execution_plan_handle {
+public:
+    /// Default constructor. Constructs an empty object.
+    execution_plan() = default;
+
+    /// Constructs an execution plan for compiled partitions which are
+    /// executed in the given order. The tensors produced by the partitions
+    /// are placed in the arena unless their IDs are in @p output_ids. The
+    /// compiled partitions must outlive the plan.
+    ///
+    /// @param partitions A list of compiled partitions in execution order.
+    /// @param output_ids A list of IDs of the tensors which are required by
+    ///     the user after the execution.
+    execution_plan(const std::vector<compiled_partition> &partitions,
+            const std::vector<size_t> &output_ids) {
+        std::vector<const_dnnl_graph_compiled_partition_t> c_partitions;
+        c_partitions.reserve(partitions.size());
+        for (auto &cp : partitions) {
+            c_partitions.push_back(cp.get());
+        }
+
+        dnnl_graph_execution_plan_t p = nullptr;
+        error::wrap_c_api(
+                dnnl_graph_execution_plan_create(&p, c_partitions.size(),
+                        c_partitions.data(), output_ids.size(),
+                        output_ids.data()),
+                "could not create the execution plan");
+        reset(p);
+    }
+
+    /// Returns the size in bytes of the arena buffer required by the plan.
+    ///
+    /// @returns The arena size.
+    size_t get_arena_size() const {
+        size_t size = 0;
+        error::wrap_c_api(
+                dnnl_graph_execution_plan_get_arena_size(get(), &size),
+                "could not get the arena size from the execution plan");
+        return size;
+    }
+
+    /// Returns the offset of an intermediate tensor in the arena buffer. If
+    /// the tensor is not an intermediate of the plan, an exception will be
+    /// raised by the API.
+    ///
+    /// @param tid The unique id of the tensor.
+    /// @returns The offset in bytes.
+    size_t query_offset(size_t tid) const {
+        size_t offset = 0;
+        error::wrap_c_api(
+                dnnl_graph_execution_plan_query_offset(get(), tid, &offset),
+                "could not query the offset from the execution plan");
+        return offset;
+    }
+
+    /// Executes the compiled partitions of the plan in order.
+    ///
+    /// @param astream Stream object to run over.
+    /// @param arena The arena buffer of at least get_arena_size() bytes.
+    /// @param inputs A list of graph input tensors.
+    /// @param outputs A list of graph output tensors.
+    void execute(dnnl::stream &astream, void *arena,
+            const std::vector<tensor> &inputs,
+            const std::vector<tensor> &outputs) const {
+        std::vector<const_dnnl_graph_tensor_t> c_inputs;
+        c_inputs.reserve(inputs.size());
+        for (auto &in : inputs) {
+            c_inputs.push_back(in.get());
+        }
+        std::vector<const_dnnl_graph_tensor_t> c_outputs;
+        c_outputs.reserve(outputs.size());
+        for (auto &out : outputs) {
+            c_outputs.push_back(out.get());
+        }
+
+        error::wrap_c_api(
+                dnnl_graph_execution_plan_execute(get(), astream.get(), arena,
+                        c_inputs.size(), c_inputs.data(), c_outputs.size(),
+                        c_outputs.data()),
+                "could not execute the execution plan");
+    }
+};
+
+/// @} dnnl_graph_api_execution_plan
+
 /// @addtogroup dnnl_graph_api_op Op
 ///
 /// OP is an abstraction of computation logic for deep neural network
@@ -722,10 +857,13 @@ public:
         DynamicQuantize = dnnl_graph_op_dynamic_quantize,
         Elu = dnnl_graph_op_elu,
         EluBackward = dnnl_graph_op_elu_backward,
+        EmbeddingBag = dnnl_graph_op_embedding_bag,
         End = dnnl_graph_op_end,
         Exp = dnnl_graph_op_exp,
+        Gather = dnnl_graph_op_gather,
         GELU = dnnl_graph_op_gelu,
         GELUBackward = dnnl_graph_op_gelu_backward,
+        GroupNorm = dnnl_graph_op_group_norm,
         HardSwish = dnnl_graph_op_hard_swish,
         HardSwishBackward = dnnl_graph_op_hard_swish_backward,
         Interpolate = dnnl_graph_op_interpolate,
@@ -744,6 +882,7 @@ public:
         Mish = dnnl_graph_op_mish,
         MishBackward = dnnl_graph_op_mish_backward,
         Multiply = dnnl_graph_op_multiply,
+        Pow = dnnl_graph_op_pow,
         PReLU = dnnl_graph_op_prelu,
         PReLUBackward = dnnl_graph_op_prelu_backward,
         Quantize = dnnl_graph_op_quantize,
@@ -759,6 +898,7 @@ public:
         ReLUBackward = dnnl_graph_op_relu_backward,
         Reorder = dnnl_graph_op_reorder,
         Round = dnnl_graph_op_round,
+        Select = dnnl_graph_op_select,
         Sigmoid = dnnl_graph_op_sigmoid,
         SigmoidBackward = dnnl_graph_op_sigmoid_backward,
         SoftMax = dnnl_graph_op_softmax,
@@ -1169,7 +1309,9 @@ public:
     /// The output logical tensors can also have layout type `any`. The
     /// compilation will choose the optimal layout for output tensors. The
     /// optimal layout will be represented as an opaque layout ID saved in the
-    /// output logical tensor.
+    /// output logical tensor. The input logical tensors can contain unknown
+    /// dimensions as well. For this case, the code generation is deferred to
+    /// execution, where the tensors must have concrete dimensions and strides.
     ///
     /// @param inputs A list of input logical tensors.
     /// @param outputs A list of output logical tensors.
@@ -1185,6 +1327,36 @@ public:
         return compile_(inputs, outputs, e);
     }
 
+    /// Compiles a partition from a cache blob returned by
+    /// compiled_partition::get_cache_blob(). The cache blob must be created
+    /// from a compilation of the same partition, with the same version of
+    /// the library and on an engine of the same kind and CPU ISA. The graph
+    /// transformations and the layout selection are skipped. The input and
+    /// output logical tensors can be queried from the compiled partition.
+    ///
+    /// @param cache_blob The cache blob.
+    /// @param e The engine used to compile the partition.
+    /// @returns A compiled partition.
+    compiled_partition compile(
+            const std::vector<uint8_t> &cache_blob, const engine &e) const {
+        if (!is_supported()) {
+            error::wrap_c_api(dnnl_invalid_arguments,
+                    "could not compile an unsupported partition");
+        }
+
+        dnnl_graph_compiled_partition_t cpartitions = nullptr;
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_create(&cpartitions, get()),
+                "could not create compiled_partition");
+        compiled_partition cp(cpartitions);
+        error::wrap_c_api(
+                dnnl_graph_partition_compile_from_cache_blob(get(),
+                        cpartitions, cache_blob.size(), cache_blob.data(),
+                        e.get()),
+                "partition compile from cache blob failed");
+        return cp;
+    }
+
     /// Returns the supporting status of a partition. Some operations may not be
     /// supported by the library under certain circumstances. During
     /// partitioning stage, unsupported partitions will be returned to users
@@ -1286,6 +1458,101 @@ private:
 
 /// @} dnnl_graph_api_partition
 
+/// @addtogroup dnnl_graph_api_batching_executor Batching Executor
+///
+/// A batching executor serves many concurrent requests of small batch size,
+/// for example single-sample inference requests of a server. The requests
+/// which arrive within a time window are packed along dimension 0 and
+/// executed at once by the partition compiled for the total batch size, which
+/// makes a better use of the hardware than executing them one by one. Each
+/// request is delayed by at most the time window plus the batch execution.
+/// The total batch size is rounded up to a power of two with zero-filled
+/// samples, so the partition has to process the samples independently.
+///
+/// @{
+
+/// A batching executor object.
+class batching_executor : public batching_executor_handle {
+public:
+    /// Default constructor. Constructs an empty object.
+    batching_executor() = default;
+
+    /// Constructs a batching executor for a partition. The logical tensors
+    /// describe the tensors of one request and must be dense and strided with
+    /// dimension 0 as the outermost one. Constant inputs are shared by all
+    /// requests of a batch.
+    ///
+    /// @param p The partition to execute.
+    /// @param inputs A list of input logical tensors of one request.
+    /// @param outputs A list of output logical tensors of one request.
+    /// @param e The engine used to compile and execute the partition.
+    /// @param max_batch The maximum total batch size of one execution.
+    /// @param window_us The time in microseconds a batch waits for requests.
+    batching_executor(const partition &p,
+            const std::vector<logical_tensor> &inputs,
+            const std::vector<logical_tensor> &outputs, const engine &e,
+            size_t max_batch, size_t window_us) {
+        std::vector<const dnnl_graph_logical_tensor_t *> c_inputs;
+        c_inputs.reserve(inputs.size());
+        for (const auto &in : inputs) {
+            c_inputs.push_back(&(in.data));
+        }
+        std::vector<const dnnl_graph_logical_tensor_t *> c_outputs;
+        c_outputs.reserve(outputs.size());
+        for (const auto &out : outputs) {
+            c_outputs.push_back(&(out.data));
+        }
+
+        dnnl_graph_batching_executor_t ex = nullptr;
+        error::wrap_c_api(
+                dnnl_graph_batching_executor_create(&ex, p.get(),
+                        c_inputs.size(), c_inputs.data(), c_outputs.size(),
+                        c_outputs.data(), e.get(), max_batch, window_us),
+                "could not create the batching executor");
+        reset(ex);
+    }
+
+    /// Returns the number of batch sizes the partition is compiled for.
+    ///
+    /// @returns The number of compiled batch sizes.
+    size_t get_num_compiled_batches() const {
+        size_t num = 0;
+        error::wrap_c_api(
+                dnnl_graph_batching_executor_get_num_compiled_batches(
+                        get(), &num),
+                "could not get the number of compiled batches");
+        return num;
+    }
+
+    /// Executes one request. The method may be called concurrently and
+    /// returns once the outputs of the request are written.
+    ///
+    /// @param astream Stream object to run over.
+    /// @param inputs A list of input tensors of the request.
+    /// @param outputs A list of output tensors of the request.
+    void execute(dnnl::stream &astream, const std::vector<tensor> &inputs,
+            const std::vector<tensor> &outputs) const {
+        std::vector<const_dnnl_graph_tensor_t> c_inputs;
+        c_inputs.reserve(inputs.size());
+        for (auto &in : inputs) {
+            c_inputs.push_back(in.get());
+        }
+        std::vector<const_dnnl_graph_tensor_t> c_outputs;
+        c_outputs.reserve(outputs.size());
+        for (auto &out : outputs) {
+            c_outputs.push_back(out.get());
+        }
+
+        error::wrap_c_api(
+                dnnl_graph_batching_executor_execute(get(), astream.get(),
+                        c_inputs.size(), c_inputs.data(), c_outputs.size(),
+                        c_outputs.data()),
+                "could not execute the batching executor");
+    }
+};
+
+/// @} dnnl_graph_api_batching_executor
+
 /// @addtogroup dnnl_graph_api_graph Graph
 ///
 /// Graph represents a computational DAG with a set of operations.
@@ -1468,6 +1735,23 @@ inline int get_constant_tensor_cache() {
     return result;
 }
 
+/// Set the directory where the constant tensor cache shares the constant
+/// tensors with other processes. An empty string disables the sharing.
+///
+/// @param dir The directory.
+inline void set_constant_tensor_cache_dir(const std::string &dir) {
+    error::wrap_c_api(dnnl_graph_set_constant_tensor_cache_dir(dir.c_str()),
+            "fail to set constant tensor cache directory");
+}
+
+/// Return the memory held by the constant tensor cache in bytes.
+inline size_t get_constant_tensor_cache_footprint() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_graph_get_constant_tensor_cache_footprint(&result),
+            "fail to get constant tensor cache footprint");
+    return result;
+}
+
 /// @} dnnl_graph_constant_tensor_cache
 
 } // namespace graph
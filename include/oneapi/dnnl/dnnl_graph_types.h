@@ -194,10 +194,13 @@ typedef enum {
     dnnl_graph_op_dynamic_quantize,
     dnnl_graph_op_elu,
     dnnl_graph_op_elu_backward,
+    dnnl_graph_op_embedding_bag,
     dnnl_graph_op_end,
     dnnl_graph_op_exp,
+    dnnl_graph_op_gather,
     dnnl_graph_op_gelu,
     dnnl_graph_op_gelu_backward,
+    dnnl_graph_op_group_norm,
     dnnl_graph_op_hard_swish,
     dnnl_graph_op_hard_swish_backward,
     dnnl_graph_op_interpolate,
@@ -216,6 +219,7 @@ typedef enum {
     dnnl_graph_op_mish,
     dnnl_graph_op_mish_backward,
     dnnl_graph_op_multiply,
+    dnnl_graph_op_pow,
     dnnl_graph_op_prelu,
     dnnl_graph_op_prelu_backward,
     dnnl_graph_op_quantize,
@@ -231,6 +235,7 @@ typedef enum {
     dnnl_graph_op_relu_backward,
     dnnl_graph_op_reorder,
     dnnl_graph_op_round,
+    dnnl_graph_op_select,
     dnnl_graph_op_sigmoid,
     dnnl_graph_op_sigmoid_backward,
     dnnl_graph_op_softmax,
@@ -436,6 +441,36 @@ typedef const struct dnnl_graph_compiled_partition
 
 /// @} dnnl_graph_api_compiled_partition
 
+/// @addtogroup dnnl_graph_api_execution_plan
+/// @{
+
+/// An opaque structure to describe an execution plan.
+struct dnnl_graph_execution_plan;
+
+/// An execution plan handle.
+typedef struct dnnl_graph_execution_plan *dnnl_graph_execution_plan_t;
+
+/// A constant execution plan handle.
+typedef const struct dnnl_graph_execution_plan
+        *const_dnnl_graph_execution_plan_t;
+
+/// @} dnnl_graph_api_execution_plan
+
+/// @addtogroup dnnl_graph_api_batching_executor
+/// @{
+
+/// An opaque structure to describe a batching executor.
+struct dnnl_graph_batching_executor;
+
+/// A batching executor handle.
+typedef struct dnnl_graph_batching_executor *dnnl_graph_batching_executor_t;
+
+/// A constant batching executor handle.
+typedef const struct dnnl_graph_batching_executor
+        *const_dnnl_graph_batching_executor_t;
+
+/// @} dnnl_graph_api_batching_executor
+
 /// @addtogroup dnnl_graph_api_tensor
 /// @{
 
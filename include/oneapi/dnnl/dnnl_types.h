@@ -1643,6 +1643,10 @@ typedef enum {
     dnnl_softmax,
     /// A layer normalization primitive.
     dnnl_layer_normalization,
+    /// A group normalization primitive.
+    dnnl_group_normalization,
+    /// An embedding bag primitive.
+    dnnl_embedding_bag,
 
     /// Parameter to allow internal only primitives without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -1773,6 +1777,8 @@ typedef enum {
     dnnl_binary_eq = 0x1fffa,
     /// Binary not equal
     dnnl_binary_ne = 0x1fffb,
+    /// Binary select
+    dnnl_binary_select = 0x1fffc,
     /// Nearest Neighbor Resampling Method
     dnnl_resampling_nearest = 0x2fff0,
     /// Linear Resampling Method
@@ -1799,6 +1805,12 @@ typedef enum {
     dnnl_softmax_accurate = 0x30000,
     /// Logsoftmax
     dnnl_softmax_log,
+    /// Embedding bag using sum
+    dnnl_embedding_bag_sum = 0x40000,
+    /// Embedding bag using mean
+    dnnl_embedding_bag_mean,
+    /// Embedding bag using max
+    dnnl_embedding_bag_max,
 } dnnl_alg_kind_t;
 
 /// Flags for normalization primitives.
@@ -1870,6 +1882,59 @@ typedef enum {
     ///    tensor and then perform backward normalization.
     dnnl_fuse_norm_add_relu = 0x10U,
 
+    /// Use precomputed sums
+    ///
+    /// If specified:
+    ///  - on forward propagation compute mean and variance from per-channel
+    ///    sums and sums of squares of the source tensor provided by user
+    ///    (input) instead of reading the source tensor one more time. The sums
+    ///    are usually produced by the preceding primitive with the
+    ///    @ref dev_guide_attributes_dst_stats attribute.
+    ///  - on forward training propagation mean and variance are stored as
+    ///    output, same as if the flag were not specified.
+    ///
+    /// The flag is supported only for batch normalization forward propagation
+    /// and cannot be combined with #dnnl_use_global_stats.
+    dnnl_use_precomputed_sums = 0x20U,
+
+    /// Use root mean square normalization
+    ///
+    /// If specified:
+    ///  - the mean is not subtracted from the source tensor and the variance
+    ///    is replaced with the mean of squares of the source tensor.
+    ///  - the mean is neither computed, nor used, and the #DNNL_ARG_MEAN
+    ///    argument is not expected.
+    ///
+    /// The flag is supported only for layer normalization.
+    dnnl_rms_norm = 0x40U,
+
+    /// Fuse with residual Add
+    ///
+    /// If specified:
+    ///  - on forward propagation add an additional input tensor passed with
+    ///    index #DNNL_ARG_SRC_1 to the source tensor before the normalization.
+    ///    The statistics and the normalized output are computed from the sum.
+    ///  - if a tensor with index #DNNL_ARG_DST_1 is passed at execution, the
+    ///    sum is also stored to it.
+    ///
+    /// Both tensors have the same memory descriptor as the source tensor. The
+    /// flag is supported only for layer normalization forward propagation.
+    dnnl_fuse_residual_add = 0x80U,
+
+    /// Use one-pass Welford statistics
+    ///
+    /// If specified:
+    ///  - on forward propagation mean and variance are computed in a single
+    ///    pass over the source tensor with Welford's online algorithm. Partial
+    ///    results of threads are combined with pairwise (Chan) merges, which
+    ///    keeps the variance accurate for large spatial and mini-batch sizes
+    ///    without reading the source tensor twice.
+    ///
+    /// The flag is supported only for batch normalization forward propagation
+    /// and cannot be combined with #dnnl_use_global_stats or
+    /// #dnnl_use_precomputed_sums.
+    dnnl_welford_stats = 0x100U,
+
 } dnnl_normalization_flags_t;
 
 /// @} dnnl_api_primitives_common
@@ -1946,7 +2011,13 @@ typedef const struct dnnl_memory *const_dnnl_memory_t;
 /// Flags for RNN cell.
 typedef enum {
     /// Undefined RNN flags
-    dnnl_rnn_flags_undef = 0x0
+    dnnl_rnn_flags_undef = 0x0,
+    /// Stateful (streaming) execution: hidden and cell states are kept in
+    /// the workspace between executions instead of being passed via the
+    /// src_iter and dst_iter arguments. Each execution continues the
+    /// sequences from the states left by the previous one. Zeroing the
+    /// workspace resets the states.
+    dnnl_rnn_flags_stateful = 0x1
 } dnnl_rnn_flags_t;
 
 /// A direction of RNN primitive execution.
@@ -2098,6 +2169,12 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// #DNNL_ARG_SRC_3.
 #define DNNL_ARG_AUGRU_ATTENTION DNNL_ARG_SRC_3
 
+/// Source argument #4.
+#define DNNL_ARG_SRC_4 5
+/// A special mnemonic for RNN per-sequence lengths of a minibatch of
+/// variable-length sequences. An alias for #DNNL_ARG_SRC_4.
+#define DNNL_ARG_SEQ_LENGTHS DNNL_ARG_SRC_4
+
 /// Destination argument #0.
 #define DNNL_ARG_DST_0 17
 /// A special mnemonic for destination argument for primitives that have a
@@ -2253,6 +2330,15 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// Output scaling factors provided at execution time.
 #define DNNL_ARG_ATTR_OUTPUT_SCALES 513
 
+/// Per-channel sums and sums of squares of the destination tensor. The
+/// argument is an f32 tensor of shape {2, C} in the row-major layout, where
+/// the first row holds the sums and the second one holds the sums of squares.
+#define DNNL_ARG_ATTR_DST_STATS 514
+
+/// Additive source mask applied before the primitive operation. See
+/// dnnl_primitive_attr_set_src_mask().
+#define DNNL_ARG_ATTR_SRC_MASK 515
+
 /// Starting index for source arguments for primitives that take a variable
 /// number of source arguments.
 #define DNNL_ARG_MULTIPLE_SRC 1024
@@ -2383,6 +2469,7 @@ typedef enum {
     dnnl_query_activation_kind, ///< RNN parameter activation kind
     dnnl_query_kernel, ///< Pooling parameter kernel
     dnnl_query_group_size_s64, ///< Shuffle parameter group size
+    dnnl_query_num_groups_s64, ///< Group normalization parameter groups
 
     // memory descriptor section
     dnnl_query_some_md = 128, ///< stub
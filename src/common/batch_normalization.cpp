@@ -47,9 +47,27 @@ status_t bnrm_desc_init(batch_normalization_desc_t *bnrm_desc,
     unsigned bnorm_flags = normalization_flags::use_global_stats
             | normalization_flags::fuse_norm_relu
             | normalization_flags::fuse_norm_add_relu
-            | normalization_flags::use_scale | normalization_flags::use_shift;
+            | normalization_flags::use_scale | normalization_flags::use_shift
+            | normalization_flags::use_precomputed_sums
+            | normalization_flags::welford_stats;
     if ((~bnorm_flags & flags) != 0) return invalid_arguments;
 
+    // Precomputed sums replace the statistics computation on forward only.
+    if (flags & normalization_flags::use_precomputed_sums) {
+        if (!is_fwd || (flags & normalization_flags::use_global_stats))
+            return invalid_arguments;
+    }
+
+    // Welford statistics select how the statistics are computed, so they
+    // cannot be combined with flags providing the statistics.
+    if (flags & normalization_flags::welford_stats) {
+        if (!is_fwd
+                || (flags
+                        & (normalization_flags::use_global_stats
+                                | normalization_flags::use_precomputed_sums)))
+            return invalid_arguments;
+    }
+
     auto bd = batch_normalization_desc_t();
     bd.primitive_kind = primitive_kind::batch_normalization;
     bd.prop_kind = prop_kind;
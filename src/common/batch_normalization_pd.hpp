@@ -78,6 +78,16 @@ struct batch_normalization_pd_t : public primitive_desc_t {
     bool fuse_norm_add_relu() const {
         return desc_.flags & normalization_flags::fuse_norm_add_relu;
     }
+    bool use_precomputed_sums() const {
+        return desc_.flags & normalization_flags::use_precomputed_sums;
+    }
+    bool use_welford_stats() const {
+        return desc_.flags & normalization_flags::welford_stats;
+    }
+    // Returns true if the primitive does not compute statistics from src
+    bool stats_are_precomputed() const {
+        return use_global_stats() || use_precomputed_sums();
+    }
     bool with_relu_post_op(bool require_nslope_zero = true) const {
         const auto &p = this->attr()->post_ops_;
         const bool nslope_zero_ok
@@ -147,6 +157,8 @@ struct batch_normalization_fwd_pd_t : public batch_normalization_pd_t {
         if (arg == DNNL_ARG_SRC) return arg_usage_t::input;
         if (arg == DNNL_ARG_SRC_1 && fuse_norm_add_relu())
             return arg_usage_t::input;
+        if (arg == DNNL_ARG_ATTR_DST_STATS && use_precomputed_sums())
+            return arg_usage_t::input;
         if (arg == DNNL_ARG_DST) return arg_usage_t::output;
 
         if (utils::one_of(arg, DNNL_ARG_MEAN, DNNL_ARG_VARIANCE)) {
@@ -174,6 +186,7 @@ struct batch_normalization_fwd_pd_t : public batch_normalization_pd_t {
                 return stats_is_src() ? src_md(2) : dst_md(2);
             case DNNL_ARG_SCALE:
             case DNNL_ARG_SHIFT: return weights_md(0);
+            case DNNL_ARG_ATTR_DST_STATS: return sums_md();
             default: return batch_normalization_pd_t::arg_md(arg);
         }
     }
@@ -204,9 +217,15 @@ struct batch_normalization_fwd_pd_t : public batch_normalization_pd_t {
         return stats_is_src() ? src_md(1) : dst_md(1);
     }
 
+    // Per-channel sums and sums of squares of src, see
+    // normalization_flags::use_precomputed_sums
+    const memory_desc_t *sums_md() const {
+        return use_precomputed_sums() ? &sums_md_ : &glob_zero_md;
+    }
+
     int n_inputs() const override {
         return 1 + 2 * stats_is_src() + use_scale() + use_shift()
-                + fuse_norm_add_relu();
+                + fuse_norm_add_relu() + use_precomputed_sums();
     }
     int n_outputs() const override {
         return 1 + !types::is_zero_md(workspace_md())
@@ -215,12 +234,20 @@ struct batch_normalization_fwd_pd_t : public batch_normalization_pd_t {
 
 protected:
     memory_desc_t dst_md_;
+    memory_desc_t sums_md_;
 
     batch_normalization_fwd_pd_t(const batch_normalization_desc_t *adesc,
             const primitive_attr_t *attr,
             const batch_normalization_fwd_pd_t *hint_fwd_pd)
         : batch_normalization_pd_t(adesc, attr, hint_fwd_pd)
-        , dst_md_(desc_.dst_desc) {}
+        , dst_md_(desc_.dst_desc)
+        , sums_md_() {
+        if (use_precomputed_sums()) {
+            dims_t dims = {2, desc_.src_desc.dims[1]};
+            memory_desc_init_by_tag(
+                    sums_md_, 2, dims, data_type::f32, format_tag::ab);
+        }
+    }
 
     bool set_default_formats_common() {
         return IMPLICATION(dst_md_.format_kind == format_kind::any,
@@ -30,19 +30,24 @@ using namespace dnnl::impl::status;
 using namespace dnnl::impl::alg_kind;
 using namespace dnnl::impl::types;
 
-status_t dnnl_binary_primitive_desc_create(
-        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
-        alg_kind_t alg_kind, const memory_desc_t *src0_md,
-        const memory_desc_t *src1_md, const memory_desc_t *dst_md,
-        const primitive_attr_t *attr) {
+namespace {
+status_t binary_desc_init(binary_desc_t *binary_desc, alg_kind_t alg_kind,
+        const memory_desc_t *src0_md, const memory_desc_t *src1_md,
+        const memory_desc_t *src2_md, const memory_desc_t *dst_md) {
+    const bool is_ternary = alg_kind == binary_select;
     bool args_ok = !any_null(src0_md, src1_md, dst_md)
             && one_of(alg_kind, binary_add, binary_mul, binary_max, binary_min,
                     binary_div, binary_sub, binary_ge, binary_gt, binary_le,
-                    binary_lt, binary_eq, binary_ne)
+                    binary_lt, binary_eq, binary_ne, binary_select)
             // TODO - Add support for mutual or bi-directional broadcasts
             && !memory_desc_wrapper(src0_md).format_any();
     if (!args_ok) return invalid_arguments;
 
+    // Only the select algorithm takes a third source, the condition.
+    const bool has_src2
+            = src2_md && !memory_desc_wrapper(src2_md).is_zero();
+    if (has_src2 != is_ternary) return invalid_arguments;
+
     auto bod = binary_desc_t();
     bod.primitive_kind = primitive_kind::binary;
     bod.alg_kind = alg_kind;
@@ -50,11 +55,15 @@ status_t dnnl_binary_primitive_desc_create(
     bool runtime_dims_or_strides
             = memory_desc_wrapper(src0_md).has_runtime_dims_or_strides()
             || memory_desc_wrapper(src1_md).has_runtime_dims_or_strides()
-            || memory_desc_wrapper(dst_md).has_runtime_dims_or_strides();
+            || memory_desc_wrapper(dst_md).has_runtime_dims_or_strides()
+            || (is_ternary
+                    && memory_desc_wrapper(src2_md)
+                               .has_runtime_dims_or_strides());
     if (runtime_dims_or_strides) return unimplemented;
 
     bod.src_desc[0] = *src0_md;
     bod.src_desc[1] = *src1_md;
+    if (is_ternary) bod.src_desc[2] = *src2_md;
     bod.dst_desc = *dst_md;
 
     const int ndims = dst_md->ndims;
@@ -62,7 +71,16 @@ status_t dnnl_binary_primitive_desc_create(
 
     if (!(src0_md->ndims == ndims && src1_md->ndims == ndims))
         return invalid_arguments;
+    if (is_ternary && src2_md->ndims != ndims) return invalid_arguments;
     for (int d = 0; d < ndims; ++d) {
+        if (is_ternary) {
+            // Select broadcasts every source independently.
+            const bool ok = utils::one_of(src0_md->dims[d], 1, dims[d])
+                    && utils::one_of(src1_md->dims[d], 1, dims[d])
+                    && utils::one_of(src2_md->dims[d], 1, dims[d]);
+            if (!ok) return invalid_arguments;
+            continue;
+        }
         //dims must equal eachother or equal 1 (broadcast)
         const bool ok = utils::one_of(src0_md->dims[d], 1, dims[d])
                 && utils::one_of(src1_md->dims[d], 1, dims[d])
@@ -71,6 +89,31 @@ status_t dnnl_binary_primitive_desc_create(
         if (!ok) return invalid_arguments;
     }
 
+    *binary_desc = bod;
+    return success;
+}
+} // namespace
+
+status_t dnnl_binary_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        alg_kind_t alg_kind, const memory_desc_t *src0_md,
+        const memory_desc_t *src1_md, const memory_desc_t *dst_md,
+        const primitive_attr_t *attr) {
+    auto bod = binary_desc_t();
+    CHECK(binary_desc_init(
+            &bod, alg_kind, src0_md, src1_md, nullptr, dst_md));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&bod, nullptr, attr);
+}
+
+status_t dnnl_binary_primitive_desc_create_v2(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        alg_kind_t alg_kind, const memory_desc_t *src0_md,
+        const memory_desc_t *src1_md, const memory_desc_t *src2_md,
+        const memory_desc_t *dst_md, const primitive_attr_t *attr) {
+    auto bod = binary_desc_t();
+    CHECK(binary_desc_init(
+            &bod, alg_kind, src0_md, src1_md, src2_md, dst_md));
     return primitive_desc_create(primitive_desc_iface, engine,
             (const op_desc_t *)&bod, nullptr, attr);
 }
@@ -53,6 +53,9 @@ struct binary_pd_t : public primitive_desc_t {
         if (arg == DNNL_ARG_SRC_0 || arg == DNNL_ARG_SRC_1)
             return arg_usage_t::input;
 
+        if (arg == DNNL_ARG_SRC_2 && is_ternary_op())
+            return arg_usage_t::input;
+
         if (arg == DNNL_ARG_DST) return arg_usage_t::output;
 
         return primitive_desc_t::arg_usage(arg);
@@ -62,6 +65,7 @@ struct binary_pd_t : public primitive_desc_t {
         switch (arg) {
             case DNNL_ARG_SRC_0: return src_md(0);
             case DNNL_ARG_SRC_1: return src_md(1);
+            case DNNL_ARG_SRC_2: return src_md(2);
             case DNNL_ARG_DST: return dst_md(0);
             default: return primitive_desc_t::arg_md(arg);
         }
@@ -72,13 +76,17 @@ struct binary_pd_t : public primitive_desc_t {
             return &src0_md_;
         else if (index == 1)
             return &src1_md_;
+        else if (index == 2 && is_ternary_op())
+            return &src2_md_;
         return &glob_zero_md;
     }
     const memory_desc_t *dst_md(int index = 0) const override {
         return index == 0 ? &dst_md_ : &glob_zero_md;
     }
 
-    int n_inputs() const override { return 2 + n_binary_po_inputs(); }
+    int n_inputs() const override {
+        return 2 + is_ternary_op() + n_binary_po_inputs();
+    }
     int n_outputs() const override { return 1; }
 
     const dims_t &broadcast_dims() const { return broadcast_dims_; }
@@ -95,11 +103,17 @@ struct binary_pd_t : public primitive_desc_t {
         return src0_d.consistent_with(src1_d);
     }
 
+    // Select is the only algorithm with a third source.
+    bool is_ternary_op() const {
+        return desc_.alg_kind == alg_kind::binary_select;
+    }
+
 protected:
     binary_desc_t desc_;
 
     memory_desc_t src0_md_;
     memory_desc_t src1_md_;
+    memory_desc_t src2_md_;
     memory_desc_t dst_md_;
 
     dims_t broadcast_dims_;
@@ -110,6 +124,7 @@ protected:
         , desc_(*adesc)
         , src0_md_(desc_.src_desc[0])
         , src1_md_(desc_.src_desc[1])
+        , src2_md_(desc_.src_desc[2])
         , dst_md_(desc_.dst_desc) {
         init_broadcast_dims();
     }
@@ -123,6 +138,14 @@ protected:
             }
         }
 
+        if (is_ternary_op() && src2_md_.format_kind == format_kind::any) {
+            const memory_desc_wrapper src_d(src_md(0));
+            if (src_d.is_blocking_desc()) {
+                CHECK(memory_desc_init_by_blocking_desc(
+                        src2_md_, src_d.blocking_desc()));
+            }
+        }
+
         if (dst_md_.format_kind == format_kind::any) {
             const memory_desc_wrapper src_d(src_md(0));
             if (src_d.is_blocking_desc()) {
@@ -121,6 +121,7 @@ const alg_kind_t binary_le = dnnl_binary_le;
 const alg_kind_t binary_lt = dnnl_binary_lt;
 const alg_kind_t binary_eq = dnnl_binary_eq;
 const alg_kind_t binary_ne = dnnl_binary_ne;
+const alg_kind_t binary_select = dnnl_binary_select;
 const alg_kind_t resampling_nearest = dnnl_resampling_nearest;
 const alg_kind_t resampling_linear = dnnl_resampling_linear;
 const alg_kind_t reduction_max = dnnl_reduction_max;
@@ -136,6 +137,9 @@ const alg_kind_t reduction_norm_lp_power_p_sum
         = dnnl_reduction_norm_lp_power_p_sum;
 const alg_kind_t softmax_accurate = dnnl_softmax_accurate;
 const alg_kind_t softmax_log = dnnl_softmax_log;
+const alg_kind_t embedding_bag_sum = dnnl_embedding_bag_sum;
+const alg_kind_t embedding_bag_mean = dnnl_embedding_bag_mean;
+const alg_kind_t embedding_bag_max = dnnl_embedding_bag_max;
 } // namespace alg_kind
 
 using data_type_t = dnnl_data_type_t;
@@ -1478,6 +1482,10 @@ const normalization_flags_t use_scale = dnnl_use_scale;
 const normalization_flags_t use_shift = dnnl_use_shift;
 const normalization_flags_t fuse_norm_relu = dnnl_fuse_norm_relu;
 const normalization_flags_t fuse_norm_add_relu = dnnl_fuse_norm_add_relu;
+const normalization_flags_t use_precomputed_sums = dnnl_use_precomputed_sums;
+const normalization_flags_t rms_norm = dnnl_rms_norm;
+const normalization_flags_t fuse_residual_add = dnnl_fuse_residual_add;
+const normalization_flags_t welford_stats = dnnl_welford_stats;
 } // namespace normalization_flags
 
 using engine_kind_t = dnnl_engine_kind_t;
@@ -1530,6 +1538,8 @@ const primitive_kind_t resampling = dnnl_resampling;
 const primitive_kind_t reduction = dnnl_reduction;
 const primitive_kind_t softmax = dnnl_softmax;
 const primitive_kind_t layer_normalization = dnnl_layer_normalization;
+const primitive_kind_t group_normalization = dnnl_group_normalization;
+const primitive_kind_t embedding_bag = dnnl_embedding_bag;
 
 // Internal only primitive kinds.
 const primitive_kind_t internal_only_start = (primitive_kind_t)(1 << 12);
@@ -1580,6 +1590,7 @@ const query_t direction = dnnl_query_direction;
 const query_t activation_kind = dnnl_query_activation_kind;
 const query_t kernel = dnnl_query_kernel;
 const query_t group_size_s64 = dnnl_query_group_size_s64;
+const query_t num_groups_s64 = dnnl_query_num_groups_s64;
 
 const query_t some_md = dnnl_query_some_md;
 const query_t src_md = dnnl_query_src_md;
@@ -1645,7 +1656,11 @@ struct deconvolution_pd_t;
 struct eltwise_bwd_pd_t;
 struct eltwise_fwd_pd_t;
 struct eltwise_pd_t;
+struct embedding_bag_pd_t;
 struct gemm_pd_t;
+struct group_normalization_bwd_pd_t;
+struct group_normalization_fwd_pd_t;
+struct group_normalization_pd_t;
 struct inner_product_bwd_data_pd_t;
 struct inner_product_bwd_weights_pd_t;
 struct inner_product_fwd_pd_t;
@@ -0,0 +1,102 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <assert.h>
+#include "oneapi/dnnl/dnnl.h"
+#include "opdesc.hpp"
+#include "primitive_desc_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::alg_kind;
+using namespace dnnl::impl::types;
+
+namespace {
+status_t embedding_bag_desc_init(embedding_bag_desc_t *embedding_bag_desc,
+        alg_kind_t alg_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *indices_desc, const memory_desc_t *offsets_desc,
+        const memory_desc_t *weights_desc, const memory_desc_t *dst_desc) {
+    bool args_ok = !any_null(embedding_bag_desc, src_desc, indices_desc,
+                           offsets_desc, dst_desc)
+            && one_of(alg_kind, embedding_bag_sum, embedding_bag_mean,
+                    embedding_bag_max)
+            && src_desc->ndims == 2 && indices_desc->ndims == 1
+            && offsets_desc->ndims == 1 && dst_desc->ndims == 2
+            && !memory_desc_wrapper(src_desc).format_any()
+            && indices_desc->data_type == data_type::s32
+            && offsets_desc->data_type == data_type::s32;
+    if (!args_ok) return invalid_arguments;
+
+    // Per-sample weights scale the rows before they are summed up, other
+    // pooling kinds have no meaningful definition for them.
+    const bool with_weights = weights_desc != nullptr
+            && !memory_desc_wrapper(weights_desc).is_zero();
+    args_ok = IMPLICATION(with_weights,
+            alg_kind == embedding_bag_sum && weights_desc->ndims == 1
+                    && weights_desc->dims[0] == indices_desc->dims[0]
+                    && weights_desc->data_type == data_type::f32);
+    if (!args_ok) return invalid_arguments;
+
+    // Every bag produces one row of the destination.
+    args_ok = dst_desc->dims[0] == offsets_desc->dims[0]
+            && dst_desc->dims[1] == src_desc->dims[1];
+    if (!args_ok) return invalid_arguments;
+
+    bool runtime_dims_or_strides
+            = memory_desc_wrapper(src_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(indices_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(offsets_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides()
+            || (with_weights
+                    && memory_desc_wrapper(weights_desc)
+                               .has_runtime_dims_or_strides());
+    if (runtime_dims_or_strides) return unimplemented;
+
+    auto ed = embedding_bag_desc_t();
+    ed.primitive_kind = primitive_kind::embedding_bag;
+    ed.alg_kind = alg_kind;
+
+    ed.src_desc = *src_desc;
+    ed.indices_desc = *indices_desc;
+    ed.offsets_desc = *offsets_desc;
+    ed.weights_desc = with_weights ? *weights_desc : zero_md();
+    ed.dst_desc = *dst_desc;
+
+    *embedding_bag_desc = ed;
+    return success;
+}
+} // namespace
+
+status_t dnnl_embedding_bag_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        alg_kind_t alg_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *indices_desc, const memory_desc_t *offsets_desc,
+        const memory_desc_t *weights_desc, const memory_desc_t *dst_desc,
+        const primitive_attr_t *attr) {
+    auto embedding_bag_desc = embedding_bag_desc_t();
+    CHECK(embedding_bag_desc_init(&embedding_bag_desc, alg_kind, src_desc,
+            indices_desc, offsets_desc, weights_desc, dst_desc));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&embedding_bag_desc, nullptr, attr);
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,179 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#ifndef COMMON_EMBEDDING_BAG_PD_HPP
+#define COMMON_EMBEDDING_BAG_PD_HPP
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+
+struct embedding_bag_pd_t : public primitive_desc_t {
+    static constexpr auto base_pkind = primitive_kind::embedding_bag;
+
+    typedef embedding_bag_pd_t base_class;
+    typedef embedding_bag_pd_t hint_class;
+
+    const embedding_bag_desc_t *desc() const { return &desc_; }
+    const op_desc_t *op_desc() const override {
+        return reinterpret_cast<const op_desc_t *>(this->desc());
+    }
+
+    status_t query(query_t what, int idx, void *result) const override {
+        switch (what) {
+            case query::alg_kind:
+                *(alg_kind_t *)result = desc()->alg_kind;
+                break;
+            default: return primitive_desc_t::query(what, idx, result);
+        }
+        return status::success;
+    }
+
+    arg_usage_t arg_usage(int arg) const override {
+        if (utils::one_of(arg, DNNL_ARG_SRC, DNNL_ARG_SRC_1, DNNL_ARG_SRC_2))
+            return arg_usage_t::input;
+        if (arg == DNNL_ARG_WEIGHTS && with_weights())
+            return arg_usage_t::input;
+        if (arg == DNNL_ARG_DST) return arg_usage_t::output;
+
+        return primitive_desc_t::arg_usage(arg);
+    }
+
+    const memory_desc_t *arg_md(int arg) const override {
+        switch (arg) {
+            case DNNL_ARG_SRC: return src_md(0);
+            case DNNL_ARG_SRC_1: return src_md(1);
+            case DNNL_ARG_SRC_2: return src_md(2);
+            case DNNL_ARG_WEIGHTS: return weights_md(0);
+            case DNNL_ARG_DST: return dst_md(0);
+            default: return primitive_desc_t::arg_md(arg);
+        }
+    }
+
+    // The table is src 0, indices and offsets are src 1 and src 2.
+    const memory_desc_t *src_md(int index = 0) const override {
+        switch (index) {
+            case 0: return &src_md_;
+            case 1: return &indices_md_;
+            case 2: return &offsets_md_;
+            default: return &glob_zero_md;
+        }
+    }
+    const memory_desc_t *weights_md(int index = 0) const override {
+        return index == 0 ? &weights_md_ : &glob_zero_md;
+    }
+    const memory_desc_t *dst_md(int index = 0) const override {
+        return index == 0 ? &dst_md_ : &glob_zero_md;
+    }
+
+    const memory_desc_t *indices_md() const { return src_md(1); }
+    const memory_desc_t *offsets_md() const { return src_md(2); }
+
+    int n_inputs() const override { return 3 + with_weights(); }
+    int n_outputs() const override { return 1; }
+
+    /* common embedding_bag aux functions */
+    // Number of rows in the table.
+    dim_t R() const { return desc_.src_desc.dims[0]; }
+    // Embedding dimension.
+    dim_t D() const { return desc_.src_desc.dims[1]; }
+    // Number of indices.
+    dim_t NI() const { return desc_.indices_desc.dims[0]; }
+    // Number of bags.
+    dim_t NB() const { return desc_.offsets_desc.dims[0]; }
+
+    bool with_weights() const {
+        return !memory_desc_wrapper(desc_.weights_desc).is_zero();
+    }
+
+    bool has_zero_dim_memory() const {
+        return memory_desc_wrapper(desc_.dst_desc).has_zero_dim();
+    }
+
+    // Computes the range of indices pooled into bag @p b. The last bag ends
+    // with the indices. Returns false for offsets that do not form a valid
+    // range.
+    bool bag_range(
+            const int32_t *offsets, dim_t b, dim_t &beg, dim_t &end) const {
+        beg = offsets[b];
+        end = b + 1 < NB() ? offsets[b + 1] : NI();
+        return 0 <= beg && beg <= end && end <= NI();
+    }
+
+    // Returns the mask of the table scales: 0 for a common scale and 1 for
+    // a scale per row.
+    int src_scales_mask() const {
+        return attr()->scales_.get(DNNL_ARG_SRC).mask_;
+    }
+
+protected:
+    embedding_bag_desc_t desc_;
+
+    memory_desc_t src_md_;
+    memory_desc_t indices_md_;
+    memory_desc_t offsets_md_;
+    memory_desc_t weights_md_;
+    memory_desc_t dst_md_;
+
+    embedding_bag_pd_t(const embedding_bag_desc_t *adesc,
+            const primitive_attr_t *attr, const hint_class *hint_fwd)
+        : primitive_desc_t(attr, base_pkind)
+        , desc_(*adesc)
+        , src_md_(desc_.src_desc)
+        , indices_md_(desc_.indices_desc)
+        , offsets_md_(desc_.offsets_desc)
+        , weights_md_(desc_.weights_desc)
+        , dst_md_(desc_.dst_desc) {}
+
+    status_t set_default_params() {
+        using namespace format_tag;
+        if (dst_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(dst_md_, ab));
+        if (indices_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(indices_md_, a));
+        if (offsets_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(offsets_md_, a));
+        if (with_weights() && weights_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_md_, a));
+        return status::success;
+    }
+
+    // Table scales are only meaningful for quantized tables and may be
+    // either common or per row.
+    bool attr_scales_ok() const {
+        const auto &scales = attr()->scales_;
+        for (const auto &e : scales.scales_) {
+            if (e.second.has_default_values()) continue;
+            if (e.first != DNNL_ARG_SRC) return false;
+        }
+        return IMPLICATION(!scales.get(DNNL_ARG_SRC).has_default_values(),
+                src_md_.data_type == data_type::s8
+                        && utils::one_of(src_scales_mask(), 0, 1));
+    }
+};
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,145 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include "oneapi/dnnl/dnnl.h"
+#include "opdesc.hpp"
+#include "primitive_desc_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::prop_kind;
+using namespace dnnl::impl::types;
+
+namespace {
+status_t gnorm_desc_init(group_normalization_desc_t *gnorm_desc,
+        prop_kind_t prop_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *dst_desc, const memory_desc_t *diff_src_desc,
+        const memory_desc_t *diff_dst_desc, dim_t groups, float epsilon,
+        unsigned flags) {
+    bool args_ok = !any_null(gnorm_desc, src_desc) && 2 <= src_desc->ndims
+            && src_desc->ndims <= 5
+            && (flags
+                       & ~(normalization_flags::use_global_stats
+                               | normalization_flags::use_scale
+                               | normalization_flags::use_shift))
+                    == 0;
+    if (!args_ok) return invalid_arguments;
+
+    // Channels have to be split into groups of equal size.
+    const dim_t C = src_desc->dims[1];
+    args_ok = groups > 0 && C % groups == 0;
+    if (!args_ok) return invalid_arguments;
+
+    bool is_fwd
+            = prop_kind == forward_training || prop_kind == forward_inference;
+    args_ok = IMPLICATION(is_fwd, dst_desc != nullptr)
+            && IMPLICATION(!is_fwd, !any_null(diff_src_desc, diff_dst_desc))
+            && IMPLICATION(is_fwd, !memory_desc_wrapper(src_desc).format_any());
+    if (!args_ok) return invalid_arguments;
+
+    auto gd = group_normalization_desc_t();
+    gd.primitive_kind = primitive_kind::group_normalization;
+    gd.prop_kind = prop_kind;
+
+    bool runtime_dims_or_strides
+            = memory_desc_wrapper(src_desc).has_runtime_dims_or_strides()
+            || memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides();
+    if (!is_fwd)
+        runtime_dims_or_strides = runtime_dims_or_strides
+                || memory_desc_wrapper(diff_src_desc)
+                           .has_runtime_dims_or_strides()
+                || memory_desc_wrapper(diff_dst_desc)
+                           .has_runtime_dims_or_strides();
+    if (runtime_dims_or_strides) return unimplemented;
+
+    gd.src_desc = *src_desc;
+    if (is_fwd) gd.dst_desc = *dst_desc;
+    if (!is_fwd) gd.diff_src_desc = *diff_src_desc;
+    if (!is_fwd) gd.diff_dst_desc = *diff_dst_desc;
+
+    // Statistics are computed per image and group.
+    dims_t stat_dims = {src_desc->dims[0], groups};
+    CHECK(memory_desc_init_by_tag(
+            gd.stat_desc, 2, stat_dims, data_type::f32, format_tag::ab));
+
+    dims_t scaleshift_dims = {C};
+    CHECK(memory_desc_init_by_tag(gd.scaleshift_desc, 1, scaleshift_dims,
+            data_type::f32, format_tag::x));
+    if (gd.prop_kind == backward)
+        gd.diff_scaleshift_desc = gd.scaleshift_desc;
+
+    gd.groups = groups;
+    gd.group_norm_epsilon = epsilon;
+    gd.flags = flags;
+
+    if (is_fwd) {
+        bool consistency = gd.src_desc.ndims == gd.dst_desc.ndims
+                && array_cmp(
+                        gd.src_desc.dims, gd.dst_desc.dims, gd.src_desc.ndims);
+        if (!consistency) return invalid_arguments;
+    } else {
+        bool consistency = gd.diff_src_desc.ndims == gd.src_desc.ndims
+                && array_cmp(gd.diff_src_desc.dims, gd.src_desc.dims,
+                        gd.diff_src_desc.ndims)
+                && gd.diff_src_desc.ndims == gd.diff_dst_desc.ndims
+                && array_cmp(gd.diff_src_desc.dims, gd.diff_dst_desc.dims,
+                        gd.diff_src_desc.ndims);
+        if (!consistency) return invalid_arguments;
+    }
+
+    *gnorm_desc = gd;
+    return success;
+}
+} // namespace
+
+status_t dnnl_group_normalization_forward_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        prop_kind_t prop_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *dst_desc, dim_t groups, float epsilon,
+        unsigned flags, const primitive_attr_t *attr) {
+    if (!one_of(prop_kind, forward_training, forward_inference))
+        return invalid_arguments;
+
+    auto gnorm_desc = group_normalization_desc_t();
+    CHECK(gnorm_desc_init(&gnorm_desc, prop_kind, src_desc, dst_desc, nullptr,
+            nullptr, groups, epsilon, flags));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&gnorm_desc, nullptr, attr);
+}
+
+status_t dnnl_group_normalization_backward_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        prop_kind_t prop_kind, const memory_desc_t *diff_src_desc,
+        const memory_desc_t *diff_dst_desc, const memory_desc_t *src_desc,
+        dim_t groups, float epsilon, unsigned flags,
+        const primitive_desc_iface_t *hint_fwd_pd,
+        const primitive_attr_t *attr) {
+    if (!one_of(prop_kind, backward, backward_data)) return invalid_arguments;
+
+    auto gnorm_desc = group_normalization_desc_t();
+    CHECK(gnorm_desc_init(&gnorm_desc, prop_kind, src_desc, nullptr,
+            diff_src_desc, diff_dst_desc, groups, epsilon, flags));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&gnorm_desc, hint_fwd_pd, attr);
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
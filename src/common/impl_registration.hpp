@@ -96,6 +96,20 @@
     {}
 #endif
 
+#if BUILD_PRIMITIVE_ALL || BUILD_EMBEDDING_BAG
+#define REG_EMBEDDING_BAG_P(...) __VA_ARGS__
+#else
+#define REG_EMBEDDING_BAG_P(...) \
+    {}
+#endif
+
+#if BUILD_PRIMITIVE_ALL || BUILD_GROUP_NORMALIZATION
+#define REG_GNORM_P(...) __VA_ARGS__
+#else
+#define REG_GNORM_P(...) \
+    {}
+#endif
+
 #if BUILD_PRIMITIVE_ALL || BUILD_INNER_PRODUCT
 #define REG_IP_P(...) __VA_ARGS__
 #else
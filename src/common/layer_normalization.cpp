@@ -40,12 +40,17 @@ status_t lnorm_desc_init(layer_normalization_desc_t *lnorm_desc,
             && (flags
                        & ~(normalization_flags::use_global_stats
                                | normalization_flags::use_scale
-                               | normalization_flags::use_shift))
+                               | normalization_flags::use_shift
+                               | normalization_flags::rms_norm
+                               | normalization_flags::fuse_residual_add))
                     == 0;
     if (!args_ok) return invalid_arguments;
 
     bool is_fwd
             = prop_kind == forward_training || prop_kind == forward_inference;
+    // Residual add is a forward-only fusion: its gradient is diff_src itself.
+    if (!is_fwd && (flags & normalization_flags::fuse_residual_add))
+        return invalid_arguments;
     args_ok = IMPLICATION(is_fwd, dst_desc != nullptr)
             && IMPLICATION(!is_fwd, !any_null(diff_src_desc, diff_dst_desc))
             && IMPLICATION(is_fwd, !memory_desc_wrapper(src_desc).format_any());
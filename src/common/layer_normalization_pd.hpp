@@ -75,6 +75,12 @@ struct layer_normalization_pd_t : public primitive_desc_t {
     bool use_global_stats() const {
         return desc_.flags & normalization_flags::use_global_stats;
     }
+    bool use_rms_norm() const {
+        return desc_.flags & normalization_flags::rms_norm;
+    }
+    bool fuse_residual_add() const {
+        return desc_.flags & normalization_flags::fuse_residual_add;
+    }
 
     bool is_fwd() const {
         return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
@@ -156,6 +162,7 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
         if (arg == DNNL_ARG_SRC) return arg_usage_t::input;
         if (arg == DNNL_ARG_DST) return arg_usage_t::output;
 
+        if (arg == DNNL_ARG_MEAN && use_rms_norm()) return arg_usage_t::unused;
         if (utils::one_of(arg, DNNL_ARG_MEAN, DNNL_ARG_VARIANCE)) {
             if (stats_are_src()) return arg_usage_t::input;
             if (!stats_are_src() && is_training()) return arg_usage_t::output;
@@ -165,6 +172,12 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
         if (arg == DNNL_ARG_SCALE && use_scale()) return arg_usage_t::input;
         if (arg == DNNL_ARG_SHIFT && use_shift()) return arg_usage_t::input;
 
+        // The residual sum output is optional, see `dnnl_fuse_residual_add`.
+        if (arg == DNNL_ARG_SRC_1 && fuse_residual_add())
+            return arg_usage_t::input;
+        if (arg == DNNL_ARG_DST_1 && fuse_residual_add())
+            return arg_usage_t::output;
+
         return primitive_desc_t::arg_usage(arg);
     }
 
@@ -172,6 +185,9 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
         switch (arg) {
             case DNNL_ARG_SRC: return src_md(0);
             case DNNL_ARG_DST: return dst_md(0);
+            case DNNL_ARG_SRC_1:
+            case DNNL_ARG_DST_1:
+                return fuse_residual_add() ? src_md(0) : &glob_zero_md;
             case DNNL_ARG_MEAN: return stats_are_src() ? src_md(1) : dst_md(1);
             case DNNL_ARG_VARIANCE:
                 return stats_are_src() ? src_md(2) : dst_md(2);
@@ -199,12 +215,16 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
     }
 
     int n_inputs() const override {
-        return 1 + 2 * stats_are_src() + use_scale() + use_shift();
+        return 1 + n_stats() * stats_are_src() + use_scale() + use_shift()
+                + fuse_residual_add();
     }
     int n_outputs() const override {
-        return 1 + 2 * (!stats_are_src()) * is_training();
+        return 1 + n_stats() * (!stats_are_src()) * is_training();
     }
 
+    // Only the variance is used in the RMS mode.
+    int n_stats() const { return use_rms_norm() ? 1 : 2; }
+
 protected:
     memory_desc_t dst_md_;
 
@@ -242,6 +262,7 @@ struct layer_normalization_bwd_pd_t : public layer_normalization_pd_t {
     typedef layer_normalization_fwd_pd_t hint_class;
 
     arg_usage_t arg_usage(int arg) const override {
+        if (arg == DNNL_ARG_MEAN && use_rms_norm()) return arg_usage_t::unused;
         if (utils::one_of(arg, DNNL_ARG_SRC, DNNL_ARG_MEAN, DNNL_ARG_VARIANCE,
                     DNNL_ARG_DIFF_DST))
             return arg_usage_t::input;
@@ -291,7 +312,9 @@ struct layer_normalization_bwd_pd_t : public layer_normalization_pd_t {
         return index == 0 ? &diff_scaleshift_md_ : &glob_zero_md;
     }
 
-    int n_inputs() const override { return 4 + use_scale() + use_shift(); }
+    int n_inputs() const override {
+        return 4 - use_rms_norm() + use_scale() + use_shift();
+    }
     int n_outputs() const override {
         return 1
                 + (desc_.prop_kind == prop_kind::backward)
@@ -137,7 +137,9 @@ protected:
         , src_md_(desc_.src_desc)
         , weights_md_(desc_.weights_desc)
         , bias_md_(desc_.bias_desc)
-        , dst_md_(desc_.dst_desc) {}
+        , dst_md_(desc_.dst_desc) {
+        init_dst_stats_md(dst_md_.dims[dst_md_.ndims - 1]);
+    }
 
     // temporary solution to deal with format `any`
     bool set_default_formats() {
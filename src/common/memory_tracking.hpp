@@ -159,6 +159,7 @@ enum {
     key_bnorm_tmp_diff_ss,
     key_bnorm_tmp_stats,
     key_bnorm_reduction,
+    key_bnorm_welford,
     key_brgemm_primitive_batch,
     key_brgemm_primitive_buffer,
     key_brgemm_primitive_buffer_a,
@@ -196,6 +197,8 @@ enum {
     key_conv_gemm_col,
     key_conv_gemm_imtr,
     key_conv_gemm_zp_src_comp,
+    key_conv_grouped_wei_packed,
+    key_conv_grouped_wei_plain,
     key_conv_int_dat_in_acc_dt,
     key_conv_padded_bias,
     key_conv_rtus_space,
@@ -213,6 +216,7 @@ enum {
     key_deconv_bias,
     key_deconv_sum,
     key_deconv_zp,
+    key_dst_stats_reduction,
     key_eltwise_diff_dst,
     key_eltwise_src,
     key_fusion_forward_scratchpad,
@@ -220,6 +224,9 @@ enum {
     key_gemm_int_c_in_acc_dt,
     key_gemm_tmp_buffer,
     key_gemm_flag,
+    key_gnorm_scale_shift,
+    key_gnorm_tmp_mean,
+    key_gnorm_tmp_var,
     key_iprod_bias_bf16_convert_wsp,
     key_iprod_dst_bf16_convert_wsp,
     key_iprod_dst_reorder,
@@ -229,6 +236,7 @@ enum {
     key_lnorm_tmp_var,
     key_lnorm_tmp_diff_ss,
     key_lnorm_reduction,
+    key_lnorm_tmp_residual,
     key_matmul_dst_in_acc_dt,
     key_pool_dst_bf16cvt,
     key_pool_dst_plain2blocked_cvt,
@@ -327,6 +327,36 @@ struct layer_normalization_desc_t {
     memory_desc_t diff_dst_desc;
 };
 
+// A descriptor of a Group Normalization operation.
+struct group_normalization_desc_t {
+    // The kind of primitive. Used for self-identifying the primitive
+    // descriptor. Must be #dnnl_group_normalization.
+    primitive_kind_t primitive_kind;
+    // The kind of propagation. Possible values: #dnnl_forward_training,
+    // #dnnl_forward_inference, #dnnl_backward, and #dnnl_backward_data.
+    prop_kind_t prop_kind;
+    // Source memory descriptor.
+    memory_desc_t src_desc;
+    // Source gradient memory descriptor.
+    memory_desc_t diff_src_desc;
+    // Scale and shift data and gradient memory descriptors.
+    // Scaleshift memory descriptor uses 1D #dnnl_x format[Channels].
+    memory_desc_t scaleshift_desc;
+    memory_desc_t diff_scaleshift_desc;
+    // Destination memory descriptor.
+    memory_desc_t dst_desc;
+    // Destination gradient memory descriptor.
+    memory_desc_t diff_dst_desc;
+    // Statistics (mean or variance) descriptor use 2D #dnnl_ab
+    // format[Batch, Groups].
+    memory_desc_t stat_desc;
+    // Number of groups the channels are split into.
+    dim_t groups;
+    // Group normalization epsilon parameter.
+    float group_norm_epsilon;
+    unsigned flags;
+};
+
 // A descriptor of a Local Response Normalization (LRN) operation.
 struct lrn_desc_t {
     // The kind of primitive. Used for self-identifying the primitive
@@ -386,6 +416,28 @@ struct reduction_desc_t {
     float p, eps;
 };
 
+// A descriptor of embedding bag operation.
+struct embedding_bag_desc_t {
+    // The kind of primitive. Used for self-identifying the primitive
+    // descriptor. Must be #dnnl_embedding_bag.
+    primitive_kind_t primitive_kind;
+    // The kind of pooling algorithm. Possible values:
+    // #dnnl_embedding_bag_sum, #dnnl_embedding_bag_mean,
+    // #dnnl_embedding_bag_max.
+    alg_kind_t alg_kind;
+    // Embedding table memory descriptor uses 2D #dnnl_ab format[Rows, Dim].
+    memory_desc_t src_desc;
+    // Indices memory descriptor uses 1D #dnnl_a format[Indices].
+    memory_desc_t indices_desc;
+    // Offsets memory descriptor uses 1D #dnnl_a format[Bags].
+    memory_desc_t offsets_desc;
+    // Per-sample weights memory descriptor uses 1D #dnnl_a format[Indices].
+    // Zero memory descriptor when per-sample weights are not used.
+    memory_desc_t weights_desc;
+    // Destination memory descriptor uses 2D format[Bags, Dim].
+    memory_desc_t dst_desc;
+};
+
 /// A descriptor of a Softmax operation.
 struct softmax_desc_t {
     // The kind of primitive. Used for self-identifying the primitive
@@ -416,10 +468,12 @@ struct binary_desc_t {
     primitive_kind_t primitive_kind;
     // The kind of the binary algorithm. Possible values:
     // #dnnl_binary_add, #dnnl_binary_mul, #dnnl_binary_max, #dnnl_binary_min,
-    // #dnnl_binary_div and #dnnl_binary_sub.
+    // #dnnl_binary_div, #dnnl_binary_sub, the comparisons and
+    // #dnnl_binary_select.
     alg_kind_t alg_kind;
-    // Source memory descriptors.
-    memory_desc_t src_desc[2];
+    // Source memory descriptors. The third one is the condition of
+    // #dnnl_binary_select and is a zero memory descriptor otherwise.
+    memory_desc_t src_desc[3];
     // Destination memory descriptor.
     memory_desc_t dst_desc;
 };
@@ -571,6 +625,7 @@ struct op_desc_t {
         lrn_desc_t lrn;
         batch_normalization_desc_t batch_normalization;
         layer_normalization_desc_t layer_normalization;
+        group_normalization_desc_t group_normalization;
         inner_product_desc_t inner_product;
         rnn_desc_t rnn;
         gemm_desc_t gemm;
@@ -582,6 +637,7 @@ struct op_desc_t {
         resampling_desc_t resampling;
         zero_pad_desc_t zero_pad;
         reduction_desc_t reduction;
+        embedding_bag_desc_t embedding_bag;
     };
 
 #define DECL_CTOR_AND_CONVERTERS(c_type) \
@@ -602,6 +658,7 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(lrn_desc_t);
     DECL_CTOR_AND_CONVERTERS(batch_normalization_desc_t);
     DECL_CTOR_AND_CONVERTERS(layer_normalization_desc_t);
+    DECL_CTOR_AND_CONVERTERS(group_normalization_desc_t);
     DECL_CTOR_AND_CONVERTERS(inner_product_desc_t);
     DECL_CTOR_AND_CONVERTERS(rnn_desc_t);
     DECL_CTOR_AND_CONVERTERS(gemm_desc_t);
@@ -613,6 +670,7 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(resampling_desc_t);
     DECL_CTOR_AND_CONVERTERS(zero_pad_desc_t);
     DECL_CTOR_AND_CONVERTERS(reduction_desc_t);
+    DECL_CTOR_AND_CONVERTERS(embedding_bag_desc_t);
 
     // concat_desc_t and sum_desc_t have data members which have non-trivial
     // special member functions hence the default destructor is implicitly
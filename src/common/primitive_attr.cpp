@@ -116,6 +116,9 @@ bool primitive_attr_t::has_default_values(dnnl_primitive_attr::skip_mask_t mask,
     bool gpu_attr_ok = IMPLICATION((bool)(~mask & smask_t::gpu_attr),
             !gpu_attr_ || gpu_attr_->has_default_values());
     CHECK_ARG(gpu_attr_ok);
+    CHECK_ARG(IMPLICATION((bool)(~mask & smask_t::dst_stats), !dst_stats_));
+    CHECK_ARG(IMPLICATION((bool)(~mask & smask_t::src_prescale_mask),
+            src_prescale_ == 1.f && types::is_zero_md(&src_mask_md_)));
     CHECK_ARG(this->defined(defined_mask));
     return ok;
 #undef CHECK_MASK
@@ -333,10 +336,43 @@ status_t primitive_attr_t::set_scratchpad_mode(
     return success;
 }
 
+status_t primitive_attr_t::set_scratchpad_limit(size_t scratchpad_limit) {
+    scratchpad_limit_ = scratchpad_limit;
+    return success;
+}
+
 status_t primitive_attr_t::set_post_ops(const post_ops_t &post_ops) {
     return post_ops_.copy_from(post_ops);
 }
 
+status_t primitive_attr_t::set_dst_stats(bool dst_stats) {
+    dst_stats_ = dst_stats;
+    return success;
+}
+
+status_t primitive_attr_t::set_src_prescale(float scale) {
+    src_prescale_ = scale;
+    return success;
+}
+
+status_t primitive_attr_t::set_src_mask(const memory_desc_t *md) {
+    if (types::is_zero_md(md)) {
+        src_mask_md_ = types::zero_md();
+        return success;
+    }
+
+    const memory_desc_wrapper mdw(md);
+    const bool ok = md->ndims > 0 && md->ndims <= DNNL_MAX_NDIMS
+            && md->format_kind == format_kind::blocked
+            && !mdw.has_runtime_dims_or_strides()
+            && utils::one_of(md->data_type, data_type::f32, data_type::bf16,
+                    data_type::f16);
+    if (!ok) return invalid_arguments;
+
+    src_mask_md_ = *md;
+    return success;
+}
+
 status_t primitive_attr_t::set_default_formats(const memory_desc_t *dst_md) {
     return post_ops_.set_default_formats(dst_md);
 }
@@ -383,6 +419,44 @@ status_t dnnl_primitive_attr_set_fpmath_mode(
     return attr->set_fpmath_mode(mode);
 }
 
+status_t dnnl_primitive_attr_get_dst_stats(
+        const primitive_attr_t *attr, int *value) {
+    if (any_null(attr, value)) return invalid_arguments;
+    *value = attr->dst_stats_;
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_dst_stats(primitive_attr_t *attr, int value) {
+    if (any_null(attr)) return invalid_arguments;
+    return attr->set_dst_stats(value != 0);
+}
+
+status_t dnnl_primitive_attr_get_src_prescale(
+        const primitive_attr_t *attr, float *scale) {
+    if (any_null(attr, scale)) return invalid_arguments;
+    *scale = attr->src_prescale_;
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_src_prescale(
+        primitive_attr_t *attr, float scale) {
+    if (any_null(attr)) return invalid_arguments;
+    return attr->set_src_prescale(scale);
+}
+
+status_t dnnl_primitive_attr_get_src_mask(
+        const primitive_attr_t *attr, const memory_desc_t **mask_desc) {
+    if (any_null(attr, mask_desc)) return invalid_arguments;
+    *mask_desc = &attr->src_mask_md_;
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_src_mask(
+        primitive_attr_t *attr, const memory_desc_t *mask_desc) {
+    if (any_null(attr)) return invalid_arguments;
+    return attr->set_src_mask(mask_desc);
+}
+
 status_t dnnl_primitive_attr_get_scratchpad_mode(
         const primitive_attr_t *attr, scratchpad_mode_t *scratchpad_mode) {
     if (any_null(attr, scratchpad_mode)) return invalid_arguments;
@@ -399,6 +473,22 @@ status_t dnnl_primitive_attr_set_scratchpad_mode(
     return attr->set_scratchpad_mode(scratchpad_mode);
 }
 
+status_t dnnl_primitive_attr_get_scratchpad_limit(
+        const primitive_attr_t *attr, size_t *scratchpad_limit) {
+    if (any_null(attr, scratchpad_limit)) return invalid_arguments;
+
+    *scratchpad_limit = attr->scratchpad_limit_;
+
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_scratchpad_limit(
+        primitive_attr_t *attr, size_t scratchpad_limit) {
+    if (any_null(attr)) return invalid_arguments;
+
+    return attr->set_scratchpad_limit(scratchpad_limit);
+}
+
 status_t dnnl_primitive_attr_set_scales_mask(
         primitive_attr_t *attr, int arg, int mask) {
     bool ok = attr && mask >= 0 && arg >= 0
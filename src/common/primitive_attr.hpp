@@ -621,7 +621,11 @@ private:
 struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl_primitive_attr()
         : scratchpad_mode_(dnnl::impl::scratchpad_mode::library)
-        , fpmath_mode_(dnnl::impl::get_fpmath_mode()) {}
+        , scratchpad_limit_(0)
+        , fpmath_mode_(dnnl::impl::get_fpmath_mode())
+        , dst_stats_(false)
+        , src_prescale_(1.f)
+        , src_mask_md_(dnnl::impl::types::zero_md()) {}
 
     dnnl_primitive_attr *clone() const {
         return new dnnl_primitive_attr(*this);
@@ -639,7 +643,11 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         scales_ = other.scales_;
         zero_points_ = other.zero_points_;
         scratchpad_mode_ = other.scratchpad_mode_;
+        scratchpad_limit_ = other.scratchpad_limit_;
         fpmath_mode_ = other.fpmath_mode_;
+        dst_stats_ = other.dst_stats_;
+        src_prescale_ = other.src_prescale_;
+        src_mask_md_ = other.src_mask_md_;
         CHECK(post_ops_.copy_from(other.post_ops_));
         rnn_data_qparams_ = other.rnn_data_qparams_;
         CHECK(rnn_weights_qparams_.copy_from(other.rnn_weights_qparams_));
@@ -667,12 +675,15 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         rnn_tparams = 1u << 9,
         sum_dt = 1u << 10,
         rnn_weights_projection_qparams = 1u << 11,
-        gpu_attr = 1u << 12
+        gpu_attr = 1u << 12,
+        dst_stats = 1u << 13,
+        src_prescale_mask = 1u << 14
     };
 
     /** Returns true if the attributes have default values.
      *
-     * @note The scratchpad_mode_ is not take into account */
+     * @note The scratchpad_mode_ and scratchpad_limit_ are not take into
+     * account */
     bool has_default_values(skip_mask_t mask = skip_mask_t::none,
             dnnl::impl::data_type_t dst_dt = dnnl_data_type_undef) const;
 
@@ -681,7 +692,11 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
 
     bool operator==(const dnnl_primitive_attr &rhs) const {
         bool ret = scratchpad_mode_ == rhs.scratchpad_mode_
+                && scratchpad_limit_ == rhs.scratchpad_limit_
                 && fpmath_mode_ == rhs.fpmath_mode_
+                && dst_stats_ == rhs.dst_stats_
+                && src_prescale_ == rhs.src_prescale_
+                && src_mask_md_ == rhs.src_mask_md_
                 && output_scales_ == rhs.output_scales_
                 && scales_ == rhs.scales_ && zero_points_ == rhs.zero_points_
                 && post_ops_ == rhs.post_ops_
@@ -699,7 +714,11 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl::impl::status_t set_fpmath_mode(dnnl::impl::fpmath_mode_t fpmath_mode);
     dnnl::impl::status_t set_scratchpad_mode(
             dnnl::impl::scratchpad_mode_t scratchpad_mode);
+    dnnl::impl::status_t set_scratchpad_limit(size_t scratchpad_limit);
     dnnl::impl::status_t set_post_ops(const dnnl::impl::post_ops_t &post_ops);
+    dnnl::impl::status_t set_dst_stats(bool dst_stats);
+    dnnl::impl::status_t set_src_prescale(float scale);
+    dnnl::impl::status_t set_src_mask(const dnnl::impl::memory_desc_t *md);
     dnnl::impl::status_t set_gpu_attr(
             const dnnl::impl::primitive_attr_item_t &gpu_attr);
     dnnl::impl::status_t set_default_formats(
@@ -732,7 +751,16 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl::impl::arg_scales_t scales_;
     dnnl::impl::zero_points_t zero_points_;
     dnnl::impl::scratchpad_mode_t scratchpad_mode_;
+    // Preferred upper bound of the scratchpad size in bytes, 0 means no limit.
+    // This is a hint, implementations are free to ignore it.
+    size_t scratchpad_limit_;
     dnnl::impl::fpmath_mode_t fpmath_mode_;
+    // Compute per-channel sums and sums of squares of dst
+    bool dst_stats_;
+    // src <- src * src_prescale_ + mask, applied before the primitive
+    // operation. The mask is broadcast along the dimensions of size 1.
+    float src_prescale_;
+    dnnl::impl::memory_desc_t src_mask_md_;
     dnnl::impl::post_ops_t post_ops_;
     dnnl::impl::rnn_data_qparams_t rnn_data_qparams_;
     dnnl::impl::scales_t rnn_weights_qparams_;
@@ -48,11 +48,14 @@ struct primitive_t;
 // Primitive descriptor implementation
 struct primitive_desc_t : public c_compatible {
     primitive_desc_t(const primitive_attr_t *attr, primitive_kind_t kind)
-        : attr_(*attr), kind_(kind), pd_iterator_offset_(0) {
+        : attr_(*attr)
+        , kind_(kind)
+        , pd_iterator_offset_(0)
+        , dst_stats_md_() {
         is_initialized_ = is_initialized_ && attr_.is_initialized();
     }
 
-    primitive_desc_t(primitive_kind_t kind) : kind_(kind) {}
+    primitive_desc_t(primitive_kind_t kind) : kind_(kind), dst_stats_md_() {}
 
     bool is_initialized() const { return is_initialized_; }
 
@@ -111,6 +114,8 @@ struct primitive_desc_t : public c_compatible {
             return arg_usage_t::input;
         if (arg == DNNL_ARG_SCRATCHPAD && !is_zero_md(scratchpad_md()))
             return arg_usage_t::output;
+        if (arg == DNNL_ARG_ATTR_DST_STATS && !is_zero_md(dst_stats_md()))
+            return arg_usage_t::output;
         for (int idx = 0; idx < attr()->post_ops_.len(); ++idx) {
             using namespace primitive_kind;
             if (post_op_has_proper_input(
@@ -143,6 +148,7 @@ struct primitive_desc_t : public c_compatible {
         switch (arg) {
             case DNNL_ARG_WORKSPACE: return workspace_md(0);
             case DNNL_ARG_SCRATCHPAD: return scratchpad_md(0);
+            case DNNL_ARG_ATTR_DST_STATS: return dst_stats_md();
             default: return &glob_zero_md;
         }
     }
@@ -174,6 +180,17 @@ struct primitive_desc_t : public c_compatible {
                 scratchpad_md_, size ? 1 : 0, dims, data_type::u8, dnnl_x);
     }
 
+    // Per-channel sums and sums of squares of dst, see
+    // primitive_attr_t::dst_stats_. Zero unless the attribute is set.
+    const memory_desc_t *dst_stats_md() const { return &dst_stats_md_; }
+
+    void init_dst_stats_md(dim_t C) {
+        if (!attr_.dst_stats_) return;
+        dims_t dims = {2, C};
+        memory_desc_init_by_tag(
+                dst_stats_md_, 2, dims, data_type::f32, format_tag::ab);
+    }
+
     /** returns the scratchpad size for the given scratchpad mode. */
     dim_t scratchpad_size(scratchpad_mode_t mode) const {
         if (mode != attr_.scratchpad_mode_) return 0;
@@ -285,6 +302,7 @@ protected:
     int pd_iterator_offset_;
 
     memory_desc_t scratchpad_md_;
+    memory_desc_t dst_stats_md_;
 
     mutable pd_info_t info_;
     mutable cache_blob_id_t cache_blob_id_;
@@ -47,6 +47,8 @@ status_t cvt_primitive_args(const primitive_desc_t *pd, int nargs,
                 args[arg] = {mem, true};
                 n_inputs++;
                 extra_inputs += (arg == DNNL_ARG_ATTR_OUTPUT_SCALES)
+                        // optional RNN sequence lengths
+                        || (arg == DNNL_ARG_SEQ_LENGTHS)
                         || (arg & DNNL_ARG_ATTR_ZERO_POINTS)
                         || (arg & DNNL_ARG_ATTR_SCALES)
                         // 1x1 + dw conv fusion
@@ -65,7 +67,12 @@ status_t cvt_primitive_args(const primitive_desc_t *pd, int nargs,
                 if (args.count(arg) != 0) return invalid_arguments;
                 args[arg] = {mem, false};
                 n_outputs++;
-                extra_outputs += (arg == DNNL_ARG_SCRATCHPAD);
+                extra_outputs += (arg == DNNL_ARG_SCRATCHPAD)
+                        || (arg == DNNL_ARG_ATTR_DST_STATS)
+                        // optional layer normalization residual sum
+                        || (arg == DNNL_ARG_DST_1
+                                && pd->kind()
+                                        == primitive_kind::layer_normalization);
                 break;
             case primitive_desc_t::arg_usage_t::unused: break;
         }
@@ -319,6 +319,17 @@ status_t rnn_common_fwd_desc_init(rnn_desc_t *rnn_desc, prop_kind_t prop_kind,
             weights_peephole_desc, weights_projection_desc, bias_desc,
             dst_layer_desc, dst_iter_desc, dst_iter_c_desc}));
 
+    // check stateful execution restrictions: the states are kept inside the
+    // primitive, so they cannot be passed explicitly
+    if (flags & ~dnnl_rnn_flags_stateful) return invalid_arguments;
+    if (flags & dnnl_rnn_flags_stateful) {
+        args_ok = args_ok && prop_kind == prop_kind::forward_inference
+                && direction == dnnl_unidirectional_left2right
+                && is_zero_md(src_iter_desc) && is_zero_md(src_iter_c_desc)
+                && is_zero_md(dst_iter_desc) && is_zero_md(dst_iter_c_desc);
+        if (!args_ok) return invalid_arguments;
+    }
+
     // Create the descriptor
     auto rd = rnn_desc_t();
 
@@ -392,6 +403,9 @@ status_t rnn_common_bwd_desc_init(rnn_desc_t *rnn_desc, prop_kind_t prop_kind,
                     diff_dst_layer_desc);
     if (!args_ok) return invalid_arguments;
 
+    // stateful execution is supported for inference only
+    if (flags != dnnl_rnn_flags_undef) return invalid_arguments;
+
     if (cell_kind == dnnl_vanilla_rnn) {
         using namespace alg_kind;
         args_ok = args_ok
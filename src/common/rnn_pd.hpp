@@ -114,6 +114,8 @@ struct rnn_pd_t : public primitive_desc_t {
                 prop_kind::forward_inference);
     }
 
+    bool is_stateful() const { return desc_.flags & dnnl_rnn_flags_stateful; }
+
     dim_t T() const { return desc_.src_layer_desc.dims[0]; }
     dim_t MB() const { return desc_.src_layer_desc.dims[1]; }
 
@@ -184,6 +186,12 @@ struct rnn_pd_t : public primitive_desc_t {
 
     dnnl_rnn_direction_t direction() const { return desc_.direction; }
 
+    // Implementations that support variable-length sequences initialize
+    // seq_lengths_md_, the lengths are then an optional execution argument.
+    bool with_seq_lengths() const {
+        return !memory_desc_wrapper(seq_lengths_md_).is_zero();
+    }
+
 protected:
     rnn_desc_t desc_;
     const rnn_fwd_pd_t *hint_fwd_pd_;
@@ -201,6 +209,7 @@ protected:
     memory_desc_t dst_iter_c_md_;
 
     memory_desc_t ws_md_;
+    memory_desc_t seq_lengths_md_;
 
     rnn_pd_t(const rnn_desc_t *adesc, const primitive_attr_t *attr,
             const rnn_fwd_pd_t *hint_fwd_pd)
@@ -218,7 +227,8 @@ protected:
         , dst_layer_md_(desc_.dst_layer_desc)
         , dst_iter_md_(desc_.dst_iter_desc)
         , dst_iter_c_md_(desc_.dst_iter_c_desc)
-        , ws_md_() {}
+        , ws_md_()
+        , seq_lengths_md_() {}
 };
 
 struct rnn_fwd_pd_t : public rnn_pd_t {
@@ -256,9 +266,12 @@ struct rnn_fwd_pd_t : public rnn_pd_t {
         if (arg == DNNL_ARG_DST_ITER_C && with_dst_iter() && is_lstm())
             return arg_usage_t::output;
 
-        if (arg == DNNL_ARG_WORKSPACE && is_training())
+        if (arg == DNNL_ARG_WORKSPACE && (is_training() || is_stateful()))
             return arg_usage_t::output;
 
+        if (arg == DNNL_ARG_SEQ_LENGTHS && with_seq_lengths())
+            return arg_usage_t::input;
+
         return primitive_desc_t::arg_usage(arg);
     }
 
@@ -281,6 +294,7 @@ struct rnn_fwd_pd_t : public rnn_pd_t {
             case DNNL_ARG_DST_LAYER: return dst_md(0);
             case DNNL_ARG_DST_ITER: return dst_md(1);
             case DNNL_ARG_DST_ITER_C: return dst_md(2);
+            case DNNL_ARG_SEQ_LENGTHS: return &seq_lengths_md_;
             default: return rnn_pd_t::arg_md(arg);
         }
     }
@@ -290,7 +304,8 @@ struct rnn_fwd_pd_t : public rnn_pd_t {
                 + with_src_iter() + with_src_iter_c() + is_augru();
     }
     int n_outputs() const override {
-        return 1 + with_dst_iter() + with_dst_iter_c() + is_training();
+        return 1 + with_dst_iter() + with_dst_iter_c()
+                + (is_training() || is_stateful());
     }
 
 protected:
@@ -36,8 +36,10 @@ status_t serialize_desc(
         CASE(convolution)
         CASE(deconvolution)
         CASE(eltwise)
+        CASE(embedding_bag)
         CASE(inner_product)
         CASE(gemm)
+        CASE(group_normalization)
         CASE(layer_normalization)
         CASE(lrn)
         CASE(matmul)
@@ -133,8 +135,16 @@ void serialize_attr(
         serialization_stream_t &sstream, const primitive_attr_t &attr) {
     // scratchpad_mode
     sstream.write(&attr.scratchpad_mode_);
+    // scratchpad_limit
+    sstream.write(&attr.scratchpad_limit_);
     // fpmath_mode
     sstream.write(&attr.fpmath_mode_);
+    // dst_stats
+    sstream.write(&attr.dst_stats_);
+    // src_prescale
+    sstream.write(&attr.src_prescale_);
+    // src_mask
+    serialize_md(sstream, attr.src_mask_md_);
 
     if (!attr.output_scales_.has_default_values()) {
         // output_scales: mask
@@ -249,6 +259,7 @@ void serialize_desc(
     // Memory descriptors
     serialize_md(sstream, desc.src_desc[0]);
     serialize_md(sstream, desc.src_desc[1]);
+    serialize_md(sstream, desc.src_desc[2]);
     serialize_md(sstream, desc.dst_desc);
 }
 
@@ -294,6 +305,19 @@ void serialize_desc(
     sstream.write(&desc.beta);
 }
 
+void serialize_desc(
+        serialization_stream_t &sstream, const embedding_bag_desc_t &desc) {
+    // Kinds
+    sstream.write(&desc.primitive_kind);
+    sstream.write(&desc.alg_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.src_desc);
+    serialize_md(sstream, desc.indices_desc);
+    serialize_md(sstream, desc.offsets_desc);
+    serialize_md(sstream, desc.weights_desc);
+    serialize_md(sstream, desc.dst_desc);
+}
+
 void serialize_desc(serialization_stream_t &sstream, const gemm_desc_t &desc) {
     // Kind
     sstream.write(&desc.primitive_kind);
@@ -325,6 +349,27 @@ void serialize_desc(
     sstream.write(&desc.accum_data_type);
 }
 
+void serialize_desc(serialization_stream_t &sstream,
+        const group_normalization_desc_t &desc) {
+    // Kinds
+    sstream.write(&desc.primitive_kind);
+    sstream.write(&desc.prop_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.src_desc);
+    serialize_md(sstream, desc.diff_src_desc);
+    serialize_md(sstream, desc.scaleshift_desc);
+    serialize_md(sstream, desc.diff_scaleshift_desc);
+    serialize_md(sstream, desc.dst_desc);
+    serialize_md(sstream, desc.diff_dst_desc);
+    serialize_md(sstream, desc.stat_desc);
+    // Groups
+    sstream.write(&desc.groups);
+    // Epsilon
+    sstream.write(&desc.group_norm_epsilon);
+    // Flags
+    sstream.write(&desc.flags);
+}
+
 void serialize_desc(serialization_stream_t &sstream,
         const layer_normalization_desc_t &desc) {
     // Kinds
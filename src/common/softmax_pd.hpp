@@ -117,6 +117,9 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
     arg_usage_t arg_usage(int arg) const override {
         if (arg == DNNL_ARG_SRC) return arg_usage_t::input;
 
+        if (arg == DNNL_ARG_ATTR_SRC_MASK && with_src_mask())
+            return arg_usage_t::input;
+
         if (arg == DNNL_ARG_DST) return arg_usage_t::output;
 
         if (arg == DNNL_ARG_WORKSPACE && (!types::is_zero_md(workspace_md())))
@@ -129,6 +132,7 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
         switch (arg) {
             case DNNL_ARG_SRC: return src_md(0);
             case DNNL_ARG_DST: return dst_md(0);
+            case DNNL_ARG_ATTR_SRC_MASK: return src_mask_md();
             default: return softmax_pd_t::arg_md(arg);
         }
     }
@@ -140,11 +144,21 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
         return index == 0 ? &dst_md_ : &glob_zero_md;
     }
 
-    int n_inputs() const override { return 1; }
+    int n_inputs() const override { return 1 + with_src_mask(); }
     int n_outputs() const override {
         return 1 + (!types::is_zero_md(workspace_md()));
     }
 
+    const memory_desc_t *src_mask_md() const { return &attr()->src_mask_md_; }
+    float src_prescale() const { return attr()->src_prescale_; }
+    bool with_src_mask() const { return !types::is_zero_md(src_mask_md()); }
+    bool with_src_prescale() const { return src_prescale() != 1.f; }
+    // Returns true if src is transformed as src * prescale + mask before the
+    // softmax is computed.
+    bool with_src_ops() const {
+        return with_src_prescale() || with_src_mask();
+    }
+
 protected:
     memory_desc_t src_md_;
 
@@ -162,6 +176,17 @@ protected:
                 dst_md_, src_md_.format_desc.blocking);
     }
 
+    // Checks that the mask is broadcastable to src.
+    bool attr_src_mask_ok() const {
+        if (!with_src_mask()) return true;
+        const memory_desc_t &mask_md = *src_mask_md();
+        if (mask_md.ndims != src_md_.ndims) return false;
+        for (int d = 0; d < mask_md.ndims; d++)
+            if (!utils::one_of(mask_md.dims[d], 1, src_md_.dims[d]))
+                return false;
+        return true;
+    }
+
     bool attr_scales_ok() const {
         const auto &scales = attr()->scales_;
         bool ok = true;
@@ -403,6 +403,7 @@ inline bool operator==(const binary_desc_t &lhs, const binary_desc_t &rhs) {
             && COMPARE_DESC_MEMBERS(alg_kind)
             && COMPARE_DESC_MEMBERS(src_desc[0])
             && COMPARE_DESC_MEMBERS(src_desc[1])
+            && COMPARE_DESC_MEMBERS(src_desc[2])
             && COMPARE_DESC_MEMBERS(dst_desc);
     return ret;
 }
@@ -456,6 +457,18 @@ inline bool operator==(const eltwise_desc_t &lhs, const eltwise_desc_t &rhs) {
     return ret;
 }
 
+inline bool operator==(
+        const embedding_bag_desc_t &lhs, const embedding_bag_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
+            && COMPARE_DESC_MEMBERS(alg_kind)
+            && COMPARE_DESC_MEMBERS(src_desc)
+            && COMPARE_DESC_MEMBERS(indices_desc)
+            && COMPARE_DESC_MEMBERS(offsets_desc)
+            && COMPARE_DESC_MEMBERS(weights_desc)
+            && COMPARE_DESC_MEMBERS(dst_desc);
+    return ret;
+}
+
 inline bool operator==(const gemm_desc_t &lhs, const gemm_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
             && COMPARE_DESC_MEMBERS(a_desc)
@@ -484,6 +497,23 @@ inline bool operator==(
     return ret;
 }
 
+inline bool operator==(const group_normalization_desc_t &lhs,
+        const group_normalization_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
+            && COMPARE_DESC_MEMBERS(prop_kind)
+            && COMPARE_DESC_MEMBERS(src_desc)
+            && COMPARE_DESC_MEMBERS(diff_src_desc)
+            && COMPARE_DESC_MEMBERS(scaleshift_desc)
+            && COMPARE_DESC_MEMBERS(diff_scaleshift_desc)
+            && COMPARE_DESC_MEMBERS(dst_desc)
+            && COMPARE_DESC_MEMBERS(diff_dst_desc)
+            && COMPARE_DESC_MEMBERS(stat_desc)
+            && COMPARE_DESC_MEMBERS(groups)
+            && COMPARE_FLOAT_DESC_MEMBERS(group_norm_epsilon)
+            && COMPARE_DESC_MEMBERS(flags);
+    return ret;
+}
+
 inline bool operator==(
         const layer_normalization_desc_t &lhs, const layer_normalization_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
@@ -940,7 +970,9 @@ inline void copy_c_op_desc(op_desc_t *dst, const op_desc_t *src) {
         CASE_OP_DESC(convolution);
         CASE_OP_DESC(deconvolution);
         CASE_OP_DESC(eltwise);
+        CASE_OP_DESC(embedding_bag);
         CASE_OP_DESC(gemm);
+        CASE_OP_DESC(group_normalization);
         CASE_OP_DESC(inner_product);
         CASE_OP_DESC(layer_normalization);
         CASE_OP_DESC(lrn);
@@ -38,6 +38,8 @@
 #include "convolution_pd.hpp"
 #include "deconvolution_pd.hpp"
 #include "eltwise_pd.hpp"
+#include "embedding_bag_pd.hpp"
+#include "group_normalization_pd.hpp"
 #include "inner_product_pd.hpp"
 #include "layer_normalization_pd.hpp"
 #include "lrn_pd.hpp"
@@ -208,6 +210,10 @@ std::string flags2str(unsigned flags) {
     if (flags & normalization_flags::use_shift) s += "H";
     if (flags & normalization_flags::fuse_norm_relu) s += "R";
     if (flags & normalization_flags::fuse_norm_add_relu) s += "A";
+    if (flags & normalization_flags::use_precomputed_sums) s += "P";
+    if (flags & normalization_flags::rms_norm) s += "M";
+    if (flags & normalization_flags::fuse_residual_add) s += "S";
+    if (flags & normalization_flags::welford_stats) s += "W";
     return s;
 }
 
@@ -406,12 +412,15 @@ std::string arg2str(int arg) {
 }
 
 std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
-    // scratchpad and fpmath mode are not a part of
+    // scratchpad mode and limit and fpmath mode are not a part of
     // has_default_values(). Check them first.
     const scratchpad_mode_t &spm = attr->scratchpad_mode_;
     if (spm != scratchpad_mode_t::dnnl_scratchpad_mode_library) {
         ss << "attr-scratchpad:" << dnnl_scratchpad_mode2str(spm) << " ";
     }
+    if (attr->scratchpad_limit_ != 0) {
+        ss << "attr-scratchpad-limit:" << attr->scratchpad_limit_ << " ";
+    }
     const fpmath_mode_t &fpm = attr->fpmath_mode_;
     if (fpm != fpmath_mode_t::dnnl_fpmath_mode_strict) {
         ss << "attr-fpmath:" << dnnl_fpmath_mode2str(fpm) << " ";
@@ -419,6 +428,15 @@ std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
 
     if (attr->has_default_values()) return ss;
 
+    if (attr->dst_stats_) ss << "attr-dst-stats:1 ";
+    if (attr->src_prescale_ != 1.f)
+        ss << "attr-src-prescale:" << attr->src_prescale_ << " ";
+    if (!types::is_zero_md(&attr->src_mask_md_)) {
+        const auto &md = attr->src_mask_md_;
+        ss << "attr-src-mask:" << md.data_type << ":" << md2dim_str(&md)
+           << " ";
+    }
+
     const runtime_scales_t &os = attr->output_scales_;
     if (!os.has_default_values()) { ss << "attr-oscale:" << os << " "; }
 
@@ -550,12 +568,16 @@ static std::string init_info_binary(const engine_t *e, const pd_t *pd) {
 
     auto src0_md = pd->src_md(0);
     auto src1_md = pd->src_md(1);
+    auto src2_md = pd->src_md(2);
     auto dst_md = pd->dst_md();
-    ss << "src_" << src0_md << " src_" << src1_md << " dst_" << dst_md << ",";
+    ss << "src_" << src0_md << " src_" << src1_md << " ";
+    if (pd->is_ternary_op()) ss << "src_" << src2_md << " ";
+    ss << "dst_" << dst_md << ",";
 
     ss << pd->attr() << ",";
     ss << "alg:" << pd->desc()->alg_kind << ",";
     ss << md2dim_str(src0_md) << ":" << md2dim_str(src1_md);
+    if (pd->is_ternary_op()) ss << ":" << md2dim_str(src2_md);
 
     return ss.str();
 }
@@ -678,6 +700,49 @@ static std::string init_info_inner_product(const engine_t *e, const pd_t *pd) {
     return ss.str();
 }
 
+template <typename pd_t>
+static std::string init_info_embedding_bag(const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << "," << prop_kind::undef
+       << ",";
+
+    auto src_md = pd->src_md();
+    auto indices_md = pd->indices_md();
+    auto offsets_md = pd->offsets_md();
+    auto dst_md = pd->dst_md();
+    ss << "src_" << src_md << " indices_" << indices_md << " offsets_"
+       << offsets_md;
+    if (pd->with_weights()) ss << " wei_" << pd->weights_md();
+    ss << " dst_" << dst_md << ",";
+
+    ss << pd->attr() << ",";
+    ss << "alg:" << pd->desc()->alg_kind << ",";
+    ss << md2dim_str(src_md) << ":" << md2dim_str(indices_md) << ":"
+       << md2dim_str(offsets_md);
+
+    return ss.str();
+}
+
+template <typename pd_t>
+static std::string init_info_group_normalization(
+        const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << ","
+       << pd->desc()->prop_kind << ",";
+
+    auto src_md = pd->src_md();
+    auto dst_md = pd->is_fwd() ? pd->dst_md() : pd->diff_dst_md();
+    ss << "src_" << src_md << " dst_" << dst_md;
+    if (pd->is_bwd()) ss << " diff_src_" << pd->diff_src_md();
+    ss << ",";
+
+    ss << pd->attr() << ",";
+    ss << "flags:" << flags2str(pd->desc()->flags) << ",";
+    ss << md2dim_str(src_md) << ":g" << pd->G();
+
+    return ss.str();
+}
+
 template <typename pd_t>
 static std::string init_info_layer_normalization(
         const engine_t *e, const pd_t *pd) {
@@ -1006,6 +1071,8 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             CASE(convolution);
             CASE(deconvolution);
             CASE(eltwise);
+            CASE(embedding_bag);
+            CASE(group_normalization);
             CASE(inner_product);
             CASE(layer_normalization);
             CASE(lrn);
@@ -127,6 +127,8 @@ struct acl_binary_t : public primitive_t {
 
             using namespace acl_utils;
 
+            if (is_ternary_op()) return status::unimplemented;
+
             // Only support f16/f32/s32 for now
             data_type_t ddt = dst_md(0)->data_type;
             if (!utils::one_of(
@@ -2260,8 +2260,8 @@ using namespace utils;
 
 template <cpu_isa_t isa>
 status_t jit_uni_batch_normalization_fwd_t<isa>::pd_t::init(engine_t *engine) {
-    bool ok = is_fwd() && mayiuse(isa)
-            && !has_zero_dim_memory()
+    bool ok = is_fwd() && mayiuse(isa) && !has_zero_dim_memory()
+            && !use_precomputed_sums() && !use_welford_stats()
             // Algorithm requires barriers for best performance.
             // TBB utilizes jit_uni_tbb_batch_normalization implementation.
             && dnnl_thr_syncable() && one_of(src_md()->data_type, f32)
@@ -90,7 +90,7 @@ status_t jit_uni_binary_t::pd_t::init(engine_t *engine) {
     conf_.is_i8 = utils::one_of(conf_.dst_type, s8, u8);
 
     bool ok = mayiuse(sve_512) && data_type_supported(conf_.dst_type)
-            && data_type_supported(conf_.src0_type)
+            && !is_ternary_op() && data_type_supported(conf_.src0_type)
             && data_type_supported(conf_.src1_type)
             && set_default_params() == status::success && !has_zero_dim_memory()
             && IMPLICATION(!conf_.is_i8, src0_md_ == dst_md_) && is_applicable()
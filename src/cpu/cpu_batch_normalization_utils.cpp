@@ -187,6 +187,20 @@ bool is_spatial_thr(const batch_normalization_pd_t *bdesc, bool is_nspc,
     return S_nthr > 1;
 }
 
+void stats_from_sums(const batch_normalization_pd_t *bdesc, const float *sums,
+        float *mean, float *variance) {
+    const dim_t C = bdesc->C();
+    const float denom = bdesc->MB() * bdesc->D() * bdesc->H() * bdesc->W();
+    const float *sums_sq = sums + C;
+
+    parallel_nd(C, [&](dim_t c) {
+        const float m = sums[c] / denom;
+        // Rounding may lead to a small negative value for constant channels.
+        mean[c] = m;
+        variance[c] = nstl::max(0.f, sums_sq[c] / denom - m * m);
+    });
+}
+
 } // namespace bnorm_utils
 } // namespace cpu
 } // namespace impl
@@ -36,6 +36,11 @@ bool thread_balance(bool do_blocking, bool spatial_thr_allowed, bool is_nhwc,
 bool is_spatial_thr(const batch_normalization_pd_t *bdesc, bool is_nhwc,
         int simd_w, int data_size);
 
+// Computes mean and variance from per-channel sums and sums of squares of src,
+// see normalization_flags::use_precomputed_sums.
+void stats_from_sums(const batch_normalization_pd_t *bdesc, const float *sums,
+        float *mean, float *variance);
+
 } // namespace bnorm_utils
 } // namespace cpu
 } // namespace impl
@@ -0,0 +1,52 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_CPU_GROUP_NORMALIZATION_PD_HPP
+#define CPU_CPU_GROUP_NORMALIZATION_PD_HPP
+
+#include "common/group_normalization_pd.hpp"
+#include "cpu/cpu_engine.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+struct cpu_group_normalization_fwd_pd_t : public group_normalization_fwd_pd_t {
+    using group_normalization_fwd_pd_t::group_normalization_fwd_pd_t;
+
+protected:
+    // Post-ops are applied to the normalized value before the conversion to
+    // the destination data type.
+    bool post_ops_ok() const {
+        const auto &po = attr()->post_ops_;
+        for (int i = 0; i < po.len(); ++i)
+            if (!(po.entry_[i].is_eltwise() || po.entry_[i].is_binary()))
+                return false;
+        return true;
+    }
+};
+
+struct cpu_group_normalization_bwd_pd_t : public group_normalization_bwd_pd_t {
+    using group_normalization_bwd_pd_t::group_normalization_bwd_pd_t;
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+
+#include "common/dnnl_thread.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/dst_stats_utils.hpp"
+#include "cpu/ref_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using namespace memory_tracking::names;
+
+namespace {
+template <data_type_t dt>
+void accumulate(double *sums, double *sums_sq, const void *dst, dim_t len) {
+    using data_t = typename prec_traits<dt>::type;
+    const data_t *d = reinterpret_cast<const data_t *>(dst);
+    PRAGMA_OMP_SIMD()
+    for (dim_t i = 0; i < len; ++i) {
+        const double v = static_cast<float>(d[i]);
+        sums[i] += v;
+        sums_sq[i] += v * v;
+    }
+}
+} // namespace
+
+void book_dst_stats(
+        memory_tracking::registrar_t &scratchpad, dim_t C, int nthr) {
+    scratchpad.book<double>(key_dst_stats_reduction, 2 * C * nthr);
+}
+
+double *get_dst_stats_partials(
+        const memory_tracking::grantor_t &scratchpad, dim_t C, int ithr) {
+    return scratchpad.get<double>(key_dst_stats_reduction) + 2 * C * ithr;
+}
+
+void init_dst_stats(
+        const memory_tracking::grantor_t &scratchpad, dim_t C, int nthr) {
+    auto partials = scratchpad.get<double>(key_dst_stats_reduction);
+    std::memset(partials, 0, sizeof(double) * 2 * C * nthr);
+}
+
+void accumulate_dst_stats(double *acc, dim_t C, data_type_t dt,
+        const void *dst, dim_t c_start, dim_t len) {
+    using namespace data_type;
+    double *sums = acc + c_start;
+    double *sums_sq = acc + C + c_start;
+    switch (dt) {
+        case f32: accumulate<f32>(sums, sums_sq, dst, len); break;
+        case bf16: accumulate<bf16>(sums, sums_sq, dst, len); break;
+        case f16: accumulate<f16>(sums, sums_sq, dst, len); break;
+        case s32: accumulate<s32>(sums, sums_sq, dst, len); break;
+        case s8: accumulate<s8>(sums, sums_sq, dst, len); break;
+        case u8: accumulate<u8>(sums, sums_sq, dst, len); break;
+        default: assert(!"unsupported data type");
+    }
+}
+
+void reduce_dst_stats(float *stats,
+        const memory_tracking::grantor_t &scratchpad, dim_t C, int nthr) {
+    const auto partials = scratchpad.get<const double>(key_dst_stats_reduction);
+    parallel_nd(2 * C, [&](dim_t i) {
+        double s = 0;
+        for (int ithr = 0; ithr < nthr; ++ithr)
+            s += partials[2 * C * ithr + i];
+        stats[i] = static_cast<float>(s);
+    });
+}
+
+status_t compute_dst_stats(
+        const exec_ctx_t &ctx, const memory_desc_wrapper &dst_d, int ch_dim) {
+    status_t status = status::success;
+    auto dst = CTX_IN_MEM(const void *, DNNL_ARG_DST);
+    auto stats = CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_ATTR_DST_STATS, status);
+    CHECK(status);
+
+    const auto dt = dst_d.data_type();
+    const dim_t C = dst_d.dims()[ch_dim];
+    dim_t outer = 1, inner = 1;
+    for (int d = 0; d < ch_dim; ++d)
+        outer *= dst_d.dims()[d];
+    for (int d = ch_dim + 1; d < dst_d.ndims(); ++d)
+        inner *= dst_d.dims()[d];
+
+    parallel_nd(C, [&](dim_t c) {
+        double s = 0, s_sq = 0;
+        for_(dim_t o = 0; o < outer; ++o)
+        for (dim_t i = 0; i < inner; ++i) {
+            const dim_t off = dst_d.off_l((o * C + c) * inner + i);
+            const double v = io::load_float_value(dt, dst, off);
+            s += v;
+            s_sq += v * v;
+        }
+        stats[c] = static_cast<float>(s);
+        stats[C + c] = static_cast<float>(s_sq);
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
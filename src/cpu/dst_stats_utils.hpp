@@ -0,0 +1,68 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_DST_STATS_UTILS_HPP
+#define CPU_DST_STATS_UTILS_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive_exec_types.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Helpers for the dst statistics attribute (primitive_attr_t::dst_stats_).
+// Optimized implementations accumulate per-thread partial sums right after a
+// block of dst is written, while it is still in cache, and reduce the partial
+// sums into the user buffer at the end of the execution. Partial sums are kept
+// in double precision since the variance is later computed as a difference of
+// two large values.
+
+// Books per-thread partial sums for `C` channels.
+void book_dst_stats(
+        memory_tracking::registrar_t &scratchpad, dim_t C, int nthr);
+
+// Returns partial sums of thread `ithr` zeroed by init_dst_stats().
+double *get_dst_stats_partials(
+        const memory_tracking::grantor_t &scratchpad, dim_t C, int ithr);
+
+void init_dst_stats(
+        const memory_tracking::grantor_t &scratchpad, dim_t C, int nthr);
+
+// Accumulates `len` consecutive dst values, which belong to channels
+// [c_start, c_start + len), into thread partial sums `acc`.
+void accumulate_dst_stats(double *acc, dim_t C, data_type_t dt,
+        const void *dst, dim_t c_start, dim_t len);
+
+// Reduces partial sums of all threads into the user buffer `stats`.
+void reduce_dst_stats(float *stats,
+        const memory_tracking::grantor_t &scratchpad, dim_t C, int nthr);
+
+// Computes statistics of the whole dst tensor, where the channel dimension is
+// `ch_dim`, in a separate pass. Used by reference implementations and as a
+// fallback when dst can't be processed in blocks.
+status_t compute_dst_stats(
+        const exec_ctx_t &ctx, const memory_desc_wrapper &dst_d, int ch_dim);
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -24,6 +24,7 @@
 #include "common/type_helpers.hpp"
 
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/dst_stats_utils.hpp"
 #include "cpu/ref_io_helper.hpp"
 
 #include "cpu/matmul/matmul_utils.hpp"
@@ -143,6 +144,9 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
         utils::dim_iterator(dst_d.dims(), dst_dims_idx, batch_ndims);
     });
 
+    if (pd()->attr()->dst_stats_)
+        return compute_dst_stats(ctx, dst_d, dst_d.ndims() - 1);
+
     return status::success;
 }
 
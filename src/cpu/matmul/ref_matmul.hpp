@@ -68,8 +68,11 @@ struct ref_matmul_t : public primitive_t {
                                             utils::one_of(bia_type, f32, bf16)))
                     && platform::has_data_type_support(src_type)
                     && attr()->has_default_values(smask_t::scales_runtime
-                                    | smask_t::post_ops | smask_t::sum_dt,
+                                    | smask_t::post_ops | smask_t::sum_dt
+                                    | smask_t::dst_stats,
                             dst_type)
+                    && IMPLICATION(attr()->dst_stats_,
+                            !has_runtime_dims_or_strides())
                     && attr_.post_ops_.check_sum_consistent_dt(dst_type)
                     && attr_scales_ok() && set_default_formats()
                     && attr_.set_default_formats(dst_md(0)) == status::success;
@@ -48,6 +48,7 @@ struct nspc_batch_normalization_fwd_t : public primitive_t {
             using namespace format_tag;
 
             bool ok = is_fwd() && !has_zero_dim_memory()
+                    && !use_precomputed_sums() && !use_welford_stats()
                     && utils::everyone_is(
                             d_type, src_md()->data_type, dst_md()->data_type)
                     && platform::has_data_type_support(d_type)
@@ -22,6 +22,8 @@
 #include "common/dnnl_thread.hpp"
 #include "common/memory_tracking.hpp"
 #include "common/type_helpers.hpp"
+
+#include "cpu/cpu_batch_normalization_utils.hpp"
 #include "cpu/ref_batch_normalization.hpp"
 #include "cpu/simple_q10n.hpp"
 
@@ -85,6 +87,18 @@ status_t ref_batch_normalization_fwd_t<d_type>::execute_forward(
     auto ws = CTX_OUT_CLEAN_MEM(uint8_t *, DNNL_ARG_WORKSPACE, status);
     CHECK(status);
 
+    if (pd()->use_precomputed_sums()) {
+        // Mean and variance are not outputs on inference, keep them in the
+        // scratchpad instead.
+        if (!pd()->is_training()) {
+            const auto scratchpad = ctx.get_scratchpad_grantor();
+            mean = scratchpad.template get<acc_data_t>(key_bnorm_tmp_mean);
+            variance = scratchpad.template get<acc_data_t>(key_bnorm_tmp_var);
+        }
+        auto sums = CTX_IN_MEM(const float *, DNNL_ARG_ATTR_DST_STATS);
+        bnorm_utils::stats_from_sums(pd(), sums, mean, variance);
+    }
+
     const auto ndims = data_d.ndims();
     const auto N = pd()->MB();
     const auto C = pd()->C();
@@ -93,7 +107,7 @@ status_t ref_batch_normalization_fwd_t<d_type>::execute_forward(
     const auto W = pd()->W();
 
     const auto eps = pd()->desc()->batch_norm_epsilon;
-    const auto calculate_stats = !pd()->stats_is_src();
+    const auto calculate_stats = !pd()->stats_are_precomputed();
     const auto fuse_norm_relu = pd()->fuse_norm_relu();
     const auto save_stats = pd()->is_training();
     const auto is_training = pd()->is_training();
@@ -118,7 +132,20 @@ status_t ref_batch_normalization_fwd_t<d_type>::execute_forward(
         acc_data_t v_mean = calculate_stats ? 0 : mean[c];
         acc_data_t v_variance = calculate_stats ? 0 : variance[c];
 
-        if (calculate_stats) {
+        if (calculate_stats && pd()->use_welford_stats()) {
+            dim_t cnt = 0;
+            for_(int n = 0; n < N; ++n)
+            for_(int d = 0; d < D; ++d)
+            for_(int h = 0; h < H; ++h)
+            for (int w = 0; w < W; ++w) {
+                const acc_data_t s = maybe_up_convert(
+                        src[DATA_OFF(data_d, n, c, d, h, w)]);
+                const acc_data_t delta = s - v_mean;
+                v_mean += delta / ++cnt;
+                v_variance += delta * (s - v_mean);
+            }
+            v_variance /= W * H * N * D;
+        } else if (calculate_stats) {
             for_(int n = 0; n < N; ++n)
             for_(int d = 0; d < D; ++d)
             for_(int h = 0; h < H; ++h)
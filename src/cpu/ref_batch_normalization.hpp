@@ -64,8 +64,19 @@ struct ref_batch_normalization_fwd_t : public primitive_t {
 
             if (is_training() && fuse_norm_relu()) init_default_ws(8);
 
+            init_scratchpad();
+
             return status::success;
         }
+
+    private:
+        void init_scratchpad() {
+            using namespace memory_tracking::names;
+            if (!use_precomputed_sums() || is_training()) return;
+            auto scratchpad = scratchpad_registry().registrar();
+            scratchpad.book<float>(key_bnorm_tmp_mean, C());
+            scratchpad.book<float>(key_bnorm_tmp_var, C());
+        }
     };
 
     ref_batch_normalization_fwd_t(const pd_t *apd) : primitive_t(apd) {}
@@ -46,6 +46,9 @@ struct ref_binary_t : public primitive_t {
             const bool ok
                     = platform::has_data_type_support(src_md(0)->data_type)
                     && platform::has_data_type_support(src_md(1)->data_type)
+                    && IMPLICATION(is_ternary_op(),
+                            platform::has_data_type_support(
+                                    src_md(2)->data_type))
                     && platform::has_data_type_support(dst_md()->data_type)
                     && set_default_params() == status::success
                     && attr()->has_default_values(
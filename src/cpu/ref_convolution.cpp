@@ -21,6 +21,7 @@
 #include "common/type_helpers.hpp"
 
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/dst_stats_utils.hpp"
 #include "cpu/ref_io_helper.hpp"
 
 #include "cpu/ref_convolution.hpp"
@@ -216,6 +217,8 @@ status_t ref_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
                 io::store_float_value(dst_d.data_type(), d, dst, dst_off);
             });
 
+    if (pd()->attr()->dst_stats_) return compute_dst_stats(ctx, dst_d, 1);
+
     return status::success;
 }
 
@@ -55,8 +55,9 @@ struct ref_convolution_fwd_t : public primitive_t {
                     && utils::one_of(dst_type, src_type, f32)
                     && utils::one_of(bia_type, data_type::undef, src_type, f32)
                     && set_default_formats()
-                    && attr()->has_default_values(
-                            smask_t::post_ops | smask_t::sum_dt, dst_type)
+                    && attr()->has_default_values(smask_t::post_ops
+                                    | smask_t::sum_dt | smask_t::dst_stats,
+                            dst_type)
                     && attr()->post_ops_.check_sum_consistent_dt(dst_type)
                     && post_ops_ok()
                     && attr_.set_default_formats(dst_md(0)) == status::success;
@@ -0,0 +1,99 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <atomic>
+#include <float.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/ref_embedding_bag.hpp"
+#include "cpu/ref_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_embedding_bag_t::execute_ref(const exec_ctx_t &ctx) const {
+    using namespace alg_kind;
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper indices_d(pd()->indices_md());
+    const memory_desc_wrapper offsets_d(pd()->offsets_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto indices = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_1);
+    auto offsets = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_2);
+    auto weights = CTX_IN_MEM(const float *, DNNL_ARG_WEIGHTS);
+    auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+
+    const dim_t R = pd()->R();
+    const dim_t D = pd()->D();
+    const dim_t NB = pd()->NB();
+    const alg_kind_t alg = pd()->desc()->alg_kind;
+    const bool with_weights = pd()->with_weights();
+    const bool per_row_scales = pd()->src_scales_mask() == 1;
+
+    if (pd()->has_zero_dim_memory()) return status::success;
+
+    std::atomic<bool> args_ok(true);
+    parallel_nd(NB, [&](dim_t b) {
+        dim_t beg = 0, end = 0;
+        bool ok = pd()->bag_range(offsets, b, beg, end);
+        for (dim_t i = beg; ok && i < end; i++) {
+            const dim_t idx = indices[indices_d.off(i)];
+            ok = 0 <= idx && idx < R;
+        }
+        if (!ok) {
+            args_ok = false;
+            return;
+        }
+
+        for (dim_t d = 0; d < D; d++) {
+            float acc = alg == embedding_bag_max ? -FLT_MAX : 0.f;
+            for (dim_t i = beg; i < end; i++) {
+                const dim_t idx = indices[indices_d.off(i)];
+                float s = io::load_float_value(
+                        src_d.data_type(), src, src_d.off(idx, d));
+                s *= src_scales[per_row_scales ? idx : 0];
+                if (with_weights) s *= weights[weights_d.off(i)];
+                acc = alg == embedding_bag_max ? nstl::max(acc, s) : acc + s;
+            }
+            // Empty bags produce zero rows.
+            if (end == beg)
+                acc = 0.f;
+            else if (alg == embedding_bag_mean)
+                acc /= (end - beg);
+            io::store_float_value(dst_d.data_type(), acc, dst, dst_d.off(b, d));
+        }
+    });
+
+    return args_ok ? status::success : status::invalid_arguments;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,260 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/ref_group_normalization.hpp"
+#include "cpu/ref_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_group_normalization_fwd_t::execute_forward(
+        const exec_ctx_t &ctx) const {
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper stat_d(pd()->stat_md());
+    const memory_desc_wrapper sc_d(pd()->weights_md());
+
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto scale = CTX_IN_MEM(const float *, DNNL_ARG_SCALE);
+    auto shift = CTX_IN_MEM(const float *, DNNL_ARG_SHIFT);
+    auto mean = pd()->stats_are_src()
+            ? const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_MEAN))
+            : CTX_OUT_MEM(float *, DNNL_ARG_MEAN);
+    auto variance = pd()->stats_are_src()
+            ? const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE))
+            : CTX_OUT_MEM(float *, DNNL_ARG_VARIANCE);
+    auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+    DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
+
+    const dim_t N = pd()->MB();
+    const dim_t C = pd()->C();
+    const dim_t G = pd()->G();
+    const dim_t CG = pd()->C_per_G();
+    const dim_t SP = pd()->SP();
+
+    const float eps = pd()->desc()->group_norm_epsilon;
+    const bool save_stats = pd()->is_training();
+    const bool calculate_stats = !pd()->stats_are_src();
+    const bool has_post_ops = pd()->attr()->post_ops_.len() > 0;
+
+    /* fast return */
+    if (this->pd()->has_zero_dim_memory()) {
+        if (calculate_stats && save_stats) {
+            for_(dim_t n = 0; n < N; n++)
+            for (dim_t g = 0; g < G; g++) {
+                mean[stat_d.off(n, g)] = 0;
+                variance[stat_d.off(n, g)] = 0;
+            }
+        }
+        return status::success;
+    }
+
+    // Logical offset of the first element of a channel in the image.
+    auto data_off = [&](dim_t n, dim_t c) { return (n * C + c) * SP; };
+
+    parallel_nd(N, G, [&](dim_t n, dim_t g) {
+        const auto s_off = stat_d.off(n, g);
+        float v_mean = calculate_stats ? 0 : mean[s_off];
+        float v_variance = calculate_stats ? 0 : variance[s_off];
+
+        if (calculate_stats) {
+            for_(dim_t c = g * CG; c < (g + 1) * CG; ++c)
+            for (dim_t sp = 0; sp < SP; ++sp) {
+                const auto off = src_d.off_l(data_off(n, c) + sp);
+                v_mean += io::load_float_value(src_d.data_type(), src, off);
+            }
+            v_mean /= CG * SP;
+
+            for_(dim_t c = g * CG; c < (g + 1) * CG; ++c)
+            for (dim_t sp = 0; sp < SP; ++sp) {
+                const auto off = src_d.off_l(data_off(n, c) + sp);
+                float m = io::load_float_value(src_d.data_type(), src, off)
+                        - v_mean;
+                v_variance += m * m;
+            }
+            v_variance /= CG * SP;
+        }
+
+        const float sqrt_variance = sqrtf(v_variance + eps);
+        for (dim_t c = g * CG; c < (g + 1) * CG; ++c) {
+            const float sm = (scale ? scale[sc_d.off(c)] : 1.f) / sqrt_variance;
+            const float sv = shift ? shift[sc_d.off(c)] : 0;
+            for (dim_t sp = 0; sp < SP; ++sp) {
+                const auto l_off = data_off(n, c) + sp;
+                const auto s_off = src_d.off_l(l_off);
+                const auto d_off = dst_d.off_l(l_off);
+                float s = io::load_float_value(src_d.data_type(), src, s_off);
+                float d = sm * (s - v_mean) + sv;
+                d *= src_scales[0];
+                if (has_post_ops) {
+                    ref_post_ops_t::args_t args;
+                    args.ctx = &ctx;
+                    args.l_offset = l_off;
+                    args.dst_md = pd()->dst_md();
+                    ref_post_ops->execute(d, args);
+                }
+                d *= dst_scales[0];
+                io::store_float_value(dst_d.data_type(), d, dst, d_off);
+            }
+        }
+
+        if (calculate_stats && save_stats) {
+            mean[s_off] = v_mean;
+            variance[s_off] = v_variance;
+        }
+    });
+    return status::success;
+}
+
+status_t ref_group_normalization_bwd_t::execute_backward(
+        const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper stat_d(pd()->stat_md());
+    const memory_desc_wrapper diff_src_d(pd()->diff_src_md());
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
+    const memory_desc_wrapper sc_d(pd()->weights_md());
+    const memory_desc_wrapper diff_sc_d(pd()->diff_weights_md());
+
+    const auto use_scale = pd()->use_scale();
+    const auto use_shift = pd()->use_shift();
+
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto mean = CTX_IN_MEM(const float *, DNNL_ARG_MEAN);
+    auto variance = CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE);
+    auto diff_dst = CTX_IN_MEM(const void *, DNNL_ARG_DIFF_DST);
+    auto scale = CTX_IN_MEM(float *, DNNL_ARG_SCALE);
+    auto diff_src = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DIFF_SRC, status);
+    CHECK(status);
+
+    auto diff_scale = use_scale
+            ? CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_DIFF_SCALE, status)
+            : nullptr;
+    CHECK(status);
+    auto diff_shift = use_shift
+            ? CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_DIFF_SHIFT, status)
+            : nullptr;
+    CHECK(status);
+
+    const dim_t N = pd()->MB();
+    const dim_t C = pd()->C();
+    const dim_t CG = pd()->C_per_G();
+    const dim_t G = pd()->G();
+    const dim_t SP = pd()->SP();
+
+    /* fast return */
+    if (this->pd()->has_zero_dim_memory()) {
+        for (dim_t c = 0; c < C; ++c) {
+            if (diff_scale) diff_scale[diff_sc_d.off(c)] = 0;
+            if (diff_shift) diff_shift[diff_sc_d.off(c)] = 0;
+        }
+        return status::success;
+    }
+
+    const float eps = pd()->desc()->group_norm_epsilon;
+    const bool calculate_diff_stats = !pd()->use_global_stats();
+
+    auto data_off = [&](dim_t n, dim_t c) { return (n * C + c) * SP; };
+    auto load_src = [&](dim_t l_off) {
+        return io::load_float_value(
+                src_d.data_type(), src, src_d.off_l(l_off));
+    };
+    auto load_diff_dst = [&](dim_t l_off) {
+        return io::load_float_value(
+                diff_dst_d.data_type(), diff_dst, diff_dst_d.off_l(l_off));
+    };
+
+    if (diff_scale || diff_shift) {
+        parallel_nd(C, [&](dim_t c) {
+            const dim_t g = c / CG;
+            float diff_gamma = 0.f;
+            float diff_beta = 0.f;
+
+            for (dim_t n = 0; n < N; ++n) {
+                const auto stat_off = stat_d.off(n, g);
+                const float inv_sqrt_variance
+                        = 1.f / sqrtf(variance[stat_off] + eps);
+                for (dim_t sp = 0; sp < SP; ++sp) {
+                    const auto l_off = data_off(n, c) + sp;
+                    const float dd = load_diff_dst(l_off);
+                    diff_gamma += (load_src(l_off) - mean[stat_off]) * dd
+                            * inv_sqrt_variance;
+                    diff_beta += dd;
+                }
+            }
+
+            if (diff_scale) diff_scale[diff_sc_d.off(c)] = diff_gamma;
+            if (diff_shift) diff_shift[diff_sc_d.off(c)] = diff_beta;
+        });
+    }
+
+    parallel_nd(N, G, [&](dim_t n, dim_t g) {
+        const auto s_off = stat_d.off(n, g);
+        const float v_mean = mean[s_off];
+        const float inv_sqrt_variance = 1.f / sqrtf(variance[s_off] + eps);
+        const dim_t group_size = CG * SP;
+
+        float dd_gamma = 0.f;
+        float dd_gamma_x = 0.f;
+        if (calculate_diff_stats) {
+            for (dim_t c = g * CG; c < (g + 1) * CG; ++c) {
+                const float gamma = scale ? scale[sc_d.off(c)] : 1.f;
+                for (dim_t sp = 0; sp < SP; ++sp) {
+                    const auto l_off = data_off(n, c) + sp;
+                    const float dd = load_diff_dst(l_off);
+                    dd_gamma += dd * gamma;
+                    dd_gamma_x += dd * gamma * (load_src(l_off) - v_mean);
+                }
+            }
+            dd_gamma_x *= inv_sqrt_variance;
+        }
+
+        for (dim_t c = g * CG; c < (g + 1) * CG; ++c) {
+            const float gamma = scale ? scale[sc_d.off(c)] : 1.f;
+            for (dim_t sp = 0; sp < SP; ++sp) {
+                const auto l_off = data_off(n, c) + sp;
+                float d_src = load_diff_dst(l_off) * gamma;
+                if (calculate_diff_stats) {
+                    d_src -= dd_gamma / group_size;
+                    d_src -= (load_src(l_off) - v_mean) * dd_gamma_x
+                            * inv_sqrt_variance / group_size;
+                }
+                d_src *= inv_sqrt_variance;
+                io::store_float_value(diff_src_d.data_type(), d_src, diff_src,
+                        diff_src_d.off_l(l_off));
+            }
+        }
+    });
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -37,6 +37,7 @@ status_t ref_layer_normalization_fwd_t::execute_forward(
     const memory_desc_wrapper sc_d(pd()->weights_md());
 
     auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto residual = CTX_IN_MEM(const void *, DNNL_ARG_SRC_1);
     auto scale = CTX_IN_MEM(const float *, DNNL_ARG_SCALE);
     auto shift = CTX_IN_MEM(const float *, DNNL_ARG_SHIFT);
     auto mean = pd()->stats_are_src()
@@ -46,6 +47,9 @@ status_t ref_layer_normalization_fwd_t::execute_forward(
             ? const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE))
             : CTX_OUT_MEM(float *, DNNL_ARG_VARIANCE);
     auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+    // Optional, the residual sum is stored only if the user asked for it.
+    auto sum = pd()->fuse_residual_add() ? CTX_OUT_MEM(void *, DNNL_ARG_DST_1)
+                                         : nullptr;
 
     DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
@@ -56,35 +60,49 @@ status_t ref_layer_normalization_fwd_t::execute_forward(
     const float eps = pd()->desc()->layer_norm_epsilon;
     const bool save_stats = pd()->is_training();
     const bool calculate_stats = !pd()->stats_are_src();
+    const bool use_mean = !pd()->use_rms_norm();
 
     /* fast return */
     if (this->pd()->has_zero_dim_memory()) {
         if (calculate_stats && save_stats) {
             for (dim_t n = 0; n < N; n++) {
-                mean[n] = 0;
+                if (use_mean) mean[n] = 0;
                 variance[n] = 0;
             }
         }
         return status::success;
     }
 
+    // With the residual fusion the normalization is applied to src + res.
+    auto load_src = [&](dim_t off) {
+        float s = io::load_float_value(src_d.data_type(), src, off);
+        if (residual)
+            s += io::load_float_value(src_d.data_type(), residual, off);
+        return s;
+    };
+
     parallel_nd(N, [&](dim_t n) {
         const size_t s_off = stat_d.off_l(n);
-        auto v_mean = calculate_stats ? 0 : mean[s_off];
-        auto v_variance = calculate_stats ? 0 : variance[s_off];
+        float v_mean = calculate_stats || !use_mean ? 0 : mean[s_off];
+        float v_variance = calculate_stats ? 0 : variance[s_off];
 
-        if (calculate_stats) {
+        if (sum) {
             for (dim_t c = 0; c < C; ++c) {
                 const auto s_off = src_d.off_l(n * C + c);
-                float s = io::load_float_value(src_d.data_type(), src, s_off);
-                v_mean += s;
+                io::store_float_value(
+                        src_d.data_type(), load_src(s_off), sum, s_off);
+            }
+        }
+
+        if (calculate_stats) {
+            if (use_mean) {
+                for (dim_t c = 0; c < C; ++c)
+                    v_mean += load_src(src_d.off_l(n * C + c));
+                v_mean /= C;
             }
-            v_mean /= C;
 
             for (dim_t c = 0; c < C; ++c) {
-                const auto s_off = src_d.off_l(n * C + c);
-                float s = io::load_float_value(src_d.data_type(), src, s_off);
-                float m = s - v_mean;
+                float m = load_src(src_d.off_l(n * C + c)) - v_mean;
                 v_variance += m * m;
             }
             v_variance /= C;
@@ -96,15 +114,14 @@ status_t ref_layer_normalization_fwd_t::execute_forward(
             const float sv = shift ? shift[sc_d.off(c)] : 0;
             const auto s_off = src_d.off_l(n * C + c);
             const auto d_off = dst_d.off_l(n * C + c);
-            float s = io::load_float_value(src_d.data_type(), src, s_off);
-            float d = sm * (s - v_mean) + sv;
+            float d = sm * (load_src(s_off) - v_mean) + sv;
             d *= src_scales[0] * dst_scales[0];
             io::store_float_value(dst_d.data_type(), d, dst, d_off);
         }
 
         if (calculate_stats) {
             if (save_stats) {
-                mean[s_off] = v_mean;
+                if (use_mean) mean[s_off] = v_mean;
                 variance[s_off] = v_variance;
             }
         }
@@ -163,6 +180,9 @@ status_t ref_layer_normalization_bwd_t::execute_backward(
 
     const float eps = pd()->desc()->layer_norm_epsilon;
     const bool calculate_diff_stats = !pd()->use_global_stats();
+    // In the RMS mode the mean is a constant zero and has no derivative.
+    const bool use_mean = !pd()->use_rms_norm();
+    auto get_mean = [&](size_t s_off) { return use_mean ? mean[s_off] : 0.f; };
 
     if (diff_scale || diff_shift) {
         parallel_nd(C, [&](dim_t c) {
@@ -177,7 +197,7 @@ status_t ref_layer_normalization_bwd_t::execute_backward(
                 float s = io::load_float_value(src_d.data_type(), src, src_off);
                 float dd = io::load_float_value(
                         diff_dst_d.data_type(), diff_dst, diff_dst_off);
-                diff_gamma += (s - mean[stat_off]) * dd * inv_sqrt_variance;
+                diff_gamma += (s - get_mean(stat_off)) * dd * inv_sqrt_variance;
                 diff_beta += dd;
             }
 
@@ -200,7 +220,7 @@ status_t ref_layer_normalization_bwd_t::execute_backward(
                 float dd = io::load_float_value(
                         diff_dst_d.data_type(), diff_dst, diff_dst_off);
                 dd_gamma += dd * gamma;
-                dd_gamma_x += dd * gamma * (s - mean[s_off]);
+                dd_gamma_x += dd * gamma * (s - get_mean(s_off));
             }
             dd_gamma_x *= inv_sqrt_variance;
         }
@@ -215,8 +235,9 @@ status_t ref_layer_normalization_bwd_t::execute_backward(
             float d_src = dd * gamma;
             if (calculate_diff_stats) {
                 float s = io::load_float_value(src_d.data_type(), src, src_off);
-                d_src -= dd_gamma / C;
-                d_src -= (s - mean[s_off]) * dd_gamma_x * inv_sqrt_variance / C;
+                if (use_mean) d_src -= dd_gamma / C;
+                d_src -= (s - get_mean(s_off)) * dd_gamma_x * inv_sqrt_variance
+                        / C;
             }
             d_src *= inv_sqrt_variance;
             io::store_float_value(
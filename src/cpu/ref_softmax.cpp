@@ -185,6 +185,7 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
 
     auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
     auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+    auto mask = CTX_IN_MEM(const void *, DNNL_ARG_ATTR_SRC_MASK);
 
     DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
@@ -194,6 +195,27 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
 
     const memory_desc_wrapper src_d(pd()->src_md());
     const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper mask_d(pd()->src_mask_md());
+
+    const int ndims = src_d.ndims();
+    const float prescale = pd()->src_prescale();
+
+    // Returns src[l] * prescale + mask[l] with l a logical offset.
+    auto load_src = [&](dim_t l) {
+        float s = io::load_float_value(src_d.data_type(), src, src_d.off_l(l));
+        if (!pd()->with_src_ops()) return s;
+
+        s *= prescale;
+        if (mask) {
+            dims_t pos;
+            utils::l_dims_by_l_offset(pos, l, src_d.dims(), ndims);
+            for (int d = 0; d < ndims; d++)
+                if (mask_d.dims()[d] == 1) pos[d] = 0;
+            s += io::load_float_value(
+                    mask_d.data_type(), mask, mask_d.off_v(pos));
+        }
+        return s;
+    };
 
     void *interim_ptr = pd()->need_int8_scratchpad() ? scratchpad_int8 : dst;
     const auto interim_dt
@@ -240,14 +262,12 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
             dim_t ou_in_offset = ou * channels_ * inner_size_ + in;
 
             for (int c = 0; c < channels_; c++) {
-                size_t off = src_d.off_l(ou_in_offset + c * inner_size_);
-                float s = io::load_float_value(src_d.data_type(), src, off);
+                float s = load_src(ou_in_offset + c * inner_size_);
                 space_max[in] = nstl::max(space_max[in], s);
             }
 
             for (int c = 0; c < channels_; c++) {
-                size_t src_off = src_d.off_l(ou_in_offset + c * inner_size_);
-                float s = io::load_float_value(src_d.data_type(), src, src_off);
+                float s = load_src(ou_in_offset + c * inner_size_);
                 float d = s - space_max[in];
                 if (pd()->is_softmax()) {
                     d = expf(d);
@@ -49,8 +49,12 @@ struct ref_softmax_fwd_t : public primitive_t {
                             dst_md()->data_type, f32, bf16, f16, s8, u8)
                     && platform::has_data_type_support(src_md()->data_type)
                     && platform::has_data_type_support(dst_md()->data_type)
-                    && attr()->has_default_values(skip_mask_t::scales_runtime)
-                    && attr_scales_ok()
+                    && attr()->has_default_values(skip_mask_t::scales_runtime
+                            | skip_mask_t::src_prescale_mask)
+                    && attr_scales_ok() && attr_src_mask_ok()
+                    && IMPLICATION(with_src_mask(),
+                            platform::has_data_type_support(
+                                    src_mask_md()->data_type))
                     && set_default_formats() == status::success;
             if (!ok) return status::unimplemented;
 
@@ -105,7 +109,9 @@ struct ref_softmax_fwd_t : public primitive_t {
             if (bd.inner_idxs[iblk] == axis)
                 axis_blk_size *= bd.inner_blks[iblk];
 
-        use_dense_ = inner_size_ == 1 && src_d == dst_d && src_d.is_dense(true)
+        // src pre-scale and mask are applied in the generic path only
+        use_dense_ = !pd()->with_src_ops() && inner_size_ == 1
+                && src_d == dst_d && src_d.is_dense(true)
                 && src_d.only_padded_dim(axis)
                 && bd.strides[axis] == axis_blk_size;
         return status::success;
@@ -32,6 +32,7 @@
 #include "common/dnnl_thread.hpp"
 #include "common/stream.hpp"
 
+#include "cpu/ref_io_helper.hpp"
 #include "cpu/simple_q10n.hpp"
 
 #include "cpu/gemm/gemm.hpp"
@@ -140,6 +141,12 @@ rnn_gemm_sig(ref_rnn_fwd_s8s8_t::packed_gemm) {
             &beta, c_, &ldC, &offsetc);
 }
 
+// Moves a pointer to the rows-th row of a buffer, nullptr stays nullptr
+template <typename T>
+static T *offset_rows(T *ptr, int rows, dim_t ld) {
+    return ptr ? ptr + rows * ld : ptr;
+}
+
 //*************** Grid computations strategy: linear ***************//
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
         data_type_t acc_type>
@@ -237,6 +244,256 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
                   return dnnl_success;
               };
 
+    // Variable-length sequences are sorted by decreasing length, so only the
+    // first sequences of the minibatch are still active at a given iteration
+    // and the cells are executed for this part of the minibatch only. The
+    // brgemm kernels are generated for a fixed minibatch and compute all the
+    // sequences, the results past the end of a sequence are then ignored.
+    rnn_conf_t packed_rnn = rnn;
+    const auto n_active_seqs = [&](int iter) {
+        int n = rnn.mb;
+        if (seq_lengths_ && !rnn.is_brgemm)
+            while (n > 0 && seq_lengths_[n - 1] <= iter)
+                n--;
+        return n;
+    };
+
+    // Computes the cell of the grid for the j-th layer and the i-th
+    // iteration in the execution order. Cells executed concurrently use
+    // separate scratch buffers, selected by slot. The rows of the minibatch
+    // can be split in n_parts parts computed by different threads, each of
+    // them with its own configuration part_rnn.
+    const auto compute_cell = [&](int dir, int j, int i, int slot, int part,
+                                      int n_parts, rnn_conf_t &part_rnn) {
+        const int lay = (aprop == prop_kind::forward) ? j : rnn.n_layer - j - 1;
+        const int iter = (aprop == prop_kind::forward) ? i : rnn.n_iter - i - 1;
+
+        int m_start {0}, m_end {0};
+        balance211(n_active_seqs(iter), n_parts, part, m_start, m_end);
+        const int part_mb = m_end - m_start;
+        if (part_mb == 0) return dnnl_success;
+        const rnn_conf_t *cell_rnn = &rnn;
+        if (part_mb < rnn.mb) {
+            part_rnn.mb = part_mb;
+            cell_rnn = &part_rnn;
+        }
+
+        // We set parameters to the cell execution call
+
+        // dst_layer is equal to dst_iter. To avoid
+        // duplication of memory access we hence use only
+        // dst_layer and set dst_iter to nullptr, unless we
+        // cannot for one of the following condition:
+        // - in the last layer and last iteration, we need to
+        //   copy ht in two tensors (dst_layer and dst_iter)
+        dst_layer_t *cell_dst_layer
+                = &(ws_states_layer(lay + 1, dir, iter + 1, 0));
+        dst_iter_t *cell_dst_iter = nullptr;
+        const src_layer_t *cell_src_layer
+                = &(ws_states_layer(lay, dir, iter + 1, 0));
+        const src_iter_t *cell_src_iter
+                = &(ws_states_iter(lay + 1, dir, iter, 0));
+
+        void *cell_dst_iter_c = const_cast<void *>(
+                ws_states_iter_c(lay + 1, dir, iter + 1, 0));
+        const void *cell_src_iter_c = ws_states_iter_c(lay + 1, dir, iter, 0);
+
+        // the cell_position is used only when skip_data_copy is
+        // supported currently supported only for forward
+        cell_position_t cell_position = middle_cell;
+        if (iter == 0) cell_position |= first_iter;
+        if (lay == 0) cell_position |= first_layer;
+        if (iter == rnn.n_iter - 1) cell_position |= last_iter;
+        if (lay == rnn.n_layer - 1) cell_position |= last_layer;
+
+        // The dst_* paths should be before the src_* paths as
+        // the later will override cell_src_layer and
+        // cell_src_iter appropriately for 1st layer and 1st
+        // iter.
+        const bool last_iter_skip_copy
+                = rnn.skip_dst_iter_copy() && (cell_position & last_iter);
+        if (last_iter_skip_copy) {
+            cell_dst_layer = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
+            cell_src_layer = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
+        }
+
+        if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
+            // Note: for last layer and last iter, the output is in dst_layer
+            // and still need to be copied to dst_iter
+            cell_dst_layer = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
+            cell_dst_iter = last_iter_skip_copy
+                    ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
+                    : nullptr;
+            cell_src_iter = (iter != 0)
+                    ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
+                    : cell_src_iter;
+        }
+        if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
+            cell_src_iter = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
+
+        if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
+            cell_src_layer = src_layer_ + src_layer_mdw.off(iter, 0, 0);
+
+        // because the c state is always f32 and require no
+        // conversion, we can always skip to copy for the 1st
+        // and last iteration
+        if (iter == 0 && src_iter_c_) {
+            cell_src_iter_c = inc_ptr(src_iter_c_, rnn.src_iter_c_dt,
+                    src_iter_c_mdw.off(lay, dir, 0, 0));
+            cell_position |= c_state_first_iter;
+        }
+        if (iter == rnn.n_iter - 1 && dst_iter_c_) {
+            cell_dst_iter_c = inc_ptr(dst_iter_c_, rnn.dst_iter_c_dt,
+                    dst_iter_c_mdw.off(lay, dir, 0, 0));
+            cell_position |= c_state_last_iter;
+        }
+        const size_t sg_start_idx = rnn.n_iter_scratch_gates == 1
+                ? static_cast<size_t>(slot) * rnn.scratch_gates_nld
+                        * rnn.scratch_gates_ld
+                : static_cast<size_t>(iter) * rnn.scratch_gates_nld
+                        * rnn.scratch_gates_ld;
+        const auto cell_scratch_gates = &scratch_gates_[sg_start_idx];
+        const auto cell_scratch_cell = reinterpret_cast<scratch_t *>(
+                reinterpret_cast<char *>(scratch_cell_)
+                + slot * rnn.scratch_cell_size);
+
+        dst_iter_t *proj_ht = nullptr;
+        if (rnn.is_lstm_projection) {
+            if (rnn.is_training)
+                proj_ht = &(ws_ht(lay, dir, iter, 0));
+            else
+                proj_ht = scratch_ht_
+                        + slot * rnn.scratch_ht_nld * rnn.scratch_ht_ld;
+        }
+
+        // The part of the minibatch starts at the m_start-th row of all the
+        // states and scratch buffers. It is only split for inference, so the
+        // workspace and the diff buffers are not offset.
+        assert(m_start == 0 || !rnn.is_training);
+        auto cell_scratch_gates_part = cell_scratch_gates;
+        auto cell_scratch_cell_part = cell_scratch_cell;
+        const src_layer_t *cell_augru_attention
+                = SAFE_PTR(augru_attention, iter, m_start, 0);
+        if (m_start > 0) {
+            cell_dst_layer = offset_rows(cell_dst_layer, m_start,
+                    rnn.dst_layer_ld(cell_position, true));
+            cell_dst_iter = offset_rows(
+                    cell_dst_iter, m_start, rnn.dst_iter_ld(cell_position));
+            cell_src_layer = offset_rows(
+                    cell_src_layer, m_start, rnn.src_layer_ld(cell_position));
+            cell_src_iter = offset_rows(
+                    cell_src_iter, m_start, rnn.src_iter_ld(cell_position));
+            if (cell_src_iter_c)
+                cell_src_iter_c = inc_ptr(cell_src_iter_c, rnn.src_iter_c_dt,
+                        m_start * rnn.src_iter_c_ld(cell_position));
+            if (cell_dst_iter_c)
+                cell_dst_iter_c = inc_ptr(cell_dst_iter_c, rnn.dst_iter_c_dt,
+                        m_start * rnn.dst_iter_c_ld(cell_position));
+            cell_scratch_gates_part = offset_rows(
+                    cell_scratch_gates, m_start, rnn.scratch_gates_ld);
+            cell_scratch_cell_part
+                    = offset_rows(cell_scratch_cell, m_start, rnn.ws_gates_ld);
+            proj_ht = offset_rows(proj_ht, m_start, rnn.proj_ht_ld);
+        }
+
+#if DNNL_X64
+        CHECK((this->*cell_func)(ctx, *cell_rnn, cell_position,
+                cell_dst_layer, cell_dst_iter_c,
+                SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
+                SAFE_PTR(diff_augru_attention, iter, 0, 0),
+                SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
+                SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
+                SAFE_PTR(weights_layer, lay, dir, 0),
+                SAFE_PTR(weights_iter, lay, dir, 0),
+                SAFE_PTR(weights_projection, lay, dir),
+                SAFE_PTR(weights_peephole, lay, dir, 0),
+                w_proj_comp ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
+                            : nullptr,
+                bias(lay, dir), cell_src_layer,
+                cell_augru_attention, cell_src_iter,
+                cell_src_iter_c,
+                SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
+                SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
+                SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
+                SAFE_PTR(diff_weights_layer, lay, dir, 0),
+                SAFE_PTR(diff_weights_iter, lay, dir, 0),
+                SAFE_PTR(diff_weights_projection, lay, dir, 0),
+                SAFE_PTR(diff_weights_peephole, lay, dir, 0),
+                SAFE_PTR(diff_bias, lay, dir, 0),
+                SAFE_PTR(ws_gates, lay, dir, iter, 0), cell_scratch_gates_part,
+                proj_ht, scratch_diff_ht_,
+                SAFE_PTR(ws_grid, lay, dir, iter, 0), cell_scratch_cell_part,
+                scratch_gates_blocked_, scratch_src_layer_,
+                scratch_src_iter_, cell_dst_iter, amx_scratchpad,
+                addr_batch_global));
+#else
+        CHECK((this->*cell_func)(*cell_rnn, cell_position, cell_dst_layer,
+                cell_dst_iter_c,
+                SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
+                SAFE_PTR(diff_augru_attention, iter, 0, 0),
+                SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
+                SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
+                SAFE_PTR(weights_layer, lay, dir, 0),
+                SAFE_PTR(weights_iter, lay, dir, 0),
+                SAFE_PTR(weights_projection, lay, dir),
+                SAFE_PTR(weights_peephole, lay, dir, 0),
+                w_proj_comp ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
+                            : nullptr,
+                bias(lay, dir), cell_src_layer,
+                cell_augru_attention, cell_src_iter,
+                cell_src_iter_c,
+                SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
+                SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
+                SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
+                SAFE_PTR(diff_weights_layer, lay, dir, 0),
+                SAFE_PTR(diff_weights_iter, lay, dir, 0),
+                SAFE_PTR(diff_weights_projection, lay, dir, 0),
+                SAFE_PTR(diff_weights_peephole, lay, dir, 0),
+                SAFE_PTR(diff_bias, lay, dir, 0),
+                SAFE_PTR(ws_gates, lay, dir, iter, 0), cell_scratch_gates_part,
+                proj_ht, scratch_diff_ht_,
+                SAFE_PTR(ws_grid, lay, dir, iter, 0), cell_scratch_cell_part,
+                cell_dst_iter, amx_scratchpad));
+#endif
+        return dnnl_success;
+    };
+
+    if (rnn.wavefront) {
+        // Cells on the same anti-diagonal of the (layer, iteration) grid of
+        // both directions depend only on the cells of the previous one. The
+        // threads are split between the cells of a diagonal: when there are
+        // fewer cells than threads, a cell is computed by a team of threads,
+        // each of them for a part of the minibatch.
+        const int max_nthr = dnnl_get_max_threads();
+        const int max_tasks = nstl::max(rnn.n_concurrent_cells, max_nthr);
+        std::vector<status_t> task_status(max_tasks);
+        std::vector<rnn_conf_t> task_rnn(max_tasks, rnn);
+        for (int diag = 0; diag < rnn.n_layer + rnn.n_iter - 1; diag++) {
+            const int j_start = nstl::max(0, diag - rnn.n_iter + 1);
+            const int j_end = nstl::min(rnn.n_layer, diag + 1);
+            const int n_layer_cells = j_end - j_start;
+            const int n_cells = rnn.n_dir * n_layer_cells;
+            const int n_parts
+                    = nstl::max(1, nstl::min(rnn.mb, max_nthr / n_cells));
+            const int n_tasks = n_cells * n_parts;
+
+            parallel(nstl::min(n_tasks, max_nthr), [&](int ithr, int nthr) {
+                int start {0}, end {0};
+                balance211(n_tasks, nthr, ithr, start, end);
+                for (int t = start; t < end; t++) {
+                    const int c = t / n_parts;
+                    const int dir = c / n_layer_cells;
+                    const int j = j_start + c % n_layer_cells;
+                    task_status[t] = compute_cell(dir, j, diag - j, c,
+                            t % n_parts, n_parts, task_rnn[t]);
+                }
+            });
+            for (int t = 0; t < n_tasks; t++)
+                CHECK(task_status[t]);
+        }
+        return dnnl_success;
+    }
+
     // We run the grid of computation
     for_(int dir = 0; dir < rnn.n_dir; dir++)
     for (int j = 0; j < rnn.n_layer; j++) {
@@ -247,155 +504,8 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
 
         // TODO: enable merging projection gemm in bwd lstm projection
 
-        for (int i = 0; i < rnn.n_iter; i++) {
-            const int iter
-                    = (aprop == prop_kind::forward) ? i : rnn.n_iter - i - 1;
-
-            // We set parameters to the cell execution call
-
-            // dst_layer is equal to dst_iter. To avoid
-            // duplication of memory access we hence use only
-            // dst_layer and set dst_iter to nullptr, unless we
-            // cannot for one of the following condition:
-            // - in the last layer and last iteration, we need to
-            //   copy ht in two tensors (dst_layer and dst_iter)
-            dst_layer_t *cell_dst_layer
-                    = &(ws_states_layer(lay + 1, dir, iter + 1, 0));
-            dst_iter_t *cell_dst_iter = nullptr;
-            const src_layer_t *cell_src_layer
-                    = &(ws_states_layer(lay, dir, iter + 1, 0));
-            const src_iter_t *cell_src_iter
-                    = &(ws_states_iter(lay + 1, dir, iter, 0));
-
-            void *cell_dst_iter_c = const_cast<void *>(
-                    ws_states_iter_c(lay + 1, dir, iter + 1, 0));
-            const void *cell_src_iter_c
-                    = ws_states_iter_c(lay + 1, dir, iter, 0);
-
-            // the cell_position is used only when skip_data_copy is
-            // supported currently supported only for forward
-            cell_position_t cell_position = middle_cell;
-            if (iter == 0) cell_position |= first_iter;
-            if (lay == 0) cell_position |= first_layer;
-            if (iter == rnn.n_iter - 1) cell_position |= last_iter;
-            if (lay == rnn.n_layer - 1) cell_position |= last_layer;
-
-            // The dst_* paths should be before the src_* paths as
-            // the later will override cell_src_layer and
-            // cell_src_iter appropriately for 1st layer and 1st
-            // iter.
-            const bool last_iter_skip_copy
-                    = rnn.skip_dst_iter_copy() && (cell_position & last_iter);
-            if (last_iter_skip_copy) {
-                cell_dst_layer = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
-                cell_src_layer
-                        = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
-            }
-
-            if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
-                // Note: for last layer and last iter, the output is in dst_layer
-                // and still need to be copied to dst_iter
-                cell_dst_layer = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
-                cell_dst_iter = last_iter_skip_copy
-                        ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
-                        : nullptr;
-                cell_src_iter = (iter != 0)
-                        ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
-                        : cell_src_iter;
-            }
-            if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
-                cell_src_iter = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
-
-            if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
-                cell_src_layer = src_layer_ + src_layer_mdw.off(iter, 0, 0);
-
-            // because the c state is always f32 and require no
-            // conversion, we can always skip to copy for the 1st
-            // and last iteration
-            if (iter == 0 && src_iter_c_) {
-                cell_src_iter_c = inc_ptr(src_iter_c_, rnn.src_iter_c_dt,
-                        src_iter_c_mdw.off(lay, dir, 0, 0));
-                cell_position |= c_state_first_iter;
-            }
-            if (iter == rnn.n_iter - 1 && dst_iter_c_) {
-                cell_dst_iter_c = inc_ptr(dst_iter_c_, rnn.dst_iter_c_dt,
-                        dst_iter_c_mdw.off(lay, dir, 0, 0));
-                cell_position |= c_state_last_iter;
-            }
-            const size_t sg_start_idx = rnn.n_iter_scratch_gates == 1
-                    ? static_cast<size_t>(0)
-                    : static_cast<size_t>(iter) * rnn.scratch_gates_nld
-                            * rnn.scratch_gates_ld;
-            const auto cell_scratch_gates = &scratch_gates_[sg_start_idx];
-
-            dst_iter_t *proj_ht = nullptr;
-            if (rnn.is_lstm_projection) {
-                if (rnn.is_training)
-                    proj_ht = &(ws_ht(lay, dir, iter, 0));
-                else
-                    proj_ht = scratch_ht_;
-            }
-
-#if DNNL_X64
-            CHECK((this->*cell_func)(ctx, rnn, cell_position, cell_dst_layer,
-                    cell_dst_iter_c,
-                    SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
-                    SAFE_PTR(diff_augru_attention, iter, 0, 0),
-                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
-                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
-                    SAFE_PTR(weights_layer, lay, dir, 0),
-                    SAFE_PTR(weights_iter, lay, dir, 0),
-                    SAFE_PTR(weights_projection, lay, dir),
-                    SAFE_PTR(weights_peephole, lay, dir, 0),
-                    w_proj_comp ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
-                                : nullptr,
-                    bias(lay, dir), cell_src_layer,
-                    SAFE_PTR(augru_attention, iter, 0, 0), cell_src_iter,
-                    cell_src_iter_c,
-                    SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
-                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
-                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
-                    SAFE_PTR(diff_weights_layer, lay, dir, 0),
-                    SAFE_PTR(diff_weights_iter, lay, dir, 0),
-                    SAFE_PTR(diff_weights_projection, lay, dir, 0),
-                    SAFE_PTR(diff_weights_peephole, lay, dir, 0),
-                    SAFE_PTR(diff_bias, lay, dir, 0),
-                    SAFE_PTR(ws_gates, lay, dir, iter, 0), cell_scratch_gates,
-                    proj_ht, scratch_diff_ht_,
-                    SAFE_PTR(ws_grid, lay, dir, iter, 0), scratch_cell_,
-                    scratch_gates_blocked_, scratch_src_layer_,
-                    scratch_src_iter_, cell_dst_iter, amx_scratchpad,
-                    addr_batch_global));
-#else
-            CHECK((this->*cell_func)(rnn, cell_position, cell_dst_layer,
-                    cell_dst_iter_c,
-                    SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
-                    SAFE_PTR(diff_augru_attention, iter, 0, 0),
-                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
-                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
-                    SAFE_PTR(weights_layer, lay, dir, 0),
-                    SAFE_PTR(weights_iter, lay, dir, 0),
-                    SAFE_PTR(weights_projection, lay, dir),
-                    SAFE_PTR(weights_peephole, lay, dir, 0),
-                    w_proj_comp ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
-                                : nullptr,
-                    bias(lay, dir), cell_src_layer,
-                    SAFE_PTR(augru_attention, iter, 0, 0), cell_src_iter,
-                    cell_src_iter_c,
-                    SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
-                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
-                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
-                    SAFE_PTR(diff_weights_layer, lay, dir, 0),
-                    SAFE_PTR(diff_weights_iter, lay, dir, 0),
-                    SAFE_PTR(diff_weights_projection, lay, dir, 0),
-                    SAFE_PTR(diff_weights_peephole, lay, dir, 0),
-                    SAFE_PTR(diff_bias, lay, dir, 0),
-                    SAFE_PTR(ws_gates, lay, dir, iter, 0), cell_scratch_gates,
-                    proj_ht, scratch_diff_ht_,
-                    SAFE_PTR(ws_grid, lay, dir, iter, 0), scratch_cell_,
-                    cell_dst_iter, amx_scratchpad));
-#endif
-        }
+        for (int i = 0; i < rnn.n_iter; i++)
+            CHECK(compute_cell(dir, j, i, 0, 0, 1, packed_rnn));
 
         CHECK(compute_merged_layer_part_if_applicable(
                 prop_kind::backward, dir, lay));
@@ -1027,25 +1137,12 @@ rnn_bias_prepare_sig_templ(copy_bias_to_scratch) {
     });
 }
 
-rnn_bias_prepare_sig_templ(copy_bias_to_ws) {
-    /* Original set of bias provided by the user */
-    const AOC<const T, 5> b(b_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dhc);
-    /* Array of pointers initialized in packing */
-    const AOC<T *, 3> bias(bias_, rnn.n_layer, rnn.n_dir, rnn.n_parts_bias);
-    const AOC<T, 3> scratch_bias(
-            scratch_bias_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dhc);
-
-    for (int i = 0; i < rnn.n_layer; i++) {
-        for (int d = 0; d < rnn.n_dir; d++) {
-            int offset_bias = 0;
-            for (int p = 0; p < rnn.n_parts_bias; p++) {
-                bias(i, d, p) = rnn.copy_bias
-                        ? const_cast<T *>(&scratch_bias(i, d, offset_bias))
-                        : const_cast<T *>(&b(i, d, offset_bias));
-                offset_bias += rnn.parts_bias[p] * rnn.dhc;
-            }
-        }
-    }
+// Points the parts at the given offsets from base
+template <typename T>
+static void rebase_parts(
+        const std::vector<dim_t> &offsets, const T *base, T **parts) {
+    for (size_t i = 0; i < offsets.size(); i++)
+        parts[i] = const_cast<T *>(base) + offsets[i];
 }
 
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
@@ -1066,16 +1163,12 @@ rnn_bias_prepare_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
             assert("Unsupported bias data type");
     }
 
-    if (rnn.bias_dt == data_type::f32)
-        copy_bias_to_ws(rnn, reinterpret_cast<float **>(bias_),
-                static_cast<const float *>(b_),
-                static_cast<float *>(scratch_bias_));
-    else if (rnn.bias_dt == data_type::bf16)
-        copy_bias_to_ws(rnn, reinterpret_cast<bfloat16_t **>(bias_),
-                static_cast<const bfloat16_t *>(b_),
-                static_cast<bfloat16_t *>(scratch_bias_));
-    else
-        assert("Unsupported bias data type");
+    // The user bias and its copy have the same layout
+    const auto *base = static_cast<const char *>(
+            rnn.copy_bias ? scratch_bias_ : b_);
+    const size_t dt_size = types::data_type_size(rnn.bias_dt);
+    for (size_t i = 0; i < bias_offsets_.size(); i++)
+        bias_[i] = const_cast<char *>(base) + bias_offsets_[i] * dt_size;
 }
 
 static void apply_bias_compensation(const rnn_utils::rnn_conf_t &rnn,
@@ -1117,14 +1210,14 @@ rnn_weights_assign_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
         acc_type>::assign_packed_weights)) {
     assert(md->format_kind == format_kind::rnn_packed);
     const auto packed_desc = md->format_desc.rnn_packed_desc;
-    const AOC<weights_t *, 3> weights(
-            weights_, rnn.n_layer, rnn.n_dir, packed_desc.n_parts);
+    const AOC<dim_t, 3> offsets(
+            offsets_, rnn.n_layer, rnn.n_dir, packed_desc.n_parts);
 
-    size_t offset_packed = 0;
+    dim_t offset_packed = 0;
     for (int l = 0; l < rnn.n_layer; l++)
         for (int d = 0; d < rnn.n_dir; d++) {
             for (int p = 0; p < packed_desc.n_parts; p++) {
-                weights(l, d, p) = (weights_t *)&w_[offset_packed];
+                offsets(l, d, p) = offset_packed;
                 offset_packed
                         += packed_desc.part_pack_size[p] / sizeof(weights_t);
             }
@@ -1137,29 +1230,190 @@ rnn_weights_assign_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
         acc_type>::assign_weights)) {
     assert(md->format_kind == format_kind::blocked);
     const auto &blk = md->format_desc.blocking;
-    /* Original set of weights provided by the user */
-    const AOC<const weights_t, 3> w(
-            w_, rnn.n_layer, rnn.n_dir, (int)blk.strides[1]);
-    /* Array of pointers for each part of weights */
-    const AOC<weights_t *, 3> weights(
-            weights_, rnn.n_layer, rnn.n_dir, n_parts);
+    /* Offsets of each part of weights from the start of the weights */
+    const AOC<dim_t, 3> offsets(offsets_, rnn.n_layer, rnn.n_dir, n_parts);
 
     for (int i = 0; i < rnn.n_layer; i++)
         for (int d = 0; d < rnn.n_dir; d++) {
-            size_t offset_weights = 0;
+            dim_t offset_weights = (i * rnn.n_dir + d) * blk.strides[1];
             for (int p = 0; p < n_parts; p++) {
-                weights(i, d, p) = (weights_t *)&w(i, d, offset_weights);
+                offsets(i, d, p) = offset_weights;
                 offset_weights += gates_per_part[p] * blk.strides[3];
             }
         }
 }
 
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
+        data_type_t acc_type>
+void _ref_rnn_common_t<aprop, src_type, weights_type,
+        acc_type>::init_parts_offsets() {
+    const rnn_conf_t &rnn = pd()->rnn_;
+    const memory_desc_t *weights_layer_md = pd()->weights_md(0);
+    const memory_desc_t *weights_iter_md = pd()->weights_md(1);
+#if DNNL_X64
+    // bf32 weights are reordered to bf16 at execution
+    if (rnn.is_bf32()) {
+        weights_layer_md = pd()->bf32_wei_layer_reorder_pd_->dst_md();
+        weights_iter_md = pd()->bf32_wei_iter_reorder_pd_->dst_md();
+    }
+#endif
+    const auto n_offsets = [&](const memory_desc_t *md, int n_parts) {
+        if (md->format_kind == format_kind::rnn_packed)
+            n_parts = md->format_desc.rnn_packed_desc.n_parts;
+        return (size_t)rnn.n_layer * rnn.n_dir * n_parts;
+    };
+
+    wei_iter_offsets_.resize(
+            n_offsets(weights_iter_md, rnn.n_parts_weights_iter));
+    (this->*weights_iter_assign_func)(rnn, weights_iter_md,
+            rnn.n_parts_weights_iter, rnn.parts_weights_iter,
+            wei_iter_offsets_.data());
+    wei_layer_offsets_.resize(
+            n_offsets(weights_layer_md, rnn.n_parts_weights_layer));
+    (this->*weights_layer_assign_func)(rnn, weights_layer_md,
+            rnn.n_parts_weights_layer, rnn.parts_weights_layer,
+            wei_layer_offsets_.data());
+    if (rnn.is_lstm_projection) {
+        const memory_desc_t *md = pd()->arg_md(DNNL_ARG_WEIGHTS_PROJECTION);
+        wei_projection_offsets_.resize(
+                n_offsets(md, rnn.n_parts_weights_projection));
+        (this->*weights_projection_assign_func)(rnn, md,
+                rnn.n_parts_weights_projection, rnn.parts_weights_projection,
+                wei_projection_offsets_.data());
+    }
+
+    bias_offsets_.resize((size_t)rnn.n_layer * rnn.n_dir * rnn.n_parts_bias);
+    const AOC<dim_t, 3> bias_offsets(
+            bias_offsets_.data(), rnn.n_layer, rnn.n_dir, rnn.n_parts_bias);
+    for (int i = 0; i < rnn.n_layer; i++)
+        for (int d = 0; d < rnn.n_dir; d++) {
+            dim_t offset_bias = (i * rnn.n_dir + d) * rnn.n_bias * rnn.dhc;
+            for (int p = 0; p < rnn.n_parts_bias; p++) {
+                bias_offsets(i, d, p) = offset_bias;
+                offset_bias += rnn.parts_bias[p] * rnn.dhc;
+            }
+        }
+}
+
 //********************* Execution function *********************//
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
         data_type_t acc_type>
-void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
+void _ref_rnn_common_t<aprop, src_type, weights_type,
+        acc_type>::copy_res_seq_lengths(const rnn_conf_t &rnn,
+        const int32_t *seq_lengths, void *dst_layer_, void *dst_iter_,
+        void *dst_iter_c_, const src_iter_t *ws_states_iter_,
+        const void *ws_states_iter_c_) const {
+    const AOC<const src_iter_t, 5> ws_states_iter(ws_states_iter_,
+            rnn.n_layer + 1, rnn.n_dir, rnn.n_iter + 1, rnn.mb,
+            rnn.ws_states_iter_ld);
+    const auto ws_states_iter_c = rnn_utils::make_raw_aoc(ws_states_iter_c_,
+            types::data_type_size(rnn.src_iter_c_dt), rnn.n_layer + 1,
+            rnn.n_dir, rnn.n_iter + 1, rnn.ws_states_iter_c_nld,
+            rnn.ws_states_iter_c_ld);
+
+    const memory_desc_wrapper dst_layer_d(pd()->dst_md(0));
+    const memory_desc_wrapper dst_iter_d(pd()->dst_md(1));
+    const memory_desc_wrapper dst_iter_c_d(pd()->dst_md(2));
+    const auto dst_layer_dt = dst_layer_d.data_type();
+    const auto dst_iter_dt = dst_iter_d.data_type();
+
+    parallel_nd(rnn.mb, [&](dim_t b) {
+        const int len = seq_lengths[b];
+        if (len == rnn.n_iter) return;
+
+        if (dst_iter_) {
+            for (int lay = 0; lay < rnn.n_layer - 1; lay++) {
+                const auto *ss = &ws_states_iter(lay + 1, 0, len, b, 0);
+                for (int s = 0; s < rnn.dic; s++)
+                    io::store_float_value(dst_iter_dt, (float)ss[s], dst_iter_,
+                            dst_iter_d.off(lay, 0, b, s));
+            }
+            // The states of the last layer are already in dst_layer.
+            for (int s = 0; s < rnn.dic; s++) {
+                const float h = io::load_float_value(dst_layer_dt, dst_layer_,
+                        dst_layer_d.off(len - 1, b, s));
+                io::store_float_value(dst_iter_dt, h, dst_iter_,
+                        dst_iter_d.off(rnn.n_layer - 1, 0, b, s));
+            }
+        }
+
+        if (dst_iter_c_) {
+            for (int lay = 0; lay < rnn.n_layer; lay++) {
+                const void *cc = ws_states_iter_c(lay + 1, 0, len, b, 0);
+                for (int s = 0; s < rnn.dhc; s++) {
+                    const float c = io::load_float_value(
+                            rnn.src_iter_c_dt, cc, s);
+                    io::store_float_value(rnn.dst_iter_c_dt, c, dst_iter_c_,
+                            dst_iter_c_d.off(lay, 0, b, s));
+                }
+            }
+        }
+
+        for_(int t = len; t < rnn.n_iter; t++)
+        for (int s = 0; s < rnn.dlc; s++)
+            io::store_float_value(
+                    dst_layer_dt, 0.f, dst_layer_, dst_layer_d.off(t, b, s));
+    });
+}
+
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
+        data_type_t acc_type>
+void _ref_rnn_common_t<aprop, src_type, weights_type,
+        acc_type>::copy_res_stateful(const rnn_conf_t &rnn,
+        const void *dst_layer_, src_iter_t *ws_states_iter_,
+        void *ws_states_iter_c_) const {
+    const AOC<src_iter_t, 5> ws_states_iter(ws_states_iter_, rnn.n_layer + 1,
+            rnn.n_dir, rnn.n_iter + 1, rnn.mb, rnn.ws_states_iter_ld);
+    const size_t c_dt_size = types::data_type_size(rnn.src_iter_c_dt);
+    const auto ws_states_iter_c = rnn_utils::make_raw_aoc(ws_states_iter_c_,
+            c_dt_size, rnn.n_layer + 1, rnn.n_dir, rnn.n_iter + 1,
+            rnn.ws_states_iter_c_nld, rnn.ws_states_iter_c_ld);
+    const bool with_c = rnn.ws_states_iter_c_size > 0;
+
+    const memory_desc_wrapper dst_layer_d(pd()->dst_md(0));
+    const auto *dst_layer = static_cast<const char *>(dst_layer_);
+
+    parallel_nd(rnn.n_layer, rnn.mb, [&](dim_t lay, dim_t b) {
+        // The last layer writes its states directly to dst_layer if the copy
+        // is skipped, the data types of both match in this case.
+        const void *ss = (lay == rnn.n_layer - 1 && rnn.skip_dst_layer_copy())
+                ? dst_layer
+                        + dst_layer_d.blk_off(rnn.n_iter - 1, b)
+                                * sizeof(src_iter_t)
+                : static_cast<const void *>(
+                        &ws_states_iter(lay + 1, 0, rnn.n_iter, b, 0));
+        std::memcpy(&ws_states_iter(lay + 1, 0, 0, b, 0), ss,
+                rnn.dic * sizeof(src_iter_t));
+
+        if (with_c) {
+            const void *cc_res = ws_states_iter_c(lay + 1, 0, rnn.n_iter, b, 0);
+            const void *cc_init = ws_states_iter_c(lay + 1, 0, 0, b, 0);
+            std::memcpy(const_cast<void *>(cc_init), cc_res,
+                    rnn.dhc * c_dt_size);
+        }
+    });
+}
+
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
+        data_type_t acc_type>
+status_t _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
         const exec_ctx_t &ctx) const {
     const rnn_conf_t &rnn = this->pd()->rnn_;
+
+    const int32_t *seq_lengths = pd()->with_seq_lengths()
+            ? CTX_IN_MEM(const int32_t *, DNNL_ARG_SEQ_LENGTHS)
+            : nullptr;
+    if (seq_lengths) {
+        for (int b = 0; b < rnn.mb; b++) {
+            const bool ok = seq_lengths[b] >= 1
+                    && seq_lengths[b] <= rnn.n_iter
+                    && IMPLICATION(b > 0, seq_lengths[b] <= seq_lengths[b - 1]);
+            if (!ok) return status::invalid_arguments;
+        }
+        // Sequences of full length need no special handling.
+        if (seq_lengths[rnn.mb - 1] == rnn.n_iter) seq_lengths = nullptr;
+    }
+
     auto src_layer = CTX_IN_MEM(const src_layer_t *, DNNL_ARG_SRC_LAYER);
     auto augru_attention
             = CTX_IN_MEM(const src_layer_t *, DNNL_ARG_AUGRU_ATTENTION);
@@ -1281,19 +1535,6 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
      * dimension */
     (this->*bias_preparation_func)(rnn, ptr_bias, bias, ws_bias);
 
-    const memory_desc_t *weights_layer_md = pd()->weights_md(0);
-    const memory_desc_t *weights_iter_md = pd()->weights_md(1);
-
-    const auto tag = rnn.n_block == 64 ? format_tag::ldgOI64o2i
-                                       : format_tag::ldgOI32o2i;
-    memory_desc_t wei_layer_desc;
-    memory_desc_init_by_tag(wei_layer_desc, weights_layer_md->ndims,
-            weights_layer_md->dims, data_type::bf16, tag);
-
-    memory_desc_t wei_iter_desc;
-    memory_desc_init_by_tag(wei_iter_desc, weights_iter_md->ndims,
-            weights_iter_md->dims, data_type::bf16, tag);
-
 #if DNNL_X64
     if (rnn.is_bf32()) {
         if (rnn.is_augru) {
@@ -1310,8 +1551,9 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
         auto wei_iter_mem
                 = scratchpad.get_memory_storage(key_rnn_bf32_wei_iter_trans);
         {
-            memory_t reorder_dst(
-                    engine, &wei_layer_desc, std::move(wei_layer_mem));
+            memory_t reorder_dst(engine,
+                    pd()->bf32_wei_layer_reorder_pd_->dst_md(),
+                    std::move(wei_layer_mem));
             exec_args_t reorder_args;
             reorder_args[DNNL_ARG_SRC] = ctx.args().at(DNNL_ARG_WEIGHTS_LAYER);
             reorder_args[DNNL_ARG_DST] = {&reorder_dst, false};
@@ -1322,12 +1564,12 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
             bf32_wei_layer_reorder_->execute(reorder_ctx);
             w_layer = scratchpad.template get<weights_t>(
                     key_rnn_bf32_wei_layer_trans);
-            weights_layer_md = &wei_layer_desc;
         }
 
         {
-            memory_t reorder_dst(
-                    engine, &wei_iter_desc, std::move(wei_iter_mem));
+            memory_t reorder_dst(engine,
+                    pd()->bf32_wei_iter_reorder_pd_->dst_md(),
+                    std::move(wei_iter_mem));
             exec_args_t reorder_args;
             reorder_args[DNNL_ARG_SRC] = ctx.args().at(DNNL_ARG_WEIGHTS_ITER);
             reorder_args[DNNL_ARG_DST] = {&reorder_dst, false};
@@ -1338,24 +1580,15 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
             bf32_wei_iter_reorder_->execute(reorder_ctx);
             w_iter = scratchpad.template get<weights_t>(
                     key_rnn_bf32_wei_iter_trans);
-            weights_iter_md = &wei_iter_desc;
         }
     }
 #endif
 
-    (this->*weights_iter_assign_func)(rnn, weights_iter_md,
-            rnn.n_parts_weights_iter, rnn.parts_weights_iter, ptr_wei_iter,
-            w_iter);
-    (this->*weights_layer_assign_func)(rnn, weights_layer_md,
-            rnn.n_parts_weights_layer, rnn.parts_weights_layer, ptr_wei_layer,
-            w_layer);
-
-    if (rnn.is_lstm_projection) {
-        (this->*weights_projection_assign_func)(rnn,
-                pd()->arg_md(DNNL_ARG_WEIGHTS_PROJECTION),
-                rnn.n_parts_weights_projection, rnn.parts_weights_projection,
-                ptr_wei_projection, w_projection);
-    }
+    // The offsets of the weights parts are computed at init
+    rebase_parts(wei_iter_offsets_, w_iter, ptr_wei_iter);
+    rebase_parts(wei_layer_offsets_, w_layer, ptr_wei_layer);
+    if (rnn.is_lstm_projection)
+        rebase_parts(wei_projection_offsets_, w_projection, ptr_wei_projection);
 
     (this->*bias_finalization_func)(rnn, ws_bias, w_iter_comp, w_layer_comp);
 
@@ -1369,7 +1602,8 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
                     src_layer, diff_dst_layer);
     }
 
-    if (!(rnn.skip_src_iter_copy() && rnn.is_fwd)) {
+    // In stateful mode the initial states are left by the previous execution
+    if (!(rnn.skip_src_iter_copy() && rnn.is_fwd) && !rnn.is_stateful) {
         if (pd()->src_md(1)->data_type == data_type::f32)
             copy_init_iter(rnn, ws_states_iter,
                     static_cast<void *>(ws_states_iter_c), ws_diff_states_iter,
@@ -1400,12 +1634,11 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
 #endif
             diff_augru_attention, diff_weights_layer, diff_weights_iter,
             diff_weights_projection, diff_weights_peephole, diff_bias,
-            amx_scratchpad
+            amx_scratchpad,
 #if DNNL_X64
-            ,
-            addr_batch_global
+            addr_batch_global,
 #endif
-    );
+            seq_lengths);
 
     // Finally we copy the results to the result buffers
     if (!(rnn.skip_dst_layer_copy() && rnn.is_fwd)) {
@@ -1429,6 +1662,15 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
                     ws_states_iter_c, ws_diff_states_iter,
                     ws_diff_states_iter_c);
     }
+
+    if (seq_lengths)
+        copy_res_seq_lengths(rnn, seq_lengths, dst_layer, dst_iter, dst_iter_c,
+                ws_states_iter, ws_states_iter_c);
+
+    if (rnn.is_stateful)
+        copy_res_stateful(rnn, dst_layer, ws_states_iter, ws_states_iter_c);
+
+    return status::success;
 };
 
 /* Fix for MSVS warning C4661 */
@@ -19,6 +19,7 @@
 
 #include <assert.h>
 #include <tuple>
+#include <vector>
 
 #include "common/c_types_map.hpp"
 #include "common/memory_tracking.hpp"
@@ -334,7 +335,8 @@ struct _ref_rnn_common_t : public primitive_t {
 
             if (rnn_.is_signed_int8_conf() && !mayiuse(avx512_core_amx))
                 return status::unimplemented;
-            if (rnn_.is_int8_conf() && !mayiuse(avx512_core_vnni))
+            if (rnn_.is_int8_conf()
+                    && !(mayiuse(avx512_core_vnni) || mayiuse(avx2_vnni)))
                 return status::unimplemented;
             if (rnn_.is_f32_conf() && !mayiuse(avx512_core))
                 return status::unimplemented;
@@ -469,11 +471,12 @@ struct _ref_rnn_common_t : public primitive_t {
 
                 init_scratchpad(scratchpad_sz);
                 // initialize the workspace if needed
-                if (rnn_.is_training) {
+                if (rnn_.use_workspace) {
                     dims_t ws_dims = {(dim_t)ws_sz};
                     memory_desc_init_by_tag(this->ws_md_, 1, ws_dims,
                             data_type::u8, format_tag::x);
                 }
+                init_seq_lengths();
             }
             return st;
         }
@@ -484,6 +487,22 @@ struct _ref_rnn_common_t : public primitive_t {
         std::shared_ptr<primitive_desc_t> bf32_wei_iter_reorder_pd_;
 #endif
     private:
+        // Variable-length sequences are supported for unidirectional
+        // inference with f32 and bf16 data only. In other cases the sequence
+        // lengths argument is not used by the primitive.
+        void init_seq_lengths() {
+            const bool ok = aprop == prop_kind::forward && !rnn_.is_training
+                    && !rnn_.is_stateful
+                    && this->direction() == dnnl_unidirectional_left2right
+                    && ((rnn_.is_f32_conf() && !rnn_.is_bf32())
+                            || rnn_.is_bf16_conf());
+            if (!ok) return;
+
+            dims_t dims = {rnn_.mb};
+            memory_desc_init_by_tag(this->seq_lengths_md_, 1, dims,
+                    data_type::s32, format_tag::a);
+        }
+
         void init_scratchpad(size_t scratchpad_sz) {
             using namespace memory_tracking::names;
             auto scratchpad = this->scratchpad_registry().registrar();
@@ -516,13 +535,15 @@ struct _ref_rnn_common_t : public primitive_t {
             scratchpad.template book<void *>(
                     key_rnn_ptrs_bia, ptr_wei_sz * bias_dt_size);
 
+            const size_t n_cells = rnn_.n_concurrent_cells;
             scratchpad.template book<scratch_t>(
-                    key_rnn_gates, rnn_.scratch_gates_size);
-            scratchpad.template book<ht_t>(key_rnn_ht, rnn_.scratch_ht_size);
+                    key_rnn_gates, n_cells * rnn_.scratch_gates_size);
+            scratchpad.template book<ht_t>(
+                    key_rnn_ht, n_cells * rnn_.scratch_ht_size);
             scratchpad.template book<gemm_acc_t>(
                     key_rnn_diff_ht, rnn_.scratch_diff_ht_size);
             scratchpad.template book<scratch_t>(
-                    key_rnn_cell, rnn_.scratch_cell_size);
+                    key_rnn_cell, n_cells * rnn_.scratch_cell_size);
 
 #if DNNL_X64
             if (rnn_.is_brgemm) {
@@ -599,6 +620,8 @@ struct _ref_rnn_common_t : public primitive_t {
             default: break;
         }
 
+        init_parts_offsets();
+
         merged_layer_func = pd()->rnn_.is_brgemm && pd()->rnn_.merge_gemm_layer
                         && aprop == prop_kind::forward
                 ? &class_name::merged_layer_brgemm_fwd
@@ -633,8 +656,7 @@ struct _ref_rnn_common_t : public primitive_t {
     ~_ref_rnn_common_t() { delete rnn_postgemm_; }
 
     status_t execute(const exec_ctx_t &ctx) const override {
-        execute_(ctx);
-        return status::success;
+        return execute_(ctx);
     }
 
 private:
@@ -643,7 +665,7 @@ private:
     std::shared_ptr<primitive_t> bf32_wei_layer_reorder_;
     std::shared_ptr<primitive_t> bf32_wei_iter_reorder_;
 #endif
-    void execute_(const exec_ctx_t &ctx) const;
+    status_t execute_(const exec_ctx_t &ctx) const;
 
     rnn_grid_execution_sig(linear_execution);
     rnn_cell_execution_sig(cell_execution_ref);
@@ -660,6 +682,7 @@ private:
     rnn_bias_finalize_sig(bias_finalize);
     rnn_weights_assign_sig(assign_weights);
     rnn_weights_assign_sig(assign_packed_weights);
+    void init_parts_offsets();
 
     float (*activation_func)(float s, float alpha, float cliping);
 
@@ -691,6 +714,21 @@ private:
             const gemm_acc_t *ws_diff_states_iter_,
             const gemm_acc_t *ws_diff_states_iter_c_) const;
 
+    // Writes the results of sequences shorter than the number of iterations
+    // to the user buffers: dst_iter and dst_iter_c get the states of the last
+    // step of every sequence and dst_layer is zeroed past the end of it.
+    void copy_res_seq_lengths(const rnn_utils::rnn_conf_t &rnn,
+            const int32_t *seq_lengths, void *dst_layer_, void *dst_iter_,
+            void *dst_iter_c_, const src_iter_t *ws_states_iter_,
+            const void *ws_states_iter_c_) const;
+
+    // Moves the final states of the stateful execution to the slots of the
+    // initial states in the workspace, so the next execution continues from
+    // them.
+    void copy_res_stateful(const rnn_utils::rnn_conf_t &rnn,
+            const void *dst_layer_, src_iter_t *ws_states_iter_,
+            void *ws_states_iter_c_) const;
+
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
 
     size_t ws_gates_offset_;
@@ -720,6 +758,14 @@ private:
     weights_assign_t weights_iter_assign_func;
     weights_assign_t weights_projection_assign_func;
 
+    // Offsets of the parts of the weights and bias from the start of the
+    // tensors, computed once at init. Execution only adds them to the
+    // addresses of the tensors it is given.
+    std::vector<dim_t> wei_layer_offsets_;
+    std::vector<dim_t> wei_iter_offsets_;
+    std::vector<dim_t> wei_projection_offsets_;
+    std::vector<dim_t> bias_offsets_;
+
     gemm_t gemm_layer_func;
     gemm_t gemm_iter_func;
     gemm_t gemm_projection_func;
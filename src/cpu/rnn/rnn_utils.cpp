@@ -57,6 +57,22 @@ static bool check_dims_contiguous_except_one(const memory_desc_wrapper &mdw,
     return true;
 }
 
+bool rnn_utils::use_wavefront_execution(const rnn_desc_t &rd) {
+    if (rd.prop_kind != prop_kind::forward_inference) return false;
+
+    const dim_t n_layer = rd.weights_layer_desc.dims[0];
+    const dim_t n_dir = rd.weights_layer_desc.dims[1];
+    const dim_t n_iter = rd.src_layer_desc.dims[0];
+    const dim_t mb = rd.src_layer_desc.dims[1];
+
+    // A cell of a small minibatch cannot keep many threads busy, while the
+    // cells of an anti-diagonal can be spread over the threads.
+    static constexpr dim_t max_mb = 8;
+    const dim_t max_concurrent_cells = n_dir * nstl::min(n_layer, n_iter);
+    return mb <= max_mb && max_concurrent_cells > 1
+            && dnnl_get_max_threads() > 1;
+}
+
 bool rnn_utils::is_ldigo(const memory_desc_wrapper &mdw) {
     return check_dims_contiguous_except_one(mdw, 2, {0, 1, 2, 3, 4});
 }
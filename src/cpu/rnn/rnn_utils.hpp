@@ -98,7 +98,8 @@
             gemm_acc_t *diff_weights_layer_, gemm_acc_t *diff_weights_iter_, \
             float *diff_weights_projection_, float *diff_weights_peephole_, \
             float *diff_bias_, gemm_acc_t *amx_scratchpad, \
-            x64::brgemm_batch_element_t *addr_batch_global) const
+            x64::brgemm_batch_element_t *addr_batch_global, \
+            const int32_t *seq_lengths_) const
 #else
 #define rnn_merged_layer_execution_sig(f) \
     dnnl_status_t f(const rnn_utils::rnn_conf_t &rnn, \
@@ -143,7 +144,8 @@
             scratch_t *scratch_cell_, gemm_acc_t *diff_augru_attention_, \
             gemm_acc_t *diff_weights_layer_, gemm_acc_t *diff_weights_iter_, \
             float *diff_weights_projection_, float *diff_weights_peephole_, \
-            float *diff_bias_, gemm_acc_t *amx_scratchpad) const
+            float *diff_bias_, gemm_acc_t *amx_scratchpad, \
+            const int32_t *seq_lengths_) const
 #endif
 
 #define rnn_gemm_sig(f) \
@@ -167,8 +169,7 @@
 
 #define rnn_weights_assign_sig(f) \
     void f(const rnn_utils::rnn_conf_t &rnn, const memory_desc_t *md, \
-            int n_parts, const int *gates_per_part, weights_t **weights_, \
-            const weights_t *w_) const
+            int n_parts, const int *gates_per_part, dim_t *offsets_) const
 
 namespace dnnl {
 namespace impl {
@@ -342,6 +343,8 @@ struct rnn_conf_t {
     bool is_fwd = 0, is_training = 0, is_lbr = 0, is_lstm_peephole = 0,
          is_lstm_projection = 0, is_augru = 0, is_orig_gru = 0;
     bool use_workspace = 0;
+    // States are kept in the workspace between executions
+    bool is_stateful = 0;
 
     // Size of workspace for each tensor in bytes
     // Notes:
@@ -376,6 +379,10 @@ struct rnn_conf_t {
          force_nocopy = false, use_layer_packed_gemm = false,
          use_iter_packed_gemm = false, use_projection_packed_gemm = false;
     int n_iter_scratch_gates = 0;
+    // Independent cells of the grid are executed concurrently, each of them
+    // uses its own part of the scratch buffers.
+    bool wavefront = false;
+    int n_concurrent_cells = 1;
 
     inline bool is_int8_conf() const {
         return is_signed_int8_conf() || is_unsigned_int8_conf();
@@ -607,6 +614,10 @@ bool is_ldgoi_blocked(const memory_desc_wrapper &md);
 bool is_ldio_blocked(const memory_desc_wrapper &md);
 bool is_ldoi_blocked(const memory_desc_wrapper &md);
 
+// Returns true if the cells on the same anti-diagonal of the (layer,
+// iteration) grid are better executed concurrently than one by one.
+bool use_wavefront_execution(const rnn_desc_t &rd);
+
 int get_good_ld(int dim, int sizeof_dt);
 
 template <typename T>
@@ -625,6 +636,7 @@ bool init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
             prop_kind::forward_inference);
     rnn.is_training = utils::one_of(
             rd.prop_kind, prop_kind::forward_training, prop_kind::backward);
+    rnn.is_stateful = rd.flags & dnnl_rnn_flags_stateful;
     rnn.is_lbr = utils::one_of(rd.cell_kind, dnnl_lbr_gru, dnnl_lbr_augru);
     rnn.is_lstm_peephole = rd.cell_kind == dnnl_vanilla_lstm
             && !memory_desc_wrapper(rd.weights_peephole_desc).is_zero();
@@ -810,7 +822,14 @@ bool init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
             = dst_layer_d.blocking_desc().strides[0]
             == (rnn.dst_layer_ld_ * rnn.mb);
 
-    rnn.merge_gemm_layer = (!rnn.is_brgemm)
+    // The layer GEMM merged across iterations has to be computed before the
+    // first cell of the layer, which serializes the layers.
+    rnn.wavefront = !rnn.is_brgemm && use_wavefront_execution(rd);
+    rnn.n_concurrent_cells = rnn.wavefront
+            ? rnn.n_dir * nstl::min(rnn.n_layer, rnn.n_iter)
+            : 1;
+
+    rnn.merge_gemm_layer = (!rnn.is_brgemm && !rnn.wavefront)
             ? ((rnn.is_fwd && rnn.src_layer_is_trivial_stride)
                       || ((rd.prop_kind == prop_kind::backward)
                               && dst_layer_is_trivial_stride))
@@ -1022,7 +1041,7 @@ void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
 
 template <typename T>
 void set_workspace_sizes(rnn_conf_t &rnn, const rnn_desc_t &rd) {
-    rnn.use_workspace = rnn.is_training;
+    rnn.use_workspace = rnn.is_training || rnn.is_stateful;
     // TODO: for inference, we can make ws_states_* smaller, but
     // dependant of the grid execution though
     rnn.ws_states_layer_size = (size_t)(rnn.n_layer + 1) * rnn.n_dir
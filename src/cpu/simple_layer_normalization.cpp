@@ -39,7 +39,8 @@ status_t simple_layer_normalization_fwd_t::pd_t::init(engine_t *engine) {
     using skip_mask_t = primitive_attr_t::skip_mask_t;
     const memory_desc_wrapper src_d(src_md());
 
-    const bool ok = is_fwd() && !has_zero_dim_memory()
+    const bool ok = is_fwd() && !has_zero_dim_memory() && !use_rms_norm()
+            && !fuse_residual_add()
             && utils::one_of(src_md()->data_type, f32, bf16, f16, s8, u8)
             && utils::one_of(dst_md()->data_type, f32, bf16, f16, s8, u8)
             && platform::has_data_type_support(src_md()->data_type)
@@ -200,7 +201,7 @@ status_t simple_layer_normalization_bwd_t::pd_t::init(engine_t *engine) {
     using namespace data_type;
     const memory_desc_wrapper src_d(src_md());
 
-    const bool ok = is_bwd() && !has_zero_dim_memory()
+    const bool ok = is_bwd() && !has_zero_dim_memory() && !use_rms_norm()
             && utils::one_of(src_md()->data_type, f32, bf16, f16)
             && utils::one_of(diff_dst_md()->data_type, f32, bf16, f16)
             && utils::one_of(diff_src_md()->data_type, f32, bf16, f16)
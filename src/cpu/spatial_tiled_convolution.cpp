@@ -0,0 +1,281 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <utility>
+
+#include "common/convolution_pd.hpp"
+#include "common/memory.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive_desc_iterator.hpp"
+#include "common/stream.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/spatial_tiled_convolution.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+status_t spatial_tiled_convolution_fwd_t::pd_t::init_formats() {
+    const auto cl_tag = pick(ndims() - 3, format_tag::nwc, format_tag::nhwc,
+            format_tag::ndhwc);
+
+    if (src_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(src_md_, cl_tag));
+    if (dst_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(dst_md_, cl_tag));
+    if (with_bias() && bias_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_tag(bias_md_, format_tag::x));
+
+    const memory_desc_wrapper src_d(&src_md_);
+    const memory_desc_wrapper dst_d(&dst_md_);
+    if (!src_d.matches_tag(cl_tag) || !dst_d.matches_tag(cl_tag))
+        return status::unimplemented;
+
+    return status::success;
+}
+
+status_t spatial_tiled_convolution_fwd_t::pd_t::create_conv_pd(
+        engine_t *engine, const primitive_attr_t &attr, dim_t mb,
+        const tile_t &tile, memory_desc_t &wei_md,
+        std::shared_ptr<primitive_desc_t> &conv_pd) {
+    const auto cl_tag = pick(ndims() - 3, format_tag::nwc, format_tag::nhwc,
+            format_tag::ndhwc);
+
+    memory_desc_t src_md = src_md_;
+    src_md.dims[0] = mb;
+    src_md.dims[2] = tile.i_len;
+    CHECK(memory_desc_init_by_tag(src_md, cl_tag));
+
+    memory_desc_t dst_md = dst_md_;
+    dst_md.dims[0] = mb;
+    dst_md.dims[2] = tile.o_len;
+    CHECK(memory_desc_init_by_tag(dst_md, cl_tag));
+
+    dims_t padding_l, padding_r;
+    array_copy(padding_l, desc()->padding[0], ndims() - 2);
+    array_copy(padding_r, desc()->padding[1], ndims() - 2);
+    padding_l[0] = tile.pad_l;
+    padding_r[0] = tile.pad_r;
+
+    convolution_desc_t cd;
+    CHECK(conv_desc_init(&cd, desc()->prop_kind, alg_kind::convolution_direct,
+            &src_md, &wei_md, &bias_md_, &dst_md, desc()->strides,
+            desc()->dilates, padding_l, padding_r));
+
+    primitive_desc_iterator_t it(engine, (op_desc_t *)&cd, &attr, nullptr);
+    if (!it.is_initialized()) return status::out_of_memory;
+    if (++it == it.end()) return status::unimplemented;
+    conv_pd = *it;
+
+    // All tiles share the user weights, so the first nested implementation
+    // defines their layout and the others have to follow it.
+    if (wei_md.format_kind == format_kind::any)
+        wei_md = *conv_pd->weights_md();
+    if (*conv_pd->weights_md() != wei_md) return status::unimplemented;
+
+    return status::success;
+}
+
+status_t spatial_tiled_convolution_fwd_t::pd_t::init_tiles(engine_t *engine,
+        const primitive_attr_t &attr, dim_t tile_size, memory_desc_t &wei_md) {
+    const dim_t O = dst_md_.dims[2];
+    const dim_t I = src_md_.dims[2];
+    const dim_t K = weights_md_.dims[with_groups() + 2];
+    const dim_t S = desc()->strides[0];
+    const dim_t DL = desc()->dilates[0];
+    const dim_t PL = desc()->padding[0][0];
+    const dim_t ext = (K - 1) * (DL + 1);
+
+    tiles_.clear();
+    conv_pds_.clear();
+    // Representative tile for every nested primitive descriptor.
+    std::vector<tile_t> confs;
+
+    for (dim_t o_start = 0; o_start < O; o_start += tile_size) {
+        tile_t t;
+        t.o_start = o_start;
+        t.o_len = nstl::min(tile_size, O - o_start);
+
+        // First and last (inclusive) input rows read by the tile, may point
+        // to the padding area.
+        const dim_t i_first = t.o_start * S - PL;
+        const dim_t i_last = (t.o_start + t.o_len - 1) * S - PL + ext;
+        t.i_start = nstl::max(i_first, (dim_t)0);
+        const dim_t i_end = nstl::min(i_last, I - 1);
+        // A tile that reads padding only cannot be expressed as a convolution.
+        if (i_end < t.i_start) return status::unimplemented;
+        t.i_len = i_end - t.i_start + 1;
+        t.pad_l = t.i_start - i_first;
+        t.pad_r = i_last - i_end;
+
+        t.conf = confs.size();
+        for (size_t c = 0; c < confs.size(); ++c) {
+            const auto &r = confs[c];
+            if (r.o_len == t.o_len && r.i_len == t.i_len && r.pad_l == t.pad_l
+                    && r.pad_r == t.pad_r) {
+                t.conf = c;
+                break;
+            }
+        }
+        if (t.conf == confs.size()) {
+            std::shared_ptr<primitive_desc_t> conv_pd;
+            CHECK(create_conv_pd(engine, attr, 1, t, wei_md, conv_pd));
+            conv_pds_.push_back(conv_pd);
+            confs.push_back(t);
+        }
+        tiles_.push_back(t);
+    }
+
+    return status::success;
+}
+
+status_t spatial_tiled_convolution_fwd_t::pd_t::init(engine_t *engine) {
+    using smask_t = primitive_attr_t::skip_mask_t;
+
+    const auto &po = attr()->post_ops_;
+    bool post_ops_ok = true;
+    // Binary post-ops may be applied per spatial point, which the nested
+    // problem cannot address.
+    for (int i = 0; i < po.len(); ++i)
+        post_ops_ok = post_ops_ok
+                && (po.contain(primitive_kind::eltwise, i)
+                        || po.contain(primitive_kind::sum, i));
+
+    const size_t limit = attr()->scratchpad_limit_;
+    const bool ok = is_fwd()
+            && set_default_alg_kind(alg_kind::convolution_direct)
+            && limit > 0
+            && attr()->has_default_values(smask_t::scales_runtime
+                    | smask_t::zero_points_runtime | smask_t::post_ops
+                    | smask_t::sum_dt)
+            && post_ops_ok && !has_zero_dim_memory();
+    if (!ok) return status::unimplemented;
+
+    CHECK(init_formats());
+    CHECK(attr_.set_default_formats(&dst_md_));
+
+    // The nested convolutions must not be tiled again.
+    primitive_attr_t conv_attr(*attr());
+    if (!conv_attr.is_initialized()) return status::out_of_memory;
+    CHECK(conv_attr.set_scratchpad_limit(0));
+
+    const dim_t O = dst_md_.dims[2];
+    const dim_t I = src_md_.dims[2];
+    const tile_t full = {0, O, 0, I, desc()->padding[0][0],
+            desc()->padding[1][0], 0};
+
+    // Nothing to gain if the regular implementation fits into the limit. The
+    // probe must not fix the weights layout for the tiles.
+    std::shared_ptr<primitive_desc_t> full_pd;
+    memory_desc_t full_wei_md = weights_md_;
+    CHECK(create_conv_pd(
+            engine, conv_attr, MB(), full, full_wei_md, full_pd));
+    if (full_pd->scratchpad_registry().size() <= limit)
+        return status::unimplemented;
+
+    // Halve the tile until the scratchpad fits into the limit. If even
+    // single-row tiles do not fit, they still give the smallest footprint.
+    // Every attempt chooses the weights layout anew.
+    memory_desc_t wei_md;
+    for (dim_t tile_size = O;; tile_size = div_up(tile_size, 2)) {
+        wei_md = weights_md_;
+        CHECK(init_tiles(engine, conv_attr, tile_size, wei_md));
+
+        size_t size = 0;
+        for (const auto &conv_pd : conv_pds_)
+            size = nstl::max(size, conv_pd->scratchpad_registry().size());
+        if (size <= limit || tile_size == 1) break;
+    }
+    weights_md_ = wei_md;
+
+    name_.append(conv_pds_[0]->name());
+    init_scratchpad();
+
+    return status::success;
+}
+
+void spatial_tiled_convolution_fwd_t::pd_t::init_scratchpad() {
+    // Tiles are executed one by one, so all nested primitives share the same
+    // buffer sized for the most demanding of them.
+    size_t max_conf = 0;
+    for (size_t c = 1; c < conv_pds_.size(); ++c)
+        if (conv_pds_[c]->scratchpad_registry().size()
+                > conv_pds_[max_conf]->scratchpad_registry().size())
+            max_conf = c;
+
+    auto scratchpad = scratchpad_registry().registrar();
+    scratchpad.book(key_nested, conv_pds_[max_conf]->scratchpad_registry());
+}
+
+status_t spatial_tiled_convolution_fwd_t::init(engine_t *engine) {
+    for (const auto &conv_pd : pd()->conv_pds_) {
+        std::shared_ptr<primitive_t> conv_p;
+        CHECK(conv_pd->create_primitive(conv_p, engine));
+        conv_ps_.push_back(conv_p);
+    }
+    return status::success;
+}
+
+status_t spatial_tiled_convolution_fwd_t::execute(
+        const exec_ctx_t &ctx) const {
+    engine_t *engine = ctx.stream()->engine();
+
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const size_t src_dt_size = src_d.data_type_size();
+    const size_t dst_dt_size = dst_d.data_type_size();
+
+    for_(dim_t n = 0; n < pd()->MB(); ++n)
+    for (const auto &tile : pd()->tiles()) {
+        const auto &conv_pd = pd()->conv_pds_[tile.conf];
+        const auto &conv_p = conv_ps_[tile.conf];
+
+        // Rows of a single image are contiguous in channels-last layouts.
+        const char *src_tile_ptr
+                = src + src_d.blk_off(n, 0, tile.i_start) * src_dt_size;
+        char *dst_tile_ptr
+                = dst + dst_d.blk_off(n, 0, tile.o_start) * dst_dt_size;
+        memory_t src_tile(engine, conv_pd->src_md(),
+                memory_flags_t::use_runtime_ptr,
+                const_cast<char *>(src_tile_ptr));
+        memory_t dst_tile(engine, conv_pd->dst_md(),
+                memory_flags_t::use_runtime_ptr, dst_tile_ptr);
+
+        exec_args_t conv_args = ctx.args();
+        conv_args[DNNL_ARG_SRC] = {&src_tile, true};
+        conv_args[DNNL_ARG_DST] = {&dst_tile, false};
+        exec_ctx_t conv_ctx(ctx, std::move(conv_args));
+
+        nested_scratchpad_t ns(ctx, key_nested, conv_p);
+        conv_ctx.set_scratchpad_grantor(ns.grantor());
+        CHECK(conv_p->execute(conv_ctx));
+    }
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,111 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_SPATIAL_TILED_CONVOLUTION_HPP
+#define CPU_SPATIAL_TILED_CONVOLUTION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_convolution_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Low-memory mode for convolutions over large images. Scratchpad buffers of
+// most implementations (e.g. the padded input buffer of brgemm convolution or
+// the im2col buffer of gemm convolution) grow with the spatial size of the
+// problem. When the user sets a scratchpad limit via attributes and the
+// regular implementation exceeds it, this implementation splits every image
+// into tiles along the outermost spatial dimension of the output and executes
+// a nested convolution per tile, so the scratchpad is bounded by the tile
+// size rather than by the image size. Only channels-last activations are
+// supported since a range of rows of a single image is then a dense tensor
+// that can be passed to the nested primitive without copying.
+struct spatial_tiled_convolution_fwd_t : public primitive_t {
+    // A range of output rows along the tiled dimension and the input rows it
+    // reads. The padding of the nested problem is what remains of the
+    // original padding after clipping the input range to the image.
+    struct tile_t {
+        dim_t o_start, o_len;
+        dim_t i_start, i_len;
+        dim_t pad_l, pad_r;
+        // Index of the nested primitive descriptor for this tile shape.
+        size_t conf;
+    };
+
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        pd_t(const convolution_desc_t *adesc, const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(adesc, attr, hint_fwd_pd) {}
+
+        pd_t(const pd_t &other)
+            : cpu_convolution_fwd_pd_t(other)
+            , tiles_(other.tiles_)
+            , name_(other.name_) {
+            for (const auto &conv_pd : other.conv_pds_)
+                conv_pds_.emplace_back(conv_pd->clone());
+        }
+
+        ~pd_t() = default;
+
+        DECLARE_COMMON_PD_T(name_.c_str(), spatial_tiled_convolution_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        const std::vector<tile_t> &tiles() const { return tiles_; }
+
+        // One nested primitive descriptor per distinct tile shape, usually
+        // the first, the inner, and the last tiles.
+        std::vector<std::shared_ptr<primitive_desc_t>> conv_pds_;
+
+    private:
+        std::vector<tile_t> tiles_;
+        std::string name_ = "tiled:";
+
+        status_t init_formats();
+        status_t create_conv_pd(engine_t *engine, const primitive_attr_t &attr,
+                dim_t mb, const tile_t &tile, memory_desc_t &wei_md,
+                std::shared_ptr<primitive_desc_t> &conv_pd);
+        status_t init_tiles(engine_t *engine, const primitive_attr_t &attr,
+                dim_t tile_size, memory_desc_t &wei_md);
+        void init_scratchpad();
+    };
+
+    spatial_tiled_convolution_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::vector<std::shared_ptr<primitive_t>> conv_ps_;
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,283 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+#include <utility>
+
+#include "common/convolution_pd.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive_desc_iterator.hpp"
+#include "common/reorder.hpp"
+#include "common/stream.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/x64/brgemm_grouped_conv.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+status_t brgemm_grouped_convolution_fwd_t::pd_t::init_pack_factor() {
+    // The packed problem has to fill at least one vector register along the
+    // output channels, otherwise the nested brgemm kernel is no better than
+    // the per-group one.
+    const dim_t simd_w = isa_max_vlen(get_max_cpu_isa()) / sizeof(float);
+    const dim_t icg = IC() / G();
+    const dim_t ocg = OC() / G();
+
+    // Depthwise convolutions are handled by brdgmm, and groups that already
+    // fill a vector register gain nothing from packing.
+    const bool is_small_group = !everyone_is(1, icg, ocg) && icg < simd_w
+            && ocg < simd_w;
+    if (!is_small_group) return status::unimplemented;
+
+    // Packing increases the amount of computations by a factor of gp, so pick
+    // the smallest divisor of G that fills a vector register.
+    gp_ = G();
+    for (dim_t d = 2; d < G(); ++d) {
+        if (G() % d == 0 && d * ocg >= simd_w) {
+            gp_ = d;
+            break;
+        }
+    }
+    if (gp_ == 1) return status::unimplemented;
+
+    return status::success;
+}
+
+status_t brgemm_grouped_convolution_fwd_t::pd_t::init_conv(engine_t *engine) {
+    const int nd = ndims();
+    const dim_t icg = IC() / G();
+    const dim_t ocg = OC() / G();
+
+    // Block-diagonal weights of the packed problem: {G / gp, gp * ocg,
+    // gp * icg, [kd,] [kh,] kw}.
+    dims_t wei_dims;
+    wei_dims[0] = G() / gp_;
+    wei_dims[1] = gp_ * ocg;
+    wei_dims[2] = gp_ * icg;
+    for (int d = 2; d < nd; ++d)
+        wei_dims[d + 1] = weights_md_.dims[d + 1];
+
+    const auto wei_dt = weights_md_.data_type;
+    const auto plain_tag = pick(nd - 3, format_tag::goiw, format_tag::goihw,
+            format_tag::goidhw);
+    CHECK(memory_desc_init_by_tag(
+            wei_plain_md_, nd + 1, wei_dims, wei_dt, plain_tag));
+
+    memory_desc_t conv_wei_md;
+    CHECK(memory_desc_init_by_tag(
+            conv_wei_md, nd + 1, wei_dims, wei_dt, format_tag::any));
+
+    convolution_desc_t cd;
+    CHECK(conv_desc_init(&cd, desc()->prop_kind, alg_kind::convolution_direct,
+            &src_md_, &conv_wei_md, &bias_md_, &dst_md_, desc()->strides,
+            desc()->dilates, desc()->padding[0], desc()->padding[1]));
+
+    primitive_desc_iterator_t it(engine, (op_desc_t *)&cd, attr(), nullptr);
+    if (!it.is_initialized()) return status::out_of_memory;
+
+    while (++it != it.end()) {
+        conv_pd_ = *it;
+        // Only brgemm-based implementations benefit from the wider groups.
+        const bool is_brgemm
+                = std::string(conv_pd_->name()).find("brgconv") == 0;
+        if (is_brgemm) break;
+        conv_pd_.reset();
+    }
+    if (!conv_pd_) return status::unimplemented;
+
+    // src and dst share the channel order with the nested problem, so the
+    // layouts chosen by the nested implementation apply as is.
+    if (src_md_.format_kind == format_kind::any)
+        src_md_ = *conv_pd_->src_md();
+    if (dst_md_.format_kind == format_kind::any)
+        dst_md_ = *conv_pd_->dst_md();
+    if (bias_md_.format_kind == format_kind::any)
+        bias_md_ = *conv_pd_->weights_md(1);
+    if (*conv_pd_->src_md() != src_md_ || *conv_pd_->dst_md() != dst_md_)
+        return status::unimplemented;
+
+    if (*conv_pd_->weights_md() != wei_plain_md_)
+        CHECK(reorder_primitive_desc_create(
+                reorder_pd_, engine, &wei_plain_md_, conv_pd_->weights_md()));
+
+    return status::success;
+}
+
+status_t brgemm_grouped_convolution_fwd_t::pd_t::init(engine_t *engine) {
+    using smask_t = primitive_attr_t::skip_mask_t;
+
+    const bool ok = is_fwd()
+            && set_default_alg_kind(alg_kind::convolution_direct)
+            && with_groups() && G() > 1 && mayiuse(avx512_core)
+            && attr()->has_default_values(smask_t::scales_runtime
+                    | smask_t::zero_points_runtime | smask_t::post_ops
+                    | smask_t::sum_dt | smask_t::dst_stats)
+            // fused depthwise convolution changes the dst shape
+            && attr()->post_ops_.find(primitive_kind::convolution) == -1
+            && !has_zero_dim_memory();
+    if (!ok) return status::unimplemented;
+
+    CHECK(init_pack_factor());
+
+    // Weights are repacked on every execution, so updates made in place under
+    // the same handle are always picked up. Any user layout without extra
+    // data (e.g. compensation) is acceptable.
+    if (weights_md_.format_kind == format_kind::any) {
+        const auto wei_tag = pick(ndims() - 3, format_tag::goiw,
+                format_tag::goihw, format_tag::goidhw);
+        CHECK(memory_desc_init_by_tag(weights_md_, wei_tag));
+    }
+    const memory_desc_wrapper wei_d(&weights_md_);
+    if (!wei_d.is_blocking_desc() || wei_d.extra().flags != 0)
+        return status::unimplemented;
+
+    CHECK(init_conv(engine));
+    CHECK(attr_.set_default_formats(&dst_md_));
+
+    name_.append(conv_pd_->name());
+    init_scratchpad();
+
+    return status::success;
+}
+
+void brgemm_grouped_convolution_fwd_t::pd_t::init_scratchpad() {
+    auto scratchpad = scratchpad_registry().registrar();
+
+    scratchpad.book(key_conv_grouped_wei_plain,
+            memory_desc_wrapper(wei_plain_md_).size(), 1);
+    if (reorder_pd_) {
+        scratchpad.book(key_conv_grouped_wei_packed,
+                memory_desc_wrapper(conv_pd_->weights_md()).size(), 1);
+        scratchpad.book(
+                key_nested_multiple + 0, reorder_pd_->scratchpad_registry());
+    }
+    scratchpad.book(key_nested_multiple + 1, conv_pd_->scratchpad_registry());
+}
+
+status_t brgemm_grouped_convolution_fwd_t::init(engine_t *engine) {
+    if (pd()->reorder_pd_)
+        CHECK(pd()->reorder_pd_->create_primitive(reorder_p_, engine));
+    CHECK(pd()->conv_pd_->create_primitive(conv_p_, engine));
+    return status::success;
+}
+
+void brgemm_grouped_convolution_fwd_t::pack_weights(
+        const exec_ctx_t &ctx, char *wei_plain) const {
+    const auto wei = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS);
+
+    const memory_desc_wrapper wei_d(pd()->weights_md());
+    const memory_desc_wrapper plain_d(pd()->wei_plain_md());
+    const size_t dt_size = wei_d.data_type_size();
+
+    const int nd = pd()->ndims();
+    const dim_t G = pd()->G();
+    const dim_t gp = pd()->packed_groups();
+    const dim_t icg = pd()->IC() / G;
+    const dim_t ocg = pd()->OC() / G;
+    const dim_t KD = pd()->KD(), KH = pd()->KH(), KW = pd()->KW();
+    const dim_t ks = KD * KH * KW;
+
+    // Off-diagonal blocks must be zero.
+    std::memset(wei_plain, 0, plain_d.size());
+
+    parallel_nd(G, ocg, [&](dim_t g, dim_t oc) {
+        const dim_t pg = g / gp;
+        const dim_t gi = g % gp;
+        for_(dim_t ic = 0; ic < icg; ++ic)
+        for (dim_t k = 0; k < ks; ++k) {
+            const dim_t kd = k / (KH * KW);
+            const dim_t kh = (k / KW) % KH;
+            const dim_t kw = k % KW;
+
+            dims_t pos;
+            pos[0] = g;
+            pos[1] = oc;
+            pos[2] = ic;
+            int d = 3;
+            if (nd == 5) pos[d++] = kd;
+            if (nd >= 4) pos[d++] = kh;
+            pos[d] = kw;
+            const dim_t src_off = wei_d.off_v(pos);
+
+            pos[0] = pg;
+            pos[1] = gi * ocg + oc;
+            pos[2] = gi * icg + ic;
+            const dim_t dst_off = plain_d.off_v(pos);
+
+            std::memcpy(wei_plain + dst_off * dt_size,
+                    wei + src_off * dt_size, dt_size);
+        }
+    });
+}
+
+status_t brgemm_grouped_convolution_fwd_t::execute(
+        const exec_ctx_t &ctx) const {
+    engine_t *engine = ctx.stream()->engine();
+    const auto scratchpad = ctx.get_scratchpad_grantor();
+
+    auto wei_plain_storage
+            = scratchpad.get_memory_storage(key_conv_grouped_wei_plain);
+    memory_t wei_plain(
+            engine, pd()->wei_plain_md(), std::move(wei_plain_storage));
+
+    void *wei_plain_ptr = nullptr;
+    CHECK(wei_plain.memory_storage()->get_data_handle(&wei_plain_ptr));
+    pack_weights(ctx, static_cast<char *>(wei_plain_ptr));
+
+    memory_t *conv_wei = &wei_plain;
+    std::unique_ptr<memory_t> wei_packed;
+    if (reorder_p_) {
+        auto wei_packed_storage
+                = scratchpad.get_memory_storage(key_conv_grouped_wei_packed);
+        wei_packed.reset(new memory_t(engine, pd()->conv_pd_->weights_md(),
+                std::move(wei_packed_storage)));
+
+        exec_args_t r_args;
+        r_args[DNNL_ARG_SRC] = {&wei_plain, true};
+        r_args[DNNL_ARG_DST] = {wei_packed.get(), false};
+        exec_ctx_t r_ctx(ctx, std::move(r_args));
+
+        nested_scratchpad_t ns(ctx, key_nested_multiple + 0, reorder_p_);
+        r_ctx.set_scratchpad_grantor(ns.grantor());
+        CHECK(reorder_p_->execute(r_ctx));
+
+        conv_wei = wei_packed.get();
+    }
+
+    exec_args_t conv_args = ctx.args();
+    conv_args[DNNL_ARG_WEIGHTS] = {conv_wei, true};
+    exec_ctx_t conv_ctx(ctx, std::move(conv_args));
+
+    nested_scratchpad_t ns(ctx, key_nested_multiple + 1, conv_p_);
+    conv_ctx.set_scratchpad_grantor(ns.grantor());
+
+    return conv_p_->execute(conv_ctx);
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
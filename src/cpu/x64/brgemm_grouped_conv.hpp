@@ -0,0 +1,100 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_BRGEMM_GROUPED_CONV_HPP
+#define CPU_X64_BRGEMM_GROUPED_CONV_HPP
+
+#include <memory>
+#include <string>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_convolution_pd.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Grouped convolution with few channels per group (e.g. ResNeXt blocks with
+// 4-8 channels per group) maps poorly onto brgemm: every group is a tiny GEMM
+// with N and K far below the vector length. This implementation packs `gp`
+// consecutive groups into a single wider group with a block-diagonal weights
+// tensor and executes the resulting convolution with G / gp groups through a
+// nested brgemm-based convolution. Activations are not touched since the
+// channel order of src and dst is the same for both problems.
+struct brgemm_grouped_convolution_fwd_t : public primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        pd_t(const convolution_desc_t *adesc, const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(adesc, attr, hint_fwd_pd) {}
+
+        pd_t(const pd_t &other)
+            : cpu_convolution_fwd_pd_t(other)
+            , conv_pd_(other.conv_pd_->clone())
+            , reorder_pd_(other.reorder_pd_ ? other.reorder_pd_->clone()
+                                            : nullptr)
+            , gp_(other.gp_)
+            , wei_plain_md_(other.wei_plain_md_)
+            , name_(other.name_) {}
+
+        ~pd_t() = default;
+
+        DECLARE_COMMON_PD_T(name_.c_str(), brgemm_grouped_convolution_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        // Number of original groups packed into a single nested group.
+        dim_t packed_groups() const { return gp_; }
+        // Block-diagonal weights in plain layout, before the nested reorder.
+        const memory_desc_t *wei_plain_md() const { return &wei_plain_md_; }
+
+        std::shared_ptr<primitive_desc_t> conv_pd_;
+        std::shared_ptr<primitive_desc_t> reorder_pd_;
+
+    private:
+        dim_t gp_ = 1;
+        memory_desc_t wei_plain_md_;
+        std::string name_ = "brg_grp:";
+
+        status_t init_pack_factor();
+        status_t init_conv(engine_t *engine);
+        void init_scratchpad();
+    };
+
+    brgemm_grouped_convolution_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    void pack_weights(const exec_ctx_t &ctx, char *wei_plain) const;
+
+    std::shared_ptr<primitive_t> conv_p_;
+    std::shared_ptr<primitive_t> reorder_p_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -19,6 +19,7 @@
 #include "common/type_helpers.hpp"
 #include "common/utils.hpp"
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/dst_stats_utils.hpp"
 #include "cpu/scale_utils.hpp"
 
 #include "cpu/x64/injectors/jit_uni_binary_injector.hpp"
@@ -57,6 +58,7 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::pd_t::init(
     auto skip_mask = skip_mask_t::post_ops | skip_mask_t::sum_dt
             | skip_mask_t::zero_points_runtime;
     if (is_int8) skip_mask |= skip_mask_t::scales_runtime;
+    if (!use_inversion) skip_mask |= skip_mask_t::dst_stats;
 
     bool ok = is_fwd() && set_default_alg_kind(alg_kind::convolution_direct)
             && IMPLICATION(is_int8,
@@ -306,6 +308,8 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::pd_t::init(
     if (jcp_.with_scales)
         book_precomputed_scales(
                 scratchpad, attr()->scales_, jcp_.ngroups * jcp_.oc);
+    if (attr()->dst_stats_)
+        book_dst_stats(scratchpad, jcp_.oc_without_padding, jcp_.nthr);
 
     return status::success;
 }
@@ -935,6 +939,10 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::execute(
             ? scratchpad.template get<char>(key_conv_amx_tile_buffer)
             : nullptr;
 
+    const bool with_dst_stats = _pd->attr()->dst_stats_;
+    if (with_dst_stats)
+        init_dst_stats(scratchpad, jcp.oc_without_padding, jcp.nthr);
+
     // --------------- Parallel section ------------------------------
     const dim_t work_amount = static_cast<dim_t>(jcp.mb) * jcp.ngroups
             * jcp.nb_oc * jcp.nb_od * jcp.nb_oh * jcp.nb_ow;
@@ -969,6 +977,10 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::execute(
         char *const wsp_tile = is_amx
                 ? wsp_tile_global + ithr * jcp.amx_buf_size_per_thread
                 : nullptr;
+        double *const dst_stats = with_dst_stats
+                ? get_dst_stats_partials(
+                        scratchpad, jcp.oc_without_padding, ithr)
+                : nullptr;
         dim_t start {0}, end {0};
         balance211(work_amount, nthr, ithr, start, end);
         int n {0}, g {0}, ocb {0}, odb {0}, ohb {0}, owb {0};
@@ -1044,6 +1056,11 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::execute(
                     last_owb = owb;
                 }
             }
+            // The dst block is final once all ic chunks are processed, so the
+            // statistics are accumulated while it is still in cache.
+            if (with_dst_stats)
+                accumulate_dst_stats_block(
+                        dst_stats, brgemm_ctx.dst, n, g, ocb, odb, ohb, owb);
             if (jcp.loop_order == loop_ndhwgc)
                 nd_iterator_step(n, jcp.mb, odb, jcp.nb_od, ohb, jcp.nb_oh, owb,
                         jcp.nb_ow, g, jcp.ngroups, ocb, jcp.nb_oc);
@@ -1056,11 +1073,43 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::execute(
         if (is_amx) { amx_tile_release(); }
     });
 
+    if (with_dst_stats) {
+        auto stats = CTX_OUT_MEM(float *, DNNL_ARG_ATTR_DST_STATS);
+        reduce_dst_stats(stats, scratchpad, jcp.oc_without_padding, jcp.nthr);
+    }
+
     if (_pd->wants_zero_pad_dst()) ctx.memory(DNNL_ARG_DST)->zero_pad(ctx);
 
     return status::success;
 }
 
+template <cpu_isa_t isa, bool use_inversion>
+void brgemm_convolution_fwd_t<isa, use_inversion>::accumulate_dst_stats_block(
+        double *dst_stats, const char *dst, int n, int g, int ocb, int odb,
+        int ohb, int owb) const {
+    const auto &jcp = pd()->jcp_;
+
+    const int oc_s = ocb * jcp.oc_block;
+    const int oc_len = nstl::min(jcp.oc_block, jcp.oc - oc_s);
+    const int g_oc = g * jcp.oc + oc_s;
+
+    const int od_s = odb * jcp.od_block;
+    const int od_e = nstl::min(OD, od_s + jcp.od_block);
+    const int oh_s = ohb * jcp.oh_block;
+    const int oh_e = nstl::min(OH, oh_s + jcp.oh_block);
+    const int ow_s = owb * jcp.ow_block;
+    const int ow_e = nstl::min(OW, ow_s + jcp.ow_block);
+
+    for_(int od = od_s; od < od_e; od++)
+    for_(int oh = oh_s; oh < oh_e; oh++)
+    for (int ow = ow_s; ow < ow_e; ow++) {
+        const dim_t off = n * dst_d_sz + od * dst_h_sz + oh * dst_w_sz
+                + ow * jcp.oc_without_padding + g_oc;
+        accumulate_dst_stats(dst_stats, jcp.oc_without_padding, jcp.dst_dt,
+                dst + dst_dsz * off, g_oc, oc_len);
+    }
+}
+
 template <cpu_isa_t isa, bool use_inversion>
 status_t brgemm_convolution_fwd_t<isa, use_inversion>::cal_compensation(
         const char *__restrict weights, int32_t *src_zp_buffer,
@@ -208,6 +208,9 @@ private:
     void add_po_kernels(int i_N, int init_bcast_dim, int po_bcast_dim);
     status_t add_brg_kernel(int bs, int M, int i_N, int i_K, int i_init);
 
+    void accumulate_dst_stats_block(double *dst_stats, const char *dst, int n,
+            int g, int ocb, int odb, int ohb, int owb) const;
+
     status_t cal_compensation(const char *__restrict weights,
             int32_t *src_zp_buffer, int32_t *s8s8_comp_buffer) const;
     int get_comp_ker_idx(const int kd_b, const int kd_e, const int kh_b,
@@ -17,8 +17,10 @@
 #include <assert.h>
 #include <functional>
 
+#include "common/bfloat16.hpp"
 #include "common/c_types_map.hpp"
 #include "common/dnnl_thread.hpp"
+#include "common/float16.hpp"
 #include "common/math_utils.hpp"
 #include "common/memory_tracking.hpp"
 #include "common/nstl.hpp"
@@ -154,8 +156,8 @@ struct jit_bnorm_conf_t {
                 N_nthr = (int)nstl::min<dim_t>(N, nthr / C_nthr);
                 // heuristic for training on avx512_core_amx
                 // TODO: test heuristic when global stats flag is set
-                if (!pd_->use_global_stats() && 0 < dt_size_ && 0 < simd_w_
-                        && 1 < C_nthr && nthr <= N
+                if (!pd_->stats_are_precomputed() && 0 < dt_size_
+                        && 0 < simd_w_ && 1 < C_nthr && nthr <= N
                         && mayiuse(avx512_core_amx)) {
                     const size_t data_size
                             = dt_size_ * N * SP * C_blks * simd_w_;
@@ -1565,7 +1567,7 @@ struct jit_bnorm_t : public jit_generator {
                     else
                         assert(false);
                 }
-                if (!pd_->use_global_stats()) {
+                if (!pd_->stats_are_precomputed()) {
                     uni_vsubps(v, v, vdiff_beta);
                     uni_vmovups_spat_data(
                             t, vmmword[reg_src + reg_soff + offt]);
@@ -1624,7 +1626,7 @@ struct jit_bnorm_t : public jit_generator {
             const int num_spat_pts = 1;
 
             // pre-compute scale for each channel to avoid costly div and sqrt
-            if (!pd_->use_global_stats()) {
+            if (!pd_->stats_are_precomputed()) {
                 mov(ptr[rsp + stack_off_ws_off_copy], reg_ws);
                 mov(reg_ws, ptr[rsp + stack_off_diff_scale]);
             }
@@ -1635,7 +1637,7 @@ struct jit_bnorm_t : public jit_generator {
                 uni_vaddps(vsqrtvar_ch, vsqrtvar_ch, veps);
                 uni_vsqrtps(vsqrtvar_ch, vsqrtvar_ch);
                 uni_vdivps(vsqrtvar_ch, vone, vsqrtvar_ch, vtmp);
-                if (!pd_->use_global_stats()) {
+                if (!pd_->stats_are_precomputed()) {
                     const Vmm vdiff_beta_ch = Vmm(idx + num_ch_blks);
                     const Vmm vdiff_gamma_ch = Vmm(idx + 2 * num_ch_blks);
                     uni_vmovups_maybe_tail(vdiff_beta_ch,
@@ -1647,7 +1649,7 @@ struct jit_bnorm_t : public jit_generator {
                     uni_vdivps(vdiff_gamma_ch, vdiff_gamma_ch, vchan_size);
                 }
             }
-            if (!pd_->use_global_stats()) {
+            if (!pd_->stats_are_precomputed()) {
                 mov(reg_ws, ptr[rsp + stack_off_ws_off_copy]);
             }
 
@@ -1676,7 +1678,7 @@ struct jit_bnorm_t : public jit_generator {
                             assert(false);
                     }
 
-                    if (!pd_->use_global_stats()) {
+                    if (!pd_->stats_are_precomputed()) {
                         const Vmm vdiff_beta_ch = Vmm(idx + num_ch_blks);
                         const Vmm vdiff_gamma_ch = Vmm(idx + 2 * num_ch_blks);
                         uni_vsubps(vdiff_data, vdiff_data, vdiff_beta_ch);
@@ -1736,7 +1738,7 @@ struct jit_bnorm_t : public jit_generator {
                 backward_diff_channels_nspc_compute(ch_blk_size);
 
                 add(reg_diff_dst, vlen_spat_data_ * ch_blk_size);
-                if (!pd_->use_global_stats())
+                if (!pd_->stats_are_precomputed())
                     add(reg_src, vlen_spat_data_ * ch_blk_size);
                 add(reg_diff_src, vlen_spat_data_ * ch_blk_size);
 
@@ -1757,7 +1759,7 @@ struct jit_bnorm_t : public jit_generator {
 
         if (is_xf16()) shr(reg_coff_max, 1);
         sub(reg_diff_dst, reg_coff_max);
-        if (!pd_->use_global_stats()) sub(reg_src, reg_coff_max);
+        if (!pd_->stats_are_precomputed()) sub(reg_src, reg_coff_max);
         sub(reg_diff_src, reg_coff_max);
         if (is_xf16()) shl(reg_coff_max, 1);
 
@@ -1896,7 +1898,7 @@ struct jit_bnorm_t : public jit_generator {
             // Process next image
             if (jbp_->is_nspc_) {
                 // Can use static offset since we comeback after spatial loop
-                if (!pd_->use_global_stats()) add(reg_src, mb_offt);
+                if (!pd_->stats_are_precomputed()) add(reg_src, mb_offt);
                 add(reg_diff_dst, mb_offt);
                 add(reg_diff_src, mb_offt);
                 add(reg_soff, mb_offt);
@@ -1912,7 +1914,7 @@ struct jit_bnorm_t : public jit_generator {
         }
         if (jbp_->is_nspc_) {
             // comeback
-            if (!pd_->use_global_stats())
+            if (!pd_->stats_are_precomputed())
                 mov(reg_src, ptr[rsp + stack_off_src]);
             mov(reg_diff_dst, ptr[rsp + stack_off_diff_dst]);
             mov(reg_diff_src, ptr[rsp + stack_off_diff_src]);
@@ -1959,7 +1961,10 @@ struct jit_bnorm_t : public jit_generator {
         load_common_params();
 
         if (pd_->is_fwd()) {
-            if (!pd_->stats_is_src()) { compute_mean_variance(); }
+            // Welford statistics are computed by the driver in advance.
+            if (!pd_->stats_are_precomputed() && !pd_->use_welford_stats()) {
+                compute_mean_variance();
+            }
             forward();
         } else {
             backward();
@@ -1995,6 +2000,13 @@ struct driver_t : public c_compatible {
         scratchpad.book<acc_data_t>(key_bnorm_tmp_diff_ss, pbuf_sz);
         scratchpad.book<acc_data_t>(key_bnorm_reduction, rbuf_sz);
 
+        if (pd->use_welford_stats()) {
+            // Partial mean and M2 per thread followed by per socket group.
+            const auto wbuf_sz
+                    = (nthr + welford_ngroups(nthr)) * 2 * C_PADDED;
+            scratchpad.book<acc_data_t>(key_bnorm_welford, wbuf_sz);
+        }
+
         if (dnnl_thr_syncable()) {
             auto n_barriers = C_PADDED / simd_w;
             scratchpad.book<barrier::ctx_64_t>(key_barrier, n_barriers);
@@ -2146,6 +2158,110 @@ struct driver_t : public c_compatible {
         }
     }
 
+    // Derives mean and variance from precomputed sums before the kernel
+    // normalizes the data. The statistics go to the user buffers on training
+    // and to the temporary ones on inference, same as the computed ones.
+    void init_stats_from_sums(const float *sums, acc_data_t *mean,
+            acc_data_t *var, const memory_tracking::grantor_t &scratchpad) {
+        if (use_tmp_stats(pd_)) {
+            auto sbuf = scratchpad.get<acc_data_t>(key_bnorm_tmp_stats);
+            mean = sbuf;
+            var = sbuf + get_c_padded(pd_);
+        }
+        bnorm_utils::stats_from_sums(pd_, sums, mean, var);
+    }
+
+    // Computes mean and variance in one pass over src with Welford's
+    // algorithm. Each thread accumulates a contiguous range of N * SP rows,
+    // partial results are merged with Chan's formula first within groups of
+    // threads sharing a socket and then across the groups, so that only
+    // ngroups partials per channel cross the socket boundary. The statistics
+    // go to the same buffers as in init_stats_from_sums().
+    //
+    // The rows are split by the number of threads the runtime provides,
+    // which is lower than nthr inside an outer parallel region.
+    void compute_welford_stats(const void *src, acc_data_t *mean,
+            acc_data_t *var, const memory_tracking::grantor_t &scratchpad,
+            int nthr) {
+        if (use_tmp_stats(pd_)) {
+            auto sbuf = scratchpad.get<acc_data_t>(key_bnorm_tmp_stats);
+            mean = sbuf;
+            var = sbuf + get_c_padded(pd_);
+        }
+        auto wbuf = scratchpad.get<acc_data_t>(key_bnorm_welford);
+
+        const dim_t C = pd_->C();
+        const dim_t C_PADDED = get_c_padded(pd_);
+        const dim_t rows = pd_->MB() * pd_->D() * pd_->H() * pd_->W();
+        const auto dt = pd_->src_md()->data_type;
+
+        // The number of partials, set by the runtime thread count
+        int nparts = nthr;
+        parallel(nthr, [&](const int ithr, const int nthr_rt) {
+            if (ithr == 0) nparts = nthr_rt;
+            dim_t r_s {0}, r_e {0};
+            balance211(rows, nthr_rt, ithr, r_s, r_e);
+            acc_data_t *t_mean = wbuf + ithr * 2 * C_PADDED;
+            acc_data_t *t_m2 = t_mean + C_PADDED;
+            if (dt == data_type::bf16)
+                welford_partial(static_cast<const bfloat16_t *>(src), r_s,
+                        r_e, t_mean, t_m2);
+            else if (dt == data_type::f16)
+                welford_partial(static_cast<const float16_t *>(src), r_s,
+                        r_e, t_mean, t_m2);
+            else
+                welford_partial(static_cast<const float *>(src), r_s, r_e,
+                        t_mean, t_m2);
+        });
+
+        const int grp_size = welford_group_size(nparts);
+        const int ngroups = welford_ngroups(nparts);
+
+        // Rows processed by a thread, the count of its partial statistics.
+        auto thr_rows = [&](int ithr) {
+            dim_t r_s {0}, r_e {0};
+            balance211(rows, nparts, ithr, r_s, r_e);
+            return r_e - r_s;
+        };
+
+        // Merge the partials of each group, the channels being split in
+        // blocks of simd_w.
+        const dim_t nblks = utils::div_up(C_PADDED, simd_w);
+        parallel_nd(ngroups, nblks, [&](dim_t grp, dim_t blk) {
+            const int thr_s = (int)grp * grp_size;
+            const int thr_e = nstl::min(nparts, thr_s + grp_size);
+            const dim_t c_s = blk * simd_w;
+            const dim_t c_e = nstl::min(C_PADDED, c_s + simd_w);
+
+            acc_data_t *g_mean = wbuf + (nparts + grp) * 2 * C_PADDED;
+            acc_data_t *g_m2 = g_mean + C_PADDED;
+            dim_t g_cnt = 0;
+            for (int t = thr_s; t < thr_e; ++t) {
+                const acc_data_t *t_mean = wbuf + t * 2 * C_PADDED;
+                chan_merge(g_cnt, g_mean, g_m2, thr_rows(t), t_mean,
+                        t_mean + C_PADDED, c_s, c_e);
+            }
+        });
+
+        parallel_nd(C, [&](dim_t c) {
+            dim_t cnt = 0;
+            acc_data_t m = 0, m2 = 0;
+            for (int grp = 0; grp < ngroups; ++grp) {
+                const int thr_s = grp * grp_size;
+                const int thr_e = nstl::min(nparts, thr_s + grp_size);
+                dim_t g_cnt = 0;
+                for (int t = thr_s; t < thr_e; ++t)
+                    g_cnt += thr_rows(t);
+                const acc_data_t *g_mean
+                        = wbuf + (nparts + grp) * 2 * C_PADDED;
+                chan_merge(cnt, &m, &m2, g_cnt, g_mean + c,
+                        g_mean + C_PADDED + c, 0, 1);
+            }
+            mean[c] = m;
+            var[c] = cnt > 0 ? m2 / cnt : 0.f;
+        });
+    }
+
     void init_barriers(const memory_tracking::grantor_t &scratchpad) {
         auto barriers = scratchpad.get<barrier::ctx_64_t>(key_barrier);
         if (barriers) {
@@ -2164,6 +2280,86 @@ private:
                         / sizeof(acc_data_t) // BF16 will expand to FP32
     };
 
+    // Threads are grouped by the number of cores per socket assuming the
+    // usual compact thread affinity.
+    static int welford_group_size(int nthr) {
+        const int ncores = (int)platform::get_num_cores();
+        return nstl::max(1, ncores > 0 ? nstl::min(nthr, ncores) : nthr);
+    }
+
+    static int welford_ngroups(int nthr) {
+        return (int)utils::div_up(nthr, welford_group_size(nthr));
+    }
+
+    // Accumulates Welford mean and M2 of rows [r_s, r_e) for every channel.
+    template <typename data_t>
+    void welford_partial(const data_t *src, dim_t r_s, dim_t r_e,
+            acc_data_t *mean, acc_data_t *m2) const {
+        const dim_t C_PADDED = get_c_padded(pd_);
+        const dim_t SP = pd_->D() * pd_->H() * pd_->W();
+        const dim_t C_blks = C_PADDED / simd_w;
+
+        for (dim_t c = 0; c < C_PADDED; ++c)
+            mean[c] = m2[c] = 0;
+
+        if (jbp_.is_nspc_) {
+            for (dim_t r = r_s; r < r_e; ++r) {
+                const acc_data_t rcp_cnt = 1.f / (r - r_s + 1);
+                const data_t *s = src + r * C_PADDED;
+                PRAGMA_OMP_SIMD()
+                for (dim_t c = 0; c < C_PADDED; ++c) {
+                    const acc_data_t v = s[c];
+                    const acc_data_t delta = v - mean[c];
+                    mean[c] += delta * rcp_cnt;
+                    m2[c] += delta * (v - mean[c]);
+                }
+            }
+            return;
+        }
+
+        for_(dim_t cb = 0; cb < C_blks; ++cb)
+        for (dim_t r = r_s; r < r_e; ++r) {
+            const acc_data_t rcp_cnt = 1.f / (r - r_s + 1);
+            const dim_t n = r / SP, sp = r % SP;
+            const data_t *s = src + ((n * C_blks + cb) * SP + sp) * simd_w;
+            acc_data_t *b_mean = mean + cb * simd_w;
+            acc_data_t *b_m2 = m2 + cb * simd_w;
+            PRAGMA_OMP_SIMD()
+            for (int c = 0; c < simd_w; ++c) {
+                const acc_data_t v = s[c];
+                const acc_data_t delta = v - b_mean[c];
+                b_mean[c] += delta * rcp_cnt;
+                b_m2[c] += delta * (v - b_mean[c]);
+            }
+        }
+    }
+
+    // Merges statistics (cnt_b, mean_b, m2_b) into (cnt_a, mean_a, m2_a)
+    // for channels [c_s, c_e) with Chan's pairwise formula.
+    static void chan_merge(dim_t &cnt_a, acc_data_t *mean_a, acc_data_t *m2_a,
+            dim_t cnt_b, const acc_data_t *mean_b, const acc_data_t *m2_b,
+            dim_t c_s, dim_t c_e) {
+        if (cnt_b == 0) return;
+        if (cnt_a == 0) {
+            for (dim_t c = c_s; c < c_e; ++c) {
+                mean_a[c] = mean_b[c];
+                m2_a[c] = m2_b[c];
+            }
+            cnt_a = cnt_b;
+            return;
+        }
+        const dim_t cnt = cnt_a + cnt_b;
+        const acc_data_t w_b = (acc_data_t)cnt_b / cnt;
+        const acc_data_t w_ab = (acc_data_t)cnt_a * w_b;
+        PRAGMA_OMP_SIMD()
+        for (dim_t c = c_s; c < c_e; ++c) {
+            const acc_data_t delta = mean_b[c] - mean_a[c];
+            mean_a[c] += delta * w_b;
+            m2_a[c] += m2_b[c] + delta * delta * w_ab;
+        }
+        cnt_a = cnt;
+    }
+
     static bool use_tmp_stats(const batch_normalization_pd_t *pd) {
         return !pd->stats_is_src()
                 && pd->desc()->prop_kind == prop_kind::forward_inference;
@@ -2282,8 +2478,16 @@ status_t jit_uni_batch_normalization_fwd_t<isa>::execute(
 
     auto scratchpad = ctx.get_scratchpad_grantor();
 
-    bnorm_driver_->init_barriers(scratchpad);
+    if (pd()->use_precomputed_sums()) {
+        auto sums = CTX_IN_MEM(const float *, DNNL_ARG_ATTR_DST_STATS);
+        bnorm_driver_->init_stats_from_sums(sums, mean, var, scratchpad);
+    }
+
     const int nthr = pd()->nthr_;
+    if (pd()->use_welford_stats())
+        bnorm_driver_->compute_welford_stats(src, mean, var, scratchpad, nthr);
+
+    bnorm_driver_->init_barriers(scratchpad);
 
     parallel(nthr, [&](const int ithr, const int nthr) {
         bnorm_driver_->exec(ithr, nthr, src, nullptr, dst, nullptr, scale,
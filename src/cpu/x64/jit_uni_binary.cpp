@@ -111,7 +111,7 @@ status_t jit_uni_binary_t::pd_t::init(engine_t *engine) {
     conf_.isa = get_supported_isa();
 
     bool ok = data_type_supported(conf_.dst_type)
-            && data_type_supported(conf_.src0_type)
+            && !is_ternary_op() && data_type_supported(conf_.src0_type)
             && data_type_supported(conf_.src1_type)
             && data_format_supported(src0_md_, conf_.isa)
             && IMPLICATION(conf_.src0_type == bf16, mayiuse(avx512_core))
@@ -0,0 +1,398 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <assert.h>
+#include <atomic>
+#include <float.h>
+#include <string.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_uni_embedding_bag.hpp"
+#include "cpu/x64/utils/jit_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace data_type;
+using namespace alg_kind;
+using namespace Xbyak;
+
+template <cpu_isa_t isa>
+struct jit_embedding_bag_kernel_t : public embedding_bag_kernel_t,
+                                    public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_embedding_bag_kernel_t);
+
+    jit_embedding_bag_kernel_t(const embedding_bag_pd_t *pd)
+        : embedding_bag_kernel_t(pd)
+        , jit_generator(jit_name())
+        , src_d_(pd_->src_md())
+        , dst_d_(pd_->dst_md())
+        , alg_(pd_->desc()->alg_kind)
+        , simd_w_(vlen / sizeof(float))
+        , nvec_(utils::div_up(pd_->D(), simd_w_))
+        , simd_tail_(pd_->D() % simd_w_)
+        , row_bytes_(src_d_.blocking_desc().strides[0]
+                  * src_d_.data_type_size())
+        , with_weights_(pd_->with_weights())
+        , with_scales_(!pd_->attr()->scales_.get(DNNL_ARG_SRC)
+                                .has_default_values())
+        , per_row_scales_(with_scales_ && pd_->src_scales_mask() == 1)
+        // Max pooling does not commute with a negative common scale, so it
+        // is applied to every row as the per-row scales are.
+        , common_scale_in_loop_(
+                  with_scales_ && !per_row_scales_ && alg_ == embedding_bag_max)
+        , use_multiplier_(
+                  with_weights_ || per_row_scales_ || common_scale_in_loop_) {
+        io::io_conf_t io_conf;
+        io::io_tail_conf_t io_tail_conf(simd_w_, simd_tail_, tail_opmask_idx,
+                vmm_tail_mask.getIdx(), reg_tmp);
+        io::io_emu_bf16_conf_t io_bf16_conf(bf16_emu_zmm_1_idx,
+                bf16_emu_zmm_2_idx, bf16_emu_zmm_3_idx, reg_tmp,
+                bf16_emu_zmm_4_idx);
+        io_ = io::jit_io_multi_dt_helper_t<Vmm>(this, isa,
+                {src_d_.data_type(), dst_d_.data_type()}, io_conf,
+                io_tail_conf, io_bf16_conf);
+    }
+
+    void operator()(const call_params_t *p) const override {
+        jit_generator::operator()(p);
+    }
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    static constexpr int vlen = cpu_isa_traits<isa>::vlen;
+    // Accumulators of a block of the row stay in registers while all the
+    // indices of the bag are traversed.
+    static constexpr int max_acc_ = isa == avx512_core ? 16 : 8;
+    // Number of indices ahead of the current one whose rows are prefetched.
+    // Rows are picked at random from a table that usually does not fit the
+    // caches, so hardware prefetchers cannot predict them.
+    static constexpr int prefetch_distance_ = 8;
+    static constexpr int cache_line_ = 64;
+
+    io::jit_io_multi_dt_helper_t<Vmm> io_;
+    const memory_desc_wrapper src_d_, dst_d_;
+    const alg_kind_t alg_;
+    const dim_t simd_w_;
+    const dim_t nvec_;
+    const dim_t simd_tail_;
+    const dim_t row_bytes_;
+    const bool with_weights_;
+    const bool with_scales_;
+    const bool per_row_scales_;
+    const bool common_scale_in_loop_;
+    const bool use_multiplier_;
+
+    const Reg64 reg_param = abi_param1;
+    const Reg64 reg_src = r8;
+    const Reg64 reg_indices = r9;
+    const Reg64 reg_weights = r10;
+    const Reg64 reg_scales = r11;
+    const Reg64 reg_dst = r12;
+    const Reg64 reg_n = r13;
+    const Reg64 reg_cnt = r14;
+    const Reg64 reg_idx_ptr = r15;
+    const Reg64 reg_w_ptr = rax;
+    const Reg64 reg_idx = rbx;
+    const Reg64 reg_row = rdx;
+    const Reg64 reg_pf = rsi;
+    const Reg64 reg_tmp = rbp;
+
+    const Vmm vmm_tail_mask = Vmm(0);
+    // Accumulators use Vmm(1)...Vmm(max_acc_).
+    const Vmm vmm_data = Vmm(max_acc_ + 1);
+    const Vmm vmm_mult = Vmm(max_acc_ + 2);
+    const Vmm vmm_tmp = Vmm(max_acc_ + 3);
+    const Vmm vmm_dst_scale = Vmm(max_acc_ + 4);
+
+    const int bf16_emu_zmm_1_idx = 28;
+    const int bf16_emu_zmm_2_idx = 29;
+    const int bf16_emu_zmm_3_idx = 30;
+    const int bf16_emu_zmm_4_idx = 31;
+    const int tail_opmask_idx = 2;
+
+    Vmm vmm_acc(int i) const { return Vmm(1 + i); }
+
+    bool apply_dst_scale() const {
+        return alg_ == embedding_bag_mean
+                || (with_scales_ && !per_row_scales_
+                        && !common_scale_in_loop_);
+    }
+
+    void accumulate(const Vmm &acc) {
+        if (alg_ == embedding_bag_max) {
+            if (use_multiplier_) uni_vmulps(vmm_data, vmm_data, vmm_mult);
+            uni_vmaxps(acc, acc, vmm_data);
+        } else if (use_multiplier_) {
+            uni_vfmadd231ps(acc, vmm_data, vmm_mult);
+        } else {
+            uni_vaddps(acc, acc, vmm_data);
+        }
+    }
+
+    void prefetch_rows(dim_t vec_beg, int nvec) {
+        Label skip;
+        cmp(reg_cnt, prefetch_distance_);
+        jle(skip, T_NEAR);
+        movsxd(reg_pf,
+                dword[reg_idx_ptr + prefetch_distance_ * sizeof(int32_t)]);
+        imul(reg_pf, reg_pf, static_cast<int>(row_bytes_));
+        add(reg_pf, reg_src);
+        const dim_t beg = vec_beg * simd_w_ * src_d_.data_type_size();
+        const dim_t end = nstl::min(pd_->D(), (vec_beg + nvec) * simd_w_)
+                * src_d_.data_type_size();
+        for (dim_t off = beg; off < end; off += cache_line_)
+            prefetcht0(ptr[reg_pf + off]);
+        L(skip);
+    }
+
+    void load_multiplier() {
+        if (with_weights_) uni_vbroadcastss(vmm_mult, ptr[reg_w_ptr]);
+        if (!per_row_scales_) return;
+        const auto scale = ptr[reg_scales + reg_idx * sizeof(float)];
+        if (with_weights_) {
+            uni_vbroadcastss(vmm_tmp, scale);
+            uni_vmulps(vmm_mult, vmm_mult, vmm_tmp);
+        } else {
+            uni_vbroadcastss(vmm_mult, scale);
+        }
+    }
+
+    // Pools the vectors [vec_beg, vec_beg + nvec) of the rows.
+    void pool_block(dim_t vec_beg, int nvec) {
+        const auto src_dt = src_d_.data_type();
+        const auto dst_dt = dst_d_.data_type();
+        auto is_tail = [&](int v) {
+            return simd_tail_ > 0 && vec_beg + v == nvec_ - 1;
+        };
+
+        if (alg_ == embedding_bag_max) {
+            init_vmm(vmm_acc(0), reg_tmp, -FLT_MAX);
+            for (int v = 1; v < nvec; v++)
+                uni_vmovups(vmm_acc(v), vmm_acc(0));
+        } else {
+            for (int v = 0; v < nvec; v++)
+                uni_vpxor(vmm_acc(v), vmm_acc(v), vmm_acc(v));
+        }
+
+        mov(reg_idx_ptr, reg_indices);
+        if (with_weights_) mov(reg_w_ptr, reg_weights);
+        mov(reg_cnt, reg_n);
+
+        Label loop;
+        L(loop);
+        {
+            prefetch_rows(vec_beg, nvec);
+
+            movsxd(reg_idx, dword[reg_idx_ptr]);
+            if (use_multiplier_ && !common_scale_in_loop_) load_multiplier();
+            mov(reg_row, reg_idx);
+            imul(reg_row, reg_row, static_cast<int>(row_bytes_));
+            add(reg_row, reg_src);
+
+            for (int v = 0; v < nvec; v++) {
+                const dim_t off = (vec_beg + v) * simd_w_
+                        * src_d_.data_type_size();
+                io_[src_dt]->load(ptr[reg_row + off], vmm_data, is_tail(v));
+                accumulate(vmm_acc(v));
+            }
+
+            add(reg_idx_ptr, sizeof(int32_t));
+            if (with_weights_) add(reg_w_ptr, sizeof(float));
+            dec(reg_cnt);
+            jnz(loop, T_NEAR);
+        }
+
+        for (int v = 0; v < nvec; v++) {
+            if (apply_dst_scale())
+                uni_vmulps(vmm_acc(v), vmm_acc(v), vmm_dst_scale);
+            const dim_t off
+                    = (vec_beg + v) * simd_w_ * dst_d_.data_type_size();
+            io_[dst_dt]->store(vmm_acc(v), ptr[reg_dst + off], is_tail(v));
+        }
+    }
+
+    void generate() override {
+        preamble();
+
+        io_.init_bf16();
+        if (simd_tail_) io_.prepare_tail_mask();
+
+#define PARAM_OFF(x) offsetof(call_params_t, x)
+        mov(reg_src, ptr[reg_param + PARAM_OFF(src)]);
+        mov(reg_indices, ptr[reg_param + PARAM_OFF(indices)]);
+        if (with_weights_)
+            mov(reg_weights, ptr[reg_param + PARAM_OFF(weights)]);
+        if (with_scales_) mov(reg_scales, ptr[reg_param + PARAM_OFF(scales)]);
+        mov(reg_dst, ptr[reg_param + PARAM_OFF(dst)]);
+        mov(reg_n, ptr[reg_param + PARAM_OFF(nindices)]);
+        if (apply_dst_scale())
+            uni_vbroadcastss(
+                    vmm_dst_scale, ptr[reg_param + PARAM_OFF(dst_scale)]);
+#undef PARAM_OFF
+
+        if (common_scale_in_loop_) uni_vbroadcastss(vmm_mult, ptr[reg_scales]);
+
+        // Long rows are pooled in blocks that fit the accumulator registers,
+        // the indices of the bag are traversed once per block.
+        for (dim_t vec_beg = 0; vec_beg < nvec_; vec_beg += max_acc_) {
+            const dim_t nvec = nstl::min<dim_t>(max_acc_, nvec_ - vec_beg);
+            pool_block(vec_beg, static_cast<int>(nvec));
+        }
+
+        postamble();
+    }
+};
+
+embedding_bag_kernel_t *embedding_bag_kernel_t::create(
+        const embedding_bag_pd_t *pd, cpu_isa_t isa) {
+    if (isa == avx512_core)
+        return new jit_embedding_bag_kernel_t<avx512_core>(pd);
+    if (isa == avx2) return new jit_embedding_bag_kernel_t<avx2>(pd);
+    assert(!"kernel is empty.");
+    return nullptr;
+}
+
+status_t jit_uni_embedding_bag_t::pd_t::init(engine_t *engine) {
+    using namespace format_tag;
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    if (mayiuse(avx512_core))
+        isa_ = avx512_core;
+    else if (mayiuse(avx2))
+        isa_ = avx2;
+    else
+        return status::unimplemented;
+
+    const auto src_dt = src_md()->data_type;
+    const auto dst_dt = dst_md()->data_type;
+    bool ok = !has_zero_dim_memory() && utils::one_of(src_dt, f32, bf16, s8)
+            && utils::one_of(dst_dt, f32, bf16)
+            && IMPLICATION(utils::one_of(bf16, src_dt, dst_dt),
+                    isa_ == avx512_core)
+            && set_default_params() == status::success
+            && attr()->has_default_values(skip_mask_t::scales_runtime)
+            && attr_scales_ok();
+    if (!ok) return status::unimplemented;
+
+    // Rows of the table are addressed with 32-bit displacements.
+    const memory_desc_wrapper src_d(src_md());
+    ok = src_d.matches_tag(ab)
+            && src_d.blocking_desc().strides[0] * src_d.data_type_size()
+                    <= INT32_MAX
+            && memory_desc_wrapper(dst_md()).matches_tag(ab)
+            && memory_desc_wrapper(indices_md()).matches_tag(a)
+            && memory_desc_wrapper(offsets_md()).matches_tag(a)
+            && IMPLICATION(with_weights(),
+                    memory_desc_wrapper(weights_md()).matches_tag(a));
+    if (!ok) return status::unimplemented;
+
+    return status::success;
+}
+
+status_t jit_uni_embedding_bag_t::init(engine_t *engine) {
+    CHECK(safe_ptr_assign(
+            kernel_, embedding_bag_kernel_t::create(pd(), pd()->isa_)));
+    return kernel_->create_kernel();
+}
+
+status_t jit_uni_embedding_bag_t::execute_forward(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto indices = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_1);
+    auto offsets = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_2);
+    auto weights = CTX_IN_MEM(const float *, DNNL_ARG_WEIGHTS);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper indices_d(pd()->indices_md());
+    const memory_desc_wrapper offsets_d(pd()->offsets_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const size_t dst_dt_size = dst_d.data_type_size();
+    src += src_d.offset0() * src_d.data_type_size();
+    dst += dst_d.offset0() * dst_dt_size;
+    indices += indices_d.offset0();
+    offsets += offsets_d.offset0();
+    if (weights) weights += weights_d.offset0();
+
+    const dim_t R = pd()->R();
+    const dim_t D = pd()->D();
+    const dim_t NB = pd()->NB();
+    const alg_kind_t alg = pd()->desc()->alg_kind;
+    // A common scale of the table is folded into the final multiplier for
+    // all the pooling kinds but max.
+    const float common_scale
+            = pd()->src_scales_mask() == 0 && alg != embedding_bag_max
+            ? src_scales[0]
+            : 1.f;
+
+    // Bags are independent and are spread across threads. The indices of a
+    // bag are validated right before its rows are read, so the check costs
+    // a single pass over data that is about to be touched anyway.
+    std::atomic<bool> args_ok(true);
+    parallel_nd(NB, [&](dim_t b) {
+        dim_t beg = 0, end = 0;
+        bool ok = pd()->bag_range(offsets, b, beg, end);
+        for (dim_t i = beg; ok && i < end; i++)
+            ok = 0 <= indices[i] && indices[i] < R;
+        if (!ok) {
+            args_ok = false;
+            return;
+        }
+
+        char *dst_row = dst + b * D * dst_dt_size;
+        if (end == beg) {
+            // Empty bags produce zero rows, zero bits are zero in both f32
+            // and bf16.
+            memset(dst_row, 0, D * dst_dt_size);
+            return;
+        }
+
+        embedding_bag_kernel_t::call_params_t p;
+        p.src = src;
+        p.indices = indices + beg;
+        p.weights = weights ? weights + beg : nullptr;
+        p.scales = src_scales;
+        p.dst = dst_row;
+        p.nindices = end - beg;
+        p.dst_scale = alg == embedding_bag_mean
+                ? common_scale / (end - beg)
+                : common_scale;
+        (*kernel_)(&p);
+    });
+
+    return args_ok ? status::success : status::invalid_arguments;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,98 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#ifndef CPU_X64_JIT_UNI_EMBEDDING_BAG_HPP
+#define CPU_X64_JIT_UNI_EMBEDDING_BAG_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_embedding_bag_pd.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Pools the table rows referred to by the indices of a single bag into a row
+// of the destination.
+struct embedding_bag_kernel_t {
+    struct call_params_t {
+        const void *src; // table
+        const int32_t *indices; // first index of the bag
+        const float *weights; // first per-sample weight of the bag
+        const float *scales; // table scales
+        void *dst; // destination row
+        dim_t nindices; // number of indices in the bag, must be positive
+        float dst_scale; // multiplier applied to the pooled row
+    };
+
+    static embedding_bag_kernel_t *create(
+            const embedding_bag_pd_t *pd, cpu_isa_t isa);
+    virtual ~embedding_bag_kernel_t() = default;
+
+    virtual void operator()(const call_params_t *p) const {};
+
+    virtual status_t create_kernel() { return status::success; }
+
+protected:
+    embedding_bag_kernel_t(const embedding_bag_pd_t *pd) : pd_(pd) {}
+
+    const embedding_bag_pd_t *pd_;
+};
+
+struct jit_uni_embedding_bag_t : public primitive_t {
+    struct pd_t : public cpu_embedding_bag_pd_t {
+        using cpu_embedding_bag_pd_t::cpu_embedding_bag_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", isa_, ""),
+                jit_uni_embedding_bag_t);
+
+        status_t init(engine_t *engine);
+
+        cpu_isa_t isa_ = isa_undef;
+    };
+
+    jit_uni_embedding_bag_t(const pd_t *apd) : primitive_t(apd) {}
+    virtual ~jit_uni_embedding_bag_t() = default;
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return execute_forward(ctx);
+    }
+
+private:
+    status_t execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<embedding_bag_kernel_t> kernel_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,645 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/x64/injectors/jit_uni_eltwise_injector.hpp"
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_uni_group_normalization.hpp"
+#include "cpu/x64/utils/jit_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace memory_tracking::names;
+using namespace data_type;
+using namespace Xbyak;
+using namespace gnorm_layout;
+
+namespace {
+// Rows of the data tensor processed by a single call of the kernels.
+struct gnorm_rows_t {
+    dim_t nrows; // number of rows
+    dim_t len; // number of elements in a row
+    dim_t stride; // distance between rows in elements
+};
+
+// A group is a single contiguous row for channels-first layouts (the group
+// covers whole channel blocks in the blocked case) and a set of strided rows
+// for the channels-last layout.
+gnorm_rows_t group_rows(const group_normalization_pd_t *pd, layout_t layout) {
+    if (layout == nspc) return {pd->SP(), pd->C_per_G(), pd->C()};
+    return {1, pd->C_per_G() * pd->SP(), 0};
+}
+
+dim_t apply_row_len(
+        const group_normalization_pd_t *pd, layout_t layout, dim_t blk) {
+    switch (layout) {
+        case ncsp: return pd->SP();
+        case nspc: return pd->C();
+        case blocked: return pd->SP() * blk;
+    }
+    return 0;
+}
+} // namespace
+
+template <cpu_isa_t isa>
+struct jit_gnorm_stat_kernel_t : public gnorm_stat_kernel_t,
+                                 public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_gnorm_stat_kernel_t);
+
+    jit_gnorm_stat_kernel_t(const group_normalization_pd_t *pd,
+            layout_t layout, bool compute_var)
+        : gnorm_stat_kernel_t(pd)
+        , jit_generator(jit_name())
+        , src_d_(pd_->src_md())
+        , rows_(group_rows(pd, layout))
+        , simd_w_(vlen / sizeof(float))
+        , row_simd_full_(rows_.len / simd_w_)
+        , row_simd_tail_(rows_.len % simd_w_)
+        , compute_var_(compute_var) {
+        io::io_conf_t io_conf;
+        io::io_tail_conf_t io_tail_conf(simd_w_, row_simd_tail_,
+                tail_opmask_idx, vmm_tail_mask.getIdx(), reg_tmp);
+        io::io_emu_bf16_conf_t io_bf16_conf(bf16_emu_zmm_1_idx,
+                bf16_emu_zmm_2_idx, bf16_emu_zmm_3_idx, reg_tmp,
+                bf16_emu_zmm_4_idx);
+        io_ = io::jit_io_multi_dt_helper_t<Vmm>(this, isa,
+                {src_d_.data_type()}, io_conf, io_tail_conf, io_bf16_conf);
+    }
+
+    void operator()(
+            const void *src, const float *mean, float *res) const override {
+        ker_args_t args;
+        args.src = src;
+        args.mean = mean;
+        args.res = res;
+        jit_generator::operator()(&args);
+    }
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    static constexpr int vlen = cpu_isa_traits<isa>::vlen;
+    static constexpr int unroll_ = 4;
+
+    struct ker_args_t {
+        const void *src;
+        const float *mean;
+        float *res;
+    };
+
+    io::jit_io_multi_dt_helper_t<Vmm> io_;
+    const memory_desc_wrapper src_d_;
+    const gnorm_rows_t rows_;
+    const dim_t simd_w_;
+    const dim_t row_simd_full_;
+    const dim_t row_simd_tail_;
+    const bool compute_var_;
+
+    const Reg64 reg_param = abi_param1;
+    const Reg64 reg_src = r8;
+    const Reg64 reg_ptr = r9;
+    const Reg64 reg_cnt = r10;
+    const Reg64 reg_rows = r11;
+    const Reg64 reg_tmp = r12;
+    const Reg64 reg_res = r13;
+
+    const Vmm vmm_tail_mask = Vmm(0);
+    // Accumulators use Vmm(1)...Vmm(unroll_), loaded data the next unroll_
+    // registers.
+    const Vmm vmm_mean = Vmm(9);
+    const Vmm vmm_tmp = Vmm(10);
+
+    const int bf16_emu_zmm_1_idx = 28;
+    const int bf16_emu_zmm_2_idx = 29;
+    const int bf16_emu_zmm_3_idx = 30;
+    const int bf16_emu_zmm_4_idx = 31;
+    const int tail_opmask_idx = 2;
+
+    Vmm vmm_acc(int i) const { return Vmm(1 + i); }
+    Vmm vmm_src(int i) const { return Vmm(1 + unroll_ + i); }
+
+    Address src_ptr(dim_t offt_elems) {
+        return ptr[reg_ptr + offt_elems * src_d_.data_type_size()];
+    }
+
+    void accumulate(const Vmm &acc, const Vmm &src, bool tail) {
+        if (!compute_var_) {
+            uni_vaddps(acc, acc, src);
+            return;
+        }
+        // Lanes beyond the tail are loaded as zeros and have to stay zeros
+        // after the mean is subtracted.
+        if (!tail)
+            uni_vsubps(src, src, vmm_mean);
+        else if (is_superset(isa, avx512_core))
+            vsubps(src | Opmask(tail_opmask_idx) | T_z, src, vmm_mean);
+        else {
+            uni_vpxor(vmm_tmp, vmm_tmp, vmm_tmp);
+            uni_vblendvps(vmm_tmp, vmm_tmp, vmm_mean, vmm_tail_mask);
+            uni_vsubps(src, src, vmm_tmp);
+        }
+        uni_vfmadd231ps(acc, src, src);
+    }
+
+    void reduce_row() {
+        const dim_t n_unrolled = row_simd_full_ / unroll_;
+        if (n_unrolled > 0) {
+            Label loop;
+            mov(reg_cnt, n_unrolled);
+            L(loop);
+            {
+                for (int i = 0; i < unroll_; i++)
+                    io_[src_d_.data_type()]->load(
+                            src_ptr(i * simd_w_), vmm_src(i), false);
+                for (int i = 0; i < unroll_; i++)
+                    accumulate(vmm_acc(i), vmm_src(i), false);
+                add(reg_ptr, unroll_ * simd_w_ * src_d_.data_type_size());
+                dec(reg_cnt);
+                jnz(loop, T_NEAR);
+            }
+        }
+
+        const int n_rem = row_simd_full_ % unroll_;
+        for (int i = 0; i < n_rem; i++) {
+            io_[src_d_.data_type()]->load(
+                    src_ptr(i * simd_w_), vmm_src(i), false);
+            accumulate(vmm_acc(i), vmm_src(i), false);
+        }
+        if (row_simd_tail_ > 0) {
+            io_[src_d_.data_type()]->load(
+                    src_ptr(n_rem * simd_w_), vmm_src(0), true);
+            accumulate(vmm_acc(0), vmm_src(0), true);
+        }
+    }
+
+    void horizontal_add(const Vmm &v) {
+        const Ymm ymm_v(v.getIdx()), ymm_tmp(vmm_tmp.getIdx());
+        const Xmm xmm_v(v.getIdx()), xmm_tmp(vmm_tmp.getIdx());
+        if (is_superset(isa, avx512_core)) {
+            vextractf64x4(ymm_tmp, Zmm(v.getIdx()), 1);
+            vaddps(ymm_v, ymm_v, ymm_tmp);
+        }
+        vextractf128(xmm_tmp, ymm_v, 1);
+        vaddps(xmm_v, xmm_v, xmm_tmp);
+        vhaddps(xmm_v, xmm_v, xmm_v);
+        vhaddps(xmm_v, xmm_v, xmm_v);
+    }
+
+    void generate() override {
+        preamble();
+
+        io_.init_bf16();
+        if (row_simd_tail_) io_.prepare_tail_mask();
+
+#define PARAM_OFF(x) offsetof(ker_args_t, x)
+        mov(reg_src, ptr[reg_param + PARAM_OFF(src)]);
+        mov(reg_res, ptr[reg_param + PARAM_OFF(res)]);
+        if (compute_var_) {
+            mov(reg_tmp, ptr[reg_param + PARAM_OFF(mean)]);
+            uni_vbroadcastss(vmm_mean, ptr[reg_tmp]);
+        }
+#undef PARAM_OFF
+
+        for (int i = 0; i < unroll_; i++)
+            uni_vpxor(vmm_acc(i), vmm_acc(i), vmm_acc(i));
+
+        Label row_loop;
+        mov(reg_rows, rows_.nrows);
+        L(row_loop);
+        {
+            mov(reg_ptr, reg_src);
+            reduce_row();
+            add(reg_src, rows_.stride * src_d_.data_type_size());
+            dec(reg_rows);
+            jnz(row_loop, T_NEAR);
+        }
+
+        for (int i = 1; i < unroll_; i++)
+            uni_vaddps(vmm_acc(0), vmm_acc(0), vmm_acc(i));
+        horizontal_add(vmm_acc(0));
+        uni_vmovss(ptr[reg_res], Xmm(vmm_acc(0).getIdx()));
+
+        postamble();
+    }
+};
+
+gnorm_stat_kernel_t *gnorm_stat_kernel_t::create(
+        const group_normalization_pd_t *pd, cpu_isa_t isa, layout_t layout,
+        bool compute_var) {
+    if (isa == avx512_core)
+        return new jit_gnorm_stat_kernel_t<avx512_core>(
+                pd, layout, compute_var);
+    if (isa == avx2)
+        return new jit_gnorm_stat_kernel_t<avx2>(pd, layout, compute_var);
+    assert(!"kernel is empty.");
+    return nullptr;
+}
+
+template <cpu_isa_t isa>
+struct jit_gnorm_apply_kernel_t : public gnorm_apply_kernel_t,
+                                  public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_gnorm_apply_kernel_t);
+
+    jit_gnorm_apply_kernel_t(
+            const group_normalization_pd_t *pd, layout_t layout)
+        : gnorm_apply_kernel_t(pd)
+        , jit_generator(jit_name())
+        , src_d_(pd_->src_md())
+        , dst_d_(pd_->dst_md())
+        , layout_(layout)
+        , simd_w_(vlen / sizeof(float))
+        , len_(apply_row_len(pd, layout, simd_w_))
+        , simd_full_(len_ / simd_w_)
+        , simd_tail_(len_ % simd_w_) {
+        io::io_conf_t io_conf;
+        io::io_tail_conf_t io_tail_conf(simd_w_, simd_tail_, tail_opmask_idx,
+                vmm_tail_mask.getIdx(), reg_tmp);
+        io::io_emu_bf16_conf_t io_bf16_conf(bf16_emu_zmm_1_idx,
+                bf16_emu_zmm_2_idx, bf16_emu_zmm_3_idx, reg_tmp,
+                bf16_emu_zmm_4_idx);
+        io::io_saturation_conf_t io_saturation_conf(
+                vmm_zero.getIdx(), vmm_saturation_ubound.getIdx(), reg_tmp);
+        io_ = io::jit_io_multi_dt_helper_t<Vmm>(this, isa,
+                {src_d_.data_type(), dst_d_.data_type(), f32}, io_conf,
+                io_tail_conf, io_bf16_conf,
+                {{dst_d_.data_type(), io_saturation_conf}});
+
+        const auto &po = pd_->attr()->post_ops_;
+        for (int i = 0; i < po.len(); i++)
+            eltwise_injectors_.emplace_back(
+                    new jit_uni_eltwise_injector_f32<isa>(
+                            this, po.entry_[i].eltwise));
+    }
+
+    void operator()(const void *src, void *dst, const float *a, const float *b,
+            const float *dst_scales) const override {
+        ker_args_t args;
+        args.src = src;
+        args.dst = dst;
+        args.a = a;
+        args.b = b;
+        args.dst_scales = dst_scales;
+        jit_generator::operator()(&args);
+    }
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    static constexpr int vlen = cpu_isa_traits<isa>::vlen;
+
+    struct ker_args_t {
+        const void *src;
+        void *dst;
+        const float *a;
+        const float *b;
+        const float *dst_scales;
+    };
+
+    io::jit_io_multi_dt_helper_t<Vmm> io_;
+    std::vector<std::unique_ptr<jit_uni_eltwise_injector_f32<isa>>>
+            eltwise_injectors_;
+    const memory_desc_wrapper src_d_, dst_d_;
+    const layout_t layout_;
+    const dim_t simd_w_;
+    const dim_t len_;
+    const dim_t simd_full_;
+    const dim_t simd_tail_;
+
+    const Reg64 reg_param = abi_param1;
+    const Reg64 reg_src = r8;
+    const Reg64 reg_dst = r9;
+    const Reg64 reg_a = r10;
+    const Reg64 reg_b = r11;
+    const Reg64 reg_cnt = r12;
+    const Reg64 reg_tmp = r13;
+    const Reg64 reg_dst_scales = r14;
+
+    const Vmm vmm_tail_mask = Vmm(0);
+    const Vmm vmm_data = Vmm(1);
+    const Vmm vmm_a = Vmm(2);
+    const Vmm vmm_b = Vmm(3);
+    const Vmm vmm_dst_scales = Vmm(4);
+    const Vmm vmm_zero = Vmm(5);
+    const Vmm vmm_saturation_ubound = Vmm(6);
+
+    const int bf16_emu_zmm_1_idx = 28;
+    const int bf16_emu_zmm_2_idx = 29;
+    const int bf16_emu_zmm_3_idx = 30;
+    const int bf16_emu_zmm_4_idx = 31;
+    const int tail_opmask_idx = 2;
+
+    void apply(bool tail) {
+        if (layout_ == nspc) {
+            io_[f32]->load(ptr[reg_a], vmm_a, tail);
+            io_[f32]->load(ptr[reg_b], vmm_b, tail);
+        }
+        io_[src_d_.data_type()]->load(ptr[reg_src], vmm_data, tail);
+        uni_vfmadd213ps(vmm_data, vmm_a, vmm_b);
+        for (auto &inj : eltwise_injectors_)
+            inj->compute_vector(vmm_data.getIdx());
+        uni_vmulps(vmm_data, vmm_data, vmm_dst_scales);
+        io_[dst_d_.data_type()]->store(vmm_data, ptr[reg_dst], tail);
+    }
+
+    void advance() {
+        add(reg_src, simd_w_ * src_d_.data_type_size());
+        add(reg_dst, simd_w_ * dst_d_.data_type_size());
+        if (layout_ == nspc) {
+            add(reg_a, simd_w_ * sizeof(float));
+            add(reg_b, simd_w_ * sizeof(float));
+        }
+    }
+
+    void generate() override {
+        preamble();
+
+        io_.init_bf16();
+        if (simd_tail_) io_.prepare_tail_mask();
+
+#define PARAM_OFF(x) offsetof(ker_args_t, x)
+        mov(reg_src, ptr[reg_param + PARAM_OFF(src)]);
+        mov(reg_dst, ptr[reg_param + PARAM_OFF(dst)]);
+        mov(reg_a, ptr[reg_param + PARAM_OFF(a)]);
+        mov(reg_b, ptr[reg_param + PARAM_OFF(b)]);
+        mov(reg_dst_scales, ptr[reg_param + PARAM_OFF(dst_scales)]);
+#undef PARAM_OFF
+
+        uni_vbroadcastss(vmm_dst_scales, ptr[reg_dst_scales]);
+        io_.init_saturate_f32({dst_d_.data_type()});
+
+        // A single channel per row for ncsp, a single channel block for the
+        // blocked layout: coefficients stay in registers for the whole row.
+        if (layout_ == ncsp) {
+            uni_vbroadcastss(vmm_a, ptr[reg_a]);
+            uni_vbroadcastss(vmm_b, ptr[reg_b]);
+        } else if (layout_ == blocked) {
+            uni_vmovups(vmm_a, ptr[reg_a]);
+            uni_vmovups(vmm_b, ptr[reg_b]);
+        }
+
+        if (simd_full_ > 0) {
+            Label loop;
+            mov(reg_cnt, simd_full_);
+            L(loop);
+            {
+                apply(false);
+                advance();
+                dec(reg_cnt);
+                jnz(loop, T_NEAR);
+            }
+        }
+        if (simd_tail_ > 0) apply(true);
+
+        postamble();
+
+        for (auto &inj : eltwise_injectors_)
+            inj->prepare_table();
+    }
+};
+
+gnorm_apply_kernel_t *gnorm_apply_kernel_t::create(
+        const group_normalization_pd_t *pd, cpu_isa_t isa, layout_t layout) {
+    if (isa == avx512_core)
+        return new jit_gnorm_apply_kernel_t<avx512_core>(pd, layout);
+    if (isa == avx2) return new jit_gnorm_apply_kernel_t<avx2>(pd, layout);
+    assert(!"kernel is empty.");
+    return nullptr;
+}
+
+status_t jit_uni_group_normalization_fwd_t::pd_t::init_layout() {
+    using namespace format_tag;
+    const memory_desc_wrapper src_d(src_md());
+    const memory_desc_wrapper dst_d(dst_md());
+    const int simd_w = isa_ == avx512_core ? 16 : 8;
+
+    // 2D tensors have no spatial dimensions, so plain layouts coincide and
+    // there is no blocked one.
+    format_tag_t ncsp_tag = ab, nspc_tag = ab, blocked_tag = format_tag::undef;
+    if (ndims() > 2) {
+        const int sp_idx = ndims() - 3;
+        ncsp_tag = utils::pick(sp_idx, abc, abcd, abcde);
+        nspc_tag = utils::pick(sp_idx, acb, acdb, acdeb);
+        blocked_tag = simd_w == 16
+                ? utils::pick(sp_idx, aBc16b, aBcd16b, aBcde16b)
+                : utils::pick(sp_idx, aBc8b, aBcd8b, aBcde8b);
+    }
+
+    const auto tag = src_d.matches_one_of_tag(ncsp_tag, nspc_tag, blocked_tag);
+    if (tag == format_tag::undef || !dst_d.matches_tag(tag))
+        return status::unimplemented;
+
+    if (tag == ncsp_tag)
+        layout_ = ncsp;
+    else if (tag == nspc_tag)
+        layout_ = nspc;
+    else
+        layout_ = blocked;
+
+    // A group must consist of whole channel blocks.
+    if (layout_ == blocked && C_per_G() % simd_w != 0)
+        return status::unimplemented;
+
+    return status::success;
+}
+
+bool jit_uni_group_normalization_fwd_t::pd_t::eltwise_post_ops_ok() const {
+    const auto &po = attr()->post_ops_;
+    for (int i = 0; i < po.len(); i++) {
+        if (!po.entry_[i].is_eltwise()) return false;
+        if (!eltwise_injector::is_supported(isa_, po.entry_[i].eltwise.alg))
+            return false;
+    }
+    return true;
+}
+
+status_t jit_uni_group_normalization_fwd_t::pd_t::init(engine_t *engine) {
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    if (mayiuse(avx512_core))
+        isa_ = avx512_core;
+    else if (mayiuse(avx2))
+        isa_ = avx2;
+    else
+        return status::unimplemented;
+
+    const bool ok = is_fwd() && !has_zero_dim_memory()
+            && utils::one_of(src_md()->data_type, f32, bf16, s8, u8)
+            && utils::one_of(dst_md()->data_type, f32, bf16, s8, u8)
+            && IMPLICATION(
+                    utils::one_of(bf16, src_md()->data_type,
+                            dst_md()->data_type),
+                    isa_ == avx512_core)
+            && stat_md()->data_type == f32 && check_scale_shift_data_type()
+            && attr()->has_default_values(
+                    skip_mask_t::scales_runtime | skip_mask_t::post_ops)
+            && attr_scales_ok() && eltwise_post_ops_ok()
+            && set_default_formats_common();
+    if (!ok) return status::unimplemented;
+
+    CHECK(init_layout());
+
+    init_scratchpad();
+    return status::success;
+}
+
+void jit_uni_group_normalization_fwd_t::pd_t::init_scratchpad() {
+    auto scratchpad = scratchpad_registry().registrar();
+    // Per image and channel coefficients of the normalization, see
+    // gnorm_apply_kernel_t.
+    scratchpad.template book<float>(key_gnorm_scale_shift, 2 * MB() * C());
+    if (stats_are_tmp()) {
+        scratchpad.template book<float>(key_gnorm_tmp_mean, MB() * G());
+        scratchpad.template book<float>(key_gnorm_tmp_var, MB() * G());
+    }
+}
+
+status_t jit_uni_group_normalization_fwd_t::init(engine_t *engine) {
+    const auto isa = pd()->isa_;
+    const auto layout = pd()->layout_;
+    if (!pd()->stats_are_src()) {
+        CHECK(safe_ptr_assign(mean_kernel_,
+                gnorm_stat_kernel_t::create(pd(), isa, layout, false)));
+        CHECK(safe_ptr_assign(var_kernel_,
+                gnorm_stat_kernel_t::create(pd(), isa, layout, true)));
+        CHECK(mean_kernel_->create_kernel());
+        CHECK(var_kernel_->create_kernel());
+    }
+    CHECK(safe_ptr_assign(
+            apply_kernel_, gnorm_apply_kernel_t::create(pd(), isa, layout)));
+    return apply_kernel_->create_kernel();
+}
+
+status_t jit_uni_group_normalization_fwd_t::execute_forward(
+        const exec_ctx_t &ctx) const {
+    auto scratchpad = ctx.get_scratchpad_grantor();
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    auto scale = CTX_IN_MEM(const float *, DNNL_ARG_SCALE);
+    auto shift = CTX_IN_MEM(const float *, DNNL_ARG_SHIFT);
+
+    float *mean {nullptr}, *variance {nullptr};
+    if (pd()->stats_are_tmp()) {
+        mean = scratchpad.template get<float>(key_gnorm_tmp_mean);
+        variance = scratchpad.template get<float>(key_gnorm_tmp_var);
+    } else if (pd()->stats_are_src()) {
+        mean = const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_MEAN));
+        variance = const_cast<float *>(
+                CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE));
+    } else {
+        mean = CTX_OUT_MEM(float *, DNNL_ARG_MEAN);
+        variance = CTX_OUT_MEM(float *, DNNL_ARG_VARIANCE);
+    }
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+    DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper stat_d(pd()->stat_md());
+    const memory_desc_wrapper sc_d(pd()->weights_md());
+    const size_t src_dt_size = src_d.data_type_size();
+    const size_t dst_dt_size = dst_d.data_type_size();
+    src += src_d.offset0() * src_dt_size;
+    dst += dst_d.offset0() * dst_dt_size;
+
+    const auto layout = pd()->layout_;
+    const dim_t N = pd()->MB();
+    const dim_t C = pd()->C();
+    const dim_t G = pd()->G();
+    const dim_t CG = pd()->C_per_G();
+    const dim_t SP = pd()->SP();
+    const float eps = pd()->desc()->group_norm_epsilon;
+    const bool calculate_stats = !pd()->stats_are_src();
+
+    float *a = scratchpad.template get<float>(key_gnorm_scale_shift);
+    float *b = a + N * C;
+
+    // Phase 1: statistics of every group folded with the scale, shift and
+    // source scale into per channel coefficients.
+    parallel_nd(N, G, [&](dim_t n, dim_t g) {
+        const auto s_off = stat_d.off(n, g);
+        if (calculate_stats) {
+            const dim_t group_off
+                    = n * C * SP + g * CG * (layout == nspc ? 1 : SP);
+            const char *group_src = src + group_off * src_dt_size;
+            float sum = 0.f;
+            (*mean_kernel_)(group_src, nullptr, &sum);
+            mean[s_off] = sum / (CG * SP);
+            float sq_sum = 0.f;
+            (*var_kernel_)(group_src, &mean[s_off], &sq_sum);
+            variance[s_off] = sq_sum / (CG * SP);
+        }
+
+        const float inv_sqrtvar = 1.f / sqrtf(variance[s_off] + eps);
+        for (dim_t c = g * CG; c < (g + 1) * CG; c++) {
+            const float sm = (scale ? scale[sc_d.off(c)] : 1.f) * inv_sqrtvar;
+            const float sv = shift ? shift[sc_d.off(c)] : 0.f;
+            a[n * C + c] = sm * src_scales[0];
+            b[n * C + c] = (sv - mean[s_off] * sm) * src_scales[0];
+        }
+    });
+
+    // Phase 2: normalization of the rows of the tensor.
+    switch (layout) {
+        case ncsp:
+            parallel_nd(N, C, [&](dim_t n, dim_t c) {
+                const dim_t off = (n * C + c) * SP;
+                (*apply_kernel_)(src + off * src_dt_size,
+                        dst + off * dst_dt_size, &a[n * C + c], &b[n * C + c],
+                        dst_scales);
+            });
+            break;
+        case nspc:
+            parallel_nd(N, SP, [&](dim_t n, dim_t sp) {
+                const dim_t off = (n * SP + sp) * C;
+                (*apply_kernel_)(src + off * src_dt_size,
+                        dst + off * dst_dt_size, &a[n * C], &b[n * C],
+                        dst_scales);
+            });
+            break;
+        case blocked: {
+            const dim_t blk = src_d.blocking_desc().inner_blks[0];
+            parallel_nd(N, C / blk, [&](dim_t n, dim_t cb) {
+                const dim_t off = (n * C + cb * blk) * SP;
+                (*apply_kernel_)(src + off * src_dt_size,
+                        dst + off * dst_dt_size, &a[n * C + cb * blk],
+                        &b[n * C + cb * blk], dst_scales);
+            });
+        } break;
+    }
+
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_GROUP_NORMALIZATION_HPP
+#define CPU_X64_JIT_UNI_GROUP_NORMALIZATION_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_group_normalization_pd.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+namespace gnorm_layout {
+// Physical layouts of the data tensor supported by the jit implementation.
+enum layout_t {
+    ncsp, // plain, channels first
+    nspc, // plain, channels last
+    blocked, // channels blocked by the vector length
+};
+} // namespace gnorm_layout
+
+// Reduces a group of the source tensor to a single value: the sum of its
+// elements or the sum of squared deviations from the group mean.
+struct gnorm_stat_kernel_t {
+    static gnorm_stat_kernel_t *create(const group_normalization_pd_t *pd,
+            cpu_isa_t isa, gnorm_layout::layout_t layout, bool compute_var);
+    virtual ~gnorm_stat_kernel_t() = default;
+
+    virtual void operator()(
+            const void *src, const float *mean, float *res) const {};
+
+    virtual status_t create_kernel() { return status::success; }
+
+protected:
+    gnorm_stat_kernel_t(const group_normalization_pd_t *pd) : pd_(pd) {}
+
+    const group_normalization_pd_t *pd_;
+};
+
+// Computes `dst = post_ops(src * a + b) * dst_scale` for a row of the data
+// tensor, where `a` and `b` fold the statistics, scale and shift of the
+// channel.
+struct gnorm_apply_kernel_t {
+    static gnorm_apply_kernel_t *create(const group_normalization_pd_t *pd,
+            cpu_isa_t isa, gnorm_layout::layout_t layout);
+    virtual ~gnorm_apply_kernel_t() = default;
+
+    virtual void operator()(const void *src, void *dst, const float *a,
+            const float *b, const float *dst_scales) const {};
+
+    virtual status_t create_kernel() { return status::success; }
+
+protected:
+    gnorm_apply_kernel_t(const group_normalization_pd_t *pd) : pd_(pd) {}
+
+    const group_normalization_pd_t *pd_;
+};
+
+struct jit_uni_group_normalization_fwd_t : public primitive_t {
+    struct pd_t : public cpu_group_normalization_fwd_pd_t {
+        using cpu_group_normalization_fwd_pd_t::
+                cpu_group_normalization_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", isa_, ""),
+                jit_uni_group_normalization_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        cpu_isa_t isa_ = isa_undef;
+        gnorm_layout::layout_t layout_ = gnorm_layout::ncsp;
+
+    private:
+        status_t init_layout();
+        bool eltwise_post_ops_ok() const;
+        void init_scratchpad();
+    };
+
+    jit_uni_group_normalization_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+    virtual ~jit_uni_group_normalization_fwd_t() = default;
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return execute_forward(ctx);
+    }
+
+private:
+    status_t execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<gnorm_stat_kernel_t> mean_kernel_;
+    std::unique_ptr<gnorm_stat_kernel_t> var_kernel_;
+    std::unique_ptr<gnorm_apply_kernel_t> apply_kernel_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
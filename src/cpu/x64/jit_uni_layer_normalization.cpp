@@ -51,6 +51,7 @@ struct jit_stat_and_data_base_kernel_t : stat_and_data_kernel_t,
     void operator()(const void *src, void *dst, const float *scale,
             const float *shift, float *mean, float *var,
             const float *src_scales, const float *dst_scales,
+            const void *residual, void *sum, const size_t sum_stride,
             const size_t block_size) const override {
         ker_args_t args;
         args.src = src;
@@ -61,6 +62,9 @@ struct jit_stat_and_data_base_kernel_t : stat_and_data_kernel_t,
         args.var = var;
         args.src_scales = src_scales;
         args.dst_scales = dst_scales;
+        args.residual = residual;
+        args.sum = sum;
+        args.sum_stride = sum_stride;
         args.block_size
                 = block_size * C_ * types::data_type_size(src_d_.data_type());
         args.eps = eps_;
@@ -82,6 +86,8 @@ struct jit_stat_and_data_base_kernel_t : stat_and_data_kernel_t,
         , use_shift_(pd_->use_shift())
         , save_stats_(pd_->is_training())
         , calculate_stats_(!pd_->stats_are_src())
+        , use_mean_(!pd_->use_rms_norm())
+        , fuse_residual_(pd_->fuse_residual_add())
         , eps_(pd_->desc()->layer_norm_epsilon) {
 
         io::io_conf_t io_conf;
@@ -116,6 +122,9 @@ protected:
         const float *var;
         const float *src_scales;
         const float *dst_scales;
+        const void *residual;
+        void *sum;
+        size_t sum_stride;
         size_t block_size;
         float eps;
     };
@@ -130,6 +139,8 @@ protected:
     const bool use_shift_;
     const bool save_stats_;
     const bool calculate_stats_;
+    const bool use_mean_;
+    const bool fuse_residual_;
     const float eps_;
 
     const Reg64 reg_param = abi_param1;
@@ -144,6 +155,8 @@ protected:
     const Reg64 reg_var = r13;
     const Reg64 reg_src_scales = r14;
     const Reg64 reg_dst_scales = r15;
+    const Reg64 reg_residual = rsi;
+    const Reg64 reg_sum = rbp;
 
     const Vmm vmm_tail_mask = Vmm(0);
     const Vmm vmm_zero = Vmm(4); // In unroll range, safe for dst compute.
@@ -168,10 +181,20 @@ protected:
     const int bf16_emu_zmm_4_idx = 31;
     const int tail_opmask_idx = 1;
 
+    // With the residual fusion statistics and dst are computed from the sum.
     Address src_ptr(size_t offt = 0) {
+        const Reg64 reg_data = fuse_residual_ ? reg_sum : reg_src;
+        return vmmword[reg_data + offt * src_d_.data_type_size()];
+    }
+
+    Address src_in_ptr(size_t offt = 0) {
         return vmmword[reg_src + offt * src_d_.data_type_size()];
     }
 
+    Address residual_ptr(size_t offt = 0) {
+        return vmmword[reg_residual + offt * src_d_.data_type_size()];
+    }
+
     Address dst_ptr(size_t offt = 0) {
         return vmmword[reg_dst + offt * dst_d_.data_type_size()];
     }
@@ -255,6 +278,16 @@ protected:
         if (save_stats_) uni_vmovss(ptr[reg_mean], Xmm(vmm_mean.getIdx()));
     }
 
+    // Stores src + residual to the sum row, the row stays in cache for the
+    // statistics and dst passes that follow.
+    void add_residual(size_t offt_elems, bool tail = false) {
+        const auto dt = src_d_.data_type();
+        io_[dt]->load(src_in_ptr(offt_elems), vmm_dst, tail);
+        io_[dt]->load(residual_ptr(offt_elems), vmm_tmp, tail);
+        uni_vaddps(vmm_dst, vmm_dst, vmm_tmp);
+        io_[dt]->store(vmm_dst, src_ptr(offt_elems), tail);
+    }
+
     void calculate_dst(size_t offt_elems, bool tail = false) {
         if (use_scale_) {
             io_[f32]->load(scale_ptr(offt_elems), vmm_scale, tail);
@@ -263,7 +296,7 @@ protected:
             io_[f32]->load(shift_ptr(offt_elems), vmm_shift, tail);
         }
         io_[src_d_.data_type()]->load(src_ptr(offt_elems), vmm_dst, tail);
-        uni_vsubps(vmm_dst, vmm_dst, vmm_mean);
+        if (use_mean_) uni_vsubps(vmm_dst, vmm_dst, vmm_mean);
         uni_vmulps(vmm_dst, vmm_dst, vmm_inv_sqrtvar);
         if (use_scale_ && use_shift_)
             uni_vfmadd213ps(vmm_dst, vmm_scale, vmm_shift);
@@ -298,7 +331,10 @@ protected:
         mov(reg_dst_scales, ptr[reg_param + PARAM_OFF(dst_scales)]);
         mov(reg_block_end, ptr[reg_param + PARAM_OFF(block_size)]);
         mov(reg_eps, ptr[reg_param + PARAM_OFF(eps)]);
-#undef PARAM_OFF
+        if (fuse_residual_) {
+            mov(reg_residual, ptr[reg_param + PARAM_OFF(residual)]);
+            mov(reg_sum, ptr[reg_param + PARAM_OFF(sum)]);
+        }
 
         uni_vmovq(xmm_tmp, reg_eps);
         uni_vbroadcastss(vmm_eps, xmm_tmp);
@@ -318,14 +354,26 @@ protected:
             cmp(reg_block_end, reg_src);
             jle(end, T_NEAR);
 
+            if (fuse_residual_) {
+                for (int i = 0; i < axis_simd_full_; i++)
+                    add_residual(i * simd_w_);
+                if (axis_simd_tail_)
+                    add_residual(axis_simd_full_ * simd_w_, true);
+            }
+
+            // the mean is zero in the RMS mode
+            if (!use_mean_) uni_vpxor(vmm_mean, vmm_mean, vmm_mean);
+
             if (calculate_stats_) {
                 // compute stats
-                compute_mean();
+                if (use_mean_) compute_mean();
                 compute_var();
             } else {
                 // read mean and var from input
-                uni_vmovss(xmm_tmp, dword[reg_mean]);
-                uni_vbroadcastss(vmm_mean, xmm_tmp);
+                if (use_mean_) {
+                    uni_vmovss(xmm_tmp, dword[reg_mean]);
+                    uni_vbroadcastss(vmm_mean, xmm_tmp);
+                }
                 uni_vmovss(xmm_tmp, dword[reg_var]);
                 uni_vbroadcastss(vmm_inv_sqrtvar, xmm_tmp);
             }
@@ -350,11 +398,16 @@ protected:
 
             add(reg_src, c_src_size);
             add(reg_dst, c_dst_size);
-            add(reg_mean, float_size);
+            if (use_mean_) add(reg_mean, float_size);
             add(reg_var, float_size);
+            if (fuse_residual_) {
+                add(reg_residual, c_src_size);
+                add(reg_sum, ptr[reg_param + PARAM_OFF(sum_stride)]);
+            }
             jmp(unroll_loop);
         }
         L(end);
+#undef PARAM_OFF
 
         postamble();
     }
@@ -987,19 +1040,39 @@ status_t jit_uni_layer_normalization_fwd_t::execute_forward(
     const memory_desc_wrapper dst_d(pd()->dst_md());
 
     const dim_t N = pd()->across_axis();
+    const dim_t C = pd()->norm_axis();
     const dim_t C_padded = src_d.padded_dims()[pd()->ndims() - 1];
 
-    parallel(0, [&](const int ithr, const int nthr) {
+    // The residual sum goes to the user memory if it was passed, otherwise
+    // each thread keeps a single row of it in the scratchpad.
+    const auto residual = CTX_IN_MEM(const void *, DNNL_ARG_SRC_1);
+    auto sum = pd()->fuse_residual_add() ? CTX_OUT_MEM(void *, DNNL_ARG_DST_1)
+                                         : nullptr;
+    const bool sum_in_scratchpad = residual && !sum;
+    char *const sum_scratch
+            = scratchpad.template get<char>(key_lnorm_tmp_residual);
+    const size_t sum_stride
+            = sum_in_scratchpad ? 0 : C * src_d.data_type_size();
+
+    parallel(pd()->nthr_, [&](const int ithr, const int nthr) {
         dim_t N_start = 0, N_end = 0;
         balance211(N, nthr, ithr, N_start, N_end);
+        const size_t src_off = N_start * C_padded * src_d.data_type_size();
         const char *const __restrict src_ptr
-                = reinterpret_cast<const char *>(src)
-                + N_start * C_padded * src_d.data_type_size();
+                = reinterpret_cast<const char *>(src) + src_off;
         char *const __restrict dst_ptr = reinterpret_cast<char *>(dst)
                 + N_start * C_padded * dst_d.data_type_size();
+        const char *const res_ptr = residual
+                ? reinterpret_cast<const char *>(residual) + src_off
+                : nullptr;
+        char *const sum_ptr = sum_in_scratchpad
+                ? sum_scratch + ithr * C * src_d.data_type_size()
+                : sum ? reinterpret_cast<char *>(sum) + src_off : nullptr;
         const int block_size = N_end - N_start;
-        (*stat_and_data_kernel_)(src_ptr, dst_ptr, scale, shift, &mean[N_start],
-                &variance[N_start], src_scales, dst_scales, block_size);
+        (*stat_and_data_kernel_)(src_ptr, dst_ptr, scale, shift,
+                mean ? &mean[N_start] : nullptr, &variance[N_start],
+                src_scales, dst_scales, res_ptr, sum_ptr, sum_stride,
+                block_size);
     });
     return status::success;
 }
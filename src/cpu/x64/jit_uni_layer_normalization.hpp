@@ -43,6 +43,7 @@ struct stat_and_data_kernel_t {
     virtual void operator()(const void *src, void *dst, const float *scale,
             const float *shift, float *mean, float *var,
             const float *src_scales, const float *dst_scales,
+            const void *residual, void *sum, const size_t sum_stride,
             const size_t block_size) const {};
 
     virtual status_t create_kernel() { return status::success; }
@@ -110,6 +111,9 @@ struct jit_uni_layer_normalization_fwd_t : public primitive_t {
                                            dst_md()->data_type),
                             mayiuse(avx512_core_fp16))
                     && stat_md()->data_type == f32
+                    // the residual sum is kept in the source data type
+                    && IMPLICATION(fuse_residual_add(),
+                            utils::one_of(src_md()->data_type, f32, bf16, f16))
                     && check_scale_shift_data_type()
                     && attr()->has_default_values(skip_mask_t::scales_runtime)
                     && attr_scales_ok() && set_default_formats_common()
@@ -126,6 +130,7 @@ struct jit_uni_layer_normalization_fwd_t : public primitive_t {
                         stats_are_src() ? &reordered_stat_md_ : stat_md()));
             }
 
+            nthr_ = dnnl_get_max_threads();
             init_scratchpad();
             return status::success;
         }
@@ -134,17 +139,26 @@ struct jit_uni_layer_normalization_fwd_t : public primitive_t {
 
         std::shared_ptr<primitive_desc_t> reorder_pd_;
         memory_desc_t reordered_stat_md_;
+        int nthr_; // To not exceed the limit in execute used for set up.
 
     private:
         void init_scratchpad() {
             using namespace memory_tracking::names;
             auto scratchpad = scratchpad_registry().registrar();
             if (use_tmp_stats()) {
-                scratchpad.template book<float>(
-                        key_lnorm_tmp_mean, across_axis());
+                if (!use_rms_norm())
+                    scratchpad.template book<float>(
+                            key_lnorm_tmp_mean, across_axis());
                 scratchpad.template book<float>(
                         key_lnorm_tmp_var, across_axis());
             }
+            if (fuse_residual_add()) {
+                // A row of the residual sum per thread, used when the user
+                // does not ask for the sum to be stored.
+                const memory_desc_wrapper src_d(src_md());
+                scratchpad.book(key_lnorm_tmp_residual, nthr_ * norm_axis(),
+                        src_d.data_type_size());
+            }
             if (reordered_stat_md_ != *stat_md() && !stats_are_tmp()) {
                 scratchpad.book(key_nested, reorder_pd_->scratchpad_registry());
             }
@@ -191,10 +205,12 @@ struct jit_uni_layer_normalization_fwd_t : public primitive_t {
         memory_t variance(
                 engine, &(pd()->reordered_stat_md_), std::move(variance_mem));
 
-        // reorder input stats
+        // reorder input stats, there is no mean in the RMS mode
+        const bool use_mean = !pd()->use_rms_norm();
         if (pd()->stats_are_src() && reorder_) {
-            reorder_stat(
-                    ctx, engine, ctx.args().at(DNNL_ARG_MEAN), {&mean, false});
+            if (use_mean)
+                reorder_stat(ctx, engine, ctx.args().at(DNNL_ARG_MEAN),
+                        {&mean, false});
             reorder_stat(ctx, engine, ctx.args().at(DNNL_ARG_VARIANCE),
                     {&variance, false});
         }
@@ -202,8 +218,9 @@ struct jit_uni_layer_normalization_fwd_t : public primitive_t {
         if (status != status::success) return status;
         // reorder output stats
         if (!pd()->stats_are_src() && reorder_) {
-            reorder_stat(
-                    ctx, engine, {&mean, true}, ctx.args().at(DNNL_ARG_MEAN));
+            if (use_mean)
+                reorder_stat(ctx, engine, {&mean, true},
+                        ctx.args().at(DNNL_ARG_MEAN));
             reorder_stat(ctx, engine, {&variance, true},
                     ctx.args().at(DNNL_ARG_VARIANCE));
         }
@@ -231,6 +248,7 @@ struct jit_uni_layer_normalization_bwd_t : public primitive_t {
             const memory_desc_wrapper src_d(src_md());
 
             const bool ok = is_bwd() && !has_zero_dim_memory()
+                    && !use_rms_norm()
                     && mayiuse(avx2) // sse41 is not supported yet
                     && utils::one_of(src_md()->data_type, f32, bf16, f16)
                     && utils::one_of(diff_dst_md()->data_type, f32, bf16, f16)
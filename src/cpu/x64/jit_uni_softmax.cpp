@@ -54,6 +54,7 @@ struct jit_softmax_base_t : public jit_generator {
         const void *interim; // scratch memory for intermediate storage
         const void *src_scales; // src_scales defined for all data type cases
         const void *dst_scales; // dst_scales defined for all data type cases
+        const void *mask; // src mask row, f32
         size_t process_n_elems;
     };
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_softmax_t)
@@ -89,6 +90,9 @@ struct jit_softmax_base_t : public jit_generator {
     Reg64 reg_interim_spat_offt = abi_not_param1;
     Reg64 reg_src_scales = rsi;
     Reg64 reg_dst_scales = rdx;
+    // the online algorithm does not use the interim storage
+    Reg64 reg_mask = reg_interim;
+    Reg64 reg_mask_spat_offt = reg_interim_spat_offt;
 
     Opmask injector_mask = Opmask(1);
 
@@ -110,6 +114,11 @@ struct jit_softmax_base_t : public jit_generator {
     bool is_logsoftmax_ = pd_->is_logsoftmax();
     bool axis_is_blocked_;
     bool need_scratchpad_;
+    bool use_online_;
+    bool with_prescale_;
+    bool with_mask_;
+    bool mask_bcast_axis_; // a single mask value per row
+    float prescale_;
 
     size_t simd_w_ = 0;
     size_t unroll_regs_ = 4;
@@ -121,6 +130,7 @@ struct jit_softmax_base_t : public jit_generator {
     size_t process_n_elems_;
     size_t src_axis_stride_;
     size_t interim_axis_stride_;
+    size_t mask_axis_stride_;
     size_t dst_axis_stride_;
     size_t diff_dst_axis_stride_;
 
@@ -132,6 +142,7 @@ struct jit_softmax_base_t : public jit_generator {
         process_n_elems_ = compute_process_n_elems(dst_d_);
         src_axis_stride_ = compute_axis_stride(src_d_);
         interim_axis_stride_ = simd_w_ * sizeof(float);
+        mask_axis_stride_ = simd_w_ * sizeof(float);
         dst_axis_stride_ = compute_axis_stride(dst_d_);
         if (!pd_->is_fwd())
             diff_dst_axis_stride_ = compute_axis_stride(diff_dst_d_);
@@ -170,6 +181,7 @@ struct jit_softmax_base_t : public jit_generator {
         }
         mov(reg_src_scales, ptr[reg_param + PARAM_OFF(src_scales)]);
         mov(reg_dst_scales, ptr[reg_param + PARAM_OFF(dst_scales)]);
+        if (with_mask_) mov(reg_mask, ptr[reg_param + PARAM_OFF(mask)]);
 #undef PARAM_OFF
     }
 
@@ -185,6 +197,10 @@ struct jit_softmax_base_t : public jit_generator {
         return vmmword[reg_interim + reg_interim_spat_offt + offt];
     }
 
+    Address mask_ptr(size_t offt = 0) {
+        return vmmword[reg_mask + reg_mask_spat_offt + offt];
+    }
+
     Address dst_ptr(size_t offt = 0) {
         return vmmword[reg_dst + reg_dst_spat_offt + offt];
     }
@@ -212,6 +228,8 @@ struct jit_softmax_base_t : public jit_generator {
         xor_(reg_dst_spat_offt, reg_dst_spat_offt); // dst addr
         if (need_scratchpad_)
             xor_(reg_interim_spat_offt, reg_interim_spat_offt); // scratch addr
+        if (with_mask_ && !mask_bcast_axis_)
+            xor_(reg_mask_spat_offt, reg_mask_spat_offt); // mask addr
         if (!pd_->is_fwd())
             xor_(reg_diff_dst_spat_offt, reg_diff_dst_spat_offt); // d_dst addr
         L(main_loop);
@@ -227,6 +245,8 @@ struct jit_softmax_base_t : public jit_generator {
                 if (need_scratchpad_)
                     add(reg_interim_spat_offt,
                             unroll_regs_ * interim_axis_stride_);
+                if (with_mask_ && !mask_bcast_axis_)
+                    add(reg_mask_spat_offt, unroll_regs_ * mask_axis_stride_);
                 if (!pd_->is_fwd())
                     add(reg_diff_dst_spat_offt,
                             unroll_regs_ * diff_dst_axis_stride_);
@@ -243,6 +263,8 @@ struct jit_softmax_base_t : public jit_generator {
                 if (need_scratchpad_)
                     add(reg_interim_spat_offt,
                             loop_tail_ * interim_axis_stride_);
+                if (with_mask_ && !mask_bcast_axis_)
+                    add(reg_mask_spat_offt, loop_tail_ * mask_axis_stride_);
                 if (!pd_->is_fwd())
                     add(reg_diff_dst_spat_offt,
                             loop_tail_ * diff_dst_axis_stride_);
@@ -263,8 +285,15 @@ struct jit_softmax_base_t : public jit_generator {
     virtual void initialization_hook() {}
     virtual void accumulate_vsbr() {}
     virtual void compute_diff_src() {}
+    virtual void accumulate_online() {}
+    virtual void compute_dst_online() {}
 
     void forward() {
+        if (use_online_) {
+            accumulate_online();
+            compute_dst_online();
+            return;
+        }
         accumulate_vmax();
         accumulate_vsum();
         compute_dst();
@@ -305,7 +334,7 @@ struct jit_softmax_base_t : public jit_generator {
         if (log_injector_) log_injector_->prepare_table();
     }
 
-    jit_softmax_base_t(const softmax_pd_t *pd)
+    jit_softmax_base_t(const softmax_pd_t *pd, bool use_online)
         : jit_generator(jit_name(), nullptr, MAX_CODE_SIZE, true, isa)
         , pd_(pd)
         , src_d_(pd_->is_fwd() ? pd_->src_md() : pd_->diff_src_md())
@@ -316,8 +345,24 @@ struct jit_softmax_base_t : public jit_generator {
         is_f16_ = utils::one_of(
                 data_type::f16, src_d_.data_type(), dst_d_.data_type());
         simd_w_ = vlen / sizeof(float); // bf16 works on ymms
-        need_scratchpad_ = utils::one_of(
-                dst_d_.data_type(), data_type::u8, data_type::s8);
+        use_online_ = use_online;
+        need_scratchpad_ = !use_online_
+                && utils::one_of(
+                        dst_d_.data_type(), data_type::u8, data_type::s8);
+
+        with_prescale_ = false;
+        with_mask_ = false;
+        mask_bcast_axis_ = false;
+        prescale_ = 1.f;
+        if (pd_->is_fwd()) {
+            auto fwd_pd = static_cast<const softmax_fwd_pd_t *>(pd_);
+            with_prescale_ = fwd_pd->with_src_prescale();
+            prescale_ = fwd_pd->src_prescale();
+            with_mask_ = fwd_pd->with_src_mask();
+            mask_bcast_axis_ = with_mask_
+                    && fwd_pd->src_mask_md()->dims[pd_->axis()] == 1;
+        }
+        assert(IMPLICATION(with_prescale_ || with_mask_, use_online_));
     }
 };
 
@@ -337,6 +382,12 @@ struct jit_softmax_t<avx512_core> : public jit_softmax_base_t<avx512_core> {
 
     Opmask tail_opmask = Opmask(2);
 
+    // registers used by the online algorithm only
+    Vmm vprescale = Vmm(17);
+    Vmm vmask = Vmm(18);
+    Vmm vblock_max = Vmm(19);
+    Vmm vcorr = Vmm(20);
+
     void store(const Address &addr, const Vmm &vmm, data_type_t dt,
             bool tail = false) {
         auto effective_addr = addr;
@@ -575,11 +626,114 @@ struct jit_softmax_t<avx512_core> : public jit_softmax_base_t<avx512_core> {
         });
     }
 
+    // Loads src and applies the pre-scale and the mask.
+    void load_src(const Vmm &vmm, int i, bool tail) {
+        load(vmm, src_ptr(src_axis_stride_ * i), src_d_.data_type(), tail);
+        if (with_prescale_) uni_vmulps(vmm, vmm, vprescale);
+        if (with_mask_ && mask_bcast_axis_) uni_vaddps(vmm, vmm, vmask);
+        if (with_mask_ && !mask_bcast_axis_) {
+            if (tail)
+                uni_vaddps(vmm | tail_opmask, vmm,
+                        mask_ptr(mask_axis_stride_ * i));
+            else
+                uni_vaddps(vmm, vmm, mask_ptr(mask_axis_stride_ * i));
+        }
+    }
+
+    // Updates per-lane running max and sum of exponents.
+    void accumulate_online() override {
+        if (with_prescale_) {
+            mov(reg_tmp, float2int(prescale_));
+            uni_vmovq(Xmm(vprescale.getIdx()), reg_tmp);
+            uni_vbroadcastss(vprescale, Xmm(vprescale.getIdx()));
+        }
+        if (with_mask_ && mask_bcast_axis_)
+            uni_vbroadcastss(vmask, ptr[reg_mask]);
+
+        uni_vmovups(vmax, vneg_flt_max);
+        uni_vpxor(vsum, vsum, vsum);
+
+        axis_loop([&](int unroll, bool tail = false) {
+            uni_vmovups(vblock_max, vmax);
+            for (int i = 0; i < unroll; i++) {
+                Vmm vreg_tmp_src = Vmm(i + 1);
+                load_src(vreg_tmp_src, i, tail);
+                if (tail)
+                    uni_vmaxps(vblock_max | tail_opmask, vblock_max,
+                            vreg_tmp_src);
+                else
+                    uni_vmaxps(vblock_max, vblock_max, vreg_tmp_src);
+            }
+
+            // sum *= exp(max_old - max_new)
+            uni_vsubps(vcorr, vmax, vblock_max);
+            exp_injector_->compute_vector(vcorr.getIdx());
+            uni_vmulps(vsum, vsum, vcorr);
+            uni_vmovups(vmax, vblock_max);
+
+            for (int i = 0; i < unroll; i++)
+                uni_vsubps(Vmm(i + 1), Vmm(i + 1), vmax);
+            exp_injector_->compute_vector_range(1, unroll + 1);
+            for (int i = 0; i < unroll; i++) {
+                if (tail)
+                    uni_vaddps(vsum | tail_opmask, vsum, Vmm(i + 1));
+                else
+                    uni_vaddps(vsum, vsum, Vmm(i + 1));
+            }
+        });
+
+        // Merge the lanes: rescale each partial sum to the global max.
+        uni_vmovups(vblock_max, vmax);
+        get_horizontal_op(vblock_max, vtmp = vcorr, op_t::max);
+        uni_vsubps(vcorr, vmax, vblock_max);
+        exp_injector_->compute_vector(vcorr.getIdx());
+        uni_vmulps(vsum, vsum, vcorr);
+        uni_vmovups(vmax, vblock_max);
+        get_horizontal_op(vsum, vtmp = vcorr, op_t::sum);
+
+        if (is_softmax_) uni_vdivps(vsum, vone, vsum, vtmp = vcorr);
+        if (is_logsoftmax_) log_injector_->compute_vector(vsum.getIdx());
+    }
+
+    void compute_dst_online() override {
+        // vneg_flt_max is not needed anymore and is spoiled here
+        if (utils::one_of(dst_d_.data_type(), data_type::u8, data_type::s8)) {
+            init_saturate_f32(vzero, vsaturation_ubound, reg_tmp,
+                    data_type::f32, dst_d_.data_type());
+        }
+
+        axis_loop([&](int unroll, bool tail = false) {
+            for (int i = 0; i < unroll; i++) {
+                Vmm vreg_tmp_src = Vmm(i + 1);
+                load_src(vreg_tmp_src, i, tail);
+                uni_vsubps(vreg_tmp_src, vreg_tmp_src, vmax);
+            }
+            if (is_softmax_) exp_injector_->compute_vector_range(1, unroll + 1);
+
+            for (int i = 0; i < unroll; i++) {
+                Vmm vreg_tmp_src = Vmm(i + 1);
+                if (is_softmax_)
+                    uni_vmulps(vreg_tmp_src, vreg_tmp_src, vsum);
+                if (is_logsoftmax_)
+                    uni_vsubps(vreg_tmp_src, vreg_tmp_src, vsum);
+
+                Vmm vscale = vcorr;
+                uni_vmovups(vscale, ptr[reg_src_scales]);
+                uni_vmulps(vreg_tmp_src, vreg_tmp_src, vscale);
+                uni_vmovups(vscale, ptr[reg_dst_scales]);
+                uni_vmulps(vreg_tmp_src, vreg_tmp_src, vscale);
+                store(dst_ptr(dst_axis_stride_ * i), vreg_tmp_src,
+                        dst_d_.data_type(), tail);
+            }
+        });
+    }
+
     void initialization_hook() override {
         if (bf16_emu_) bf16_emu_->init_vcvtneps2bf16();
     }
 
-    jit_softmax_t(const softmax_pd_t *pd) : jit_softmax_base_t(pd) {
+    jit_softmax_t(const softmax_pd_t *pd, bool use_online)
+        : jit_softmax_base_t(pd, use_online) {
         if (is_bf16_ && !mayiuse(avx512_core_bf16))
             bf16_emu_.reset(new bf16_emulation_t(this, bf16_emu_zmm_1,
                     bf16_emu_zmm_2, bf16_emu_zmm_3, bf16_emu_gpr,
@@ -713,7 +867,8 @@ struct jit_softmax_t<avx2> : public jit_softmax_base_t<avx2> {
         return jit_generator::operator()(p);
     }
 
-    jit_softmax_t(const softmax_pd_t *pd) : jit_softmax_base_t(pd) {}
+    jit_softmax_t(const softmax_pd_t *pd, bool use_online)
+        : jit_softmax_base_t(pd, use_online) {}
 };
 
 template <>
@@ -845,13 +1000,15 @@ struct jit_softmax_t<sse41> : public jit_softmax_base_t<sse41> {
         return jit_generator::operator()(p);
     }
 
-    jit_softmax_t(const softmax_pd_t *pd) : jit_softmax_base_t(pd) {}
+    jit_softmax_t(const softmax_pd_t *pd, bool use_online)
+        : jit_softmax_base_t(pd, use_online) {}
 };
 
 template <cpu_isa_t isa>
 jit_uni_softmax_fwd_t<isa>::jit_uni_softmax_fwd_t(const pd_t *apd)
     : primitive_t(apd)
-    , softmax_driver_(new softmax_impl::driver_t<isa>(pd())) {}
+    , softmax_driver_(
+              new softmax_impl::driver_t<isa>(pd(), pd()->use_online_)) {}
 
 template <cpu_isa_t isa>
 jit_uni_softmax_fwd_t<isa>::~jit_uni_softmax_fwd_t() {
@@ -867,6 +1024,7 @@ template <cpu_isa_t isa>
 status_t jit_uni_softmax_fwd_t<isa>::execute(const exec_ctx_t &ctx) const {
     const auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
     auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    const auto mask = CTX_IN_MEM(const float *, DNNL_ARG_ATTR_SRC_MASK);
     auto scratchpad_ptr = ctx.get_scratchpad_grantor().template get<char>(
             memory_tracking::names::key_softmax_interim_store);
 
@@ -890,6 +1048,19 @@ status_t jit_uni_softmax_fwd_t<isa>::execute(const exec_ctx_t &ctx) const {
 
     const int nthr = pd()->nthr_;
 
+    // With the mask the rows are in the logical order, see pd_t::src_ops_ok()
+    const memory_desc_wrapper mask_d(pd()->src_mask_md());
+    const int ndims = src_d.ndims();
+    auto mask_row = [&](dim_t ou) -> const float * {
+        if (!mask) return nullptr;
+        dims_t pos;
+        utils::l_dims_by_l_offset(pos, ou, src_d.dims(), ndims - 1);
+        pos[ndims - 1] = 0;
+        for (int d = 0; d < ndims - 1; d++)
+            if (mask_d.dims()[d] == 1) pos[d] = 0;
+        return mask + mask_d.off_v(pos);
+    };
+
     parallel_nd_ext(nthr, outer_size, inner_size,
             [&](int ithr, int, dim_t ou, dim_t in) {
                 dim_t offset = (ou * outer_stride + in * inner_stride);
@@ -899,7 +1070,7 @@ status_t jit_uni_softmax_fwd_t<isa>::execute(const exec_ctx_t &ctx) const {
                                 + ithr * axis_size_padded * sizeof(float)
                                                    : nullptr;
                 softmax_driver_->exec(src_ptr, dst_ptr, interim_ptr, src_scales,
-                        dst_scales, process_n_elems);
+                        dst_scales, mask_row(ou), process_n_elems);
             });
 
     return status::success;
@@ -959,10 +1130,12 @@ namespace softmax_impl {
 template <cpu_isa_t isa>
 struct driver_t : public c_compatible {
 
-    driver_t(const softmax_pd_t *pd) : pd_(pd), ker_(pd_) {}
+    driver_t(const softmax_pd_t *pd, bool use_online = false)
+        : pd_(pd), ker_(pd_, use_online) {}
 
     void exec(const void *src, void *dst, void *interim, const void *src_scales,
-            const void *dst_scales, const dim_t process_n_elems) {
+            const void *dst_scales, const void *mask,
+            const dim_t process_n_elems) {
         typename jit_softmax_t<isa>::call_params_t p;
         p.process_n_elems = process_n_elems;
         p.src = src;
@@ -970,6 +1143,7 @@ struct driver_t : public c_compatible {
         p.interim = interim;
         p.src_scales = src_scales;
         p.dst_scales = dst_scales;
+        p.mask = mask;
         ker_(&p);
     }
 
@@ -26,6 +26,7 @@
 #include "common/utils.hpp"
 
 #include "cpu/cpu_softmax_pd.hpp"
+#include "cpu/platform.hpp"
 #include "cpu/x64/cpu_isa_traits.hpp"
 #include "cpu/x64/jit_avx512_core_bf16cvt.hpp"
 
@@ -88,8 +89,9 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
                     && IMPLICATION(utils::one_of(f16, src_dt, dst_dt),
                             is_superset(isa, avx512_core)
                                     && mayiuse(avx512_core_fp16))
-                    && attr()->has_default_values(skip_mask_t::scales_runtime)
-                    && attr_scales_ok()
+                    && attr()->has_default_values(skip_mask_t::scales_runtime
+                            | skip_mask_t::src_prescale_mask)
+                    && attr_scales_ok() && attr_src_mask_ok()
                     && set_default_formats() == status::success;
             if (!ok) return status::unimplemented;
 
@@ -98,6 +100,11 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
                     && is_dense(); // not dense impl can be easily done
             if (!ok) return status::unimplemented;
 
+            use_online_ = can_use_online()
+                    && (with_src_ops() || is_long_axis());
+            if (with_src_ops() && !(use_online_ && src_ops_ok()))
+                return status::unimplemented;
+
             nthr_ = dnnl_get_max_threads();
             init_scratchpad();
 
@@ -105,11 +112,50 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
         };
 
         int nthr_; // To not exceed the limit in execute used for set up.
+        // Compute the max and the sum of exponents in a single pass over
+        // src, rescaling the partial sum each time the running max grows.
+        // Src is read twice and dst is written once.
+        bool use_online_ = false;
 
     private:
+        // The online algorithm is implemented for plain layouts with the
+        // softmax axis being the innermost one.
+        bool can_use_online() const {
+            const memory_desc_wrapper src_d(src_md());
+            return is_superset(isa, avx512_core) && src_d.is_plain()
+                    && src_d.blocking_desc().strides[axis()] == 1;
+        }
+
+        // Three passes keep the row in L1 if it fits there, otherwise the
+        // online algorithm saves a pass over memory.
+        bool is_long_axis() const {
+            const size_t row_size = axis_size()
+                    * (types::data_type_size(src_md()->data_type)
+                            + types::data_type_size(dst_md()->data_type));
+            return row_size > platform::get_per_core_cache_size(1) / 2;
+        }
+
+        // The kernel computes the mask offset per row, so the rows must be
+        // in the logical order. The mask must be f32 and either dense or
+        // broadcast along the softmax axis.
+        bool src_ops_ok() const {
+            using namespace format_tag;
+            const memory_desc_wrapper src_d(src_md());
+            if (axis() != ndims() - 1
+                    || !src_d.matches_one_of_tag(a, ab, abc, abcd, abcde))
+                return false;
+            if (!with_src_mask()) return true;
+
+            const memory_desc_wrapper mask_d(src_mask_md());
+            return mask_d.data_type() == data_type::f32 && mask_d.is_plain()
+                    && IMPLICATION(mask_d.dims()[axis()] != 1,
+                            mask_d.blocking_desc().strides[axis()] == 1);
+        }
+
         void init_scratchpad() {
-            if (utils::one_of(
-                        dst_md()->data_type, data_type::u8, data_type::s8)) {
+            const bool is_int8_dst = utils::one_of(
+                    dst_md()->data_type, data_type::u8, data_type::s8);
+            if (is_int8_dst && !use_online_) {
                 auto scratchpad = scratchpad_registry().registrar();
                 scratchpad.template book<char>(
                         memory_tracking::names::key_softmax_interim_store,
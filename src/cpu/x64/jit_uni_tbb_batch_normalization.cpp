@@ -2254,6 +2254,7 @@ template <cpu_isa_t isa>
 status_t jit_uni_tbb_batch_normalization_fwd_t<isa>::pd_t::init(
         engine_t *engine) {
     const bool ok = is_fwd() && mayiuse(isa) && !has_zero_dim_memory()
+            && !use_precomputed_sums() && !use_welford_stats()
             && one_of(src_md()->data_type, f32, bf16, f16)
             && src_md()->data_type == dst_md()->data_type
             && IMPLICATION(
@@ -22,6 +22,7 @@
 #include "common/utils.hpp"
 
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/dst_stats_utils.hpp"
 #include "cpu/scale_utils.hpp"
 
 #include "cpu/x64/amx_tile_configure.hpp"
@@ -97,7 +98,8 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
                     primitive_attr_t::skip_mask_t::scales_runtime
                             | primitive_attr_t::skip_mask_t::zero_points_runtime
                             | primitive_attr_t::skip_mask_t::post_ops
-                            | primitive_attr_t::skip_mask_t::sum_dt,
+                            | primitive_attr_t::skip_mask_t::sum_dt
+                            | primitive_attr_t::skip_mask_t::dst_stats,
                     dst_dt)
             && attr()->post_ops_.check_sum_consistent_dt(dst_dt)
             && check_attr_scales() && check_attr_zero_points() && check_bias();
@@ -164,6 +166,7 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     auto scratchpad = scratchpad_registry().registrar();
     init_scratchpad(scratchpad, bgmmc_);
     book_precomputed_scales(scratchpad, attr()->scales_, N());
+    if (attr()->dst_stats_) book_dst_stats(scratchpad, N(), bgmmc_.nthr);
 
     return status::success;
 }
@@ -227,10 +230,20 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
     const bool is_amx = is_superset(isa, avx512_core_amx);
     const int num_threads = brgmm_ctx.get_num_threads_for_parallelization();
 
+    // With parallel reduction over K dst blocks are final only after the
+    // reduction, so the statistics are computed in a separate pass.
+    const bool with_dst_stats = pd()->attr()->dst_stats_;
+    const bool fuse_dst_stats
+            = with_dst_stats && !brgmm_ctx.parallel_reduction_is_used();
+    if (fuse_dst_stats) init_dst_stats(scratchpad, pd()->N(), num_threads);
+
     parallel(num_threads, [&](const int ithr, const int nthr) {
         const int ithr_bmn = brgmm_ctx.get_thread_idx_for_bmn(ithr);
         const int ithr_k = brgmm_ctx.get_thread_idx_for_k(ithr);
         if (ithr_bmn < 0 || ithr_k < 0) return;
+        double *const dst_stats = fuse_dst_stats
+                ? get_dst_stats_partials(scratchpad, pd()->N(), ithr)
+                : nullptr;
         int start {0}, end {0};
         balance211(brgmm_ctx.get_parallel_work_amount(),
                 brgmm_ctx.get_num_threads_for_bmn(), ithr_bmn, start, end);
@@ -263,6 +276,9 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
                         copy_a_chunk_in_buffer(brgmm_ctx, ithr, b, mb, kc);
                     compute_kernel(
                             brgmm_ctx, ithr, b, mb, nb, kc, kc == kc_start);
+                    if (fuse_dst_stats && kc == kc_end - 1)
+                        accumulate_dst_stats_block(
+                                brgmm_ctx, dst_stats, b, mb, nb);
                 }
             }
             ++start;
@@ -274,9 +290,32 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
 
     maybe_reduce_partial_results_and_apply_postops(brgmm_ctx);
 
+    if (fuse_dst_stats) {
+        auto stats = CTX_OUT_MEM(float *, DNNL_ARG_ATTR_DST_STATS);
+        reduce_dst_stats(stats, scratchpad, pd()->N(), num_threads);
+    } else if (with_dst_stats) {
+        const memory_desc_wrapper dst_d(pd()->dst_md());
+        return compute_dst_stats(ctx, dst_d, dst_d.ndims() - 1);
+    }
+
     return status::success;
 }
 
+template <cpu_isa_t isa>
+void brgemm_matmul_t<isa>::accumulate_dst_stats_block(
+        const brg_matmul_exec_ctx_t &brgmm_ctx, double *dst_stats, int b_idx,
+        int m_blk_idx, int n_blk_idx) const {
+    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const int m_s = m_blk_idx * bgmmc.M_blk;
+    const int m_e = nstl::min<int>(bgmmc.M, m_s + bgmmc.M_blk);
+    const int n = n_blk_idx * bgmmc.N_blk;
+    const int n_len = nstl::min<int>(bgmmc.N - n, bgmmc.N_blk);
+
+    for (int m = m_s; m < m_e; m++)
+        accumulate_dst_stats(dst_stats, bgmmc.N, bgmmc.dst_dt,
+                brgmm_ctx.get_data_C_ptr(b_idx, m, n), n, n_len);
+}
+
 template <cpu_isa_t isa>
 void brgemm_matmul_t<isa>::compute_kernel(
         const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr, int b_idx,
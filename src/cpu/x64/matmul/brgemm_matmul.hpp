@@ -111,6 +111,8 @@ private:
             int ithr, int b_idx, int n_blk_idx, int k_blk_idx) const;
     void maybe_reduce_partial_results_and_apply_postops(
             const brg_matmul_exec_ctx_t &brgmm_ctx) const;
+    void accumulate_dst_stats_block(const brg_matmul_exec_ctx_t &brgmm_ctx,
+            double *dst_stats, int b_idx, int m_blk_idx, int n_blk_idx) const;
     void accumulate(
             char *result_ptr, const char *reduce_ptr, size_t size) const;
 
@@ -28,6 +28,7 @@ namespace rnn_brgemm_utils {
 namespace {
 
 x64::cpu_isa_t brgemm_calc_isa(dim_t K1, dim_t K2, bool is_int8, bool is_bf16);
+x64::cpu_isa_t brgemm_calc_non_amx_isa(bool is_int8, bool is_bf16);
 std::pair<dim_t, dim_t> brgemm_calc_k_block(dim_t K1, dim_t K2, dim_t M,
         dim_t n_block, alg_kind_t cell_kind, dim_t src_layer_type_size,
         dim_t As, dim_t Bs, dim_t Cs, dim_t l2_cache_size, x64::cpu_isa_t isa,
@@ -69,8 +70,15 @@ x64::cpu_isa_t brgemm_calc_isa(dim_t K1, dim_t K2, bool is_int8, bool is_bf16) {
         if (!amx_block_invalid) return x64::avx512_core_amx;
     }
 
+    return brgemm_calc_non_amx_isa(is_int8, is_bf16);
+}
+
+x64::cpu_isa_t brgemm_calc_non_amx_isa(bool is_int8, bool is_bf16) {
     if (is_int8) {
-        return x64::avx512_core_vnni;
+        // Intel AVX2 VNNI provides the same u8s8 dot product instruction on
+        // 256-bit registers, so the cells keep the same weights layout.
+        if (x64::mayiuse(x64::avx512_core_vnni)) return x64::avx512_core_vnni;
+        if (x64::mayiuse(x64::avx2_vnni)) return x64::avx2_vnni;
     } else if (is_bf16) {
         return x64::avx512_core_bf16;
     }
@@ -438,10 +446,13 @@ status_t rnn_brgemm_t<prop_kind::forward>::configure_brgemm(
             if ((rnn.kproj_tail % padding) || (rnn.kproj_block % padding)) {
                 rnn.kproj_block = rnn.Kproj;
                 rnn.kproj_tail = 0;
-                rnn.brgemm_isa = rnn.is_cell_dt_int8() ? x64::avx512_core_vnni
-                                                       : x64::avx512_core_bf16;
-            } else {
-                rnn.brgemm_isa = x64::avx512_core_amx;
+                // The projection cannot be blocked for AMX, so all gemms of
+                // the cell fall back to the best non-AMX isa available.
+                rnn.brgemm_isa = adjust_isa_by_m_block(
+                        brgemm_calc_non_amx_isa(is_int8, is_bf16),
+                        rnn.m_block, false);
+                if (rnn.brgemm_isa == x64::isa_undef)
+                    return status::unimplemented;
             }
         } else {
             rnn.kproj_block = rnn.Kproj;
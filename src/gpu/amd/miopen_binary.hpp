@@ -42,7 +42,8 @@ struct miopen_binary_t : public primitive_t {
         status_t init(engine_t *) {
             using namespace data_type;
 
-            bool ok = (set_default_params() == status::success)
+            bool ok = !is_ternary_op()
+                    && (set_default_params() == status::success)
                     && check_data_types() && check_no_blocking()
                     && check_broadcast()
                     && attr()->has_default_values(
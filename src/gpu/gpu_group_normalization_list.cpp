@@ -0,0 +1,32 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "gpu/gpu_impl_list.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace gpu {
+
+// There are no GPU implementations of group normalization yet.
+const impl_list_item_t *get_group_normalization_impl_list(
+        const group_normalization_desc_t *desc) {
+    static const impl_list_item_t empty_list[] = {nullptr};
+    return empty_list;
+}
+
+} // namespace gpu
+} // namespace impl
+} // namespace dnnl
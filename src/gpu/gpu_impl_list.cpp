@@ -34,7 +34,9 @@ const impl_list_item_t *gpu_impl_list_t::get_implementation_list(
             CASE(convolution);
             CASE(deconvolution);
             CASE(eltwise);
+            CASE(embedding_bag);
             CASE(gemm);
+            CASE(group_normalization);
             CASE(inner_product);
             CASE(layer_normalization);
             CASE(lrn);
@@ -78,7 +78,8 @@ struct cudnn_batch_normalization_fwd_t : public primitive_t {
 
             const auto attr_skip_mask = primitive_attr_t::skip_mask_t::post_ops;
 
-            bool ok = is_fwd()
+            bool ok = is_fwd() && !use_precomputed_sums()
+                    && !use_welford_stats()
                     && utils::one_of(src_md()->data_type, f16, f32, s8)
                     && src_md()->data_type == dst_md()->data_type
                     && check_scale_shift_data_type()
@@ -52,7 +52,8 @@ struct gen9_binary_t : public gpu_primitive_t {
             format_tag_t dst_tag
                     = dst_d.matches_one_of_tag(nc, ncw, nchw, ncdhw);
             bool is_plain_layout = dst_d.matches_tag(dst_tag);
-            bool ok = set_default_params() == status::success
+            bool ok = !is_ternary_op()
+                    && set_default_params() == status::success
                     && IMPLICATION(is_broadcast(), is_plain_layout)
                     && !memory_desc_ndims_ok(src_md(0), src_md(1), dst_md())
                     && ((utils::everyone_is(bf16, src_md(0)->data_type,
@@ -51,7 +51,8 @@ struct ref_batch_normalization_fwd_t : public gpu_primitive_t {
 
             const auto attr_skip_mask = primitive_attr_t::skip_mask_t::post_ops;
 
-            bool ok = is_fwd()
+            bool ok = is_fwd() && !use_precomputed_sums()
+                    && !use_welford_stats()
                     && utils::one_of(src_md()->data_type, f32, bf16, f16, s8)
                     && src_md()->data_type == dst_md()->data_type
                     && IMPLICATION(src_md()->data_type == s8,
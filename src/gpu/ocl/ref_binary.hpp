@@ -45,7 +45,8 @@ struct ref_binary_t : public gpu_primitive_t {
 
             const auto attr_skip_mask = sm::post_ops | sm::scales_runtime;
 
-            bool ok = set_default_params() == status::success
+            bool ok = !is_ternary_op()
+                    && set_default_params() == status::success
                     && ((utils::everyone_is(bf16, src_md(0)->data_type,
                                  src_md(1)->data_type)
                                 && utils::one_of(dst_md()->data_type, bf16, u8))
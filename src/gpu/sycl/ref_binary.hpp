@@ -47,7 +47,8 @@ struct ref_binary_t : public sycl_gpu_primitive_t {
             const memory_desc_wrapper src1_d(src_md(1));
             const memory_desc_wrapper dst_d(dst_md());
 
-            const bool ok = set_default_params() == status::success
+            const bool ok = !is_ternary_op()
+                    && set_default_params() == status::success
                     && check_data_types(src0_d, src1_d, dst_d)
                     && check_formats(src0_d, src1_d, dst_d) && is_tensor_op()
                     && attr()->has_default_values(
@@ -0,0 +1,531 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/memory_desc.hpp"
+
+#include "graph/interface/c_types_map.hpp"
+#include "graph/interface/logical_tensor.hpp"
+#include "graph/interface/op.hpp"
+#include "graph/interface/value.hpp"
+
+#include "graph/backend/dnnl/cache_blob.hpp"
+#include "graph/backend/dnnl/common.hpp"
+#include "graph/backend/dnnl/dnnl_backend.hpp"
+#include "graph/backend/dnnl/fusion_info.hpp"
+#include "graph/backend/dnnl/internal_attrs.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+using op_ptr = std::shared_ptr<op_t>;
+
+namespace {
+// "DNNLGCB" followed by the format version
+const uint64_t cache_blob_magic = 0x0142434c4e4e44ULL;
+
+const int32_t meta_op_scales = 0;
+const int32_t meta_op_zps = 1;
+const int32_t meta_op_eltwise = 2;
+const int32_t meta_op_sum = 3;
+const int32_t meta_op_binary = 4;
+const int32_t meta_op_dw_conv = 5;
+
+// A signature skips the ids and the unused fields, so that the same
+// computation in different subgraphs gives the same bytes.
+void save_lt(const logical_tensor_t &lt, cache_blob_writer_t &writer,
+        bool signature = false) {
+    if (!signature) {
+        writer.write(lt);
+    } else {
+        writer.write(lt.ndims);
+        for (int32_t i = 0; i < lt.ndims; i++)
+            writer.write(lt.dims[i]);
+        writer.write(lt.data_type);
+        writer.write(lt.property);
+        writer.write(lt.layout_type);
+        if (lt.layout_type == layout_type::strided) {
+            for (int32_t i = 0; i < lt.ndims; i++)
+                writer.write(lt.layout.strides[i]);
+        }
+    }
+    if (lt.layout_type != layout_type::opaque) return;
+    const memory::desc md = make_dnnl_memory_desc(lt);
+    writer.write(*md.get());
+}
+
+status_t load_lt(cache_blob_reader_t &reader, logical_tensor_t &lt) {
+    CHECK(reader.read(lt));
+    // the dims are indexed with ndims, so a corrupted blob must not get
+    // further than this
+    if (lt.ndims < 0 || lt.ndims > DNNL_MAX_NDIMS)
+        return status::invalid_arguments;
+    if (lt.layout_type != layout_type::opaque) return status::success;
+
+    memory_desc_t raw;
+    CHECK(reader.read(raw));
+    if (raw.ndims < 0 || raw.ndims > DNNL_MAX_NDIMS)
+        return status::invalid_arguments;
+    dnnl_memory_desc_t c_md = nullptr;
+    CHECK(dnnl_memory_desc_clone(&c_md, &raw));
+    const memory::desc md(c_md);
+    lt.layout.layout_id
+            = dnnl_backend::get_singleton().set_mem_desc(md).value();
+    return status::success;
+}
+
+void save_attrs(
+        const op_t *op, cache_blob_writer_t &writer, bool signature) {
+    // sorted by name to make the signature independent of the insertion order
+    std::map<op_attr_t, const graph::utils::attribute_value_t *> attrs;
+    for (const auto &attr : op->get_attributes()) {
+        if (signature && attr.first == op_attr::fusion_info_key) continue;
+        attrs.emplace(attr.first, &attr.second);
+    }
+    writer.write<uint64_t>(attrs.size());
+    for (const auto &attr : attrs) {
+        const auto &value = *attr.second;
+        writer.write<int64_t>(attr.first);
+        writer.write<uint64_t>(value.get_kind());
+        switch (value.get_kind()) {
+            case attribute_kind::b: writer.write(value.get<bool>()); break;
+            case attribute_kind::i: writer.write(value.get<int64_t>()); break;
+            case attribute_kind::f: writer.write(value.get<float>()); break;
+            case attribute_kind::is:
+                writer.write_vector(value.get<std::vector<int64_t>>());
+                break;
+            case attribute_kind::fs:
+                writer.write_vector(value.get<std::vector<float>>());
+                break;
+            case attribute_kind::s:
+                writer.write_string(value.get<std::string>());
+                break;
+            default: assertm(false, "unknown attribute kind"); break;
+        }
+    }
+}
+
+status_t load_attrs(cache_blob_reader_t &reader, op_t *op) {
+    uint64_t num_attrs = 0;
+    CHECK(reader.read(num_attrs));
+    for (uint64_t i = 0; i < num_attrs; i++) {
+        int64_t name = 0;
+        uint64_t kind = 0;
+        CHECK(reader.read(name));
+        CHECK(reader.read(kind));
+        const auto attr_name = static_cast<op_attr_t>(name);
+        switch (kind) {
+            case attribute_kind::b: {
+                bool v = false;
+                CHECK(reader.read(v));
+                op->set_attr<bool>(attr_name, v);
+            } break;
+            case attribute_kind::i: {
+                int64_t v = 0;
+                CHECK(reader.read(v));
+                op->set_attr<int64_t>(attr_name, v);
+            } break;
+            case attribute_kind::f: {
+                float v = 0.f;
+                CHECK(reader.read(v));
+                op->set_attr<float>(attr_name, v);
+            } break;
+            case attribute_kind::is: {
+                std::vector<int64_t> v;
+                CHECK(reader.read_vector(v));
+                op->set_attr<std::vector<int64_t>>(attr_name, v);
+            } break;
+            case attribute_kind::fs: {
+                std::vector<float> v;
+                CHECK(reader.read_vector(v));
+                op->set_attr<std::vector<float>>(attr_name, v);
+            } break;
+            case attribute_kind::s: {
+                std::string v;
+                CHECK(reader.read_string(v));
+                op->set_attr<std::string>(attr_name, v);
+            } break;
+            default: return status::invalid_arguments;
+        }
+    }
+    return status::success;
+}
+
+void save_op_header(
+        const op_t *op, cache_blob_writer_t &writer, bool signature) {
+    if (!signature) writer.write<uint64_t>(op->get_id());
+    writer.write<int64_t>(static_cast<int64_t>(op->get_kind()));
+    if (!signature) {
+        writer.write_string(op->get_name());
+        writer.write<uint8_t>(op->is_internal());
+    }
+    save_attrs(op, writer, signature);
+}
+
+status_t load_op_header(cache_blob_reader_t &reader, op_ptr &op) {
+    uint64_t id = 0;
+    int64_t kind = 0;
+    std::string name;
+    uint8_t internal = 0;
+    CHECK(reader.read(id));
+    CHECK(reader.read(kind));
+    CHECK(reader.read_string(name));
+    CHECK(reader.read(internal));
+    op = std::make_shared<op_t>(static_cast<size_t>(id),
+            static_cast<op_kind_t>(kind), name, internal != 0);
+    return load_attrs(reader, op.get());
+}
+
+// A meta op only carries the attributes and the logical tensors of the fused
+// op, its values are not connected to the subgraph.
+void save_meta_op(int32_t type, const op_t *op, cache_blob_writer_t &writer,
+        bool signature) {
+    writer.write(type);
+    save_op_header(op, writer, signature);
+    writer.write<uint64_t>(op->num_inputs());
+    for (const auto &in : op->get_input_values())
+        save_lt(in->get_logical_tensor(), writer, signature);
+    writer.write<uint64_t>(op->num_outputs());
+    for (const auto &out : op->get_output_values())
+        save_lt(out->get_logical_tensor(), writer, signature);
+}
+
+status_t load_meta_op(cache_blob_reader_t &reader, op_ptr &op) {
+    CHECK(load_op_header(reader, op));
+    for (size_t k = 0; k < 2; k++) {
+        uint64_t num = 0;
+        CHECK(reader.read(num));
+        for (uint64_t i = 0; i < num; i++) {
+            logical_tensor_t lt;
+            CHECK(load_lt(reader, lt));
+            if (k == 0)
+                op->add_input(lt);
+            else
+                op->add_output(lt);
+        }
+    }
+    return status::success;
+}
+
+void save_fusion_info(const op_t *op, const fusion_info_t &info,
+        cache_blob_writer_t &writer, bool signature) {
+    // The scales and zero points are keyed by the index of the argument, the
+    // output ones always use index 0.
+    std::vector<std::pair<int32_t, const op_t *>> args;
+    std::vector<uint64_t> slots;
+    auto &mutable_info = const_cast<fusion_info_t &>(info);
+    for (size_t i = 0; i <= op->num_inputs(); i++) {
+        const bool is_input = i < op->num_inputs();
+        const size_t idx = is_input ? i : 0;
+        if (const op_t *s = mutable_info.get_mutable_scales(is_input, idx)) {
+            args.emplace_back(meta_op_scales, s);
+            slots.emplace_back(i);
+        }
+        if (const op_t *z = info.get_mutable_zero_points(is_input, idx)) {
+            args.emplace_back(meta_op_zps, z);
+            slots.emplace_back(i);
+        }
+    }
+    writer.write<uint64_t>(args.size());
+    for (size_t i = 0; i < args.size(); i++) {
+        save_meta_op(args[i].first, args[i].second, writer, signature);
+        writer.write<uint8_t>(slots[i] < op->num_inputs());
+        writer.write<uint64_t>(slots[i] < op->num_inputs() ? slots[i] : 0);
+    }
+
+    const auto &pops = info.get_post_ops();
+    writer.write<uint64_t>(pops.size());
+    for (const auto &pop : pops) {
+        const op_t *pop_op = pop->get_op();
+        int32_t type = meta_op_eltwise;
+        if (pop->is_post_sum())
+            type = meta_op_sum;
+        else if (pop->is_post_binary())
+            type = meta_op_binary;
+        else if (pop_op->get_kind() == op_kind::dnnl_convolution)
+            type = meta_op_dw_conv;
+        save_meta_op(type, pop_op, writer, signature);
+        writer.write(pop->get_scale());
+        writer.write(pop->get_zp());
+        const auto &indices = pop->get_unfused_input_indices();
+        writer.write_vector(
+                std::vector<uint64_t>(indices.begin(), indices.end()));
+    }
+}
+
+status_t load_fusion_info(cache_blob_reader_t &reader, fusion_info_t &info) {
+    uint64_t num_args = 0;
+    CHECK(reader.read(num_args));
+    for (uint64_t i = 0; i < num_args; i++) {
+        int32_t type = 0;
+        op_ptr meta;
+        uint8_t is_input = 0;
+        uint64_t index = 0;
+        CHECK(reader.read(type));
+        CHECK(load_meta_op(reader, meta));
+        CHECK(reader.read(is_input));
+        CHECK(reader.read(index));
+        if (type == meta_op_scales)
+            info.set_runtime_scales(meta, is_input != 0, index);
+        else if (type == meta_op_zps)
+            info.set_zero_points(meta, is_input != 0, index);
+        else
+            return status::invalid_arguments;
+    }
+
+    uint64_t num_pops = 0;
+    CHECK(reader.read(num_pops));
+    for (uint64_t i = 0; i < num_pops; i++) {
+        int32_t type = 0;
+        op_ptr meta;
+        float scale = 1.f;
+        int32_t zp = 0;
+        std::vector<uint64_t> raw_indices;
+        CHECK(reader.read(type));
+        CHECK(load_meta_op(reader, meta));
+        CHECK(reader.read(scale));
+        CHECK(reader.read(zp));
+        CHECK(reader.read_vector(raw_indices));
+        const std::vector<size_t> indices(
+                raw_indices.begin(), raw_indices.end());
+        switch (type) {
+            case meta_op_eltwise: info.append_post_eltwise(meta, scale); break;
+            case meta_op_sum:
+                info.append_post_sum(meta, indices, scale, zp);
+                break;
+            case meta_op_binary: info.append_post_binary(meta, indices); break;
+            case meta_op_dw_conv:
+                info.append_post_dw_conv(meta, indices);
+                break;
+            default: return status::invalid_arguments;
+        }
+    }
+    return status::success;
+}
+} // namespace
+
+void save_cache_blob_header(
+        cache_blob_writer_t &writer, const dnnl::engine &p_engine) {
+    const dnnl_version_t *version = dnnl_version();
+    writer.write(cache_blob_magic);
+    writer.write(version->major);
+    writer.write(version->minor);
+    writer.write(version->patch);
+    writer.write_string(version->hash ? version->hash : "");
+    writer.write(version->cpu_runtime);
+    writer.write(version->gpu_runtime);
+    writer.write<uint64_t>(sizeof(memory_desc_t));
+    writer.write<int32_t>(static_cast<int32_t>(p_engine.get_kind()));
+    writer.write<int32_t>(static_cast<int32_t>(dnnl_get_effective_cpu_isa()));
+}
+
+status_t load_cache_blob_header(
+        cache_blob_reader_t &reader, const dnnl::engine &p_engine) {
+    std::vector<uint8_t> expected_blob;
+    cache_blob_writer_t expected(expected_blob);
+    save_cache_blob_header(expected, p_engine);
+
+    std::vector<uint8_t> header(expected_blob.size());
+    CHECK(reader.read_bytes(header.data(), header.size()));
+    return header == expected_blob ? status::success : status::unimplemented;
+}
+
+void save_op_signature(const op_t *op, const fusion_info_mgr_t &mgr,
+        cache_blob_writer_t &writer) {
+    save_op_header(op, writer, true);
+    for (const auto *vals :
+            {&op->get_input_values(), &op->get_output_values()}) {
+        writer.write<uint64_t>(vals->size());
+        for (const auto &val : *vals)
+            save_lt(val->get_logical_tensor(), writer, true);
+    }
+
+    const bool fused = op->has_attr(op_attr::fusion_info_key)
+            && op->get_attr<int64_t>(op_attr::fusion_info_key) != -1;
+    writer.write<uint8_t>(fused);
+    if (!fused) return;
+    const int64_t key = op->get_attr<int64_t>(op_attr::fusion_info_key);
+    save_fusion_info(op, mgr.get_info(key), writer, true);
+}
+
+status_t save_subgraph(
+        const std::shared_ptr<subgraph_t> &sg, cache_blob_writer_t &writer) {
+    const auto &ops = sg->get_ops();
+
+    // index all values in the order they are met
+    std::unordered_map<const value_t *, uint64_t> value_idx;
+    std::vector<const value_t *> values;
+    std::unordered_map<const op_t *, uint64_t> op_idx;
+    for (size_t i = 0; i < ops.size(); i++) {
+        op_idx[ops[i].get()] = i;
+        for (const auto *vals :
+                {&ops[i]->get_input_values(), &ops[i]->get_output_values()}) {
+            for (const auto &val : *vals) {
+                if (value_idx.count(val.get())) continue;
+                value_idx[val.get()] = values.size();
+                values.emplace_back(val.get());
+            }
+        }
+    }
+
+    writer.write(static_cast<int32_t>(sg->get_fpmath_mode()));
+    writer.write<uint64_t>(sg->ins_.size());
+    for (const auto &lt : sg->ins_)
+        save_lt(lt, writer);
+    writer.write<uint64_t>(sg->outs_.size());
+    for (const auto &lt : sg->outs_)
+        save_lt(lt, writer);
+
+    writer.write<uint64_t>(values.size());
+    for (const auto *val : values) {
+        save_lt(val->get_logical_tensor(), writer);
+        writer.write<uint8_t>(val->is_internal());
+    }
+
+    writer.write<uint64_t>(ops.size());
+    for (const auto &op : ops) {
+        save_op_header(op.get(), writer, false);
+        std::vector<uint64_t> ins, outs;
+        for (const auto &in : op->get_input_values())
+            ins.emplace_back(value_idx.at(in.get()));
+        for (const auto &out : op->get_output_values())
+            outs.emplace_back(value_idx.at(out.get()));
+        writer.write_vector(ins);
+        writer.write_vector(outs);
+    }
+
+    // The consumers are stored in their original order, as the topological
+    // order of the ops depends on it.
+    for (const auto *val : values) {
+        // pairs of (op index, input offset)
+        std::vector<uint64_t> consumers;
+        for (const auto &c : val->get_consumers()) {
+            auto it = op_idx.find(&c.get_op());
+            if (it == op_idx.end()) continue;
+            consumers.emplace_back(it->second);
+            consumers.emplace_back(c.get_offset());
+        }
+        writer.write_vector(consumers);
+    }
+
+    // The fusion info keys are local to the manager, they are reassigned when
+    // loading.
+    std::vector<uint64_t> fused;
+    for (size_t i = 0; i < ops.size(); i++) {
+        if (ops[i]->has_attr(op_attr::fusion_info_key)
+                && ops[i]->get_attr<int64_t>(op_attr::fusion_info_key) != -1)
+            fused.emplace_back(i);
+    }
+    auto &mgr = sg->fusion_info_mgr_;
+    writer.write_vector(fused);
+    for (auto i : fused) {
+        const int64_t key
+                = ops[i]->get_attr<int64_t>(op_attr::fusion_info_key);
+        save_fusion_info(ops[i].get(), mgr.get_info(key), writer, false);
+    }
+    return status::success;
+}
+
+status_t load_subgraph(cache_blob_reader_t &reader,
+        const dnnl::engine &p_engine, std::shared_ptr<subgraph_t> &sg) {
+    int32_t fpmath = 0;
+    CHECK(reader.read(fpmath));
+
+    std::vector<logical_tensor_t> ins, outs;
+    for (auto *lts : {&ins, &outs}) {
+        uint64_t num = 0;
+        CHECK(reader.read(num));
+        if (num > reader.remaining()) return status::invalid_arguments;
+        lts->resize(static_cast<size_t>(num));
+        for (auto &lt : *lts)
+            CHECK(load_lt(reader, lt));
+    }
+
+    uint64_t num_values = 0;
+    CHECK(reader.read(num_values));
+    if (num_values > reader.remaining()) return status::invalid_arguments;
+    std::vector<std::shared_ptr<value_t>> values;
+    values.reserve(static_cast<size_t>(num_values));
+    for (uint64_t i = 0; i < num_values; i++) {
+        logical_tensor_t lt;
+        uint8_t internal = 0;
+        CHECK(load_lt(reader, lt));
+        CHECK(reader.read(internal));
+        values.emplace_back(std::make_shared<value_t>(lt, internal != 0));
+    }
+
+    uint64_t num_ops = 0;
+    CHECK(reader.read(num_ops));
+    if (num_ops > reader.remaining()) return status::invalid_arguments;
+    std::vector<op_ptr> ops;
+    ops.reserve(static_cast<size_t>(num_ops));
+    for (uint64_t i = 0; i < num_ops; i++) {
+        op_ptr op;
+        CHECK(load_op_header(reader, op));
+        std::vector<uint64_t> in_idx, out_idx;
+        CHECK(reader.read_vector(in_idx));
+        CHECK(reader.read_vector(out_idx));
+        for (auto idx : in_idx) {
+            if (idx >= values.size()) return status::invalid_arguments;
+            op->add_input(values[idx]);
+        }
+        for (auto idx : out_idx) {
+            if (idx >= values.size()) return status::invalid_arguments;
+            op->add_output(values[idx]);
+        }
+        ops.emplace_back(op);
+    }
+
+    for (auto &val : values) {
+        std::vector<uint64_t> consumers;
+        CHECK(reader.read_vector(consumers));
+        if (consumers.size() % 2) return status::invalid_arguments;
+        for (size_t i = 0; i < consumers.size(); i += 2) {
+            if (consumers[i] >= ops.size()
+                    || consumers[i + 1] >= ops[consumers[i]]->num_inputs())
+                return status::invalid_arguments;
+            val->add_consumer(*ops[consumers[i]], consumers[i + 1]);
+        }
+    }
+
+    sg = std::make_shared<subgraph_t>(
+            ops, p_engine, static_cast<fpmath_mode_t>(fpmath), false);
+    sg->ins_ = ins;
+    sg->outs_ = outs;
+
+    std::vector<uint64_t> fused;
+    CHECK(reader.read_vector(fused));
+    auto &mgr = sg->fusion_info_mgr_;
+    for (auto i : fused) {
+        if (i >= ops.size()) return status::invalid_arguments;
+        const int64_t key = mgr.init_info();
+        CHECK(load_fusion_info(reader, mgr.get_mutable_info(key)));
+        ops[i]->set_attr<int64_t>(op_attr::fusion_info_key, key);
+    }
+    return status::success;
+}
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,155 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_CACHE_BLOB_HPP
+#define GRAPH_BACKEND_DNNL_CACHE_BLOB_HPP
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "graph/interface/c_types_map.hpp"
+
+#include "graph/backend/dnnl/subgraph.hpp"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// Appends plain data to a cache blob
+class cache_blob_writer_t {
+public:
+    cache_blob_writer_t(std::vector<uint8_t> &blob) : blob_(blob) {}
+
+    void write_bytes(const void *data, size_t size) {
+        const uint8_t *ptr = static_cast<const uint8_t *>(data);
+        blob_.insert(blob_.end(), ptr, ptr + size);
+    }
+
+    template <typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be written");
+        write_bytes(&value, sizeof(T));
+    }
+
+    void write_string(const std::string &str) {
+        write<uint64_t>(str.size());
+        write_bytes(str.data(), str.size());
+    }
+
+    template <typename T>
+    void write_vector(const std::vector<T> &vec) {
+        write<uint64_t>(vec.size());
+        for (const auto &v : vec)
+            write<T>(v);
+    }
+
+private:
+    std::vector<uint8_t> &blob_;
+};
+
+// Reads plain data from a cache blob. Reading beyond the end of the blob
+// returns invalid_arguments.
+class cache_blob_reader_t {
+public:
+    cache_blob_reader_t(const std::vector<uint8_t> &blob)
+        : blob_(blob), pos_(0) {}
+
+    status_t read_bytes(void *data, size_t size) {
+        if (size > blob_.size() - pos_) return status::invalid_arguments;
+        if (size > 0) std::memcpy(data, blob_.data() + pos_, size);
+        pos_ += size;
+        return status::success;
+    }
+
+    template <typename T>
+    status_t read(T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be read");
+        return read_bytes(&value, sizeof(T));
+    }
+
+    status_t read_string(std::string &str) {
+        uint64_t size = 0;
+        CHECK(read(size));
+        if (size > blob_.size() - pos_) return status::invalid_arguments;
+        str.assign(reinterpret_cast<const char *>(blob_.data() + pos_),
+                static_cast<size_t>(size));
+        pos_ += static_cast<size_t>(size);
+        return status::success;
+    }
+
+    template <typename T>
+    status_t read_vector(std::vector<T> &vec) {
+        uint64_t size = 0;
+        CHECK(read(size));
+        if (size > (blob_.size() - pos_) / sizeof(T))
+            return status::invalid_arguments;
+        vec.resize(static_cast<size_t>(size));
+        for (auto &v : vec)
+            CHECK(read<T>(v));
+        return status::success;
+    }
+
+    size_t remaining() const { return blob_.size() - pos_; }
+
+private:
+    const std::vector<uint8_t> &blob_;
+    size_t pos_;
+};
+
+// Writes the identity of the library build and the engine. A cache blob can
+// only be loaded by the same build on an engine of the same kind and the same
+// cpu isa, as the memory descriptors are stored in their internal format and
+// the chosen layouts depend on the isa.
+void save_cache_blob_header(
+        cache_blob_writer_t &writer, const dnnl::engine &p_engine);
+
+// Returns unimplemented if the cache blob was written by another build or
+// for another engine
+status_t load_cache_blob_header(
+        cache_blob_reader_t &reader, const dnnl::engine &p_engine);
+
+// Writes the kind, the attributes, the logical tensors and the fusion
+// information of an op, without the ids. Two ops with the same signature
+// compute the same function of their inputs.
+void save_op_signature(const op_t *op, const fusion_info_mgr_t &mgr,
+        cache_blob_writer_t &writer);
+
+// Writes the ops, values, fusion information and the input and output logical
+// tensors of a transformed subgraph. Opaque layouts are stored as memory
+// descriptors, since their layout ids are only valid in this process.
+status_t save_subgraph(
+        const std::shared_ptr<subgraph_t> &sg, cache_blob_writer_t &writer);
+
+// Reconstructs a subgraph written by save_subgraph. The ops, their
+// connections and the order of the value consumers are restored, so the
+// memory planning of the loaded subgraph gives the same result.
+status_t load_subgraph(cache_blob_reader_t &reader,
+        const dnnl::engine &p_engine, std::shared_ptr<subgraph_t> &sg);
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
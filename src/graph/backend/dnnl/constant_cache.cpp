@@ -15,11 +15,28 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
 #include <unordered_map>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "graph/interface/backend.hpp"
+#include "graph/interface/logical_tensor.hpp"
 
 #include "graph/utils/utils.hpp"
 
+#include "graph/backend/dnnl/cache_blob.hpp"
 #include "graph/backend/dnnl/constant_cache.hpp"
+#include "graph/backend/dnnl/passes/memory_planning.hpp"
+#include "graph/backend/dnnl/subgraph.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -29,8 +46,10 @@ namespace dnnl_impl {
 using key_t = constant_cache_t::key_t;
 using value_t = constant_cache_t::value_t;
 
-std::unordered_map<key_t, constant_cache_t::timed_entry_t>
+std::unordered_map<key_t, constant_cache_t::timed_entry_t, key_t::hasher_t>
         constant_cache_t::constant_map_;
+std::unordered_map<key_t, size_t, key_t::hasher_t>
+        constant_cache_t::num_users_;
 impl::utils::rw_mutex_t constant_cache_t::rw_mutex_;
 
 static size_t get_timestamp() {
@@ -104,6 +123,273 @@ void constant_cache_t::remove_if_exist(const key_t &key) {
     }
 }
 
+value_t constant_cache_t::get_if_exist(const key_t &key) {
+    lock_read();
+    value_t value = get(key);
+    unlock_read();
+    return value;
+}
+
+void constant_cache_t::retain(const key_t &key) {
+    lock_write();
+    num_users_[key]++;
+    unlock_write();
+}
+
+void constant_cache_t::release(const key_t &key) {
+    lock_write();
+    auto it = num_users_.find(key);
+    if (it != num_users_.end() && --it->second == 0) {
+        num_users_.erase(it);
+        constant_map_.erase(key);
+    }
+    unlock_write();
+}
+
+size_t constant_cache_t::get_footprint() const {
+    impl::utils::lock_read_t lock_r(rw_mutex_);
+    size_t footprint = 0;
+    for (const auto &pair : constant_map_) {
+        const value_t &value = pair.second.value_;
+        if (value.wait_for(std::chrono::seconds(0))
+                != std::future_status::ready)
+            continue;
+        const cached_t &buffer = value.get();
+        if (buffer) footprint += buffer->size();
+    }
+    return footprint;
+}
+
+namespace {
+// FNV-1a over 8-byte words. The constant inputs are hashed only when the
+// key of a kernel is built, i.e. when their handles change.
+size_t hash_bytes(const void *data, size_t size) {
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const char *bytes = static_cast<const char *>(data);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(uint64_t));
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ static_cast<uint8_t>(bytes[i])) * prime;
+    }
+    return static_cast<size_t>(hash);
+}
+} // namespace
+
+void constant_key_t::init(const memory_planner_t &planner,
+        const std::shared_ptr<subgraph_t> &sg) {
+    std::vector<size_t> constant_inputs;
+    std::string fingerprint
+            = planner.get_persistent_fingerprint(sg, constant_inputs);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    fingerprint_ = std::move(fingerprint);
+    engine_ = reinterpret_cast<size_t>(sg->p_engine_->get());
+    constant_inputs_ = std::move(constant_inputs);
+    // the data of the inputs can only be read on the host for cpu engines
+    // with a native runtime
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+    hash_contents_ = sg->p_engine_->get_kind() == dnnl::engine::kind::cpu;
+#else
+    hash_contents_ = false;
+#endif
+}
+
+key_t constant_key_t::get(const std::vector<tensor_t> &inputs) {
+    std::vector<const void *> handles;
+    handles.reserve(constant_inputs_.size());
+    for (size_t idx : constant_inputs_)
+        handles.emplace_back(inputs[idx].get_data_handle());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_key_ && handles == handles_) return key_;
+
+    // fingerprint | engine | handles of the constant inputs | hashes of their
+    // contents. The hashes keep a kernel from picking up the buffer of
+    // another model whose inputs were at the same addresses. When the
+    // contents cannot be read on the host, the kernel itself is part of the
+    // key and its buffer is not shared.
+    std::vector<size_t> hashes;
+    if (hash_contents_) {
+        hashes.reserve(constant_inputs_.size());
+        for (size_t idx : constant_inputs_) {
+            const tensor_t &in = inputs[idx];
+            hashes.emplace_back(hash_bytes(in.get_data_handle(),
+                    logical_tensor_wrapper_t(in.get_logical_tensor()).size()));
+        }
+    }
+    std::string bytes = fingerprint_;
+    bytes.append(reinterpret_cast<const char *>(&engine_), sizeof(engine_));
+    bytes.append(reinterpret_cast<const char *>(handles.data()),
+            handles.size() * sizeof(const void *));
+    if (hash_contents_) {
+        bytes.append(reinterpret_cast<const char *>(hashes.data()),
+                hashes.size() * sizeof(size_t));
+    } else {
+        const constant_key_t *owner = this;
+        bytes.append(reinterpret_cast<const char *>(&owner), sizeof(owner));
+    }
+    key_t key(std::move(bytes));
+
+    constant_cache_t constant_cache;
+    constant_cache.retain(key);
+    if (has_key_) constant_cache.release(key_);
+    key_ = key;
+    handles_ = std::move(handles);
+    hashes_ = std::move(hashes);
+    has_key_ = true;
+    return key;
+}
+
+#ifdef __linux__
+namespace {
+// The data of a shared file starts at the first page boundary after the
+// header and the checksum, so it can be mapped directly
+size_t get_data_offset(size_t header_size) {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t size = header_size + sizeof(uint64_t);
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+// Maps the data of a shared file if the file holds the expected header and
+// the data matches its checksum. Any mismatch, e.g. a file written by
+// another build or a truncated or corrupted file, makes the caller prepare
+// the constant tensors itself.
+void *map_file(const std::string &path, const std::vector<uint8_t> &header,
+        size_t size) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    const size_t offset = get_data_offset(header.size());
+    std::vector<uint8_t> file_header(header.size());
+    uint64_t checksum = 0;
+    struct stat st;
+    bool ok = ::fstat(fd, &st) == 0
+            && static_cast<size_t>(st.st_size) == offset + size
+            && ::pread(fd, file_header.data(), header.size(), 0)
+                    == static_cast<ssize_t>(header.size())
+            && file_header == header
+            && ::pread(fd, &checksum, sizeof(checksum), header.size())
+                    == static_cast<ssize_t>(sizeof(checksum));
+    void *data = MAP_FAILED;
+    if (ok) {
+        data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd,
+                static_cast<off_t>(offset));
+    }
+    ::close(fd);
+    if (data == MAP_FAILED) return nullptr;
+
+    if (hash_bytes(data, size) != checksum) {
+        ::munmap(data, size);
+        return nullptr;
+    }
+    return data;
+}
+} // namespace
+#endif
+
+void unmap_constant_buffer(void *data, size_t size) {
+#ifdef __linux__
+    ::munmap(data, size);
+#else
+    UNUSED(data);
+    UNUSED(size);
+#endif
+}
+
+constant_cache_t::cached_t constant_key_t::make_buffer(
+        const std::vector<tensor_t> &inputs, size_t size,
+        const dnnl::engine &p_engine, const allocator_t *alc) const {
+#if defined(__linux__) && DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+    const std::string dir = get_constant_cache_dir();
+    if (!dir.empty() && size > 0
+            && p_engine.get_kind() == dnnl::engine::kind::cpu) {
+        // The header must be the same in all processes, so the data handles
+        // and the engine address are replaced by the hashes of the inputs,
+        // which were computed with the key of these inputs
+        std::vector<size_t> hashes;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            hashes = hashes_;
+        }
+        std::vector<uint8_t> header;
+        cache_blob_writer_t writer(header);
+        save_cache_blob_header(writer, p_engine);
+        writer.write_string(fingerprint_);
+        writer.write<uint64_t>(constant_inputs_.size());
+        for (size_t i = 0; i < constant_inputs_.size(); i++) {
+            const tensor_t &in = inputs[constant_inputs_[i]];
+            const size_t in_size
+                    = logical_tensor_wrapper_t(in.get_logical_tensor()).size();
+            writer.write<uint64_t>(in_size);
+            writer.write<uint64_t>(i < hashes.size()
+                            ? hashes[i]
+                            : hash_bytes(in.get_data_handle(), in_size));
+        }
+        writer.write<uint64_t>(size);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "/dnnl_graph_constant_%016zx.bin",
+                std::hash<std::string>()(
+                        std::string(header.begin(), header.end())));
+        const std::string path = dir + name;
+        void *mapped = map_file(path, header, size);
+        if (mapped) return std::make_shared<constant_buffer_t>(mapped, size);
+
+        auto buffer = std::make_shared<constant_buffer_t>(size, p_engine, alc);
+        buffer->set_shared_path(path, header);
+        return buffer;
+    }
+#endif
+    return std::make_shared<constant_buffer_t>(size, p_engine, alc);
+}
+
+void publish_constant_buffer(
+        dnnl::stream &p_stream, const constant_cache_t::cached_t &buffer) {
+#ifdef __linux__
+    if (!buffer || buffer->is_mapped() || buffer->get_shared_path().empty())
+        return;
+    p_stream.wait();
+
+    // Write a temporary file and rename it, so other processes never map a
+    // partially written buffer. Failures only disable the sharing.
+    const std::string &path = buffer->get_shared_path();
+    const std::string tmp_path
+            = path + "." + std::to_string(::getpid()) + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+    if (fd < 0) return;
+
+    std::vector<uint8_t> prefix = buffer->get_shared_header();
+    const size_t offset = get_data_offset(prefix.size());
+    cache_blob_writer_t writer(prefix);
+    writer.write<uint64_t>(hash_bytes(buffer->data<char>(), buffer->size()));
+    prefix.resize(offset, 0);
+
+    const auto write_all = [&](const void *ptr, size_t size) {
+        const char *bytes = static_cast<const char *>(ptr);
+        size_t written = 0;
+        while (written < size) {
+            ssize_t ret = ::write(fd, bytes + written, size - written);
+            if (ret <= 0) return false;
+            written += static_cast<size_t>(ret);
+        }
+        return true;
+    };
+    bool ok = write_all(prefix.data(), prefix.size())
+            && write_all(buffer->data<char>(), buffer->size());
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || ::rename(tmp_path.c_str(), path.c_str()) != 0)
+        ::unlink(tmp_path.c_str());
+#else
+    UNUSED(p_stream);
+    UNUSED(buffer);
+#endif
+}
+
 // Get the total size of all cached buffers
 size_t constant_cache_t::get_size() const {
     size_t total_size = 0;
@@ -22,11 +22,15 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "common/rw_mutex.hpp"
 
+#include "graph/interface/tensor.hpp"
+
 #include "graph/backend/dnnl/common.hpp"
 
 #include "oneapi/dnnl/dnnl.hpp"
@@ -36,6 +40,12 @@ namespace impl {
 namespace graph {
 namespace dnnl_impl {
 
+class memory_planner_t;
+class subgraph_t;
+
+// Unmaps a constant buffer shared by another process
+void unmap_constant_buffer(void *data, size_t size);
+
 struct constant_buffer_t {
     constant_buffer_t(
             size_t size, const dnnl::engine &p_engine, const allocator_t *alc)
@@ -45,7 +55,16 @@ struct constant_buffer_t {
         const_cast<allocator_t *>(alc)->retain();
     }
 
+    // Wraps a read-only mapping of a constant buffer stored by another
+    // process
+    constant_buffer_t(void *mapped, size_t size)
+        : data_(mapped), size_(size), alc_(nullptr), is_mapped_(true) {}
+
     ~constant_buffer_t() {
+        if (is_mapped_) {
+            unmap_constant_buffer(data_, size_);
+            return;
+        }
 #ifdef DNNL_WITH_SYCL
         dnnl_allocator_t::free(data_, p_engine_, alc_, {});
 #else
@@ -61,15 +80,64 @@ struct constant_buffer_t {
 
     size_t size() const { return size_; }
 
+    // True if the data is mapped from a file written by another process, so
+    // the constant tensors are ready and must not be written
+    bool is_mapped() const { return is_mapped_; }
+
+    // The file to store the buffer into once the constant tensors are
+    // prepared, and the header identifying its contents which is written
+    // before the data. The path is empty if the buffer is not shared.
+    const std::string &get_shared_path() const { return shared_path_; }
+    const std::vector<uint8_t> &get_shared_header() const {
+        return shared_header_;
+    }
+    void set_shared_path(
+            const std::string &path, const std::vector<uint8_t> &header) {
+        shared_path_ = path;
+        shared_header_ = header;
+    }
+
 private:
     void *data_;
     size_t size_;
     const dnnl::engine p_engine_;
     const allocator_t *alc_;
+    bool is_mapped_ = false;
+    std::string shared_path_;
+    std::vector<uint8_t> shared_header_;
+};
+
+// The full key of a cached constant buffer. The hash only selects the bucket:
+// two keys are equal only if their bytes are equal, so a hash collision never
+// returns the buffer of another computation. Copies share the bytes.
+class constant_cache_key_t {
+public:
+    constant_cache_key_t() = default;
+    explicit constant_cache_key_t(std::string bytes)
+        : bytes_(std::make_shared<const std::string>(std::move(bytes)))
+        , hash_(std::hash<std::string>()(*bytes_)) {}
+
+    bool operator==(const constant_cache_key_t &other) const {
+        if (bytes_ == other.bytes_) return true;
+        return hash_ == other.hash_ && bytes_ && other.bytes_
+                && *bytes_ == *other.bytes_;
+    }
+
+    size_t hash() const { return hash_; }
+
+    struct hasher_t {
+        size_t operator()(const constant_cache_key_t &key) const {
+            return key.hash();
+        }
+    };
+
+private:
+    std::shared_ptr<const std::string> bytes_;
+    size_t hash_ = 0;
 };
 
 struct constant_cache_t {
-    using key_t = size_t;
+    using key_t = constant_cache_key_t;
     using cached_t = std::shared_ptr<constant_buffer_t>;
     using value_t = std::shared_future<cached_t>;
 
@@ -79,6 +147,17 @@ struct constant_cache_t {
     size_t get_capacity() const;
     value_t get_or_add(const key_t &key, const value_t &value);
     void remove_if_exist(const key_t &key);
+    // Returns an invalid future if the key is not in the cache
+    value_t get_if_exist(const key_t &key);
+
+    // A key can be shared by several kernels. Each of them retains the key
+    // while using it, and the entry is removed once all of them released it.
+    void retain(const key_t &key);
+    void release(const key_t &key);
+
+    // Returns the total size of the cached buffers in bytes. The buffers
+    // still being computed are not counted.
+    size_t get_footprint() const;
 
 private:
     void evict(size_t n) const;
@@ -105,11 +184,92 @@ private:
     // NOTE: pairs that contain atomics cannot be stored in an unordered_map *as
     // an element*, since it invokes the copy constructor of std::atomic, which
     // is deleted.
-    static std::unordered_map<key_t, timed_entry_t> constant_map_;
+    static std::unordered_map<key_t, timed_entry_t, key_t::hasher_t>
+            constant_map_;
+    static std::unordered_map<key_t, size_t, key_t::hasher_t> num_users_;
     static impl::utils::rw_mutex_t rw_mutex_;
     size_t capacity_ = std::numeric_limits<size_t>::max();
 };
 
+// Stores the prepared constant buffer into the file given by
+// constant_buffer_t::get_shared_path, so other processes can map it. The file
+// holds the header of the buffer, a checksum of the data, padding to the page
+// size and the data. Waits for the stream, as the constant tensors must be
+// computed. Does nothing if the buffer is not shared.
+void publish_constant_buffer(
+        dnnl::stream &p_stream, const constant_cache_t::cached_t &buffer);
+
+// The key of the constant buffer of a kernel. It combines the fingerprint of
+// the constant computation (see memory_planner_t::get_persistent_fingerprint)
+// with the engine, the data handles of the constant inputs and a hash of
+// their contents, so the kernels which prepare the same constant tensors from
+// the same inputs share one cached buffer. The whole key is stored in the
+// cache and compared on lookup. A kernel retains one key at a time: executing
+// with other constant inputs releases the previous key.
+//
+// The key is built, and the inputs hashed, only when their handles change.
+// The hash keeps another model whose constant inputs reuse the same addresses
+// from getting the buffer of the old data. The user must still keep the
+// memory of a constant input unchanged while a kernel using it is alive (see
+// dnnl_graph_set_constant_tensor_cache). On engines whose memory cannot be
+// read on the host, the key includes the kernel instead of the hashes, so
+// the buffer is never shared.
+class constant_key_t {
+public:
+    constant_key_t() = default;
+    ~constant_key_t() {
+        if (!has_key_) return;
+        constant_cache_t constant_cache;
+        constant_cache.release(key_);
+    }
+
+    // Computes the fingerprint of the constant ops of a compiled subgraph.
+    // The fingerprint also includes the engine, so the kernels on different
+    // engines never share a buffer.
+    void init(const memory_planner_t &planner,
+            const std::shared_ptr<subgraph_t> &sg);
+
+    // Returns the key for the given inputs of the kernel. The key is built
+    // again, hashing the contents of the constant inputs, only when their
+    // handles change.
+    constant_cache_t::key_t get(const std::vector<tensor_t> &inputs);
+
+    // Creates the constant buffer for the given inputs of the kernel. If the
+    // constant tensors are shared with other processes (see
+    // dnnl_graph_set_constant_tensor_cache_dir), the shared buffer is
+    // identified by a header made of the cache blob header (library build,
+    // engine kind and isa), the full fingerprint, the sizes and content
+    // hashes of the constant inputs and the buffer size. The file stored by
+    // another process is named after the hash of this header, and it is
+    // mapped only if it holds the same header and its data matches the
+    // stored checksum.
+    constant_cache_t::cached_t make_buffer(const std::vector<tensor_t> &inputs,
+            size_t size, const dnnl::engine &p_engine,
+            const allocator_t *alc) const;
+
+    // Returns false if the kernel has not been executed yet
+    bool get_last(constant_cache_t::key_t &key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        key = key_;
+        return has_key_;
+    }
+
+private:
+    constant_key_t(const constant_key_t &) = delete;
+    constant_key_t &operator=(const constant_key_t &) = delete;
+
+    std::string fingerprint_;
+    size_t engine_ = 0;
+    std::vector<size_t> constant_inputs_;
+    bool hash_contents_ = false;
+
+    bool has_key_ = false;
+    std::vector<const void *> handles_;
+    std::vector<size_t> hashes_;
+    constant_cache_t::key_t key_;
+    mutable std::mutex mutex_;
+};
+
 } // namespace dnnl_impl
 } // namespace graph
 } // namespace impl
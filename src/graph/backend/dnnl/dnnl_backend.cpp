@@ -18,6 +18,7 @@
 
 #include "graph/utils/compatible.hpp"
 
+#include "graph/backend/dnnl/constant_cache.hpp"
 #include "graph/backend/dnnl/dnnl_backend.hpp"
 #include "graph/backend/dnnl/dnnl_opset.hpp"
 #include "graph/backend/dnnl/kernels/kernels.hpp"
@@ -36,6 +37,11 @@ bool dnnl_layout_id_manager_t::is_mem_desc_equal(
     return md1 == md2;
 }
 
+size_t dnnl_backend::get_constant_cache_footprint() const {
+    constant_cache_t constant_cache;
+    return constant_cache.get_footprint();
+}
+
 dnnl_backend::dnnl_backend(const std::string &name, float priority)
     : backend(name, priority) {
     register_op_schemas();
@@ -64,6 +70,10 @@ bool dnnl_backend::register_passes() {
     DNNL_BACKEND_REGISTER_PATTERN_CALL(interpolate_fusion, pass_registry_);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(softmax_fusion, pass_registry_);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(layernorm_fusion, pass_registry_);
+    DNNL_BACKEND_REGISTER_PATTERN_CALL(groupnorm_fusion, pass_registry_);
+    DNNL_BACKEND_REGISTER_PATTERN_CALL(embedding_bag_fusion, pass_registry_);
+    DNNL_BACKEND_REGISTER_PATTERN_CALL(select_fusion, pass_registry_);
+    DNNL_BACKEND_REGISTER_PATTERN_CALL(gather_fusion, pass_registry_);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(sum_fusion, pass_registry_);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(reorder_fusion, pass_registry_);
     DNNL_BACKEND_REGISTER_PATTERN_CALL(shuffle_fusion, pass_registry_);
@@ -101,6 +111,10 @@ kernel_ptr large_partition_kernel_creator() {
     return std::make_shared<larger_partition_kernel_t>();
 }
 
+kernel_ptr dynamic_shape_kernel_creator(FCreateKernel kernel_creator) {
+    return std::make_shared<dynamic_shape_kernel_t>(std::move(kernel_creator));
+}
+
 } // namespace dnnl_impl
 
 // This function should be called by backend_registry_t
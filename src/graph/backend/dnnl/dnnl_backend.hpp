@@ -205,6 +205,43 @@ struct kernel_base_t {
         return prepare_inplace_pairs_impl();
     }
 
+    // Restores a kernel from a cache blob given by get_cache_blob. The
+    // inputs and outputs are filled with the compiled logical tensors, in the
+    // order given to the original compilation.
+    status_t compile_from_cache_blob(const dnnl_partition_impl_t *part,
+            const engine_t *aengine, const std::vector<uint8_t> &cache_blob,
+            std::vector<logical_tensor_t> &inputs,
+            std::vector<logical_tensor_t> &outputs) {
+        auto ret = load_cache_blob_impl(
+                part, aengine, cache_blob, inputs, outputs);
+        if (ret != status::success) return ret;
+        return prepare_inplace_pairs_impl();
+    }
+
+    virtual status_t get_cache_blob(std::vector<uint8_t> &cache_blob) const {
+        UNUSED(cache_blob);
+        return status::unimplemented;
+    }
+
+    // Makes the next compile keep what compile_with_shapes needs to reuse
+    // the transformed subgraph of this kernel.
+    virtual void enable_shape_reuse() {}
+
+    // Compiles the kernel for other input and output shapes from the
+    // subgraph transformed by `ref`, a kernel of the same type compiled for
+    // the same partition after enable_shape_reuse. Only the shape dependent
+    // passes run again. Fails if the subgraph of `ref` cannot be reused, the
+    // kernel has then to be compiled from the partition.
+    status_t compile_with_shapes(const kernel_base_t *ref,
+            const dnnl_partition_impl_t *part, const engine_t *aengine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) {
+        auto ret = compile_with_shapes_impl(
+                ref, part, aengine, inputs, outputs);
+        if (ret != status::success) return ret;
+        return prepare_inplace_pairs_impl();
+    }
+
     status_t execute(const stream_t *astream,
             const std::vector<tensor_t> &inputs,
             const std::vector<tensor_t> &outputs) {
@@ -240,6 +277,30 @@ struct kernel_base_t {
             const std::vector<tensor_t> &outputs)
             = 0;
 
+    virtual status_t load_cache_blob_impl(const dnnl_partition_impl_t *part,
+            const engine_t *aengine, const std::vector<uint8_t> &cache_blob,
+            std::vector<logical_tensor_t> &inputs,
+            std::vector<logical_tensor_t> &outputs) {
+        UNUSED(part);
+        UNUSED(aengine);
+        UNUSED(cache_blob);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        return status::unimplemented;
+    }
+
+    virtual status_t compile_with_shapes_impl(const kernel_base_t *ref,
+            const dnnl_partition_impl_t *part, const engine_t *aengine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) {
+        UNUSED(ref);
+        UNUSED(part);
+        UNUSED(aengine);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        return status::unimplemented;
+    }
+
     virtual status_t prepare_inplace_pairs_impl() { return status::success; };
 
     std::vector<inplace_pair_t> inplace_pairs_;
@@ -250,6 +311,10 @@ using FCreateKernel = std::function<kernel_ptr(void)>;
 
 kernel_ptr large_partition_kernel_creator();
 
+// Wraps a kernel creator for partitions compiled with unknown input dims. The
+// wrapped kernels are compiled per set of concrete shapes at execution.
+kernel_ptr dynamic_shape_kernel_creator(FCreateKernel kernel_creator);
+
 class dnnl_backend : public backend {
     friend class dnnl_partition_impl_t;
 
@@ -276,6 +341,8 @@ public:
     bool compare_logical_tensor(const logical_tensor_t &lhs,
             const logical_tensor_t &rhs) const override;
 
+    size_t get_constant_cache_footprint() const override;
+
     status_t get_partitions(
             graph_t &agraph, partition_policy_t policy) override {
         // Note: This environment variable is internal and for test purpose. It
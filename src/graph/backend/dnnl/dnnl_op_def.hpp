@@ -40,6 +40,16 @@ namespace dnnl_impl {
             "op is constant", \
             false, attribute_kind::b, false)
 
+#define SET_LAYOUT_ASSIGNMENT_ATTRS \
+    set_attr(op_attr::use_plain_layout, \
+            "set by layout assignment to create the primitive with plain " \
+            "src and dst instead of any", \
+            false, attribute_kind::b, false) \
+            .set_attr(op_attr::layout_plan, \
+                    "the layout chosen by layout assignment and the " \
+                    "estimated costs, only for graph dump", \
+                    false, attribute_kind::s, std::string())
+
 #define SET_EXECUTABLE_CREATOR(func) \
     set_additional_item<executable_creator_func>("executable_creator", {func})
 
@@ -320,6 +330,7 @@ DNNL_GRAPH_OP_SCHEMA(dnnl_convolution, 1,
                         "directly mapped to DNNL primitive",
                         false, attribute_kind::b, false)
                 .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                .SET_LAYOUT_ASSIGNMENT_ATTRS
                 // Analysis rules
                 .set_shape_inference_function(infer_dnnl_conv_output_shape)
                 .SET_LAYOUT_PROPAGATOR(layout_propagator_for_conv)
@@ -359,6 +370,7 @@ DNNL_GRAPH_OP_SCHEMA(dnnl_convtranspose, 1,
                         "directly mapped to DNNL primitive",
                         false, attribute_kind::b, false)
                 .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                .SET_LAYOUT_ASSIGNMENT_ATTRS
                 // Analysis rules
                 .set_shape_inference_function(
                         infer_dnnl_convtranspose_output_shape)
@@ -1268,6 +1280,7 @@ DNNL_GRAPH_OP_SCHEMA(dnnl_matmul, 1,
                         "directly mapped to DNNL primitive",
                         false, attribute_kind::b, false)
                 .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                .SET_LAYOUT_ASSIGNMENT_ATTRS
                 .set_attr(op_attr::keep_dst_layout,
                         "if true, defined dst layout will be used to create "
                         "primitive instead of any",
@@ -1374,6 +1387,261 @@ DNNL_GRAPH_OP_SCHEMA(dnnl_layernorm, 1,
                         executable_creator<layernorm_executable_t>)
                 .SET_ARG_INDICES_GETTER(layernorm_executable_t))
 
+DNNL_GRAPH_OP_SCHEMA(dnnl_groupnorm, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::variadic)
+                .set_num_inputs(std::set<size_t>({1, 32}))
+                .set_outputs_option(op_schema_t::param_num_option::optional)
+                .set_num_outputs(std::set<size_t>({2, 4}))
+                .set_input(0, "input", "input tensor")
+                .set_input(1, "gamma",
+                        "(optional) gamma scaling for normalized value")
+                .set_input(2, "beta",
+                        "(optional) bias added to the scaled normalized value")
+                .set_output(0, "output", "output tensor")
+                .set_output(1, "mean",
+                        "(optional) the mean calculated for every group")
+                .set_output(2, "variance",
+                        "(optional) the variance calculated for every group")
+                .set_output(3, "scratchpad",
+                        "scratchpad tensor, which is a temporary output and "
+                        "not connected to any other ops")
+                // Attributes inherited from GroupNorm
+                .set_attr(op_attr::groups,
+                        "the number of groups the channels are split into",
+                        true, attribute_kind::i)
+                .set_attr(op_attr::keep_stats,
+                        "used to indicate whether to output mean and variance",
+                        false, attribute_kind::b, true)
+                .set_attr(op_attr::use_affine,
+                        "when set to True, this module has learnable "
+                        "per-channel affine parameters",
+                        false, attribute_kind::b, true)
+                .set_attr(op_attr::epsilon,
+                        "constant to improve numerical stability", false,
+                        attribute_kind::f, 1e-5f)
+                .set_attr(op_attr::data_format,
+                        "the data format of input / output, the options are "
+                        "NCX and NXC",
+                        false, attribute_kind::s, "NXC")
+                .set_attr(op_attr::fusion_info_key,
+                        "fusion information (such as zps, post-ops, ...) "
+                        "generated by fusion passes.",
+                        false, attribute_kind::i, (int64_t)-1)
+                // New added attributes
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_groupnorm_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_groupnorm)
+                .SET_EXECUTABLE_CREATOR(
+                        executable_creator<groupnorm_executable_t>)
+                .SET_ARG_INDICES_GETTER(groupnorm_executable_t))
+
+DNNL_GRAPH_OP_SCHEMA(dnnl_embedding_bag, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::optional)
+                .set_num_inputs(std::set<size_t>({3, 4}))
+                .set_num_outputs(2)
+                .set_input(0, "table", "2D embedding table")
+                .set_input(1, "indices", "indices of the rows to pool")
+                .set_input(2, "offsets", "first index of every bag")
+                .set_input(3, "per_sample_weights",
+                        "(optional) one weight for every index")
+                .set_output(0, "output", "pooled rows, one for every bag")
+                .set_output(1, "scratchpad",
+                        "scratchpad tensor, which is a temporary output and "
+                        "not connected to any other ops")
+                // Attributes inherited from EmbeddingBag
+                .set_attr(op_attr::mode,
+                        "specifies how the rows of a bag are pooled, the "
+                        "options are sum, mean and max",
+                        false, attribute_kind::s, "sum")
+                // New added attributes
+                .set_attr(op_attr::fusion_info_key,
+                        "fusion information (such as zps, post-ops, ...) "
+                        "generated by fusion passes.",
+                        false, attribute_kind::i, (int64_t)-1)
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_embedding_bag_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_embedding_bag)
+                .SET_EXECUTABLE_CREATOR(
+                        executable_creator<embedding_bag_executable_t>)
+                .SET_ARG_INDICES_GETTER(embedding_bag_executable_t))
+
+DNNL_GRAPH_OP_SCHEMA(dnnl_gather, 1,
+        op_schema_t()
+                .set_num_inputs(2)
+                .set_num_outputs(2)
+                .set_input(0, "data", "input tensor")
+                .set_input(1, "indices", "indices of the slices to gather")
+                .set_output(0, "output", "output tensor")
+                .set_output(1, "scratchpad",
+                        "scratchpad tensor, which is a temporary output and "
+                        "not connected to any other ops")
+                // Attributes inherited from Gather
+                .set_attr(op_attr::axis, "the axis of data to gather along",
+                        false, attribute_kind::i, int64_t(0))
+                // New added attributes
+                .set_attr(op_attr::fusion_info_key,
+                        "fusion information (such as zps, post-ops, ...) "
+                        "generated by fusion passes.",
+                        false, attribute_kind::i, (int64_t)-1)
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_gather_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_gather)
+                .SET_EXECUTABLE_CREATOR(executable_creator<gather_executable_t>)
+                .SET_ARG_INDICES_GETTER(gather_executable_t))
+
+DNNL_GRAPH_OP_SCHEMA(dnnl_sdpa, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::variadic)
+                .set_num_inputs(std::set<size_t>({3, 6}))
+                .set_num_outputs(2)
+                .set_input(0, "query", "query tensor")
+                .set_input(1, "key", "key tensor")
+                .set_input(2, "value", "value tensor")
+                .set_input(3, "scale", "scale tensor with one element")
+                .set_input(4, "mask",
+                        "attention mask tensor, or the u8 condition of a "
+                        "select mask")
+                .set_input(5, "fill",
+                        "tensor with one element which replaces the masked "
+                        "scores of a select mask")
+                .set_output(0, "output", "output tensor")
+                .set_output(1, "scratchpad",
+                        "scratchpad tensor, which is a temporary output and "
+                        "not connected to any other ops")
+                // No corresponding frontend op
+                // Attributes
+                .set_attr(op_attr::transpose_b,
+                        "the key tensor is given in [B, H, Sk, D] instead "
+                        "of [B, H, D, Sk]",
+                        false, attribute_kind::b, false)
+                .set_attr(op_attr::with_scale,
+                        "specifying if the op has a scale input", false,
+                        attribute_kind::b, false)
+                .set_attr(op_attr::with_mask,
+                        "specifying if the op has a mask input", false,
+                        attribute_kind::b, false)
+                .set_attr(op_attr::with_select,
+                        "specifying if the mask is the condition of a "
+                        "select instead of being added to the scores",
+                        false, attribute_kind::b, false)
+                .set_attr(op_attr::select_scores_in_else,
+                        "specifying if the scores are kept where the "
+                        "condition is false instead of true",
+                        false, attribute_kind::b, false)
+                .set_attr(op_attr::alg_kind,
+                        "specifies if the scores are multiplied or divided "
+                        "by the scale",
+                        false, attribute_kind::i,
+                        static_cast<int64_t>(dnnl::algorithm::binary_mul))
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_dnnl_sdpa_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_sdpa)
+                .SET_EXECUTABLE_CREATOR(executable_creator<sdpa_executable_t>)
+                .SET_ARG_INDICES_GETTER(sdpa_executable_t))
+
+DNNL_GRAPH_OP_SCHEMA(dnnl_masked_softmax, 1,
+        op_schema_t()
+                .set_num_inputs(3)
+                .set_num_outputs(2)
+                .set_input(0, "input", "input tensor")
+                .set_input(1, "cond",
+                        "u8 condition tensor, which is broadcast to the input")
+                .set_input(2, "fill",
+                        "tensor with one element which replaces the masked "
+                        "elements")
+                .set_output(0, "output", "output tensor")
+                .set_output(1, "scratchpad",
+                        "scratchpad tensor, which is a temporary output and "
+                        "not connected to any other ops")
+                // No corresponding frontend op
+                // Attributes
+                .set_attr(op_attr::select_scores_in_else,
+                        "specifying if the input is kept where the condition "
+                        "is false instead of true",
+                        false, attribute_kind::b, false)
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_identity_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_masked_softmax)
+                .SET_EXECUTABLE_CREATOR(
+                        executable_creator<masked_softmax_executable_t>)
+                .SET_ARG_INDICES_GETTER(masked_softmax_executable_t))
+
+// The inputs are given in the order src, weight, [weight_up], weight_down,
+// [bias, [bias_up], bias_down], where the up inputs only exist for gated mlp.
+DNNL_GRAPH_OP_SCHEMA(dnnl_mlp, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::variadic)
+                .set_num_inputs(std::set<size_t>({3, 7}))
+                .set_num_outputs(2)
+                .set_input(0, "src", "input tensor")
+                .set_input(1, "weight", "weight of the activated matmul")
+                .set_input(2, "weight_up",
+                        "weight of the gating matmul, only for gated mlp")
+                .set_input(3, "weight_down", "weight of the output matmul")
+                .set_input(4, "bias", "bias of the activated matmul")
+                .set_input(5, "bias_up", "bias of the gating matmul")
+                .set_input(6, "bias_down", "bias of the output matmul")
+                .set_output(0, "output", "output tensor")
+                .set_output(1, "scratchpad",
+                        "scratchpad tensor, which is a temporary output and "
+                        "not connected to any other ops")
+                // No corresponding frontend op
+                // Attributes
+                .set_attr(op_attr::alg_kind,
+                        "specifies the activation, can be one of "
+                        "gelu_erf/gelu_tanh/swish",
+                        true, attribute_kind::i)
+                .set_attr(op_attr::alpha, "alpha of the swish activation",
+                        false, attribute_kind::f, 1.f)
+                .set_attr(op_attr::is_gated,
+                        "specifying if the activation is multiplied by a "
+                        "gating matmul",
+                        false, attribute_kind::b, false)
+                .set_attr(op_attr::with_bias,
+                        "specifying if the matmuls have bias inputs", false,
+                        attribute_kind::b, false)
+                .set_attr(op_attr::transpose_b,
+                        "the weights are given in [N, K] instead of [K, N]",
+                        false, attribute_kind::b, false)
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_dnnl_mlp_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_mlp)
+                .SET_EXECUTABLE_CREATOR(executable_creator<mlp_executable_t>)
+                .SET_ARG_INDICES_GETTER(mlp_executable_t))
+
+DNNL_GRAPH_OP_SCHEMA(dnnl_slice, 1,
+        op_schema_t()
+                .set_num_inputs(1)
+                .set_num_outputs(1)
+                .set_input(0, "input", "input tensor")
+                .set_output(0, "output",
+                        "a view of the input covering [slice_offset, "
+                        "slice_offset + slice_size) along axis")
+                // No corresponding frontend op
+                // Attributes
+                .set_attr(op_attr::axis, "the sliced dimension", false,
+                        attribute_kind::i, (int64_t)-1)
+                .set_attr(op_attr::slice_offset,
+                        "the start of the slice along axis", true,
+                        attribute_kind::i)
+                .set_attr(op_attr::slice_size,
+                        "the size of the slice along axis", true,
+                        attribute_kind::i)
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_dnnl_slice_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_slice)
+                .SET_EXECUTABLE_CREATOR(executable_creator<memory_slicer_t>)
+                .SET_ARG_INDICES_GETTER(memory_slicer_t))
+
 DNNL_GRAPH_OP_SCHEMA(dnnl_reorder, 1,
         op_schema_t()
                 .set_inputs_option(op_schema_t::param_num_option::variadic)
@@ -17,6 +17,7 @@
 #ifndef GRAPH_BACKEND_DNNL_DNNL_PARTITION_IMPL_HPP
 #define GRAPH_BACKEND_DNNL_DNNL_PARTITION_IMPL_HPP
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -87,6 +88,10 @@ public:
     }
 #endif
 
+    status_t get_cache_blob(std::vector<uint8_t> &cache_blob) const override {
+        return kernel_->get_cache_blob(cache_blob);
+    }
+
 private:
     kernel_ptr kernel_;
 };
@@ -190,15 +195,40 @@ public:
             kernel_creator = large_partition_kernel_creator;
         }
 
-        kernel_ptr kernel = kernel_creator();
+        // Inputs with unknown dims defer the compilation of the kernel to
+        // execution, where the tensors provide the concrete shapes. Such
+        // partitions use the large partition kernel, which can reuse its
+        // transformed subgraph across shapes.
+        const bool is_dynamic = std::any_of(inputs.begin(), inputs.end(),
+                [](const logical_tensor_t &lt) {
+                    return logical_tensor_wrapper_t(lt).is_shape_unknown();
+                });
+
+        kernel_ptr kernel = is_dynamic
+                ? dynamic_shape_kernel_creator(large_partition_kernel_creator)
+                : kernel_creator();
         if (!kernel) return status::unimplemented;
 
+        // Output shapes of a dynamic kernel depend on the input shapes and
+        // are known only at execution. The outputs are always dense, so an
+        // `any` layout becomes strided with unknown strides.
+        std::vector<logical_tensor_t> compiled_outputs = outputs;
+        if (is_dynamic) {
+            for (auto &out : compiled_outputs) {
+                if (!logical_tensor_wrapper_t(out).is_any()) continue;
+                out.layout_type = layout_type::strided;
+                std::fill(out.layout.strides,
+                        out.layout.strides + DNNL_MAX_NDIMS,
+                        DNNL_GRAPH_UNKNOWN_DIM);
+            }
+        }
+
         status_t ret;
 
         // compile kernel.
         // FIXME(qun) will modify the outputs inside the compile, which
         // break the constant semantics
-        ret = kernel->compile(part.get(), g_engine, inputs, outputs);
+        ret = kernel->compile(part.get(), g_engine, inputs, compiled_outputs);
         if (ret != status::success) return ret;
 
         std::vector<logical_tensor_t> ordered_inputs;
@@ -206,7 +236,8 @@ public:
         ret = get_ordered_inputs_outputs(inputs_, inputs, ordered_inputs);
         if (status::success != ret) return ret;
 
-        ret = get_ordered_inputs_outputs(outputs_, outputs, ordered_outputs);
+        ret = get_ordered_inputs_outputs(
+                outputs_, compiled_outputs, ordered_outputs);
         if (status::success != ret) return ret;
 
         // wrapper kernel to dnnl_compiled_partition_impl_t
@@ -217,6 +248,36 @@ public:
         return status::success;
     }
 
+    status_t compile_from_cache_blob(compiled_partition_t *compiled_partition,
+            const std::vector<uint8_t> &cache_blob,
+            const engine_t *g_engine) const override {
+        auto part = std::dynamic_pointer_cast<dnnl_partition_impl_t>(
+                this->clone());
+
+        // Only the large partition kernel writes cache blobs
+        kernel_ptr kernel = large_partition_kernel_creator();
+        if (!kernel) return status::unimplemented;
+
+        std::vector<logical_tensor_t> inputs, outputs;
+        status_t ret = kernel->compile_from_cache_blob(
+                part.get(), g_engine, cache_blob, inputs, outputs);
+        if (ret != status::success) return ret;
+
+        std::vector<logical_tensor_t> ordered_inputs;
+        std::vector<logical_tensor_t> ordered_outputs;
+        ret = get_ordered_inputs_outputs(inputs_, inputs, ordered_inputs);
+        if (status::success != ret) return ret;
+
+        ret = get_ordered_inputs_outputs(outputs_, outputs, ordered_outputs);
+        if (status::success != ret) return ret;
+
+        auto pimpl = std::make_shared<dnnl_compiled_partition_impl_t>(
+                *g_engine, ordered_inputs, ordered_outputs, kernel);
+        compiled_partition->init(pimpl);
+
+        return status::success;
+    }
+
     status_t infer_shape(std::vector<const logical_tensor_t *> &inputs,
             std::vector<logical_tensor_t *> &outputs) const override {
         UNUSED(inputs);
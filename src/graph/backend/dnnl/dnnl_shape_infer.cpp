@@ -369,6 +369,121 @@ status_t infer_bn_folding_output_shape(op_t *n,
     return status::success;
 }
 
+status_t infer_dnnl_sdpa_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto out0 = logical_tensor_wrapper_t(outputs[0]);
+    auto q = logical_tensor_wrapper_t(inputs[0]);
+    auto k = logical_tensor_wrapper_t(inputs[1]);
+    auto v = logical_tensor_wrapper_t(inputs[2]);
+
+    // q: [B, H, Sq, D], k: [B, H, D, Sk] (or [B, H, Sk, D] if transposed),
+    // v: [B, H, Sk, Dv]
+    if (q.ndims() != 4 || k.ndims() != 4 || v.ndims() != 4)
+        return status::invalid_shape;
+    const bool transpose_b = n->has_attr(op_attr::transpose_b)
+            && n->get_attr<bool>(op_attr::transpose_b);
+    const auto q_dims = q.vdims();
+    const auto k_dims = k.vdims();
+    const auto v_dims = v.vdims();
+    const dim_t k_d = transpose_b ? k_dims[3] : k_dims[2];
+    const dim_t k_s = transpose_b ? k_dims[2] : k_dims[3];
+    for (size_t i = 0; i < 2; i++) {
+        if (q_dims[i] != k_dims[i] || q_dims[i] != v_dims[i])
+            return status::invalid_shape;
+    }
+    if (q_dims[3] != k_d || k_s != v_dims[2]) return status::invalid_shape;
+
+    auto inferred_out_shape = q_dims;
+    inferred_out_shape[3] = v_dims[3];
+
+    // check if partial set shape aligns with inferred shape
+    if (out0.ndims() != -1) {
+        if (!validate(inferred_out_shape, out0.vdims())) {
+            return status::invalid_shape;
+        }
+    }
+
+    set_shape_and_strides(*outputs[0], inferred_out_shape);
+    return status::success;
+}
+
+status_t infer_dnnl_mlp_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto out0 = logical_tensor_wrapper_t(outputs[0]);
+    auto src = logical_tensor_wrapper_t(inputs[0]);
+
+    const bool is_gated = n->get_attr<bool>(op_attr::is_gated);
+    const bool transpose_b = n->get_attr<bool>(op_attr::transpose_b);
+    const size_t num_weights = is_gated ? 3 : 2;
+
+    // src: [..., K], weights: [K, N1] and [N1, N2] (or [N1, K] and [N2, N1]
+    // if transposed), biases: [N1] and [N2]
+    if (src.ndims() < 2) return status::invalid_shape;
+    dims w_dims[3];
+    for (size_t i = 0; i < num_weights; i++) {
+        auto w = logical_tensor_wrapper_t(inputs[1 + i]);
+        if (w.ndims() != 2) return status::invalid_shape;
+        w_dims[i] = w.vdims();
+        if (transpose_b) std::swap(w_dims[i][0], w_dims[i][1]);
+    }
+    const dims &w_down_dims = w_dims[num_weights - 1];
+    const auto src_dims = src.vdims();
+    if (src_dims.back() != w_dims[0][0] || w_dims[0][1] != w_down_dims[0])
+        return status::invalid_shape;
+    if (is_gated && w_dims[1] != w_dims[0]) return status::invalid_shape;
+
+    if (n->get_attr<bool>(op_attr::with_bias)) {
+        for (size_t i = 0; i < num_weights; i++) {
+            auto b = logical_tensor_wrapper_t(inputs[1 + num_weights + i]);
+            if (b.nelems() != w_dims[i][1]) return status::invalid_shape;
+        }
+    }
+
+    auto inferred_out_shape = src_dims;
+    inferred_out_shape.back() = w_down_dims[1];
+
+    // check if partial set shape aligns with inferred shape
+    if (out0.ndims() != -1) {
+        if (!validate(inferred_out_shape, out0.vdims())) {
+            return status::invalid_shape;
+        }
+    }
+
+    set_shape_and_strides(*outputs[0], inferred_out_shape);
+    return status::success;
+}
+
+status_t infer_dnnl_slice_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto out0 = logical_tensor_wrapper_t(outputs[0]);
+    auto in0 = logical_tensor_wrapper_t(inputs[0]);
+
+    const int64_t ndims = in0.ndims();
+    int64_t axis = n->get_attr<int64_t>(op_attr::axis);
+    if (axis < 0) axis += ndims;
+    if (axis < 0 || axis >= ndims) return status::invalid_shape;
+
+    const int64_t offset = n->get_attr<int64_t>(op_attr::slice_offset);
+    const int64_t size = n->get_attr<int64_t>(op_attr::slice_size);
+    auto inferred_out_shape = in0.vdims();
+    if (offset < 0 || size <= 0 || offset + size > inferred_out_shape[axis])
+        return status::invalid_shape;
+    inferred_out_shape[axis] = size;
+
+    // check if partial set shape aligns with inferred shape
+    if (out0.ndims() != -1) {
+        if (!validate(inferred_out_shape, out0.vdims())) {
+            return status::invalid_shape;
+        }
+    }
+
+    set_shape_and_strides(*outputs[0], inferred_out_shape);
+    return status::success;
+}
+
 status_t infer_dnnl_conv_bwd_data_output_shape(op_t *n,
         std::vector<logical_tensor_t *> &inputs,
         std::vector<logical_tensor_t *> &outputs) {
@@ -45,13 +45,22 @@ const op_attr_t with_runtime_dst_zps = 0x1000c;
 const op_attr_t is_bias_add = 0x1000d;
 const op_attr_t with_sum = 0x1000e;
 const op_attr_t keep_dst_layout = 0x1000f;
+const op_attr_t with_scale = 0x10010;
+const op_attr_t with_mask = 0x10011;
+const op_attr_t is_gated = 0x10012;
+const op_attr_t use_plain_layout = 0x10013;
+const op_attr_t with_select = 0x10014;
+const op_attr_t select_scores_in_else = 0x10015;
 
 // int64_t
 const op_attr_t alg_kind = 0x10100;
 const op_attr_t fusion_info_key = 0x10103;
+const op_attr_t slice_offset = 0x10104;
+const op_attr_t slice_size = 0x10105;
 
 // string
 const op_attr_t dw_type = 0x10201;
+const op_attr_t layout_plan = 0x10202;
 const op_attr_t kind = 0x10204;
 
 // float
@@ -82,9 +91,18 @@ static inline std::string internal_attr2str(op_attr_t attr) {
         CASE(is_bias_add);
         CASE(with_sum);
         CASE(keep_dst_layout);
+        CASE(with_scale);
+        CASE(with_mask);
+        CASE(is_gated);
+        CASE(use_plain_layout);
+        CASE(with_select);
+        CASE(select_scores_in_else);
         CASE(alg_kind);
         CASE(fusion_info_key);
+        CASE(slice_offset);
+        CASE(slice_size);
         CASE(dw_type);
+        CASE(layout_plan);
         CASE(kind);
         CASE(p);
         CASE(dst_zps);
@@ -76,7 +76,14 @@ namespace op_kind {
     X(dnnl_layernorm, Dnnl_layernorm) \
     X(dnnl_reorder, Dnnl_reorder) \
     X(dnnl_convtranspose_bwd_data, Dnnl_convtranspose_bwd_data) \
-    X(dnnl_convtranspose_bwd_weights, Dnnl_convtranspose_bwd_weights)
+    X(dnnl_convtranspose_bwd_weights, Dnnl_convtranspose_bwd_weights) \
+    X(dnnl_groupnorm, Dnnl_groupnorm) \
+    X(dnnl_embedding_bag, Dnnl_embedding_bag) \
+    X(dnnl_gather, Dnnl_gather) \
+    X(dnnl_sdpa, Dnnl_sdpa) \
+    X(dnnl_masked_softmax, Dnnl_masked_softmax) \
+    X(dnnl_mlp, Dnnl_mlp) \
+    X(dnnl_slice, Dnnl_slice)
 
 enum kind_t {
     kDNNL_INTERNAL_OP_STARTER = 0x1234,
@@ -0,0 +1,224 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_DYNAMIC_SHAPE_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_DYNAMIC_SHAPE_HPP
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "graph/interface/backend.hpp"
+#include "graph/interface/logical_tensor.hpp"
+#include "graph/interface/tensor.hpp"
+
+#include "graph/backend/dnnl/dnnl_partition_impl.hpp"
+#include "graph/utils/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// A kernel for partitions compiled with unknown input dimensions. The
+// compilation only records the partition and the kernel creator, the real
+// kernel is compiled at execution once the tensors provide concrete shapes.
+// The compiled kernels are kept per set of concrete shapes (a bucket), so
+// executing with a shape seen before reuses its primitives, memory plan and
+// constant buffers and costs only a lookup. A new bucket reuses the subgraph
+// transformed for the first one where the kernel supports it, and only runs
+// the shape inference, layout propagation, memory planning and primitive
+// creation again.
+class dynamic_shape_kernel_t : public kernel_base_t {
+public:
+    using key_t = std::vector<dim_t>;
+
+    dynamic_shape_kernel_t(FCreateKernel kernel_creator)
+        : kernel_creator_(std::move(kernel_creator)) {
+        // Note: This environment variable is internal and for test/debug
+        // purpose. It can be changed or removed without prior notice.
+        capacity_ = static_cast<size_t>(std::max(1,
+                graph::utils::getenv_int_internal(
+                        "DYNAMIC_SHAPE_CACHE_CAPACITY", 16)));
+    }
+
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override {
+        using ltw = logical_tensor_wrapper_t;
+        for (const auto &in : inputs) {
+            if (ltw(in).is_empty() || ltw(in).is_opaque())
+                return status::unimplemented;
+        }
+        // The outputs are always dense, the partition turns an `any` layout
+        // into strided with unknown strides before compiling this kernel.
+        for (const auto &out : outputs) {
+            if (!ltw(out).is_strided()) return status::unimplemented;
+        }
+
+        part_ = part->clone();
+        g_engine_ = g_engine;
+        return status::success;
+    }
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override {
+        kernel_ptr kernel;
+        CHECK(get_or_compile(inputs, outputs, kernel));
+        return kernel->execute(g_stream, inputs, outputs);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    status_t sycl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override {
+        kernel_ptr kernel;
+        CHECK(get_or_compile(inputs, outputs, kernel));
+        return kernel->execute_sycl(
+                g_stream, inputs, outputs, sycl_deps, sycl_event);
+    }
+#endif
+
+    // Returns the number of shape buckets with a compiled kernel.
+    size_t get_num_compiled_shapes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return kernels_.size();
+    }
+
+private:
+    struct entry_t {
+        kernel_ptr kernel;
+        size_t last_use;
+    };
+
+    // The key includes dims and strides of all tensors. Data types and
+    // property types are fixed by the compilation.
+    static status_t make_key(const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs, key_t &key) {
+        using ltw = logical_tensor_wrapper_t;
+        key.clear();
+        for (const auto *tensors : {&inputs, &outputs}) {
+            for (const auto &t : *tensors) {
+                const auto &lt = t.get_logical_tensor();
+                if (ltw(lt).is_shape_unknown() || !ltw(lt).is_strided()
+                        || ltw(lt).is_stride_unknown())
+                    return status::invalid_arguments;
+                key.push_back(lt.ndims);
+                key.insert(key.end(), lt.dims, lt.dims + lt.ndims);
+                key.insert(key.end(), lt.layout.strides,
+                        lt.layout.strides + lt.ndims);
+            }
+        }
+        return status::success;
+    }
+
+    // Looks the kernel up, or compiles it outside of the lock so that other
+    // shapes can execute meanwhile. If two threads compile the same bucket,
+    // the first kernel inserted is kept.
+    status_t get_or_compile(const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs, kernel_ptr &kernel) {
+        key_t key;
+        CHECK(make_key(inputs, outputs, key));
+
+        kernel_ptr ref;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (find(key, kernel)) return status::success;
+            ref = ref_kernel_;
+        }
+
+        kernel_ptr new_kernel;
+        CHECK(compile(ref, inputs, outputs, new_kernel));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (find(key, kernel)) return status::success;
+        if (!ref_kernel_) ref_kernel_ = new_kernel;
+        if (kernels_.size() >= capacity_) {
+            auto lru = std::min_element(kernels_.begin(), kernels_.end(),
+                    [](const std::pair<const key_t, entry_t> &a,
+                            const std::pair<const key_t, entry_t> &b) {
+                        return a.second.last_use < b.second.last_use;
+                    });
+            kernels_.erase(lru);
+        }
+        kernels_.emplace(key, entry_t {new_kernel, ++use_count_});
+        kernel = new_kernel;
+        return status::success;
+    }
+
+    bool find(const key_t &key, kernel_ptr &kernel) {
+        auto it = kernels_.find(key);
+        if (it == kernels_.end()) return false;
+        it->second.last_use = ++use_count_;
+        kernel = it->second.kernel;
+        return true;
+    }
+
+    status_t compile(const kernel_ptr &ref,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs, kernel_ptr &kernel) const {
+        // The passes modify the partition, so every bucket compiles its own
+        // copy.
+        auto part = std::dynamic_pointer_cast<dnnl_partition_impl_t>(
+                part_->clone());
+        std::vector<logical_tensor_t> ins, outs;
+        for (const auto &t : inputs)
+            ins.emplace_back(t.get_logical_tensor());
+        for (const auto &t : outputs)
+            outs.emplace_back(t.get_logical_tensor());
+
+        if (ref) {
+            kernel = kernel_creator_();
+            if (kernel
+                    && kernel->compile_with_shapes(
+                               ref.get(), part.get(), g_engine_, ins, outs)
+                            == status::success)
+                return status::success;
+        }
+
+        kernel = kernel_creator_();
+        if (!kernel) return status::unimplemented;
+        kernel->enable_shape_reuse();
+        return kernel->compile(part.get(), g_engine_, ins, outs);
+    }
+
+    FCreateKernel kernel_creator_;
+    std::shared_ptr<partition_impl_t> part_;
+    const engine_t *g_engine_ = nullptr;
+
+    // The first compiled kernel. Its transformed subgraph is reused by the
+    // next buckets, so it is kept even when evicted from kernels_.
+    kernel_ptr ref_kernel_;
+
+    size_t capacity_;
+    size_t use_count_ = 0;
+    std::map<key_t, entry_t> kernels_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
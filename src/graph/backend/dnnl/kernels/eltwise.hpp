@@ -52,8 +52,7 @@ private:
 
     std::function<std::shared_ptr<execution_args_set_t>()> resource_ctor_;
 
-    constant_cache_t::key_t constant_key_
-            = reinterpret_cast<constant_cache_t::key_t>(this);
+    constant_key_t constant_key_;
 
     bool enable_constant_cache_ = is_constant_cache_enabled();
 
@@ -61,11 +60,6 @@ public:
     ~eltwise_fwd_t() override {
         thread_local_cache_t<execution_args_set_t> res_cache;
         res_cache.remove_if_exist(reinterpret_cast<size_t>(this));
-
-        if (enable_constant_cache_) {
-            constant_cache_t constant_cache;
-            constant_cache.remove_if_exist(constant_key_);
-        }
     }
 
     status_t prepare_inplace_pairs_impl() override {
@@ -122,6 +116,7 @@ public:
 
         // Run the added passes
         BACKEND_DNNL_CHECK(pipeline.run(subgraph_));
+        constant_key_.init(memory_planner_, subgraph_);
 
         // fill information for outputs logical tensors
         for (size_t i = 0; i < outputs.size(); i++) {
@@ -183,7 +178,7 @@ public:
             constant_cache_t global_constant_cache;
             constant_cache_t::value_t cached_value
                     = global_constant_cache.get_or_add(
-                            constant_key_, c_promise.get_future());
+                            constant_key_.get(inputs), c_promise.get_future());
             bool is_from_cache = cached_value.valid();
             if (is_from_cache) {
                 const constant_cache_t::cached_t &c_buffer = cached_value.get();
@@ -197,7 +192,7 @@ public:
                 }
             } else {
                 constant_cache_t::cached_t c_buffer
-                        = std::make_shared<constant_buffer_t>(
+                        = constant_key_.make_buffer(inputs,
                                 memory_planner_
                                         .total_internal_persistent_size(),
                                 p_engine_, g_alloc_);
@@ -210,10 +205,13 @@ public:
                             c_grantor.get(mem_offkey.second));
                 }
 
-                for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-                    if (!subgraph_->is_constant_[i]) continue;
-                    subgraph_->execs_[i]->execute(
-                            p_stream, res->get_exec_args()[i]);
+                if (!c_buffer->is_mapped()) {
+                    for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
+                        if (!subgraph_->is_constant_[i]) continue;
+                        subgraph_->execs_[i]->execute(
+                                p_stream, res->get_exec_args()[i]);
+                    }
+                    publish_constant_buffer(p_stream, c_buffer);
                 }
 
                 c_promise.set_value(c_buffer);
@@ -257,7 +255,7 @@ public:
             constant_cache_t global_constant_cache;
             constant_cache_t::value_t cached_value
                     = global_constant_cache.get_or_add(
-                            constant_key_, c_promise.get_future());
+                            constant_key_.get(inputs), c_promise.get_future());
             bool is_from_cache = cached_value.valid();
             if (is_from_cache) {
                 const constant_cache_t::cached_t &c_buffer = cached_value.get();
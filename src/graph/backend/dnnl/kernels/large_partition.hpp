@@ -26,9 +26,12 @@
 #include <utility>
 #include <vector>
 
+#include "common/dnnl_thread.hpp"
+
 #include "graph/interface/backend.hpp"
 #include "graph/interface/graph.hpp"
 
+#include "graph/backend/dnnl/cache_blob.hpp"
 #include "graph/backend/dnnl/common.hpp"
 #include "graph/backend/dnnl/constant_cache.hpp"
 #include "graph/backend/dnnl/dnnl_partition_impl.hpp"
@@ -61,12 +64,32 @@ protected:
 
     std::function<std::shared_ptr<execution_args_set_t>()> resource_ctor_;
 
-    // FIXME(qun) improve the cache key
-    constant_cache_t::key_t constant_key_
-            = reinterpret_cast<constant_cache_t::key_t>(this);
+    constant_key_t constant_key_;
+    // The constant buffer restored from a cache blob, used once by the first
+    // execution instead of running the constant ops
+    constant_cache_t::cached_t loaded_constants_;
 
     bool enable_constant_cache_ = is_constant_cache_enabled();
 
+    // If enabled, the ops are executed level by level (see get_op_levels) and
+    // the independent ops of a level run concurrently, each on its own thread,
+    // when the level has at least as many ops as there are threads. This
+    // helps graphs with wide branches of small ops. Note: This
+    // environment variable is internal and for test/debug purpose. It can be
+    // changed or removed without prior notice.
+    bool enable_level_execution_
+            = graph::utils::getenv_int_internal("GRAPH_LEVEL_EXECUTION", 0)
+            > 0;
+    // The indices of the executables grouped by level, for the constant and
+    // the non-constant ops. Empty if the ops are executed one by one.
+    std::vector<std::vector<size_t>> const_exec_levels_;
+    std::vector<std::vector<size_t>> exec_levels_;
+
+    // The subgraph after the shape independent passes, kept for
+    // compile_with_shapes if enable_shape_reuse was called
+    bool keep_lowered_subgraph_ = false;
+    std::shared_ptr<const std::vector<uint8_t>> lowered_subgraph_;
+
     std::once_flag once_flag_;
     subgraph_visualizer_t vis_;
     pass_pipeline_t pipeline_;
@@ -75,11 +98,6 @@ public:
     ~larger_partition_kernel_t() override {
         thread_local_cache_t<execution_args_set_t> res_cache;
         res_cache.remove_if_exist(reinterpret_cast<size_t>(this));
-
-        if (enable_constant_cache_) {
-            constant_cache_t constant_cache;
-            constant_cache.remove_if_exist(constant_key_);
-        }
     }
 
     static void setup_pipeline_stage1(pass_pipeline_t &pipeline) {
@@ -91,6 +109,9 @@ public:
         BACKEND_DNNL_ADD_PASS(pipeline, fuse_mul_sigmoid_to_swish);
         BACKEND_DNNL_ADD_PASS(pipeline, fuse_to_dnnl_sum);
         BACKEND_DNNL_ADD_PASS(pipeline, fuse_to_shuffle);
+        BACKEND_DNNL_ADD_PASS(pipeline, fuse_to_sdpa);
+        BACKEND_DNNL_ADD_PASS(pipeline, fuse_to_masked_softmax);
+        BACKEND_DNNL_ADD_PASS(pipeline, fuse_to_mlp);
 
         // TODO(xx) The implementation of these two passes relay on a non-fully
         // lowered subgraph. We need to improve them.
@@ -146,6 +167,7 @@ public:
         BACKEND_DNNL_ADD_PASS(pipeline, convert_runtime_zero_points);
         BACKEND_DNNL_ADD_PASS(pipeline, fuse_dynamic_mul_scales_add_zps);
         BACKEND_DNNL_ADD_PASS(pipeline, fuse_dynamic_sub_zps_mul_scales);
+        BACKEND_DNNL_ADD_PASS(pipeline, fuse_sibling_matmuls);
 
         BACKEND_DNNL_ADD_PASS(pipeline, insert_u8_to_s8_for_matmul);
         BACKEND_DNNL_ADD_PASS(pipeline, insert_permute_for_matmul);
@@ -175,6 +197,14 @@ public:
         pipeline.reset_visualize_arg(true, false);
         BACKEND_DNNL_ADD_PASS(pipeline, infer_shape);
         BACKEND_DNNL_ADD_PASS(pipeline, fuse_dst_transpose_to_matmul);
+        // Note: This environment variable is internal and for test/debug
+        // purpose. It can be changed or removed without prior notice.
+        static const bool enable_layout_assignment
+                = graph::utils::getenv_int_internal(
+                          "GRAPH_LAYOUT_ASSIGNMENT", 0)
+                > 0;
+        if (enable_layout_assignment)
+            BACKEND_DNNL_ADD_PASS(pipeline, layout_assignment);
         BACKEND_DNNL_ADD_PASS(pipeline, layout_propagation);
         BACKEND_DNNL_ADD_PASS(pipeline, common_reorder_elimination);
         BACKEND_DNNL_ADD_PASS(pipeline, fuse_adjacent_reorders);
@@ -192,10 +222,12 @@ public:
         BACKEND_DNNL_ADD_PASS(pipeline, compile_ops);
     }
 
-    static void setup_pipeline(pass_pipeline_t &pipeline,
-            memory_planner_t &mem_planner, bool enable_constant_cache) {
-        setup_pipeline_stage1(pipeline);
-        setup_pipeline_stage2(pipeline, mem_planner, enable_constant_cache);
+    status_t save_lowered_subgraph(const std::shared_ptr<subgraph_t> &sg) {
+        auto blob = std::make_shared<std::vector<uint8_t>>();
+        cache_blob_writer_t writer(*blob);
+        CHECK(save_subgraph(sg, writer));
+        lowered_subgraph_ = blob;
+        return status::success;
     }
 
     status_t compile_impl(const dnnl_partition_impl_t *part,
@@ -212,6 +244,10 @@ public:
         BACKEND_DNNL_CHECK(
                 set_given_inputs_outputs(subgraph_, inputs, outputs));
 
+        const bool level_execution = enable_level_execution_
+                && p_engine_.get_kind() == dnnl::engine::kind::cpu;
+        memory_planner_.set_level_execution(level_execution);
+
         // Populate the transform passes into the pipeline
         std::call_once(once_flag_, [&, this]() {
             vis_ = subgraph_visualizer_t(
@@ -219,11 +255,22 @@ public:
                         return this->memory_planner_.get_memory_info(val);
                     });
             pipeline_ = pass_pipeline_t(vis_);
-            setup_pipeline(pipeline_, memory_planner_, enable_constant_cache_);
+            setup_pipeline_stage1(pipeline_);
+            if (keep_lowered_subgraph_) {
+                auto save_lowered = [this](std::shared_ptr<subgraph_t> &sg) {
+                    return this->save_lowered_subgraph(sg);
+                };
+                BACKEND_DNNL_ADD_PASS(pipeline_, save_lowered);
+            }
+            setup_pipeline_stage2(
+                    pipeline_, memory_planner_, enable_constant_cache_);
         });
 
         // Run the added passes
         BACKEND_DNNL_CHECK(pipeline_.run(subgraph_));
+        constant_key_.init(memory_planner_, subgraph_);
+
+        init_exec_levels(level_execution);
 
         // fill information for inputs logical tensors
         for (size_t i = 0; i < inputs.size(); i++) {
@@ -244,6 +291,206 @@ public:
         return status::success;
     }
 
+    void enable_shape_reuse() override { keep_lowered_subgraph_ = true; }
+
+    // The lowering and fusion passes only depend on the ranks of the inputs
+    // and on which dims are broadcast, so their result is reused for inputs
+    // that agree with the reference on both. A pass that baked a dim of the
+    // reference into the subgraph makes the shape inference or the
+    // primitive creation fail, and the caller then compiles from scratch.
+    status_t compile_with_shapes_impl(const kernel_base_t *ref,
+            const dnnl_partition_impl_t *part, const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override {
+        const auto *ref_kernel
+                = dynamic_cast<const larger_partition_kernel_t *>(ref);
+        if (!ref_kernel || !ref_kernel->lowered_subgraph_
+                || ref_kernel->subgraph_->ins_.size() != inputs.size())
+            return status::unimplemented;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            const auto &ref_in = ref_kernel->subgraph_->ins_[i];
+            if (ref_in.id != inputs[i].id || ref_in.ndims != inputs[i].ndims)
+                return status::unimplemented;
+            for (int d = 0; d < ref_in.ndims; d++) {
+                if ((ref_in.dims[d] == 1) != (inputs[i].dims[d] == 1))
+                    return status::unimplemented;
+            }
+        }
+
+        p_engine_ = make_dnnl_engine(*g_engine);
+        g_alloc_ = reinterpret_cast<graph::allocator_t *>(
+                g_engine->get_allocator());
+        enable_constant_cache_ = ref_kernel->enable_constant_cache_;
+        keep_lowered_subgraph_ = true;
+        lowered_subgraph_ = ref_kernel->lowered_subgraph_;
+
+        cache_blob_reader_t reader(*lowered_subgraph_);
+        CHECK(load_subgraph(reader, p_engine_, subgraph_));
+
+        // The values keep the shapes and layouts of the reference. The
+        // partition inputs and outputs are given, the others are inferred
+        // again.
+        for (const auto &op : subgraph_->get_ops()) {
+            for (const auto &val : op->get_output_values()) {
+                auto lt = val->get_logical_tensor();
+                if (lt.ndims > 0)
+                    std::fill(lt.dims, lt.dims + lt.ndims,
+                            DNNL_GRAPH_UNKNOWN_DIM);
+                lt.layout_type = layout_type::any;
+                val->set_logical_tensor(lt);
+            }
+        }
+        BACKEND_DNNL_CHECK(
+                set_given_inputs_outputs(subgraph_, inputs, outputs));
+
+        const bool level_execution = enable_level_execution_
+                && p_engine_.get_kind() == dnnl::engine::kind::cpu;
+        memory_planner_.set_level_execution(level_execution);
+
+        std::call_once(once_flag_, [&, this]() {
+            vis_ = subgraph_visualizer_t(
+                    part->id(), [this](const value_t *val) {
+                        return this->memory_planner_.get_memory_info(val);
+                    });
+            pipeline_ = pass_pipeline_t(vis_);
+            setup_pipeline_stage2(
+                    pipeline_, memory_planner_, enable_constant_cache_);
+        });
+        BACKEND_DNNL_CHECK(pipeline_.run(subgraph_));
+        constant_key_.init(memory_planner_, subgraph_);
+        init_exec_levels(level_execution);
+
+        resource_ctor_ = [this]() {
+            return this->memory_planner_.get_exec_args_set().clone();
+        };
+
+        return status::success;
+    }
+
+    // Groups the compiled executables by level for the level by level
+    // execution
+    void init_exec_levels(bool level_execution) {
+        const_exec_levels_.clear();
+        exec_levels_.clear();
+        if (!level_execution) return;
+
+        for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
+            auto &levels = subgraph_->is_constant_[i] ? const_exec_levels_
+                                                      : exec_levels_;
+            const size_t level = subgraph_->exec_levels_[i];
+            if (levels.size() <= level) levels.resize(level + 1);
+            levels[level].push_back(i);
+        }
+        for (auto *levels : {&const_exec_levels_, &exec_levels_}) {
+            levels->erase(std::remove_if(levels->begin(), levels->end(),
+                                  [](const std::vector<size_t> &level) {
+                                      return level.empty();
+                                  }),
+                    levels->end());
+        }
+    }
+
+    // The cache blob holds the transformed subgraph and, if the partition
+    // has been executed with the constant cache, the constant tensors. The
+    // primitives are created again when loading.
+    status_t get_cache_blob(std::vector<uint8_t> &cache_blob) const override {
+        cache_blob.clear();
+        cache_blob_writer_t writer(cache_blob);
+        save_cache_blob_header(writer, p_engine_);
+        writer.write<uint8_t>(enable_constant_cache_);
+        CHECK(save_subgraph(subgraph_, writer));
+
+        // Only the constant buffers in host memory can be copied
+        constant_cache_t::cached_t c_buffer;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+        if (enable_constant_cache_
+                && p_engine_.get_kind() == dnnl::engine::kind::cpu) {
+            constant_cache_t global_constant_cache;
+            constant_cache_t::key_t key;
+            if (constant_key_.get_last(key)) {
+                constant_cache_t::value_t cached_value
+                        = global_constant_cache.get_if_exist(key);
+                if (cached_value.valid()) c_buffer = cached_value.get();
+            }
+        }
+#endif
+        if (c_buffer) {
+            writer.write<uint64_t>(c_buffer->size());
+            writer.write_bytes(c_buffer->data<char>(), c_buffer->size());
+        } else {
+            writer.write<uint64_t>(0);
+        }
+        return status::success;
+    }
+
+    status_t load_cache_blob_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine, const std::vector<uint8_t> &cache_blob,
+            std::vector<logical_tensor_t> &inputs,
+            std::vector<logical_tensor_t> &outputs) override {
+        p_engine_ = make_dnnl_engine(*g_engine);
+        g_alloc_ = reinterpret_cast<graph::allocator_t *>(
+                g_engine->get_allocator());
+
+        cache_blob_reader_t reader(cache_blob);
+        CHECK(load_cache_blob_header(reader, p_engine_));
+        uint8_t enable_constant_cache = 0;
+        CHECK(reader.read(enable_constant_cache));
+        enable_constant_cache_ = enable_constant_cache != 0;
+        CHECK(load_subgraph(reader, p_engine_, subgraph_));
+
+        const bool level_execution = enable_level_execution_
+                && p_engine_.get_kind() == dnnl::engine::kind::cpu;
+        memory_planner_.set_level_execution(level_execution);
+
+        // The subgraph is already transformed, so only the memory planning
+        // and the primitive creation are run
+        std::call_once(once_flag_, [&, this]() {
+            vis_ = subgraph_visualizer_t(
+                    part->id(), [this](const value_t *val) {
+                        return this->memory_planner_.get_memory_info(val);
+                    });
+            pipeline_ = pass_pipeline_t(vis_);
+            auto memory_plan = [this](std::shared_ptr<subgraph_t> &sg) {
+                return this->memory_planner_.run(sg);
+            };
+            pipeline_.reset_visualize_arg(true, true);
+            BACKEND_DNNL_ADD_PASS(pipeline_, memory_plan);
+            BACKEND_DNNL_ADD_PASS(pipeline_, compile_ops);
+        });
+        BACKEND_DNNL_CHECK(pipeline_.run(subgraph_));
+        constant_key_.init(memory_planner_, subgraph_);
+        init_exec_levels(level_execution);
+
+        uint64_t constant_size = 0;
+        CHECK(reader.read(constant_size));
+        if (constant_size > 0) {
+            if (!enable_constant_cache_
+                    || p_engine_.get_kind() != dnnl::engine::kind::cpu
+                    || constant_size
+                            != memory_planner_.total_internal_persistent_size())
+                return status::invalid_arguments;
+
+            constant_cache_t::cached_t c_buffer
+                    = std::make_shared<constant_buffer_t>(
+                            static_cast<size_t>(constant_size), p_engine_,
+                            g_alloc_);
+            CHECK(reader.read_bytes(c_buffer->data<char>(), c_buffer->size()));
+            // The key depends on the data handles of the inputs, so the
+            // buffer is added to the cache at the first execution
+            loaded_constants_ = c_buffer;
+        }
+        if (reader.remaining() != 0) return status::invalid_arguments;
+
+        inputs = subgraph_->ins_;
+        outputs = subgraph_->outs_;
+
+        resource_ctor_ = [this]() {
+            return this->memory_planner_.get_exec_args_set().clone();
+        };
+
+        return status::success;
+    }
+
     status_t prepare_inplace_pairs_impl() override {
         inplace_pairs_ = memory_planner_.get_subgraph_inplace_pairs();
         return status::success;
@@ -295,7 +542,7 @@ public:
             constant_cache_t global_constant_cache;
             constant_cache_t::value_t cached_value
                     = global_constant_cache.get_or_add(
-                            constant_key_, c_promise.get_future());
+                            constant_key_.get(inputs), c_promise.get_future());
             bool is_from_cache = cached_value.valid();
             if (is_from_cache) {
                 const constant_cache_t::cached_t &c_buffer = cached_value.get();
@@ -308,11 +555,14 @@ public:
                             c_grantor.get(mem_offkey.second));
                 }
             } else {
-                constant_cache_t::cached_t c_buffer
-                        = std::make_shared<constant_buffer_t>(
-                                memory_planner_
-                                        .total_internal_persistent_size(),
-                                p_engine_, g_alloc_);
+                constant_cache_t::cached_t c_buffer = std::atomic_exchange(
+                        &loaded_constants_, constant_cache_t::cached_t());
+                const bool is_loaded = c_buffer != nullptr;
+                if (!is_loaded) {
+                    c_buffer = constant_key_.make_buffer(inputs,
+                            memory_planner_.total_internal_persistent_size(),
+                            p_engine_, g_alloc_);
+                }
                 grantor_t c_grantor
                         = memory_planner_.internal_persistent_grantor(
                                 c_buffer->data<char>());
@@ -322,24 +572,54 @@ public:
                             c_grantor.get(mem_offkey.second));
                 }
 
-                for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-                    if (!subgraph_->is_constant_[i]) continue;
-                    subgraph_->execs_[i]->execute(
-                            p_stream, res->get_exec_args()[i]);
+                if (!is_loaded && !c_buffer->is_mapped()) {
+                    execute_ops(p_stream, res, true);
+                    publish_constant_buffer(p_stream, c_buffer);
                 }
 
                 c_promise.set_value(c_buffer);
             }
         }
 
-        for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-            if (subgraph_->is_constant_[i]) continue;
-            subgraph_->execs_[i]->execute(p_stream, res->get_exec_args()[i]);
-        }
+        execute_ops(p_stream, res, false);
 
         return status::success;
     }
 
+    // Executes the constant or the non-constant ops of the subgraph
+    void execute_ops(const dnnl::stream &p_stream,
+            const execution_args_set_t *res, bool is_constant) const {
+        const auto &levels = is_constant ? const_exec_levels_ : exec_levels_;
+        if (levels.empty()) {
+            for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
+                if (subgraph_->is_constant_[i] != is_constant) continue;
+                subgraph_->execs_[i]->execute(
+                        p_stream, res->get_exec_args()[i]);
+            }
+            return;
+        }
+
+        const int max_nthr = dnnl_get_max_threads();
+        for (const auto &level : levels) {
+            // An op runs with a single thread inside the parallel region, as
+            // primitives do not nest parallelism. A level with fewer ops than
+            // threads would leave threads idle, so its ops run one by one,
+            // each with all the threads.
+            if (static_cast<int>(level.size()) < max_nthr) {
+                for (const size_t i : level)
+                    subgraph_->execs_[i]->execute(
+                            p_stream, res->get_exec_args()[i]);
+                continue;
+            }
+            dnnl::impl::parallel(max_nthr, [&](const int ithr, const int nthr) {
+                for (size_t i = ithr; i < level.size(); i += nthr) {
+                    subgraph_->execs_[level[i]]->execute(
+                            p_stream, res->get_exec_args()[level[i]]);
+                }
+            });
+        }
+    }
+
 #ifdef DNNL_WITH_SYCL
     status_t sycl_execute_impl(const stream_t *g_stream,
             const std::vector<tensor_t> &inputs,
@@ -368,7 +648,7 @@ public:
             constant_cache_t global_constant_cache;
             constant_cache_t::value_t cached_value
                     = global_constant_cache.get_or_add(
-                            constant_key_, c_promise.get_future());
+                            constant_key_.get(inputs), c_promise.get_future());
             bool is_from_cache = cached_value.valid();
             if (is_from_cache) {
                 const constant_cache_t::cached_t &c_buffer = cached_value.get();
@@ -381,11 +661,14 @@ public:
                             c_grantor.get(mem_offkey.second));
                 }
             } else {
-                constant_cache_t::cached_t c_buffer
-                        = std::make_shared<constant_buffer_t>(
-                                memory_planner_
-                                        .total_internal_persistent_size(),
-                                p_engine_, g_alloc_);
+                constant_cache_t::cached_t c_buffer = std::atomic_exchange(
+                        &loaded_constants_, constant_cache_t::cached_t());
+                const bool is_loaded = c_buffer != nullptr;
+                if (!is_loaded) {
+                    c_buffer = std::make_shared<constant_buffer_t>(
+                            memory_planner_.total_internal_persistent_size(),
+                            p_engine_, g_alloc_);
+                }
                 grantor_t c_grantor
                         = memory_planner_.internal_persistent_grantor(
                                 c_buffer->data<char>());
@@ -396,7 +679,7 @@ public:
                 }
 
                 for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-                    if (!subgraph_->is_constant_[i]) continue;
+                    if (!subgraph_->is_constant_[i] || is_loaded) continue;
                     returned_event = subgraph_->execs_[i]->execute_sycl(
                             p_stream, res->get_exec_args()[i], deps);
                     deps = {returned_event};
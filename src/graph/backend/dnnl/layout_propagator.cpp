@@ -746,6 +746,237 @@ status_t layout_propagator_for_layernorm(op_ptr &op,
     return status;
 }
 
+status_t layout_propagator_for_groupnorm(op_ptr &op,
+        const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+        pd_cache_t &pd_cache, subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd
+            = groupnorm_executable_t::create_desc(op, p_engine, mgr, pd_cache);
+
+    insert_reorder_after(
+            op, 0, pd.dst_desc(), p_engine, mgr, pd_cache, rewriter);
+    value_ptr dst = op->get_output_value(0);
+    status = fill_layout_info(dst, pd.dst_desc());
+    if (status != status::success) return status;
+
+    if (op->num_outputs() > 2) {
+        // keep_stats is true
+        value_ptr mean = op->get_output_value(1);
+        value_ptr variance = op->get_output_value(2);
+        status = fill_layout_info(mean, pd.mean_desc());
+        if (status != status::success) return status;
+        status = fill_layout_info(variance, pd.variance_desc());
+        if (status != status::success) return status;
+    }
+
+    // scratchpad is groupnorm's last output
+    value_ptr scratchpad_val = op->get_output_values().back();
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
+status_t layout_propagator_for_sdpa(op_ptr &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache,
+        subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd
+            = sdpa_executable_t::create_desc(op, p_engine, mgr, pd_cache);
+
+    // sdpa addresses its inputs and output through strides, so strided
+    // tensors are used as they are and only the others are made plain.
+    for (size_t i = 0; i < op->num_inputs(); i++) {
+        value_ptr in = op->get_input_value(i);
+        const auto &lt = in->get_logical_tensor();
+        if (ltw(lt).is_strided()) continue;
+        const memory::desc plain_desc
+                = to_ncx_format(make_dnnl_memory_desc(lt));
+        insert_reorder_before(
+                op, i, plain_desc, p_engine, mgr, pd_cache, rewriter);
+        status = fill_layout_info(op->get_input_value(i), plain_desc);
+        if (status != status::success) return status;
+    }
+
+    value_ptr dst = op->get_output_value(0);
+    const auto &dst_lt = dst->get_logical_tensor();
+    if (!ltw(dst_lt).is_strided()) {
+        const memory::desc plain_desc
+                = to_ncx_format(make_dnnl_memory_desc(dst_lt));
+        insert_reorder_after(
+                op, 0, plain_desc, p_engine, mgr, pd_cache, rewriter);
+        status = fill_layout_info(dst, plain_desc);
+        if (status != status::success) return status;
+    }
+
+    value_ptr scratchpad_val = op->get_output_value(1);
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
+status_t layout_propagator_for_masked_softmax(op_ptr &op,
+        const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+        pd_cache_t &pd_cache, subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd = masked_softmax_executable_t::create_desc(
+            op, p_engine, mgr, pd_cache);
+
+    // the rows are processed contiguously, so all tensors are made plain
+    insert_reorder_before(
+            op, 0, pd.src_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_input_value(0), pd.src_desc());
+    if (status != status::success) return status;
+
+    insert_reorder_before(
+            op, 1, pd.cond_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_input_value(1), pd.cond_desc());
+    if (status != status::success) return status;
+
+    insert_reorder_before(
+            op, 2, pd.fill_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_input_value(2), pd.fill_desc());
+    if (status != status::success) return status;
+
+    insert_reorder_after(
+            op, 0, pd.dst_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_output_value(0), pd.dst_desc());
+    if (status != status::success) return status;
+
+    value_ptr scratchpad_val = op->get_output_value(1);
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
+status_t layout_propagator_for_mlp(op_ptr &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache,
+        subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd = mlp_executable_t::create_desc(op, p_engine, mgr, pd_cache);
+
+    // mlp gives its tensors to gemm as row-major matrices. The outer dims of
+    // the src, dst and biases are collapsed into rows, so they need a unit
+    // innermost stride and dense outer dims. The weights only need a unit
+    // stride in one of their two dims.
+    const auto is_gemm_friendly = [](const logical_tensor_t &lt, bool is_wei) {
+        if (!ltw(lt).is_strided()) return false;
+        const auto dims = ltw(lt).vdims();
+        const auto strides = ltw(lt).vstrides();
+        const size_t nd = dims.size();
+        if (is_wei) return strides[0] == 1 || strides[1] == 1;
+        if (strides[nd - 1] != 1) return false;
+        for (size_t i = 0; i + 2 < nd; i++) {
+            if (strides[i] != strides[i + 1] * dims[i + 1]) return false;
+        }
+        return true;
+    };
+
+    const size_t num_weights = op->get_attr<bool>(op_attr::is_gated) ? 3 : 2;
+    for (size_t i = 0; i < op->num_inputs(); i++) {
+        value_ptr in = op->get_input_value(i);
+        const auto &lt = in->get_logical_tensor();
+        const bool is_wei = i >= 1 && i <= num_weights;
+        if (is_gemm_friendly(lt, is_wei)) continue;
+        const memory::desc plain_desc
+                = to_ncx_format(make_dnnl_memory_desc(lt));
+        insert_reorder_before(
+                op, i, plain_desc, p_engine, mgr, pd_cache, rewriter);
+        status = fill_layout_info(op->get_input_value(i), plain_desc);
+        if (status != status::success) return status;
+    }
+
+    value_ptr dst = op->get_output_value(0);
+    if (!is_gemm_friendly(dst->get_logical_tensor(), false)) {
+        const memory::desc plain_desc = to_ncx_format(
+                make_dnnl_memory_desc(dst->get_logical_tensor()));
+        insert_reorder_after(
+                op, 0, plain_desc, p_engine, mgr, pd_cache, rewriter);
+        status = fill_layout_info(dst, plain_desc);
+        if (status != status::success) return status;
+    }
+
+    value_ptr scratchpad_val = op->get_output_value(1);
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
+status_t layout_propagator_for_slice(op_ptr &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache,
+        subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    value_ptr src = op->get_input_value(0);
+    assertm(!ltw(src->get_logical_tensor()).is_any(),
+            "slice's src can't be any layout now");
+
+    // the output is a view into the input, so the input must be strided
+    memory::desc in_md = make_dnnl_memory_desc(src->get_logical_tensor());
+    if (!ltw(src->get_logical_tensor()).is_strided()) {
+        in_md = to_ncx_format(in_md);
+        insert_reorder_before(op, 0, in_md, p_engine, mgr, pd_cache, rewriter);
+        status = fill_layout_info(op->get_input_value(0), in_md);
+        if (status != status::success) return status;
+    }
+
+    // the view keeps the strides of the input
+    const auto &dst_lt = op->get_output_value(0)->get_logical_tensor();
+    const memory::desc view_md(
+            ltw(dst_lt).vdims(), in_md.get_data_type(), in_md.get_strides());
+    status = insert_reorder_after(
+            op, 0, view_md, p_engine, mgr, pd_cache, rewriter);
+    if (status != status::success) return status;
+    return fill_layout_info(op->get_output_value(0), view_md);
+}
+
+status_t layout_propagator_for_embedding_bag(op_ptr &op,
+        const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+        pd_cache_t &pd_cache, subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd = embedding_bag_executable_t::create_desc(
+            op, p_engine, mgr, pd_cache);
+
+    // the table is read row by row, so a non-dense table is reordered first
+    insert_reorder_before(
+            op, 0, pd.src_desc(), p_engine, mgr, pd_cache, rewriter);
+    value_ptr src = op->get_input_value(0);
+    status = fill_layout_info(src, pd.src_desc());
+    if (status != status::success) return status;
+
+    insert_reorder_after(
+            op, 0, pd.dst_desc(), p_engine, mgr, pd_cache, rewriter);
+    value_ptr dst = op->get_output_value(0);
+    status = fill_layout_info(dst, pd.dst_desc());
+    if (status != status::success) return status;
+
+    value_ptr scratchpad_val = op->get_output_value(1);
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
+status_t layout_propagator_for_gather(op_ptr &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache,
+        subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd
+            = gather_executable_t::create_desc(op, p_engine, mgr, pd_cache);
+
+    // gather copies contiguous slices, so all tensors are made plain
+    insert_reorder_before(
+            op, 0, pd.data_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_input_value(0), pd.data_desc());
+    if (status != status::success) return status;
+
+    insert_reorder_before(
+            op, 1, pd.indices_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_input_value(1), pd.indices_desc());
+    if (status != status::success) return status;
+
+    insert_reorder_after(
+            op, 0, pd.dst_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_output_value(0), pd.dst_desc());
+    if (status != status::success) return status;
+
+    value_ptr scratchpad_val = op->get_output_value(1);
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
 status_t layout_propagator_for_layernorm_bwd(op_ptr &op,
         const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
         pd_cache_t &pd_cache, subgraph_rewriter_t &rewriter) {
@@ -69,6 +69,13 @@ DECLARE_LAYOUT_PROPAGATOR(prelu);
 DECLARE_LAYOUT_PROPAGATOR(prelu_bwd);
 DECLARE_LAYOUT_PROPAGATOR(layernorm);
 DECLARE_LAYOUT_PROPAGATOR(layernorm_bwd);
+DECLARE_LAYOUT_PROPAGATOR(groupnorm);
+DECLARE_LAYOUT_PROPAGATOR(embedding_bag);
+DECLARE_LAYOUT_PROPAGATOR(gather);
+DECLARE_LAYOUT_PROPAGATOR(sdpa);
+DECLARE_LAYOUT_PROPAGATOR(masked_softmax);
+DECLARE_LAYOUT_PROPAGATOR(mlp);
+DECLARE_LAYOUT_PROPAGATOR(slice);
 DECLARE_LAYOUT_PROPAGATOR(permute);
 DECLARE_LAYOUT_PROPAGATOR(to_group);
 DECLARE_LAYOUT_PROPAGATOR(from_group);
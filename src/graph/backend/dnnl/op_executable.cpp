@@ -13,6 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -25,6 +30,9 @@
 
 #include <graph/utils/utils.hpp>
 
+#include "common/dnnl_thread.hpp"
+#include "common/math_utils.hpp"
+
 #include "graph/interface/backend.hpp"
 
 #include "graph/backend/dnnl/common.hpp"
@@ -70,9 +78,13 @@ conv_fwd_executable_t::desc_t conv_fwd_executable_t::create_desc(
     prm_attr.set_fpmath_mode(
             static_cast<dnnl::fpmath_mode>(mgr.get_fpmath_mode()));
 
+    // the layout assignment may ask for plain activations on gpu as well
+    const bool use_plain = p_engine.get_kind() == dnnl::engine::kind::cpu
+            || (op->has_attr(op_attr::use_plain_layout)
+                    && op->get_attr<bool>(op_attr::use_plain_layout));
     auto src = make_dnnl_memory_desc(
             op->get_input_value(0)->get_logical_tensor());
-    if (p_engine.get_kind() == dnnl::engine::kind::cpu)
+    if (use_plain)
         src = to_nxc_format(src);
     else
         src = to_format_any(src);
@@ -96,7 +108,7 @@ conv_fwd_executable_t::desc_t conv_fwd_executable_t::create_desc(
                 = dw_conv->get_op()->get_input_value(0)->get_logical_tensor();
     }
     auto dst = make_dnnl_memory_desc(base_conv_dst_lt);
-    if (p_engine.get_kind() == dnnl::engine::kind::cpu)
+    if (use_plain)
         dst = to_nxc_format(dst);
     else
         dst = to_format_any(dst);
@@ -149,15 +161,17 @@ deconv_fwd_executable_t::desc_t deconv_fwd_executable_t::create_desc(
     prm_attr.set_fpmath_mode(
             static_cast<dnnl::fpmath_mode>(mgr.get_fpmath_mode()));
 
+    const bool use_plain = op->has_attr(op_attr::use_plain_layout)
+            && op->get_attr<bool>(op_attr::use_plain_layout);
     auto src = make_dnnl_memory_desc(
             op->get_input_value(0)->get_logical_tensor());
-    src = to_format_any(src);
+    src = use_plain ? to_nxc_format(src) : to_format_any(src);
     auto weight = make_dnnl_memory_desc(
             op->get_input_value(1)->get_logical_tensor());
     weight = to_format_any(weight);
     auto dst = make_dnnl_memory_desc(
             op->get_output_value(0)->get_logical_tensor());
-    dst = to_format_any(dst);
+    dst = use_plain ? to_nxc_format(dst) : to_format_any(dst);
 
     dnnl::deconvolution_forward::primitive_desc pd;
     if (op->has_attr(op_attr::with_bias)
@@ -325,7 +339,14 @@ matmul_executable_t::desc_t matmul_executable_t::create_desc(
                         && is_format(src, dnnl::memory::format_tag::acbd))
                     || ((src.get_ndims() == 2 || src.get_ndims() == 3)
                             && p_engine.get_kind() == dnnl::engine::kind::gpu));
-    if (!use_strided_src) { src = to_format_any(src); }
+    // the layout assignment may ask for plain src and dst instead of any
+    const bool use_plain = op->has_attr(op_attr::use_plain_layout)
+            && op->get_attr<bool>(op_attr::use_plain_layout);
+    if (use_plain && !is_plain(src)) {
+        src = to_ncx_format(src);
+    } else if (!use_strided_src) {
+        src = to_format_any(src);
+    }
     auto wei = make_dnnl_memory_desc(
             op->get_input_value(1)->get_logical_tensor());
     // For non-constant weight, create primitive desc with strided layout when:
@@ -349,7 +370,11 @@ matmul_executable_t::desc_t matmul_executable_t::create_desc(
             = ((src.get_ndims() == 2 || src.get_ndims() == 3)
                       && p_engine.get_kind() == dnnl::engine::kind::gpu)
             || keep_dst_layout;
-    if (!use_strided_dst) { dst = to_format_any(dst); }
+    if (use_plain && !is_plain(dst)) {
+        dst = to_ncx_format(dst);
+    } else if (!use_strided_dst) {
+        dst = to_format_any(dst);
+    }
 
     dnnl::matmul::primitive_desc pd;
     if (op->has_attr(op_attr::with_bias)
@@ -711,6 +736,154 @@ layernorm_executable_t::desc_t layernorm_executable_t::create_desc(
     return {pd, false};
 }
 
+groupnorm_executable_t::desc_t groupnorm_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    // first look up the cache
+    if (pd_cache.find(op.get()) != pd_cache.end()) {
+        auto pd = graph::utils::any_cast<
+                dnnl::group_normalization_forward::primitive_desc>(
+                pd_cache.at(op.get()));
+        return {pd, true};
+    }
+
+    dnnl::primitive_attr prm_attr;
+    if (op->has_attr(op_attr::fusion_info_key)
+            && op->get_attr<int64_t>(op_attr::fusion_info_key) != -1) {
+        int64_t key = op->get_attr<int64_t>(op_attr::fusion_info_key);
+        prm_attr = make_dnnl_primitive_attr(op, mgr.get_info(key));
+    }
+
+    prm_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+    const auto groups = op->get_attr<int64_t>(op_attr::groups);
+    float epsilon = 1e-5;
+    if (op->has_attr(op_attr::epsilon))
+        epsilon = op->get_attr<float>(op_attr::epsilon);
+    bool keep_stats = true;
+    if (op->has_attr(op_attr::keep_stats))
+        keep_stats = op->get_attr<bool>(op_attr::keep_stats);
+    bool use_affine = true;
+    if (op->has_attr(op_attr::use_affine))
+        use_affine = op->get_attr<bool>(op_attr::use_affine);
+
+    auto flags = dnnl::normalization_flags::none;
+    if (use_affine)
+        flags |= (dnnl::normalization_flags::use_scale
+                | dnnl::normalization_flags::use_shift);
+
+    prop_kind pkind = keep_stats ? prop_kind::forward_training
+                                 : prop_kind::forward_inference;
+
+    auto src = make_dnnl_memory_desc(
+            op->get_input_value(0)->get_logical_tensor());
+    auto dst = make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor());
+    // let the primitive keep the src layout for dst
+    dst = to_format_any(dst);
+
+    dnnl::group_normalization_forward::primitive_desc pd(
+            p_engine, pkind, src, dst, groups, epsilon, flags, prm_attr);
+
+    pd_cache.insert({op.get(), pd});
+    return {pd, false};
+}
+
+embedding_bag_executable_t::desc_t embedding_bag_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    // first look up the cache
+    if (pd_cache.find(op.get()) != pd_cache.end()) {
+        auto pd = graph::utils::any_cast<dnnl::embedding_bag::primitive_desc>(
+                pd_cache.at(op.get()));
+        return {pd, true};
+    }
+
+    dnnl::primitive_attr prm_attr;
+    if (op->has_attr(op_attr::fusion_info_key)
+            && op->get_attr<int64_t>(op_attr::fusion_info_key) != -1) {
+        int64_t key = op->get_attr<int64_t>(op_attr::fusion_info_key);
+        prm_attr = make_dnnl_primitive_attr(op, mgr.get_info(key));
+    }
+    prm_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+
+    const std::string mode = op->has_attr(op_attr::mode)
+            ? op->get_attr<std::string>(op_attr::mode)
+            : "sum";
+    algorithm alg = algorithm::undef;
+    if (mode == "sum")
+        alg = algorithm::embedding_bag_sum;
+    else if (mode == "mean")
+        alg = algorithm::embedding_bag_mean;
+    else if (mode == "max")
+        alg = algorithm::embedding_bag_max;
+    else
+        BACKEND_DNNL_ENFORCE(0, "Unsupported embedding bag mode.");
+
+    auto src = make_dnnl_memory_desc(
+            op->get_input_value(0)->get_logical_tensor());
+    // the rows of the table are always read densely
+    src = memory::desc(
+            src.get_dims(), src.get_data_type(), memory::format_tag::ab);
+    auto indices = make_dnnl_memory_desc(
+            op->get_input_value(1)->get_logical_tensor());
+    auto offsets = make_dnnl_memory_desc(
+            op->get_input_value(2)->get_logical_tensor());
+    memory::desc weights;
+    if (op->num_inputs() > 3) {
+        weights = make_dnnl_memory_desc(
+                op->get_input_value(3)->get_logical_tensor());
+    }
+    auto dst = make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor());
+    dst = to_format_any(dst);
+
+    dnnl::embedding_bag::primitive_desc pd(p_engine, alg, src, indices,
+            offsets, weights, dst, prm_attr);
+
+    pd_cache.insert({op.get(), pd});
+    return {pd, false};
+}
+
+gather_executable_t::desc_t gather_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    UNUSED(p_engine);
+    UNUSED(mgr);
+    UNUSED(pd_cache);
+
+    desc_t desc;
+    desc.data_desc_ = to_ncx_format(make_dnnl_memory_desc(
+            op->get_input_value(0)->get_logical_tensor()));
+    desc.indices_desc_ = to_ncx_format(make_dnnl_memory_desc(
+            op->get_input_value(1)->get_logical_tensor()));
+    desc.dst_desc_ = to_ncx_format(make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor()));
+
+    const auto data_dims = desc.data_desc_.get_dims();
+    const auto ndims = static_cast<int64_t>(data_dims.size());
+    int64_t axis = op->get_attr<int64_t>(op_attr::axis);
+    if (axis < 0) axis += ndims;
+
+    desc.outer_ = 1;
+    for (int64_t d = 0; d < axis; d++)
+        desc.outer_ *= data_dims[d];
+    desc.axis_dim_ = data_dims[axis];
+    dim_t inner = 1;
+    for (int64_t d = axis + 1; d < ndims; d++)
+        inner *= data_dims[d];
+    desc.inner_bytes_ = static_cast<size_t>(inner)
+            * memory::data_type_size(desc.data_desc_.get_data_type());
+
+    const auto indices_dims = desc.indices_desc_.get_dims();
+    desc.n_indices_ = 1;
+    for (auto d : indices_dims)
+        desc.n_indices_ *= d;
+
+    // the copies need no temporary buffer
+    desc.scratchpad_desc_ = memory::desc();
+    return desc;
+}
+
 layernorm_bwd_executable_t::desc_t layernorm_bwd_executable_t::create_desc(
         std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
         fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
@@ -1157,8 +1330,16 @@ binary_executable_t::desc_t binary_executable_t::create_desc(
             op->get_attr<int64_t>(op_attr::alg_kind));
 
     dnnl::binary::primitive_desc pd;
-    pd = dnnl::binary::primitive_desc(
-            p_engine, algo, src0, src1, dst, prm_attr);
+    if (algo == algorithm::binary_select) {
+        // the condition of select is the third input
+        auto src2 = make_dnnl_memory_desc(
+                op->get_input_value(2)->get_logical_tensor());
+        pd = dnnl::binary::primitive_desc(
+                p_engine, algo, src0, src1, src2, dst, prm_attr);
+    } else {
+        pd = dnnl::binary::primitive_desc(
+                p_engine, algo, src0, src1, dst, prm_attr);
+    }
 
     pd_cache.insert({op.get(), pd});
 
@@ -1579,6 +1760,599 @@ bn_folding_t::desc_t bn_folding_t::create_desc(std::shared_ptr<op_t> &op,
     return desc;
 }
 
+sdpa_executable_t::desc_t sdpa_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    UNUSED(p_engine);
+    UNUSED(mgr);
+    UNUSED(pd_cache);
+
+    desc_t desc;
+
+    desc.with_scale_ = op->get_attr<bool>(op_attr::with_scale);
+    desc.with_mask_ = op->get_attr<bool>(op_attr::with_mask);
+    desc.with_select_ = desc.with_mask_ && op->has_attr(op_attr::with_select)
+            && op->get_attr<bool>(op_attr::with_select);
+    desc.select_scores_in_else_ = desc.with_select_
+            && op->has_attr(op_attr::select_scores_in_else)
+            && op->get_attr<bool>(op_attr::select_scores_in_else);
+    desc.transpose_b_ = op->has_attr(op_attr::transpose_b)
+            && op->get_attr<bool>(op_attr::transpose_b);
+    if (desc.with_scale_) {
+        desc.is_div_scale_ = op->get_attr<int64_t>(op_attr::alg_kind)
+                == static_cast<int64_t>(algorithm::binary_div);
+    }
+
+    size_t in_idx = 0;
+    desc.q_desc_ = make_dnnl_memory_desc(
+            op->get_input_value(in_idx++)->get_logical_tensor());
+    desc.k_desc_ = make_dnnl_memory_desc(
+            op->get_input_value(in_idx++)->get_logical_tensor());
+    desc.v_desc_ = make_dnnl_memory_desc(
+            op->get_input_value(in_idx++)->get_logical_tensor());
+    if (desc.with_scale_) in_idx++;
+    if (desc.with_mask_) {
+        desc.mask_desc_ = make_dnnl_memory_desc(
+                op->get_input_value(in_idx++)->get_logical_tensor());
+    }
+    desc.dst_desc_ = make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor());
+
+    // q: [B, H, Sq, D], v: [B, H, Sk, Dv]
+    const auto q_dims = desc.q_desc_.get_dims();
+    const auto k_dims = desc.k_desc_.get_dims();
+    const auto v_dims = desc.v_desc_.get_dims();
+    const dim_t Sq = q_dims[2], D = q_dims[3];
+    const dim_t Sk = v_dims[2], Dv = v_dims[3];
+
+    // k^T and v are packed once for each of their own heads, so a broadcast
+    // k or v is not copied for every query head
+    desc.kt_pack_size_ = k_dims[0] * k_dims[1] * D * Sk;
+    desc.v_pack_size_ = v_dims[0] * v_dims[1] * Sk * Dv;
+
+    // The blocks are chosen so that the per-thread buffers of a typical head
+    // size (64) fit into L2.
+    desc.q_block_ = std::max<dim_t>(std::min<dim_t>(Sq, 64), 1);
+    desc.k_block_ = std::max<dim_t>(std::min<dim_t>(Sk, 128), 1);
+    const dim_t bq = desc.q_block_, bk = desc.k_block_;
+    // packed q block, scores of one block, output accumulator, and the
+    // running max and sum of each query row
+    desc.thr_buf_size_ = bq * D + bq * bk + bq * Dv + 2 * bq;
+    desc.nthr_ = dnnl_get_max_threads();
+
+    const dim_t scratchpad_size = static_cast<dim_t>(sizeof(float))
+            * (desc.kt_pack_size_ + desc.v_pack_size_
+                    + desc.thr_buf_size_ * desc.nthr_);
+    desc.scratchpad_desc_ = memory::desc(
+            {scratchpad_size}, memory::data_type::u8, memory::format_tag::a);
+    return desc;
+}
+
+masked_softmax_executable_t::desc_t masked_softmax_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    UNUSED(p_engine);
+    UNUSED(mgr);
+    UNUSED(pd_cache);
+
+    desc_t desc;
+    desc.src_desc_ = to_ncx_format(make_dnnl_memory_desc(
+            op->get_input_value(0)->get_logical_tensor()));
+    desc.cond_desc_ = to_ncx_format(make_dnnl_memory_desc(
+            op->get_input_value(1)->get_logical_tensor()));
+    desc.fill_desc_ = to_ncx_format(make_dnnl_memory_desc(
+            op->get_input_value(2)->get_logical_tensor()));
+    desc.dst_desc_ = to_ncx_format(make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor()));
+    desc.scores_in_else_ = op->has_attr(op_attr::select_scores_in_else)
+            && op->get_attr<bool>(op_attr::select_scores_in_else);
+
+    // the rows are normalized in place in dst
+    desc.scratchpad_desc_ = memory::desc();
+    return desc;
+}
+
+void gather_executable_t::execute(const stream &stream,
+        const std::unordered_map<int, memory> &args) const {
+    UNUSED(stream);
+
+    const auto *data = static_cast<const uint8_t *>(
+            args.find(DNNL_ARG_SRC_0)->second.get_data_handle());
+    const auto *indices = static_cast<const int32_t *>(
+            args.find(DNNL_ARG_SRC_1)->second.get_data_handle());
+    auto *dst = static_cast<uint8_t *>(
+            args.find(DNNL_ARG_DST)->second.get_data_handle());
+
+    const dim_t axis_dim = desc_.axis_dim_;
+    const dim_t n_indices = desc_.n_indices_;
+    const size_t inner_bytes = desc_.inner_bytes_;
+    std::atomic<bool> args_ok(true);
+    dnnl::impl::parallel_nd(
+            desc_.outer_, n_indices, [&](dim_t o, dim_t i) {
+                dim_t idx = indices[i];
+                // negative indices count from the end of the axis
+                if (idx < 0) idx += axis_dim;
+                if (idx < 0 || idx >= axis_dim) {
+                    args_ok = false;
+                    return;
+                }
+                uint8_t *out = dst + (o * n_indices + i) * inner_bytes;
+                std::memcpy(out, data + (o * axis_dim + idx) * inner_bytes,
+                        inner_bytes);
+            });
+    // an index out of range is reported the same way as by the embedding
+    // bag primitive
+    error::wrap_c_api(args_ok ? dnnl_success : dnnl_invalid_arguments,
+            "gather index is out of range");
+}
+
+void sdpa_executable_t::execute(const stream &stream,
+        const std::unordered_map<int, memory> &args) const {
+    UNUSED(stream);
+
+    const auto *q = static_cast<const float *>(
+            args.find(DNNL_ARG_SRC_0)->second.get_data_handle());
+    const auto *k = static_cast<const float *>(
+            args.find(DNNL_ARG_SRC_1)->second.get_data_handle());
+    const auto *v = static_cast<const float *>(
+            args.find(DNNL_ARG_SRC_2)->second.get_data_handle());
+    const void *mask_data = desc_.with_mask_
+            ? args.find(DNNL_ARG_SRC_3)->second.get_data_handle()
+            : nullptr;
+    // an additive f32 mask, or the u8 condition of a select mask
+    const auto *mask = desc_.with_select_
+            ? nullptr
+            : static_cast<const float *>(mask_data);
+    const auto *cond = desc_.with_select_
+            ? static_cast<const uint8_t *>(mask_data)
+            : nullptr;
+    const float fill = desc_.with_select_
+            ? *static_cast<const float *>(
+                    args.find(DNNL_ARG_SRC_4)->second.get_data_handle())
+            : 0.f;
+    auto *dst = static_cast<float *>(
+            args.find(DNNL_ARG_DST)->second.get_data_handle());
+    auto *scratchpad = static_cast<float *>(
+            args.find(DNNL_ARG_SCRATCHPAD)->second.get_data_handle());
+
+    // the scale is applied as the alpha of the first gemm
+    float alpha = 1.f;
+    if (desc_.with_scale_) {
+        const float scale = *static_cast<const float *>(
+                args.find(DNNL_ARG_SCALE)->second.get_data_handle());
+        alpha = desc_.is_div_scale_ ? 1.f / scale : scale;
+    }
+
+    const auto q_dims = desc_.q_desc_.get_dims();
+    const auto v_dims = desc_.v_desc_.get_dims();
+    const dim_t B = q_dims[0], H = q_dims[1], Sq = q_dims[2], D = q_dims[3];
+    const dim_t Sk = v_dims[2], Dv = v_dims[3];
+
+    const auto qs = desc_.q_desc_.get_strides();
+    const auto ds = desc_.dst_desc_.get_strides();
+    // strides of k^T: [B, H, D, Sk]
+    auto ks = desc_.k_desc_.get_strides();
+    if (desc_.transpose_b_) std::swap(ks[2], ks[3]);
+    // k and v with a batch or head dim of 1 are broadcast by the matmuls,
+    // e.g. one key and value head shared by all query heads (MQA)
+    auto vs = desc_.v_desc_.get_strides();
+    const auto k_dims = desc_.k_desc_.get_dims();
+    for (int i = 0; i < 2; i++) {
+        if (k_dims[i] == 1) ks[i] = 0;
+        if (v_dims[i] == 1) vs[i] = 0;
+    }
+    // strides of the mask broadcast to [B, H, Sq, Sk]
+    dims ms(4, 0);
+    if (desc_.with_mask_) {
+        const auto mask_dims = desc_.mask_desc_.get_dims();
+        const auto mask_strides = desc_.mask_desc_.get_strides();
+        const size_t offset = 4 - mask_dims.size();
+        for (size_t i = 0; i < mask_dims.size(); i++)
+            ms[offset + i] = mask_dims[i] == 1 ? 0 : mask_strides[i];
+    }
+
+    const dim_t bq = desc_.q_block_, bk = desc_.k_block_;
+    const dim_t nqb = (Sq + bq - 1) / bq;
+    const dim_t work_amount = B * H * nqb;
+    if (work_amount == 0 || Sk == 0) return;
+
+    const float neg_inf = -std::numeric_limits<float>::infinity();
+
+    // k^T of each head is packed to [D, Sk] and v to [Sk, Dv], so a key block
+    // is a column block of k^T and a row block of v
+    float *kt_pack = scratchpad;
+    float *v_pack = kt_pack + desc_.kt_pack_size_;
+    const dim_t KH = k_dims[1], VH = v_dims[1];
+    dnnl::impl::parallel_nd(k_dims[0], KH, D, [&](dim_t b, dim_t h, dim_t d) {
+        const float *src = k + b * ks[0] + h * ks[1] + d * ks[2];
+        float *out = kt_pack + ((b * KH + h) * D + d) * Sk;
+        for (dim_t j = 0; j < Sk; j++)
+            out[j] = src[j * ks[3]];
+    });
+    dnnl::impl::parallel_nd(v_dims[0], VH, Sk, [&](dim_t b, dim_t h, dim_t j) {
+        const float *src = v + b * vs[0] + h * vs[1] + j * vs[2];
+        float *out = v_pack + ((b * VH + h) * Sk + j) * Dv;
+        for (dim_t c = 0; c < Dv; c++)
+            out[c] = src[c * vs[3]];
+    });
+
+    float *thr_scratchpad = v_pack + desc_.v_pack_size_;
+    dnnl::impl::parallel(desc_.nthr_, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        dnnl::impl::balance211(work_amount, nthr, ithr, start, end);
+
+        float *q_buf = thr_scratchpad + ithr * desc_.thr_buf_size_; // [bq, D]
+        float *s_buf = q_buf + bq * D; // [bq, bk]
+        float *o_buf = s_buf + bq * bk; // [bq, Dv]
+        float *m_buf = o_buf + bq * Dv; // [bq]
+        float *l_buf = m_buf + bq; // [bq]
+
+        for (dim_t iwork = start; iwork < end; iwork++) {
+            const dim_t qb = iwork % nqb;
+            const dim_t h = (iwork / nqb) % H;
+            const dim_t b = iwork / nqb / H;
+            const dim_t q0 = qb * bq;
+            const dim_t nq = std::min(bq, Sq - q0);
+
+            const float *q_ptr = q + b * qs[0] + h * qs[1] + q0 * qs[2];
+            const dim_t kh = (k_dims[0] == 1 ? 0 : b) * KH + (KH == 1 ? 0 : h);
+            const dim_t vh = (v_dims[0] == 1 ? 0 : b) * VH + (VH == 1 ? 0 : h);
+            const float *kt_ptr = kt_pack + kh * D * Sk;
+            const float *v_ptr = v_pack + vh * Sk * Dv;
+            const dim_t mask_off = b * ms[0] + h * ms[1] + q0 * ms[2];
+            const float *mask_ptr = mask ? mask + mask_off : nullptr;
+            const uint8_t *cond_ptr = cond ? cond + mask_off : nullptr;
+            float *dst_ptr = dst + b * ds[0] + h * ds[1] + q0 * ds[2];
+
+            for_(dim_t i = 0; i < nq; i++)
+            for (dim_t d = 0; d < D; d++)
+                q_buf[i * D + d] = q_ptr[i * qs[2] + d * qs[3]];
+            std::fill(m_buf, m_buf + nq, neg_inf);
+            std::fill(l_buf, l_buf + nq, 0.f);
+            std::fill(o_buf, o_buf + nq * Dv, 0.f);
+
+            for (dim_t k0 = 0; k0 < Sk; k0 += bk) {
+                const dim_t nk = std::min(bk, Sk - k0);
+
+                dnnl_sgemm('N', 'N', nq, nk, D, alpha, q_buf, D, kt_ptr + k0,
+                        Sk, 0.f, s_buf, nk);
+
+                if (mask_ptr) {
+                    for_(dim_t i = 0; i < nq; i++)
+                    for (dim_t j = 0; j < nk; j++)
+                        s_buf[i * nk + j]
+                                += mask_ptr[i * ms[2] + (k0 + j) * ms[3]];
+                }
+                if (cond_ptr) {
+                    // the scores are kept where the condition selects them
+                    // and replaced by the fill value elsewhere
+                    const bool keep_on = !desc_.select_scores_in_else_;
+                    for_(dim_t i = 0; i < nq; i++)
+                    for (dim_t j = 0; j < nk; j++) {
+                        const bool is_set
+                                = cond_ptr[i * ms[2] + (k0 + j) * ms[3]] != 0;
+                        if (is_set != keep_on) s_buf[i * nk + j] = fill;
+                    }
+                }
+
+                // online softmax: rescale what was accumulated so far to the
+                // new running max of the row
+                for (dim_t i = 0; i < nq; i++) {
+                    float *s = s_buf + i * nk;
+                    float max = m_buf[i];
+                    for (dim_t j = 0; j < nk; j++)
+                        max = std::max(max, s[j]);
+                    if (max == neg_inf) {
+                        // the row is fully masked so far
+                        std::fill(s, s + nk, 0.f);
+                        continue;
+                    }
+                    const float corr = std::exp(m_buf[i] - max);
+                    float sum = 0.f;
+                    for (dim_t j = 0; j < nk; j++) {
+                        s[j] = std::exp(s[j] - max);
+                        sum += s[j];
+                    }
+                    l_buf[i] = l_buf[i] * corr + sum;
+                    m_buf[i] = max;
+                    if (corr != 1.f) {
+                        for (dim_t c = 0; c < Dv; c++)
+                            o_buf[i * Dv + c] *= corr;
+                    }
+                }
+
+                dnnl_sgemm('N', 'N', nq, Dv, nk, 1.f, s_buf, nk,
+                        v_ptr + k0 * Dv, Dv, 1.f, o_buf, Dv);
+            }
+
+            for_(dim_t i = 0; i < nq; i++)
+            for (dim_t c = 0; c < Dv; c++)
+                dst_ptr[i * ds[2] + c * ds[3]] = o_buf[i * Dv + c] / l_buf[i];
+        }
+    });
+}
+
+void masked_softmax_executable_t::execute(const stream &stream,
+        const std::unordered_map<int, memory> &args) const {
+    UNUSED(stream);
+
+    const auto *src = static_cast<const float *>(
+            args.find(DNNL_ARG_SRC_0)->second.get_data_handle());
+    const auto *cond = static_cast<const uint8_t *>(
+            args.find(DNNL_ARG_SRC_1)->second.get_data_handle());
+    const float fill = *static_cast<const float *>(
+            args.find(DNNL_ARG_SRC_2)->second.get_data_handle());
+    auto *dst = static_cast<float *>(
+            args.find(DNNL_ARG_DST)->second.get_data_handle());
+
+    const auto src_dims = desc_.src_desc_.get_dims();
+    const int ndims = static_cast<int>(src_dims.size());
+    const dim_t N = src_dims[ndims - 1];
+    if (N == 0) return;
+    dim_t rows = 1;
+    for (int d = 0; d < ndims - 1; d++)
+        rows *= src_dims[d];
+
+    // strides of cond broadcast to the dims of src
+    dims cs(ndims, 0);
+    const auto cond_dims = desc_.cond_desc_.get_dims();
+    const auto cond_strides = desc_.cond_desc_.get_strides();
+    const size_t offset = ndims - cond_dims.size();
+    for (size_t i = 0; i < cond_dims.size(); i++)
+        cs[offset + i] = cond_dims[i] == 1 ? 0 : cond_strides[i];
+
+    const bool keep_on = !desc_.scores_in_else_;
+    dnnl::impl::parallel_nd(rows, [&](dim_t r) {
+        dim_t cond_off = 0;
+        for (dim_t d = ndims - 2, rem = r; d >= 0; d--) {
+            cond_off += (rem % src_dims[d]) * cs[d];
+            rem /= src_dims[d];
+        }
+        const float *s = src + r * N;
+        const uint8_t *c = cond + cond_off;
+        float *out = dst + r * N;
+
+        float max = -std::numeric_limits<float>::infinity();
+        for (dim_t j = 0; j < N; j++) {
+            const bool is_set = c[j * cs[ndims - 1]] != 0;
+            out[j] = is_set != keep_on ? fill : s[j];
+            max = std::max(max, out[j]);
+        }
+        float sum = 0.f;
+        for (dim_t j = 0; j < N; j++) {
+            out[j] = std::exp(out[j] - max);
+            sum += out[j];
+        }
+        const float inv_sum = 1.f / sum;
+        for (dim_t j = 0; j < N; j++)
+            out[j] *= inv_sum;
+    });
+}
+
+mlp_executable_t::desc_t mlp_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    UNUSED(p_engine);
+    UNUSED(mgr);
+    UNUSED(pd_cache);
+
+    desc_t desc;
+
+    desc.alg_ = static_cast<algorithm>(
+            op->get_attr<int64_t>(op_attr::alg_kind));
+    desc.alpha_ = op->get_attr<float>(op_attr::alpha);
+    desc.is_gated_ = op->get_attr<bool>(op_attr::is_gated);
+    desc.with_bias_ = op->get_attr<bool>(op_attr::with_bias);
+    desc.transpose_b_ = op->get_attr<bool>(op_attr::transpose_b);
+
+    size_t in_idx = 0;
+    desc.src_desc_ = make_dnnl_memory_desc(
+            op->get_input_value(in_idx++)->get_logical_tensor());
+    desc.wei_desc_ = make_dnnl_memory_desc(
+            op->get_input_value(in_idx++)->get_logical_tensor());
+    if (desc.is_gated_) {
+        desc.wei_up_desc_ = make_dnnl_memory_desc(
+                op->get_input_value(in_idx++)->get_logical_tensor());
+    }
+    desc.wei_down_desc_ = make_dnnl_memory_desc(
+            op->get_input_value(in_idx++)->get_logical_tensor());
+    desc.dst_desc_ = make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor());
+
+    // the outer dims of src are collapsed into the rows of the gemms
+    const auto src_dims = desc.src_desc_.get_dims();
+    desc.K_ = src_dims.back();
+    desc.M_ = 1;
+    for (size_t i = 0; i + 1 < src_dims.size(); i++)
+        desc.M_ *= src_dims[i];
+    const auto wei_dims = desc.wei_desc_.get_dims();
+    desc.N1_ = desc.transpose_b_ ? wei_dims[0] : wei_dims[1];
+    desc.N2_ = desc.dst_desc_.get_dims().back();
+
+    // The N1 chunk is chosen so that its weight slab (K x chunk of W and
+    // W_up, chunk x N2 of W_down) takes about half of a typical 1MB L2. The
+    // row block is then chosen so that the intermediate of one block and
+    // chunk (and its gating counterpart) fits into the other half.
+    const dim_t num_bufs = desc.is_gated_ ? 2 : 1;
+    const dim_t l2_size = 1024 * 1024;
+    const dim_t f32_size = static_cast<dim_t>(sizeof(float));
+    const dim_t slab_row_size
+            = f32_size * (num_bufs * desc.K_ + desc.N2_);
+    dim_t n1_block = (l2_size / 2) / std::max<dim_t>(slab_row_size, 1);
+    n1_block = std::max<dim_t>(n1_block / 16 * 16, 16);
+    desc.n1_block_ = std::max<dim_t>(std::min(n1_block, desc.N1_), 1);
+    dim_t row_block
+            = (l2_size / 2) / (f32_size * num_bufs * desc.n1_block_);
+    row_block = std::min<dim_t>(std::max<dim_t>(row_block, 16), 128);
+    desc.row_block_ = std::max<dim_t>(std::min(row_block, desc.M_), 1);
+    desc.thr_buf_size_ = num_bufs * desc.row_block_ * desc.n1_block_;
+    desc.nthr_ = dnnl_get_max_threads();
+
+    const dim_t scratchpad_size = static_cast<dim_t>(sizeof(float))
+            * desc.thr_buf_size_ * desc.nthr_;
+    desc.scratchpad_desc_ = memory::desc(
+            {scratchpad_size}, memory::data_type::u8, memory::format_tag::a);
+    return desc;
+}
+
+// Gets the gemm arguments of a [K, N] weight (or [N, K] if transposed) that
+// has a unit stride in one of its dims.
+static void get_mlp_weight_gemm_args(const memory::desc &md, bool transpose_b,
+        char &trans, dim_t &ld) {
+    auto wdims = md.get_dims();
+    auto wstrides = md.get_strides();
+    if (transpose_b) {
+        std::swap(wdims[0], wdims[1]);
+        std::swap(wstrides[0], wstrides[1]);
+    }
+    if (wstrides[1] == 1) {
+        trans = 'N';
+        ld = std::max(wstrides[0], wdims[1]);
+    } else {
+        trans = 'T';
+        ld = std::max(wstrides[1], wdims[0]);
+    }
+}
+
+void mlp_executable_t::execute(const stream &stream,
+        const std::unordered_map<int, memory> &args) const {
+    UNUSED(stream);
+
+    const auto get_ptr = [&](int arg) -> float * {
+        return static_cast<float *>(args.find(arg)->second.get_data_handle());
+    };
+    const float *src = get_ptr(DNNL_ARG_SRC);
+    const float *wei = get_ptr(DNNL_ARG_WEIGHTS_0);
+    const float *wei_up = desc_.is_gated_ ? get_ptr(DNNL_ARG_WEIGHTS_1)
+                                          : nullptr;
+    const float *wei_down = get_ptr(DNNL_ARG_WEIGHTS_2);
+    const float *bias = desc_.with_bias_ ? get_ptr(DNNL_ARG_SRC_1) : nullptr;
+    const float *bias_up = desc_.with_bias_ && desc_.is_gated_
+            ? get_ptr(DNNL_ARG_SRC_2)
+            : nullptr;
+    const float *bias_down
+            = desc_.with_bias_ ? get_ptr(DNNL_ARG_SRC_3) : nullptr;
+    float *dst = get_ptr(DNNL_ARG_DST);
+    float *scratchpad = get_ptr(DNNL_ARG_SCRATCHPAD);
+
+    const dim_t M = desc_.M_, K = desc_.K_, N1 = desc_.N1_, N2 = desc_.N2_;
+    const dim_t mb = desc_.row_block_;
+    const dim_t nblk = (M + mb - 1) / mb;
+    if (nblk == 0) return;
+
+    // the rows of src and dst are dense, see layout_propagator_for_mlp
+    const auto src_strides = desc_.src_desc_.get_strides();
+    const auto dst_strides = desc_.dst_desc_.get_strides();
+    const dim_t lda = std::max(src_strides[src_strides.size() - 2], K);
+    const dim_t ldd = std::max(dst_strides[dst_strides.size() - 2], N2);
+    char wei_trans, wei_down_trans;
+    dim_t ldw, ldw_down;
+    get_mlp_weight_gemm_args(
+            desc_.wei_desc_, desc_.transpose_b_, wei_trans, ldw);
+    get_mlp_weight_gemm_args(
+            desc_.wei_down_desc_, desc_.transpose_b_, wei_down_trans, ldw_down);
+
+    const auto act = [&](float s) -> float {
+        switch (desc_.alg_) {
+            case algorithm::eltwise_gelu_erf:
+                return dnnl::impl::math::gelu_erf_fwd(s);
+            case algorithm::eltwise_gelu_tanh:
+                return dnnl::impl::math::gelu_tanh_fwd(s);
+            default: return dnnl::impl::math::swish_fwd(s, desc_.alpha_);
+        }
+    };
+    // h = act(h + bias) [* (u + bias_up)] for the rows [i0, i1) of a block
+    // and the columns [j0, j0 + nc) of N1
+    const auto epilogue = [&](float *h, const float *u, dim_t i0, dim_t i1,
+                                  dim_t j0, dim_t nc) {
+        for_(dim_t i = i0; i < i1; i++)
+        for (dim_t j = 0; j < nc; j++) {
+            float v = h[i * nc + j];
+            if (bias) v += bias[j0 + j];
+            v = act(v);
+            if (u) {
+                v *= bias_up ? u[i * nc + j] + bias_up[j0 + j]
+                             : u[i * nc + j];
+            }
+            h[i * nc + j] = v;
+        }
+    };
+
+    // the first column of W and W_up and the first row of W_down of a chunk
+    const auto wei_chunk = [&](const float *w, dim_t j0) {
+        return wei_trans == 'N' ? w + j0 : w + j0 * ldw;
+    };
+    const auto wei_down_chunk = [&](dim_t j0) {
+        return wei_down_trans == 'N' ? wei_down + j0 * ldw_down
+                                     : wei_down + j0;
+    };
+
+    // the output bias is put into dst first and the chunks are accumulated on
+    const auto init_block = [&](dim_t blk) {
+        if (!bias_down) return;
+        const dim_t r0 = blk * mb;
+        const dim_t nr = std::min(mb, M - r0);
+        float *y = dst + r0 * ldd;
+        for_(dim_t i = 0; i < nr; i++)
+        for (dim_t j = 0; j < N2; j++)
+            y[i * ldd + j] = bias_down[j];
+    };
+
+    const dim_t n1b = desc_.n1_block_;
+    const dim_t nchunk = (N1 + n1b - 1) / n1b;
+    const auto compute_block
+            = [&](dim_t blk, dim_t chunk, float *h_buf, bool threaded) {
+                  const dim_t r0 = blk * mb;
+                  const dim_t nr = std::min(mb, M - r0);
+                  const dim_t j0 = chunk * n1b;
+                  const dim_t nc = std::min(n1b, N1 - j0);
+                  float *u_buf = wei_up ? h_buf + mb * n1b : nullptr;
+                  const float *x = src + r0 * lda;
+                  float *y = dst + r0 * ldd;
+
+                  dnnl_sgemm('N', wei_trans, nr, nc, K, 1.f, x, lda,
+                          wei_chunk(wei, j0), ldw, 0.f, h_buf, nc);
+                  if (u_buf) {
+                      dnnl_sgemm('N', wei_trans, nr, nc, K, 1.f, x, lda,
+                              wei_chunk(wei_up, j0), ldw, 0.f, u_buf, nc);
+                  }
+                  if (threaded) {
+                      dnnl::impl::parallel_nd(nr, [&](dim_t i) {
+                          epilogue(h_buf, u_buf, i, i + 1, j0, nc);
+                      });
+                  } else {
+                      epilogue(h_buf, u_buf, 0, nr, j0, nc);
+                  }
+
+                  const float beta = (bias_down || chunk > 0) ? 1.f : 0.f;
+                  dnnl_sgemm('N', wei_down_trans, nr, N2, nc, 1.f, h_buf, nc,
+                          wei_down_chunk(j0), ldw_down, beta, y, ldd);
+              };
+
+    if (nblk >= desc_.nthr_) {
+        dnnl::impl::parallel(desc_.nthr_, [&](const int ithr, const int nthr) {
+            dim_t start {0}, end {0};
+            dnnl::impl::balance211(nblk, nthr, ithr, start, end);
+            float *h_buf = scratchpad + ithr * desc_.thr_buf_size_;
+            for (dim_t blk = start; blk < end; blk++)
+                init_block(blk);
+            // The chunk loop is the outer one, so the weight slab of a chunk
+            // is reused by all the row blocks of the thread.
+            for_(dim_t chunk = 0; chunk < nchunk; chunk++)
+            for (dim_t blk = start; blk < end; blk++)
+                compute_block(blk, chunk, h_buf, false);
+        });
+    } else {
+        // There are too few blocks to give one to each thread, so the blocks
+        // are computed one after another with the threading inside the gemms.
+        for (dim_t blk = 0; blk < nblk; blk++)
+            init_block(blk);
+        for_(dim_t chunk = 0; chunk < nchunk; chunk++)
+        for (dim_t blk = 0; blk < nblk; blk++)
+            compute_block(blk, chunk, scratchpad, true);
+    }
+}
+
 static void get_arg_indices_for_post_ops(const op_t *op, fusion_info_mgr_t &mgr,
         arg_indices_t &indices, size_t &base_index) {
     const fusion_info_t &fusion_info
@@ -1684,6 +2458,10 @@ arg_indices_t binary_executable_t::get_arg_indices(
     size_t index = 0;
     arg_indices.insert({DNNL_ARG_SRC_0, indices_t {input, index++}});
     arg_indices.insert({DNNL_ARG_SRC_1, indices_t {input, index++}});
+    if (static_cast<dnnl::algorithm>(op->get_attr<int64_t>(op_attr::alg_kind))
+            == algorithm::binary_select) {
+        arg_indices.insert({DNNL_ARG_SRC_2, indices_t {input, index++}});
+    }
 
     get_arg_indices_for_post_ops(op, mgr, arg_indices, index);
 
@@ -1738,6 +2516,15 @@ arg_indices_t memory_reparser_t::get_arg_indices(
     return arg_indices;
 }
 
+arg_indices_t memory_slicer_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+    arg_indices.insert({DNNL_ARG_FROM, indices_t {input, 0}});
+    arg_indices.insert({DNNL_ARG_TO, indices_t {output, 0}});
+    return arg_indices;
+}
+
 // for single-input-single-output op
 static arg_indices_t get_arg_indices_for_siso_op(
         const op_t *op, fusion_info_mgr_t &mgr) {
@@ -1875,6 +2662,96 @@ arg_indices_t bn_folding_t::get_arg_indices(
     return arg_indices;
 }
 
+arg_indices_t gather_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(op);
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+
+    arg_indices.insert({DNNL_ARG_SRC_0, indices_t {input, 0}}); // data
+    arg_indices.insert({DNNL_ARG_SRC_1, indices_t {input, 1}}); // indices
+
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, 0}});
+    arg_indices.insert({DNNL_ARG_SCRATCHPAD, indices_t {output, 1}});
+
+    return arg_indices;
+}
+
+arg_indices_t sdpa_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+
+    size_t in_idx = 0;
+    arg_indices.insert({DNNL_ARG_SRC_0, indices_t {input, in_idx++}}); // q
+    arg_indices.insert({DNNL_ARG_SRC_1, indices_t {input, in_idx++}}); // k
+    arg_indices.insert({DNNL_ARG_SRC_2, indices_t {input, in_idx++}}); // v
+    if (op->get_attr<bool>(op_attr::with_scale)) {
+        arg_indices.insert({DNNL_ARG_SCALE, indices_t {input, in_idx++}});
+    }
+    if (op->get_attr<bool>(op_attr::with_mask)) {
+        arg_indices.insert(
+                {DNNL_ARG_SRC_3, indices_t {input, in_idx++}}); // mask
+        if (op->has_attr(op_attr::with_select)
+                && op->get_attr<bool>(op_attr::with_select)) {
+            arg_indices.insert(
+                    {DNNL_ARG_SRC_4, indices_t {input, in_idx++}}); // fill
+        }
+    }
+
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, 0}});
+    arg_indices.insert({DNNL_ARG_SCRATCHPAD, indices_t {output, 1}});
+
+    return arg_indices;
+}
+
+arg_indices_t masked_softmax_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(op);
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+
+    arg_indices.insert({DNNL_ARG_SRC_0, indices_t {input, 0}}); // src
+    arg_indices.insert({DNNL_ARG_SRC_1, indices_t {input, 1}}); // cond
+    arg_indices.insert({DNNL_ARG_SRC_2, indices_t {input, 2}}); // fill
+
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, 0}});
+    arg_indices.insert({DNNL_ARG_SCRATCHPAD, indices_t {output, 1}});
+
+    return arg_indices;
+}
+
+arg_indices_t mlp_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+
+    const bool is_gated = op->get_attr<bool>(op_attr::is_gated);
+    size_t in_idx = 0;
+    arg_indices.insert({DNNL_ARG_SRC, indices_t {input, in_idx++}});
+    arg_indices.insert({DNNL_ARG_WEIGHTS_0, indices_t {input, in_idx++}});
+    if (is_gated) {
+        arg_indices.insert(
+                {DNNL_ARG_WEIGHTS_1, indices_t {input, in_idx++}}); // up
+    }
+    arg_indices.insert(
+            {DNNL_ARG_WEIGHTS_2, indices_t {input, in_idx++}}); // down
+    if (op->get_attr<bool>(op_attr::with_bias)) {
+        arg_indices.insert({DNNL_ARG_SRC_1, indices_t {input, in_idx++}});
+        if (is_gated) {
+            arg_indices.insert(
+                    {DNNL_ARG_SRC_2, indices_t {input, in_idx++}}); // up
+        }
+        arg_indices.insert(
+                {DNNL_ARG_SRC_3, indices_t {input, in_idx++}}); // down
+    }
+
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, 0}});
+    arg_indices.insert({DNNL_ARG_SCRATCHPAD, indices_t {output, 1}});
+
+    return arg_indices;
+}
+
 arg_indices_t conv_bwd_data_executable_t::get_arg_indices(
         const op_t *op, fusion_info_mgr_t &mgr) {
     UNUSED(mgr);
@@ -1995,6 +2872,65 @@ arg_indices_t batchnorm_bwd_executable_t::get_arg_indices(
     return arg_indices;
 }
 
+arg_indices_t groupnorm_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    arg_indices_t arg_indices;
+
+    size_t in_index = 0;
+    arg_indices.insert({DNNL_ARG_SRC, indices_t {input, in_index++}});
+    if (!op->has_attr(op_attr::use_affine)
+            || op->get_attr<bool>(op_attr::use_affine)) {
+        arg_indices.insert({DNNL_ARG_SCALE, indices_t {input, in_index++}});
+        arg_indices.insert({DNNL_ARG_SHIFT, indices_t {input, in_index++}});
+    }
+
+    get_arg_indices_for_post_ops(op, mgr, arg_indices, in_index);
+
+    const fusion_info_t &fusion_info
+            = (op->has_attr(op_attr::fusion_info_key)
+                      && op->get_attr<int64_t>(op_attr::fusion_info_key) != -1)
+            ? mgr.get_info(op->get_attr<int64_t>(op_attr::fusion_info_key))
+            : fusion_info_t();
+
+    if (fusion_info.with_runtime_scales(false, 0)) {
+        arg_indices.insert({DNNL_ARG_ATTR_SCALES | DNNL_ARG_DST,
+                indices_t {input, in_index++}});
+    }
+
+    size_t out_index = 0;
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, out_index++}});
+    if (!op->has_attr(op_attr::keep_stats)
+            || op->get_attr<bool>(op_attr::keep_stats)) {
+        arg_indices.insert({DNNL_ARG_MEAN, indices_t {output, out_index++}});
+        arg_indices.insert(
+                {DNNL_ARG_VARIANCE, indices_t {output, out_index++}});
+    }
+
+    if (op->num_outputs() > out_index) {
+        arg_indices.insert(
+                {DNNL_ARG_SCRATCHPAD, indices_t {output, out_index++}});
+    }
+
+    return arg_indices;
+}
+
+arg_indices_t embedding_bag_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+
+    arg_indices.insert({DNNL_ARG_SRC, indices_t {input, 0}});
+    arg_indices.insert({DNNL_ARG_SRC_1, indices_t {input, 1}});
+    arg_indices.insert({DNNL_ARG_SRC_2, indices_t {input, 2}});
+    if (op->num_inputs() > 3) {
+        arg_indices.insert({DNNL_ARG_WEIGHTS, indices_t {input, 3}});
+    }
+
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, 0}});
+    arg_indices.insert({DNNL_ARG_SCRATCHPAD, indices_t {output, 1}});
+    return arg_indices;
+}
+
 arg_indices_t layernorm_executable_t::get_arg_indices(
         const op_t *op, fusion_info_mgr_t &mgr) {
     UNUSED(mgr);
@@ -183,9 +183,7 @@ struct memory_reparser_t : public dummy_impl_t {
 
     void execute(const stream &stream,
             const std::unordered_map<int, memory> &args) const override {
-        assertm(args.find(DNNL_ARG_FROM)->second.get_data_handle()
-                        == args.find(DNNL_ARG_TO)->second.get_data_handle(),
-                "memory reparser must be inplaced");
+        forward_data_handle(args);
         dummy_impl_t::execute(stream, args);
     }
 
@@ -193,12 +191,65 @@ struct memory_reparser_t : public dummy_impl_t {
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
             const std::vector<::sycl::event> &deps = {}) const override {
-        assertm(args.find(DNNL_ARG_FROM)->second.get_data_handle()
-                        == args.find(DNNL_ARG_TO)->second.get_data_handle(),
-                "memory reparser must be inplaced");
+        forward_data_handle(args);
         return dummy_impl_t::execute_sycl(stream, args, deps);
     }
 #endif
+
+private:
+    // The input and output share the same buffer. The input handle differs
+    // only if the input is a view moved into the buffer by memory_slicer_t,
+    // and the output must follow it.
+    static void forward_data_handle(
+            const std::unordered_map<int, memory> &args) {
+        const memory &from = args.find(DNNL_ARG_FROM)->second;
+        memory to = args.find(DNNL_ARG_TO)->second;
+        if (from.get_data_handle() != to.get_data_handle())
+            to.set_data_handle(from.get_data_handle());
+    }
+};
+
+// Makes the output a view of a slice of the input by pointing the output memory
+// into the input buffer, no data is copied. The planner assigns the input's
+// buffer to the output.
+struct memory_slicer_t : public dummy_impl_t {
+    DECLARE_ARG_INDICES_GETTER;
+
+    memory_slicer_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+            fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+        UNUSED(p_engine);
+        UNUSED(mgr);
+        UNUSED(pd_cache);
+        const memory::desc in_md = make_dnnl_memory_desc(
+                op->get_input_value(0)->get_logical_tensor());
+        int64_t axis = op->get_attr<int64_t>(op_attr::axis);
+        if (axis < 0) axis += in_md.get_ndims();
+        byte_offset_ = op->get_attr<int64_t>(op_attr::slice_offset)
+                * in_md.get_strides()[axis]
+                * static_cast<dim_t>(
+                        memory::data_type_size(in_md.get_data_type()));
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override {
+        UNUSED(stream);
+        const memory &from = args.find(DNNL_ARG_FROM)->second;
+        memory to = args.find(DNNL_ARG_TO)->second;
+        to.set_data_handle(
+                static_cast<char *>(from.get_data_handle()) + byte_offset_);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        execute(stream, args);
+        return dummy_impl_t::execute_sycl(stream, args, deps);
+    }
+#endif
+
+private:
+    dim_t byte_offset_;
 };
 
 template <op_attr_t attr_name, typename attr_dt, typename target_dt>
@@ -1185,6 +1236,204 @@ private:
     dnnl::binary sub_prim_;
 };
 
+// sdpa_executable_t computes the scaled dot-product attention
+// softmax(Q * K^T [*|/ scale] [+ mask]) * V in one pass over the key sequence.
+// Instead of being added, the mask can be the condition of a select which
+// replaces the masked scores with a fill value.
+// Work is split over batch, head and query blocks. For each query block the
+// scores of one key block at a time are kept in a small per-thread buffer and
+// the softmax is computed online, so the [Sq, Sk] score matrix is never
+// materialized. K^T and V are packed once per head before that, so all the
+// query blocks of a head share the packed keys and values.
+struct sdpa_executable_t : public op_executable_t {
+    DECLARE_ARG_INDICES_GETTER
+
+    // sdpa_executable_t is not backed by a primitive, so we need a customized
+    // desc class to describe it.
+    class desc_t {
+        friend struct sdpa_executable_t;
+
+        memory::desc q_desc_;
+        memory::desc k_desc_;
+        memory::desc v_desc_;
+        memory::desc mask_desc_;
+        memory::desc dst_desc_;
+        memory::desc scratchpad_desc_;
+
+        bool with_scale_ {false};
+        bool with_mask_ {false};
+        bool with_select_ {false};
+        bool select_scores_in_else_ {false};
+        bool is_div_scale_ {false};
+        bool transpose_b_ {false};
+
+        int nthr_ {1};
+        dim_t q_block_ {0};
+        dim_t k_block_ {0};
+        // sizes of the packed k^T and v of all the heads, in floats
+        dim_t kt_pack_size_ {0};
+        dim_t v_pack_size_ {0};
+        // size of the scratchpad used by each thread, in floats
+        dim_t thr_buf_size_ {0};
+
+    public:
+        const memory::desc &scratchpad_desc() const { return scratchpad_desc_; }
+    };
+
+    static desc_t create_desc(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache);
+
+    sdpa_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+            fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+        desc_ = create_desc(op, p_engine, mgr, pd_cache);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override;
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        // The kernel runs on the host, so only the cpu engine is supported.
+        ::sycl::event::wait(deps);
+        execute(stream, args);
+        return ::sycl::event();
+    }
+#endif
+
+private:
+    desc_t desc_;
+};
+
+// masked_softmax_executable_t computes softmax(select(cond, src, fill)) over
+// the last axis, where fill has one element and cond is broadcast to src. The
+// masked row is built, normalized and written in one pass over dst, so the
+// select result is never stored separately.
+struct masked_softmax_executable_t : public op_executable_t {
+    DECLARE_ARG_INDICES_GETTER
+
+    // masked_softmax_executable_t is not backed by a primitive, so we need a
+    // customized desc class to describe it.
+    class desc_t {
+        friend struct masked_softmax_executable_t;
+
+        memory::desc src_desc_;
+        memory::desc cond_desc_;
+        memory::desc fill_desc_;
+        memory::desc dst_desc_;
+        memory::desc scratchpad_desc_;
+
+        // src is kept where cond is false instead of true
+        bool scores_in_else_ {false};
+
+    public:
+        const memory::desc &src_desc() const { return src_desc_; }
+        const memory::desc &cond_desc() const { return cond_desc_; }
+        const memory::desc &fill_desc() const { return fill_desc_; }
+        const memory::desc &dst_desc() const { return dst_desc_; }
+        const memory::desc &scratchpad_desc() const { return scratchpad_desc_; }
+    };
+
+    static desc_t create_desc(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache);
+
+    masked_softmax_executable_t(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache) {
+        desc_ = create_desc(op, p_engine, mgr, pd_cache);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override;
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        // The kernel runs on the host, so only the cpu engine is supported.
+        ::sycl::event::wait(deps);
+        execute(stream, args);
+        return ::sycl::event();
+    }
+#endif
+
+private:
+    desc_t desc_;
+};
+
+// mlp_executable_t computes the feed-forward block
+// act(src * W [+ b]) [* (src * W_up [+ b_up])] * W_down [+ b_down]. The N1
+// dim is split into chunks, and the weights of one chunk (the columns of W
+// and W_up and the rows of W_down) are applied to all the row blocks of a
+// thread before moving on, so the weight slab stays in cache instead of being
+// streamed once per row block. The intermediate of a row block and chunk is
+// kept in a small per-thread buffer, and dst is accumulated across chunks.
+struct mlp_executable_t : public op_executable_t {
+    DECLARE_ARG_INDICES_GETTER
+
+    // mlp_executable_t is not backed by a primitive, so we need a customized
+    // desc class to describe it.
+    class desc_t {
+        friend struct mlp_executable_t;
+
+        memory::desc src_desc_;
+        memory::desc wei_desc_;
+        memory::desc wei_up_desc_;
+        memory::desc wei_down_desc_;
+        memory::desc dst_desc_;
+        memory::desc scratchpad_desc_;
+
+        algorithm alg_ {algorithm::undef};
+        float alpha_ {0.f};
+        bool is_gated_ {false};
+        bool with_bias_ {false};
+        bool transpose_b_ {false};
+
+        dim_t M_ {0};
+        dim_t K_ {0};
+        dim_t N1_ {0};
+        dim_t N2_ {0};
+
+        int nthr_ {1};
+        dim_t row_block_ {0};
+        dim_t n1_block_ {0};
+        // size of the scratchpad used by each thread, in floats
+        dim_t thr_buf_size_ {0};
+
+    public:
+        const memory::desc &scratchpad_desc() const { return scratchpad_desc_; }
+    };
+
+    static desc_t create_desc(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache);
+
+    mlp_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+            fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+        desc_ = create_desc(op, p_engine, mgr, pd_cache);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override;
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        // The kernel runs on the host, so only the cpu engine is supported.
+        ::sycl::event::wait(deps);
+        execute(stream, args);
+        return ::sycl::event();
+    }
+#endif
+
+private:
+    desc_t desc_;
+};
+
 struct conv_bwd_data_executable_t : public op_executable_t {
     DECLARE_DESC_CLASS_AND_CREATOR(
             dnnl::convolution_backward_data::primitive_desc);
@@ -1510,6 +1759,123 @@ private:
     dnnl::layer_normalization_forward prim_;
 };
 
+struct groupnorm_executable_t : public op_executable_t {
+    DECLARE_DESC_CLASS_AND_CREATOR(
+            dnnl::group_normalization_forward::primitive_desc);
+    DECLARE_ARG_INDICES_GETTER;
+
+    groupnorm_executable_t(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache) {
+        auto desc = create_desc(op, p_engine, mgr, pd_cache);
+        prim_ = dnnl::group_normalization_forward(desc);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override {
+        prim_.execute(stream, args);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        auto e = dnnl::sycl_interop::execute(prim_, stream, args, deps);
+        if (stream.get_engine().get_kind() == engine::kind::cpu) e.wait();
+        return e;
+    }
+#endif
+
+private:
+    dnnl::group_normalization_forward prim_;
+};
+
+struct embedding_bag_executable_t : public op_executable_t {
+    DECLARE_DESC_CLASS_AND_CREATOR(dnnl::embedding_bag::primitive_desc);
+    DECLARE_ARG_INDICES_GETTER;
+
+    embedding_bag_executable_t(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache) {
+        auto desc = create_desc(op, p_engine, mgr, pd_cache);
+        prim_ = dnnl::embedding_bag(desc);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override {
+        prim_.execute(stream, args);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        auto e = dnnl::sycl_interop::execute(prim_, stream, args, deps);
+        if (stream.get_engine().get_kind() == engine::kind::cpu) e.wait();
+        return e;
+    }
+#endif
+
+private:
+    dnnl::embedding_bag prim_;
+};
+
+// gather_executable_t copies the slices of data selected by indices along
+// axis. Data is viewed as [outer, axis_dim, inner], so every gathered index
+// copies one contiguous block of inner elements.
+struct gather_executable_t : public op_executable_t {
+    DECLARE_ARG_INDICES_GETTER
+
+    // gather_executable_t is not backed by a primitive, so we need a
+    // customized desc class to describe it.
+    class desc_t {
+        friend struct gather_executable_t;
+
+        memory::desc data_desc_;
+        memory::desc indices_desc_;
+        memory::desc dst_desc_;
+        memory::desc scratchpad_desc_;
+
+        dim_t outer_ {0};
+        dim_t axis_dim_ {0};
+        dim_t n_indices_ {0};
+        // size of one gathered slice, in bytes
+        size_t inner_bytes_ {0};
+
+    public:
+        const memory::desc &data_desc() const { return data_desc_; }
+        const memory::desc &indices_desc() const { return indices_desc_; }
+        const memory::desc &dst_desc() const { return dst_desc_; }
+        const memory::desc &scratchpad_desc() const { return scratchpad_desc_; }
+    };
+
+    static desc_t create_desc(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache);
+
+    gather_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+            fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+        desc_ = create_desc(op, p_engine, mgr, pd_cache);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override;
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        // The kernel runs on the host, so only the cpu engine is supported.
+        ::sycl::event::wait(deps);
+        execute(stream, args);
+        return ::sycl::event();
+    }
+#endif
+
+private:
+    desc_t desc_;
+};
+
 struct layernorm_bwd_executable_t : public op_executable_t {
     DECLARE_DESC_CLASS_AND_CREATOR(
             dnnl::layer_normalization_backward::primitive_desc);
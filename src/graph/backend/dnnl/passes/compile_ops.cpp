@@ -26,6 +26,7 @@
 #include "graph/backend/dnnl/internal_attrs.hpp"
 #include "graph/backend/dnnl/op_executable.hpp"
 #include "graph/backend/dnnl/passes/compile_ops.hpp"
+#include "graph/backend/dnnl/passes/utils.hpp"
 
 #include "oneapi/dnnl/dnnl.hpp"
 
@@ -43,6 +44,7 @@ status_t compile_ops(std::shared_ptr<subgraph_t> &sg) {
     auto &mgr = sg->fusion_info_mgr_;
     const auto &p_engine = *(sg->p_engine_);
     auto &pd_cache = sg->pd_cache_;
+    const auto levels = get_op_levels(sg);
 
     return topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
         const op_schema_t *opm
@@ -71,6 +73,7 @@ status_t compile_ops(std::shared_ptr<subgraph_t> &sg) {
         sg->execs_.emplace_back(exec);
         sg->is_constant_.push_back(op->has_attr(op_attr::is_constant)
                 && op->get_attr<bool>(op_attr::is_constant));
+        sg->exec_levels_.push_back(levels.at(op));
         return status::success;
     });
 }
@@ -45,6 +45,7 @@ bool has_scratchpad(const op_t *op) {
             op_kind::dnnl_unsqueeze,
             op_kind::dnnl_transpose,
             op_kind::dnnl_reshape,
+            op_kind::dnnl_slice,
     };
 
     // the following ops may have scratchpad output if output size > 1
@@ -14,17 +14,26 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "oneapi/dnnl/dnnl.hpp"
 
+#include "common/primitive_desc.hpp"
+#include "common/primitive_desc_iface.hpp"
+
 #include "graph/interface/c_types_map.hpp"
 #include "graph/interface/value.hpp"
 
 #include "graph/backend/dnnl/common.hpp"
+#include "graph/backend/dnnl/internal_attrs.hpp"
 #include "graph/backend/dnnl/layout_propagator.hpp"
+#include "graph/backend/dnnl/op_executable.hpp"
+#include "graph/backend/dnnl/passes/layout_propagation.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -35,6 +44,270 @@ using op_ptr = std::shared_ptr<op_t>;
 using value_ptr = std::shared_ptr<value_t>;
 using ltw = logical_tensor_wrapper_t;
 
+namespace {
+// The kernel layouts and estimated memory traffic of one candidate of a
+// compute op
+struct layout_candidate_t {
+    memory::desc src;
+    memory::desc dst;
+    // position of the implementation in the dispatch list of the primitive
+    int impl_idx = -1;
+    double cost = 0.0; // in bytes
+};
+
+// A compute op whose activation layouts are decided by layout assignment.
+// Candidate 0 is the layout preferred by the primitive (any), candidate 1 is
+// the plain layout.
+struct layout_node_t {
+    op_t *op;
+    layout_candidate_t cands[2];
+    bool has_choice;
+};
+
+// The data is read and written once
+double reorder_cost(const memory::desc &md) {
+    return 2.0 * static_cast<double>(md.get_size());
+}
+
+// Compares the layouts of two descs with the same dims regardless of their
+// data types
+bool is_same_layout(const memory::desc &a, const memory::desc &b) {
+    if (a.get_format_kind() != format_kind::blocked
+            || b.get_format_kind() != format_kind::blocked)
+        return a == b;
+    return a.get_strides() == b.get_strides()
+            && a.get_inner_blks() == b.get_inner_blks()
+            && a.get_inner_idxs() == b.get_inner_idxs();
+}
+
+// Ops which produce their output in the layout of their first input
+bool is_layout_transparent(op_t &op) {
+    if (op.get_kind() != op_kind::dnnl_eltwise
+            && op.get_kind() != op_kind::dnnl_binary)
+        return false;
+    return ltw(op.get_input_value(0)->get_logical_tensor()).vdims()
+            == ltw(op.get_output_value(0)->get_logical_tensor()).vdims();
+}
+
+// Creates the primitive desc of the op with any or plain activations and
+// records the layouts and the implementation it gets. The desc is created
+// aside from the subgraph's cache, so that the layout propagation only sees
+// the final one.
+template <typename pd_t>
+void init_layout_candidate(const pd_t &pd, layout_candidate_t &cand) {
+    cand.src = pd.src_desc();
+    cand.dst = pd.dst_desc();
+    cand.impl_idx = pd.get()->impl()->pd_iterator_offset();
+    cand.cost = static_cast<double>(cand.src.get_size() + cand.dst.get_size());
+}
+
+status_t get_layout_candidate(op_ptr &op, bool use_plain,
+        const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+        layout_candidate_t &cand) {
+    op->set_attr<bool>(op_attr::use_plain_layout, use_plain);
+    pd_cache_t pd_cache;
+    if (op->get_kind() == op_kind::dnnl_convolution) {
+        init_layout_candidate(conv_fwd_executable_t::create_desc(
+                                      op, p_engine, mgr, pd_cache),
+                cand);
+    } else if (op->get_kind() == op_kind::dnnl_convtranspose) {
+        init_layout_candidate(deconv_fwd_executable_t::create_desc(
+                                      op, p_engine, mgr, pd_cache),
+                cand);
+    } else if (op->get_kind() == op_kind::dnnl_matmul) {
+        init_layout_candidate(matmul_executable_t::create_desc(
+                                      op, p_engine, mgr, pd_cache),
+                cand);
+    } else {
+        return status::unimplemented;
+    }
+    return status::success;
+}
+} // namespace
+
+/// Chooses the activation layouts of the compute ops over the whole subgraph
+/// instead of op by op. Each convolution, deconvolution and matmul can use
+/// the layout preferred by its primitive (any) or the plain layout, as long as
+/// the primitive keeps the same implementation for both. The ops then differ
+/// only by the memory they move, so the cost of an assignment is the bytes of
+/// the kernel activations plus the reorders needed where connected ops or the
+/// partition inputs and outputs disagree. No compute throughput is modelled.
+/// Eltwise and binary ops keep the layout of their input, so they connect
+/// the compute ops around them. Other ops follow the layout they are given
+/// and are not charged. The assignment with the lowest total cost is searched
+/// exhaustively for up to 12 free ops and greedily otherwise, starting from
+/// the op by op choice, so the result is never estimated worse than that.
+///
+/// The choice is given to the layout propagation by the use_plain_layout
+/// attribute and recorded in the layout_plan attribute for the graph dump.
+status_t layout_assignment(std::shared_ptr<subgraph_t> &sg) {
+    const auto &p_engine = *(sg->p_engine_);
+    auto &mgr = sg->fusion_info_mgr_;
+    const bool is_cpu = p_engine.get_kind() == dnnl::engine::kind::cpu;
+
+    std::vector<layout_node_t> nodes;
+    std::unordered_map<op_t *, size_t> node_idx;
+    for (auto cur_op : sg->get_ops()) {
+        if (!graph::utils::one_of(cur_op->get_kind(),
+                    op_kind::dnnl_convolution, op_kind::dnnl_convtranspose,
+                    op_kind::dnnl_matmul))
+            continue;
+        if (cur_op->has_attr(op_attr::fusion_info_key)
+                && cur_op->get_attr<int64_t>(op_attr::fusion_info_key) != -1
+                && mgr.get_info(cur_op->get_attr<int64_t>(
+                                        op_attr::fusion_info_key))
+                           .has_post_dw_conv())
+            continue;
+
+        layout_node_t node {cur_op.get(), {}, false};
+        if (cur_op->get_kind() == op_kind::dnnl_convolution && is_cpu) {
+            // convolution always uses nxc activations on cpu
+            for (auto &cand : node.cands) {
+                cand.src = to_nxc_format(make_dnnl_memory_desc(
+                        cur_op->get_input_value(0)->get_logical_tensor()));
+                cand.dst = to_nxc_format(make_dnnl_memory_desc(
+                        cur_op->get_output_value(0)->get_logical_tensor()));
+            }
+        } else {
+            for (size_t i = 0; i < 2; i++) {
+                CHECK(get_layout_candidate(
+                        cur_op, i == 1, p_engine, mgr, node.cands[i]));
+            }
+            cur_op->set_attr<bool>(op_attr::use_plain_layout, false);
+            // A plain layout which makes the primitive fall back to another
+            // implementation is never preferred over the dispatch order.
+            node.has_choice
+                    = node.cands[0].impl_idx == node.cands[1].impl_idx
+                    && (!is_same_layout(node.cands[0].src, node.cands[1].src)
+                            || !is_same_layout(
+                                    node.cands[0].dst, node.cands[1].dst));
+        }
+        node_idx[cur_op.get()] = nodes.size();
+        nodes.emplace_back(node);
+    }
+
+    std::vector<size_t> vars;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].has_choice) vars.emplace_back(i);
+    }
+    if (vars.empty()) return status::success;
+
+    // the producer of node.src -> node, and the node -> consumer of node.dst
+    // connections through layout transparent ops
+    struct edge_t {
+        size_t from;
+        size_t to;
+    };
+    std::vector<edge_t> edges;
+    // connections to the partition inputs and outputs with a given layout
+    std::vector<std::pair<size_t, memory::desc>> in_bounds, out_bounds;
+    const auto is_sg_output = [&](const value_t *val) {
+        const size_t id = val->get_logical_tensor().id;
+        return std::any_of(sg->outs_.begin(), sg->outs_.end(),
+                [&](const logical_tensor_t &lt) { return lt.id == id; });
+    };
+    for (size_t i = 0; i < nodes.size(); i++) {
+        value_t *val = nodes[i].op->get_input_value(0).get();
+        while (val->has_producer()
+                && is_layout_transparent(val->get_producer()))
+            val = val->get_producer().get_input_value(0).get();
+        const auto &in_lt = val->get_logical_tensor();
+        if (!val->has_producer() && ltw(in_lt).is_strided())
+            in_bounds.emplace_back(i, make_dnnl_memory_desc(in_lt));
+
+        std::vector<value_t *> to_visit {
+                nodes[i].op->get_output_value(0).get()};
+        while (!to_visit.empty()) {
+            val = to_visit.back();
+            to_visit.pop_back();
+            const auto &out_lt = val->get_logical_tensor();
+            if (is_sg_output(val) && ltw(out_lt).is_strided())
+                out_bounds.emplace_back(i, make_dnnl_memory_desc(out_lt));
+            for (const auto &consumer : val->get_consumers()) {
+                op_t &next = consumer.get_op();
+                if (consumer.get_offset() != 0) continue;
+                if (is_layout_transparent(next)) {
+                    to_visit.emplace_back(next.get_output_value(0).get());
+                } else if (node_idx.count(&next)) {
+                    edges.push_back({i, node_idx.at(&next)});
+                }
+            }
+        }
+    }
+
+    // label 0 is any and label 1 is plain
+    std::vector<size_t> labels(nodes.size(), 0);
+    const auto total_cost = [&]() {
+        double cost = 0.0;
+        for (size_t i = 0; i < nodes.size(); i++)
+            cost += nodes[i].cands[labels[i]].cost;
+        for (const auto &b : in_bounds) {
+            const auto &src = nodes[b.first].cands[labels[b.first]].src;
+            if (!is_same_layout(b.second, src)) cost += reorder_cost(src);
+        }
+        for (const auto &b : out_bounds) {
+            const auto &dst = nodes[b.first].cands[labels[b.first]].dst;
+            if (!is_same_layout(b.second, dst)) cost += reorder_cost(dst);
+        }
+        for (const auto &e : edges) {
+            const auto &dst = nodes[e.from].cands[labels[e.from]].dst;
+            const auto &src = nodes[e.to].cands[labels[e.to]].src;
+            if (!is_same_layout(dst, src)) cost += reorder_cost(src);
+        }
+        return cost;
+    };
+
+    const double default_cost = total_cost();
+    double best_cost = default_cost;
+    std::vector<size_t> best_labels = labels;
+    const size_t max_exhaustive_vars = 12;
+    if (vars.size() <= max_exhaustive_vars) {
+        for (size_t mask = 1; mask < (size_t(1) << vars.size()); mask++) {
+            for (size_t v = 0; v < vars.size(); v++)
+                labels[vars[v]] = (mask >> v) & 1;
+            const double cost = total_cost();
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_labels = labels;
+            }
+        }
+    } else {
+        // flip single ops while it helps
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (size_t v : vars) {
+                labels[v] ^= 1;
+                const double cost = total_cost();
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    improved = true;
+                } else {
+                    labels[v] ^= 1;
+                }
+            }
+        }
+        best_labels = labels;
+    }
+
+    for (size_t v : vars) {
+        const layout_node_t &node = nodes[v];
+        const size_t label = best_labels[v];
+        node.op->set_attr<bool>(op_attr::use_plain_layout, label == 1);
+        // (chosen layout):(bytes of the kernel):(bytes of the kernel with the
+        // other layout):(bytes of the subgraph with the op by op layouts):
+        // (bytes of the subgraph with the plan)
+        std::ostringstream plan;
+        plan << (label == 1 ? "plain" : "any") << ":"
+             << static_cast<int64_t>(node.cands[label].cost) << ":"
+             << static_cast<int64_t>(node.cands[1 - label].cost) << ":"
+             << static_cast<int64_t>(default_cost) << ":"
+             << static_cast<int64_t>(best_cost);
+        node.op->set_attr<std::string>(op_attr::layout_plan, plan.str());
+    }
+    return status::success;
+}
+
 bool need_prop_once_more(const std::shared_ptr<subgraph_t> &sg) {
     for (const auto &cur_op : sg->get_ops()) {
         for (const auto &in : cur_op->get_input_values()) {
@@ -31,6 +31,11 @@ namespace impl {
 namespace graph {
 namespace dnnl_impl {
 
+// Chooses the activation layouts of the compute ops by a cost model over the
+// whole subgraph. It should run right before layout_propagation. The pass is
+// opt-in through the internal GRAPH_LAYOUT_ASSIGNMENT environment variable.
+status_t layout_assignment(std::shared_ptr<subgraph_t> &sg);
+
 status_t layout_propagation(std::shared_ptr<subgraph_t> &sg);
 
 } // namespace dnnl_impl
@@ -86,6 +86,34 @@ static status_t binary_handler(
     return status::success;
 }
 
+static status_t select_handler(
+        const std::shared_ptr<op_t> &op, subgraph_rewriter_t &rewriter) {
+    auto new_op = std::make_shared<op_t>(op_kind::dnnl_binary);
+    new_op->set_attr<int64_t>(op_attr::alg_kind,
+            static_cast<int64_t>(dnnl::algorithm::binary_select));
+    new_op->merge_attributes(op->get_attributes());
+
+    // Select takes (cond, then, else), while the binary select primitive
+    // takes the condition as its third source.
+    const size_t new_offsets[] = {2, 0, 1};
+    std::vector<value_ptr> new_inputs(op->num_inputs());
+    for (size_t i = 0; i < op->num_inputs(); i++) {
+        auto in_val = op->get_input_value(i);
+        in_val->remove_consumer(*op, i);
+        new_inputs[new_offsets[i]] = in_val;
+    }
+    for (size_t i = 0; i < new_inputs.size(); i++) {
+        new_inputs[i]->add_consumer(*new_op, i);
+        new_op->add_input(new_inputs[i]);
+    }
+    new_op->add_output(op->get_output_value(0));
+    insert_empty_scratchpad(new_op);
+
+    rewriter.to_insert(new_op);
+    rewriter.to_remove(op);
+    return status::success;
+}
+
 static status_t bias_add_handler(
         const std::shared_ptr<op_t> &op, subgraph_rewriter_t &rewriter) {
     auto new_op = std::make_shared<op_t>(op_kind::dnnl_binary);
@@ -600,6 +628,7 @@ static const std::unordered_map<graph::op_kind_t, handler_func> handler_table {
         ITEM(Divide, binary_handler),
         ITEM(Minimum, binary_handler),
         ITEM(Maximum, binary_handler),
+        ITEM(Select, select_handler),
         // eltwise fwd
         ITEM(Abs, eltwise_fwd_handler),
         ITEM(Clamp, eltwise_fwd_handler),
@@ -610,6 +639,7 @@ static const std::unordered_map<graph::op_kind_t, handler_func> handler_table {
         ITEM(LeakyReLU, eltwise_fwd_handler),
         ITEM(Log, eltwise_fwd_handler),
         ITEM(Mish, eltwise_fwd_handler),
+        ITEM(Pow, eltwise_fwd_handler),
         ITEM(ReLU, eltwise_fwd_handler),
         ITEM(Round, eltwise_fwd_handler),
         ITEM(Sigmoid, eltwise_fwd_handler),
@@ -653,6 +683,12 @@ static const std::unordered_map<graph::op_kind_t, handler_func> handler_table {
         // layernorm
         ITEM(LayerNorm, common_handler<op_kind::kDnnl_layernorm>),
         ITEM(LayerNormBackward, common_handler<op_kind::kDnnl_layernorm_bwd>),
+        // groupnorm
+        ITEM(GroupNorm, common_handler<op_kind::kDnnl_groupnorm>),
+        // embedding bag
+        ITEM(EmbeddingBag, common_handler<op_kind::kDnnl_embedding_bag>),
+        // gather
+        ITEM(Gather, common_handler<op_kind::kDnnl_gather>),
         // quantization
         ITEM(Quantize, static_quant_handler),
         ITEM(Dequantize, static_dequant_handler),
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -24,6 +25,7 @@
 #include "graph/interface/c_types_map.hpp"
 #include "graph/interface/value.hpp"
 
+#include "graph/backend/dnnl/cache_blob.hpp"
 #include "graph/backend/dnnl/common.hpp"
 #include "graph/backend/dnnl/op_executable.hpp"
 
@@ -84,7 +86,12 @@ std::vector<op_inplace_pair_t> get_op_inplace_pairs(
                 index += 1;
             }
         } else if (op.get_kind() == op_kind::dnnl_binary) {
-            index = 2;
+            // select takes the condition as the third input
+            index = static_cast<dnnl::algorithm>(
+                            op.get_attr<int64_t>(op_attr::alg_kind))
+                            == dnnl::algorithm::binary_select
+                    ? 3
+                    : 2;
         } else {
             // do nothing
         }
@@ -454,8 +461,11 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
         const std::unordered_map<value_t *, size_t> &edge_ref_count,
         fusion_info_mgr_t &mgr, bool enable_standard_sharing) {
     std::unordered_map<size_t, size_t> temporary_buffer_ref_count;
+    // The temporary buffers which are partly viewed by dnnl_slice outputs.
+    // They can't be reused inplace since the views point into them.
+    std::unordered_set<size_t> sliced_buffers;
 
-    auto func = [&](op_t *op) {
+    auto allocate = [&](op_t *op) {
         // Handle alias first
         auto inputs = op->get_input_values();
         for (auto &in : inputs) {
@@ -469,13 +479,30 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
             }
         }
 
+        // Handle slice, the output is a view into the input buffer
+        if (op->get_kind() == op_kind::dnnl_slice) {
+            value_t *in = op->get_input_value(0).get();
+            value_t *out = op->get_output_value(0).get();
+            assign_info_t info = buffer_assignments_.at(in);
+            if (!buffer_assignments_.count(out)) {
+                buffer_assignments_.insert(std::make_pair(out, info));
+                if (info.kind_ == internal_temporary) {
+                    temporary_buffer_ref_count[info.index_]
+                            += edge_ref_count.at(out);
+                    sliced_buffers.insert(info.index_);
+                }
+            }
+        }
+
         // Handle inplace
         auto op_inplace_pairs = get_op_inplace_pairs(*op, mgr);
         if (!op_inplace_pairs.empty()) {
             for (const auto &pair : op_inplace_pairs) {
                 value_t *in = op->get_input_value(pair.in_idx_).get();
                 assign_info_t info = buffer_assignments_.at(in);
-                if (info.kind_ != internal_temporary) continue;
+                if (info.kind_ != internal_temporary
+                        || sliced_buffers.count(info.index_))
+                    continue;
 
                 bool reuse_in_buffer
                         = temporary_buffer_ref_count[info.index_] == 1;
@@ -503,7 +530,9 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
                     out.get(), assign_info_t(internal_temporary, idx)));
             temporary_buffer_ref_count[idx] = edge_ref_count.at(out.get());
         }
+    };
 
+    auto release = [&](op_t *op) {
         // Free inputs
         for (auto &in : op->get_input_values()) {
             assign_info_t info = buffer_assignments_.at(in.get());
@@ -530,11 +559,35 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
                 }
             }
         }
+    };
 
+    if (!level_execution_) {
+        return topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
+            allocate(op);
+            release(op);
+            return status::success;
+        });
+    }
+
+    // The ops of a level may run concurrently, so the buffers they free can
+    // only be reused by the ops of the following levels
+    const auto op_levels = get_op_levels(sg);
+    std::vector<std::vector<op_t *>> levels;
+    status_t ret = topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
+        const size_t level = op_levels.at(op);
+        if (levels.size() <= level) levels.resize(level + 1);
+        levels[level].emplace_back(op);
         return status::success;
-    };
+    });
+    if (ret != status::success) return ret;
 
-    return topo_order_visit(sg->get_output_ops(), func);
+    for (const auto &level : levels) {
+        for (op_t *op : level)
+            allocate(op);
+        for (op_t *op : level)
+            release(op);
+    }
+    return status::success;
 }
 
 status_t memory_planner_t::prepare_subgraph_inplace_pairs(
@@ -861,6 +914,56 @@ status_t memory_planner_t::run(std::shared_ptr<subgraph_t> &sg) {
     return status::success;
 }
 
+std::string memory_planner_t::get_persistent_fingerprint(
+        const std::shared_ptr<subgraph_t> &sg,
+        std::vector<size_t> &constant_inputs) const {
+    constant_inputs.clear();
+    std::vector<uint8_t> bytes;
+    cache_blob_writer_t writer(bytes);
+    writer.write<uint64_t>(persistent_registry_.size());
+
+    // the temporary buffers are numbered in the order they are met
+    std::unordered_map<size_t, size_t> temporaries;
+    topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
+        if (!op->has_attr(op_attr::is_constant)
+                || !op->get_attr<bool>(op_attr::is_constant))
+            return status::success;
+
+        save_op_signature(op, sg->fusion_info_mgr_, writer);
+        for (const auto *vals :
+                {&op->get_input_values(), &op->get_output_values()}) {
+            for (const auto &val : *vals) {
+                auto pos = buffer_assignments_.find(val.get());
+                if (pos == buffer_assignments_.end()) {
+                    writer.write<int32_t>(-1);
+                    continue;
+                }
+
+                const assign_info_t &info = pos->second;
+                uint64_t id = info.index_;
+                if (info.kind_ == external_input) {
+                    auto it = std::find(constant_inputs.begin(),
+                            constant_inputs.end(), info.index_);
+                    id = std::distance(constant_inputs.begin(), it);
+                    if (it == constant_inputs.end())
+                        constant_inputs.emplace_back(info.index_);
+                } else if (info.kind_ == internal_temporary) {
+                    id = temporaries
+                                 .emplace(info.index_, temporaries.size())
+                                 .first->second;
+                } else if (info.kind_ == internal_persistent) {
+                    id = persistent_registry_.get(info.index_);
+                }
+                writer.write<int32_t>(info.kind_);
+                writer.write(id);
+            }
+        }
+        return status::success;
+    });
+
+    return std::string(bytes.begin(), bytes.end());
+}
+
 } // namespace dnnl_impl
 } // namespace graph
 } // namespace impl
@@ -282,6 +282,12 @@ private:
 //   as an example: when writing data to t4, t2 is not used any more, so they
 //   have disjoint live range and we can make them share same buffer.
 //
+// By default the ops are assumed to be executed one by one in topological
+// order. If the ops are executed level by level with the ops of a level
+// running concurrently (see get_op_levels), the live range of a value is
+// extended to the end of the level of its last consumer, so that the ops of a
+// level never share buffers.
+//
 // The following internal env vars can be used to control the memory planning:
 // - _ONEDNN_GRAPH_ENABLE_MEM_REUSE
 //     - 0: Disable memory sharing
@@ -314,6 +320,11 @@ public:
 
     execution_args_set_t &get_exec_args_set() { return exec_args_set_; }
 
+    // Plans the buffers for executing the ops level by level
+    void set_level_execution(bool level_execution) {
+        level_execution_ = level_execution;
+    }
+
     status_t run(std::shared_ptr<subgraph_t> &sg);
 
     const std::vector<inplace_pair_t> &get_subgraph_inplace_pairs() const {
@@ -341,6 +352,17 @@ public:
         return str;
     }
 
+    // Returns the serialized computation of the internal persistent buffers:
+    // the size of the persistent registry, the signatures of the constant ops
+    // and, for each of their values, the persistent buffer offset, the
+    // temporary buffer or the external input used. It doesn't depend on the
+    // ids, so kernels of different partitions which prepare the same constant
+    // tensors have the same fingerprint. constant_inputs is filled with the
+    // indices of the external inputs read by the constant ops.
+    std::string get_persistent_fingerprint(
+            const std::shared_ptr<subgraph_t> &sg,
+            std::vector<size_t> &constant_inputs) const;
+
 private:
     enum buffer_kind_t {
         external_input = 0,
@@ -422,6 +444,7 @@ private:
     std::unordered_map<const assign_info_t *, time_bound_t>
             external_inputs_live_range_;
     std::vector<inplace_pair_t> inplace_pairs_;
+    bool level_execution_ = false;
 };
 
 } // namespace dnnl_impl
@@ -24,6 +24,7 @@
 #include <set>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -795,6 +796,714 @@ status_t fuse_to_shuffle(std::shared_ptr<subgraph_t> &sg) {
     return status::success;
 }
 
+status_t fuse_to_sdpa(std::shared_ptr<subgraph_t> &sg) {
+    // the fused kernel runs on the host
+    if (sg->get_engine_kind() != graph::engine_kind::cpu)
+        return status::success;
+
+    const auto is_f32_4d = [](const value_ptr &val) {
+        const logical_tensor_t &lt = val->get_logical_tensor();
+        return lt.data_type == data_type::f32 && ltw(lt).ndims() == 4
+                && !ltw(lt).is_shape_unknown() && !ltw(lt).has_zero_dim();
+    };
+    const auto is_sg_output = [&](const value_ptr &val) {
+        const size_t id = val->get_logical_tensor().id;
+        return std::any_of(sg->outs_.begin(), sg->outs_.end(),
+                [&](const logical_tensor_t &lt) { return lt.id == id; });
+    };
+    // the only consumer of the op's output, if the output is internal
+    const auto single_consumer = [&](op_t *op) -> op_t * {
+        value_ptr out = op->get_output_value(0);
+        if (out->get_consumers().size() != 1 || is_sg_output(out))
+            return nullptr;
+        return &out->get_consumers()[0].get_op();
+    };
+    const auto is_binary = [](const op_t *op, algorithm alg) {
+        return op && op->get_kind() == op_kind::dnnl_binary
+                && op->get_attr<int64_t>(op_attr::alg_kind)
+                == static_cast<int64_t>(alg);
+    };
+    const auto is_transposed = [](const op_t *op, op_attr_t attr) {
+        return op->has_attr(attr) && op->get_attr<bool>(attr);
+    };
+
+    struct sdpa_group_t {
+        op_t *mm_qk;
+        op_t *scale_op;
+        op_t *mask_op;
+        op_t *softmax;
+        op_t *mm_v;
+        // offsets of the scale and mask in the inputs of their binary ops
+        size_t scale_offset;
+        size_t mask_offset;
+        // for a select mask, the offset of the fill value and whether the
+        // scores are the else input
+        size_t fill_offset;
+        bool scores_in_else;
+    };
+
+    std::vector<sdpa_group_t> groups;
+    for (const auto &cur_op : sg->get_ops()) {
+        if (cur_op->get_kind() != op_kind::dnnl_matmul
+                || cur_op->num_inputs() != 2
+                || is_transposed(cur_op.get(), op_attr::transpose_a))
+            continue;
+        if (!is_f32_4d(cur_op->get_input_value(0))
+                || !is_f32_4d(cur_op->get_input_value(1))
+                || !is_f32_4d(cur_op->get_output_value(0)))
+            continue;
+
+        sdpa_group_t group {cur_op.get(), nullptr, nullptr, nullptr, nullptr,
+                0, 0, 0, false};
+        const auto scores_dims
+                = ltw(cur_op->get_output_value(0)->get_logical_tensor())
+                          .vdims();
+        op_t *next = single_consumer(cur_op.get());
+
+        // optional scale: scores * scale or scores / scale
+        const bool is_div = is_binary(next, algorithm::binary_div);
+        if (is_div || is_binary(next, algorithm::binary_mul)) {
+            const size_t offset
+                    = next->get_input_value(0)->has_producer()
+                            && &next->get_input_value(0)->get_producer()
+                                    == group.mm_qk
+                    ? 1
+                    : 0;
+            if (is_div && offset == 0) continue;
+            const logical_tensor_t &scale_lt
+                    = next->get_input_value(offset)->get_logical_tensor();
+            if (scale_lt.data_type != data_type::f32
+                    || ltw(scale_lt).is_shape_unknown()
+                    || ltw(scale_lt).nelems() != 1
+                    || !is_f32_4d(next->get_output_value(0)))
+                continue;
+            group.scale_op = next;
+            group.scale_offset = offset;
+            next = single_consumer(next);
+        }
+
+        // optional mask: scores + mask, or select(cond, scores, fill) and
+        // select(cond, fill, scores), where the mask or cond is broadcast to
+        // the scores. Select is lowered with its inputs reordered to then,
+        // else, cond.
+        const bool is_select = is_binary(next, algorithm::binary_select);
+        if (is_select || is_binary(next, algorithm::binary_add)) {
+            const op_t *prev = group.scale_op ? group.scale_op : group.mm_qk;
+            const size_t scores_offset
+                    = next->get_input_value(0)->has_producer()
+                            && &next->get_input_value(0)->get_producer()
+                                    == prev
+                    ? 0
+                    : 1;
+            const size_t offset = is_select ? 2 : 1 - scores_offset;
+            if (is_select) {
+                const value_ptr &scores = next->get_input_value(scores_offset);
+                const logical_tensor_t &fill_lt
+                        = next->get_input_value(1 - scores_offset)
+                                  ->get_logical_tensor();
+                if (!scores->has_producer() || &scores->get_producer() != prev
+                        || fill_lt.data_type != data_type::f32
+                        || ltw(fill_lt).is_shape_unknown()
+                        || ltw(fill_lt).nelems() != 1)
+                    continue;
+            }
+            const logical_tensor_t &mask_lt
+                    = next->get_input_value(offset)->get_logical_tensor();
+            const auto mask_dt = is_select ? data_type::u8 : data_type::f32;
+            if (mask_lt.data_type != mask_dt
+                    || ltw(mask_lt).is_shape_unknown()
+                    || ltw(mask_lt).ndims() > 4
+                    || !is_f32_4d(next->get_output_value(0))
+                    || ltw(next->get_output_value(0)->get_logical_tensor())
+                                    .vdims()
+                            != scores_dims)
+                continue;
+            const auto mask_dims = ltw(mask_lt).vdims();
+            const size_t dim_offset = 4 - mask_dims.size();
+            bool broadcastable = true;
+            for (size_t i = 0; i < mask_dims.size(); i++) {
+                broadcastable = broadcastable
+                        && (mask_dims[i] == 1
+                                || mask_dims[i] == scores_dims[dim_offset + i]);
+            }
+            if (!broadcastable) continue;
+            group.mask_op = next;
+            group.mask_offset = offset;
+            group.fill_offset = 1 - scores_offset;
+            group.scores_in_else = is_select && scores_offset == 1;
+            next = single_consumer(next);
+        }
+
+        // softmax over the keys
+        if (!next || next->get_kind() != op_kind::dnnl_softmax
+                || next->num_inputs() != 1)
+            continue;
+        const int64_t axis = next->get_attr<int64_t>(op_attr::axis);
+        if ((axis != -1 && axis != 3)
+                || next->get_output_value(0)->get_logical_tensor().data_type
+                        != data_type::f32)
+            continue;
+        group.softmax = next;
+        next = single_consumer(next);
+
+        // probs * value
+        if (!next || next->get_kind() != op_kind::dnnl_matmul
+                || next->num_inputs() != 2
+                || next->get_input_value(0)
+                        != group.softmax->get_output_value(0)
+                || is_transposed(next, op_attr::transpose_a)
+                || is_transposed(next, op_attr::transpose_b)
+                || !is_f32_4d(next->get_input_value(1))
+                || !is_f32_4d(next->get_output_value(0)))
+            continue;
+        group.mm_v = next;
+
+        // The kernel takes the batch and head dims from q and broadcasts k
+        // and v along the dims of size 1. Other broadcasts are not supported.
+        const auto q_dims = ltw(group.mm_qk->get_input_value(0)
+                                        ->get_logical_tensor())
+                                    .vdims();
+        const auto k_dims = ltw(group.mm_qk->get_input_value(1)
+                                        ->get_logical_tensor())
+                                    .vdims();
+        const auto v_dims
+                = ltw(next->get_input_value(1)->get_logical_tensor()).vdims();
+        bool bcast_ok = true;
+        for (size_t i = 0; i < 2; i++) {
+            bcast_ok = bcast_ok && q_dims[i] == scores_dims[i]
+                    && (k_dims[i] == 1 || k_dims[i] == q_dims[i])
+                    && (v_dims[i] == 1 || v_dims[i] == q_dims[i]);
+        }
+        if (!bcast_ok) continue;
+
+        groups.emplace_back(group);
+    }
+
+    subgraph_rewriter_t rewriter(sg);
+    for (auto &group : groups) {
+        op_ptr sdpa = std::make_shared<op_t>(op_kind::dnnl_sdpa);
+
+        size_t in_idx = 0;
+        for (size_t i = 0; i < 2; i++) {
+            value_ptr in_value = group.mm_qk->get_input_value(i);
+            sdpa->connect_input(in_idx++, in_value);
+            in_value->remove_consumer(*group.mm_qk, i);
+        }
+        value_ptr v_value = group.mm_v->get_input_value(1);
+        sdpa->connect_input(in_idx++, v_value);
+        v_value->remove_consumer(*group.mm_v, 1);
+
+        if (group.scale_op) {
+            value_ptr scale_value
+                    = group.scale_op->get_input_value(group.scale_offset);
+            sdpa->connect_input(in_idx++, scale_value);
+            scale_value->remove_consumer(*group.scale_op, group.scale_offset);
+            sdpa->set_attr<int64_t>(op_attr::alg_kind,
+                    group.scale_op->get_attr<int64_t>(op_attr::alg_kind));
+        }
+        const bool with_select = group.mask_op
+                && is_binary(group.mask_op, algorithm::binary_select);
+        if (group.mask_op) {
+            value_ptr mask_value
+                    = group.mask_op->get_input_value(group.mask_offset);
+            sdpa->connect_input(in_idx++, mask_value);
+            mask_value->remove_consumer(*group.mask_op, group.mask_offset);
+        }
+        if (with_select) {
+            value_ptr fill_value
+                    = group.mask_op->get_input_value(group.fill_offset);
+            sdpa->connect_input(in_idx++, fill_value);
+            fill_value->remove_consumer(*group.mask_op, group.fill_offset);
+        }
+
+        sdpa->set_attr<bool>(op_attr::transpose_b,
+                is_transposed(group.mm_qk, op_attr::transpose_b));
+        sdpa->set_attr<bool>(op_attr::with_scale, group.scale_op != nullptr);
+        sdpa->set_attr<bool>(op_attr::with_mask, group.mask_op != nullptr);
+        sdpa->set_attr<bool>(op_attr::with_select, with_select);
+        sdpa->set_attr<bool>(
+                op_attr::select_scores_in_else, group.scores_in_else);
+
+        sdpa->add_output(group.mm_v->get_output_value(0));
+        insert_empty_scratchpad(sdpa);
+
+        for (op_t *op : {group.mm_qk, group.scale_op, group.mask_op,
+                     group.softmax, group.mm_v}) {
+            if (op) rewriter.to_remove(op->shared_from_this());
+        }
+        rewriter.to_insert(sdpa);
+    }
+
+    rewriter.run();
+    return status::success;
+}
+
+status_t fuse_to_masked_softmax(std::shared_ptr<subgraph_t> &sg) {
+    // the fused kernel runs on the host
+    if (sg->get_engine_kind() != graph::engine_kind::cpu)
+        return status::success;
+
+    const auto is_f32_known = [](const value_ptr &val) {
+        const logical_tensor_t &lt = val->get_logical_tensor();
+        return lt.data_type == data_type::f32 && !ltw(lt).is_shape_unknown();
+    };
+    const auto is_sg_output = [&](const value_ptr &val) {
+        const size_t id = val->get_logical_tensor().id;
+        return std::any_of(sg->outs_.begin(), sg->outs_.end(),
+                [&](const logical_tensor_t &lt) { return lt.id == id; });
+    };
+
+    // select(cond, then, else) is lowered with its inputs reordered to then,
+    // else, cond. One of then and else is the input of the softmax and the
+    // other one is the fill value.
+    std::vector<std::pair<op_t *, size_t>> fusion_groups;
+    for (const auto &cur_op : sg->get_ops()) {
+        if (cur_op->get_kind() != op_kind::dnnl_binary
+                || cur_op->get_attr<int64_t>(op_attr::alg_kind)
+                        != static_cast<int64_t>(algorithm::binary_select)
+                || cur_op->num_inputs() != 3)
+            continue;
+        value_ptr out = cur_op->get_output_value(0);
+        if (out->get_consumers().size() != 1 || is_sg_output(out)) continue;
+        op_t &softmax = out->get_consumers()[0].get_op();
+        if (softmax.get_kind() != op_kind::dnnl_softmax
+                || softmax.num_inputs() != 1
+                || !is_f32_known(softmax.get_output_value(0)))
+            continue;
+
+        const auto dims = ltw(out->get_logical_tensor()).vdims();
+        const auto ndims = static_cast<int64_t>(dims.size());
+        const int64_t axis = softmax.get_attr<int64_t>(op_attr::axis);
+        if (ndims == 0 || (axis != -1 && axis != ndims - 1)) continue;
+
+        size_t scores_offset = 0;
+        for (; scores_offset < 2; scores_offset++) {
+            const value_ptr &in = cur_op->get_input_value(scores_offset);
+            const value_ptr &other = cur_op->get_input_value(1 - scores_offset);
+            if (is_f32_known(in)
+                    && ltw(in->get_logical_tensor()).vdims() == dims
+                    && is_f32_known(other)
+                    && ltw(other->get_logical_tensor()).nelems() == 1)
+                break;
+        }
+        if (scores_offset == 2) continue;
+
+        const logical_tensor_t &cond_lt
+                = cur_op->get_input_value(2)->get_logical_tensor();
+        if (cond_lt.data_type != data_type::u8
+                || ltw(cond_lt).is_shape_unknown())
+            continue;
+        const auto cond_dims = ltw(cond_lt).vdims();
+        if (cond_dims.size() > dims.size()) continue;
+        const size_t dim_offset = dims.size() - cond_dims.size();
+        bool broadcastable = true;
+        for (size_t i = 0; i < cond_dims.size(); i++) {
+            broadcastable = broadcastable
+                    && (cond_dims[i] == 1
+                            || cond_dims[i] == dims[dim_offset + i]);
+        }
+        if (!broadcastable) continue;
+
+        fusion_groups.emplace_back(cur_op.get(), scores_offset);
+    }
+
+    subgraph_rewriter_t rewriter(sg);
+    for (auto &group : fusion_groups) {
+        op_t *select = group.first;
+        const size_t scores_offset = group.second;
+        op_t &softmax
+                = select->get_output_value(0)->get_consumers()[0].get_op();
+
+        op_ptr masked_softmax
+                = std::make_shared<op_t>(op_kind::dnnl_masked_softmax);
+        // inputs: scores, cond, fill
+        size_t in_idx = 0;
+        const size_t offsets[] = {scores_offset, 2, 1 - scores_offset};
+        for (size_t offset : offsets) {
+            value_ptr in_value = select->get_input_value(offset);
+            masked_softmax->connect_input(in_idx++, in_value);
+            in_value->remove_consumer(*select, offset);
+        }
+        masked_softmax->set_attr<bool>(
+                op_attr::select_scores_in_else, scores_offset == 1);
+
+        masked_softmax->add_output(softmax.get_output_value(0));
+        insert_empty_scratchpad(masked_softmax);
+
+        rewriter.to_remove(select->shared_from_this());
+        rewriter.to_remove(softmax.shared_from_this());
+        rewriter.to_insert(masked_softmax);
+    }
+
+    rewriter.run();
+    return status::success;
+}
+
+status_t fuse_to_mlp(std::shared_ptr<subgraph_t> &sg) {
+    // the fused kernel runs on the host
+    if (sg->get_engine_kind() != graph::engine_kind::cpu)
+        return status::success;
+
+    const auto is_f32 = [](const value_ptr &val, int32_t ndims) {
+        const logical_tensor_t &lt = val->get_logical_tensor();
+        return lt.data_type == data_type::f32 && !ltw(lt).is_shape_unknown()
+                && !ltw(lt).has_zero_dim()
+                && (ndims == -1 ? ltw(lt).ndims() >= 2
+                                : ltw(lt).ndims() == ndims);
+    };
+    const auto is_sg_output = [&](const value_ptr &val) {
+        const size_t id = val->get_logical_tensor().id;
+        return std::any_of(sg->outs_.begin(), sg->outs_.end(),
+                [&](const logical_tensor_t &lt) { return lt.id == id; });
+    };
+    // the only consumer of the op's output, if the output is internal
+    const auto single_consumer = [&](op_t *op) -> op_t * {
+        value_ptr out = op->get_output_value(0);
+        if (out->get_consumers().size() != 1 || is_sg_output(out))
+            return nullptr;
+        return &out->get_consumers()[0].get_op();
+    };
+    const auto get_bool = [](const op_t *op, op_attr_t attr) {
+        return op->has_attr(attr) && op->get_attr<bool>(attr);
+    };
+    // a plain f32 matmul with a 2D weight and an optional bias of shape [N]
+    // (or [1, ..., 1, N])
+    const auto is_plain_matmul = [&](const op_t *op) {
+        if (!op || op->get_kind() != op_kind::dnnl_matmul
+                || op->num_inputs() > 3
+                || get_bool(op, op_attr::transpose_a)
+                || (op->has_attr(op_attr::fusion_info_key)
+                        && op->get_attr<int64_t>(op_attr::fusion_info_key)
+                                != -1)
+                || !is_f32(op->get_input_value(0), -1)
+                || !is_f32(op->get_input_value(1), 2)
+                || !is_f32(op->get_output_value(0), -1))
+            return false;
+        if (op->num_inputs() < 3) return true;
+        const logical_tensor_t &bias_lt
+                = op->get_input_value(2)->get_logical_tensor();
+        const auto out_dims
+                = ltw(op->get_output_value(0)->get_logical_tensor()).vdims();
+        return bias_lt.data_type == data_type::f32
+                && !ltw(bias_lt).is_shape_unknown()
+                && ltw(bias_lt).nelems() == out_dims.back()
+                && ltw(bias_lt).vdims().back() == out_dims.back();
+    };
+
+    struct mlp_group_t {
+        op_t *mm;
+        op_t *act;
+        op_t *mul;
+        op_t *mm_up;
+        op_t *mm_down;
+    };
+
+    std::vector<mlp_group_t> groups;
+    std::unordered_set<const op_t *> visited;
+    for (const auto &cur_op : sg->get_ops()) {
+        if (!is_plain_matmul(cur_op.get()) || visited.count(cur_op.get()))
+            continue;
+
+        mlp_group_t group {cur_op.get(), nullptr, nullptr, nullptr, nullptr};
+        const bool transpose_b = get_bool(group.mm, op_attr::transpose_b);
+        const bool with_bias = group.mm->num_inputs() == 3;
+        // the other matmuls must agree on the weight layout and the bias
+        const auto is_compatible = [&](const op_t *op) {
+            return is_plain_matmul(op) && !visited.count(op)
+                    && get_bool(op, op_attr::transpose_b) == transpose_b
+                    && (op->num_inputs() == 3) == with_bias;
+        };
+
+        op_t *next = single_consumer(group.mm);
+        if (!next || next->get_kind() != op_kind::dnnl_eltwise
+                || next->num_inputs() != 1
+                || !graph::utils::one_of(
+                        static_cast<algorithm>(
+                                next->get_attr<int64_t>(op_attr::alg_kind)),
+                        algorithm::eltwise_gelu_erf,
+                        algorithm::eltwise_gelu_tanh, algorithm::eltwise_swish)
+                || next->get_output_value(0)->get_logical_tensor().data_type
+                        != data_type::f32)
+            continue;
+        group.act = next;
+        next = single_consumer(next);
+
+        // optional gating: act(src * w) * (src * w_up)
+        if (next && next->get_kind() == op_kind::dnnl_binary
+                && next->num_inputs() == 2
+                && next->get_attr<int64_t>(op_attr::alg_kind)
+                        == static_cast<int64_t>(algorithm::binary_mul)) {
+            const size_t offset
+                    = next->get_input_value(0) == group.act->get_output_value(0)
+                    ? 1
+                    : 0;
+            value_ptr up_val = next->get_input_value(offset);
+            op_t *mm_up = up_val->has_producer() ? &up_val->get_producer()
+                                                 : nullptr;
+            if (!is_compatible(mm_up) || single_consumer(mm_up) != next
+                    || mm_up->get_input_value(0)
+                            != group.mm->get_input_value(0)
+                    || ltw(up_val->get_logical_tensor()).vdims()
+                            != ltw(group.act->get_output_value(0)
+                                            ->get_logical_tensor())
+                                       .vdims())
+                continue;
+            group.mul = next;
+            group.mm_up = mm_up;
+            next = single_consumer(next);
+        }
+
+        // the output matmul
+        const op_t *prev = group.mul ? group.mul : group.act;
+        if (!is_compatible(next)
+                || next->get_input_value(0) != prev->get_output_value(0))
+            continue;
+        group.mm_down = next;
+
+        for (op_t *op : {group.mm, group.act, group.mul, group.mm_up,
+                     group.mm_down}) {
+            if (op) visited.insert(op);
+        }
+        groups.emplace_back(group);
+    }
+
+    subgraph_rewriter_t rewriter(sg);
+    for (auto &group : groups) {
+        op_ptr mlp = std::make_shared<op_t>(op_kind::dnnl_mlp);
+
+        // src, weights, then biases, see the dnnl_mlp schema
+        std::vector<std::pair<op_t *, size_t>> inputs {{group.mm, 0}};
+        for (size_t in_offset : {1, 2}) {
+            for (op_t *op : {group.mm, group.mm_up, group.mm_down}) {
+                if (op && in_offset < op->num_inputs())
+                    inputs.emplace_back(op, in_offset);
+            }
+        }
+        size_t in_idx = 0;
+        for (const auto &in : inputs) {
+            value_ptr in_value = in.first->get_input_value(in.second);
+            mlp->connect_input(in_idx++, in_value);
+            in_value->remove_consumer(*in.first, in.second);
+        }
+        // the src is shared by the gating matmul
+        if (group.mm_up)
+            group.mm->get_input_value(0)->remove_consumer(*group.mm_up, 0);
+
+        mlp->set_attr<int64_t>(op_attr::alg_kind,
+                group.act->get_attr<int64_t>(op_attr::alg_kind));
+        mlp->set_attr<float>(
+                op_attr::alpha, group.act->get_attr<float>(op_attr::alpha));
+        mlp->set_attr<bool>(op_attr::is_gated, group.mm_up != nullptr);
+        mlp->set_attr<bool>(op_attr::with_bias, group.mm->num_inputs() == 3);
+        mlp->set_attr<bool>(op_attr::transpose_b,
+                get_bool(group.mm, op_attr::transpose_b));
+
+        mlp->add_output(group.mm_down->get_output_value(0));
+        insert_empty_scratchpad(mlp);
+
+        for (op_t *op : {group.mm, group.act, group.mul, group.mm_up,
+                     group.mm_down}) {
+            if (op) rewriter.to_remove(op->shared_from_this());
+        }
+        rewriter.to_insert(mlp);
+    }
+
+    rewriter.run();
+    return status::success;
+}
+
+status_t fuse_sibling_matmuls(std::shared_ptr<subgraph_t> &sg) {
+    // the views are set up by pointer arithmetic on the host
+    if (sg->get_engine_kind() != graph::engine_kind::cpu)
+        return status::success;
+
+    const auto get_bool = [](const op_t *op, op_attr_t attr) {
+        return op->has_attr(attr) && op->get_attr<bool>(attr);
+    };
+    const auto is_constant_input = [](const value_ptr &val) {
+        return !val->has_producer()
+                && ltw(val->get_logical_tensor()).property_type()
+                == property_type::constant;
+    };
+    const auto is_sg_output = [&](const value_t *val) {
+        const size_t id = val->get_logical_tensor().id;
+        return std::any_of(sg->outs_.begin(), sg->outs_.end(),
+                [&](const logical_tensor_t &lt) { return lt.id == id; });
+    };
+    // a subgraph output sharing the buffer of the value through preprocess
+    // ops would make the whole wide output use the external buffer
+    const auto reaches_sg_output = [&](value_t *val) {
+        std::vector<value_t *> vals {val};
+        while (!vals.empty()) {
+            value_t *cur = vals.back();
+            vals.pop_back();
+            if (is_sg_output(cur)) return true;
+            for (const auto &consumer : cur->get_consumers()) {
+                op_t &next = consumer.get_op();
+                if (is_preprocess_op(next))
+                    vals.emplace_back(next.get_output_value(0).get());
+            }
+        }
+        return false;
+    };
+    // constant ops run only once, so they can't set up the views at every
+    // execution. The shared src must depend on a variable subgraph input.
+    const auto is_variable = [](value_t *val) {
+        std::vector<value_t *> vals {val};
+        std::set<value_t *> visited;
+        while (!vals.empty()) {
+            value_t *cur = vals.back();
+            vals.pop_back();
+            if (!visited.insert(cur).second) continue;
+            if (!cur->has_producer()) {
+                if (ltw(cur->get_logical_tensor()).property_type()
+                        != property_type::constant)
+                    return true;
+                continue;
+            }
+            for (const auto &in : cur->get_producer().get_input_values())
+                vals.emplace_back(in.get());
+        }
+        return false;
+    };
+
+    // plain matmul with constant 2D weights and an optional constant bias,
+    // without post-ops and quantization
+    const auto is_candidate = [&](const op_t *op) {
+        if (op->get_kind() != op_kind::dnnl_matmul) return false;
+        const bool with_bias = get_bool(op, op_attr::with_bias);
+        if (op->num_inputs() != (with_bias ? 3U : 2U)
+                || get_bool(op, op_attr::transpose_a)
+                || (op->has_attr(op_attr::fusion_info_key)
+                        && op->get_attr<int64_t>(op_attr::fusion_info_key)
+                                != -1))
+            return false;
+
+        const auto &src = op->get_input_value(0)->get_logical_tensor();
+        const auto &wei = op->get_input_value(1)->get_logical_tensor();
+        const auto &dst = op->get_output_value(0)->get_logical_tensor();
+        if (!graph::utils::one_of(src.data_type, data_type::f32,
+                    data_type::bf16, data_type::f16)
+                || wei.data_type != src.data_type
+                || dst.data_type != src.data_type || ltw(src).ndims() < 2
+                || ltw(src).is_shape_unknown() || ltw(wei).ndims() != 2
+                || ltw(wei).is_shape_unknown() || ltw(dst).is_shape_unknown()
+                || !is_constant_input(op->get_input_value(1)))
+            return false;
+
+        if (with_bias) {
+            const auto &bias = op->get_input_value(2)->get_logical_tensor();
+            const dim_t n = ltw(dst).vdims().back();
+            if (!is_constant_input(op->get_input_value(2))
+                    || ltw(bias).is_shape_unknown()
+                    || ltw(bias).vdims().back() != n
+                    || ltw(bias).nelems() != n)
+                return false;
+        }
+        return !reaches_sg_output(op->get_output_value(0).get());
+    };
+    const auto compatible = [&](const op_t *a, const op_t *b) {
+        if (get_bool(a, op_attr::transpose_b)
+                != get_bool(b, op_attr::transpose_b))
+            return false;
+        if (get_bool(a, op_attr::with_bias) != get_bool(b, op_attr::with_bias))
+            return false;
+        if (!get_bool(a, op_attr::with_bias)) return true;
+        const auto &bias_a = a->get_input_value(2)->get_logical_tensor();
+        const auto &bias_b = b->get_input_value(2)->get_logical_tensor();
+        return bias_a.data_type == bias_b.data_type
+                && bias_a.ndims == bias_b.ndims;
+    };
+
+    // group the candidates by the shared src, then by compatibility
+    std::vector<std::vector<op_t *>> groups;
+    std::map<value_t *, std::vector<size_t>> src_groups;
+    for (const auto &cur_op : sg->get_ops()) {
+        if (!is_candidate(cur_op.get())) continue;
+        auto &src_group = src_groups[cur_op->get_input_value(0).get()];
+        auto pos = std::find_if(src_group.begin(), src_group.end(),
+                [&](size_t idx) {
+                    return compatible(groups[idx][0], cur_op.get());
+                });
+        if (pos != src_group.end()) {
+            groups[*pos].emplace_back(cur_op.get());
+        } else {
+            src_group.emplace_back(groups.size());
+            groups.push_back({cur_op.get()});
+        }
+    }
+
+    subgraph_rewriter_t rewriter(sg);
+    for (const auto &group : groups) {
+        if (group.size() < 2) continue;
+        op_t *first = group[0];
+        value_ptr src = first->get_input_value(0);
+        if (!is_variable(src.get())) continue;
+
+        // concatenate the inputs at offset along the output channels. The
+        // weights and biases are constant, so the concat runs once and only
+        // its output is kept in the constant cache.
+        const auto concat_inputs = [&](size_t offset, int64_t axis) {
+            const auto &first_lt
+                    = first->get_input_value(offset)->get_logical_tensor();
+            const auto dt = first_lt.data_type;
+            op_ptr concat = std::make_shared<op_t>(op_kind::dnnl_concat);
+            for (size_t i = 0; i < group.size(); i++) {
+                value_ptr in = group[i]->get_input_value(offset);
+                in->remove_consumer(*group[i], offset);
+                concat->connect_input(i, in);
+            }
+            concat->set_attr<int64_t>(op_attr::axis, axis);
+            logical_tensor_t lt = empty_logical_tensor_with_default_id();
+            auto out = std::make_shared<value_t>(*concat, 0, lt, true);
+            out->set_data_type(dt);
+            concat->add_output(out);
+            insert_empty_scratchpad(concat);
+            rewriter.to_insert(concat);
+            return out;
+        };
+
+        op_ptr wide = std::make_shared<op_t>(op_kind::dnnl_matmul);
+        wide->merge_attributes(first->get_attributes());
+        for (op_t *op : group)
+            src->remove_consumer(*op, 0);
+        wide->connect_input(0, src);
+        const int64_t wei_axis = get_bool(first, op_attr::transpose_b) ? 0 : 1;
+        wide->connect_input(1, concat_inputs(1, wei_axis));
+        if (get_bool(first, op_attr::with_bias)) {
+            const int64_t bias_ndims
+                    = first->get_input_value(2)->get_logical_tensor().ndims;
+            wide->connect_input(2, concat_inputs(2, bias_ndims - 1));
+        }
+        logical_tensor_t lt = empty_logical_tensor_with_default_id();
+        auto wide_out = std::make_shared<value_t>(*wide, 0, lt, true);
+        wide_out->set_data_type(
+                first->get_output_value(0)->get_logical_tensor().data_type);
+        wide->add_output(wide_out);
+        insert_empty_scratchpad(wide);
+        rewriter.to_insert(wide);
+
+        // the original outputs become views of the wide output
+        int64_t offset = 0;
+        for (op_t *op : group) {
+            value_ptr dst = op->get_output_value(0);
+            const int64_t size = ltw(dst->get_logical_tensor()).vdims().back();
+            op_ptr slice = std::make_shared<op_t>(op_kind::dnnl_slice);
+            slice->set_attr<int64_t>(op_attr::axis, -1);
+            slice->set_attr<int64_t>(op_attr::slice_offset, offset);
+            slice->set_attr<int64_t>(op_attr::slice_size, size);
+            slice->connect_input(0, wide_out);
+            slice->add_output(dst);
+            rewriter.to_insert(slice);
+            rewriter.to_remove(op->shared_from_this());
+            offset += size;
+        }
+    }
+
+    rewriter.run();
+    return status::success;
+}
+
 status_t fuse_post_ops(std::shared_ptr<subgraph_t> &sg) {
     // lambda function to fuse one post op into base primitive
     auto fuse_post_ops_func = [&](bool &changed) -> status_t {
@@ -1191,6 +1900,7 @@ status_t fuse_dst_scales(std::shared_ptr<subgraph_t> &sg) {
                     && cur_op->get_kind() != op_kind::dnnl_convtranspose
                     && cur_op->get_kind() != op_kind::dnnl_softmax
                     && cur_op->get_kind() != op_kind::dnnl_layernorm
+                    && cur_op->get_kind() != op_kind::dnnl_groupnorm
                     && cur_op->get_kind() != op_kind::dnnl_reorder)
                 || visited.count(cur_op.get()) != 0)
             continue;
@@ -1236,8 +1946,9 @@ status_t convert_to_runtime_dst_scales(std::shared_ptr<subgraph_t> &sg) {
                 || !cur_op->get_input_value(0)->has_producer()
                 || !impl::utils::one_of(cur_op->get_input_op(0)->get_kind(),
                         op_kind::dnnl_softmax, op_kind::dnnl_layernorm,
-                        op_kind::dnnl_convolution, op_kind::dnnl_matmul,
-                        op_kind::dnnl_convtranspose, op_kind::dnnl_reorder)
+                        op_kind::dnnl_groupnorm, op_kind::dnnl_convolution,
+                        op_kind::dnnl_matmul, op_kind::dnnl_convtranspose,
+                        op_kind::dnnl_reorder)
                 || visited.count(cur_op.get()))
             continue;
 
@@ -2261,12 +2972,25 @@ status_t binary_canonicalization(std::shared_ptr<subgraph_t> &sg) {
                 ? cur_op->get_attr<bool>(op_attr::is_bias_add)
                 : false;
 
+        const bool is_select = static_cast<dnnl::algorithm>(
+                                       cur_op->get_attr<int64_t>(
+                                               op_attr::alg_kind))
+                == dnnl::algorithm::binary_select;
+
         // check doable
         auto src0_lt = cur_op->get_input_value(0)->get_logical_tensor();
         auto src1_lt = cur_op->get_input_value(1)->get_logical_tensor();
 
         bool shape_check_ok = true;
-        if (is_bias_add) {
+        if (is_select) {
+            // the condition broadcasts against both sources
+            auto src2_lt = cur_op->get_input_value(2)->get_logical_tensor();
+            shape_check_ok
+                    = binary_doable(ltw(src0_lt).vdims(), ltw(src1_lt).vdims())
+                    && binary_doable(ltw(src0_lt).vdims(), ltw(src2_lt).vdims())
+                    && binary_doable(
+                            ltw(src1_lt).vdims(), ltw(src2_lt).vdims());
+        } else if (is_bias_add) {
             // special check for BiasAdd
             const auto &data_format = cur_op->has_attr(op_attr::data_format)
                     ? cur_op->get_attr<std::string>(op_attr::data_format)
@@ -2282,10 +3006,13 @@ status_t binary_canonicalization(std::shared_ptr<subgraph_t> &sg) {
         if (!shape_check_ok) return status::invalid_shape;
 
         // insert unsqueeze op
-        int32_t src0_ndims = src0_lt.ndims;
-        int32_t src1_ndims = src1_lt.ndims;
-        int32_t target_ndims = std::max(src0_ndims, src1_ndims);
-        std::vector<int32_t> in_ndims {src0_ndims, src1_ndims};
+        std::vector<int32_t> in_ndims;
+        for (size_t i = 0; i < cur_op->num_inputs(); ++i) {
+            in_ndims.emplace_back(
+                    cur_op->get_input_value(i)->get_logical_tensor().ndims);
+        }
+        int32_t target_ndims
+                = *std::max_element(in_ndims.begin(), in_ndims.end());
         for (size_t i = 0; i < cur_op->num_inputs(); ++i) {
             if (in_ndims[i] == target_ndims) { continue; }
 
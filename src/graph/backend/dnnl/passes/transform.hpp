@@ -43,6 +43,36 @@ status_t fuse_to_int8_concat(std::shared_ptr<subgraph_t> &sg);
 
 status_t fuse_to_shuffle(std::shared_ptr<subgraph_t> &sg);
 
+// Fuse the scaled dot-product attention
+//   matmul(q, k) -> [mul|div scale] -> [add mask|select] -> softmax
+//   -> matmul(, v)
+// into a single dnnl_sdpa op, which computes the softmax blockwise without
+// materializing the score matrix. A select mask must replace the masked scores
+// with a one-element fill value. Only f32 4D inputs on cpu are fused.
+status_t fuse_to_sdpa(std::shared_ptr<subgraph_t> &sg);
+
+// Fuse the masked scores which are not followed by a matmul with v
+//   select(cond, scores, fill) -> softmax
+// into a single dnnl_masked_softmax op, which builds and normalizes each row
+// in one pass. The scores may also be the else input of the select. Only f32
+// inputs with a one-element fill and a softmax over the last axis on cpu are
+// fused.
+status_t fuse_to_masked_softmax(std::shared_ptr<subgraph_t> &sg);
+
+// Fuse the feed-forward block
+//   matmul(src, w) -> gelu|swish -> [mul matmul(src, w_up)] -> matmul(, w_down)
+// into a single dnnl_mlp op, which computes the rows of src blockwise so the
+// intermediate is never written to memory as a whole. Only f32 inputs with 2D
+// weights on cpu are fused.
+status_t fuse_to_mlp(std::shared_ptr<subgraph_t> &sg);
+
+// Merge sibling matmuls which share the same src and have constant weights
+// into one wide matmul over the concatenated weights (and biases). The outputs
+// of the original matmuls become dnnl_slice views of the wide output, so the
+// src is read once and no data is copied. Only plain matmuls without post-ops
+// on cpu are merged.
+status_t fuse_sibling_matmuls(std::shared_ptr<subgraph_t> &sg);
+
 status_t replace_quant_data_with_binary_post_op(
         std::shared_ptr<subgraph_t> &sg);
 
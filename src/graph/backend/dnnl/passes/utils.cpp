@@ -147,6 +147,9 @@ void merge_common_eltwise_attrs(
             || org_op->get_kind() == graph::op_kind::HardSwishBackward) {
         // in v3.0, users need to explicitly specify the alpha
         new_op->set_attr<float>(op_attr::alpha, 1.f / 6.f);
+    } else if (org_op->get_kind() == graph::op_kind::Pow) {
+        // eltwise_pow computes alpha * x ^ beta
+        new_op->set_attr<float>(op_attr::alpha, 1.f);
     } else {
         new_op->set_attr<float>(op_attr::alpha, 0);
     }
@@ -192,6 +195,21 @@ std::vector<value_t *> get_constant_block_output_values(
     return ret;
 }
 
+std::unordered_map<op_t *, size_t> get_op_levels(
+        const std::shared_ptr<subgraph_t> &sg) {
+    std::unordered_map<op_t *, size_t> levels;
+    topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
+        size_t level = 0;
+        for (const auto &in : op->get_input_values()) {
+            if (!in->has_producer()) continue;
+            level = std::max(level, levels.at(&in->get_producer()) + 1);
+        }
+        levels[op] = level;
+        return status::success;
+    });
+    return levels;
+}
+
 status_t infer_shape(std::shared_ptr<subgraph_t> &sg) {
     // workaround: the conv output shape will be impacted if the post-op is a
     // k3s2p1 dw conv. but with current shape infer functions' implementation,
@@ -356,6 +374,12 @@ std::pair<bool, std::pair<size_t, int64_t>> shuffle_fusible(
 }
 
 bool post_binary_fusible(const op_t *base_op, const op_t *bin_op) {
+    // select has three sources and is not supported as a post-op
+    if (static_cast<dnnl::algorithm>(
+                bin_op->get_attr<int64_t>(op_attr::alg_kind))
+            == dnnl::algorithm::binary_select)
+        return false;
+
     auto fused_out = base_op->get_output_values()[0];
     auto consumers = fused_out->get_consumers();
     if (consumers.size() != 1) return false;
@@ -453,6 +477,8 @@ get_post_ops_fusible_map() {
                     {dnnl_binary, {dnnl_eltwise, dnnl_binary}},
                     // bn
                     {dnnl_batchnorm, {dnnl_eltwise}},
+                    // gn
+                    {dnnl_groupnorm, {dnnl_eltwise, dnnl_binary}},
                     // reduction
                     {dnnl_reduction, {dnnl_eltwise, dnnl_binary}},
                     // resample
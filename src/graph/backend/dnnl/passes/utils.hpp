@@ -157,6 +157,7 @@ inline const std::map<op_kind_t, dnnl::algorithm> &get_eltwise_alg_map() {
             {graph::op_kind::LeakyReLU, dnnl::algorithm::eltwise_relu},
             {graph::op_kind::Log, dnnl::algorithm::eltwise_log},
             {graph::op_kind::Mish, dnnl::algorithm::eltwise_mish},
+            {graph::op_kind::Pow, dnnl::algorithm::eltwise_pow},
             {graph::op_kind::ReLU, dnnl::algorithm::eltwise_relu},
             {graph::op_kind::Round, dnnl::algorithm::eltwise_round},
             {graph::op_kind::Sigmoid, dnnl::algorithm::eltwise_logistic},
@@ -275,6 +276,12 @@ inline bool is_reduction_kind(op_kind_t kind) {
 std::vector<value_t *> get_constant_block_output_values(
         const std::shared_ptr<subgraph_t> &sg);
 
+// Returns the level of each op in the subgraph, which is the length of the
+// longest path from the subgraph inputs to the op. Ops on the same level don't
+// depend on each other and can be executed concurrently.
+std::unordered_map<op_t *, size_t> get_op_levels(
+        const std::shared_ptr<subgraph_t> &sg);
+
 status_t infer_shape(std::shared_ptr<subgraph_t> &sg);
 
 const std::map<op_kind_t, dnnl::algorithm> &get_binary_alg_map();
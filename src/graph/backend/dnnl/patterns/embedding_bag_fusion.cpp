@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <string>
+
+#include "graph/backend/dnnl/internal_ops.hpp"
+#include "graph/backend/dnnl/kernels/large_partition.hpp"
+#include "graph/backend/dnnl/patterns/fusions.hpp"
+#include "graph/backend/dnnl/patterns/transformation_pattern.hpp"
+#include "graph/backend/dnnl/patterns/utils.hpp"
+
+#include "graph/utils/pm/pbuilder.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+namespace pattern {
+
+namespace pm = graph::utils::pm;
+using in_edges_t = pm::in_edges_t;
+using pb_graph_t = pm::pb_graph_t;
+using FCreatePattern = graph::pass::FCreatePattern;
+
+namespace {
+// per_sample_weights are only supported by the sum mode
+bool check_embedding_bag_mode(op_t *op) {
+    if (op->num_inputs() < 4) return true;
+    return !op->has_attr(op_attr::mode)
+            || op->get_attr<std::string>(op_attr::mode) == "sum";
+}
+} // namespace
+
+/*!
+ * \brief This provides embedding bag-related fusion
+ *        The process includes follow steps:
+ *          1. look for fusion pattern on the graph
+ *          2. If found, verify if this transformation is safe / correct
+ *          3. replace the pattern with a fused op, update the graph
+ *
+ * \brief This pattern can match the target graph as shown below:
+ *
+ *           |
+ *     embedding_bag
+ *           |
+ *         matmul                 --->   embedding bag and interaction
+ *           |                           matmul in one partition
+ *  [unary/binary]*[0,4]
+ *           |
+ *
+ */
+DNNL_BACKEND_REGISTER_PATTERN_DEF_BEGIN(embedding_bag_fusion)
+
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(
+        dnnl, embedding_bag_matmul_fusion_cpu)
+        .set_priority(9.95f)
+        .set_kind(graph::partition_kind_t::misc_post_ops)
+        .set_engine_kind(engine_kind::cpu)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *embedding_bag
+                            = pgraph->append_op(graph::op_kind::EmbeddingBag);
+                    embedding_bag->append_decision_function(
+                            check_embedding_bag_mode);
+                    // the pooled rows are the lhs of the interaction
+                    pm::pb_op_t *matmul
+                            = pgraph->append_op(graph::op_kind::MatMul,
+                                    in_edges_t {in_edge(0, embedding_bag, 0)});
+                    matmul->append_decision_function(check_input_num<2>);
+
+                    auto postop_graph
+                            = std::make_shared<pb_graph_t>("postop_graph");
+                    pm::pb_op_t *pop = postop_graph->append_alternation(
+                            get_unary_binary_ops(), "pother_postop");
+                    pop->allow_internal_inputs();
+                    postop_graph->create_input_port(0, pop, 0);
+                    postop_graph->create_input_port(1, pop, 1);
+                    postop_graph->create_output_port(0, pop, 0);
+
+                    pgraph->append_repetition(postop_graph, {0, 0}, 0,
+                            MAX_REPETITION, in_edges_t {in_edge(0, matmul, 0)},
+                            "prepetition");
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, embedding_bag_pass_cpu)
+        .set_priority(8.f)
+        .set_kind(graph::partition_kind_t::misc_post_ops)
+        .set_engine_kind(engine_kind::cpu)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *embedding_bag
+                            = pgraph->append_op(graph::op_kind::EmbeddingBag);
+                    embedding_bag->append_decision_function(
+                            check_embedding_bag_mode);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
+DNNL_BACKEND_REGISTER_PATTERN_DEF_END
+
+} // namespace pattern
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
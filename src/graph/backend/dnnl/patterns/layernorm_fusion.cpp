@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include "graph/backend/dnnl/internal_ops.hpp"
+#include "graph/backend/dnnl/kernels/large_partition.hpp"
 #include "graph/backend/dnnl/kernels/layernorm.hpp"
 #include "graph/backend/dnnl/patterns/fusions.hpp"
 #include "graph/backend/dnnl/patterns/transformation_pattern.hpp"
@@ -31,6 +32,13 @@ using in_edges_t = pm::in_edges_t;
 using pb_graph_t = pm::pb_graph_t;
 using FCreatePattern = graph::pass::FCreatePattern;
 
+namespace {
+bool check_pow_beta(op_t *op, float beta) {
+    return op->has_attr(op_attr::beta)
+            && op->get_attr<float>(op_attr::beta) == beta;
+}
+} // namespace
+
 /*!
  * \brief This provides layernorm-related fusion
  *        The process includes follow steps:
@@ -100,6 +108,87 @@ DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(
             return std::make_shared<layernorm_fwd_t>();
         });
 
+/*
+ * RMS normalization written with elementwise ops, as exported by frameworks:
+ *
+ *       x
+ *       |
+ *  pow(x, 2)
+ *       |
+ *  reduce_mean
+ *       |
+ *   add(eps)
+ *       |
+ *  sqrt -> divide(x, .)   or   pow(., -0.5) -> multiply(x, .)
+ *       |
+ *  [multiply(gamma)]
+ *       |
+ *
+ * The eps is a tensor, so the subgraph cannot be replaced by the layernorm
+ * primitive. Keeping it in one partition lets the reduction take the add and
+ * sqrt as post-ops and run the whole normalization in one compiled kernel.
+ */
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, rms_norm_subgraph_fusion_cpu)
+        .set_priority(8.5f)
+        .set_kind(graph::partition_kind_t::misc_post_ops)
+        .set_engine_kind(engine_kind::cpu)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *square
+                            = pgraph->append_op(graph::op_kind::Pow, "square");
+                    square->append_decision_function([](op_t *op) -> bool {
+                        return check_pow_beta(op, 2.f);
+                    });
+                    pm::pb_op_t *mean
+                            = pgraph->append_op(graph::op_kind::ReduceMean,
+                                    in_edges_t {in_edge(0, square, 0)}, "mean");
+                    pm::pb_op_t *add_eps = pgraph->append_op(
+                            graph::op_kind::Add,
+                            in_edges_t {in_edge(0, mean, 0)}, "add_eps");
+
+                    // Alt0: x / sqrt(mean + eps)
+                    auto pdiv_graph
+                            = std::make_shared<pb_graph_t>("pdiv_graph");
+                    pm::pb_op_t *psqrt = pdiv_graph->append_op(
+                            graph::op_kind::Sqrt, "sqrt");
+                    pm::pb_op_t *pdiv = pdiv_graph->append_op(
+                            graph::op_kind::Divide,
+                            in_edges_t {in_edge(1, psqrt, 0)}, "divide");
+                    pdiv_graph->create_input_port(0, psqrt, 0);
+                    pdiv_graph->create_output_port(0, pdiv, 0);
+
+                    // Alt1: x * (mean + eps) ^ -0.5
+                    auto pmul_graph
+                            = std::make_shared<pb_graph_t>("pmul_graph");
+                    pm::pb_op_t *prsqrt = pmul_graph->append_op(
+                            graph::op_kind::Pow, "rsqrt");
+                    prsqrt->append_decision_function([](op_t *op) -> bool {
+                        return check_pow_beta(op, -0.5f);
+                    });
+                    pm::pb_op_t *pmul = pmul_graph->append_op(
+                            graph::op_kind::Multiply,
+                            in_edges_t {in_edge(1, prsqrt, 0)}, "multiply");
+                    pmul_graph->create_input_port(0, prsqrt, 0);
+                    pmul_graph->create_output_port(0, pmul, 0);
+
+                    auto norm = pgraph->append_alternation(
+                            {pdiv_graph, pmul_graph},
+                            in_edges_t {in_edge(0, add_eps, 0)}, "norm");
+
+                    // Optional scale by gamma
+                    auto pgamma_graph
+                            = std::make_shared<pb_graph_t>("pgamma_graph");
+                    pm::pb_op_t *pgamma = pgamma_graph->append_op(
+                            graph::op_kind::Multiply, "gamma");
+                    pgamma_graph->create_input_port(0, pgamma, 0);
+                    pgamma_graph->create_output_port(0, pgamma, 0);
+                    pgraph->append_optional(pgamma_graph,
+                            in_edges_t {in_edge(0, norm, 0)}, "popt_gamma");
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
 DNNL_BACKEND_REGISTER_PATTERN_DEF_END
 
 } // namespace pattern
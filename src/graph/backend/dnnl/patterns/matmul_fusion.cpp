@@ -33,6 +33,45 @@ using in_edges_t = pm::in_edges_t;
 using pb_graph_t = pm::pb_graph_t;
 using FCreatePattern = graph::pass::FCreatePattern;
 
+namespace {
+// Block creator of the f32 feed-forward block
+//   MatMul -> GELU|Swish -> [Multiply with a gating MatMul] -> MatMul
+// where Swish is given as Sigmoid and Multiply. The gating MatMul is expected
+// to read the same src as the first one, which is checked by fuse_to_mlp.
+void create_f32_mlp_pattern(const std::shared_ptr<pb_graph_t> &pgraph,
+        bool is_gated, bool is_swish) {
+    pm::pb_op_t *matmul = pgraph->append_op(graph::op_kind::MatMul, "matmul");
+    matmul->append_decision_function(check_input_dtype<graph::data_type::f32>);
+
+    pm::pb_op_t *act = nullptr;
+    if (is_swish) {
+        pm::pb_op_t *sigmoid = pgraph->append_op(graph::op_kind::Sigmoid,
+                in_edges_t {in_edge(0, matmul, 0)}, "sigmoid");
+        act = pgraph->append_op(graph::op_kind::Multiply,
+                in_edges_t {in_edge(0, matmul, 0), in_edge(1, sigmoid, 0)},
+                "swish");
+    } else {
+        act = pgraph->append_op(graph::op_kind::GELU,
+                in_edges_t {in_edge(0, matmul, 0)}, "gelu");
+    }
+
+    if (is_gated) {
+        pm::pb_op_t *matmul_up
+                = pgraph->append_op(graph::op_kind::MatMul, "matmul_up");
+        matmul_up->append_decision_function(
+                check_input_dtype<graph::data_type::f32>);
+        act = pgraph->append_op(graph::op_kind::Multiply,
+                in_edges_t {in_edge(0, act, 0), in_edge(1, matmul_up, 0)},
+                "gate");
+    }
+
+    pm::pb_op_t *matmul_down = pgraph->append_op(graph::op_kind::MatMul,
+            in_edges_t {in_edge(0, act, 0)}, "matmul_down");
+    matmul_down->append_decision_function(
+            check_input_dtype<graph::data_type::f32>);
+}
+} // namespace
+
 DNNL_BACKEND_REGISTER_PATTERN_DEF_BEGIN(matmul_fusion)
 
 DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, matmul_post_ops_chain_fusion)
@@ -1148,8 +1187,33 @@ DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, f32_MHA_fusion)
                     auto popt2 = pgraph->append_optional(
                             popt_graph2, {in_edge(0, matmul_qk, 0)}, "popt2");
 
-                    auto fscore_add = pgraph->append_op(graph::op_kind::Add,
-                            in_edges_t {in_edge(0, popt2, 0)}, "fscore_add");
+                    // The mask is either added to the scores or applied
+                    // by a Select, which takes the scores as its then or
+                    // else input.
+                    auto padd_graph = std::make_shared<pb_graph_t>("padd_mask");
+                    auto pfscore_add = padd_graph->append_op(
+                            graph::op_kind::Add, "pfscore_add");
+                    padd_graph->create_input_port(0, pfscore_add, 0);
+                    padd_graph->create_output_port(0, pfscore_add, 0);
+
+                    auto pselect_then_graph
+                            = std::make_shared<pb_graph_t>("pselect_then_mask");
+                    auto pselect_then = pselect_then_graph->append_op(
+                            graph::op_kind::Select, "pselect_then");
+                    pselect_then_graph->create_input_port(0, pselect_then, 1);
+                    pselect_then_graph->create_output_port(0, pselect_then, 0);
+
+                    auto pselect_else_graph
+                            = std::make_shared<pb_graph_t>("pselect_else_mask");
+                    auto pselect_else = pselect_else_graph->append_op(
+                            graph::op_kind::Select, "pselect_else");
+                    pselect_else_graph->create_input_port(0, pselect_else, 2);
+                    pselect_else_graph->create_output_port(0, pselect_else, 0);
+
+                    auto fscore_mask = pgraph->append_alternation(
+                            {padd_graph, pselect_then_graph,
+                                    pselect_else_graph},
+                            in_edges_t {in_edge(0, popt2, 0)}, "fscore_mask");
 
                     // Optional Pre Reshape of SoftMax
                     auto popt_graph3
@@ -1159,7 +1223,7 @@ DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, f32_MHA_fusion)
                     popt_graph3->create_input_port(0, pre_reshape, 0);
                     popt_graph3->create_output_port(0, pre_reshape, 0);
                     auto popt3 = pgraph->append_optional(
-                            popt_graph3, {in_edge(0, fscore_add, 0)}, "popt3");
+                            popt_graph3, {in_edge(0, fscore_mask, 0)}, "popt3");
 
                     auto softmax = pgraph->append_op(graph::op_kind::SoftMax,
                             in_edges_t {in_edge(0, popt3, 0)}, "softmax");
@@ -1205,6 +1269,50 @@ DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, f32_MHA_fusion)
             return std::make_shared<larger_partition_kernel_t>();
         });
 
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, f32_mlp_gelu_fusion)
+        .set_priority(21.0f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    create_f32_mlp_pattern(pgraph, false, false);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, f32_mlp_swish_fusion)
+        .set_priority(21.0f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    create_f32_mlp_pattern(pgraph, false, true);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, f32_gated_mlp_gelu_fusion)
+        .set_priority(21.1f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    create_f32_mlp_pattern(pgraph, true, false);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, f32_gated_mlp_swish_fusion)
+        .set_priority(21.1f)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    create_f32_mlp_pattern(pgraph, true, true);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
 DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, int8_bf16_MHA_fusion)
         .set_priority(5.0f)
         .set_kind(partition_kind_t::quantized_mha)
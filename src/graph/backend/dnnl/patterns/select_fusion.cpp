@@ -0,0 +1,133 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "graph/backend/dnnl/kernels/binary.hpp"
+#include "graph/backend/dnnl/kernels/large_partition.hpp"
+#include "graph/backend/dnnl/patterns/fusions.hpp"
+#include "graph/backend/dnnl/patterns/transformation_pattern.hpp"
+#include "graph/backend/dnnl/patterns/utils.hpp"
+
+#include "graph/utils/pm/pbuilder.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+namespace pattern {
+
+namespace pm = graph::utils::pm;
+using in_edges_t = pm::in_edges_t;
+using pb_graph_t = pm::pb_graph_t;
+using FCreatePattern = graph::pass::FCreatePattern;
+
+/*!
+ * \brief This provides select-related fusion
+ *        The process includes follow steps:
+ *          1. look for fusion pattern on the graph
+ *          2. If found, verify if this transformation is safe / correct
+ *          3. replace the pattern with a fused op, update the graph
+ */
+DNNL_BACKEND_REGISTER_PATTERN_DEF_BEGIN(select_fusion)
+
+/*
+ *           |
+ *        select
+ *           |
+ *  [unary/binary]*[1,MAX_REPETITION]
+ *           |
+ *
+ * Select is lowered to a ternary binary primitive, which accepts the
+ * following ops as regular post-ops.
+ */
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, select_post_ops_fusion_cpu)
+        .set_priority(8.3f)
+        .set_kind(partition_kind_t::binary_post_ops)
+        .set_engine_kind(engine_kind::cpu)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *select = pgraph->append_op(
+                            graph::op_kind::Select, "select");
+
+                    auto post_subgraph
+                            = std::make_shared<pb_graph_t>("post_subgraph");
+                    auto alternative_post_op
+                            = post_subgraph->append_alternation(
+                                    get_unary_binary_ops(),
+                                    "alternative_post_op");
+                    alternative_post_op->allow_internal_inputs();
+                    post_subgraph->create_input_port(0, alternative_post_op, 0);
+                    post_subgraph->create_output_port(
+                            0, alternative_post_op, 0);
+
+                    pgraph->append_repetition(post_subgraph, {0, 0}, 1,
+                            MAX_REPETITION, {in_edge(0, select, 0)}, "palt");
+                })
+        .set_attr<FCreateKernel>("FCreateKernel",
+                []() -> kernel_ptr { return std::make_shared<binary_t>(); });
+
+/*
+ *      |       |
+ *       matmul
+ *          |
+ *  [divide/multiply]*[0,1]
+ *          |
+ *  select(mask, ., -inf)
+ *          |
+ *       softmax
+ *          |
+ *
+ * The masked attention scores of decoder models outside of a full MHA
+ * subgraph. The scores are the "then" input of the select. The select and
+ * softmax are computed by one fused kernel instead of the binary and softmax
+ * primitives.
+ */
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, masked_scores_fusion_cpu)
+        .set_priority(9.5f)
+        .set_kind(partition_kind_t::misc_post_ops)
+        .set_engine_kind(engine_kind::cpu)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *matmul = pgraph->append_op(
+                            graph::op_kind::MatMul, "matmul");
+                    matmul->append_decision_function(check_input_num<2>);
+
+                    auto pscale_graph
+                            = std::make_shared<pb_graph_t>("pscale_graph");
+                    pm::pb_op_t *pscale = pscale_graph->append_alternation(
+                            {graph::op_kind::Divide, graph::op_kind::Multiply},
+                            "pscale");
+                    pscale_graph->create_input_port(0, pscale, 0);
+                    pscale_graph->create_output_port(0, pscale, 0);
+                    auto popt_scale = pgraph->append_optional(pscale_graph,
+                            in_edges_t {in_edge(0, matmul, 0)}, "popt_scale");
+
+                    pm::pb_op_t *select = pgraph->append_op(
+                            graph::op_kind::Select,
+                            in_edges_t {in_edge(1, popt_scale, 0)}, "select");
+                    pgraph->append_op(graph::op_kind::SoftMax,
+                            in_edges_t {in_edge(0, select, 0)}, "softmax");
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
+DNNL_BACKEND_REGISTER_PATTERN_DEF_END
+
+} // namespace pattern
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
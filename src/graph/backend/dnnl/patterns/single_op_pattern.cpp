@@ -139,6 +139,8 @@ DNNL_BACKEND_SINGLE_OP_TRANSFORM(min_pass, Minimum, binary_t, 8.f)
 DNNL_BACKEND_SINGLE_OP_TRANSFORM(mish_pass, Mish, float_eltwise_fwd, 8.f)
 DNNL_BACKEND_SINGLE_OP_TRANSFORM(mish_bw_pass, MishBackward, eltwise_bwd_t, 8.f)
 DNNL_BACKEND_SINGLE_OP_TRANSFORM(div_pass, Divide, binary_t, 8.f)
+DNNL_BACKEND_SINGLE_OP_TRANSFORM(pow_pass, Pow, float_eltwise_fwd, 8.f)
+DNNL_BACKEND_SINGLE_OP_TRANSFORM(select_pass, Select, binary_t, 8.f)
 DNNL_BACKEND_SINGLE_OP_TRANSFORM(sub_pass, Subtract, binary_t, 8.f)
 DNNL_BACKEND_SINGLE_OP_TRANSFORM(round_pass, Round, float_eltwise_fwd, 8.f)
 DNNL_BACKEND_SINGLE_OP_TRANSFORM(sigmoid_pass, Sigmoid, float_eltwise_fwd, 8.f)
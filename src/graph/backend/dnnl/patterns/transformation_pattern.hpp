@@ -17,7 +17,9 @@
 #ifndef GRAPH_BACKEND_DNNL_PATTERNS_TRANSFORMATION_PATTERN_HPP
 #define GRAPH_BACKEND_DNNL_PATTERNS_TRANSFORMATION_PATTERN_HPP
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,8 +39,11 @@ namespace pattern {
 
 class pattern_utils_t {
 public:
+    // Tries the pattern at the ops of the given kinds in topological order.
+    // All ops are tried if start_kinds is empty.
     inline void match(graph_t &backend_graph,
-            std::shared_ptr<graph::utils::pm::pb_graph_t> pgraph,
+            const std::shared_ptr<graph::utils::pm::pb_graph_t> &pgraph,
+            const std::vector<op_kind_t> &start_kinds,
             std::vector<std::vector<op_t *>> &fusion_ops);
 
     inline void init_partition(graph_t &backend_graph,
@@ -52,18 +57,35 @@ public:
 };
 
 inline void pattern_utils_t::match(graph_t &backend_graph,
-        std::shared_ptr<graph::utils::pm::pb_graph_t> pgraph,
+        const std::shared_ptr<graph::utils::pm::pb_graph_t> &pgraph,
+        const std::vector<op_kind_t> &start_kinds,
         std::vector<std::vector<op_t *>> &fusion_ops) {
-    // dfs_visit graph, do pattern matching
-    topo_order_visit(backend_graph.get_output_ops(), [&](op_t *cur_op) {
+    const graph_t::op_kind_index_t &index = backend_graph.get_op_kind_index();
+    auto match_op = [&](op_t *cur_op) {
+        if (cur_op->get_partition() != nullptr) return;
         std::vector<op_t *> candidate_fusion;
         if (!graph::utils::pm::match_pattern(
-                    cur_op, pgraph, candidate_fusion)) {
-            return status::success;
-        }
+                    cur_op, pgraph, candidate_fusion))
+            return;
         fusion_ops.emplace_back(candidate_fusion);
-        return status::success;
-    });
+    };
+
+    if (start_kinds.empty()) {
+        for (op_t *cur_op : index.topo_ops)
+            match_op(cur_op);
+        return;
+    }
+
+    std::vector<size_t> positions;
+    for (op_kind_t kind : start_kinds) {
+        auto it = index.positions.find(kind);
+        if (it == index.positions.end()) continue;
+        positions.insert(
+                positions.end(), it->second.begin(), it->second.end());
+    }
+    if (start_kinds.size() > 1) std::sort(positions.begin(), positions.end());
+    for (size_t pos : positions)
+        match_op(index.topo_ops[pos]);
 }
 
 inline void pattern_utils_t::init_partition(graph_t &backend_graph,
@@ -110,22 +132,14 @@ public:
                 && get_engine_kind() != graph_engine_kind)
             return impl::status::success;
 
-        // we can have only one optimized pattern
-        std::vector<graph::pass::FCreatePattern> pfuncs
-                = get_attr<graph::pass::FCreatePattern>("FCreatePattern");
-
         FCreateKernel kernel_creator
                 = get_attr<FCreateKernel>("FCreateKernel")[0];
 
         pattern_utils_t pu;
-        for (auto &pfunc : pfuncs) {
-            std::shared_ptr<graph::utils::pm::pb_graph_t> pgraph
-                    = std::make_shared<graph::utils::pm::pb_graph_t>("pgraph");
-            pfunc(pgraph);
-
+        for (const auto &pattern : get_patterns()) {
             // for each pattern. match it
             std::vector<std::vector<op_t *>> fusion_ops;
-            pu.match(agraph, pgraph, fusion_ops);
+            pu.match(agraph, pattern.pgraph, pattern.start_kinds, fusion_ops);
             if (!fusion_ops.empty()) {
                 // temporary solution here for showing which pattern matched
                 if (getenv_int_user("GRAPH_DUMP", 0) > 0
@@ -142,6 +156,38 @@ public:
         }
         return impl::status::success;
     }
+
+private:
+    struct pattern_t {
+        std::shared_ptr<graph::utils::pm::pb_graph_t> pgraph;
+        // The kinds of the ops a match can start from, empty if any
+        std::vector<op_kind_t> start_kinds;
+    };
+
+    // The pattern graphs are built once and reused by all the graphs the
+    // pass runs on. Match results are not memoized: an op is tried at most
+    // once per pattern in a run, and the ops claimed by a partition are
+    // skipped by later patterns, so no matcher call is ever repeated.
+    const std::vector<pattern_t> &get_patterns() {
+        std::call_once(patterns_once_, [this]() {
+            std::vector<graph::pass::FCreatePattern> pfuncs
+                    = get_attr<graph::pass::FCreatePattern>("FCreatePattern");
+            for (auto &pfunc : pfuncs) {
+                pattern_t pattern;
+                pattern.pgraph = std::make_shared<graph::utils::pm::pb_graph_t>(
+                        "pgraph");
+                pfunc(pattern.pgraph);
+                std::unordered_set<op_kind_t> kinds;
+                if (pattern.pgraph->get_start_op_kinds(kinds))
+                    pattern.start_kinds.assign(kinds.begin(), kinds.end());
+                patterns_.emplace_back(pattern);
+            }
+        });
+        return patterns_;
+    }
+
+    std::once_flag patterns_once_;
+    std::vector<pattern_t> patterns_;
 };
 
 #define DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN( \
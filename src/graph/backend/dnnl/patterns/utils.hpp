@@ -92,6 +92,7 @@ inline const std::vector<op_kind_t> &get_unary_ops() {
             graph::op_kind::LeakyReLU,
             graph::op_kind::Log,
             graph::op_kind::Mish,
+            graph::op_kind::Pow,
             graph::op_kind::Sigmoid,
             graph::op_kind::SoftPlus,
             graph::op_kind::ReLU,
@@ -128,6 +129,7 @@ inline const std::vector<op_kind_t> &get_unary_binary_ops() {
             graph::op_kind::LeakyReLU,
             graph::op_kind::Log,
             graph::op_kind::Mish,
+            graph::op_kind::Pow,
             graph::op_kind::Sigmoid,
             graph::op_kind::SoftPlus,
             graph::op_kind::ReLU,
@@ -257,6 +257,14 @@ status_t subgraph_visualizer_t::run(const std::shared_ptr<subgraph_t> &sg,
                 << val2str(op->get_output_value(i).get());
         }
 
+        // the plan chosen by layout assignment, if any
+        if (op->has_attr(op_attr::layout_plan)
+                && !op->get_attr<std::string>(op_attr::layout_plan).empty()) {
+            out << "\\n"
+                << "layout_plan_"
+                << op->get_attr<std::string>(op_attr::layout_plan);
+        }
+
         out << "\"];\n";
         return status::success;
     });
@@ -92,6 +92,10 @@ public:
 
     // The executable for each op in subgraph
     std::vector<std::shared_ptr<op_executable_t>> execs_;
+
+    // The level of each op in execs_ (see get_op_levels). Ops on the same
+    // level can be executed concurrently
+    std::vector<size_t> exec_levels_;
 };
 
 class subgraph_visualizer_t {
@@ -14,8 +14,14 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <climits>
+#include <mutex>
+#include <string>
+
 #include "oneapi/dnnl/dnnl_graph.h"
 
+#include "common/utils.hpp"
+
 #include "graph/interface/backend.hpp"
 
 #include "graph/utils/utils.hpp"
@@ -95,6 +101,53 @@ public:
     }
 };
 
+class constant_cache_dir_t {
+    std::mutex mutex_;
+    std::string dir_;
+
+    // The initial directory is taken from the env var
+    // ONEDNN_GRAPH_CONSTANT_TENSOR_CACHE_DIR (or DNNL_ prefixed), so the
+    // replicas of an application can share the constant tensors without
+    // code changes.
+    constant_cache_dir_t() {
+#ifdef __linux__
+        char buf[PATH_MAX];
+        for (const auto &prefix : {"ONEDNN_", "DNNL_"}) {
+            std::string name = std::string(prefix)
+                    + std::string("GRAPH_CONSTANT_TENSOR_CACHE_DIR");
+            if (impl::getenv(name.c_str(), buf, sizeof(buf)) > 0) {
+                dir_ = buf;
+                break;
+            }
+        }
+#endif
+    }
+
+    constant_cache_dir_t(const constant_cache_dir_t &) = delete;
+    constant_cache_dir_t(constant_cache_dir_t &&) = delete;
+    constant_cache_dir_t &operator=(const constant_cache_dir_t &) = delete;
+    constant_cache_dir_t &operator=(constant_cache_dir_t &&) = delete;
+
+public:
+    static constant_cache_dir_t &get_singleton() {
+        static constant_cache_dir_t ins;
+        return ins;
+    }
+
+    std::string load() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dir_;
+    }
+    void store(const char *dir) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dir_ = dir ? dir : "";
+    }
+};
+
+std::string get_constant_cache_dir() {
+    return constant_cache_dir_t::get_singleton().load();
+}
+
 } // namespace graph
 } // namespace impl
 } // namespace dnnl
@@ -111,3 +164,26 @@ dnnl::impl::graph::status_t dnnl_graph_get_constant_tensor_cache(int *flag) {
     *flag = dnnl::impl::graph::constant_cache_flag_t::get_singleton().load();
     return dnnl::impl::graph::status::success;
 }
+
+dnnl::impl::graph::status_t dnnl_graph_set_constant_tensor_cache_dir(
+        const char *dir) {
+#ifdef __linux__
+    dnnl::impl::graph::constant_cache_dir_t::get_singleton().store(dir);
+    return dnnl::impl::graph::status::success;
+#else
+    UNUSED(dir);
+    return dnnl::impl::graph::status::unimplemented;
+#endif
+}
+
+dnnl::impl::graph::status_t dnnl_graph_get_constant_tensor_cache_footprint(
+        size_t *size) {
+    using namespace dnnl::impl::graph;
+    if (size == nullptr) return status::invalid_arguments;
+    *size = 0;
+    for (const backend *abackend :
+            backend_registry_t::get_singleton().get_registered_backends()) {
+        *size += abackend->get_constant_cache_footprint();
+    }
+    return status::success;
+}
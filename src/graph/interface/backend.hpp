@@ -104,6 +104,12 @@ public:
     virtual status_t get_partitions(graph_t &agraph, partition_policy_t policy)
             = 0;
 
+    /// Get the memory held by the constant tensor cache of the backend
+    /// @return The size in bytes
+    /// @note This is a default implementation for the backends without
+    ///     constant tensor cache.
+    virtual size_t get_constant_cache_footprint() const { return 0; }
+
     /// Register the pointer of created backend instance to oneDNN Graph
     static backend *register_backend(const backend *abackend);
 
@@ -215,6 +221,10 @@ private:
 // status.
 bool is_constant_cache_enabled();
 
+// Backend API used by each backend to get the directory where the constant
+// tensors are shared with other processes. Empty if sharing is disabled.
+std::string get_constant_cache_dir();
+
 } // namespace graph
 } // namespace impl
 } // namespace dnnl
@@ -0,0 +1,353 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "oneapi/dnnl/dnnl_graph.h"
+
+#include "common/engine.hpp"
+#include "common/stream.hpp"
+
+#include "graph/interface/allocator.hpp"
+#include "graph/interface/batching_executor.hpp"
+#include "graph/interface/c_types_map.hpp"
+#include "graph/interface/logical_tensor.hpp"
+
+#include "graph/utils/utils.hpp"
+
+using namespace dnnl::impl::graph;
+
+namespace {
+// Frees the packed buffers of a batch however the execution ends
+struct buffers_t {
+    buffers_t(const allocator_t *alloc) : alloc_(alloc) {}
+    ~buffers_t() {
+        for (void *buf : bufs_)
+            alloc_->deallocate(buf);
+    }
+
+    void *allocate(size_t size) {
+        void *buf = alloc_->allocate(
+                size, {allocator_t::mem_type_t::temp, /* alignment = */ 64});
+        if (buf) bufs_.emplace_back(buf);
+        return buf;
+    }
+
+private:
+    const allocator_t *alloc_;
+    std::vector<void *> bufs_;
+};
+} // namespace
+
+status_t dnnl_graph_batching_executor::init(
+        const std::vector<logical_tensor_t> &inputs,
+        const std::vector<logical_tensor_t> &outputs, size_t max_batch,
+        size_t window_us) {
+    using ltw = logical_tensor_wrapper_t;
+    if (max_batch == 0) return status::invalid_arguments;
+    // The requests are packed and unpacked with host copies
+    if (engine_->kind() != engine_kind::cpu
+            || engine_->runtime_kind() == dnnl::impl::runtime_kind::sycl)
+        return status::unimplemented;
+
+    for (const auto *lts : {&inputs, &outputs}) {
+        for (const auto &lt : *lts) {
+            if (ltw(lt).is_shape_unknown()) return status::invalid_shape;
+            const bool batched = lts == &outputs || is_batched(lt);
+            if (!batched) continue;
+            // The data of one sample must be a contiguous block, so the
+            // batches are concatenations of the requests.
+            if (!ltw(lt).is_strided() || ltw(lt).is_stride_unknown()
+                    || ltw(lt).ndims() < 1)
+                return status::invalid_arguments;
+            const size_t sample_size = static_cast<size_t>(lt.layout.strides[0])
+                    * ltw(lt).data_type_size();
+            if (ltw(lt).size() != sample_size * lt.dims[0])
+                return status::invalid_arguments;
+        }
+    }
+
+    inputs_ = inputs;
+    outputs_ = outputs;
+    max_batch_ = static_cast<dim_t>(max_batch);
+    window_ = std::chrono::microseconds(window_us);
+    return status::success;
+}
+
+status_t dnnl_graph_batching_executor::check_request(
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs, dim_t &batch) const {
+    if (inputs.size() != inputs_.size() || outputs.size() != outputs_.size())
+        return status::invalid_arguments;
+
+    batch = -1;
+    const auto check = [&](const tensor_t &t, const logical_tensor_t &expected,
+                               bool batched) -> status_t {
+        const auto &lt = t.get_logical_tensor();
+        if (!t.get_data_handle() || lt.id != expected.id
+                || lt.data_type != expected.data_type
+                || lt.ndims != expected.ndims)
+            return status::invalid_arguments;
+        for (int d = batched ? 1 : 0; d < lt.ndims; d++) {
+            if (lt.dims[d] != expected.dims[d])
+                return status::invalid_arguments;
+        }
+        if (!batched) return status::success;
+
+        for (int d = 0; d < lt.ndims; d++) {
+            if (lt.layout.strides[d] != expected.layout.strides[d])
+                return status::invalid_arguments;
+        }
+        if (lt.dims[0] < 1 || (batch != -1 && lt.dims[0] != batch))
+            return status::invalid_arguments;
+        batch = lt.dims[0];
+        return status::success;
+    };
+
+    for (size_t i = 0; i < inputs.size(); i++)
+        CHECK(check(inputs[i], inputs_[i], is_batched(inputs_[i])));
+    for (size_t i = 0; i < outputs.size(); i++)
+        CHECK(check(outputs[i], outputs_[i], true));
+    return batch == -1 ? status::invalid_arguments : status::success;
+}
+
+dim_t dnnl_graph_batching_executor::get_bucket(dim_t batch) const {
+    dim_t bucket = 1;
+    while (bucket < batch)
+        bucket *= 2;
+    return std::min(bucket, max_batch_);
+}
+
+status_t dnnl_graph_batching_executor::get_or_compile(
+        dim_t batch, std::shared_ptr<compiled_partition_t> &cp) const {
+    {
+        std::lock_guard<std::mutex> lock(compiled_mutex_);
+        auto it = compiled_.find(batch);
+        if (it != compiled_.end()) {
+            cp = it->second;
+            return status::success;
+        }
+    }
+
+    // The compilation runs unlocked, so the batches of the sizes already
+    // compiled are not blocked by it. If two batches compile the same size
+    // concurrently, the first inserted partition is kept.
+    std::vector<logical_tensor_t> ins = inputs_, outs = outputs_;
+    std::vector<const logical_tensor_t *> in_ptrs, out_ptrs;
+    for (auto &lt : ins) {
+        if (is_batched(lt)) lt.dims[0] = batch;
+        in_ptrs.emplace_back(&lt);
+    }
+    for (auto &lt : outs) {
+        lt.dims[0] = batch;
+        out_ptrs.emplace_back(&lt);
+    }
+
+    auto new_cp = std::make_shared<compiled_partition_t>(partition_);
+    std::pair<compiled_partition_t *, bool> cp_pair {new_cp.get(), false};
+    CHECK(partition_.compile(cp_pair, in_ptrs, out_ptrs, engine_));
+
+    std::lock_guard<std::mutex> lock(compiled_mutex_);
+    cp = compiled_.emplace(batch, new_cp).first->second;
+    return status::success;
+}
+
+status_t dnnl_graph_batching_executor::run(
+        stream_t *astream, const batch_t &batch) const {
+    // The padding samples of a bucket are zeros and their outputs are
+    // dropped.
+    const dim_t bucket = get_bucket(batch.size);
+    std::shared_ptr<compiled_partition_t> cp;
+    CHECK(get_or_compile(bucket, cp));
+
+    // A single request which fills the bucket is executed in place
+    if (batch.requests.size() == 1 && batch.size == bucket) {
+        const request_t *req = batch.requests[0];
+        return cp->execute(astream, *req->inputs, *req->outputs);
+    }
+
+    using ltw = logical_tensor_wrapper_t;
+    buffers_t buffers(
+            static_cast<const allocator_t *>(engine_->get_allocator()));
+    std::vector<tensor_t> ins, outs;
+    ins.reserve(inputs_.size());
+    outs.reserve(outputs_.size());
+
+    for (size_t i = 0; i < inputs_.size(); i++) {
+        // constant inputs are the same for all requests
+        if (!is_batched(inputs_[i])) {
+            ins.emplace_back((*batch.requests[0]->inputs)[i]);
+            continue;
+        }
+        logical_tensor_t lt = inputs_[i];
+        lt.dims[0] = bucket;
+        const size_t buf_size = ltw(lt).size();
+        char *buf = static_cast<char *>(buffers.allocate(buf_size));
+        if (!buf) return status::out_of_memory;
+        size_t offset = 0;
+        for (const request_t *req : batch.requests) {
+            const tensor_t &t = (*req->inputs)[i];
+            const size_t size = ltw(t.get_logical_tensor()).size();
+            std::memcpy(buf + offset, t.get_data_handle(), size);
+            offset += size;
+        }
+        std::memset(buf + offset, 0, buf_size - offset);
+        ins.emplace_back(lt, engine_, buf);
+    }
+    for (size_t i = 0; i < outputs_.size(); i++) {
+        logical_tensor_t lt = outputs_[i];
+        lt.dims[0] = bucket;
+        void *buf = buffers.allocate(ltw(lt).size());
+        if (!buf) return status::out_of_memory;
+        outs.emplace_back(lt, engine_, buf);
+    }
+
+    CHECK(cp->execute(astream, ins, outs));
+    CHECK(astream->wait());
+
+    for (size_t i = 0; i < outputs_.size(); i++) {
+        const char *buf = static_cast<const char *>(outs[i].get_data_handle());
+        size_t offset = 0;
+        for (const request_t *req : batch.requests) {
+            const tensor_t &t = (*req->outputs)[i];
+            const size_t size = ltw(t.get_logical_tensor()).size();
+            std::memcpy(t.get_data_handle(), buf + offset, size);
+            offset += size;
+        }
+    }
+    return status::success;
+}
+
+status_t dnnl_graph_batching_executor::execute(stream_t *astream,
+        const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs) const {
+    request_t req {&inputs, &outputs, 0};
+    CHECK(check_request(inputs, outputs, req.batch));
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A request which doesn't fit starts a new batch
+    if (open_ && open_->size + req.batch > max_batch_) {
+        open_->closed = true;
+        open_.reset();
+        cv_.notify_all();
+    }
+    const bool is_leader = !open_;
+    if (is_leader) open_ = std::make_shared<batch_t>();
+    std::shared_ptr<batch_t> batch = open_;
+    batch->requests.emplace_back(&req);
+    batch->size += req.batch;
+    if (batch->size >= max_batch_) {
+        batch->closed = true;
+        open_.reset();
+        cv_.notify_all();
+    }
+
+    if (!is_leader) {
+        cv_.wait(lock, [&] { return batch->done; });
+        return batch->status;
+    }
+
+    cv_.wait_for(lock, window_, [&] { return batch->closed; });
+    if (!batch->closed) {
+        batch->closed = true;
+        open_.reset();
+    }
+    lock.unlock();
+
+    // The followers are released however the execution ends, an exception
+    // thrown by a primitive or an allocation included.
+    const auto finish = [&](status_t status) {
+        lock.lock();
+        batch->status = status;
+        batch->done = true;
+        cv_.notify_all();
+        lock.unlock();
+    };
+    status_t status = status::runtime_error;
+    try {
+        status = run(astream, *batch);
+    } catch (...) {
+        finish(status::runtime_error);
+        throw;
+    }
+    finish(status);
+    return status;
+}
+
+status_t DNNL_API dnnl_graph_batching_executor_create(
+        batching_executor_t **executor, const partition_t *partition,
+        size_t num_inputs, const logical_tensor_t **inputs, size_t num_outputs,
+        const logical_tensor_t **outputs, engine_t *engine, size_t max_batch,
+        size_t window_us) {
+    if (utils::any_null(executor, partition, engine))
+        return status::invalid_arguments;
+    if ((num_inputs > 0 && !inputs) || num_outputs == 0 || !outputs)
+        return status::invalid_arguments;
+    if (!partition->is_supported()) return status::invalid_arguments;
+
+    std::vector<logical_tensor_t> ins, outs;
+    for (size_t i = 0; i < num_inputs; i++) {
+        if (!inputs[i]) return status::invalid_arguments;
+        ins.emplace_back(*inputs[i]);
+    }
+    for (size_t i = 0; i < num_outputs; i++) {
+        if (!outputs[i]) return status::invalid_arguments;
+        outs.emplace_back(*outputs[i]);
+    }
+
+    auto *ex = new batching_executor_t(*partition, engine);
+    const status_t ret = ex->init(ins, outs, max_batch, window_us);
+    if (ret != status::success) {
+        delete ex;
+        return ret;
+    }
+    *executor = ex;
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_batching_executor_destroy(
+        batching_executor_t *executor) {
+    delete executor;
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_batching_executor_get_num_compiled_batches(
+        const batching_executor_t *executor, size_t *num) {
+    if (utils::any_null(executor, num)) return status::invalid_arguments;
+    *num = executor->get_num_compiled_batches();
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_batching_executor_execute(
+        const batching_executor_t *executor, stream_t *stream,
+        size_t num_inputs, const tensor_t **inputs, size_t num_outputs,
+        const tensor_t **outputs) {
+    if (utils::any_null(executor, stream)) return status::invalid_arguments;
+    if ((num_inputs > 0 && !inputs) || (num_outputs > 0 && !outputs))
+        return status::invalid_arguments;
+
+    std::vector<tensor_t> ins, outs;
+    ins.reserve(num_inputs);
+    outs.reserve(num_outputs);
+    for (size_t i = 0; i < num_inputs; ++i) {
+        ins.emplace_back(**(inputs + i));
+    }
+    for (size_t i = 0; i < num_outputs; ++i) {
+        outs.emplace_back(**(outputs + i));
+    }
+    return executor->execute(stream, ins, outs);
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_INTERFACE_BATCHING_EXECUTOR_HPP
+#define GRAPH_INTERFACE_BATCHING_EXECUTOR_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "graph/interface/c_types_map.hpp"
+#include "graph/interface/partition.hpp"
+#include "graph/interface/tensor.hpp"
+
+// A batching executor runs concurrent requests of one partition together. The
+// first request of a batch becomes its leader: it waits for the time window or
+// until the batch is full, packs the inputs of all requests along dimension 0,
+// executes the partition compiled for the total batch size and copies the
+// outputs back. The other requests only wait for the leader to finish, so no
+// background thread is needed. A new batch opens as soon as the previous one
+// is closed, even if the latter is still executing.
+//
+// The total batch size is rounded up to a power of two, capped by the maximum
+// batch size, and the missing samples are zero-filled. This bounds the number
+// of compiled partitions by log2(max_batch) + 1.
+struct dnnl_graph_batching_executor {
+public:
+    dnnl_graph_batching_executor(const dnnl::impl::graph::partition_t &part,
+            const dnnl::impl::graph::engine_t *eng)
+        : partition_(part), engine_(eng) {}
+
+    // Validates the logical tensors of one request and the engine.
+    dnnl::impl::graph::status_t init(
+            const std::vector<dnnl::impl::graph::logical_tensor_t> &inputs,
+            const std::vector<dnnl::impl::graph::logical_tensor_t> &outputs,
+            size_t max_batch, size_t window_us);
+
+    size_t get_num_compiled_batches() const {
+        std::lock_guard<std::mutex> lock(compiled_mutex_);
+        return compiled_.size();
+    }
+
+    dnnl::impl::graph::status_t execute(dnnl::impl::graph::stream_t *astream,
+            const std::vector<dnnl::impl::graph::tensor_t> &inputs,
+            const std::vector<dnnl::impl::graph::tensor_t> &outputs) const;
+
+private:
+    struct request_t {
+        const std::vector<dnnl::impl::graph::tensor_t> *inputs;
+        const std::vector<dnnl::impl::graph::tensor_t> *outputs;
+        dnnl::impl::graph::dim_t batch;
+    };
+
+    struct batch_t {
+        std::vector<const request_t *> requests;
+        dnnl::impl::graph::dim_t size = 0;
+        // no request can join the batch anymore
+        bool closed = false;
+        // the outputs of all requests are written
+        bool done = false;
+        dnnl::impl::graph::status_t status = dnnl::impl::graph::status::success;
+    };
+
+    bool is_batched(const dnnl::impl::graph::logical_tensor_t &lt) const {
+        return lt.property != dnnl::impl::graph::property_type::constant;
+    }
+
+    // Checks the tensors of a request against the logical tensors given at
+    // creation and returns the batch size of the request.
+    dnnl::impl::graph::status_t check_request(
+            const std::vector<dnnl::impl::graph::tensor_t> &inputs,
+            const std::vector<dnnl::impl::graph::tensor_t> &outputs,
+            dnnl::impl::graph::dim_t &batch) const;
+
+    // Returns the batch size the partition is compiled for to execute a
+    // batch of the given total size.
+    dnnl::impl::graph::dim_t get_bucket(dnnl::impl::graph::dim_t batch) const;
+
+    dnnl::impl::graph::status_t get_or_compile(dnnl::impl::graph::dim_t batch,
+            std::shared_ptr<dnnl::impl::graph::compiled_partition_t> &cp)
+            const;
+
+    dnnl::impl::graph::status_t run(
+            dnnl::impl::graph::stream_t *astream, const batch_t &batch) const;
+
+    const dnnl::impl::graph::partition_t partition_;
+    const dnnl::impl::graph::engine_t *engine_;
+    std::vector<dnnl::impl::graph::logical_tensor_t> inputs_;
+    std::vector<dnnl::impl::graph::logical_tensor_t> outputs_;
+    dnnl::impl::graph::dim_t max_batch_ = 1;
+    std::chrono::microseconds window_ {0};
+
+    // guards the batch open for new requests
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    mutable std::shared_ptr<batch_t> open_;
+
+    // compiled partitions per bucket
+    mutable std::mutex compiled_mutex_;
+    mutable std::map<dnnl::impl::graph::dim_t,
+            std::shared_ptr<dnnl::impl::graph::compiled_partition_t>>
+            compiled_;
+};
+
+#endif
@@ -140,10 +140,13 @@ const op_kind_t DynamicDequantize = dnnl_graph_op_dynamic_dequantize;
 const op_kind_t DynamicQuantize = dnnl_graph_op_dynamic_quantize;
 const op_kind_t Elu = dnnl_graph_op_elu;
 const op_kind_t EluBackward = dnnl_graph_op_elu_backward;
+const op_kind_t EmbeddingBag = dnnl_graph_op_embedding_bag;
 const op_kind_t End = dnnl_graph_op_end;
 const op_kind_t Exp = dnnl_graph_op_exp;
+const op_kind_t Gather = dnnl_graph_op_gather;
 const op_kind_t GELU = dnnl_graph_op_gelu;
 const op_kind_t GELUBackward = dnnl_graph_op_gelu_backward;
+const op_kind_t GroupNorm = dnnl_graph_op_group_norm;
 const op_kind_t HardSwish = dnnl_graph_op_hard_swish;
 const op_kind_t HardSwishBackward = dnnl_graph_op_hard_swish_backward;
 const op_kind_t Interpolate = dnnl_graph_op_interpolate;
@@ -162,6 +165,7 @@ const op_kind_t Minimum = dnnl_graph_op_minimum;
 const op_kind_t Mish = dnnl_graph_op_mish;
 const op_kind_t MishBackward = dnnl_graph_op_mish_backward;
 const op_kind_t Multiply = dnnl_graph_op_multiply;
+const op_kind_t Pow = dnnl_graph_op_pow;
 const op_kind_t PReLU = dnnl_graph_op_prelu;
 const op_kind_t PReLUBackward = dnnl_graph_op_prelu_backward;
 const op_kind_t Quantize = dnnl_graph_op_quantize;
@@ -177,6 +181,7 @@ const op_kind_t ReLU = dnnl_graph_op_relu;
 const op_kind_t ReLUBackward = dnnl_graph_op_relu_backward;
 const op_kind_t Reorder = dnnl_graph_op_reorder;
 const op_kind_t Round = dnnl_graph_op_round;
+const op_kind_t Select = dnnl_graph_op_select;
 const op_kind_t Sigmoid = dnnl_graph_op_sigmoid;
 const op_kind_t SigmoidBackward = dnnl_graph_op_sigmoid_backward;
 const op_kind_t SoftMax = dnnl_graph_op_softmax;
@@ -294,6 +299,8 @@ using graph_t = dnnl_graph_graph;
 using op_t = dnnl_graph_op;
 using partition_t = dnnl_graph_partition;
 using compiled_partition_t = dnnl_graph_compiled_partition;
+using execution_plan_t = dnnl_graph_execution_plan;
+using batching_executor_t = dnnl_graph_batching_executor;
 using tensor_t = dnnl_graph_tensor;
 
 // oneDNN common objects
@@ -0,0 +1,220 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "oneapi/dnnl/dnnl_graph.h"
+
+#include "graph/interface/c_types_map.hpp"
+#include "graph/interface/execution_plan.hpp"
+#include "graph/interface/logical_tensor.hpp"
+
+#include "graph/utils/utils.hpp"
+
+using namespace dnnl::impl::graph;
+
+namespace {
+// Offsets in the arena are aligned like the buffers of the library allocator
+constexpr size_t arena_alignment = 64;
+
+size_t align_size(size_t size) {
+    return (size + arena_alignment - 1) / arena_alignment * arena_alignment;
+}
+} // namespace
+
+status_t dnnl_graph_execution_plan::init(
+        const std::vector<const compiled_partition_t *> &partitions,
+        const std::vector<size_t> &output_ids) {
+    using ltw = logical_tensor_wrapper_t;
+    partitions_ = partitions;
+    buffers_.clear();
+    arena_size_ = 0;
+
+    const std::unordered_set<size_t> outputs(
+            output_ids.begin(), output_ids.end());
+    for (size_t i = 0; i < partitions_.size(); i++) {
+        const compiled_partition_t *cp = partitions_[i];
+        if (!cp || !cp->is_initialized()) return status::invalid_arguments;
+
+        for (const auto &in : cp->get_inputs()) {
+            auto it = buffers_.find(in.id);
+            // graph inputs are given by the user
+            if (it == buffers_.end()) continue;
+            it->second.last = i;
+            // the consumer may read a larger buffer than the producer writes
+            const size_t size = ltw(in).size();
+            if (size == static_cast<size_t>(-1))
+                return status::invalid_arguments;
+            it->second.size = std::max(it->second.size, size);
+        }
+        for (const auto &out : cp->get_outputs()) {
+            if (outputs.count(out.id)) continue;
+            // every tensor has a single producer
+            if (buffers_.count(out.id)) return status::invalid_arguments;
+            const size_t size = ltw(out).size();
+            if (size == static_cast<size_t>(-1))
+                return status::invalid_arguments;
+            buffers_.emplace(out.id, buffer_t {size, i, i, 0});
+        }
+    }
+
+    // Place the largest buffers first, each at the lowest offset which does
+    // not overlap a placed buffer alive at the same time.
+    std::vector<std::pair<const size_t, buffer_t> *> order;
+    order.reserve(buffers_.size());
+    for (auto &kv : buffers_)
+        order.emplace_back(&kv);
+    std::sort(order.begin(), order.end(),
+            [](const std::pair<const size_t, buffer_t> *a,
+                    const std::pair<const size_t, buffer_t> *b) {
+                if (a->second.size != b->second.size)
+                    return a->second.size > b->second.size;
+                return a->first < b->first;
+            });
+
+    std::vector<const buffer_t *> placed;
+    placed.reserve(order.size());
+    for (auto *kv : order) {
+        buffer_t &buf = kv->second;
+        const size_t size = align_size(buf.size);
+        std::vector<const buffer_t *> conflicts;
+        for (const buffer_t *other : placed) {
+            if (other->first <= buf.last && buf.first <= other->last)
+                conflicts.emplace_back(other);
+        }
+        std::sort(conflicts.begin(), conflicts.end(),
+                [](const buffer_t *a, const buffer_t *b) {
+                    return a->offset < b->offset;
+                });
+
+        size_t offset = 0;
+        for (const buffer_t *other : conflicts) {
+            if (offset + size <= other->offset) break;
+            offset = std::max(offset, other->offset + align_size(other->size));
+        }
+        buf.offset = offset;
+        arena_size_ = std::max(arena_size_, offset + size);
+        placed.emplace_back(&buf);
+    }
+    return status::success;
+}
+
+status_t dnnl_graph_execution_plan::query_offset(
+        size_t tid, size_t *offset) const {
+    auto it = buffers_.find(tid);
+    if (it == buffers_.end()) return status::invalid_arguments;
+    *offset = it->second.offset;
+    return status::success;
+}
+
+status_t dnnl_graph_execution_plan::execute(const stream_t *astream,
+        void *arena, const std::vector<tensor_t> &inputs,
+        const std::vector<tensor_t> &outputs) const {
+    if (arena_size_ > 0 && !arena) return status::invalid_arguments;
+
+    std::unordered_map<size_t, const tensor_t *> user_tensors;
+    for (const auto *tensors : {&inputs, &outputs}) {
+        for (const auto &t : *tensors)
+            user_tensors[t.get_logical_tensor().id] = &t;
+    }
+
+    const auto get_tensor = [&](const compiled_partition_t *cp,
+                                    const logical_tensor_t &lt,
+                                    tensor_t &t) -> status_t {
+        auto it = buffers_.find(lt.id);
+        if (it != buffers_.end()) {
+            t = tensor_t(lt, cp->get_engine(),
+                    static_cast<char *>(arena) + it->second.offset);
+            return status::success;
+        }
+        auto user_it = user_tensors.find(lt.id);
+        if (user_it == user_tensors.end()) return status::invalid_arguments;
+        t = *user_it->second;
+        return status::success;
+    };
+
+    std::vector<tensor_t> ins, outs;
+    for (const compiled_partition_t *cp : partitions_) {
+        ins.resize(cp->get_inputs().size());
+        outs.resize(cp->get_outputs().size());
+        for (size_t i = 0; i < ins.size(); i++)
+            CHECK(get_tensor(cp, cp->get_inputs()[i], ins[i]));
+        for (size_t i = 0; i < outs.size(); i++)
+            CHECK(get_tensor(cp, cp->get_outputs()[i], outs[i]));
+        CHECK(cp->execute(astream, ins, outs));
+    }
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_execution_plan_create(execution_plan_t **plan,
+        size_t num_partitions, const compiled_partition_t **partitions,
+        size_t num_outputs, const size_t *output_ids) {
+    if (utils::any_null(plan, partitions)) return status::invalid_arguments;
+    if (num_partitions == 0 || (num_outputs > 0 && !output_ids))
+        return status::invalid_arguments;
+
+    std::vector<const compiled_partition_t *> cps(
+            partitions, partitions + num_partitions);
+    std::vector<size_t> outs(output_ids, output_ids + num_outputs);
+
+    auto *p = new execution_plan_t();
+    const status_t ret = p->init(cps, outs);
+    if (ret != status::success) {
+        delete p;
+        return ret;
+    }
+    *plan = p;
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_execution_plan_destroy(execution_plan_t *plan) {
+    delete plan;
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_execution_plan_get_arena_size(
+        const execution_plan_t *plan, size_t *size) {
+    if (utils::any_null(plan, size)) return status::invalid_arguments;
+    *size = plan->get_arena_size();
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_execution_plan_query_offset(
+        const execution_plan_t *plan, size_t tid, size_t *offset) {
+    if (utils::any_null(plan, offset)) return status::invalid_arguments;
+    return plan->query_offset(tid, offset);
+}
+
+status_t DNNL_API dnnl_graph_execution_plan_execute(
+        const execution_plan_t *plan, stream_t *stream, void *arena,
+        size_t num_inputs, const tensor_t **inputs, size_t num_outputs,
+        const tensor_t **outputs) {
+    if (utils::any_null(plan, stream)) return status::invalid_arguments;
+    if ((num_inputs > 0 && !inputs) || (num_outputs > 0 && !outputs))
+        return status::invalid_arguments;
+
+    std::vector<tensor_t> ins, outs;
+    ins.reserve(num_inputs);
+    outs.reserve(num_outputs);
+    for (size_t i = 0; i < num_inputs; ++i) {
+        ins.emplace_back(**(inputs + i));
+    }
+    for (size_t i = 0; i < num_outputs; ++i) {
+        outs.emplace_back(**(outputs + i));
+    }
+    return plan->execute(stream, arena, ins, outs);
+}
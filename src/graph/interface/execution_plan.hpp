@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_INTERFACE_EXECUTION_PLAN_HPP
+#define GRAPH_INTERFACE_EXECUTION_PLAN_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include "graph/interface/c_types_map.hpp"
+#include "graph/interface/partition.hpp"
+#include "graph/interface/tensor.hpp"
+
+// An execution plan runs a list of compiled partitions in order and places the
+// tensors passed between them in one arena. The lifetime of each intermediate
+// spans from the partition producing it to the last partition consuming it.
+// Intermediates with disjoint lifetimes share memory in the arena.
+struct dnnl_graph_execution_plan {
+public:
+    dnnl_graph_execution_plan() = default;
+
+    // Computes the lifetimes and the arena offsets of the intermediates. The
+    // tensors in output_ids and the tensors not produced by any partition are
+    // provided by the user at execution.
+    dnnl::impl::graph::status_t init(
+            const std::vector<const dnnl::impl::graph::compiled_partition_t *>
+                    &partitions,
+            const std::vector<size_t> &output_ids);
+
+    size_t get_arena_size() const { return arena_size_; }
+
+    dnnl::impl::graph::status_t query_offset(size_t tid, size_t *offset) const;
+
+    dnnl::impl::graph::status_t execute(
+            const dnnl::impl::graph::stream_t *astream, void *arena,
+            const std::vector<dnnl::impl::graph::tensor_t> &inputs,
+            const std::vector<dnnl::impl::graph::tensor_t> &outputs) const;
+
+private:
+    struct buffer_t {
+        size_t size;
+        // index of the producing partition
+        size_t first;
+        // index of the last consuming partition
+        size_t last;
+        size_t offset;
+    };
+
+    std::vector<const dnnl::impl::graph::compiled_partition_t *> partitions_;
+    std::unordered_map<size_t, buffer_t> buffers_;
+    size_t arena_size_ = 0;
+};
+
+#endif
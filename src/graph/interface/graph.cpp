@@ -195,6 +195,21 @@ status_t dnnl_graph_graph::get_ordered_partitions(
     return ret;
 }
 
+const dnnl_graph_graph::op_kind_index_t &
+dnnl_graph_graph::get_op_kind_index() {
+    if (op_kind_index_) return *op_kind_index_;
+
+    auto index = std::make_shared<op_kind_index_t>();
+    index->topo_ops.reserve(ops_.size());
+    topo_order_visit(get_output_ops(), [&](op_t *op) {
+        index->positions[op->get_kind()].push_back(index->topo_ops.size());
+        index->topo_ops.push_back(op);
+        return status::success;
+    });
+    op_kind_index_ = index;
+    return *op_kind_index_;
+}
+
 status_t dnnl_graph_graph::finalize() {
     // if the graph is already built, return directly.
     // TODO(xxx): actually we may need to a verification here.
@@ -264,6 +279,7 @@ status_t dnnl_graph_graph::finalize() {
         }
     }
 
+    op_kind_index_.reset();
     finalized_ = true;
     return status::success;
 }
@@ -58,6 +58,7 @@ void rewrite(
 
 struct dnnl_graph_graph : public graph::utils::id_t {
     using op_t = graph::op_t;
+    using op_kind_t = graph::op_kind_t;
     using value_t = graph::value_t;
     using op_ptr = std::shared_ptr<op_t>;
     using value_ptr = std::shared_ptr<value_t>;
@@ -81,6 +82,20 @@ private:
 
     bool finalized_ {false};
 
+public:
+    /*!
+     * \brief The ops in topological order and the positions of the ops of
+     *     each kind in this order.
+     */
+    struct op_kind_index_t {
+        std::vector<op_t *> topo_ops;
+        std::unordered_map<op_kind_t, std::vector<size_t>> positions;
+    };
+
+private:
+    // Built at the first query and dropped when ops are added or removed
+    std::shared_ptr<op_kind_index_t> op_kind_index_;
+
 public:
     dnnl_graph_graph(graph::engine_kind_t kind = graph::engine_kind::cpu)
         : engine_kind_(kind), fpmath_mode_(dnnl::impl::get_fpmath_mode()) {}
@@ -133,6 +148,7 @@ public:
                 }
             }
             ops_.push_back(std::make_shared<op_t>(tmp_ln));
+            op_kind_index_.reset();
             auto back_op = ops_.back().get();
             for (size_t i = 0; i < back_op->num_outputs(); i++)
                 back_op->get_output_value(i)->set_producer(*back_op);
@@ -142,6 +158,7 @@ public:
 
     op_t *create_op(dnnl_graph_op_kind_t kind, std::string name = "") {
         ops_.push_back(std::make_shared<op_t>(kind, std::move(name)));
+        op_kind_index_.reset();
         return ops_.back().get();
     }
 
@@ -151,6 +168,7 @@ public:
         auto pos = std::find_if(ops_.begin(), ops_.end(),
                 [op](const op_ptr &n) -> bool { return *n == *op; });
         if (pos != ops_.end()) ops_.erase(pos);
+        op_kind_index_.reset();
     }
 
     /*!
@@ -159,6 +177,14 @@ public:
      */
     const std::vector<op_ptr> &get_ops() const { return ops_; }
 
+    /*!
+     * \brief Get the op kind index of this finalized graph. The pattern
+     *     passes use it to visit only the ops their patterns can start from,
+     *     instead of traversing the whole graph for each pattern.
+     * \return The index, which stays valid until ops are added or removed
+     */
+    const op_kind_index_t &get_op_kind_index();
+
     /*! \brief how many ops in the graph */
     size_t num_ops() const { return ops_.size(); }
 
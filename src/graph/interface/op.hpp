@@ -370,10 +370,13 @@ public:
             CASE(DynamicQuantize);
             CASE(Elu);
             CASE(EluBackward);
+            CASE(EmbeddingBag);
             CASE(End);
             CASE(Exp);
+            CASE(Gather);
             CASE(GELU);
             CASE(GELUBackward);
+            CASE(GroupNorm);
             CASE(HardSwish);
             CASE(HardSwishBackward);
             CASE(Interpolate);
@@ -392,6 +395,7 @@ public:
             CASE(Mish);
             CASE(MishBackward);
             CASE(Multiply);
+            CASE(Pow);
             CASE(PReLU);
             CASE(PReLUBackward);
             CASE(Quantize);
@@ -407,6 +411,7 @@ public:
             CASE(ReLUBackward);
             CASE(Reorder);
             CASE(Round);
+            CASE(Select);
             CASE(Sigmoid);
             CASE(SigmoidBackward);
             CASE(SoftMax);
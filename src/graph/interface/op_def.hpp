@@ -507,6 +507,36 @@ DNNL_GRAPH_OP_SCHEMA(EluBackward, 1,
                         "T", {data_type::f32, data_type::bf16, data_type::f16})
                 .set_shape_inference_function(infer_identity_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(EmbeddingBag, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::optional)
+                .set_num_inputs(std::set<size_t>({3, 4}))
+                .set_num_outputs(1)
+                .set_input(0, "table", "2D embedding table", "T1")
+                .set_input(1, "indices",
+                        "1D tensor of the table rows to pool, the indices of "
+                        "all bags are concatenated",
+                        "T2")
+                .set_input(2, "offsets",
+                        "1D tensor with the position of the first index of "
+                        "every bag in indices",
+                        "T2")
+                .set_input(3, "per_sample_weights",
+                        "(optional) 1D tensor with one weight for every index, "
+                        "only supported with sum mode",
+                        "T3")
+                .set_output(0, "output",
+                        "2D tensor with one pooled row for every bag", "T1")
+                .set_attr(op_attr::mode,
+                        "specifies how the rows of a bag are pooled, the "
+                        "options are sum, mean and max",
+                        false, attribute_kind::s, "sum")
+                .set_type_constraints("T1", {data_type::f32, data_type::bf16})
+                .set_type_constraints("T2", {data_type::s32})
+                .set_type_constraints("T3", {data_type::f32})
+                .set_shape_inference_function(
+                        infer_embedding_bag_output_shape))
+
 DNNL_GRAPH_OP_SCHEMA(End, 1,
         op_schema_t()
                 .set_num_inputs(1)
@@ -527,6 +557,31 @@ DNNL_GRAPH_OP_SCHEMA(Exp, 1,
                         "T", {data_type::f32, data_type::bf16, data_type::f16})
                 .set_shape_inference_function(infer_identity_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(Gather, 1,
+        op_schema_t()
+                .set_num_inputs(2)
+                .set_num_outputs(1)
+                .set_input(0, "data", "input tensor", "T1")
+                .set_input(1, "indices",
+                        "indices of the slices to gather along axis. "
+                        "Negative indices count from the end of the axis; an "
+                        "index out of range fails the execution with "
+                        "invalid_arguments",
+                        "T2")
+                .set_output(0, "output",
+                        "output tensor, the gathered axis of data is "
+                        "replaced by the dimensions of indices",
+                        "T1")
+                .set_attr(op_attr::axis,
+                        "the axis of data to gather along, must be in the "
+                        "range [-r, r-1] where r is the rank of data",
+                        false, attribute_kind::i, int64_t(0))
+                .set_type_constraints("T1",
+                        {data_type::f32, data_type::bf16, data_type::f16,
+                                data_type::s8, data_type::u8, data_type::s32})
+                .set_type_constraints("T2", {data_type::s32})
+                .set_shape_inference_function(infer_gather_output_shape))
+
 DNNL_GRAPH_OP_SCHEMA(GELU, 1,
         op_schema_t()
                 .set_num_inputs(1)
@@ -550,6 +605,49 @@ DNNL_GRAPH_OP_SCHEMA(GELUBackward, 1,
                         "T", {data_type::f32, data_type::bf16, data_type::f16})
                 .set_shape_inference_function(infer_identity_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(GroupNorm, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::optional)
+                .set_num_inputs(std::set<size_t>({1, 3}))
+                .set_outputs_option(op_schema_t::param_num_option::optional)
+                .set_num_outputs(std::set<size_t>({1, 3}))
+                .set_input(0, "input", "input tensor", "T1")
+                .set_input(1, "gamma",
+                        "(optional) per-channel gamma scaling for normalized "
+                        "value",
+                        "T2")
+                .set_input(2, "beta",
+                        "(optional) per-channel bias added to the scaled "
+                        "normalized value",
+                        "T2")
+                .set_output(0, "output", "output tensor", "T1")
+                .set_output(1, "mean",
+                        "(optional) the mean calculated for every group", "T2")
+                .set_output(2, "variance",
+                        "(optional) the variance calculated for every group",
+                        "T2")
+                .set_attr(op_attr::groups,
+                        "the number of groups the channels are split into",
+                        true, attribute_kind::i)
+                .set_attr(op_attr::keep_stats,
+                        "used to indicate whether to output mean and variance",
+                        false, attribute_kind::b, true)
+                .set_attr(op_attr::use_affine,
+                        "when set to True, this module has learnable "
+                        "per-channel affine parameters",
+                        false, attribute_kind::b, true)
+                .set_attr(op_attr::epsilon,
+                        "constant to improve numerical stability", false,
+                        attribute_kind::f, 1e-5f)
+                .set_attr(op_attr::data_format,
+                        "the data format of input / output, the options are "
+                        "NCX and NXC",
+                        false, attribute_kind::s, "NXC")
+                .set_type_constraints("T1", {data_type::f32, data_type::bf16})
+                .set_type_constraints("T2", {data_type::f32, data_type::bf16})
+                .set_shape_inference_function(infer_groupnorm_output_shape)
+                .set_type_constraint_function(check_ln_data_type))
+
 DNNL_GRAPH_OP_SCHEMA(HardSwish, 1,
         op_schema_t()
                 .set_num_inputs(1)
@@ -943,6 +1041,18 @@ DNNL_GRAPH_OP_SCHEMA(Multiply, 1,
                 .set_shape_inference_function(
                         infer_elemwise_arithmetic_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(Pow, 1,
+        op_schema_t()
+                .set_num_inputs(1)
+                .set_num_outputs(1)
+                .set_input(0, "input", "input tensor", "T")
+                .set_output(0, "output", "output tensor", "T")
+                .set_attr(op_attr::beta, "exponent of the power", true,
+                        attribute_kind::f)
+                .set_type_constraints(
+                        "T", {data_type::f32, data_type::bf16, data_type::f16})
+                .set_shape_inference_function(infer_identity_output_shape))
+
 DNNL_GRAPH_OP_SCHEMA(PReLU, 1,
         op_schema_t()
                 .set_num_inputs(2)
@@ -1144,6 +1254,26 @@ DNNL_GRAPH_OP_SCHEMA(Round, 1,
                         "T", {data_type::f32, data_type::bf16, data_type::f16})
                 .set_shape_inference_function(infer_identity_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(Select, 1,
+        op_schema_t()
+                .set_num_inputs(3)
+                .set_num_outputs(1)
+                .set_input(0, "cond",
+                        "condition tensor, a non-zero value selects the "
+                        "element of then",
+                        "T1")
+                .set_input(1, "then", "first input tensor", "T2")
+                .set_input(2, "else", "second input tensor", "T2")
+                .set_output(0, "output", "output tensor", "T2")
+                .set_attr(op_attr::auto_broadcast,
+                        "specifies rules used for auto-broadcasting of input "
+                        "tensors",
+                        false, attribute_kind::s, "numpy")
+                .set_type_constraints("T1", {data_type::u8})
+                .set_type_constraints(
+                        "T2", {data_type::f32, data_type::bf16, data_type::f16})
+                .set_shape_inference_function(infer_select_output_shape))
+
 DNNL_GRAPH_OP_SCHEMA(Sigmoid, 1,
         op_schema_t()
                 .set_num_inputs(1)
@@ -207,6 +207,32 @@ status_t DNNL_API dnnl_graph_partition_compile(partition_t *partition,
     return status::success;
 }
 
+status_t DNNL_API dnnl_graph_partition_compile_from_cache_blob(
+        partition_t *partition, compiled_partition_t *compiled_partition,
+        size_t size, const uint8_t *cache_blob, engine_t *engine) {
+    if (utils::any_null(partition, compiled_partition, cache_blob, engine)) {
+        return status::invalid_arguments;
+    }
+
+    if (!partition->is_supported()) return status::invalid_arguments;
+
+    std::vector<uint8_t> blob(cache_blob, cache_blob + size);
+    if (utils::get_verbose() >= 2) {
+        double ms = dnnl::impl::get_msec();
+        CHECK(partition->compile_from_cache_blob(
+                compiled_partition, blob, engine));
+        ms = dnnl::impl::get_msec() - ms;
+
+        printf("onednn_graph_verbose,compile:from_cache_blob,%s,%g\n",
+                compiled_partition->info(), ms);
+        fflush(stdout);
+    } else {
+        CHECK(partition->compile_from_cache_blob(
+                compiled_partition, blob, engine));
+    }
+    return status::success;
+}
+
 status_t DNNL_API dnnl_graph_partition_get_input_ports_num(
         const partition_t *partition, size_t *num) {
     if (utils::any_null(partition, num)) { return status::invalid_arguments; }
@@ -451,6 +477,25 @@ status_t DNNL_API dnnl_graph_compiled_partition_query_logical_tensor(
     return compiled_partition->query_logical_tensor(tid, lt);
 }
 
+status_t DNNL_API dnnl_graph_compiled_partition_get_cache_blob(
+        const compiled_partition_t *compiled_partition, size_t *size,
+        uint8_t *cache_blob) {
+    if (utils::any_null(compiled_partition, size))
+        return status::invalid_arguments;
+
+    std::vector<uint8_t> blob;
+    CHECK(compiled_partition->get_cache_blob(blob));
+    if (!cache_blob) {
+        *size = blob.size();
+        return status::success;
+    }
+
+    // the constant tensors may be added to the blob between the two calls
+    if (*size != blob.size()) return status::invalid_arguments;
+    std::memcpy(cache_blob, blob.data(), blob.size());
+    return status::success;
+}
+
 status_t DNNL_API dnnl_graph_compiled_partition_get_inplace_ports(
         const compiled_partition_t *compiled_partition,
         size_t *num_inplace_pairs, const inplace_pair_t **inplace_pairs) {
@@ -603,6 +648,25 @@ status_t dnnl_graph_partition::compile(compiled_partition_t *cp,
     return status::success;
 }
 
+status_t dnnl_graph_partition::compile_from_cache_blob(
+        compiled_partition_t *cp, const std::vector<uint8_t> &cache_blob,
+        const engine_t *aengine) const {
+    if (!aengine || aengine->kind() != pimpl_->get_engine_kind())
+        return status::invalid_arguments;
+
+    const backend *backend = pimpl_->get_assigned_backend();
+    if (!backend) return status::invalid_arguments;
+
+    std::vector<logical_tensor_t> tmp_inputs, tmp_outputs;
+    CHECK(pimpl_->compile_from_cache_blob(cp, cache_blob, aengine));
+    if (!cp->is_initialized()) return status::unimplemented;
+
+    // encode backend id to the layout ids chosen by the compilation
+    CHECK(post_process(cp->get_mutable_inputs(), tmp_inputs, backend));
+    CHECK(post_process(cp->get_mutable_outputs(), tmp_outputs, backend));
+    return status::success;
+}
+
 status_t dnnl_graph_partition::compile(
         std::pair<compiled_partition_t *, bool> &compiled_partition,
         std::vector<const logical_tensor_t *> &inputs,
@@ -128,6 +128,11 @@ public:
             std::vector<const graph::logical_tensor_t *> &outputs,
             const graph::engine_t *aengine) const;
 
+    graph::status_t compile_from_cache_blob(
+            graph::compiled_partition_t *compiled_partition,
+            const std::vector<uint8_t> &cache_blob,
+            const graph::engine_t *aengine) const;
+
     graph::status_t infer_shape(
             std::vector<const graph::logical_tensor_t *> &inputs,
             std::vector<graph::logical_tensor_t *> &outputs);
@@ -186,6 +191,11 @@ public:
         return pimpl_->query_logical_tensor(tid, lt);
     }
 
+    graph::status_t get_cache_blob(std::vector<uint8_t> &cache_blob) const {
+        if (!pimpl_) return graph::status::invalid_arguments;
+        return pimpl_->get_cache_blob(cache_blob);
+    }
+
     const graph::engine_t *get_engine() const { return pimpl_->get_engine(); }
 
     std::vector<graph::logical_tensor_t> &get_mutable_inputs() {
@@ -165,6 +165,26 @@ public:
             const std::vector<logical_tensor_t> &outputs,
             const engine_t *aengine) const = 0;
 
+    /// Create a compiled partition from the cache blob of a previous
+    /// compilation of this partition, see
+    /// compiled_partition_impl_t::get_cache_blob
+    /// @param compiled_partition The pointer of an empty instance, whose
+    ///     pimpl_ field should be filled like in compile
+    /// @param cache_blob The cache blob
+    /// @param aengine The engine which the compiled partition is specialized
+    ///     for
+    /// @return The status code. Backends which don't support cache blobs
+    ///     return unimplemented
+    virtual status_t compile_from_cache_blob(
+            compiled_partition_t *compiled_partition,
+            const std::vector<uint8_t> &cache_blob,
+            const engine_t *aengine) const {
+        UNUSED(compiled_partition);
+        UNUSED(cache_blob);
+        UNUSED(aengine);
+        return status::unimplemented;
+    }
+
     /// get partition_impl id
     size_t id() const { return id_; }
 
@@ -337,6 +357,16 @@ public:
             = 0;
 #endif
 
+    /// Serialize the compiled state into a cache blob, which can be loaded
+    /// by partition_impl_t::compile_from_cache_blob
+    /// @param cache_blob The output cache blob
+    /// @return The status code. Backends which don't support cache blobs
+    ///     return unimplemented
+    virtual status_t get_cache_blob(std::vector<uint8_t> &cache_blob) const {
+        UNUSED(cache_blob);
+        return status::unimplemented;
+    }
+
 protected:
     /// The engine which this compiled_partition_impl_t is specialized
     /// for. Should directly store the engine that is given when calling
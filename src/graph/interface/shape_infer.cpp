@@ -991,6 +991,104 @@ status_t infer_norm_output_shape(op_t *n,
     return status::success;
 }
 
+status_t infer_groupnorm_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto status = infer_identity_output_shape(n, inputs, outputs);
+    if (status != status::success) return status;
+
+    auto in0 = logical_tensor_wrapper_t(inputs[0]);
+    if (in0.ndims() < 2) return status::invalid_shape;
+
+    const dim_t groups = n->get_attr<dim_t>(op_attr::groups);
+    const std::string data_format = n->has_attr(op_attr::data_format)
+            ? n->get_attr<std::string>(op_attr::data_format)
+            : "NXC";
+    const dims input0_dims = in0.vdims();
+    const dim_t channels = data_format == "NCX"
+            ? input0_dims[1]
+            : input0_dims[input0_dims.size() - 1];
+    if (groups <= 0
+            || (channels != DNNL_GRAPH_UNKNOWN_DIM && channels % groups != 0))
+        return status::invalid_shape;
+
+    // keep_stats defaults to true as in the op schema
+    const bool keep_stats = n->has_attr(op_attr::keep_stats)
+            ? n->get_attr<bool>(op_attr::keep_stats)
+            : true;
+    if (!keep_stats || outputs.size() < 3) return status::success;
+
+    // mean and variance are computed for every (mb, group) pair
+    const dims output_dims {input0_dims[0], groups};
+    for (size_t i = 1; i < 3; i++) {
+        // check if output shape is already known
+        auto out = logical_tensor_wrapper_t(outputs[i]);
+        if (out.is_shape_unknown()) {
+            set_shape_and_strides(*outputs[i], output_dims);
+        }
+    }
+    return status::success;
+}
+
+status_t infer_embedding_bag_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    UNUSED(n);
+    auto table = logical_tensor_wrapper_t(inputs[0]);
+    auto indices = logical_tensor_wrapper_t(inputs[1]);
+    auto offsets = logical_tensor_wrapper_t(inputs[2]);
+    if (table.ndims() != 2 || indices.ndims() != 1 || offsets.ndims() != 1)
+        return status::invalid_shape;
+    if (inputs.size() > 3) {
+        // per_sample_weights has one value for each index
+        auto weights = logical_tensor_wrapper_t(inputs[3]);
+        if (weights.ndims() != 1) return status::invalid_shape;
+        if (!weights.is_shape_unknown() && !indices.is_shape_unknown()
+                && weights.dims()[0] != indices.dims()[0])
+            return status::invalid_shape;
+    }
+
+    // one pooled row of the table for every bag
+    const dims output_dims {offsets.dims()[0], table.dims()[1]};
+    auto out0 = logical_tensor_wrapper_t(outputs[0]);
+    if (!out0.is_shape_unknown()) {
+        if (!validate(output_dims, out0.vdims())) return status::invalid_shape;
+        return status::success;
+    }
+    set_shape_and_strides(*outputs[0], output_dims);
+    return status::success;
+}
+
+status_t infer_gather_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto data = logical_tensor_wrapper_t(inputs[0]);
+    auto indices = logical_tensor_wrapper_t(inputs[1]);
+    const int32_t data_ndims = data.ndims();
+    if (data_ndims < 1 || indices.ndims() < 0) return status::invalid_shape;
+
+    int64_t axis = n->get_attr<int64_t>(op_attr::axis);
+    if (axis < -data_ndims || axis >= data_ndims) return status::invalid_shape;
+    if (axis < 0) axis += data_ndims;
+
+    // the gathered axis of data is replaced by the dims of indices
+    const dims data_dims = data.vdims();
+    const dims indices_dims = indices.vdims();
+    dims output_dims(data_dims.begin(), data_dims.begin() + axis);
+    output_dims.insert(
+            output_dims.end(), indices_dims.begin(), indices_dims.end());
+    output_dims.insert(
+            output_dims.end(), data_dims.begin() + axis + 1, data_dims.end());
+
+    auto out0 = logical_tensor_wrapper_t(outputs[0]);
+    if (!out0.is_shape_unknown()) {
+        if (!validate(output_dims, out0.vdims())) return status::invalid_shape;
+        return status::success;
+    }
+    set_shape_and_strides(*outputs[0], output_dims);
+    return status::success;
+}
+
 status_t infer_norm_bprop_output_shape(op_t *n,
         std::vector<logical_tensor_t *> &inputs,
         std::vector<logical_tensor_t *> &outputs) {
@@ -1042,6 +1140,40 @@ status_t infer_elemwise_arithmetic_output_shape(op_t *n,
     return status::success;
 }
 
+status_t infer_select_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto out0 = logical_tensor_wrapper_t(outputs[0]);
+    if (!out0.is_shape_unknown()) return status::success;
+
+    const bool shapes_should_match = n->has_attr(op_attr::auto_broadcast)
+            ? "none" == n->get_attr<std::string>(op_attr::auto_broadcast)
+            : false;
+
+    // condition, then and else are broadcast to one shape
+    dims inferred_out_shape = logical_tensor_wrapper_t(inputs[0]).vdims();
+    for (size_t i = 1; i < inputs.size(); ++i) {
+        const dims input_dims = logical_tensor_wrapper_t(inputs[i]).vdims();
+        if (shapes_should_match) {
+            if (input_dims != inferred_out_shape) return status::invalid_shape;
+            continue;
+        }
+        dims broadcasted;
+        status_t ret = broadcast(inferred_out_shape, input_dims, broadcasted);
+        if (ret != status::success) return ret;
+        inferred_out_shape = broadcasted;
+    }
+    // check if partial set shape aligns with inferred shape
+    if (out0.ndims() != -1) {
+        if (!validate(inferred_out_shape, out0.vdims())) {
+            return status::invalid_shape;
+        }
+    }
+
+    set_shape_and_strides(*outputs[0], inferred_out_shape);
+    return status::success;
+}
+
 status_t infer_bn_fwd_train_output_shape(op_t *n,
         std::vector<logical_tensor_t *> &inputs,
         std::vector<logical_tensor_t *> &outputs) {
@@ -134,6 +134,12 @@ public:
         return accept_internal_inputs_;
     };
 
+    // The op kinds the node can match. Empty if the node is created with a
+    // decision function, as it may match ops of any kind.
+    const std::vector<dnnl::impl::graph::op_kind_t> &get_op_kinds() const {
+        return op_kinds_;
+    }
+
 protected:
     friend class pb_graph_t;
     pb_op_t(const decision_function &p_fn);
@@ -195,6 +201,8 @@ protected:
                |
     */
     bool accept_internal_inputs_ = false;
+
+    std::vector<dnnl::impl::graph::op_kind_t> op_kinds_;
 };
 
 //
@@ -317,6 +325,11 @@ public:
 
     std::vector<pb_node_t *> get_nodes();
 
+    // Get the kinds of the ops a match of the graph can start from. Returns
+    // false if a match can start from an op of any kind.
+    bool get_start_op_kinds(
+            std::unordered_set<dnnl::impl::graph::op_kind_t> &kinds);
+
 protected:
     pb_op_t *append_op(const decision_function &type_checker,
             const in_edges_t &p_in_edges, std::string name = "");
@@ -333,6 +333,11 @@ void skip_unimplemented_prb(const prb_t *prb, res_t *res) {
         res->state = SKIPPED;
         res->reason = CASE_NOT_SUPPORTED;
     }
+    // Welford statistics are not supported on GPU
+    if (is_gpu() && (prb->flags & WELFORD_STATS)) {
+        res->state = SKIPPED;
+        res->reason = CASE_NOT_SUPPORTED;
+    }
 }
 
 void skip_invalid_prb(const prb_t *prb, res_t *res) {
@@ -341,6 +346,14 @@ void skip_invalid_prb(const prb_t *prb, res_t *res) {
         skip_invalid_inplace(res, prb->dt, prb->dt, prb->tag, prb->tag);
         if (res->state == SKIPPED) return;
     }
+    // Welford statistics are computed on forward only and replace neither
+    // given nor global statistics.
+    if ((prb->flags & WELFORD_STATS)
+            && (!(prb->dir & FLAG_FWD) || (prb->flags & GLOB_STATS))) {
+        res->state = SKIPPED;
+        res->reason = INVALID_CASE;
+        return;
+    }
 }
 
 void setup_cmp(compare::compare_t &cmp, const prb_t *prb, data_kind_t kind,
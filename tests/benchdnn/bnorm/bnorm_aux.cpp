@@ -45,6 +45,7 @@ flags_t str2flags(const char *str) {
         if (*str == 'H') flags |= USE_SHIFT;
         if (*str == 'R') flags |= FUSE_NORM_RELU;
         if (*str == 'A') flags |= FUSE_NORM_ADD_RELU;
+        if (*str == 'W') flags |= WELFORD_STATS;
         str++;
     }
     return flags;
@@ -57,6 +58,7 @@ std::string flags2str(flags_t flags) {
     if (flags & USE_SHIFT) str += "H";
     if (flags & FUSE_NORM_RELU) str += "R";
     if (flags & FUSE_NORM_ADD_RELU) str += "A";
+    if (flags & WELFORD_STATS) str += "W";
     return str;
 }
 
@@ -0,0 +1,428 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <float.h>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sstream>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "utils/parallel.hpp"
+
+#include "dnnl_common.hpp"
+#include "dnnl_memory.hpp"
+
+#include "binary/binary.hpp"
+#include "gnorm/gnorm.hpp"
+
+namespace gnorm {
+
+static int prepare_fwd(const prb_t *prb, dnn_mem_t &src, dnn_mem_t &mean,
+        dnn_mem_t &var, dnn_mem_t &sc, dnn_mem_t &sh) {
+    /** Idea: choose src[] values so that both mean and variance are computed
+     * exactly (independently of the order of the computations).
+     *
+     * Every group of `ic / g * sp` points is filled with pairs of values
+     * symmetric around the group mean: (m + d, m - d), where `m` and `d` are
+     * powers of 2. The last point of a group of an odd size is set to `m`.
+     */
+    const int64_t L = prb->group_size();
+
+    benchdnn_parallel_nd(prb->mb, prb->g, [&](int64_t mb, int64_t g) {
+        const int64_t stat_off = mb * prb->g + g;
+        // Note: we use a different seed for each group to avoid repeating
+        // patterns. We also add 1 to avoid seeding with 0.
+        std::minstd_rand int_seed(stat_off + 1);
+        int_seed.discard(1);
+        std::minstd_rand b_seed(stat_off + 1);
+        b_seed.discard(2);
+
+        const float val_coeff = is_integral_dt(prb->dt[0]) ? 4.f : 1.f;
+        const int distr_shift = prb->dt[0] == dnnl_u8 ? 2 : 0;
+        std::uniform_int_distribution<> int_dist(0 + distr_shift, 6);
+        std::bernoulli_distribution b_dist(0.5f);
+        const float m = val_coeff * 0.25f * (1 << int_dist(int_seed));
+        float v = 0; /* current variance */
+
+        const int64_t off_base = (mb * prb->ic + g * prb->ic_per_g()) * prb->sp;
+        float *s = (float *)src + off_base;
+
+        bool bigger_val = false;
+        for (int64_t l = 0; l < L; ++l) {
+            float val = m;
+            if (l % 2 == 0) {
+                bigger_val = b_dist(b_seed);
+                val += val_coeff * (bigger_val ? 1.f : 0.25f);
+            } else {
+                val -= val_coeff * (bigger_val ? 1.f : 0.25f);
+            }
+            if (L % 2 && l == L - 1) val = m;
+            s[l] = val;
+            v += (val - m) * (val - m);
+        }
+        mean.set_elem(stat_off, m);
+        var.set_elem(stat_off, v / L);
+    });
+
+    const bool use_sc = prb->use_sc();
+    const bool use_sh = prb->use_sh();
+
+    benchdnn_parallel_nd(prb->ic, [&](int64_t c) {
+        float sc_value = 1.f / 8 * (1 << (c % 7));
+        float sh_value = (c % 3 + 1) * sc_value / 64;
+        ((float *)sc)[c] = use_sc ? sc_value : 1.0f;
+        ((float *)sh)[c] = use_sh ? sh_value : 0.0f;
+    });
+    return OK;
+}
+
+static int prepare_bwd(const prb_t *prb, dnn_mem_t &src, dnn_mem_t &d_dst,
+        dnn_mem_t &mean, dnn_mem_t &var, dnn_mem_t &sc) {
+    if (prb->group_size() < 2) return FAIL;
+
+    const bool use_sc = prb->use_sc();
+
+    // fill gamma
+    for (int64_t c = 0; c < prb->ic; ++c) {
+        const float sc_value = 0.125f * (1 << (c % 7));
+        ((float *)sc)[c] = use_sc ? sc_value : 1.0f;
+    }
+
+    benchdnn_parallel_nd(prb->mb, prb->g, [&](int64_t mb, int64_t g) {
+        const int64_t stat_off = mb * prb->g + g;
+        // Note: we use a different seed for each group to avoid repeating
+        // patterns. We also add 1 to avoid seeding with 0.
+        std::minstd_rand int_seed(stat_off + 1);
+        int_seed.discard(1);
+        std::minstd_rand b_seed(stat_off + 1);
+        b_seed.discard(2);
+
+        // The same idea as in lnorm: src data is simplified to (m+1) and
+        // (m-1) points, d_dst data is random but all values are pow2 values
+        // to have almost exact summation result.
+        std::uniform_int_distribution<> stat_dist(0, 2);
+        std::uniform_int_distribution<> data_dist(0, 6);
+        std::bernoulli_distribution half_dist(0.5f);
+
+        // mean = {-0.5f, 0.f, 0.5f}
+        const float m = 0.5f * (stat_dist(int_seed) - 1);
+        mean.set_elem(stat_off, m);
+
+        // final variance = {0.25f, 1.f, 4.f}
+        const float v = 0.25f * (1 << (stat_dist(int_seed) * 2));
+        var.set_elem(stat_off, v - prb->eps);
+
+        const int64_t off_base = (mb * prb->ic + g * prb->ic_per_g()) * prb->sp;
+
+        for (int64_t l = 0; l < prb->group_size(); ++l) {
+            int sign = half_dist(b_seed) ? 1.f : -1.f;
+            // d_dst = powf(2, {-4, ... , 2})
+            float dd = sign * 0.0625f * (1LL << data_dist(int_seed));
+            d_dst.set_elem(off_base + l,
+                    round_to_nearest_representable(prb->dt[1], dd));
+
+            float s = l % 2 == 0 ? (m - 1.f) : (m + 1.f);
+            src.set_elem(off_base + l,
+                    round_to_nearest_representable(prb->dt[0], s));
+        }
+    });
+
+    return OK;
+}
+
+int fill_scales(
+        const attr_t &attr, int arg, dnn_mem_t &mem_dt, dnn_mem_t &mem_fp) {
+    const auto nelems = mem_fp.nelems();
+    if (nelems == 0) return OK;
+
+    assert(mem_dt.nelems() == mem_fp.nelems() && nelems == 1);
+
+    const auto &scales = attr.scales.get(arg);
+    mem_fp.set_elem(0, scales.scale);
+
+    SAFE(mem_dt.reorder(mem_fp), WARN);
+
+    return OK;
+}
+
+dnnl_status_t init_pd(init_pd_args_t<prb_t> &init_pd_args) {
+    const prb_t *prb = init_pd_args.prb;
+
+    auto src_d = dnn_mem_t::init_md(
+            prb->ndims, prb->dims.data(), prb->dt[0], prb->tag[0]);
+
+    attr_args_t attr_args;
+    attr_args.prepare_post_ops_mds(prb->attr, prb->ndims, prb->dims.data());
+    auto dnnl_attr = make_benchdnn_dnnl_wrapper(
+            create_dnnl_attr(prb->attr, attr_args));
+
+    auto flags = (dnnl_normalization_flags_t)prb->flags;
+    if (prb->dir & FLAG_FWD) {
+        auto dst_d = dnn_mem_t::init_md(
+                prb->ndims, prb->dims.data(), prb->dt[1], prb->tag[1]);
+        auto prop = prb->dir & FLAG_INF ? dnnl_forward_inference
+                                        : dnnl_forward_training;
+        DNN_SAFE_STATUS(dnnl_group_normalization_forward_primitive_desc_create(
+                &init_pd_args.pd, init_pd_args.engine, prop, src_d, dst_d,
+                prb->g, prb->eps, flags, dnnl_attr));
+    } else {
+        auto diff_src_d = dnn_mem_t::init_md(
+                prb->ndims, prb->dims.data(), prb->dt[0], prb->tag[0]);
+        auto diff_dst_d = dnn_mem_t::init_md(
+                prb->ndims, prb->dims.data(), prb->dt[1], prb->tag[1]);
+        auto prop = prb->dir & FLAG_WEI ? dnnl_backward : dnnl_backward_data;
+        DNN_SAFE_STATUS(dnnl_group_normalization_backward_primitive_desc_create(
+                &init_pd_args.pd, init_pd_args.engine, prop, diff_src_d,
+                diff_dst_d, src_d, prb->g, prb->eps, flags, init_pd_args.hint,
+                dnnl_attr));
+    }
+
+    return dnnl_success;
+}
+
+void skip_unimplemented_prb(const prb_t *prb, res_t *res) {
+    skip_unimplemented_data_type({prb->dt[0], prb->dt[1]}, prb->dir, res);
+    skip_unimplemented_sum_po(prb->attr, res);
+
+    if (is_gpu()) {
+        res->state = SKIPPED, res->reason = CASE_NOT_SUPPORTED;
+        return;
+    }
+}
+
+void skip_invalid_prb(const prb_t *prb, res_t *res) {
+    if (prb->g <= 0 || prb->ic % prb->g != 0) {
+        res->state = SKIPPED, res->reason = INVALID_CASE;
+        return;
+    }
+
+    // See `skip_invalid_inplace` for details.
+    if (prb->inplace) {
+        skip_invalid_inplace(
+                res, prb->dt[0], prb->dt[1], prb->tag[0], prb->tag[1]);
+        if (res->state == SKIPPED) return;
+    }
+}
+
+void setup_cmp(compare::compare_t &cmp, const prb_t *prb, data_kind_t kind,
+        const args_t &ref_args) {
+    const bool compare_with_norm = (prb->dir & FLAG_BWD);
+    cmp.set_norm_validation_mode(compare_with_norm);
+
+    const auto dt = prb->dir & FLAG_FWD ? prb->dt[1] : prb->dt[0];
+    const int f32_mant_digits = 24;
+    const float trh_coeff = (1 << (f32_mant_digits - digits_dt(dt)));
+    float trh = trh_coeff * ((kind == SRC || kind == DST) ? 5e-7 : 0);
+    if ((kind == SC || kind == SH) && prb->dir & FLAG_BWD)
+        trh = trh_coeff * 5e-6;
+    // Post-ops are computed in f32 on top of the normalized value.
+    if (kind == DST && !prb->attr.post_ops.is_def())
+        trh = MAX2(trh, trh_coeff * 4e-6);
+    cmp.set_threshold(trh);
+
+    // u8 turns half of output into zeros.
+    if (prb->dt[1] == dnnl_u8) cmp.set_zero_trust_percent(60.f);
+}
+
+int doit(const prb_t *prb, res_t *res) {
+    if (bench_mode == LIST) return res->state = LISTED, OK;
+
+    benchdnn_dnnl_wrapper_t<dnnl_primitive_t> prim;
+    SAFE(init_prim(prb->ctx_init, prim, init_pd, prb, res), WARN);
+    if (res->state == SKIPPED || res->state == UNIMPLEMENTED) return OK;
+
+    auto const_pd = query_pd(prim);
+
+    const bool use_sc = prb->use_sc();
+    const bool use_sh = prb->use_sh();
+
+    const auto &src_md = query_md(const_pd, DNNL_ARG_SRC);
+    const auto &mean_md = query_md(const_pd, DNNL_ARG_MEAN);
+    const auto &var_md = query_md(const_pd, DNNL_ARG_VARIANCE);
+    const auto &sc_md = query_md(const_pd, DNNL_ARG_SCALE);
+    const auto &sh_md = query_md(const_pd, DNNL_ARG_SHIFT);
+    const auto &scratchpad_md = query_md(const_pd, DNNL_ARG_SCRATCHPAD);
+
+    const auto &test_engine = get_test_engine();
+    const auto &ref_engine = get_cpu_engine();
+
+    dnn_mem_t src_fp(src_md, dnnl_f32, tag::abx, ref_engine);
+    dnn_mem_t src_dt(src_md, test_engine);
+    dnn_mem_t placeholder_dst_dt;
+    dnn_mem_t &dst_dt = prb->inplace ? src_dt : placeholder_dst_dt;
+
+    // On inference w/o global stats the group norm doesn't require stat
+    // memories. Hence, we need to prepare the mean_fp and var_fp ourselves.
+    const dnnl_dims_t stat_dims = {prb->mb, prb->g};
+    dnn_mem_t mean_fp(2, stat_dims, dnnl_f32, tag::abx, ref_engine);
+    dnn_mem_t mean_dt(mean_md, test_engine);
+
+    dnn_mem_t var_fp(2, stat_dims, dnnl_f32, tag::abx, ref_engine);
+    dnn_mem_t var_dt(var_md, test_engine);
+
+    const dnnl_dims_t ss_dims = {prb->ic};
+    dnn_mem_t sc_fp(1, ss_dims, dnnl_f32, tag::x, ref_engine);
+    dnn_mem_t sc_dt(sc_md, test_engine);
+
+    dnn_mem_t sh_fp(1, ss_dims, dnnl_f32, tag::x, ref_engine);
+    dnn_mem_t sh_dt(sh_md, test_engine);
+
+    dnn_mem_t scratchpad_dt(scratchpad_md, test_engine);
+
+    dnn_mem_t d_dst_dt, placeholder_d_src_dt, d_sc_dt, d_sh_dt;
+
+    const dnnl_dims_t scale_dims = {1};
+    auto scales_md = dnn_mem_t::init_md(1, scale_dims, dnnl_f32, tag::abx);
+    dnn_mem_t src_scales_dt(scales_md, test_engine);
+    dnn_mem_t dst_scales_dt(scales_md, test_engine);
+
+    std::vector<dnn_mem_t> binary_po_fp, binary_po_dt;
+    std::vector<int> binary_po_args;
+
+    args_t args, ref_args;
+
+    if (prb->dir & FLAG_FWD) {
+        const auto &dst_md = query_md(const_pd, DNNL_ARG_DST);
+
+        dnn_mem_t &dst_fp = src_fp; // in-place reference
+        if (!prb->inplace) {
+            placeholder_dst_dt = dnn_mem_t(dst_md, test_engine);
+        }
+
+        if (prepare_fwd(prb, src_fp, mean_fp, var_fp, sc_fp, sh_fp) != OK) {
+            return res->state = MISTRUSTED, OK;
+        }
+
+        SAFE(src_dt.reorder(src_fp), WARN);
+        if (prb->flags & GLOB_STATS) {
+            /* prepare mean & var if they are inputs */
+            SAFE(mean_dt.reorder(mean_fp), WARN);
+            SAFE(var_dt.reorder(var_fp), WARN);
+        }
+        if (use_sc) { SAFE(sc_dt.reorder(sc_fp), WARN); }
+        if (use_sh) { SAFE(sh_dt.reorder(sh_fp), WARN); }
+
+        dnn_mem_t src_scales_fp(scales_md, ref_engine);
+        dnn_mem_t dst_scales_fp(scales_md, ref_engine);
+        fill_scales(prb->attr, DNNL_ARG_SRC, src_scales_dt, src_scales_fp);
+        fill_scales(prb->attr, DNNL_ARG_DST, dst_scales_dt, dst_scales_fp);
+
+        SAFE(binary::setup_binary_po(
+                     const_pd, binary_po_args, binary_po_dt, binary_po_fp),
+                WARN);
+
+        args.set(DNNL_ARG_SRC, src_dt);
+        args.set(DNNL_ARG_MEAN, mean_dt);
+        args.set(DNNL_ARG_VARIANCE, var_dt);
+        args.set(DNNL_ARG_SCALE, sc_dt);
+        args.set(DNNL_ARG_SHIFT, sh_dt);
+        args.set(DNNL_ARG_DST, dst_dt);
+        args.set(DNNL_ARG_SCRATCHPAD, scratchpad_dt);
+        args.set(DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, src_scales_dt);
+        args.set(DNNL_ARG_ATTR_SCALES | DNNL_ARG_DST, dst_scales_dt);
+        args.set(binary_po_args, binary_po_dt);
+
+        SAFE(execute_and_wait(prim, args, res), WARN);
+
+        if (is_bench_mode(CORR)) {
+            ref_args.set(DNNL_ARG_SRC, src_fp);
+            ref_args.set(DNNL_ARG_MEAN, mean_fp);
+            ref_args.set(DNNL_ARG_VARIANCE, var_fp);
+            ref_args.set(DNNL_ARG_SCALE, sc_fp);
+            ref_args.set(DNNL_ARG_SHIFT, sh_fp);
+            ref_args.set(DNNL_ARG_DST, dst_fp);
+            ref_args.set(DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, src_scales_fp);
+            ref_args.set(DNNL_ARG_ATTR_SCALES | DNNL_ARG_DST, dst_scales_fp);
+            ref_args.set(binary_po_args, binary_po_fp);
+
+            std::vector<data_kind_t> kinds {DST};
+            if (!(prb->flags & GLOB_STATS) && !(prb->dir & FLAG_INF)) {
+                kinds.push_back(MEAN);
+                kinds.push_back(VAR);
+            }
+
+            check_correctness(prb, kinds, args, ref_args, setup_cmp, res);
+        }
+    } else {
+        const auto &d_src_md = query_md(const_pd, DNNL_ARG_DIFF_SRC);
+        const auto &d_dst_md = query_md(const_pd, DNNL_ARG_DIFF_DST);
+
+        dnn_mem_t d_dst_fp(d_dst_md, dnnl_f32, tag::abx, ref_engine);
+        d_dst_dt = dnn_mem_t(d_dst_md, test_engine);
+
+        dnn_mem_t &d_src_fp = d_dst_fp; // in-place in ref code
+        if (!prb->inplace) {
+            placeholder_d_src_dt = dnn_mem_t(d_src_md, test_engine);
+        }
+        dnn_mem_t &d_src_dt = prb->inplace ? d_dst_dt : placeholder_d_src_dt;
+
+        d_sc_dt = dnn_mem_t(sc_md, test_engine);
+        dnn_mem_t d_sc_fp(1, ss_dims, dnnl_f32, tag::x, ref_engine);
+
+        d_sh_dt = dnn_mem_t(sh_md, test_engine);
+        dnn_mem_t d_sh_fp(1, ss_dims, dnnl_f32, tag::x, ref_engine);
+
+        if (prepare_bwd(prb, src_fp, d_dst_fp, mean_fp, var_fp, sc_fp) != OK) {
+            return res->state = MISTRUSTED, OK;
+        }
+
+        SAFE(src_dt.reorder(src_fp), WARN);
+        SAFE(d_dst_dt.reorder(d_dst_fp), WARN);
+        SAFE(mean_dt.reorder(mean_fp), WARN);
+        SAFE(var_dt.reorder(var_fp), WARN);
+        if (use_sc) { SAFE(sc_dt.reorder(sc_fp), WARN); }
+        if (use_sh) { SAFE(sh_dt.reorder(sh_fp), WARN); }
+
+        args.set(DNNL_ARG_SRC, src_dt);
+        args.set(DNNL_ARG_DIFF_DST, d_dst_dt);
+        args.set(DNNL_ARG_DIFF_SRC, d_src_dt);
+        args.set(DNNL_ARG_MEAN, mean_dt);
+        args.set(DNNL_ARG_VARIANCE, var_dt);
+        args.set(DNNL_ARG_SCALE, sc_dt);
+        args.set(DNNL_ARG_DIFF_SCALE, d_sc_dt);
+        args.set(DNNL_ARG_SHIFT, sh_dt);
+        args.set(DNNL_ARG_DIFF_SHIFT, d_sh_dt);
+        args.set(DNNL_ARG_SCRATCHPAD, scratchpad_dt);
+
+        SAFE(execute_and_wait(prim, args, res), WARN);
+
+        if (is_bench_mode(CORR)) {
+            ref_args.set(DNNL_ARG_SRC, src_fp);
+            ref_args.set(DNNL_ARG_MEAN, mean_fp);
+            ref_args.set(DNNL_ARG_VARIANCE, var_fp);
+            ref_args.set(DNNL_ARG_SCALE, sc_fp);
+            ref_args.set(DNNL_ARG_SHIFT, sh_fp);
+            ref_args.set(DNNL_ARG_DIFF_DST, d_dst_fp);
+            ref_args.set(DNNL_ARG_DIFF_SRC, d_src_fp);
+            ref_args.set(DNNL_ARG_DIFF_SCALE, d_sc_fp);
+            ref_args.set(DNNL_ARG_DIFF_SHIFT, d_sh_fp);
+
+            std::vector<data_kind_t> kinds {SRC};
+            if (use_sc && (prb->dir & FLAG_WEI)) kinds.push_back(SC);
+            if (use_sh && (prb->dir & FLAG_WEI)) kinds.push_back(SH);
+
+            check_correctness(prb, kinds, args, ref_args, setup_cmp, res);
+        }
+    }
+
+    return measure_perf(prb->ctx_exe, res, prim, args);
+}
+
+} // namespace gnorm
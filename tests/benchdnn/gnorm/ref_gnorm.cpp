@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "utils/parallel.hpp"
+
+#include "gnorm/gnorm.hpp"
+
+namespace gnorm {
+
+void compute_ref_fwd(const prb_t *prb, const args_t &args) {
+    const dnn_mem_t &src = args.find(DNNL_ARG_SRC);
+    const dnn_mem_t &mean = args.find(DNNL_ARG_MEAN);
+    const dnn_mem_t &var = args.find(DNNL_ARG_VARIANCE);
+    const dnn_mem_t &sc = args.find(DNNL_ARG_SCALE);
+    const dnn_mem_t &sh = args.find(DNNL_ARG_SHIFT);
+    const dnn_mem_t &dst = args.find(DNNL_ARG_DST);
+    const dnn_mem_t &src_scale = args.find(DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC);
+    const dnn_mem_t &dst_scale = args.find(DNNL_ARG_ATTR_SCALES | DNNL_ARG_DST);
+
+    float *dst_ptr = (float *)dst;
+
+    const bool use_sc = prb->use_sc();
+    const bool use_sh = prb->use_sh();
+
+    assert(src_scale.nelems() == 1 && dst_scale.nelems() == 1);
+    const float src_scale_val = src_scale.get_elem(0);
+    const float dst_scale_val = dst_scale.get_elem(0);
+
+    const auto v_po_masks = prb->attr.post_ops.get_po_masks();
+    const int64_t CG = prb->ic_per_g();
+    benchdnn_parallel_nd(prb->mb, prb->g, [&](int64_t mb, int64_t g) {
+        const int64_t stat_off = mb * prb->g + g;
+        const float smean = mean.get_elem(stat_off);
+        const float svar = var.get_elem(stat_off);
+        const float sqrt_var = sqrtf(svar + prb->eps);
+
+        for (int64_t c = g * CG; c < (g + 1) * CG; ++c) {
+            const float gamma = (use_sc ? sc.get_elem(c) : 1.0f) / sqrt_var;
+            const float beta = use_sh ? sh.get_elem(c) : 0;
+            for (int64_t sp = 0; sp < prb->sp; ++sp) {
+                const auto off = (mb * prb->ic + c) * prb->sp + sp;
+                float res = gamma * (src.get_elem(off) - smean) + beta;
+                res *= src_scale_val;
+
+                const auto v_po_vals
+                        = prepare_po_vals(dst, args, v_po_masks, off);
+                maybe_post_ops(prb->attr, res, 0.f, v_po_vals);
+                dst_ptr[off] = res / dst_scale_val;
+            }
+        }
+    });
+}
+
+void compute_ref_bwd(const prb_t *prb, const args_t &args) {
+    const dnn_mem_t &src = args.find(DNNL_ARG_SRC);
+    const dnn_mem_t &mean = args.find(DNNL_ARG_MEAN);
+    const dnn_mem_t &var = args.find(DNNL_ARG_VARIANCE);
+    const dnn_mem_t &d_dst = args.find(DNNL_ARG_DIFF_DST);
+    const dnn_mem_t &sc = args.find(DNNL_ARG_SCALE);
+    const dnn_mem_t &d_src = args.find(DNNL_ARG_DIFF_SRC);
+    const dnn_mem_t &d_sc = args.find(DNNL_ARG_DIFF_SCALE);
+    const dnn_mem_t &d_sh = args.find(DNNL_ARG_DIFF_SHIFT);
+
+    float *d_src_ptr = (float *)d_src;
+    float *d_sc_ptr = (float *)d_sc;
+    float *d_sh_ptr = (float *)d_sh;
+
+    const bool use_sc = prb->use_sc();
+    const bool use_sh = prb->use_sh();
+    const int64_t CG = prb->ic_per_g();
+
+    if ((use_sc || use_sh) && (prb->dir & FLAG_WEI)) {
+        benchdnn_parallel_nd(prb->ic, [&](int64_t c) {
+            const int64_t g = c / CG;
+            float d_gamma = 0;
+            float d_beta = 0;
+
+            for (int64_t mb = 0; mb < prb->mb; ++mb) {
+                const int64_t stat_off = mb * prb->g + g;
+                const float smean = mean.get_elem(stat_off);
+                const float svar = var.get_elem(stat_off);
+                const float rcp_denom = 1.f / sqrtf(svar + prb->eps);
+                for (int64_t sp = 0; sp < prb->sp; ++sp) {
+                    const auto off = (mb * prb->ic + c) * prb->sp + sp;
+                    const float dd = d_dst.get_elem(off);
+                    d_gamma += dd * (src.get_elem(off) - smean) * rcp_denom;
+                    d_beta += dd;
+                }
+            }
+
+            if (use_sc) d_sc_ptr[c] = d_gamma;
+            if (use_sh) d_sh_ptr[c] = d_beta;
+        });
+    }
+
+    benchdnn_parallel_nd(prb->mb, prb->g, [&](int64_t mb, int64_t g) {
+        const int64_t stat_off = mb * prb->g + g;
+        const float smean = mean.get_elem(stat_off);
+        const float svar = var.get_elem(stat_off);
+        const float rcp_denom = 1.f / sqrtf(svar + prb->eps);
+        float dd_gamma = 0, dd_gamma_x = 0;
+        if (!(prb->flags & GLOB_STATS)) {
+            for_(int64_t c = g * CG; c < (g + 1) * CG; ++c)
+            for (int64_t sp = 0; sp < prb->sp; ++sp) {
+                const auto off = (mb * prb->ic + c) * prb->sp + sp;
+                const float ds = d_dst.get_elem(off);
+                const float x = src.get_elem(off) - smean;
+                const float gamma = use_sc ? sc.get_elem(c) : 1;
+                dd_gamma += gamma * ds;
+                dd_gamma_x += gamma * ds * x;
+            }
+            dd_gamma_x *= rcp_denom;
+        }
+        for_(int64_t c = g * CG; c < (g + 1) * CG; ++c)
+        for (int64_t sp = 0; sp < prb->sp; ++sp) {
+            const float gamma = use_sc ? sc.get_elem(c) : 1;
+            const auto off = (mb * prb->ic + c) * prb->sp + sp;
+            float ds = d_dst.get_elem(off) * gamma;
+            if (!(prb->flags & GLOB_STATS)) {
+                const float x = src.get_elem(off) - smean;
+                ds -= (dd_gamma + x * dd_gamma_x * rcp_denom)
+                        / prb->group_size();
+            }
+
+            d_src_ptr[off] = rcp_denom * ds;
+        }
+    });
+}
+
+void compute_ref(
+        const prb_t *prb, const args_t &args, dnnl_primitive_t prim_ref) {
+    if (prb->dir & FLAG_FWD)
+        compute_ref_fwd(prb, args);
+    else
+        compute_ref_bwd(prb, args);
+}
+
+} // namespace gnorm
@@ -92,7 +92,8 @@ int verify_input(const settings_t &s) {
 static const std::string help_flags
         = "FLAGS    (Default: not specified)\n    Specifies normalization "
           "flags. `FLAGS` values are:\n    * `G` for global_stats.\n    * `C` "
-          "for scale.\n    * `H` for shift.\n";
+          "for scale.\n    * `H` for shift.\n    * `M` for rms_norm.\n    * "
+          "`S` for fuse_residual_add.\n";
 
 int bench(int argc, char **argv) {
     driver_name = "lnorm";
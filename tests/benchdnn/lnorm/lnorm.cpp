@@ -163,6 +163,16 @@ static int prepare_fwd(const prb_t *prb, dnn_mem_t &src, dnn_mem_t &mean,
         });
     }
 
+    // RMS normalization is applied to the same data: the mean is zero and
+    // the variance turns into the mean of squares, E[x^2] = D[x] + E[x]^2.
+    if (prb->use_rms()) {
+        benchdnn_parallel_nd(prb->n, [&](int64_t n) {
+            const float m = mean.get_elem(n);
+            var.set_elem(n, var.get_elem(n) + m * m);
+            mean.set_elem(n, 0.f);
+        });
+    }
+
     const bool use_sc = prb->use_sc();
     const bool use_sh = prb->use_sh();
 
@@ -206,8 +216,8 @@ static int prepare_bwd(const prb_t *prb, dnn_mem_t &src, dnn_mem_t &d_dst,
         std::uniform_int_distribution<> data_dist(0, 6);
         std::bernoulli_distribution half_dist(0.5f);
 
-        // mean = {-0.5f, 0.f, 0.5f}
-        const float m = 0.5f * (stat_dist(int_seed) - 1);
+        // mean = {-0.5f, 0.f, 0.5f}, always 0 in the RMS mode
+        const float m = prb->use_rms() ? 0.f : 0.5f * (stat_dist(int_seed) - 1);
         mean.set_elem(n, m);
 
         // final variance = {0.25f, 1.f, 4.f}
@@ -315,7 +325,7 @@ void skip_unimplemented_prb(const prb_t *prb, res_t *res) {
     if (is_gpu()) {
         const bool dt_ok = prb->dt[0] == prb->dt[1]
                 && !is_integral_dt(prb->dt[0]) && !is_integral_dt(prb->dt[1]);
-        if (!dt_ok) {
+        if (!dt_ok || prb->use_rms() || prb->use_residual()) {
             res->state = SKIPPED, res->reason = CASE_NOT_SUPPORTED;
             return;
         }
@@ -323,6 +333,12 @@ void skip_unimplemented_prb(const prb_t *prb, res_t *res) {
 }
 
 void skip_invalid_prb(const prb_t *prb, res_t *res) {
+    // The residual add fusion is defined for forward propagation only.
+    if (prb->use_residual() && !(prb->dir & FLAG_FWD)) {
+        res->state = SKIPPED, res->reason = INVALID_CASE;
+        return;
+    }
+
     // See `skip_invalid_inplace` for details.
     if (prb->inplace) {
         skip_invalid_inplace(
@@ -431,6 +447,15 @@ int doit(const prb_t *prb, res_t *res) {
 
     dnn_mem_t d_dst_dt, placeholder_d_src_dt, d_sc_dt, d_sh_dt;
 
+    // Residual input and the stored sum for the residual add fusion.
+    dnn_mem_t res_dt, sum_dt;
+    dnn_mem_t sum_fp;
+    if (prb->use_residual()) {
+        res_dt = dnn_mem_t(src_md, test_engine);
+        sum_dt = dnn_mem_t(src_md, test_engine);
+        sum_fp = dnn_mem_t(src_md, dnnl_f32, tag::abx, ref_engine);
+    }
+
     const dnnl_dims_t scale_dims = {1};
     auto scales_md = dnn_mem_t::init_md(1, scale_dims, dnnl_f32, tag::abx);
     dnn_mem_t src_scales_dt(scales_md, test_engine);
@@ -450,7 +475,23 @@ int doit(const prb_t *prb, res_t *res) {
             return res->state = MISTRUSTED, OK;
         }
 
-        SAFE(src_dt.reorder(src_fp), WARN);
+        if (prb->use_residual()) {
+            // Split the prepared data between src and the residual so that
+            // their sum is exact and each of them matters: even points come
+            // from src, odd points from the residual.
+            SAFE(sum_fp.reorder(src_fp), WARN);
+            dnn_mem_t src_part_fp(src_md, dnnl_f32, tag::abx, ref_engine);
+            dnn_mem_t res_part_fp(src_md, dnnl_f32, tag::abx, ref_engine);
+            benchdnn_parallel_nd(src_fp.nelems(), [&](int64_t i) {
+                const float x = src_fp.get_elem(i);
+                src_part_fp.set_elem(i, i % 2 ? 0.f : x);
+                res_part_fp.set_elem(i, i % 2 ? x : 0.f);
+            });
+            SAFE(src_dt.reorder(src_part_fp), WARN);
+            SAFE(res_dt.reorder(res_part_fp), WARN);
+        } else {
+            SAFE(src_dt.reorder(src_fp), WARN);
+        }
         if (prb->flags & GLOB_STATS) {
             /* prepare mean & var if they are inputs */
             SAFE(mean_dt.reorder(mean_fp), WARN);
@@ -470,6 +511,10 @@ int doit(const prb_t *prb, res_t *res) {
         args.set(DNNL_ARG_SCALE, sc_dt);
         args.set(DNNL_ARG_SHIFT, sh_dt);
         args.set(DNNL_ARG_DST, dst_dt);
+        if (prb->use_residual()) {
+            args.set(DNNL_ARG_SRC_1, res_dt);
+            args.set(DNNL_ARG_DST_1, sum_dt);
+        }
         args.set(DNNL_ARG_SCRATCHPAD, scratchpad_dt);
         args.set(DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, src_scales_dt);
         args.set(DNNL_ARG_ATTR_SCALES | DNNL_ARG_DST, dst_scales_dt);
@@ -488,11 +533,18 @@ int doit(const prb_t *prb, res_t *res) {
 
             std::vector<data_kind_t> kinds {DST};
             if (!(prb->flags & GLOB_STATS) && !(prb->dir & FLAG_INF)) {
-                kinds.push_back(MEAN);
+                if (!prb->use_rms()) kinds.push_back(MEAN);
                 kinds.push_back(VAR);
             }
 
             check_correctness(prb, kinds, args, ref_args, setup_cmp, res);
+
+            if (prb->use_residual()) {
+                // The sum is exact by construction of src and the residual.
+                compare::compare_t cmp;
+                cmp.set_data_kind(DST);
+                cmp.compare(sum_fp, sum_dt, prb->attr, res);
+            }
         }
     } else {
         const auto &d_src_md = query_md(const_pd, DNNL_ARG_DIFF_SRC);
@@ -41,8 +41,10 @@ const flags_t NONE = bnorm::NONE;
 const flags_t GLOB_STATS = bnorm::GLOB_STATS;
 const flags_t USE_SCALE = bnorm::USE_SCALE;
 const flags_t USE_SHIFT = bnorm::USE_SHIFT;
-const auto flags2str = bnorm::flags2str;
+const flags_t RMS_NORM = dnnl_rms_norm;
+const flags_t FUSE_RESIDUAL_ADD = dnnl_fuse_residual_add;
 flags_t str2flags(const char *str);
+std::string flags2str(flags_t flags);
 
 struct settings_t : public base_settings_t {
     settings_t() = default;
@@ -114,6 +116,8 @@ struct prb_t : public prb_dims_t {
 
     bool use_sc() const { return flags & USE_SCALE; }
     bool use_sh() const { return flags & USE_SHIFT; }
+    bool use_rms() const { return flags & RMS_NORM; }
+    bool use_residual() const { return flags & FUSE_RESIDUAL_ADD; }
 };
 
 std::ostream &operator<<(std::ostream &s, const prb_t &prb);
@@ -23,9 +23,21 @@ namespace lnorm {
 flags_t str2flags(const char *str) {
     flags_t flags = bnorm::str2flags(str);
     assert(flags <= (GLOB_STATS | USE_SCALE | USE_SHIFT));
+    while (str && *str) {
+        if (*str == 'M') flags |= RMS_NORM;
+        if (*str == 'S') flags |= FUSE_RESIDUAL_ADD;
+        str++;
+    }
     return flags;
 }
 
+std::string flags2str(flags_t flags) {
+    std::string str = bnorm::flags2str(flags);
+    if (flags & RMS_NORM) str += "M";
+    if (flags & FUSE_RESIDUAL_ADD) str += "S";
+    return str;
+}
+
 std::ostream &operator<<(std::ostream &s, const prb_t &prb) {
     dump_global_params(s);
     settings_t def;
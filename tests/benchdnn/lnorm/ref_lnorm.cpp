@@ -112,7 +112,9 @@ void compute_ref_bwd(const prb_t *prb, const args_t &args) {
             float ds = d_dst.get_elem(off) * gamma;
             if (!(prb->flags & GLOB_STATS)) {
                 const float x = src.get_elem(off) - smean;
-                ds -= (dd_gamma + x * dd_gamma_x * rcp_denom) / prb->c;
+                // the mean is not a function of src in the RMS mode
+                if (!prb->use_rms()) ds -= dd_gamma / prb->c;
+                ds -= x * dd_gamma_x * rcp_denom / prb->c;
             }
 
             d_src_ptr[off] = rcp_denom * ds;
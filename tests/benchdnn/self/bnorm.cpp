@@ -35,6 +35,7 @@ static int check_flags() {
     SELF_CHECK_CASE_CPP_STR_EQ(flags2str(FUSE_NORM_ADD_RELU), "A");
     SELF_CHECK_CASE_CPP_STR_EQ(
             flags2str(GLOB_STATS | FUSE_NORM_ADD_RELU), "GA");
+    SELF_CHECK_CASE_CPP_STR_EQ(flags2str(USE_SCALE | WELFORD_STATS), "CW");
 
     SELF_CHECK_EQ(str2flags(""), NONE);
     SELF_CHECK_EQ(str2flags("G"), GLOB_STATS);
@@ -45,6 +46,7 @@ static int check_flags() {
     SELF_CHECK_EQ(str2flags("GR"), GLOB_STATS | FUSE_NORM_RELU);
     SELF_CHECK_EQ(str2flags("A"), FUSE_NORM_ADD_RELU);
     SELF_CHECK_EQ(str2flags("GA"), GLOB_STATS | FUSE_NORM_ADD_RELU);
+    SELF_CHECK_EQ(str2flags("CHW"), USE_SCALE | USE_SHIFT | WELFORD_STATS);
     return OK;
 }
 
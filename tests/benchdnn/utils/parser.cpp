@@ -347,7 +347,8 @@ bool parse_main_help(
               "[driver_options] problem_description\n\nList of supported "
               "<drivers> (lower case accepted only):\n    * binary\n    * "
               "bnorm\n    * concat\n    * conv\n    * deconv\n    * eltwise\n  "
-              "  * ip\n    * lnorm\n    * lrn\n    * matmul\n    * pool\n    * "
+              "  * gnorm\n    * ip\n    * lnorm\n    * lrn\n    * matmul\n    * "
+              "pool\n    * "
               "prelu\n    * reduction\n    * reorder\n    * resampling\n    * "
               "rnn\n    * shuffle\n    * softmax\n    * sum\n    * "
               "zeropad\n\nFor global and specific driver options, use:\n    "
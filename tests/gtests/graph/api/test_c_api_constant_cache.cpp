@@ -30,3 +30,23 @@ TEST(CAPI, ConstantTensorCache) {
             dnnl_invalid_arguments);
     ASSERT_EQ(dnnl_graph_set_constant_tensor_cache(-1), dnnl_invalid_arguments);
 }
+
+TEST(CAPI, ConstantTensorCacheFootprint) {
+    size_t size = 0;
+    ASSERT_EQ(dnnl_graph_get_constant_tensor_cache_footprint(&size),
+            dnnl_success);
+
+    // negative test
+    ASSERT_EQ(dnnl_graph_get_constant_tensor_cache_footprint(nullptr),
+            dnnl_invalid_arguments);
+}
+
+TEST(CAPI, ConstantTensorCacheDir) {
+#ifdef __linux__
+    ASSERT_EQ(dnnl_graph_set_constant_tensor_cache_dir("."), dnnl_success);
+    ASSERT_EQ(dnnl_graph_set_constant_tensor_cache_dir(nullptr), dnnl_success);
+#else
+    ASSERT_EQ(dnnl_graph_set_constant_tensor_cache_dir("."),
+            dnnl_unimplemented);
+#endif
+}
@@ -14,6 +14,8 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <thread>
+
 #include "oneapi/dnnl/dnnl_graph.hpp"
 
 #include "test_api_common.hpp"
@@ -940,3 +942,202 @@ TEST_P(test_bn_compile_t, Test_BatchNorm_Compile) {
 
 INSTANTIATE_TEST_SUITE_P(Test_BatchNorm_Compile, test_bn_compile_t,
         ::testing::Values(bn_params_t {{1, 3, 3, 10}, 0.001f, "NXC"}));
+
+TEST(APIExecutionPlan, ReluChain) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    // lt0 -> relu -> lt1 -> relu -> lt2 -> relu -> lt3 -> relu -> lt4, each
+    // relu is compiled as a separate partition
+    const std::vector<int64_t> dims {4, 64};
+    const size_t num_ops = 4;
+    std::vector<logical_tensor> lts;
+    for (size_t i = 0; i <= num_ops; i++) {
+        lts.emplace_back(i, logical_tensor::data_type::f32, dims,
+                logical_tensor::layout_type::strided);
+    }
+
+    std::vector<compiled_partition> cps;
+    for (size_t i = 0; i < num_ops; i++) {
+        graph g(engine_kind);
+        op relu(i, op::kind::ReLU);
+        relu.add_input(lts[i]);
+        relu.add_output(lts[i + 1]);
+        g.add_op(relu);
+        g.finalize();
+        auto partitions = g.get_partitions();
+        ASSERT_EQ(partitions.size(), 1U);
+        cps.emplace_back(partitions[0].compile({lts[i]}, {lts[i + 1]}, eng));
+    }
+
+    execution_plan plan(cps, {num_ops});
+
+    // lt1 and lt3 are not alive at the same time and share the memory
+    const size_t size = lts[1].get_mem_size();
+    ASSERT_EQ(plan.get_arena_size(), 2 * size);
+    ASSERT_EQ(plan.query_offset(1), plan.query_offset(3));
+    ASSERT_NE(plan.query_offset(1), plan.query_offset(2));
+    EXPECT_THROW(plan.query_offset(0), dnnl::error);
+    EXPECT_THROW(plan.query_offset(num_ops), dnnl::error);
+
+    if (engine_kind != dnnl::engine::kind::cpu) return;
+
+    const size_t nelems = size / sizeof(float);
+    std::vector<float> src(nelems), dst(nelems, 1.f);
+    for (size_t i = 0; i < nelems; i++)
+        src[i] = static_cast<float>(i % 7) - 3.f;
+    std::vector<char> arena(plan.get_arena_size());
+
+    tensor src_ts(lts[0], eng, src.data());
+    tensor dst_ts(lts[num_ops], eng, dst.data());
+    dnnl::stream strm(eng);
+    plan.execute(strm, arena.data(), {src_ts}, {dst_ts});
+    strm.wait();
+    for (size_t i = 0; i < nelems; i++)
+        ASSERT_EQ(dst[i], std::max(src[i], 0.f));
+}
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL \
+        && DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+TEST(APIBatchingExecutor, MatMul) {
+    using namespace dnnl::graph;
+    using ltype = logical_tensor::layout_type;
+    using ptype = logical_tensor::property_type;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    if (engine_kind != dnnl::engine::kind::cpu) return;
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    // dst{1, N} = src{1, K} x wei{K, N}, the weights are shared by requests
+    const int64_t K = 16, N = 8;
+    const size_t num_requests = 4;
+    logical_tensor src_lt(0, logical_tensor::data_type::f32, {1, K},
+            ltype::strided);
+    logical_tensor wei_lt(1, logical_tensor::data_type::f32, {K, N},
+            ltype::strided, ptype::constant);
+    logical_tensor dst_lt(2, logical_tensor::data_type::f32, {1, N},
+            ltype::strided);
+
+    graph g(engine_kind);
+    op matmul(0, op::kind::MatMul);
+    matmul.add_inputs({src_lt, wei_lt});
+    matmul.add_output(dst_lt);
+    g.add_op(matmul);
+    g.finalize();
+    auto partitions = g.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+
+    // The window is long enough for all requests to join the same batch,
+    // which is executed as soon as it is full.
+    batching_executor ex(partitions[0], {src_lt, wei_lt}, {dst_lt}, eng,
+            num_requests, 10 * 1000 * 1000);
+
+    std::vector<float> wei(K * N);
+    for (int64_t i = 0; i < K * N; i++)
+        wei[i] = static_cast<float>(i % 3) - 1.f;
+    std::vector<std::vector<float>> src(num_requests, std::vector<float>(K));
+    std::vector<std::vector<float>> dst(num_requests, std::vector<float>(N));
+    for (size_t r = 0; r < num_requests; r++) {
+        for (int64_t k = 0; k < K; k++)
+            src[r][k] = static_cast<float>((r + k) % 5);
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t r = 0; r < num_requests; r++) {
+        threads.emplace_back([&, r]() {
+            dnnl::stream strm(eng);
+            tensor src_ts(src_lt, eng, src[r].data());
+            tensor wei_ts(wei_lt, eng, wei.data());
+            tensor dst_ts(dst_lt, eng, dst[r].data());
+            ex.execute(strm, {src_ts, wei_ts}, {dst_ts});
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    ASSERT_EQ(ex.get_num_compiled_batches(), 1U);
+    for (size_t r = 0; r < num_requests; r++) {
+        for (int64_t n = 0; n < N; n++) {
+            float ref = 0.f;
+            for (int64_t k = 0; k < K; k++)
+                ref += src[r][k] * wei[k * N + n];
+            ASSERT_EQ(dst[r][n], ref);
+        }
+    }
+
+    // The tensors must match the logical tensors given at creation
+    dnnl::stream strm(eng);
+    logical_tensor bad_lt(0, logical_tensor::data_type::f32, {1, K + 1},
+            ltype::strided);
+    std::vector<float> bad(K + 1);
+    EXPECT_THROW(ex.execute(strm,
+                         {tensor(bad_lt, eng, bad.data()),
+                                 tensor(wei_lt, eng, wei.data())},
+                         {tensor(dst_lt, eng, dst[0].data())}),
+            dnnl::error);
+}
+
+TEST(APIBatchingExecutor, PaddedBatch) {
+    using namespace dnnl::graph;
+    using ltype = logical_tensor::layout_type;
+    using ptype = logical_tensor::property_type;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    if (engine_kind != dnnl::engine::kind::cpu) return;
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    const int64_t K = 16, N = 8;
+    logical_tensor src_lt(0, logical_tensor::data_type::f32, {1, K},
+            ltype::strided);
+    logical_tensor wei_lt(1, logical_tensor::data_type::f32, {K, N},
+            ltype::strided, ptype::constant);
+    logical_tensor dst_lt(2, logical_tensor::data_type::f32, {1, N},
+            ltype::strided);
+
+    graph g(engine_kind);
+    op matmul(0, op::kind::MatMul);
+    matmul.add_inputs({src_lt, wei_lt});
+    matmul.add_output(dst_lt);
+    g.add_op(matmul);
+    g.finalize();
+    auto partitions = g.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+
+    // Without a window every request is a batch of its own
+    batching_executor ex(
+            partitions[0], {src_lt, wei_lt}, {dst_lt}, eng, 8, 0);
+
+    std::vector<float> wei(K * N);
+    for (int64_t i = 0; i < K * N; i++)
+        wei[i] = static_cast<float>(i % 3) - 1.f;
+    dnnl::stream strm(eng);
+
+    // Batches of 3 and 4 samples share the partition compiled for 4, the
+    // batch of 3 is padded.
+    for (int64_t M : {3, 4}) {
+        std::vector<float> src(M * K), dst(M * N);
+        for (int64_t i = 0; i < M * K; i++)
+            src[i] = static_cast<float>(i % 5);
+        logical_tensor src_m_lt(0, logical_tensor::data_type::f32, {M, K},
+                ltype::strided);
+        logical_tensor dst_m_lt(2, logical_tensor::data_type::f32, {M, N},
+                ltype::strided);
+        ex.execute(strm,
+                {tensor(src_m_lt, eng, src.data()),
+                        tensor(wei_lt, eng, wei.data())},
+                {tensor(dst_m_lt, eng, dst.data())});
+
+        for (int64_t m = 0; m < M; m++) {
+            for (int64_t n = 0; n < N; n++) {
+                float ref = 0.f;
+                for (int64_t k = 0; k < K; k++)
+                    ref += src[m * K + k] * wei[k * N + n];
+                ASSERT_EQ(dst[m * N + n], ref);
+            }
+        }
+    }
+    ASSERT_EQ(ex.get_num_compiled_batches(), 1U);
+}
+#endif
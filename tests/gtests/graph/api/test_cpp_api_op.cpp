@@ -55,10 +55,13 @@ TEST(APIOp, CreateAllOps) {
             op::kind::DynamicQuantize,
             op::kind::Elu,
             op::kind::EluBackward,
+            op::kind::EmbeddingBag,
             op::kind::End,
             op::kind::Exp,
+            op::kind::Gather,
             op::kind::GELU,
             op::kind::GELUBackward,
+            op::kind::GroupNorm,
             op::kind::HardSwish,
             op::kind::HardSwishBackward,
             op::kind::Interpolate,
@@ -77,6 +80,7 @@ TEST(APIOp, CreateAllOps) {
             op::kind::Mish,
             op::kind::MishBackward,
             op::kind::Multiply,
+            op::kind::Pow,
             op::kind::PReLU,
             op::kind::PReLUBackward,
             op::kind::Quantize,
@@ -92,6 +96,7 @@ TEST(APIOp, CreateAllOps) {
             op::kind::ReLUBackward,
             op::kind::Reorder,
             op::kind::Round,
+            op::kind::Select,
             op::kind::Sigmoid,
             op::kind::SigmoidBackward,
             op::kind::SoftMax,
@@ -894,6 +894,67 @@ TEST(Execute, BroadcastAdd) {
     }
 }
 
+TEST(Execute, BroadcastSelect) {
+    graph::engine_t *eng = get_engine();
+
+    test::vector<uint8_t> cond {1, 0};
+    test::vector<float> then_src {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    test::vector<float> else_src {-1.0};
+    test::vector<float> ref_dst {1.0, 2.0, 3.0, -1.0, -1.0, -1.0};
+    test::vector<float> dst(then_src.size(), 0.0);
+
+    graph::op_t select_op(0, graph::op_kind::Select, "select");
+
+    // the condition is broadcast along the last dimension and the else
+    // source to the whole output
+    graph::logical_tensor_t cond_lt
+            = utils::logical_tensor_init(0, {2, 1}, graph::data_type::u8);
+    graph::logical_tensor_t then_lt
+            = utils::logical_tensor_init(1, {2, 3}, graph::data_type::f32);
+    graph::logical_tensor_t else_lt = utils::logical_tensor_init(
+            2, std::vector<graph::dim_t> {1}, graph::data_type::f32);
+    graph::logical_tensor_t dst_lt
+            = utils::logical_tensor_init(3, {2, 3}, graph::data_type::f32);
+
+    select_op.add_input(cond_lt);
+    select_op.add_input(then_lt);
+    select_op.add_input(else_lt);
+    select_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&select_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("select_pass");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &cond_lt, &then_lt, &else_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t cond_ts(cond_lt, eng, cond.data());
+    graph::tensor_t then_ts(then_lt, eng, then_src.data());
+    graph::tensor_t else_ts(else_lt, eng, else_src.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+
+    graph::stream_t *strm = get_stream();
+    cp.execute(strm, {cond_ts, then_ts, else_ts}, {dst_ts});
+    strm->wait();
+
+    for (size_t i = 0; i < dst.size(); ++i) {
+        ASSERT_FLOAT_EQ(dst[i], ref_dst[i]);
+    }
+}
+
 TEST(Execute, SwapBroadcastAdd) {
     graph::engine_t *eng = get_engine();
 
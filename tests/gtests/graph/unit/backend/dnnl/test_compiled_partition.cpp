@@ -14,6 +14,8 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 
 #include "interface/partition.hpp"
@@ -294,3 +296,149 @@ TEST(CompiledPartition, AllowRepeatedInputs) {
         ASSERT_FLOAT_EQ(ref_out[i], data_out[i]);
     }
 }
+
+TEST(CompiledPartition, ReluWithUnknownBatch) {
+    graph::engine_t *eng = get_engine();
+
+    graph::op_t relu_op(graph::op_kind::ReLU, "relu");
+
+    const graph::dim_t unknown = DNNL_GRAPH_UNKNOWN_DIM;
+    const graph::logical_tensor_t lt_in
+            = utils::logical_tensor_init(/* tid= */ 1, {unknown, 2, 3},
+                    {unknown, unknown, unknown}, graph::data_type::f32);
+    const graph::logical_tensor_t lt_out
+            = utils::logical_tensor_init(/* tid= */ 2, {unknown, 2, 3},
+                    graph::data_type::f32, graph::layout_type::any);
+
+    relu_op.add_input(lt_in);
+    relu_op.add_output(lt_out);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&relu_op);
+    g.finalize();
+    run_all_passes(g);
+
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> lt_inputs {&lt_in};
+    std::vector<const graph::logical_tensor_t *> lt_outputs {&lt_out};
+    ASSERT_EQ(p.compile(&cp, lt_inputs, lt_outputs, eng),
+            graph::status::success);
+
+    graph::logical_tensor_t query_out_lt;
+    ASSERT_EQ(cp.query_logical_tensor(lt_out.id, &query_out_lt),
+            graph::status::success);
+    ASSERT_EQ(query_out_lt.layout_type, graph::layout_type::strided);
+    ASSERT_EQ(query_out_lt.dims[0], unknown);
+
+    // The same compiled partition runs every batch size, the last one reuses
+    // the kernel compiled for the first.
+    graph::stream_t *strm = get_stream();
+    for (graph::dim_t mb : {1, 4, 1}) {
+        const size_t nelems = static_cast<size_t>(mb * 2 * 3);
+        test::vector<float> data_in(nelems), data_out(nelems);
+        for (size_t i = 0; i < nelems; i++)
+            data_in[i] = static_cast<float>(i) - static_cast<float>(nelems / 2);
+
+        auto concrete_in = utils::logical_tensor_init(
+                1, {mb, 2, 3}, graph::data_type::f32);
+        auto concrete_out = utils::logical_tensor_init(
+                2, {mb, 2, 3}, graph::data_type::f32);
+        graph::tensor_t t_in(concrete_in, eng, data_in.data()),
+                t_out(concrete_out, eng, data_out.data());
+
+        EXPECT_SUCCESS(cp.execute(strm, {t_in}, {t_out}));
+        strm->wait();
+
+        for (size_t i = 0; i < nelems; i++)
+            ASSERT_FLOAT_EQ(data_out[i], std::max(data_in[i], 0.f));
+    }
+
+    // Tensors must carry concrete shapes.
+    test::vector<float> data(6);
+    graph::tensor_t t_in(lt_in, eng, data.data()),
+            t_out(query_out_lt, eng, data.data());
+    ASSERT_EQ(cp.execute(strm, {t_in}, {t_out}),
+            graph::status::invalid_arguments);
+}
+
+TEST(CompiledPartition, MatmulReluWithUnknownRows) {
+    graph::engine_t *eng = get_engine();
+
+    graph::op_t matmul_op(0, graph::op_kind::MatMul, "matmul");
+    graph::op_t relu_op(1, graph::op_kind::ReLU, "relu");
+
+    const graph::dim_t unknown = DNNL_GRAPH_UNKNOWN_DIM;
+    const graph::dim_t K = 8, N = 4;
+    const graph::logical_tensor_t lt_src = utils::logical_tensor_init(
+            0, {unknown, K}, {unknown, unknown}, graph::data_type::f32);
+    const graph::logical_tensor_t lt_wei
+            = utils::logical_tensor_init(1, {K, N}, graph::data_type::f32);
+    const graph::logical_tensor_t lt_mm = utils::logical_tensor_init(
+            2, {unknown, N}, graph::data_type::f32);
+    const graph::logical_tensor_t lt_dst = utils::logical_tensor_init(
+            3, {unknown, N}, graph::data_type::f32, graph::layout_type::any);
+
+    matmul_op.add_input(lt_src);
+    matmul_op.add_input(lt_wei);
+    matmul_op.add_output(lt_mm);
+    relu_op.add_input(lt_mm);
+    relu_op.add_output(lt_dst);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&matmul_op);
+    g.add_op(&relu_op);
+    g.finalize();
+    run_all_passes(g);
+
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> lt_inputs {&lt_src, &lt_wei};
+    std::vector<const graph::logical_tensor_t *> lt_outputs {&lt_dst};
+    ASSERT_EQ(p.compile(&cp, lt_inputs, lt_outputs, eng),
+            graph::status::success);
+
+    test::vector<float> wei(K * N);
+    for (size_t i = 0; i < wei.size(); i++)
+        wei[i] = static_cast<float>(i % 5) - 2.f;
+
+    // The first shape compiles the partition, the next ones reuse its
+    // transformed subgraph, the last one reuses the kernel of the second.
+    graph::stream_t *strm = get_stream();
+    for (graph::dim_t M : {2, 3, 5, 3}) {
+        test::vector<float> src(static_cast<size_t>(M * K)),
+                dst(static_cast<size_t>(M * N));
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = static_cast<float>(i % 7) - 3.f;
+
+        auto concrete_src
+                = utils::logical_tensor_init(0, {M, K}, graph::data_type::f32);
+        auto concrete_dst
+                = utils::logical_tensor_init(3, {M, N}, graph::data_type::f32);
+        graph::tensor_t t_src(concrete_src, eng, src.data()),
+                t_wei(lt_wei, eng, wei.data()),
+                t_dst(concrete_dst, eng, dst.data());
+
+        EXPECT_SUCCESS(cp.execute(strm, {t_src, t_wei}, {t_dst}));
+        strm->wait();
+
+        for (graph::dim_t m = 0; m < M; m++) {
+            for (graph::dim_t n = 0; n < N; n++) {
+                float ref = 0.f;
+                for (graph::dim_t k = 0; k < K; k++)
+                    ref += src[m * K + k] * wei[k * N + n];
+                ASSERT_FLOAT_EQ(dst[m * N + n], std::max(ref, 0.f));
+            }
+        }
+    }
+}
@@ -87,7 +87,8 @@ static inline void test_eltwise_common(test::vector<float> &src,
     strm->wait();
 
     if (op_kind == graph::op_kind::Log || op_kind == graph::op_kind::GELU
-            || op_kind == graph::op_kind::SoftPlus) {
+            || op_kind == graph::op_kind::SoftPlus
+            || op_kind == graph::op_kind::Pow) {
         for (size_t i = 0; i < src.size(); ++i) {
             ASSERT_NEAR(dst[i], ref_dst[i], 1e-5);
         }
@@ -485,6 +486,22 @@ TEST(Execute, Square) {
     test_eltwise_common(src, ref_dst, dims, graph::op_kind::Square, "square");
 }
 
+TEST(Execute, Pow) {
+    test::vector<float> src {2.f, 1.5f, 1.f, 0.5f, 0.8f, 3.5f};
+    dnnl::impl::graph::dims dims {1, 2, 3};
+
+    for (float beta : {2.f, -0.5f, 3.f}) {
+        test::vector<float> ref_dst;
+        for (size_t i = 0; i < src.size(); ++i) {
+            float temp = static_cast<float>(pow(src[i], beta));
+            ref_dst.push_back(temp);
+        }
+
+        test_eltwise_common(src, ref_dst, dims, graph::op_kind::Pow, "pow",
+                {{graph::op_attr::beta, beta}});
+    }
+}
+
 TEST(Execute, Log) {
     test::vector<float> src {2.f, 1.5f, 1.f, 0.5f, 0.8f, 3.5f};
     test::vector<float> ref_dst;
@@ -0,0 +1,191 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+// The table has 4 rows of 2 elements and the 4 indices form 3 bags: {0},
+// {2, 3} and {1}.
+static void test_embedding_bag_common(const std::string &mode,
+        bool with_weights, const test::vector<float> &ref_dst) {
+    graph::engine_t *eng = get_engine();
+
+    test::vector<float> table {1.0, 2.0, 3.0, -4.0, -5.0, 6.0, 7.0, 8.0};
+    test::vector<int32_t> indices {0, 2, 3, 1};
+    test::vector<int32_t> offsets {0, 1, 3};
+    test::vector<float> weights {2.0, 0.5, 1.0, -1.0};
+    test::vector<float> dst(ref_dst.size(), 0.0);
+
+    graph::op_t emb_op(0, graph::op_kind::EmbeddingBag, "embedding_bag");
+    emb_op.set_attr<std::string>(graph::op_attr::mode, mode);
+
+    graph::logical_tensor_t table_lt
+            = utils::logical_tensor_init(0, {4, 2}, graph::data_type::f32);
+    graph::logical_tensor_t indices_lt = utils::logical_tensor_init(
+            1, std::vector<graph::dim_t> {4}, graph::data_type::s32);
+    graph::logical_tensor_t offsets_lt = utils::logical_tensor_init(
+            2, std::vector<graph::dim_t> {3}, graph::data_type::s32);
+    graph::logical_tensor_t weights_lt = utils::logical_tensor_init(
+            3, std::vector<graph::dim_t> {4}, graph::data_type::f32);
+    graph::logical_tensor_t dst_lt = utils::logical_tensor_init(
+            4, {3, 2}, graph::data_type::f32, graph::layout_type::any);
+
+    emb_op.add_input(table_lt);
+    emb_op.add_input(indices_lt);
+    emb_op.add_input(offsets_lt);
+    if (with_weights) emb_op.add_input(weights_lt);
+    emb_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    ASSERT_EQ(g.add_op(&emb_op), graph::status::success);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("embedding_bag_pass_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &table_lt, &indices_lt, &offsets_lt};
+    if (with_weights) inputs.emplace_back(&weights_lt);
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    // the layout propagator gives the pooled rows a plain layout
+    graph::logical_tensor_t compiled_dst_lt;
+    cp.query_logical_tensor(dst_lt.id, &compiled_dst_lt);
+    ASSERT_EQ(compiled_dst_lt.layout_type, graph::layout_type::strided);
+
+    graph::tensor_t table_ts(table_lt, eng, table.data());
+    graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+    graph::tensor_t offsets_ts(offsets_lt, eng, offsets.data());
+    graph::tensor_t weights_ts(weights_lt, eng, weights.data());
+    graph::tensor_t dst_ts(compiled_dst_lt, eng, dst.data());
+
+    std::vector<graph::tensor_t> inputs_ts {table_ts, indices_ts, offsets_ts};
+    if (with_weights) inputs_ts.emplace_back(weights_ts);
+
+    graph::stream_t *strm = get_stream();
+    ASSERT_EQ(cp.execute(strm, inputs_ts, {dst_ts}), graph::status::success);
+    strm->wait();
+
+    for (size_t i = 0; i < dst.size(); ++i) {
+        ASSERT_FLOAT_EQ(dst[i], ref_dst[i]);
+    }
+}
+
+TEST(Execute, EmbeddingBag) {
+    test_embedding_bag_common("sum", false, {1.0, 2.0, 2.0, 14.0, 3.0, -4.0});
+    test_embedding_bag_common("sum", true, {2.0, 4.0, 4.5, 11.0, -3.0, 4.0});
+    test_embedding_bag_common("mean", false, {1.0, 2.0, 1.0, 7.0, 3.0, -4.0});
+    test_embedding_bag_common("max", false, {1.0, 2.0, 7.0, 8.0, 3.0, -4.0});
+}
+
+TEST(Execute, EmbeddingBagMatmulRelu) {
+    graph::engine_t *eng = get_engine();
+
+    // the bags pool to {1, 2}, {2, 14} and {3, -4}
+    test::vector<float> table {1.0, 2.0, 3.0, -4.0, -5.0, 6.0, 7.0, 8.0};
+    test::vector<int32_t> indices {0, 2, 3, 1};
+    test::vector<int32_t> offsets {0, 1, 3};
+    test::vector<float> weight {1.0, 0.0, -1.0, 0.5};
+    test::vector<float> ref_dst {0.0, 1.0, 0.0, 7.0, 7.0, 0.0};
+    test::vector<float> dst(ref_dst.size(), 0.0);
+
+    graph::op_t emb_op(0, graph::op_kind::EmbeddingBag, "embedding_bag");
+    emb_op.set_attr<std::string>(graph::op_attr::mode, "sum");
+    graph::op_t matmul_op(1, graph::op_kind::MatMul, "matmul");
+    graph::op_t relu_op(2, graph::op_kind::ReLU, "relu");
+
+    graph::logical_tensor_t table_lt
+            = utils::logical_tensor_init(0, {4, 2}, graph::data_type::f32);
+    graph::logical_tensor_t indices_lt = utils::logical_tensor_init(
+            1, std::vector<graph::dim_t> {4}, graph::data_type::s32);
+    graph::logical_tensor_t offsets_lt = utils::logical_tensor_init(
+            2, std::vector<graph::dim_t> {3}, graph::data_type::s32);
+    graph::logical_tensor_t emb_dst_lt = utils::logical_tensor_init(
+            3, {3, 2}, graph::data_type::f32, graph::layout_type::any);
+    graph::logical_tensor_t weight_lt
+            = utils::logical_tensor_init(4, {2, 2}, graph::data_type::f32);
+    graph::logical_tensor_t matmul_dst_lt = utils::logical_tensor_init(
+            5, {3, 2}, graph::data_type::f32, graph::layout_type::any);
+    graph::logical_tensor_t dst_lt
+            = utils::logical_tensor_init(6, {3, 2}, graph::data_type::f32);
+
+    emb_op.add_input(table_lt);
+    emb_op.add_input(indices_lt);
+    emb_op.add_input(offsets_lt);
+    emb_op.add_output(emb_dst_lt);
+    matmul_op.add_input(emb_dst_lt);
+    matmul_op.add_input(weight_lt);
+    matmul_op.add_output(matmul_dst_lt);
+    relu_op.add_input(matmul_dst_lt);
+    relu_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    ASSERT_EQ(g.add_op(&emb_op), graph::status::success);
+    ASSERT_EQ(g.add_op(&matmul_op), graph::status::success);
+    ASSERT_EQ(g.add_op(&relu_op), graph::status::success);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass
+            = get_pass("embedding_bag_matmul_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+    ASSERT_EQ(part->get_ops().size(), 3U);
+
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &table_lt, &indices_lt, &offsets_lt, &weight_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t table_ts(table_lt, eng, table.data());
+    graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+    graph::tensor_t offsets_ts(offsets_lt, eng, offsets.data());
+    graph::tensor_t weight_ts(weight_lt, eng, weight.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+
+    graph::stream_t *strm = get_stream();
+    ASSERT_EQ(cp.execute(strm, {table_ts, indices_ts, offsets_ts, weight_ts},
+                      {dst_ts}),
+            graph::status::success);
+    strm->wait();
+
+    for (size_t i = 0; i < dst.size(); ++i) {
+        ASSERT_FLOAT_EQ(dst[i], ref_dst[i]);
+    }
+}
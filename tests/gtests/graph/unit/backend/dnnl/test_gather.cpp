@@ -0,0 +1,202 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+TEST(Execute, Gather) {
+    graph::engine_t *eng = get_engine();
+
+    test::vector<float> src {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    // -1 and 2 are both the last element of the axis
+    test::vector<int32_t> indices {-1, 0, 2};
+    test::vector<float> ref_dst {3.0, 1.0, 3.0, 6.0, 4.0, 6.0};
+    test::vector<float> dst(ref_dst.size(), -1.0);
+
+    graph::op_t gather_op(0, graph::op_kind::Gather, "gather");
+    gather_op.set_attr<int64_t>(graph::op_attr::axis, -1);
+
+    graph::logical_tensor_t src_lt
+            = utils::logical_tensor_init(0, {2, 3}, graph::data_type::f32);
+    graph::logical_tensor_t indices_lt = utils::logical_tensor_init(
+            1, std::vector<graph::dim_t> {3}, graph::data_type::s32);
+    graph::logical_tensor_t dst_lt
+            = utils::logical_tensor_init(2, {2, 3}, graph::data_type::f32);
+
+    gather_op.add_input(src_lt);
+    gather_op.add_input(indices_lt);
+    gather_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    ASSERT_EQ(g.add_op(&gather_op), graph::status::success);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("gather_pass_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> inputs {&src_lt, &indices_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t src_ts(src_lt, eng, src.data());
+    graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+
+    graph::stream_t *strm = get_stream();
+    cp.execute(strm, {src_ts, indices_ts}, {dst_ts});
+    strm->wait();
+
+    for (size_t i = 0; i < dst.size(); ++i) {
+        ASSERT_FLOAT_EQ(dst[i], ref_dst[i]);
+    }
+}
+
+TEST(Execute, GatherOutOfRange) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu, "skip on gpu");
+
+    test::vector<float> src {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    // 3 and -4 are out of range for an axis of 3, like the indices of an
+    // embedding bag they fail the execution
+    for (int32_t bad_index : {3, -4}) {
+        test::vector<int32_t> indices {0, bad_index};
+        test::vector<float> dst(4, -1.0);
+
+        graph::op_t gather_op(0, graph::op_kind::Gather, "gather");
+        gather_op.set_attr<int64_t>(graph::op_attr::axis, 1);
+
+        graph::logical_tensor_t src_lt = utils::logical_tensor_init(
+                0, {2, 3}, graph::data_type::f32);
+        graph::logical_tensor_t indices_lt = utils::logical_tensor_init(
+                1, std::vector<graph::dim_t> {2}, graph::data_type::s32);
+        graph::logical_tensor_t dst_lt = utils::logical_tensor_init(
+                2, {2, 2}, graph::data_type::f32);
+
+        gather_op.add_input(src_lt);
+        gather_op.add_input(indices_lt);
+        gather_op.add_output(dst_lt);
+
+        graph::graph_t g(eng->kind());
+        ASSERT_EQ(g.add_op(&gather_op), graph::status::success);
+        g.finalize();
+
+        graph::pass::pass_base_ptr apass = get_pass("gather_pass_cpu");
+        apass->run(g);
+        ASSERT_EQ(g.get_num_partitions(), 1U);
+        auto part = g.get_partitions()[0];
+
+        graph::partition_t p;
+        p.init(part);
+
+        graph::compiled_partition_t cp(p);
+
+        std::vector<const graph::logical_tensor_t *> inputs {
+                &src_lt, &indices_lt};
+        std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+
+        ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+        graph::tensor_t src_ts(src_lt, eng, src.data());
+        graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+        graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+
+        graph::stream_t *strm = get_stream();
+        EXPECT_THROW(cp.execute(strm, {src_ts, indices_ts}, {dst_ts}),
+                dnnl::error);
+        strm->wait();
+    }
+}
+
+TEST(Execute, GatherAdd) {
+    graph::engine_t *eng = get_engine();
+
+    // an embedding table of 4 rows gathered along the first axis
+    test::vector<float> table {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+    test::vector<int32_t> indices {3, -4, 1};
+    test::vector<float> bias {0.5, -0.5};
+    test::vector<float> ref_dst {7.5, 7.5, 1.5, 1.5, 3.5, 3.5};
+    test::vector<float> dst(ref_dst.size(), 0.0);
+
+    graph::op_t gather_op(0, graph::op_kind::Gather, "gather");
+    gather_op.set_attr<int64_t>(graph::op_attr::axis, 0);
+    graph::op_t add_op(1, graph::op_kind::Add, "add");
+
+    graph::logical_tensor_t table_lt
+            = utils::logical_tensor_init(0, {4, 2}, graph::data_type::f32);
+    graph::logical_tensor_t indices_lt = utils::logical_tensor_init(
+            1, std::vector<graph::dim_t> {3}, graph::data_type::s32);
+    graph::logical_tensor_t gather_dst_lt
+            = utils::logical_tensor_init(2, {3, 2}, graph::data_type::f32);
+    graph::logical_tensor_t bias_lt = utils::logical_tensor_init(
+            3, std::vector<graph::dim_t> {2}, graph::data_type::f32);
+    graph::logical_tensor_t dst_lt
+            = utils::logical_tensor_init(4, {3, 2}, graph::data_type::f32);
+
+    gather_op.add_input(table_lt);
+    gather_op.add_input(indices_lt);
+    gather_op.add_output(gather_dst_lt);
+    add_op.add_input(gather_dst_lt);
+    add_op.add_input(bias_lt);
+    add_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    ASSERT_EQ(g.add_op(&gather_op), graph::status::success);
+    ASSERT_EQ(g.add_op(&add_op), graph::status::success);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("gather_post_ops_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &table_lt, &indices_lt, &bias_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t table_ts(table_lt, eng, table.data());
+    graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+    graph::tensor_t bias_ts(bias_lt, eng, bias.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+
+    graph::stream_t *strm = get_stream();
+    cp.execute(strm, {table_ts, indices_ts, bias_ts}, {dst_ts});
+    strm->wait();
+
+    for (size_t i = 0; i < dst.size(); ++i) {
+        ASSERT_FLOAT_EQ(dst[i], ref_dst[i]);
+    }
+}
@@ -0,0 +1,179 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+TEST(Execute, GroupnormTraining) {
+    graph::engine_t *eng = get_engine();
+
+    // NCX with 4 channels of 2 elements in 2 groups, the groups are
+    // {2, 4, 2, 4} and {0, 0, 4, 4}
+    test::vector<float> src {2.0, 4.0, 2.0, 4.0, 0.0, 0.0, 4.0, 4.0};
+    test::vector<float> ref_dst {-1.0, 1.0, -1.0, 1.0, -1.0, -1.0, 1.0, 1.0};
+    test::vector<float> ref_mean {3.0, 2.0};
+    test::vector<float> ref_var {1.0, 4.0};
+    test::vector<float> dst(src.size(), 0.0);
+    test::vector<float> mean(ref_mean.size(), 0.0);
+    test::vector<float> var(ref_var.size(), 0.0);
+
+    graph::op_t groupnorm_op(0, graph::op_kind::GroupNorm, "groupnorm");
+    groupnorm_op.set_attr<int64_t>(graph::op_attr::groups, 2);
+    groupnorm_op.set_attr<bool>(graph::op_attr::use_affine, false);
+    groupnorm_op.set_attr<float>(graph::op_attr::epsilon, 0.f);
+    groupnorm_op.set_attr<std::string>(graph::op_attr::data_format, "NCX");
+
+    graph::logical_tensor_t src_lt
+            = utils::logical_tensor_init(0, {1, 4, 2}, graph::data_type::f32);
+    graph::logical_tensor_t dst_lt = utils::logical_tensor_init(
+            1, {1, 4, 2}, graph::data_type::f32, graph::layout_type::any);
+    graph::logical_tensor_t mean_lt = utils::logical_tensor_init(
+            2, {1, 2}, graph::data_type::f32, graph::layout_type::any);
+    graph::logical_tensor_t var_lt = utils::logical_tensor_init(
+            3, {1, 2}, graph::data_type::f32, graph::layout_type::any);
+
+    groupnorm_op.add_input(src_lt);
+    groupnorm_op.add_output(dst_lt);
+    groupnorm_op.add_output(mean_lt);
+    groupnorm_op.add_output(var_lt);
+
+    graph::graph_t g(eng->kind());
+    ASSERT_EQ(g.add_op(&groupnorm_op), graph::status::success);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass
+            = get_pass("groupnorm_post_ops_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> inputs {&src_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {
+            &dst_lt, &mean_lt, &var_lt};
+
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::logical_tensor_t compiled_dst_lt, compiled_mean_lt,
+            compiled_var_lt;
+    cp.query_logical_tensor(dst_lt.id, &compiled_dst_lt);
+    cp.query_logical_tensor(mean_lt.id, &compiled_mean_lt);
+    cp.query_logical_tensor(var_lt.id, &compiled_var_lt);
+    ASSERT_EQ(compiled_dst_lt.layout_type, graph::layout_type::strided);
+
+    graph::tensor_t src_ts(src_lt, eng, src.data());
+    graph::tensor_t dst_ts(compiled_dst_lt, eng, dst.data());
+    graph::tensor_t mean_ts(compiled_mean_lt, eng, mean.data());
+    graph::tensor_t var_ts(compiled_var_lt, eng, var.data());
+
+    graph::stream_t *strm = get_stream();
+    ASSERT_EQ(cp.execute(strm, {src_ts}, {dst_ts, mean_ts, var_ts}),
+            graph::status::success);
+    strm->wait();
+
+    for (size_t i = 0; i < dst.size(); ++i) {
+        ASSERT_NEAR(dst[i], ref_dst[i], 1e-5);
+    }
+    for (size_t i = 0; i < mean.size(); ++i) {
+        ASSERT_NEAR(mean[i], ref_mean[i], 1e-5);
+        ASSERT_NEAR(var[i], ref_var[i], 1e-5);
+    }
+}
+
+TEST(Execute, GroupnormInferenceRelu) {
+    graph::engine_t *eng = get_engine();
+
+    // NXC with 2 elements of 4 channels in 2 groups, the groups have the
+    // statistics of GroupnormTraining
+    test::vector<float> src {2.0, 2.0, 0.0, 4.0, 4.0, 4.0, 0.0, 4.0};
+    test::vector<float> gamma {1.0, 2.0, 1.0, 0.5};
+    test::vector<float> beta {0.0, 0.0, 1.0, -1.0};
+    test::vector<float> ref_dst {0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 0.0, 0.0};
+    test::vector<float> dst(src.size(), 0.0);
+
+    graph::op_t groupnorm_op(0, graph::op_kind::GroupNorm, "groupnorm");
+    groupnorm_op.set_attr<int64_t>(graph::op_attr::groups, 2);
+    groupnorm_op.set_attr<bool>(graph::op_attr::keep_stats, false);
+    groupnorm_op.set_attr<float>(graph::op_attr::epsilon, 0.f);
+    graph::op_t relu_op(1, graph::op_kind::ReLU, "relu");
+
+    graph::logical_tensor_t src_lt
+            = utils::logical_tensor_init(0, {1, 2, 4}, graph::data_type::f32);
+    graph::logical_tensor_t gamma_lt = utils::logical_tensor_init(
+            1, std::vector<graph::dim_t> {4}, graph::data_type::f32);
+    graph::logical_tensor_t beta_lt = utils::logical_tensor_init(
+            2, std::vector<graph::dim_t> {4}, graph::data_type::f32);
+    graph::logical_tensor_t groupnorm_dst_lt = utils::logical_tensor_init(
+            3, {1, 2, 4}, graph::data_type::f32, graph::layout_type::any);
+    graph::logical_tensor_t dst_lt
+            = utils::logical_tensor_init(4, {1, 2, 4}, graph::data_type::f32);
+
+    groupnorm_op.add_input(src_lt);
+    groupnorm_op.add_input(gamma_lt);
+    groupnorm_op.add_input(beta_lt);
+    groupnorm_op.add_output(groupnorm_dst_lt);
+    relu_op.add_input(groupnorm_dst_lt);
+    relu_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    ASSERT_EQ(g.add_op(&groupnorm_op), graph::status::success);
+    ASSERT_EQ(g.add_op(&relu_op), graph::status::success);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass
+            = get_pass("groupnorm_post_ops_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+    ASSERT_EQ(part->get_ops().size(), 2U);
+
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &gamma_lt, &beta_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t src_ts(src_lt, eng, src.data());
+    graph::tensor_t gamma_ts(gamma_lt, eng, gamma.data());
+    graph::tensor_t beta_ts(beta_lt, eng, beta.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+
+    graph::stream_t *strm = get_stream();
+    ASSERT_EQ(cp.execute(strm, {src_ts, gamma_ts, beta_ts}, {dst_ts}),
+            graph::status::success);
+    strm->wait();
+
+    for (size_t i = 0; i < dst.size(); ++i) {
+        ASSERT_NEAR(dst[i], ref_dst[i], 1e-5);
+    }
+}
@@ -14,8 +14,22 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
 
 #include "gtest/gtest.h"
 
@@ -548,3 +562,786 @@ TEST(Execute, F32MhaReshapeSoftMax) {
     ASSERT_EQ(cp.execute(strm, inputs_ts, outputs_ts), graph::status::success);
     strm->wait();
 }
+
+namespace {
+// Compares the f32 MHA partition with a reference. With KVH == 1 the key and
+// value heads are shared by all query heads (MQA). With select_mask the scores
+// are masked by a Select which replaces them with -inf.
+void check_f32_mha_accuracy(int64_t KVH, bool select_mask = false) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+
+    // the sequence spans several query and key blocks of the fused kernel
+    const int64_t B = 2, S = 160, H = 2, HD = 32, D = HD / H;
+    const int64_t KVD = KVH * D;
+    const float scale = 4.f;
+
+    graph::graph_t g(eng->kind());
+    utils::construct_f32_MHA(
+            &g, B, S, H, HD, static_cast<int>(KVH), select_mask);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("f32_MHA_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    auto partition_inputs = p.get_inputs();
+    auto partition_outputs = p.get_outputs();
+    ASSERT_EQ(partition_inputs.size(), select_mask ? 6U : 5U);
+    ASSERT_EQ(partition_outputs.size(), 1U);
+
+    std::vector<const graph::logical_tensor_t *> inputs, outputs;
+    for (auto &lt : partition_inputs) {
+        inputs.emplace_back(&lt);
+    }
+    for (auto &lt : partition_outputs) {
+        lt = utils::logical_tensor_init(
+                lt.id, lt.data_type, graph::layout_type::strided);
+        outputs.emplace_back(&lt);
+    }
+
+    graph::compiled_partition_t cp(p);
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    // query, key, value: [B, S, H * D], mask or select condition:
+    // [B, 1, 1, S], scale and fill: [1]
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::vector<test::vector<float>> inputs_data;
+    std::vector<graph::tensor_t> inputs_ts;
+    std::vector<const float *> query_key_value(3);
+    const float *mask = nullptr;
+    test::vector<uint8_t> cond(B * S);
+    // mask out the tail of the sequence of the second batch
+    const auto is_masked = [&](int64_t b, int64_t s) {
+        return b == 1 && s >= S - 40;
+    };
+    for (auto &lt : inputs) {
+        inputs_data.emplace_back(
+                test::vector<float>(utils::product(ltw(lt).vdims())));
+        auto &data = inputs_data.back();
+        if (lt->id == 18) {
+            // the condition keeps the scores which are not masked
+            for_(int64_t b = 0; b < B; b++)
+            for (int64_t s = 0; s < S; s++)
+                cond[b * S + s] = is_masked(b, s) ? 0 : 1;
+            inputs_ts.emplace_back(*lt, eng, cond.data());
+            continue;
+        }
+        if (lt->id == 10) {
+            data[0] = scale;
+        } else if (lt->id == 19) {
+            data[0] = -std::numeric_limits<float>::infinity();
+        } else if (lt->id == 3) {
+            for_(int64_t b = 0; b < B; b++)
+            for (int64_t s = 0; s < S; s++)
+                data[b * S + s] = is_masked(b, s) ? -10000.f : 0.f;
+            mask = data.data();
+        } else {
+            std::generate(data.begin(), data.end(),
+                    [&]() { return distribution(generator); });
+            query_key_value[lt->id] = data.data();
+        }
+        inputs_ts.emplace_back(*lt, eng, data.data());
+    }
+
+    graph::logical_tensor_t compiled_output;
+    cp.query_logical_tensor(outputs[0]->id, &compiled_output);
+    test::vector<float> output_data(
+            utils::product(ltw(compiled_output).vdims()));
+    std::vector<graph::tensor_t> outputs_ts {
+            graph::tensor_t(compiled_output, eng, output_data.data())};
+
+    ASSERT_EQ(cp.execute(strm, inputs_ts, outputs_ts), graph::status::success);
+    strm->wait();
+
+    // output: [B, S, H, D]
+    const auto out_strides = ltw(compiled_output).vstrides();
+    const float *q = query_key_value[0], *k = query_key_value[1],
+                *v = query_key_value[2];
+    std::vector<double> scores(S);
+    for_(int64_t b = 0; b < B; b++)
+    for_(int64_t h = 0; h < H; h++)
+    for (int64_t i = 0; i < S; i++) {
+        double max = -std::numeric_limits<double>::infinity();
+        for (int64_t j = 0; j < S; j++) {
+            double dot = 0;
+            for (int64_t d = 0; d < D; d++)
+                dot += q[(b * S + i) * HD + h * D + d]
+                        * k[(b * S + j) * KVD + (h % KVH) * D + d];
+            if (select_mask)
+                scores[j] = is_masked(b, j)
+                        ? -std::numeric_limits<double>::infinity()
+                        : dot / scale;
+            else
+                scores[j] = dot / scale + mask[b * S + j];
+            max = std::max(max, scores[j]);
+        }
+        double sum = 0;
+        for (int64_t j = 0; j < S; j++) {
+            scores[j] = std::exp(scores[j] - max);
+            sum += scores[j];
+        }
+        for (int64_t d = 0; d < D; d++) {
+            double ref = 0;
+            for (int64_t j = 0; j < S; j++)
+                ref += scores[j] * v[(b * S + j) * KVD + (h % KVH) * D + d];
+            ref /= sum;
+            const float got = output_data[b * out_strides[0]
+                    + i * out_strides[1] + h * out_strides[2]
+                    + d * out_strides[3]];
+            ASSERT_NEAR(got, ref, 1e-4);
+        }
+    }
+}
+} // namespace
+
+TEST(Execute, F32MhaAccuracy) {
+    check_f32_mha_accuracy(2);
+}
+
+TEST(Execute, F32MqaAccuracy) {
+    check_f32_mha_accuracy(1);
+}
+
+TEST(Execute, F32MhaSelectMaskAccuracy) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu, "skip on gpu");
+    check_f32_mha_accuracy(2, /* select_mask = */ true);
+}
+
+TEST(Execute, F32MaskedScoresAccuracy) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu, "skip on gpu");
+    graph::stream_t *strm = get_stream();
+
+    // a causal mask shared by all batches and heads
+    const int64_t B = 2, H = 2, S = 24, D = 16;
+    const float scale = 4.f, fill = -10000.f;
+    const graph::data_type_t dt = graph::data_type::f32;
+    using utils::logical_tensor_init;
+    graph::logical_tensor_t query = logical_tensor_init(0, {B, H, S, D}, dt);
+    graph::logical_tensor_t key = logical_tensor_init(1, {B, H, D, S}, dt);
+    graph::logical_tensor_t mm_dst = logical_tensor_init(2, {B, H, S, S}, dt);
+    graph::logical_tensor_t scale_lt
+            = logical_tensor_init(3, std::vector<graph::dim_t> {1}, dt);
+    graph::logical_tensor_t div_dst = logical_tensor_init(4, {B, H, S, S}, dt);
+    graph::logical_tensor_t cond_lt
+            = logical_tensor_init(5, {1, 1, S, S}, graph::data_type::u8);
+    graph::logical_tensor_t fill_lt
+            = logical_tensor_init(6, std::vector<graph::dim_t> {1}, dt);
+    graph::logical_tensor_t select_dst
+            = logical_tensor_init(7, {B, H, S, S}, dt);
+    graph::logical_tensor_t dst = logical_tensor_init(
+            8, {B, H, S, S}, dt, graph::layout_type::strided);
+
+    graph::op_t matmul {0, graph::op_kind::MatMul, "matmul"};
+    matmul.add_input(query);
+    matmul.add_input(key);
+    matmul.add_output(mm_dst);
+    graph::op_t div {1, graph::op_kind::Divide, "divide"};
+    div.add_input(mm_dst);
+    div.add_input(scale_lt);
+    div.add_output(div_dst);
+    graph::op_t select {2, graph::op_kind::Select, "select"};
+    select.add_input(cond_lt);
+    select.add_input(div_dst);
+    select.add_input(fill_lt);
+    select.add_output(select_dst);
+    graph::op_t softmax {3, graph::op_kind::SoftMax, "softmax"};
+    softmax.set_attr<int64_t>(graph::op_attr::axis, -1);
+    softmax.add_input(select_dst);
+    softmax.add_output(dst);
+
+    graph::graph_t g(eng->kind());
+    for (auto *op : {&matmul, &div, &select, &softmax})
+        g.add_op(op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("masked_scores_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &query, &key, &scale_lt, &cond_lt, &fill_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst};
+
+    graph::compiled_partition_t cp(p);
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    test::vector<float> query_data(B * H * S * D), key_data(B * H * D * S);
+    std::generate(query_data.begin(), query_data.end(),
+            [&]() { return distribution(generator); });
+    std::generate(key_data.begin(), key_data.end(),
+            [&]() { return distribution(generator); });
+    test::vector<float> scale_data {scale}, fill_data {fill};
+    test::vector<uint8_t> cond_data(S * S);
+    for_(int64_t i = 0; i < S; i++)
+    for (int64_t j = 0; j < S; j++)
+        cond_data[i * S + j] = j <= i ? 1 : 0;
+    test::vector<float> output_data(B * H * S * S);
+
+    std::vector<graph::tensor_t> inputs_ts {
+            graph::tensor_t(query, eng, query_data.data()),
+            graph::tensor_t(key, eng, key_data.data()),
+            graph::tensor_t(scale_lt, eng, scale_data.data()),
+            graph::tensor_t(cond_lt, eng, cond_data.data()),
+            graph::tensor_t(fill_lt, eng, fill_data.data())};
+    std::vector<graph::tensor_t> outputs_ts {
+            graph::tensor_t(dst, eng, output_data.data())};
+
+    ASSERT_EQ(cp.execute(strm, inputs_ts, outputs_ts), graph::status::success);
+    strm->wait();
+
+    std::vector<double> scores(S);
+    for_(int64_t bh = 0; bh < B * H; bh++)
+    for (int64_t i = 0; i < S; i++) {
+        double max = -std::numeric_limits<double>::infinity();
+        for (int64_t j = 0; j < S; j++) {
+            double dot = 0;
+            for (int64_t d = 0; d < D; d++)
+                dot += query_data[(bh * S + i) * D + d]
+                        * key_data[(bh * D + d) * S + j];
+            scores[j] = cond_data[i * S + j] ? dot / scale : fill;
+            max = std::max(max, scores[j]);
+        }
+        double sum = 0;
+        for (int64_t j = 0; j < S; j++) {
+            scores[j] = std::exp(scores[j] - max);
+            sum += scores[j];
+        }
+        for (int64_t j = 0; j < S; j++)
+            ASSERT_NEAR(output_data[(bh * S + i) * S + j], scores[j] / sum,
+                    1e-5);
+    }
+}
+
+TEST(Execute, F32GatedMlpAccuracy) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu, "skip on gpu");
+    graph::stream_t *strm = get_stream();
+
+    // N1 spans several weight chunks of the fused kernel, the last of them
+    // partial, and the rows span several row blocks
+    const int64_t B = 2, S = 40, K = 256, N1 = 1000, N2 = 256;
+    const graph::data_type_t dt = graph::data_type::f32;
+    using utils::logical_tensor_init;
+    graph::logical_tensor_t src = logical_tensor_init(0, {B, S, K}, dt);
+    graph::logical_tensor_t wei = logical_tensor_init(1, {K, N1}, dt);
+    graph::logical_tensor_t bias = logical_tensor_init(2, {N1}, dt);
+    graph::logical_tensor_t wei_up = logical_tensor_init(3, {K, N1}, dt);
+    graph::logical_tensor_t bias_up = logical_tensor_init(4, {N1}, dt);
+    graph::logical_tensor_t wei_down = logical_tensor_init(5, {N1, N2}, dt);
+    graph::logical_tensor_t bias_down = logical_tensor_init(6, {N2}, dt);
+    graph::logical_tensor_t mm_dst = logical_tensor_init(7, {B, S, N1}, dt);
+    graph::logical_tensor_t sigmoid_dst
+            = logical_tensor_init(8, {B, S, N1}, dt);
+    graph::logical_tensor_t swish_dst = logical_tensor_init(9, {B, S, N1}, dt);
+    graph::logical_tensor_t mm_up_dst
+            = logical_tensor_init(10, {B, S, N1}, dt);
+    graph::logical_tensor_t gate_dst = logical_tensor_init(11, {B, S, N1}, dt);
+    graph::logical_tensor_t dst = logical_tensor_init(
+            12, {B, S, N2}, dt, graph::layout_type::strided);
+
+    graph::op_t matmul {0, graph::op_kind::MatMul, "matmul"};
+    matmul.add_input(src);
+    matmul.add_input(wei);
+    matmul.add_input(bias);
+    matmul.add_output(mm_dst);
+    graph::op_t sigmoid {1, graph::op_kind::Sigmoid, "sigmoid"};
+    sigmoid.add_input(mm_dst);
+    sigmoid.add_output(sigmoid_dst);
+    graph::op_t swish {2, graph::op_kind::Multiply, "swish"};
+    swish.add_input(mm_dst);
+    swish.add_input(sigmoid_dst);
+    swish.add_output(swish_dst);
+    graph::op_t matmul_up {3, graph::op_kind::MatMul, "matmul_up"};
+    matmul_up.add_input(src);
+    matmul_up.add_input(wei_up);
+    matmul_up.add_input(bias_up);
+    matmul_up.add_output(mm_up_dst);
+    graph::op_t gate {4, graph::op_kind::Multiply, "gate"};
+    gate.add_input(swish_dst);
+    gate.add_input(mm_up_dst);
+    gate.add_output(gate_dst);
+    graph::op_t matmul_down {5, graph::op_kind::MatMul, "matmul_down"};
+    matmul_down.add_input(gate_dst);
+    matmul_down.add_input(wei_down);
+    matmul_down.add_input(bias_down);
+    matmul_down.add_output(dst);
+
+    graph::graph_t g(eng->kind());
+    for (auto *op : {&matmul, &sigmoid, &swish, &matmul_up, &gate,
+                 &matmul_down})
+        g.add_op(op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("f32_gated_mlp_swish_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+
+    auto partition_inputs = p.get_inputs();
+    ASSERT_EQ(partition_inputs.size(), 7U);
+    std::vector<const graph::logical_tensor_t *> inputs, outputs {&dst};
+    for (auto &lt : partition_inputs) {
+        inputs.emplace_back(&lt);
+    }
+
+    graph::compiled_partition_t cp(p);
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-0.5f, 0.5f);
+    std::vector<test::vector<float>> inputs_data;
+    std::vector<graph::tensor_t> inputs_ts;
+    std::vector<const float *> data_by_id(7);
+    for (auto &lt : inputs) {
+        inputs_data.emplace_back(
+                test::vector<float>(utils::product(ltw(lt).vdims())));
+        auto &data = inputs_data.back();
+        std::generate(data.begin(), data.end(),
+                [&]() { return distribution(generator); });
+        data_by_id[lt->id] = data.data();
+        inputs_ts.emplace_back(*lt, eng, data.data());
+    }
+
+    graph::logical_tensor_t compiled_output;
+    cp.query_logical_tensor(dst.id, &compiled_output);
+    test::vector<float> output_data(B * S * N2);
+    std::vector<graph::tensor_t> outputs_ts {
+            graph::tensor_t(compiled_output, eng, output_data.data())};
+
+    ASSERT_EQ(cp.execute(strm, inputs_ts, outputs_ts), graph::status::success);
+    strm->wait();
+
+    const float *x = data_by_id[0], *w = data_by_id[1], *b = data_by_id[2],
+                *w_up = data_by_id[3], *b_up = data_by_id[4],
+                *w_down = data_by_id[5], *b_down = data_by_id[6];
+    std::vector<double> h(N1);
+    for (int64_t i = 0; i < B * S; i++) {
+        for (int64_t j = 0; j < N1; j++) {
+            double v = b[j], u = b_up[j];
+            for (int64_t k = 0; k < K; k++) {
+                v += x[i * K + k] * w[k * N1 + j];
+                u += x[i * K + k] * w_up[k * N1 + j];
+            }
+            h[j] = v / (1.0 + std::exp(-v)) * u;
+        }
+        for (int64_t j = 0; j < N2; j++) {
+            double ref = b_down[j];
+            for (int64_t n = 0; n < N1; n++)
+                ref += h[n] * w_down[n * N2 + j];
+            ASSERT_NEAR(output_data[i * N2 + j], ref, 1e-3);
+        }
+    }
+}
+
+namespace {
+// The partition of the int8 resnet50 stage 2 block with strided outputs,
+// shared by the tests of the cache blobs and of the constant tensor cache
+struct int8_resnet50_stage2_block_t {
+    int8_resnet50_stage2_block_t(graph::engine_kind_t kind) : g(kind) {}
+
+    void init() {
+        utils::id_generator id_gen;
+        utils::construct_int8_resnet50_stage2_block(&g, id_gen, 3);
+        g.finalize();
+
+        graph::pass::pass_base_ptr apass
+                = get_pass("int8_resnet50_stage_2_fusion");
+        apass->run(g);
+        ASSERT_EQ(g.get_num_partitions(), 1U);
+        p.init(g.get_partitions()[0]);
+
+        partition_inputs = p.get_inputs();
+        partition_outputs = p.get_outputs();
+        for (auto &lt : partition_inputs) {
+            inputs.emplace_back(&lt);
+        }
+        for (auto &lt : partition_outputs) {
+            lt = utils::logical_tensor_init(
+                    lt.id, lt.data_type, graph::layout_type::strided);
+            outputs.emplace_back(&lt);
+        }
+    }
+
+    // Fills the data of the inputs with the same values in all the tests
+    void fill_inputs(std::vector<test::vector<float>> &inputs_data) const {
+        using ltw = graph::logical_tensor_wrapper_t;
+        for (const auto *lt : inputs) {
+            inputs_data.emplace_back(
+                    test::vector<float>(utils::product(ltw(lt).vdims())));
+            auto &data = inputs_data.back();
+            for (size_t i = 0; i < data.size(); i++)
+                data[i] = static_cast<float>(i % 5) * 0.25f;
+        }
+    }
+
+    graph::graph_t g;
+    graph::partition_t p;
+    std::vector<graph::logical_tensor_t> partition_inputs, partition_outputs;
+    std::vector<const graph::logical_tensor_t *> inputs, outputs;
+};
+} // namespace
+
+TEST(Execute, Int8Resnet50Stage2BlockFromCacheBlob) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+
+    int8_resnet50_stage2_block_t block(eng->kind());
+    ASSERT_NO_FATAL_FAILURE(block.init());
+    graph::partition_t &p = block.p;
+    auto &inputs = block.inputs;
+    auto &outputs = block.outputs;
+
+    graph::compiled_partition_t cp(p);
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    std::vector<test::vector<float>> inputs_data;
+    std::vector<graph::tensor_t> inputs_ts;
+    block.fill_inputs(inputs_data);
+    for (size_t i = 0; i < inputs.size(); i++)
+        inputs_ts.emplace_back(*inputs[i], eng, inputs_data[i].data());
+
+    // The first execution fills the constant cache, so the constant tensors
+    // are part of the blob
+    graph::logical_tensor_t compiled_output;
+    cp.query_logical_tensor(outputs[0]->id, &compiled_output);
+    test::vector<float> ref_data(utils::product(ltw(compiled_output).vdims()));
+    std::vector<graph::tensor_t> ref_ts {
+            graph::tensor_t(compiled_output, eng, ref_data.data())};
+    ASSERT_EQ(cp.execute(strm, inputs_ts, ref_ts), graph::status::success);
+    strm->wait();
+
+    std::vector<uint8_t> blob;
+    ASSERT_EQ(cp.get_cache_blob(blob), graph::status::success);
+    ASSERT_FALSE(blob.empty());
+
+    graph::compiled_partition_t cp_loaded(p);
+    ASSERT_EQ(p.compile_from_cache_blob(&cp_loaded, blob, eng),
+            graph::status::success);
+
+    graph::logical_tensor_t loaded_output;
+    cp_loaded.query_logical_tensor(outputs[0]->id, &loaded_output);
+    ASSERT_TRUE(ltw(loaded_output) == ltw(compiled_output));
+    for (const auto &lt : block.partition_inputs) {
+        graph::logical_tensor_t compiled_input, loaded_input;
+        cp.query_logical_tensor(lt.id, &compiled_input);
+        cp_loaded.query_logical_tensor(lt.id, &loaded_input);
+        ASSERT_TRUE(ltw(loaded_input) == ltw(compiled_input));
+    }
+
+    test::vector<float> out_data(ref_data.size());
+    std::vector<graph::tensor_t> out_ts {
+            graph::tensor_t(loaded_output, eng, out_data.data())};
+    ASSERT_EQ(cp_loaded.execute(strm, inputs_ts, out_ts),
+            graph::status::success);
+    strm->wait();
+    for (size_t i = 0; i < ref_data.size(); i++)
+        ASSERT_EQ(out_data[i], ref_data[i]);
+
+    // a truncated blob is rejected
+    blob.resize(blob.size() / 2);
+    graph::compiled_partition_t cp_truncated(p);
+    ASSERT_NE(p.compile_from_cache_blob(&cp_truncated, blob, eng),
+            graph::status::success);
+}
+
+TEST(Compile, Int8Resnet50Stage2BlockCorruptedCacheBlob) {
+    graph::engine_t *eng = get_engine();
+
+    int8_resnet50_stage2_block_t block(eng->kind());
+    ASSERT_NO_FATAL_FAILURE(block.init());
+    graph::partition_t &p = block.p;
+
+    graph::compiled_partition_t cp(p);
+    ASSERT_EQ(p.compile(&cp, block.inputs, block.outputs, eng),
+            graph::status::success);
+    std::vector<uint8_t> blob;
+    ASSERT_EQ(cp.get_cache_blob(blob), graph::status::success);
+
+    // find the first input of the partition in the blob by its id and dims
+    graph::logical_tensor_t lt;
+    cp.query_logical_tensor(block.partition_inputs[0].id, &lt);
+    const size_t id_offset = offsetof(graph::logical_tensor_t, id);
+    const size_t ndims_offset = offsetof(graph::logical_tensor_t, ndims);
+    const size_t dims_offset = offsetof(graph::logical_tensor_t, dims);
+    const size_t dims_size = sizeof(lt.dims[0]) * lt.ndims;
+    const uint8_t *lt_bytes = reinterpret_cast<const uint8_t *>(&lt);
+    auto same = [&](size_t pos, size_t offset, size_t size) {
+        return std::memcmp(blob.data() + pos + offset, lt_bytes + offset, size)
+                == 0;
+    };
+    size_t pos = 0;
+    for (; pos + sizeof(lt) <= blob.size(); pos++) {
+        if (same(pos, id_offset, sizeof(lt.id))
+                && same(pos, ndims_offset, sizeof(lt.ndims))
+                && same(pos, dims_offset, dims_size))
+            break;
+    }
+    ASSERT_LE(pos + sizeof(lt), blob.size());
+
+    for (int32_t ndims : {-2, DNNL_MAX_NDIMS + 1}) {
+        std::vector<uint8_t> corrupted(blob);
+        std::memcpy(corrupted.data() + pos + ndims_offset, &ndims,
+                sizeof(ndims));
+        graph::compiled_partition_t cp_corrupted(p);
+        ASSERT_EQ(p.compile_from_cache_blob(&cp_corrupted, corrupted, eng),
+                graph::status::invalid_arguments);
+    }
+}
+
+TEST(Execute, Int8Resnet50Stage2BlockSharedConstants) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "constant tensors are only shared on cpu");
+    graph::stream_t *strm = get_stream();
+
+    int8_resnet50_stage2_block_t block(eng->kind());
+    ASSERT_NO_FATAL_FAILURE(block.init());
+    graph::partition_t &p = block.p;
+    auto &inputs = block.inputs;
+    auto &outputs = block.outputs;
+
+    // two compiled partitions of the same partition, e.g. two instances of a
+    // model sharing the weights
+    graph::compiled_partition_t cp0(p), cp1(p);
+    ASSERT_EQ(p.compile(&cp0, inputs, outputs, eng), graph::status::success);
+    ASSERT_EQ(p.compile(&cp1, inputs, outputs, eng), graph::status::success);
+
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    std::vector<test::vector<float>> inputs_data;
+    std::vector<graph::tensor_t> inputs_ts;
+    block.fill_inputs(inputs_data);
+    for (size_t i = 0; i < inputs.size(); i++)
+        inputs_ts.emplace_back(*inputs[i], eng, inputs_data[i].data());
+
+    graph::logical_tensor_t compiled_output;
+    cp0.query_logical_tensor(outputs[0]->id, &compiled_output);
+    test::vector<float> out0_data(utils::product(ltw(compiled_output).vdims()));
+    test::vector<float> out1_data(out0_data.size());
+    std::vector<graph::tensor_t> out0_ts {
+            graph::tensor_t(compiled_output, eng, out0_data.data())};
+    std::vector<graph::tensor_t> out1_ts {
+            graph::tensor_t(compiled_output, eng, out1_data.data())};
+
+    ASSERT_EQ(cp0.execute(strm, inputs_ts, out0_ts), graph::status::success);
+    strm->wait();
+    size_t footprint0 = 0;
+    ASSERT_EQ(dnnl_graph_get_constant_tensor_cache_footprint(&footprint0),
+            dnnl_success);
+    ASSERT_GT(footprint0, 0U);
+
+    // the second compiled partition reuses the constant tensors of the first
+    ASSERT_EQ(cp1.execute(strm, inputs_ts, out1_ts), graph::status::success);
+    strm->wait();
+    size_t footprint1 = 0;
+    ASSERT_EQ(dnnl_graph_get_constant_tensor_cache_footprint(&footprint1),
+            dnnl_success);
+    ASSERT_EQ(footprint1, footprint0);
+
+    for (size_t i = 0; i < out0_data.size(); i++)
+        ASSERT_EQ(out1_data[i], out0_data[i]);
+}
+
+TEST(Execute, Int8Resnet50Stage2BlockReusedConstantAddress) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "constant tensors are only shared on cpu");
+    graph::stream_t *strm = get_stream();
+
+    int8_resnet50_stage2_block_t block(eng->kind());
+    ASSERT_NO_FATAL_FAILURE(block.init());
+    graph::partition_t &p = block.p;
+    auto &inputs = block.inputs;
+    auto &outputs = block.outputs;
+
+    graph::compiled_partition_t cp0(p), cp1(p), cp_ref(p);
+    ASSERT_EQ(p.compile(&cp0, inputs, outputs, eng), graph::status::success);
+    ASSERT_EQ(p.compile(&cp1, inputs, outputs, eng), graph::status::success);
+    ASSERT_EQ(p.compile(&cp_ref, inputs, outputs, eng), graph::status::success);
+
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    std::vector<test::vector<float>> inputs_data;
+    std::vector<graph::tensor_t> inputs_ts;
+    block.fill_inputs(inputs_data);
+    for (size_t i = 0; i < inputs.size(); i++)
+        inputs_ts.emplace_back(*inputs[i], eng, inputs_data[i].data());
+
+    graph::logical_tensor_t compiled_output;
+    cp0.query_logical_tensor(outputs[0]->id, &compiled_output);
+    const size_t out_size = utils::product(ltw(compiled_output).vdims());
+    test::vector<float> out0_data(out_size), out1_data(out_size),
+            ref_data(out_size);
+    std::vector<graph::tensor_t> out0_ts {
+            graph::tensor_t(compiled_output, eng, out0_data.data())};
+    std::vector<graph::tensor_t> out1_ts {
+            graph::tensor_t(compiled_output, eng, out1_data.data())};
+    std::vector<graph::tensor_t> ref_ts {
+            graph::tensor_t(compiled_output, eng, ref_data.data())};
+
+    ASSERT_EQ(cp0.execute(strm, inputs_ts, out0_ts), graph::status::success);
+    strm->wait();
+
+    // another model puts other constant data at the same addresses, while
+    // the first compiled partition still holds its cached buffer
+    size_t num_constants = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (inputs[i]->property != graph::property_type::constant) continue;
+        num_constants++;
+        auto &data = inputs_data[i];
+        for (size_t j = 0; j < data.size(); j++)
+            data[j] = static_cast<float>(j % 3) * 0.5f;
+    }
+    ASSERT_GT(num_constants, 0U);
+    ASSERT_EQ(cp1.execute(strm, inputs_ts, out1_ts), graph::status::success);
+    strm->wait();
+
+    // the same data at other addresses gives the expected output
+    std::vector<test::vector<float>> ref_inputs_data(inputs_data);
+    std::vector<graph::tensor_t> ref_inputs_ts;
+    for (size_t i = 0; i < inputs.size(); i++)
+        ref_inputs_ts.emplace_back(*inputs[i], eng, ref_inputs_data[i].data());
+    ASSERT_EQ(cp_ref.execute(strm, ref_inputs_ts, ref_ts),
+            graph::status::success);
+    strm->wait();
+
+    bool same_as_old = true;
+    for (size_t i = 0; i < out_size; i++) {
+        ASSERT_EQ(out1_data[i], ref_data[i]);
+        same_as_old = same_as_old && out1_data[i] == out0_data[i];
+    }
+    ASSERT_FALSE(same_as_old);
+}
+
+#ifdef __linux__
+namespace {
+// Returns the paths of the files of a directory
+std::vector<std::string> list_files(const std::string &dir) {
+    std::vector<std::string> files;
+    DIR *d = opendir(dir.c_str());
+    if (!d) return files;
+    while (struct dirent *entry = readdir(d)) {
+        if (entry->d_name[0] == '.') continue;
+        files.emplace_back(dir + "/" + entry->d_name);
+    }
+    closedir(d);
+    return files;
+}
+
+// Disables the sharing of the constant tensors and removes the directory
+// when the test ends, also when an assertion fails
+struct constant_cache_dir_guard_t {
+    constant_cache_dir_guard_t(const std::string &dir) : dir_(dir) {}
+    ~constant_cache_dir_guard_t() {
+        dnnl_graph_set_constant_tensor_cache_dir(nullptr);
+        for (const auto &path : list_files(dir_))
+            unlink(path.c_str());
+        rmdir(dir_.c_str());
+    }
+
+private:
+    std::string dir_;
+};
+} // namespace
+
+TEST(Execute, Int8Resnet50Stage2BlockSharedConstantsDir) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    if (eng->kind() != graph::engine_kind::cpu) return;
+
+    char dir[] = "/tmp/dnnl_graph_constant_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    constant_cache_dir_guard_t dir_guard(dir);
+    ASSERT_EQ(dnnl_graph_set_constant_tensor_cache_dir(dir), dnnl_success);
+
+    int8_resnet50_stage2_block_t block(eng->kind());
+    ASSERT_NO_FATAL_FAILURE(block.init());
+    graph::partition_t &p = block.p;
+    auto &inputs = block.inputs;
+    auto &outputs = block.outputs;
+
+    graph::compiled_partition_t cp0(p), cp1(p);
+    ASSERT_EQ(p.compile(&cp0, inputs, outputs, eng), graph::status::success);
+    ASSERT_EQ(p.compile(&cp1, inputs, outputs, eng), graph::status::success);
+
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    // The second set of inputs has the same contents at other addresses, as
+    // in another process, so it is found only by the shared directory
+    std::vector<test::vector<float>> inputs0_data, inputs1_data;
+    std::vector<graph::tensor_t> inputs0_ts, inputs1_ts;
+    block.fill_inputs(inputs0_data);
+    inputs1_data = inputs0_data;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        inputs0_ts.emplace_back(*inputs[i], eng, inputs0_data[i].data());
+        inputs1_ts.emplace_back(*inputs[i], eng, inputs1_data[i].data());
+    }
+
+    graph::logical_tensor_t compiled_output;
+    cp0.query_logical_tensor(outputs[0]->id, &compiled_output);
+    test::vector<float> out0_data(utils::product(ltw(compiled_output).vdims()));
+    test::vector<float> out1_data(out0_data.size());
+    std::vector<graph::tensor_t> out0_ts {
+            graph::tensor_t(compiled_output, eng, out0_data.data())};
+    std::vector<graph::tensor_t> out1_ts {
+            graph::tensor_t(compiled_output, eng, out1_data.data())};
+
+    ASSERT_EQ(cp0.execute(strm, inputs0_ts, out0_ts), graph::status::success);
+    strm->wait();
+    ASSERT_EQ(cp1.execute(strm, inputs1_ts, out1_ts), graph::status::success);
+    strm->wait();
+    for (size_t i = 0; i < out0_data.size(); i++)
+        ASSERT_EQ(out1_data[i], out0_data[i]);
+
+    const std::vector<std::string> files = list_files(dir);
+    if (!graph::is_constant_cache_enabled()) return;
+    ASSERT_GT(files.size(), 0U);
+
+    // A corrupted file fails its checksum, so the constant tensors are
+    // prepared again instead of being mapped
+    for (const auto &path : files) {
+        FILE *f = fopen(path.c_str(), "r+b");
+        ASSERT_NE(f, nullptr);
+        ASSERT_EQ(fseek(f, -1, SEEK_END), 0);
+        const int last = fgetc(f);
+        ASSERT_EQ(fseek(f, -1, SEEK_END), 0);
+        fputc(last ^ 0xff, f);
+        fclose(f);
+    }
+    graph::compiled_partition_t cp2(p);
+    ASSERT_EQ(p.compile(&cp2, inputs, outputs, eng), graph::status::success);
+    std::vector<test::vector<float>> inputs2_data(inputs0_data);
+    std::vector<graph::tensor_t> inputs2_ts;
+    for (size_t i = 0; i < inputs.size(); i++)
+        inputs2_ts.emplace_back(*inputs[i], eng, inputs2_data[i].data());
+    test::vector<float> out2_data(out0_data.size());
+    std::vector<graph::tensor_t> out2_ts {
+            graph::tensor_t(compiled_output, eng, out2_data.data())};
+    ASSERT_EQ(cp2.execute(strm, inputs2_ts, out2_ts), graph::status::success);
+    strm->wait();
+    for (size_t i = 0; i < out0_data.size(); i++)
+        ASSERT_EQ(out2_data[i], out0_data[i]);
+}
+#endif
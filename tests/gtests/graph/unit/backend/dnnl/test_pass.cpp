@@ -15,6 +15,8 @@
 *******************************************************************************/
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <numeric>
 #include <tuple>
 #include <vector>
@@ -13355,6 +13357,242 @@ TEST(Pass, F32MhaFusion) {
     ASSERT_EQ(agraph.get_num_partitions(), 1U);
 }
 
+TEST(Pass, F32MhaFusionWithSelectMask) {
+    dnnl::impl::graph::graph_t agraph;
+    dnnl::graph::tests::unit::utils::construct_f32_MHA(
+            &agraph, 1, 384, 16, 1024, -1, /* select_mask = */ true);
+    agraph.finalize();
+    ASSERT_EQ(agraph.get_ops().size(), 13U);
+
+    dnnl::impl::graph::pass::pass_base_ptr apass = get_pass("f32_MHA_fusion");
+    apass->run(agraph);
+    ASSERT_EQ(agraph.get_num_partitions(), 1U);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_ops().size(), 13U);
+}
+
+TEST(Pass, FuseSelectPostOps) {
+    /*  select
+          |
+         relu
+          |
+         add
+    */
+    op_t select {0, Select, "select"};
+    op_t relu {1, ReLU, "relu"};
+    op_t add {2, Add, "add"};
+
+    logical_tensor_t cond = logical_tensor_init(0, data_type::u8);
+    logical_tensor_t then_src = logical_tensor_init(1, data_type::f32);
+    logical_tensor_t else_src = logical_tensor_init(2, data_type::f32);
+    logical_tensor_t select_dst = logical_tensor_init(3, data_type::f32);
+    logical_tensor_t relu_dst = logical_tensor_init(4, data_type::f32);
+    logical_tensor_t add_src1 = logical_tensor_init(5, data_type::f32);
+    logical_tensor_t add_dst = logical_tensor_init(6, data_type::f32);
+
+    select.add_input(cond);
+    select.add_input(then_src);
+    select.add_input(else_src);
+    select.add_output(select_dst);
+    relu.add_input(select_dst);
+    relu.add_output(relu_dst);
+    add.add_input(relu_dst);
+    add.add_input(add_src1);
+    add.add_output(add_dst);
+
+    graph_t agraph;
+    ASSERT_EQ(agraph.add_op(&select), status::success);
+    ASSERT_EQ(agraph.add_op(&relu), status::success);
+    ASSERT_EQ(agraph.add_op(&add), status::success);
+    agraph.finalize();
+
+    pass::pass_base_ptr apass = get_pass("select_post_ops_fusion_cpu");
+    apass->run(agraph);
+    ASSERT_EQ(agraph.get_num_partitions(), 1U);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_ops().size(), 3U);
+    ASSERT_EQ((agraph.get_partitions()[0])->get_kind(),
+            partition_kind_t::binary_post_ops);
+}
+
+TEST(Pass, FuseMaskedScores) {
+    /*  matmul
+          |
+        divide
+          |
+        select
+          |
+        softmax
+    */
+    op_t matmul {0, MatMul, "matmul"};
+    op_t div {1, Divide, "divide"};
+    op_t select {2, Select, "select"};
+    op_t softmax {3, SoftMax, "softmax"};
+    softmax.set_attr<int64_t>(op_attr::axis, -1);
+
+    logical_tensor_t src0 = logical_tensor_init(0, data_type::f32);
+    logical_tensor_t src1 = logical_tensor_init(1, data_type::f32);
+    logical_tensor_t matmul_dst = logical_tensor_init(2, data_type::f32);
+    logical_tensor_t scale = logical_tensor_init(3, data_type::f32);
+    logical_tensor_t div_dst = logical_tensor_init(4, data_type::f32);
+    logical_tensor_t mask = logical_tensor_init(5, data_type::u8);
+    logical_tensor_t masked_val = logical_tensor_init(6, data_type::f32);
+    logical_tensor_t select_dst = logical_tensor_init(7, data_type::f32);
+    logical_tensor_t softmax_dst = logical_tensor_init(8, data_type::f32);
+
+    matmul.add_input(src0);
+    matmul.add_input(src1);
+    matmul.add_output(matmul_dst);
+    div.add_input(matmul_dst);
+    div.add_input(scale);
+    div.add_output(div_dst);
+    select.add_input(mask);
+    select.add_input(div_dst);
+    select.add_input(masked_val);
+    select.add_output(select_dst);
+    softmax.add_input(select_dst);
+    softmax.add_output(softmax_dst);
+
+    graph_t agraph;
+    ASSERT_EQ(agraph.add_op(&matmul), status::success);
+    ASSERT_EQ(agraph.add_op(&div), status::success);
+    ASSERT_EQ(agraph.add_op(&select), status::success);
+    ASSERT_EQ(agraph.add_op(&softmax), status::success);
+    agraph.finalize();
+
+    pass::pass_base_ptr apass = get_pass("masked_scores_fusion_cpu");
+    apass->run(agraph);
+    ASSERT_EQ(agraph.get_num_partitions(), 1U);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_ops().size(), 4U);
+    ASSERT_EQ((agraph.get_partitions()[0])->get_kind(),
+            partition_kind_t::misc_post_ops);
+}
+
+TEST(Pass, FuseGatherPostOps) {
+    /*  gather
+          |
+         add
+          |
+       layernorm
+    */
+    for (bool with_lnorm : {false, true}) {
+        op_t gather {0, Gather, "gather"};
+        gather.set_attr<int64_t>(op_attr::axis, 0);
+        op_t add {1, Add, "add"};
+        op_t lnorm {2, LayerNorm, "layernorm"};
+        lnorm.set_attr<bool>(op_attr::keep_stats, false);
+
+        logical_tensor_t table = logical_tensor_init(0, data_type::f32);
+        logical_tensor_t indices = logical_tensor_init(1, data_type::s32);
+        logical_tensor_t gather_dst = logical_tensor_init(2, data_type::f32);
+        logical_tensor_t add_src1 = logical_tensor_init(3, data_type::f32);
+        logical_tensor_t add_dst = logical_tensor_init(4, data_type::f32);
+        logical_tensor_t lnorm_dst = logical_tensor_init(5, data_type::f32);
+
+        gather.add_input(table);
+        gather.add_input(indices);
+        gather.add_output(gather_dst);
+        add.add_input(gather_dst);
+        add.add_input(add_src1);
+        add.add_output(add_dst);
+        lnorm.add_input(add_dst);
+        lnorm.add_output(lnorm_dst);
+
+        graph_t agraph;
+        ASSERT_EQ(agraph.add_op(&gather), status::success);
+        ASSERT_EQ(agraph.add_op(&add), status::success);
+        if (with_lnorm) {
+            ASSERT_EQ(agraph.add_op(&lnorm), status::success);
+        }
+        agraph.finalize();
+
+        pass::pass_base_ptr apass = get_pass("gather_post_ops_fusion_cpu");
+        apass->run(agraph);
+        ASSERT_EQ(agraph.get_num_partitions(), 1U);
+        ASSERT_EQ(agraph.get_partitions()[0]->get_ops().size(),
+                with_lnorm ? 3U : 2U);
+        ASSERT_EQ((agraph.get_partitions()[0])->get_kind(),
+                partition_kind_t::misc_post_ops);
+    }
+}
+
+TEST(Pass, FuseRmsNorm) {
+    /*       x
+           / |
+         pow |
+          |  |
+        mean |
+          |  |
+         add |
+          |  |
+    [sqrt, divide] or [pow, multiply]
+          |
+      [multiply]
+    */
+    for (bool with_rsqrt : {false, true})
+        for (bool with_gamma : {false, true}) {
+            op_t square {0, Pow, "square"};
+            square.set_attr<float>(op_attr::beta, 2.f);
+            op_t mean {1, ReduceMean, "mean"};
+            mean.set_attr<std::vector<int64_t>>(op_attr::axes, {-1});
+            mean.set_attr<bool>(op_attr::keep_dims, true);
+            op_t add {2, Add, "add_eps"};
+            op_t sqrt {3, Sqrt, "sqrt"};
+            op_t div {4, Divide, "divide"};
+            op_t rsqrt {3, Pow, "rsqrt"};
+            rsqrt.set_attr<float>(op_attr::beta, -0.5f);
+            op_t mul {4, Multiply, "multiply"};
+            op_t gamma {5, Multiply, "gamma"};
+
+            logical_tensor_t x = logical_tensor_init(0, data_type::f32);
+            logical_tensor_t square_dst
+                    = logical_tensor_init(1, data_type::f32);
+            logical_tensor_t mean_dst = logical_tensor_init(2, data_type::f32);
+            logical_tensor_t eps = logical_tensor_init(3, data_type::f32);
+            logical_tensor_t add_dst = logical_tensor_init(4, data_type::f32);
+            logical_tensor_t inv_dst = logical_tensor_init(5, data_type::f32);
+            logical_tensor_t norm_dst = logical_tensor_init(6, data_type::f32);
+            logical_tensor_t gamma_src = logical_tensor_init(7, data_type::f32);
+            logical_tensor_t gamma_dst = logical_tensor_init(8, data_type::f32);
+
+            square.add_input(x);
+            square.add_output(square_dst);
+            mean.add_input(square_dst);
+            mean.add_output(mean_dst);
+            add.add_input(mean_dst);
+            add.add_input(eps);
+            add.add_output(add_dst);
+            op_t &inv = with_rsqrt ? rsqrt : sqrt;
+            op_t &norm = with_rsqrt ? mul : div;
+            inv.add_input(add_dst);
+            inv.add_output(inv_dst);
+            norm.add_input(x);
+            norm.add_input(inv_dst);
+            norm.add_output(norm_dst);
+            gamma.add_input(norm_dst);
+            gamma.add_input(gamma_src);
+            gamma.add_output(gamma_dst);
+
+            graph_t agraph;
+            ASSERT_EQ(agraph.add_op(&square), status::success);
+            ASSERT_EQ(agraph.add_op(&mean), status::success);
+            ASSERT_EQ(agraph.add_op(&add), status::success);
+            ASSERT_EQ(agraph.add_op(&inv), status::success);
+            ASSERT_EQ(agraph.add_op(&norm), status::success);
+            if (with_gamma) {
+                ASSERT_EQ(agraph.add_op(&gamma), status::success);
+            }
+            agraph.finalize();
+
+            pass::pass_base_ptr apass
+                    = get_pass("rms_norm_subgraph_fusion_cpu");
+            apass->run(agraph);
+            ASSERT_EQ(agraph.get_num_partitions(), 1U);
+            ASSERT_EQ(agraph.get_partitions()[0]->get_ops().size(),
+                    with_gamma ? 6U : 5U);
+            ASSERT_EQ((agraph.get_partitions()[0])->get_kind(),
+                    partition_kind_t::misc_post_ops);
+        }
+}
+
 TEST(Pass, FuseReduceAdd) {
     /* reduce
           |
@@ -15143,3 +15381,74 @@ TEST(Pass, Pool3Postops) {
             ASSERT_EQ(partition->get_outputs()[k].id, output_lts[k]);
     }
 }
+
+// A partitioning benchmark on a synthetic graph of chained MatMul + Add + ReLU
+// + SoftMax blocks. It reports the partitioning time and checks that every op
+// is assigned to a partition. The number of blocks can be set with the
+// internal env var _ONEDNN_GRAPH_PARTITION_BENCH_BLOCKS. It is disabled by
+// default, run it with --gtest_also_run_disabled_tests.
+TEST(PassPerf, DISABLED_PartitionLargeSyntheticGraph) {
+    const size_t num_blocks = static_cast<size_t>(std::max(1,
+            dnnl::impl::graph::utils::getenv_int_internal(
+                    "PARTITION_BENCH_BLOCKS", 1000)));
+    const dims src_shape {16, 64};
+    const dims wei_shape {64, 64};
+    const dims bias_shape {1, 64};
+
+    graph_t agraph;
+    id_generator id_gen;
+    logical_tensor_t src
+            = logical_tensor_init(id_gen.get_id(), src_shape, data_type::f32);
+    for (size_t i = 0; i < num_blocks; i++) {
+        op_t matmul {id_gen.get_id(), MatMul, "matmul"};
+        op_t add {id_gen.get_id(), Add, "add"};
+        op_t relu {id_gen.get_id(), ReLU, "relu"};
+        op_t softmax {id_gen.get_id(), SoftMax, "softmax"};
+        softmax.set_attr<int64_t>(op_attr::axis, 1);
+
+        logical_tensor_t wei = logical_tensor_init(
+                id_gen.get_id(), wei_shape, data_type::f32);
+        logical_tensor_t bias = logical_tensor_init(
+                id_gen.get_id(), bias_shape, data_type::f32);
+        logical_tensor_t matmul_dst = logical_tensor_init(
+                id_gen.get_id(), src_shape, data_type::f32);
+        logical_tensor_t add_dst = logical_tensor_init(
+                id_gen.get_id(), src_shape, data_type::f32);
+        logical_tensor_t relu_dst = logical_tensor_init(
+                id_gen.get_id(), src_shape, data_type::f32);
+        logical_tensor_t softmax_dst = logical_tensor_init(
+                id_gen.get_id(), src_shape, data_type::f32);
+
+        matmul.add_input(src);
+        matmul.add_input(wei);
+        matmul.add_output(matmul_dst);
+        add.add_input(matmul_dst);
+        add.add_input(bias);
+        add.add_output(add_dst);
+        relu.add_input(add_dst);
+        relu.add_output(relu_dst);
+        softmax.add_input(relu_dst);
+        softmax.add_output(softmax_dst);
+
+        ASSERT_EQ(agraph.add_op(&matmul), status::success);
+        ASSERT_EQ(agraph.add_op(&add), status::success);
+        ASSERT_EQ(agraph.add_op(&relu), status::success);
+        ASSERT_EQ(agraph.add_op(&softmax), status::success);
+        src = softmax_dst;
+    }
+    agraph.finalize();
+
+    auto &backend_ptr = dnnl_impl::dnnl_backend::get_singleton();
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(backend_ptr.get_partitions(agraph, partition_policy::fusion),
+            status::success);
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    printf("[ PERF     ] partitioned %zu ops into %zu partitions in %.2f ms\n",
+            agraph.num_ops(), agraph.get_num_partitions(), ms);
+
+    size_t num_partitioned_ops = 0;
+    for (const auto &part : agraph.get_partitions())
+        num_partitioned_ops += part->get_ops().size();
+    ASSERT_EQ(num_partitioned_ops, agraph.num_ops());
+}
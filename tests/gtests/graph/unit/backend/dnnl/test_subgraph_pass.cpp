@@ -1150,6 +1150,71 @@ TEST(SubgraphPass, MemoryPlanning) {
     ASSERT_TRUE(mem_offkeys.empty());
 }
 
+TEST(SubgraphPass, MemoryPlanningWithLevelExecution) {
+    /*
+                  / -> mul_scales (op2) -> mul_scales (op4)
+    mul_scales (op1)
+                  \ -> mul_scales (op3) -> mul_scales (op5)
+    */
+    graph::engine_t *g_eng = get_engine();
+    dnnl::engine p_eng = dnnl::impl::graph::dnnl_impl::make_dnnl_engine(*g_eng);
+
+    std::vector<int64_t> shape {8, 32, 16, 16};
+
+    graph::op_t op1(1, dnnl_impl::op_kind::dnnl_mul_scales, "op1");
+    graph::op_t op2(2, dnnl_impl::op_kind::dnnl_mul_scales, "op2");
+    graph::op_t op3(3, dnnl_impl::op_kind::dnnl_mul_scales, "op3");
+    graph::op_t op4(4, dnnl_impl::op_kind::dnnl_mul_scales, "op4");
+    graph::op_t op5(5, dnnl_impl::op_kind::dnnl_mul_scales, "op5");
+
+    std::vector<logical_tensor_t> vals;
+    for (size_t i = 0; i < 6; i++) {
+        vals.emplace_back(
+                logical_tensor_init(i, shape, graph::data_type::f32));
+    }
+
+    graph::graph_t g;
+    for (auto *op : {&op1, &op2, &op3, &op4, &op5}) {
+        op->set_attr<std::vector<float>>(op_attr::scales, {0.5});
+        // op1: val0 -> val1, op2: val1 -> val2, op3: val1 -> val3,
+        // op4: val2 -> val4, op5: val3 -> val5
+        const size_t id = op->get_id();
+        op->add_input(vals[id == 1 ? 0 : (id <= 3 ? 1 : id - 2)]);
+        op->add_output(vals[id]);
+        g.add_op(op);
+    }
+    g.finalize();
+
+    auto subgraph = std::make_shared<dnnl_impl::subgraph_t>(
+            g.get_ops(), p_eng, /* reset_layout */ false);
+    ASSERT_EQ(subgraph->get_ops().size(), 5U);
+
+    std::vector<logical_tensor_t> inputs = {vals[0]};
+    std::vector<logical_tensor_t> outputs = {vals[4], vals[5]};
+    dnnl_impl::set_given_inputs_outputs(subgraph, inputs, outputs);
+
+    const auto levels = dnnl_impl::get_op_levels(subgraph);
+    std::vector<const graph::value_t *> values(vals.size(), nullptr);
+    for (const auto &op : subgraph->get_ops()) {
+        const size_t id = op->get_id();
+        ASSERT_EQ(levels.at(op.get()), id == 1 ? 0U : (id <= 3 ? 1U : 2U));
+        for (const auto &val : op->get_output_values()) {
+            values[val->get_logical_tensor().id] = val.get();
+        }
+    }
+
+    dnnl_impl::memory_planner_t memory_planner;
+    memory_planner.set_level_execution(true);
+    ASSERT_EQ(memory_planner.run(subgraph), graph::status::success);
+
+    // op2 and op3 run concurrently, so their outputs can't share a buffer
+    const auto info2 = memory_planner.get_memory_info(values[2]);
+    const auto info3 = memory_planner.get_memory_info(values[3]);
+    ASSERT_EQ(info2.find("temporary_"), 0U);
+    ASSERT_EQ(info3.find("temporary_"), 0U);
+    ASSERT_NE(info2, info3);
+}
+
 TEST(SubgraphPass, FusePostOpsForConvDepthwise) {
     /*   conv
           |
@@ -1273,6 +1338,305 @@ TEST(SubgraphPass, FuseSigmoidMultiplyToSwish) {
             dnnl::algorithm::eltwise_swish);
 }
 
+TEST(SubgraphPass, FuseToSdpa) {
+    graph::engine_t *g_eng = get_engine();
+    SKIP_IF(g_eng->kind() == graph::engine_kind::gpu, "skip on gpu");
+    dnnl::engine p_eng = dnnl::impl::graph::dnnl_impl::make_dnnl_engine(*g_eng);
+
+    // 2 key and value heads (MHA) or 1 shared by all query heads (MQA), with
+    // an additive mask or a select mask
+    for (int num_kv_head : {2, 1}) {
+        for (bool select_mask : {false, true}) {
+            graph::graph_t g;
+            construct_f32_MHA(&g, 1, 32, 2, 32, num_kv_head, select_mask);
+            g.finalize();
+
+            graph::pass::pass_base_ptr apass = get_pass("f32_MHA_fusion");
+            apass->run(g);
+            ASSERT_EQ(g.get_num_partitions(), 1U);
+            auto part = g.get_partitions()[0];
+
+            auto subgraph = std::make_shared<dnnl_impl::subgraph_t>(
+                    part->get_ops(), p_eng);
+            dnnl_impl::pass_pipeline_t pipeline(
+                    dnnl_impl::subgraph_visualizer_t(), true, false);
+            dnnl_impl::larger_partition_kernel_t::setup_pipeline_stage1(
+                    pipeline);
+            ASSERT_EQ(pipeline.run(subgraph), graph::status::success);
+
+            // matmul -> div -> add|select -> softmax -> matmul is fused into
+            // one op, a select mask also passes its fill value
+            size_t num_sdpa = 0;
+            for (const auto &op : subgraph->get_ops()) {
+                ASSERT_NE(op->get_kind(), dnnl_impl::op_kind::dnnl_softmax);
+                ASSERT_NE(op->get_kind(), dnnl_impl::op_kind::dnnl_matmul);
+                ASSERT_NE(op->get_kind(), dnnl_impl::op_kind::dnnl_binary);
+                if (op->get_kind() != dnnl_impl::op_kind::dnnl_sdpa) continue;
+                num_sdpa++;
+                ASSERT_EQ(op->num_inputs(), select_mask ? 6U : 5U);
+                ASSERT_TRUE(op->get_attr<bool>(dnnl_impl::op_attr::with_scale));
+                ASSERT_TRUE(op->get_attr<bool>(dnnl_impl::op_attr::with_mask));
+                ASSERT_EQ(op->get_attr<bool>(dnnl_impl::op_attr::with_select),
+                        select_mask);
+                ASSERT_FALSE(op->get_attr<bool>(
+                        dnnl_impl::op_attr::select_scores_in_else));
+                ASSERT_EQ(static_cast<dnnl::algorithm>(op->get_attr<int64_t>(
+                                  dnnl_impl::op_attr::alg_kind)),
+                        dnnl::algorithm::binary_div);
+            }
+            ASSERT_EQ(num_sdpa, 1U);
+        }
+    }
+}
+
+TEST(SubgraphPass, FuseToMaskedSoftmax) {
+    graph::engine_t *g_eng = get_engine();
+    SKIP_IF(g_eng->kind() == graph::engine_kind::gpu, "skip on gpu");
+    dnnl::engine p_eng = dnnl::impl::graph::dnnl_impl::make_dnnl_engine(*g_eng);
+
+    const graph::data_type_t dt = graph::data_type::f32;
+    logical_tensor_t query = logical_tensor_init(0, {1, 2, 8, 16}, dt);
+    logical_tensor_t key = logical_tensor_init(1, {1, 2, 16, 8}, dt);
+    logical_tensor_t mm_dst = logical_tensor_init(2, {1, 2, 8, 8}, dt);
+    logical_tensor_t cond
+            = logical_tensor_init(3, {1, 1, 8, 8}, graph::data_type::u8);
+    logical_tensor_t fill
+            = logical_tensor_init(4, std::vector<graph::dim_t> {1}, dt);
+    logical_tensor_t select_dst = logical_tensor_init(5, {1, 2, 8, 8}, dt);
+    logical_tensor_t dst = logical_tensor_init(6, {1, 2, 8, 8}, dt);
+
+    graph::op_t matmul {0, graph::op_kind::MatMul, "matmul"};
+    matmul.add_input(query);
+    matmul.add_input(key);
+    matmul.add_output(mm_dst);
+    graph::op_t select {1, graph::op_kind::Select, "select"};
+    select.add_input(cond);
+    select.add_input(mm_dst);
+    select.add_input(fill);
+    select.add_output(select_dst);
+    graph::op_t softmax {2, graph::op_kind::SoftMax, "softmax"};
+    softmax.set_attr<int64_t>(graph::op_attr::axis, -1);
+    softmax.add_input(select_dst);
+    softmax.add_output(dst);
+
+    graph::graph_t g;
+    g.add_op(&matmul);
+    g.add_op(&select);
+    g.add_op(&softmax);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("masked_scores_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    auto subgraph = std::make_shared<dnnl_impl::subgraph_t>(
+            part->get_ops(), p_eng);
+    dnnl_impl::pass_pipeline_t pipeline(
+            dnnl_impl::subgraph_visualizer_t(), true, false);
+    dnnl_impl::larger_partition_kernel_t::setup_pipeline_stage1(pipeline);
+    ASSERT_EQ(pipeline.run(subgraph), graph::status::success);
+
+    // select -> softmax is fused into one op with the scores, cond and fill
+    // as inputs, the matmul is kept
+    ASSERT_EQ(subgraph->num_ops(), 2U);
+    const auto &fused = subgraph->get_ops()[1]->get_kind()
+                    == dnnl_impl::op_kind::dnnl_masked_softmax
+            ? subgraph->get_ops()[1]
+            : subgraph->get_ops()[0];
+    ASSERT_EQ(fused->get_kind(), dnnl_impl::op_kind::dnnl_masked_softmax);
+    ASSERT_EQ(fused->num_inputs(), 3U);
+    ASSERT_EQ(fused->get_input_value(1)->get_logical_tensor().id, cond.id);
+    ASSERT_EQ(fused->get_input_value(2)->get_logical_tensor().id, fill.id);
+    ASSERT_FALSE(
+            fused->get_attr<bool>(dnnl_impl::op_attr::select_scores_in_else));
+}
+
+TEST(SubgraphPass, FuseToGatedMlp) {
+    /*
+         / -> matmul (w) -> sigmoid -> multiply \
+    src  ------------------------------------> multiply -> matmul (w_down)
+         \ -> matmul (w_up) ------------------/
+    */
+    graph::engine_t *g_eng = get_engine();
+    SKIP_IF(g_eng->kind() == graph::engine_kind::gpu, "skip on gpu");
+    dnnl::engine p_eng = dnnl::impl::graph::dnnl_impl::make_dnnl_engine(*g_eng);
+
+    const graph::data_type_t dt = graph::data_type::f32;
+    logical_tensor_t src = logical_tensor_init(0, {2, 3, 16}, dt);
+    logical_tensor_t wei = logical_tensor_init(1, {16, 32}, dt);
+    logical_tensor_t bias = logical_tensor_init(2, {32}, dt);
+    logical_tensor_t wei_up = logical_tensor_init(3, {16, 32}, dt);
+    logical_tensor_t bias_up = logical_tensor_init(4, {32}, dt);
+    logical_tensor_t wei_down = logical_tensor_init(5, {32, 16}, dt);
+    logical_tensor_t bias_down = logical_tensor_init(6, {16}, dt);
+    logical_tensor_t mm_dst = logical_tensor_init(7, {2, 3, 32}, dt);
+    logical_tensor_t sigmoid_dst = logical_tensor_init(8, {2, 3, 32}, dt);
+    logical_tensor_t swish_dst = logical_tensor_init(9, {2, 3, 32}, dt);
+    logical_tensor_t mm_up_dst = logical_tensor_init(10, {2, 3, 32}, dt);
+    logical_tensor_t gate_dst = logical_tensor_init(11, {2, 3, 32}, dt);
+    logical_tensor_t dst = logical_tensor_init(12, {2, 3, 16}, dt);
+
+    graph::op_t matmul {0, graph::op_kind::MatMul, "matmul"};
+    matmul.add_input(src);
+    matmul.add_input(wei);
+    matmul.add_input(bias);
+    matmul.add_output(mm_dst);
+    graph::op_t sigmoid {1, graph::op_kind::Sigmoid, "sigmoid"};
+    sigmoid.add_input(mm_dst);
+    sigmoid.add_output(sigmoid_dst);
+    graph::op_t swish {2, graph::op_kind::Multiply, "swish"};
+    swish.add_input(mm_dst);
+    swish.add_input(sigmoid_dst);
+    swish.add_output(swish_dst);
+    graph::op_t matmul_up {3, graph::op_kind::MatMul, "matmul_up"};
+    matmul_up.add_input(src);
+    matmul_up.add_input(wei_up);
+    matmul_up.add_input(bias_up);
+    matmul_up.add_output(mm_up_dst);
+    graph::op_t gate {4, graph::op_kind::Multiply, "gate"};
+    gate.add_input(swish_dst);
+    gate.add_input(mm_up_dst);
+    gate.add_output(gate_dst);
+    graph::op_t matmul_down {5, graph::op_kind::MatMul, "matmul_down"};
+    matmul_down.add_input(gate_dst);
+    matmul_down.add_input(wei_down);
+    matmul_down.add_input(bias_down);
+    matmul_down.add_output(dst);
+
+    graph::graph_t g;
+    for (auto *op : {&matmul, &sigmoid, &swish, &matmul_up, &gate,
+                 &matmul_down})
+        g.add_op(op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("f32_gated_mlp_swish_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+    ASSERT_EQ(part->get_ops().size(), 6U);
+
+    auto subgraph
+            = std::make_shared<dnnl_impl::subgraph_t>(part->get_ops(), p_eng);
+    dnnl_impl::pass_pipeline_t pipeline(
+            dnnl_impl::subgraph_visualizer_t(), true, false);
+    dnnl_impl::larger_partition_kernel_t::setup_pipeline_stage1(pipeline);
+    ASSERT_EQ(pipeline.run(subgraph), graph::status::success);
+
+    // the whole block is fused into one op which reads src once
+    ASSERT_EQ(subgraph->num_ops(), 1U);
+    const auto &mlp = subgraph->get_ops()[0];
+    ASSERT_EQ(mlp->get_kind(), dnnl_impl::op_kind::dnnl_mlp);
+    ASSERT_EQ(mlp->num_inputs(), 7U);
+    ASSERT_TRUE(mlp->get_attr<bool>(dnnl_impl::op_attr::is_gated));
+    ASSERT_TRUE(mlp->get_attr<bool>(dnnl_impl::op_attr::with_bias));
+    ASSERT_EQ(static_cast<dnnl::algorithm>(
+                      mlp->get_attr<int64_t>(dnnl_impl::op_attr::alg_kind)),
+            dnnl::algorithm::eltwise_swish);
+    const std::vector<size_t> expected_ids {0, 1, 3, 5, 2, 4, 6};
+    for (size_t i = 0; i < expected_ids.size(); i++) {
+        ASSERT_EQ(mlp->get_input_value(i)->get_logical_tensor().id,
+                expected_ids[i]);
+    }
+    ASSERT_EQ(mlp->get_input_value(0)->get_consumers().size(), 1U);
+
+    ASSERT_EQ(dnnl_impl::infer_shape(subgraph), graph::status::success);
+    const auto &out_lt = mlp->get_output_value(0)->get_logical_tensor();
+    ASSERT_EQ(graph::logical_tensor_wrapper_t(out_lt).vdims(),
+            std::vector<int64_t>({2, 3, 16}));
+}
+
+TEST(SubgraphPass, FuseSiblingMatmuls) {
+    /*
+         / -> matmul (w1) -> mul_scales
+    src  -> matmul (w2) -> mul_scales
+         \ -> matmul (w3) -> mul_scales
+    */
+    graph::engine_t *g_eng = get_engine();
+    SKIP_IF(g_eng->kind() == graph::engine_kind::gpu, "skip on gpu");
+    dnnl::engine p_eng = dnnl::impl::graph::dnnl_impl::make_dnnl_engine(*g_eng);
+
+    const std::vector<int64_t> out_channels {8, 8, 4};
+    logical_tensor_t src
+            = logical_tensor_init(0, {2, 3, 16}, graph::data_type::f32);
+
+    std::vector<op_ptr> ops;
+    std::vector<logical_tensor_t> inputs {src}, outputs;
+    for (size_t i = 0; i < out_channels.size(); i++) {
+        const size_t id = 1 + 3 * i;
+        logical_tensor_t wei = logical_tensor_init(
+                id, {16, out_channels[i]}, graph::data_type::f32);
+        wei.property = graph::property_type::constant;
+        logical_tensor_t dst = logical_tensor_init(
+                id + 1, {2, 3, out_channels[i]}, graph::data_type::f32);
+        logical_tensor_t scaled = logical_tensor_init(
+                id + 2, {2, 3, out_channels[i]}, graph::data_type::f32);
+
+        auto matmul = std::make_shared<graph::op_t>(
+                10 + i, dnnl_impl::op_kind::dnnl_matmul, "matmul");
+        matmul->set_attr<bool>(op_attr::transpose_a, false);
+        matmul->set_attr<bool>(op_attr::transpose_b, false);
+        matmul->add_input(src);
+        matmul->add_input(wei);
+        matmul->add_output(dst);
+        auto mul_scales = std::make_shared<graph::op_t>(
+                20 + i, dnnl_impl::op_kind::dnnl_mul_scales, "mul_scales");
+        mul_scales->set_attr<std::vector<float>>(op_attr::scales, {0.5});
+        mul_scales->add_input(dst);
+        mul_scales->add_output(scaled);
+
+        ops.emplace_back(matmul);
+        ops.emplace_back(mul_scales);
+        inputs.emplace_back(wei);
+        outputs.emplace_back(scaled);
+    }
+
+    graph::graph_t g;
+    for (auto &op : ops)
+        g.add_op(op.get());
+    g.finalize();
+
+    auto subgraph = std::make_shared<dnnl_impl::subgraph_t>(
+            g.get_ops(), p_eng, /* reset_layout */ false);
+    dnnl_impl::set_given_inputs_outputs(subgraph, inputs, outputs);
+
+    ASSERT_EQ(dnnl_impl::fuse_sibling_matmuls(subgraph),
+            graph::status::success);
+    ASSERT_EQ(dnnl_impl::infer_shape(subgraph), graph::status::success);
+
+    using ltw = graph::logical_tensor_wrapper_t;
+    size_t num_matmul = 0, num_concat = 0, num_slice = 0;
+    int64_t total_size = 0;
+    for (const auto &op : subgraph->get_ops()) {
+        if (op->get_kind() == dnnl_impl::op_kind::dnnl_matmul) {
+            num_matmul++;
+            const auto &dst = op->get_output_value(0)->get_logical_tensor();
+            ASSERT_EQ(ltw(dst).vdims(), std::vector<int64_t>({2, 3, 20}));
+            ASSERT_EQ(op->get_input_value(1)->get_producer().get_kind(),
+                    dnnl_impl::op_kind::dnnl_concat);
+        } else if (op->get_kind() == dnnl_impl::op_kind::dnnl_concat) {
+            num_concat++;
+            ASSERT_EQ(op->num_inputs(), 3U);
+            ASSERT_EQ(op->get_attr<int64_t>(op_attr::axis), 1);
+        } else if (op->get_kind() == dnnl_impl::op_kind::dnnl_slice) {
+            num_slice++;
+            // the original matmul outputs are now the views
+            const auto &dst = op->get_output_value(0)->get_logical_tensor();
+            const int64_t size
+                    = op->get_attr<int64_t>(dnnl_impl::op_attr::slice_size);
+            ASSERT_EQ(out_channels[(dst.id - 2) / 3], size);
+            ASSERT_EQ(ltw(dst).vdims().back(), size);
+            ASSERT_EQ(op->get_attr<int64_t>(dnnl_impl::op_attr::slice_offset),
+                    total_size);
+            total_size += size;
+        }
+    }
+    ASSERT_EQ(num_matmul, 1U);
+    ASSERT_EQ(num_concat, 1U);
+    ASSERT_EQ(num_slice, 3U);
+    ASSERT_EQ(total_size, 20);
+}
+
 TEST(TestInt8MatmulPassesWithDiffInputs, X8X8BF16MatmulScaleAddPasses) {
     /*
         | (u8/s8)  | (u8/s8)
@@ -1808,3 +2172,66 @@ TEST(SubgraphPass, CheckUndefinedOpAttribute) {
     dnnl_impl::subgraph_validator_t validator;
     ASSERT_EQ(validator.run(subgraph), status::invalid_graph_op);
 }
+
+TEST(SubgraphPass, LayoutAssignment) {
+    /*
+    src -> matmul (w1) -> matmul (w2) -> dst
+    */
+    graph::engine_t *g_eng = get_engine();
+    dnnl::engine p_eng = dnnl::impl::graph::dnnl_impl::make_dnnl_engine(*g_eng);
+
+    const graph::data_type_t dt = graph::data_type::f32;
+    logical_tensor_t src = logical_tensor_init(0, {64, 32}, dt);
+    logical_tensor_t wei1 = logical_tensor_init(1, {32, 48}, dt);
+    logical_tensor_t mid = logical_tensor_init(2, {64, 48}, dt);
+    logical_tensor_t wei2 = logical_tensor_init(3, {48, 16}, dt);
+    logical_tensor_t dst = logical_tensor_init(4, {64, 16}, dt);
+
+    std::vector<op_ptr> ops;
+    for (size_t i = 0; i < 2; i++) {
+        auto matmul = std::make_shared<graph::op_t>(
+                i, dnnl_impl::op_kind::dnnl_matmul, "matmul");
+        matmul->set_attr<bool>(op_attr::transpose_a, false);
+        matmul->set_attr<bool>(op_attr::transpose_b, false);
+        matmul->add_input(i == 0 ? src : mid);
+        matmul->add_input(i == 0 ? wei1 : wei2);
+        matmul->add_output(i == 0 ? mid : dst);
+        ops.emplace_back(matmul);
+    }
+
+    graph::graph_t g;
+    for (auto &op : ops)
+        g.add_op(op.get());
+    g.finalize();
+
+    auto subgraph = std::make_shared<dnnl_impl::subgraph_t>(
+            g.get_ops(), p_eng, /* reset_layout */ false);
+    dnnl_impl::set_given_inputs_outputs(subgraph, {src, wei1, wei2}, {dst});
+
+    ASSERT_EQ(dnnl_impl::infer_shape(subgraph), graph::status::success);
+    ASSERT_EQ(dnnl_impl::layout_assignment(subgraph), graph::status::success);
+
+    // the chosen layout is recorded together with the attribute which makes
+    // the layout propagation use it
+    for (const auto &op : subgraph->get_ops()) {
+        if (op->get_kind() != dnnl_impl::op_kind::dnnl_matmul
+                || !op->has_attr(dnnl_impl::op_attr::layout_plan))
+            continue;
+        const auto plan
+                = op->get_attr<std::string>(dnnl_impl::op_attr::layout_plan);
+        ASSERT_FALSE(plan.empty());
+        const bool use_plain
+                = op->get_attr<bool>(dnnl_impl::op_attr::use_plain_layout);
+        ASSERT_EQ(plan.find(use_plain ? "plain:" : "any:"), 0U);
+    }
+
+    ASSERT_EQ(dnnl_impl::layout_propagation(subgraph), graph::status::success);
+    for (const auto &op : subgraph->get_ops()) {
+        if (op->get_kind() != dnnl_impl::op_kind::dnnl_matmul
+                || !op->has_attr(dnnl_impl::op_attr::use_plain_layout)
+                || !op->get_attr<bool>(dnnl_impl::op_attr::use_plain_layout))
+            continue;
+        const auto &lt = op->get_output_value(0)->get_logical_tensor();
+        ASSERT_TRUE(graph::logical_tensor_wrapper_t(lt).is_strided());
+    }
+}
@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include <memory>
+#include <unordered_set>
 
 #include "gtest/gtest.h"
 
@@ -2321,3 +2322,46 @@ TEST(PatternMatcherV2, RepetitionOportExternalOutput) {
     EXPECT_TRUE(match_pattern(agraph.get_ops()[0].get(), graphp, fusion_ops));
     EXPECT_EQ(fusion_ops.size(), 5U);
 }
+
+TEST(PatternMatcherV2, GetStartOpKinds) {
+    // single op kind
+    auto pgraph0 = std::make_shared<pb_graph_t>("pgraph0");
+    auto pconv = pgraph0->append_op(Convolution, "pconv");
+    pgraph0->append_op(ReLU, {in_edge(IN0, pconv, OUT0)}, "prelu");
+    std::unordered_set<op_kind_t> kinds;
+    ASSERT_TRUE(pgraph0->get_start_op_kinds(kinds));
+    ASSERT_EQ(kinds, std::unordered_set<op_kind_t>({Convolution}));
+
+    // alternation of op kinds and of graphs
+    auto pgraph1 = std::make_shared<pb_graph_t>("pgraph1");
+    pgraph1->append_alternation({MatMul, Convolution}, "palt");
+    kinds.clear();
+    ASSERT_TRUE(pgraph1->get_start_op_kinds(kinds));
+    ASSERT_EQ(kinds, std::unordered_set<op_kind_t>({MatMul, Convolution}));
+
+    auto alt0 = std::make_shared<pb_graph_t>("alt0");
+    auto padd = alt0->append_op(Add, "padd");
+    alt0->create_input_port(IN0, padd, IN0);
+    alt0->create_output_port(OUT0, padd, OUT0);
+    auto alt1 = std::make_shared<pb_graph_t>("alt1");
+    auto pmul = alt1->append_op(Multiply, "pmul");
+    alt1->create_input_port(IN0, pmul, IN0);
+    alt1->create_output_port(OUT0, pmul, OUT0);
+    auto pgraph2 = std::make_shared<pb_graph_t>("pgraph2");
+    pgraph2->append_alternation({alt0, alt1}, "palt");
+    kinds.clear();
+    ASSERT_TRUE(pgraph2->get_start_op_kinds(kinds));
+    ASSERT_EQ(kinds, std::unordered_set<op_kind_t>({Add, Multiply}));
+
+    // a match can start from any op after an optional or a wildcard
+    auto pgraph3 = std::make_shared<pb_graph_t>("pgraph3");
+    auto popt = pgraph3->append_optional(alt0, "popt");
+    pgraph3->append_op(ReLU, {in_edge(IN0, popt, OUT0)}, "prelu");
+    kinds.clear();
+    ASSERT_FALSE(pgraph3->get_start_op_kinds(kinds));
+
+    auto pgraph4 = std::make_shared<pb_graph_t>("pgraph4");
+    pgraph4->append_op(Wildcard, "pany");
+    kinds.clear();
+    ASSERT_FALSE(pgraph4->get_start_op_kinds(kinds));
+}
@@ -699,18 +699,27 @@ inline dnnl_dim_t product(const std::vector<int64_t> &dims) {
                                 (dnnl_dim_t)1, std::multiplies<dnnl_dim_t>());
 }
 
+// num_kv_head can be 1 for multi-query attention, where the key and value
+// heads are broadcast to all query heads by the matmuls. With select_mask the
+// scores are masked by a Select on a boolean mask instead of an Add.
 inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
         int batch_size = 1, int seq_len = 384, int num_head = 16,
-        int head_dim = 1024) {
+        int head_dim = 1024, int num_kv_head = -1, bool select_mask = false) {
     using namespace dnnl::impl::graph;
     using namespace dnnl::graph::tests;
 
     int size_per_head = head_dim / num_head;
+    if (num_kv_head < 0) num_kv_head = num_head;
     dims MIXED_LAYER_INPUT_SHAPE = {batch_size, seq_len, head_dim};
+    dims KV_INPUT_SHAPE = {batch_size, seq_len, num_kv_head * size_per_head};
+    dims KV_RESHAPED_SHAPE = {batch_size, seq_len, num_kv_head, size_per_head};
+    dims KV_TRANSPOSED_SHAPE
+            = {batch_size, num_kv_head, seq_len, size_per_head};
     dims EXTENDED_ATTENTION_MASK_SHAPE = {batch_size, 1, 1, seq_len};
     dims QKV_RESHAPED_SHAPE = {batch_size, seq_len, num_head, size_per_head};
     dims QKV_TRANSPOSED_SHAPE = {batch_size, num_head, seq_len, size_per_head};
-    dims KEY_TRANSPOSED_SHAPE = {batch_size, num_head, size_per_head, seq_len};
+    dims KEY_TRANSPOSED_SHAPE
+            = {batch_size, num_kv_head, size_per_head, seq_len};
     dims MATMUL_QK_OUTPUT_SHAPE = {batch_size, num_head, seq_len, seq_len};
     dims MATMUL_V_OUTPUT_SHAPE = {batch_size, num_head, seq_len, size_per_head};
 
@@ -724,9 +733,9 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
     auto query_gemm = unit::utils::logical_tensor_init(
             lt_id++, MIXED_LAYER_INPUT_SHAPE, data_type::f32);
     auto qk_bmm = unit::utils::logical_tensor_init(
-            lt_id++, MIXED_LAYER_INPUT_SHAPE, data_type::f32);
+            lt_id++, KV_INPUT_SHAPE, data_type::f32);
     auto value_bmm = unit::utils::logical_tensor_init(
-            lt_id++, MIXED_LAYER_INPUT_SHAPE, data_type::f32);
+            lt_id++, KV_INPUT_SHAPE, data_type::f32);
     auto attention_mask_flt = unit::utils::logical_tensor_init(
             lt_id++, EXTENDED_ATTENTION_MASK_SHAPE, data_type::f32);
 
@@ -736,9 +745,9 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
             lt_id++, QKV_TRANSPOSED_SHAPE, data_type::f32);
 
     auto key_reshape_out = unit::utils::logical_tensor_init(
-            lt_id++, QKV_RESHAPED_SHAPE, data_type::f32);
+            lt_id++, KV_RESHAPED_SHAPE, data_type::f32);
     auto key_transpose_out = unit::utils::logical_tensor_init(
-            lt_id++, QKV_TRANSPOSED_SHAPE, data_type::f32);
+            lt_id++, KV_TRANSPOSED_SHAPE, data_type::f32);
 
     auto key_transpose_out2 = unit::utils::logical_tensor_init(
             lt_id++, KEY_TRANSPOSED_SHAPE, data_type::f32);
@@ -758,9 +767,9 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
             lt_id++, MATMUL_QK_OUTPUT_SHAPE, data_type::f32);
 
     auto value_reshape_out = unit::utils::logical_tensor_init(
-            lt_id++, QKV_RESHAPED_SHAPE, data_type::f32);
+            lt_id++, KV_RESHAPED_SHAPE, data_type::f32);
     auto value_transpose_out = unit::utils::logical_tensor_init(
-            lt_id++, QKV_TRANSPOSED_SHAPE, data_type::f32);
+            lt_id++, KV_TRANSPOSED_SHAPE, data_type::f32);
 
     auto matmul_v_out = unit::utils::logical_tensor_init(
             lt_id++, MATMUL_V_OUTPUT_SHAPE, data_type::f32);
@@ -781,7 +790,7 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
     op_t key_reshape {2, op_kind::StaticReshape, "key_reshape"};
     key_reshape.set_attr(op_attr::special_zero, false);
     key_reshape.set_attr<std::vector<int64_t>>(
-            op_attr::shape, QKV_RESHAPED_SHAPE);
+            op_attr::shape, KV_RESHAPED_SHAPE);
 
     op_t key_transpose {3, op_kind::StaticTranspose, "key_transpose"};
     key_transpose.set_attr<std::vector<int64_t>>(
@@ -805,7 +814,7 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
     op_t value_reshape {15, op_kind::StaticReshape, "value_reshape"};
     value_reshape.set_attr(op_attr::special_zero, false);
     value_reshape.set_attr<std::vector<int64_t>>(
-            op_attr::shape, QKV_RESHAPED_SHAPE);
+            op_attr::shape, KV_RESHAPED_SHAPE);
 
     op_t value_transpose {16, op_kind::StaticTranspose, "value_transpose"};
     value_transpose.set_attr<std::vector<int64_t>>(
@@ -844,6 +853,17 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
     fscore_add.add_input(fscore_div_out);
     fscore_add.add_input(attention_mask_flt);
     fscore_add.add_output(fscore_add_out);
+
+    op_t fscore_select {11, op_kind::Select, "fscore_select"};
+    auto attention_mask_bool = unit::utils::logical_tensor_init(
+            lt_id++, EXTENDED_ATTENTION_MASK_SHAPE, data_type::u8);
+    auto fscore_masked_val = unit::utils::logical_tensor_init(
+            lt_id++, CONST_SHAPE, data_type::f32);
+    fscore_select.add_input(attention_mask_bool);
+    fscore_select.add_input(fscore_div_out);
+    fscore_select.add_input(fscore_masked_val);
+    fscore_select.add_output(fscore_add_out);
+
     softmax.add_input(fscore_add_out);
     softmax.add_output(softmax_out);
 
@@ -866,7 +886,7 @@ inline void construct_f32_MHA(dnnl::impl::graph::graph_t *agraph,
     agraph->add_op(&matmul_qk);
 
     agraph->add_op(&fscore_div);
-    agraph->add_op(&fscore_add);
+    agraph->add_op(select_mask ? &fscore_select : &fscore_add);
     agraph->add_op(&softmax);
     agraph->add_op(&value_reshape);
     agraph->add_op(&value_transpose);
@@ -466,4 +466,73 @@ INST_TEST_CASE(
         BatchNormalizationSimpleF16, all_cases, EXPAND_DTS(f16, f16, undef));
 INST_TEST_CASE(
         BatchNormalizationSimpleS8, all_cases, EXPAND_DTS(s8, s8, undef));
+
+// The Welford statistics must not depend on the number of threads the
+// runtime gives to the primitive, which is one inside an outer parallel
+// region.
+class bnorm_welford_nested_test_t : public ::testing::Test {};
+
+HANDLE_EXCEPTIONS_FOR_TEST(bnorm_welford_nested_test_t, TestInParallelRegion) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Welford statistics are supported on CPU only");
+    engine e {engine::kind::cpu, 0};
+
+    const memory::dim N = 4, C = 32, H = 8, W = 8;
+    const memory::desc data_md({N, C, H, W}, dt::f32, tag::nhwc);
+    auto pd = batch_normalization_forward::primitive_desc(e,
+            prop_kind::forward_training, data_md, data_md, 1e-5f,
+            normalization_flags::welford_stats);
+    batch_normalization_forward bnorm(pd);
+
+    auto src = test::make_memory(pd.src_desc(), e);
+    {
+        auto ptr = map_memory<float>(src);
+        for (memory::dim i = 0; i < N * H * W * C; i++)
+            ptr[i] = static_cast<float>((i * 7) % 13) + 100.f;
+    }
+
+    // reference statistics, src is nhwc
+    std::vector<double> ref_mean(C, 0.), ref_var(C, 0.);
+    {
+        auto ptr = map_memory<float>(src);
+        const memory::dim rows = N * H * W;
+        for_(memory::dim r = 0; r < rows; r++)
+        for (memory::dim c = 0; c < C; c++)
+            ref_mean[c] += ptr[r * C + c] / double(rows);
+        for_(memory::dim r = 0; r < rows; r++)
+        for (memory::dim c = 0; c < C; c++) {
+            const double d = ptr[r * C + c] - ref_mean[c];
+            ref_var[c] += d * d / double(rows);
+        }
+    }
+
+    const int nthr = 2;
+    std::vector<memory> dst(nthr), mean(nthr), var(nthr);
+    for (int i = 0; i < nthr; i++) {
+        dst[i] = test::make_memory(pd.dst_desc(), e);
+        mean[i] = test::make_memory(pd.mean_desc(), e);
+        var[i] = test::make_memory(pd.variance_desc(), e);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthr)
+#endif
+    for (int i = 0; i < nthr; i++) {
+        stream strm(e);
+        bnorm.execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst[i]},
+                        {DNNL_ARG_MEAN, mean[i]}, {DNNL_ARG_VARIANCE, var[i]}});
+        strm.wait();
+    }
+
+    for (int i = 0; i < nthr; i++) {
+        auto m = map_memory<float>(mean[i]);
+        auto v = map_memory<float>(var[i]);
+        for (memory::dim c = 0; c < C; c++) {
+            ASSERT_NEAR(m[c], ref_mean[c], 1e-4 * ref_mean[c]);
+            ASSERT_NEAR(v[c], ref_var[c], 1e-4 * ref_var[c] + 1e-6);
+        }
+    }
+}
+
 } // namespace dnnl
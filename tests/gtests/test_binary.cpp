@@ -276,6 +276,59 @@ INSTANTIATE_TEST_SUITE_P(BinaryTensorDims, binary_attr_test_t,
                         memory::dims {1, 1024, 1, 1},
                         memory::format_tag::abcd)));
 
+class binary_select_test_t : public ::testing::Test {};
+
+HANDLE_EXCEPTIONS_FOR_TEST(binary_select_test_t, TestSelect) {
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "Binary select is supported on CPU only");
+    engine e {engine_kind, 0};
+    auto strm = make_stream(e);
+
+    const memory::desc src_md {{2, 3}, data_type::f32, tag::ab};
+    const memory::desc cond_md {{2, 1}, data_type::u8, tag::ab};
+    const memory::desc dst_md {{2, 3}, data_type::f32, tag::ab};
+
+    // Select requires the condition, other algorithms must not take it.
+    EXPECT_ANY_THROW(binary::primitive_desc(
+            e, algorithm::binary_select, src_md, src_md, dst_md));
+    EXPECT_ANY_THROW(binary::primitive_desc(
+            e, algorithm::binary_add, src_md, src_md, cond_md, dst_md));
+
+    auto pd = binary::primitive_desc(
+            e, algorithm::binary_select, src_md, src_md, cond_md, dst_md);
+    ASSERT_TRUE(pd.src2_desc() == cond_md);
+    ASSERT_TRUE(
+            pd.query_md(query::exec_arg_md, DNNL_ARG_SRC_2) == pd.src2_desc());
+
+    auto mem_A = test::make_memory(src_md, e);
+    auto mem_B = test::make_memory(src_md, e);
+    auto mem_cond = test::make_memory(cond_md, e);
+    auto mem_C = test::make_memory(dst_md, e);
+    {
+        auto A = map_memory<float>(mem_A);
+        auto B = map_memory<float>(mem_B);
+        auto cond = map_memory<uint8_t>(mem_cond);
+        for (int i = 0; i < 6; i++) {
+            A[i] = static_cast<float>(i);
+            B[i] = static_cast<float>(-i);
+        }
+        cond[0] = 1;
+        cond[1] = 0;
+    }
+
+    binary(pd).execute(strm,
+            {{DNNL_ARG_SRC_0, mem_A}, {DNNL_ARG_SRC_1, mem_B},
+                    {DNNL_ARG_SRC_2, mem_cond}, {DNNL_ARG_DST, mem_C}});
+    strm.wait();
+
+    auto C = map_memory<float>(mem_C);
+    for (int i = 0; i < 6; i++) {
+        const float expected = i < 3 ? i : -i;
+        ASSERT_EQ(C[i], expected);
+    }
+}
+
 static auto expected_failures = []() {
     return ::testing::Values(
             // test tag::any support
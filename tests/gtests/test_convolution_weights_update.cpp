@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+// short names for brevity
+using data_type = memory::data_type;
+using tag = memory::format_tag;
+
+// Frameworks update weights in place between executions. The new values
+// have to be used even if an implementation repacks the weights internally,
+// e.g. grouped convolutions with few channels per group.
+class convolution_weights_update_test_t
+    : public ::testing::TestWithParam<prop_kind> {};
+
+TEST_P(convolution_weights_update_test_t, TestSmallGroups) {
+    engine eng = get_test_engine();
+    stream strm = make_stream(eng);
+
+    const memory::dim N = 2, G = 32, ICG = 4, OCG = 4, H = 8, W = 8;
+    const memory::desc src_md({N, G * ICG, H, W}, data_type::f32, tag::nhwc);
+    const memory::desc wei_md(
+            {G, OCG, ICG, 3, 3}, data_type::f32, tag::goihw);
+    const memory::desc dst_md({N, G * OCG, H, W}, data_type::f32, tag::nhwc);
+
+    convolution_forward::primitive_desc pd;
+    ASSERT_NO_THROW(pd = convolution_forward::primitive_desc(eng, GetParam(),
+                            algorithm::convolution_direct, src_md, wei_md,
+                            dst_md, {1, 1}, {1, 1}, {1, 1}));
+    convolution_forward conv(pd);
+
+    auto src = test::make_memory(src_md, eng);
+    auto wei = test::make_memory(wei_md, eng);
+    auto ref_wei = test::make_memory(wei_md, eng);
+    auto dst = test::make_memory(dst_md, eng);
+    auto ref_dst = test::make_memory(dst_md, eng);
+    const memory::dim wei_nelems = G * OCG * ICG * 3 * 3;
+    fill_data<float>(N * G * ICG * H * W, src);
+
+    auto execute = [&](const memory &w, const memory &d) {
+        conv.execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, w},
+                        {DNNL_ARG_DST, d}});
+        strm.wait();
+    };
+
+    fill_data<float>(wei_nelems, wei, 0.f, 0.5f);
+    execute(wei, dst);
+
+    // Update the weights under the same handle and compare against the
+    // result for the same values held by another memory object.
+    fill_data<float>(wei_nelems, wei, 1.f, 0.25f);
+    fill_data<float>(wei_nelems, ref_wei, 1.f, 0.25f);
+    execute(wei, dst);
+    execute(ref_wei, ref_dst);
+
+    compare_data<float>(ref_dst, dst);
+}
+
+INSTANTIATE_TEST_SUITE_P(TestConvolutionWeightsUpdate,
+        convolution_weights_update_test_t,
+        ::testing::Values(
+                prop_kind::forward_inference, prop_kind::forward_training));
+
+} // namespace dnnl
@@ -0,0 +1,241 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cfloat>
+#include <unordered_map>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+struct test_embedding_bag_params_t {
+    algorithm alg;
+    memory::data_type src_dt;
+    memory::dim rows;
+    memory::dim dim;
+    std::vector<int32_t> offsets;
+    memory::dim nindices;
+    bool with_weights;
+    int scales_mask; // -1 stands for no scales
+    bool bad_index; // the last index points past the table
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+class embedding_bag_test_t
+    : public ::testing::TestWithParam<test_embedding_bag_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+                "GPU engine does not support embedding bag.");
+        p = ::testing::TestWithParam<decltype(p)>::GetParam();
+        SKIP_IF(unsupported_data_type(p.src_dt),
+                "Engine does not support this data type.");
+        catch_expected_failures(
+                [=]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    void Test() {
+        eng = get_test_engine();
+        strm = make_stream(eng);
+
+        const memory::dim R = p.rows, D = p.dim, NI = p.nindices;
+        const memory::dim NB = (memory::dim)p.offsets.size();
+        const bool is_s8 = p.src_dt == memory::data_type::s8;
+        using dt = memory::data_type;
+        using tag = memory::format_tag;
+
+        const memory::desc src_md({R, D}, p.src_dt, tag::ab);
+        const memory::desc idx_md({NI}, dt::s32, tag::a);
+        const memory::desc off_md({NB}, dt::s32, tag::a);
+        const memory::desc wei_md = p.with_weights
+                ? memory::desc({NI}, dt::f32, tag::a)
+                : memory::desc();
+        const memory::desc dst_md({NB, D}, dt::f32, tag::any);
+
+        primitive_attr attr;
+        if (p.scales_mask >= 0)
+            attr.set_scales_mask(DNNL_ARG_SRC, p.scales_mask);
+
+        auto pd = embedding_bag::primitive_desc(
+                eng, p.alg, src_md, idx_md, off_md, wei_md, dst_md, attr);
+        // test construction from a C pd
+        pd = embedding_bag::primitive_desc(pd.get());
+
+        ASSERT_TRUE(pd.get_algorithm() == p.alg);
+        ASSERT_TRUE(pd.src_desc() == src_md);
+        ASSERT_TRUE(pd.indices_desc() == idx_md);
+        ASSERT_TRUE(pd.offsets_desc() == off_md);
+        const memory::dims dst_dims = {NB, D};
+        ASSERT_TRUE(pd.dst_desc().get_dims() == dst_dims);
+
+        std::vector<float> table(R * D), weights(NI), scales(R);
+        std::vector<int32_t> indices(NI);
+        for (memory::dim i = 0; i < R * D; i++)
+            table[i] = is_s8 ? (float)((i * 7) % 23 - 11)
+                             : ((i * 13) % 25 - 12) / 8.f;
+        for (memory::dim i = 0; i < NI; i++) {
+            indices[i] = (int32_t)((i * 5 + 3) % R);
+            weights[i] = 0.5f + (i % 4) / 4.f;
+        }
+        if (p.bad_index) indices[NI - 1] = (int32_t)R;
+        for (memory::dim r = 0; r < R; r++)
+            scales[r] = (r % 3 == 0 ? -1.f : 1.f) * (0.25f + (r % 5) / 8.f);
+
+        auto src_mem = test::make_memory(pd.src_desc(), eng);
+        auto idx_mem = test::make_memory(pd.indices_desc(), eng);
+        auto off_mem = test::make_memory(pd.offsets_desc(), eng);
+        auto dst_mem = test::make_memory(pd.dst_desc(), eng);
+        {
+            auto ptr = map_memory<int32_t>(idx_mem);
+            for (size_t i = 0; i < indices.size(); i++)
+                ptr[i] = indices[i];
+        }
+        {
+            auto ptr = map_memory<int32_t>(off_mem);
+            for (size_t i = 0; i < p.offsets.size(); i++)
+                ptr[i] = p.offsets[i];
+        }
+        if (is_s8) {
+            auto ptr = map_memory<int8_t>(src_mem);
+            for (memory::dim i = 0; i < R * D; i++)
+                ptr[i] = (int8_t)table[i];
+        } else if (p.src_dt == dt::bf16) {
+            // the f32 table values are exact in bf16
+            auto ptr = map_memory<bfloat16_t>(src_mem);
+            for (size_t i = 0; i < table.size(); i++)
+                ptr[i] = table[i];
+        } else {
+            auto ptr = map_memory<float>(src_mem);
+            for (size_t i = 0; i < table.size(); i++)
+                ptr[i] = table[i];
+        }
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, src_mem},
+                {DNNL_ARG_SRC_1, idx_mem}, {DNNL_ARG_SRC_2, off_mem},
+                {DNNL_ARG_DST, dst_mem}};
+        if (p.with_weights) {
+            auto wei_mem = test::make_memory(pd.weights_desc(), eng);
+            auto ptr = map_memory<float>(wei_mem);
+            for (size_t i = 0; i < weights.size(); i++)
+                ptr[i] = weights[i];
+            args.insert({DNNL_ARG_WEIGHTS, wei_mem});
+        }
+        if (p.scales_mask >= 0) {
+            const memory::dim n_scales = p.scales_mask == 1 ? R : 1;
+            auto sc_mem = test::make_memory(
+                    memory::desc({n_scales}, dt::f32, tag::x), eng);
+            auto ptr = map_memory<float>(sc_mem);
+            for (memory::dim i = 0; i < n_scales; i++)
+                ptr[i] = scales[i];
+            args.insert({DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, sc_mem});
+        }
+
+        embedding_bag(pd).execute(strm, args);
+        strm.wait();
+
+        auto dst = map_memory<float>(dst_mem);
+        for (memory::dim b = 0; b < NB; b++) {
+            const memory::dim beg = p.offsets[b];
+            const memory::dim end = b + 1 < NB ? p.offsets[b + 1] : NI;
+            for (memory::dim d = 0; d < D; d++) {
+                float ref = p.alg == algorithm::embedding_bag_max ? -FLT_MAX
+                                                                   : 0.f;
+                for (memory::dim i = beg; i < end; i++) {
+                    const memory::dim r = indices[i];
+                    float s = table[r * D + d];
+                    if (p.scales_mask >= 0)
+                        s *= scales[p.scales_mask == 1 ? r : 0];
+                    if (p.with_weights) s *= weights[i];
+                    ref = p.alg == algorithm::embedding_bag_max
+                            ? std::max(ref, s)
+                            : ref + s;
+                }
+                if (end == beg)
+                    ref = 0.f;
+                else if (p.alg == algorithm::embedding_bag_mean)
+                    ref /= (end - beg);
+                ASSERT_NEAR(dst[b * D + d], ref, 1e-4f)
+                        << "at bag " << b << " dim " << d;
+            }
+        }
+    }
+
+    test_embedding_bag_params_t p;
+    engine eng;
+    stream strm;
+};
+
+TEST_P(embedding_bag_test_t, TestsEmbeddingBag) {}
+
+#define EMB_TEST_CASE(alg, dt, ...) \
+    test_embedding_bag_params_t { \
+        algorithm::embedding_bag_##alg, memory::data_type::dt, __VA_ARGS__, \
+                false, false, dnnl_success \
+    }
+
+#define EMB_FAIL_CASE(alg, dt, ...) \
+    test_embedding_bag_params_t { \
+        algorithm::embedding_bag_##alg, memory::data_type::dt, __VA_ARGS__, \
+                false, true, dnnl_invalid_arguments \
+    }
+
+#define EMB_BAD_INDEX_CASE(alg, dt, ...) \
+    test_embedding_bag_params_t { \
+        algorithm::embedding_bag_##alg, memory::data_type::dt, __VA_ARGS__, \
+                true, true, dnnl_invalid_arguments \
+    }
+
+static auto cases = ::testing::Values(
+        // Invalid: per-sample weights are only defined for sum.
+        EMB_FAIL_CASE(mean, f32, 10, 16, {0, 2}, 4, true, -1),
+        EMB_FAIL_CASE(max, f32, 10, 16, {0, 2}, 4, true, -1),
+        // Invalid: offsets out of the indices range.
+        EMB_FAIL_CASE(sum, f32, 10, 16, {0, 5}, 4, false, -1),
+        // Invalid: an index out of the table, caught at execution.
+        EMB_BAD_INDEX_CASE(sum, f32, 10, 16, {0, 2}, 4, false, -1),
+        EMB_BAD_INDEX_CASE(max, f32, 50, 300, {0, 12, 30}, 64, false, -1),
+        EMB_BAD_INDEX_CASE(mean, bf16, 50, 64, {0, 1, 7}, 20, false, -1),
+        // f32 tables, rows shorter and longer than the accumulator block,
+        // with a vector tail and with empty bags.
+        EMB_TEST_CASE(sum, f32, 10, 16, {0, 2, 2, 5}, 8, false, -1),
+        EMB_TEST_CASE(sum, f32, 50, 13, {0, 3, 9}, 20, true, -1),
+        EMB_TEST_CASE(mean, f32, 50, 64, {0, 1, 7, 7}, 20, false, -1),
+        EMB_TEST_CASE(max, f32, 50, 37, {0, 6, 6, 11}, 20, false, -1),
+        EMB_TEST_CASE(sum, f32, 100, 300, {0, 12, 30}, 64, true, -1),
+        EMB_TEST_CASE(max, f32, 100, 300, {0, 12, 30}, 64, false, -1),
+        // bf16 tables.
+        EMB_TEST_CASE(sum, bf16, 10, 16, {0, 2, 2, 5}, 8, false, -1),
+        EMB_TEST_CASE(sum, bf16, 50, 13, {0, 3, 9}, 20, true, -1),
+        EMB_TEST_CASE(mean, bf16, 50, 64, {0, 1, 7, 7}, 20, false, -1),
+        EMB_TEST_CASE(max, bf16, 100, 300, {0, 12, 30}, 64, false, -1),
+        // Row-wise quantized tables.
+        EMB_TEST_CASE(sum, s8, 40, 32, {0, 4, 11}, 16, false, 1),
+        EMB_TEST_CASE(sum, s8, 40, 45, {0, 4, 11}, 16, true, 1),
+        EMB_TEST_CASE(mean, s8, 40, 24, {0, 4, 4, 11}, 16, false, 1),
+        EMB_TEST_CASE(max, s8, 40, 24, {0, 4, 11}, 16, false, 1),
+        EMB_TEST_CASE(mean, s8, 40, 24, {0, 4, 11}, 16, false, 0),
+        EMB_TEST_CASE(max, s8, 40, 24, {0, 4, 11}, 16, false, 0));
+
+INSTANTIATE_TEST_SUITE_P(TestEmbeddingBag, embedding_bag_test_t, cases);
+
+} // namespace dnnl
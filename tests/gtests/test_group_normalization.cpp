@@ -0,0 +1,251 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+static constexpr float epsilon = 1e-5f;
+
+struct test_gnorm_params_t {
+    memory::format_tag tag;
+    memory::dims dims; // N, C, H, W
+    memory::dim groups;
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+class gnorm_test_t : public ::testing::TestWithParam<test_gnorm_params_t> {
+protected:
+    void SetUp() override {
+        SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+                "GPU engine does not support group normalization.");
+        p = ::testing::TestWithParam<decltype(p)>::GetParam();
+        catch_expected_failures(
+                [=]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    // Moves plain nchw data into a memory object with an arbitrary layout
+    // and back, so the reference can always work on nchw.
+    void reorder_data(memory &from, memory &to) {
+        reorder(from, to).execute(strm, from, to);
+        strm.wait();
+    }
+
+    void fill_plain(std::vector<float> &v, int seed) {
+        for (size_t i = 0; i < v.size(); i++)
+            v[i] = ((int)((i * 13 + seed * 7) % 25) - 12) / 8.f;
+    }
+
+    void compute_ref_stats(const std::vector<float> &src,
+            std::vector<float> &mean, std::vector<float> &var) {
+        const memory::dim N = p.dims[0], C = p.dims[1];
+        const memory::dim SP = p.dims[2] * p.dims[3];
+        const memory::dim G = p.groups, CG = C / G;
+        for_(memory::dim n = 0; n < N; n++)
+        for (memory::dim g = 0; g < G; g++) {
+            double sum = 0, sum_sq = 0;
+            for_(memory::dim c = g * CG; c < (g + 1) * CG; c++)
+            for (memory::dim sp = 0; sp < SP; sp++) {
+                const float s = src[(n * C + c) * SP + sp];
+                sum += s;
+                sum_sq += s * s;
+            }
+            const double m = sum / (CG * SP);
+            mean[n * G + g] = (float)m;
+            var[n * G + g] = (float)(sum_sq / (CG * SP) - m * m);
+        }
+    }
+
+    void Test() {
+        eng = get_test_engine();
+        strm = make_stream(eng);
+
+        const memory::dim N = p.dims[0], C = p.dims[1];
+        const memory::dim SP = p.dims[2] * p.dims[3];
+        const memory::dim G = p.groups, CG = C / G;
+        const auto dt = memory::data_type::f32;
+
+        const memory::desc plain_md(p.dims, dt, memory::format_tag::nchw);
+        const memory::desc data_md(p.dims, dt, p.tag);
+        const memory::desc sc_md({C}, dt, memory::format_tag::x);
+
+        using flags = normalization_flags;
+        const auto fl = flags::use_scale | flags::use_shift;
+        auto fwd_pd = group_normalization_forward::primitive_desc(eng,
+                prop_kind::forward_training, data_md, data_md, G, epsilon, fl);
+        // test construction from a C pd
+        fwd_pd = group_normalization_forward::primitive_desc(fwd_pd.get());
+
+        ASSERT_EQ(fwd_pd.get_groups(), G);
+        ASSERT_EQ(fwd_pd.query_s64(query::num_groups_s64), G);
+        ASSERT_EQ(fwd_pd.get_epsilon(), epsilon);
+        ASSERT_TRUE(fwd_pd.get_flags() == fl);
+        ASSERT_TRUE(fwd_pd.src_desc() == data_md);
+        const memory::dims stat_dims = {N, G};
+        ASSERT_TRUE(fwd_pd.mean_desc().get_dims() == stat_dims);
+        ASSERT_TRUE(fwd_pd.variance_desc().get_dims() == stat_dims);
+
+        std::vector<float> src(N * C * SP), sc(C), sh(C);
+        fill_plain(src, 1);
+        for (memory::dim c = 0; c < C; c++) {
+            sc[c] = 1.f + (c % 3) / 4.f;
+            sh[c] = (c % 5 - 2) / 4.f;
+        }
+
+        auto plain_src = test::make_memory(plain_md, eng);
+        auto src_mem = test::make_memory(fwd_pd.src_desc(), eng);
+        auto dst_mem = test::make_memory(fwd_pd.dst_desc(), eng);
+        auto sc_mem = test::make_memory(sc_md, eng);
+        auto sh_mem = test::make_memory(sc_md, eng);
+        auto mean_mem = test::make_memory(fwd_pd.mean_desc(), eng);
+        auto var_mem = test::make_memory(fwd_pd.variance_desc(), eng);
+        auto ws_mem = test::make_memory(fwd_pd.workspace_desc(), eng);
+
+        write_vec(plain_src, src);
+        write_vec(sc_mem, sc);
+        write_vec(sh_mem, sh);
+        reorder_data(plain_src, src_mem);
+
+        group_normalization_forward(fwd_pd).execute(strm,
+                {{DNNL_ARG_SRC, src_mem}, {DNNL_ARG_DST, dst_mem},
+                        {DNNL_ARG_SCALE, sc_mem}, {DNNL_ARG_SHIFT, sh_mem},
+                        {DNNL_ARG_MEAN, mean_mem},
+                        {DNNL_ARG_VARIANCE, var_mem},
+                        {DNNL_ARG_WORKSPACE, ws_mem}});
+        strm.wait();
+
+        std::vector<float> ref_mean(N * G), ref_var(N * G);
+        compute_ref_stats(src, ref_mean, ref_var);
+
+        auto plain_dst = test::make_memory(plain_md, eng);
+        reorder_data(dst_mem, plain_dst);
+        const auto dst = read_vec(plain_dst, N * C * SP);
+        const auto mean = read_vec(mean_mem, N * G);
+        const auto var = read_vec(var_mem, N * G);
+
+        for (memory::dim i = 0; i < N * G; i++) {
+            ASSERT_NEAR(mean[i], ref_mean[i], 1e-5f);
+            ASSERT_NEAR(var[i], ref_var[i], 1e-4f);
+        }
+
+        for_(memory::dim n = 0; n < N; n++)
+        for_(memory::dim c = 0; c < C; c++)
+        for (memory::dim sp = 0; sp < SP; sp++) {
+            const memory::dim s_off = n * G + c / CG;
+            const memory::dim off = (n * C + c) * SP + sp;
+            const float rcp_denom
+                    = 1.f / std::sqrt(ref_var[s_off] + epsilon);
+            const float ref
+                    = sc[c] * (src[off] - ref_mean[s_off]) * rcp_denom
+                    + sh[c];
+            ASSERT_NEAR(dst[off], ref, 1e-4f) << "at " << off;
+        }
+
+        // Backward: with global statistics and no scale the result is a
+        // plain scaling of diff_dst, which is easy to verify exactly.
+        auto bwd_pd = group_normalization_backward::primitive_desc(eng,
+                prop_kind::backward_data, data_md, data_md, data_md, G,
+                epsilon, flags::use_global_stats, fwd_pd);
+        ASSERT_EQ(bwd_pd.get_groups(), G);
+
+        std::vector<float> ddst(N * C * SP);
+        fill_plain(ddst, 3);
+        auto plain_ddst = test::make_memory(plain_md, eng);
+        auto ddst_mem = test::make_memory(bwd_pd.diff_dst_desc(), eng);
+        auto dsrc_mem = test::make_memory(bwd_pd.diff_src_desc(), eng);
+        write_vec(plain_ddst, ddst);
+        reorder_data(plain_ddst, ddst_mem);
+
+        group_normalization_backward(bwd_pd).execute(strm,
+                {{DNNL_ARG_SRC, src_mem}, {DNNL_ARG_DIFF_DST, ddst_mem},
+                        {DNNL_ARG_MEAN, mean_mem},
+                        {DNNL_ARG_VARIANCE, var_mem},
+                        {DNNL_ARG_DIFF_SRC, dsrc_mem}});
+        strm.wait();
+
+        auto plain_dsrc = test::make_memory(plain_md, eng);
+        reorder_data(dsrc_mem, plain_dsrc);
+        const auto dsrc = read_vec(plain_dsrc, N * C * SP);
+        for_(memory::dim n = 0; n < N; n++)
+        for_(memory::dim c = 0; c < C; c++)
+        for (memory::dim sp = 0; sp < SP; sp++) {
+            const memory::dim s_off = n * G + c / CG;
+            const memory::dim off = (n * C + c) * SP + sp;
+            const float ref = ddst[off] / std::sqrt(var[s_off] + epsilon);
+            ASSERT_NEAR(dsrc[off], ref, 1e-5f) << "at " << off;
+        }
+    }
+
+    void write_vec(const memory &m, const std::vector<float> &v) {
+        auto ptr = map_memory<float>(m);
+        for (size_t i = 0; i < v.size(); i++)
+            ptr[i] = v[i];
+    }
+
+    std::vector<float> read_vec(const memory &m, memory::dim n) {
+        auto ptr = map_memory<float>(m);
+        std::vector<float> v(n);
+        for (memory::dim i = 0; i < n; i++)
+            v[i] = ptr[i];
+        return v;
+    }
+
+    test_gnorm_params_t p;
+    engine eng;
+    stream strm;
+};
+
+TEST_P(gnorm_test_t, TestsGnorm) {}
+
+#define EXPAND_FORMATS(tag) memory::format_tag::tag
+
+#define GNORM_TEST_CASE(tag, ...) \
+    test_gnorm_params_t { \
+        EXPAND_FORMATS(tag), __VA_ARGS__, false, dnnl_success \
+    }
+
+#define GNORM_FAIL_CASE(tag, ...) \
+    test_gnorm_params_t { \
+        EXPAND_FORMATS(tag), __VA_ARGS__, true, dnnl_invalid_arguments \
+    }
+
+static auto cases = ::testing::Values(
+        // Invalid: channels are not divisible by groups.
+        GNORM_FAIL_CASE(nchw, {2, 6, 3, 3}, 4),
+        GNORM_FAIL_CASE(nchw, {2, 6, 3, 3}, 0),
+        // Plain layouts.
+        GNORM_TEST_CASE(nchw, {2, 8, 5, 5}, 1),
+        GNORM_TEST_CASE(nchw, {2, 8, 5, 5}, 4),
+        GNORM_TEST_CASE(nchw, {3, 6, 7, 3}, 6),
+        GNORM_TEST_CASE(nhwc, {2, 8, 5, 5}, 2),
+        GNORM_TEST_CASE(nhwc, {2, 48, 3, 3}, 3),
+        GNORM_TEST_CASE(nhwc, {1, 20, 4, 1}, 5),
+        // Blocked layouts: groups aligned and not aligned to the block.
+        GNORM_TEST_CASE(nChw16c, {2, 64, 4, 4}, 4),
+        GNORM_TEST_CASE(nChw16c, {2, 32, 3, 5}, 8),
+        GNORM_TEST_CASE(nChw8c, {2, 32, 5, 5}, 4),
+        GNORM_TEST_CASE(nChw8c, {1, 24, 2, 2}, 6));
+
+INSTANTIATE_TEST_SUITE_P(TestGnorm, gnorm_test_t, cases);
+
+} // namespace dnnl
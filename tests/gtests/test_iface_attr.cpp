@@ -119,6 +119,98 @@ HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestScratchpadArg) {
     }
 }
 
+TEST_F(attr_test_t, TestScratchpadLimit) {
+    dnnl::primitive_attr attr;
+    ASSERT_EQ(attr.get_scratchpad_limit(), 0u);
+    for (size_t l : {(size_t)1, (size_t)1 << 20, (size_t)0}) {
+        attr.set_scratchpad_limit(l);
+        ASSERT_EQ(l, attr.get_scratchpad_limit());
+    }
+}
+
+TEST_F(attr_test_t, TestSrcPrescaleMask) {
+    dnnl::primitive_attr attr;
+    ASSERT_EQ(attr.get_src_prescale(), 1.f);
+    ASSERT_TRUE(attr.get_src_mask() == memory::desc());
+
+    attr.set_src_prescale(0.125f);
+    ASSERT_EQ(attr.get_src_prescale(), 0.125f);
+
+    memory::desc mask_md({1, 1, 16, 16}, data_type::f32, tag::abcd);
+    attr.set_src_mask(mask_md);
+    ASSERT_TRUE(attr.get_src_mask() == mask_md);
+    attr.set_src_mask(memory::desc());
+    ASSERT_TRUE(attr.get_src_mask() == memory::desc());
+
+    // The mask layout must be defined.
+    memory::desc any_md({1, 1, 16, 16}, data_type::f32, tag::any);
+    EXPECT_ANY_THROW(attr.set_src_mask(any_md));
+    memory::desc s8_md({1, 1, 16, 16}, data_type::s8, tag::abcd);
+    EXPECT_ANY_THROW(attr.set_src_mask(s8_md));
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestScratchpadLimitConvolution) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support scratchpad limit.");
+
+    engine eng = get_test_engine();
+    stream strm(eng);
+
+    const memory::dim N = 2, IC = 24, OC = 32, IH = 37, IW = 29;
+    memory::desc src_md({N, IC, IH, IW}, data_type::f32, tag::nhwc);
+    memory::desc wei_md({OC, IC, 3, 3}, data_type::f32, tag::any);
+    memory::desc bia_md({OC}, data_type::f32, tag::x);
+    memory::desc dst_md({N, OC, IH, IW}, data_type::f32, tag::nhwc);
+
+    post_ops ops;
+    ops.append_eltwise(algorithm::eltwise_relu, 0.f, 0.f);
+
+    auto create_pd = [&](size_t limit) {
+        primitive_attr attr;
+        attr.set_scratchpad_limit(limit);
+        attr.set_post_ops(ops);
+        return convolution_forward::primitive_desc(eng,
+                prop_kind::forward_inference, algorithm::convolution_direct,
+                src_md, wei_md, bia_md, dst_md, {1, 1}, {1, 1}, {1, 1}, attr);
+    };
+
+    // A limit of one byte asks for the smallest scratchpad possible.
+    auto ref_pd = create_pd(0);
+    auto pd = create_pd(1);
+    const std::string impl_info = pd.impl_info_str();
+    ASSERT_NE(impl_info.find("tiled:"), std::string::npos) << impl_info;
+    ASSERT_LE(pd.query_s64(query::memory_consumption_s64),
+            ref_pd.query_s64(query::memory_consumption_s64));
+
+    // Both primitives read the same weights, reorder them if the layouts
+    // chosen by the implementations differ.
+    auto src = test::make_memory(src_md, eng);
+    auto bia = test::make_memory(bia_md, eng);
+    auto ref_wei = test::make_memory(ref_pd.weights_desc(), eng);
+    auto wei = test::make_memory(pd.weights_desc(), eng);
+    auto ref_dst = test::make_memory(dst_md, eng);
+    auto dst = test::make_memory(dst_md, eng);
+    fill_data<float>(src_md.get_size() / sizeof(float), src);
+    fill_data<float>(bia_md.get_size() / sizeof(float), bia);
+    fill_data<float>(
+            ref_wei.get_desc().get_size() / sizeof(float), ref_wei);
+    reorder(ref_wei, wei).execute(strm, ref_wei, wei);
+
+    convolution_forward(ref_pd).execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, ref_wei},
+                    {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, ref_dst}});
+    convolution_forward(pd).execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst}});
+    strm.wait();
+
+    auto ref_ptr = map_memory<float>(ref_dst);
+    auto ptr = map_memory<float>(dst);
+    const memory::dim nelems = N * OC * IH * IW;
+    for (memory::dim i = 0; i < nelems; ++i)
+        ASSERT_NEAR(ptr[i], ref_ptr[i], 1e-4f * std::max(1.f, ref_ptr[i]));
+}
+
 TEST_F(attr_test_t, TestZeroPoints) {
     dnnl::primitive_attr attr;
 
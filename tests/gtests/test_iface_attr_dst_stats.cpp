@@ -0,0 +1,261 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+// short names for brevity
+using data_type = memory::data_type;
+using tag = memory::format_tag;
+
+class attr_dst_stats_test_t : public ::testing::Test {
+protected:
+    engine eng = get_test_engine();
+    stream strm = make_stream(eng);
+    void SetUp() override {}
+
+    static primitive_attr gen_attr_with_dst_stats() {
+        primitive_attr attr;
+        attr.set_dst_stats(true);
+        return attr;
+    }
+
+    template <typename F>
+    static void check_status(const F &f, dnnl_status_t status) {
+        catch_expected_failures(f, status != dnnl_success, status, false);
+    }
+
+    // Compares the statistics computed by a primitive with the ones computed
+    // from its dst, where `C` is the innermost dimension of `inner`
+    // consecutive points and there are `outer` such groups of channels.
+    static void check_stats(const memory &dst, const memory &stats,
+            memory::dim outer, memory::dim C, memory::dim inner) {
+        auto dst_ptr = map_memory<float>(dst);
+        auto stats_ptr = map_memory<float>(stats);
+        for (memory::dim c = 0; c < C; ++c) {
+            double s = 0, s_sq = 0;
+            for_(memory::dim o = 0; o < outer; ++o)
+            for (memory::dim i = 0; i < inner; ++i) {
+                const double v = dst_ptr[(o * C + c) * inner + i];
+                s += v;
+                s_sq += v * v;
+            }
+            ASSERT_NEAR(stats_ptr[c], s, 1e-4 * (1 + std::fabs(s)));
+            ASSERT_NEAR(stats_ptr[C + c], s_sq, 1e-4 * (1 + s_sq));
+        }
+    }
+};
+#define CHECK_STATUs(status, ...) check_status([&]() { __VA_ARGS__; }, status)
+#define CHECK_STATUS(status, ...) CHECK_STATUs(status, __VA_ARGS__)
+
+#define CHECK_OK(...) CHECK_STATUS(dnnl_success, __VA_ARGS__)
+#define CHECK_INVALID(...) CHECK_STATUS(dnnl_invalid_arguments, __VA_ARGS__)
+#define CHECK_UNIMPL(...) CHECK_STATUS(dnnl_unimplemented, __VA_ARGS__)
+
+TEST_F(attr_dst_stats_test_t, TestAttr) {
+    primitive_attr attr;
+    ASSERT_FALSE(attr.get_dst_stats());
+    attr.set_dst_stats(true);
+    ASSERT_TRUE(attr.get_dst_stats());
+    attr.set_dst_stats(false);
+    ASSERT_FALSE(attr.get_dst_stats());
+}
+
+TEST_F(attr_dst_stats_test_t, TestUnsupportedPrimitives) {
+    memory::desc md {{2, 16, 3, 3}, data_type::f32, tag::abcd};
+    CHECK_UNIMPL(eltwise_forward::primitive_desc(eng, prop_kind::forward,
+            algorithm::eltwise_relu, md, md, 0.f, 0.f,
+            gen_attr_with_dst_stats()));
+    CHECK_UNIMPL(binary::primitive_desc(eng, algorithm::binary_add, md, md, md,
+            gen_attr_with_dst_stats()));
+}
+
+TEST_F(attr_dst_stats_test_t, TestConvolution) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support dst stats.");
+
+    const memory::dim N = 2, IC = 32, OC = 48, IH = 7, IW = 7;
+    memory::desc src_md {{N, IC, IH, IW}, data_type::f32, tag::nhwc};
+    memory::desc wei_md {{OC, IC, 3, 3}, data_type::f32, tag::any};
+    memory::desc dst_md {{N, OC, IH, IW}, data_type::f32, tag::nhwc};
+
+    convolution_forward::primitive_desc pd;
+    CHECK_OK(pd = convolution_forward::primitive_desc(eng,
+                     prop_kind::forward_training,
+                     algorithm::convolution_direct, src_md, wei_md, dst_md,
+                     {1, 1}, {1, 1}, {1, 1}, gen_attr_with_dst_stats()));
+
+    const auto stats_md = pd.query_md(query::exec_arg_md,
+            DNNL_ARG_ATTR_DST_STATS);
+    ASSERT_EQ(stats_md, memory::desc({2, OC}, data_type::f32, tag::ab));
+
+    auto src = test::make_memory(pd.src_desc(), eng);
+    auto wei = test::make_memory(pd.weights_desc(), eng);
+    auto dst = test::make_memory(pd.dst_desc(), eng);
+    auto stats = test::make_memory(stats_md, eng);
+    fill_data<float>(src.get_desc().get_size() / sizeof(float), src);
+    fill_data<float>(wei.get_desc().get_size() / sizeof(float), wei);
+
+    convolution_forward(pd).execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_DST, dst}, {DNNL_ARG_ATTR_DST_STATS, stats}});
+    strm.wait();
+
+    check_stats(dst, stats, N * IH * IW, OC, 1);
+}
+
+TEST_F(attr_dst_stats_test_t, TestMatmul) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support dst stats.");
+
+    const memory::dim M = 67, K = 64, N = 40;
+    memory::desc src_md {{M, K}, data_type::f32, tag::ab};
+    memory::desc wei_md {{K, N}, data_type::f32, tag::ab};
+    memory::desc dst_md {{M, N}, data_type::f32, tag::ab};
+
+    matmul::primitive_desc pd;
+    CHECK_OK(pd = matmul::primitive_desc(
+                     eng, src_md, wei_md, dst_md, gen_attr_with_dst_stats()));
+
+    auto src = test::make_memory(src_md, eng);
+    auto wei = test::make_memory(wei_md, eng);
+    auto dst = test::make_memory(dst_md, eng);
+    auto stats = test::make_memory(
+            pd.query_md(query::exec_arg_md, DNNL_ARG_ATTR_DST_STATS), eng);
+    fill_data<float>(M * K, src);
+    fill_data<float>(K * N, wei);
+
+    matmul(pd).execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_DST, dst}, {DNNL_ARG_ATTR_DST_STATS, stats}});
+    strm.wait();
+
+    check_stats(dst, stats, M, N, 1);
+
+    // Runtime dimensions are not supported.
+    memory::desc rt_src_md {
+            {DNNL_RUNTIME_DIM_VAL, K}, data_type::f32, tag::ab};
+    memory::desc rt_dst_md {
+            {DNNL_RUNTIME_DIM_VAL, N}, data_type::f32, tag::ab};
+    CHECK_UNIMPL(matmul::primitive_desc(
+            eng, rt_src_md, wei_md, rt_dst_md, gen_attr_with_dst_stats()));
+}
+
+TEST_F(attr_dst_stats_test_t, TestBNormFlags) {
+    memory::desc md {{2, 16, 3, 3}, data_type::f32, tag::nchw};
+    const auto sums = normalization_flags::use_precomputed_sums;
+    const auto global = normalization_flags::use_global_stats;
+
+    CHECK_INVALID(batch_normalization_forward::primitive_desc(
+            eng, prop_kind::forward_training, md, md, 1e-3f, sums | global));
+
+    batch_normalization_forward::primitive_desc fwd_hint;
+    CHECK_OK(fwd_hint = batch_normalization_forward::primitive_desc(eng,
+                     prop_kind::forward_training, md, md, 1e-3f,
+                     normalization_flags::none));
+    CHECK_INVALID(batch_normalization_backward::primitive_desc(eng,
+            prop_kind::backward_data, md, md, md, 1e-3f, sums, fwd_hint));
+}
+
+TEST_F(attr_dst_stats_test_t, TestBNormPrecomputedSums) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support precomputed sums.");
+
+    const memory::dim N = 3, C = 32, H = 5, W = 6;
+    for (auto fmt : {tag::nchw, tag::nhwc, tag::nChw16c})
+        for (auto pk : {prop_kind::forward_training,
+                     prop_kind::forward_inference}) {
+            memory::desc md {{N, C, H, W}, data_type::f32, fmt};
+            const auto flags = normalization_flags::use_scale
+                    | normalization_flags::use_shift;
+
+            batch_normalization_forward::primitive_desc ref_pd, pd;
+            CHECK_OK(ref_pd = batch_normalization_forward::primitive_desc(
+                             eng, pk, md, md, 1e-3f, flags));
+            CHECK_OK(pd = batch_normalization_forward::primitive_desc(eng, pk,
+                             md, md, 1e-3f,
+                             flags | normalization_flags::use_precomputed_sums));
+
+            auto src = test::make_memory(md, eng);
+            auto ss = test::make_memory(pd.weights_desc(), eng);
+            auto ref_dst = test::make_memory(md, eng);
+            auto dst = test::make_memory(md, eng);
+            auto sums = test::make_memory(
+                    pd.query_md(query::exec_arg_md, DNNL_ARG_ATTR_DST_STATS),
+                    eng);
+            fill_data<float>(md.get_size() / sizeof(float), src);
+            fill_data<float>(C, ss);
+
+            {
+                // Sums in the layout produced by the dst stats attribute.
+                const memory::desc plain_md {
+                        {N, C, H, W}, data_type::f32, tag::nchw};
+                auto plain = test::make_memory(plain_md, eng);
+                reorder(src, plain).execute(strm, src, plain);
+                strm.wait();
+                auto plain_ptr = map_memory<float>(plain);
+                auto sums_ptr = map_memory<float>(sums);
+                for (memory::dim c = 0; c < C; ++c) {
+                    double s = 0, s_sq = 0;
+                    for_(memory::dim n = 0; n < N; ++n)
+                    for (memory::dim sp = 0; sp < H * W; ++sp) {
+                        const double v = plain_ptr[(n * C + c) * H * W + sp];
+                        s += v;
+                        s_sq += v * v;
+                    }
+                    sums_ptr[c] = (float)s;
+                    sums_ptr[C + c] = (float)s_sq;
+                }
+            }
+
+            std::unordered_map<int, memory> args {{DNNL_ARG_SRC, src},
+                    {DNNL_ARG_SCALE, ss}, {DNNL_ARG_SHIFT, ss}};
+            memory ref_mean, ref_var, mean, var;
+            auto ref_args = args;
+            ref_args.insert({DNNL_ARG_DST, ref_dst});
+            args.insert({DNNL_ARG_DST, dst});
+            args.insert({DNNL_ARG_ATTR_DST_STATS, sums});
+            if (pk == prop_kind::forward_training) {
+                ref_mean = test::make_memory(ref_pd.mean_desc(), eng);
+                ref_var = test::make_memory(ref_pd.variance_desc(), eng);
+                mean = test::make_memory(pd.mean_desc(), eng);
+                var = test::make_memory(pd.variance_desc(), eng);
+                ref_args.insert({DNNL_ARG_MEAN, ref_mean});
+                ref_args.insert({DNNL_ARG_VARIANCE, ref_var});
+                args.insert({DNNL_ARG_MEAN, mean});
+                args.insert({DNNL_ARG_VARIANCE, var});
+            }
+
+            batch_normalization_forward(ref_pd).execute(strm, ref_args);
+            batch_normalization_forward(pd).execute(strm, args);
+            strm.wait();
+
+            compare_data<float>(ref_dst, dst, 1e-4f);
+            if (pk == prop_kind::forward_training) {
+                compare_data<float>(ref_mean, mean, 1e-5f);
+                compare_data<float>(ref_var, var, 1e-4f);
+            }
+        }
+}
+
+} // namespace dnnl
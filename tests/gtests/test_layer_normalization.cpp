@@ -456,4 +456,74 @@ CPU_INST_TEST_CASE(LnormSimpleBF16F32, EXPAND_DTS(bf16, f32, bf16))
 CPU_INST_TEST_CASE(LnormSimpleF32S8, EXPAND_DTS(f32, s8, undef))
 CPU_INST_TEST_CASE(LnormSimpleBF16U8, EXPAND_DTS(bf16, u8, undef))
 
+// RMS normalization with a fused residual add: the sum output is optional and
+// must not change the normalized result.
+TEST(lnorm_rms_residual_test_t, TestOptionalResidualSum) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "RMS normalization is supported only by CPU.");
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    const memory::dim N = 6, C = 37;
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+    const memory::desc data_md({N, C}, dt::f32, tag::ab);
+
+    const auto flags = normalization_flags::rms_norm
+            | normalization_flags::fuse_residual_add
+            | normalization_flags::use_scale;
+    auto pd = layer_normalization_forward::primitive_desc(eng,
+            prop_kind::forward_inference, data_md, data_md, epsilon, flags);
+    layer_normalization_forward prim(pd);
+
+    auto src = test::make_memory(data_md, eng);
+    auto res = test::make_memory(data_md, eng);
+    auto sum = test::make_memory(data_md, eng);
+    auto dst = test::make_memory(data_md, eng);
+    auto dst_no_sum = test::make_memory(data_md, eng);
+    auto scale = test::make_memory(pd.weights_desc(), eng);
+    {
+        auto s = map_memory<float>(src);
+        auto r = map_memory<float>(res);
+        for (memory::dim i = 0; i < N * C; i++) {
+            s[i] = (i % 11 - 5) / 4.f;
+            r[i] = (i % 7 - 3) / 2.f;
+        }
+        auto sc = map_memory<float>(scale);
+        for (memory::dim c = 0; c < C; c++)
+            sc[c] = 1.f + (c % 3) / 2.f;
+    }
+
+    prim.execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_SRC_1, res},
+                    {DNNL_ARG_SCALE, scale}, {DNNL_ARG_DST, dst},
+                    {DNNL_ARG_DST_1, sum}});
+    prim.execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_SRC_1, res},
+                    {DNNL_ARG_SCALE, scale}, {DNNL_ARG_DST, dst_no_sum}});
+    strm.wait();
+
+    auto s = map_memory<float>(src);
+    auto r = map_memory<float>(res);
+    auto sm = map_memory<float>(sum);
+    auto sc = map_memory<float>(scale);
+    auto d = map_memory<float>(dst);
+    auto d_no_sum = map_memory<float>(dst_no_sum);
+    for (memory::dim n = 0; n < N; n++) {
+        float mean_sq = 0.f;
+        for (memory::dim c = 0; c < C; c++) {
+            const float x = s[n * C + c] + r[n * C + c];
+            ASSERT_EQ(sm[n * C + c], x);
+            mean_sq += x * x;
+        }
+        const float rcp_rms = 1.f / std::sqrt(mean_sq / C + epsilon);
+        for (memory::dim c = 0; c < C; c++) {
+            const auto off = n * C + c;
+            const float x = s[off] + r[off];
+            ASSERT_NEAR(d[off], sc[c] * x * rcp_rms, 1e-4f);
+            ASSERT_EQ(d[off], d_no_sum[off]);
+        }
+    }
+}
+
 } // namespace dnnl
@@ -0,0 +1,198 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+// short names for brevity
+using data_type = memory::data_type;
+using tag = memory::format_tag;
+
+// Int8 LSTM with projection quantizes the hidden state before the projection
+// gemm. Data and weights below are exactly representable in int8, so the int8
+// result has to match f32 up to the rounding of the hidden state. The
+// projection reduction dimension is dhc: 32 can be blocked for AMX, 34 cannot
+// and makes the cell fall back to a non-AMX isa.
+class rnn_projection_test_t : public ::testing::Test {
+protected:
+    engine eng = get_test_engine();
+    stream strm = make_stream(eng);
+
+    static constexpr float data_scale = 64.f;
+    static constexpr float data_shift = 64.f;
+
+    static uint8_t src_val(memory::dim i) {
+        return static_cast<uint8_t>(32 + (i * 37) % 65);
+    }
+    static int8_t wei_val(memory::dim i, int range) {
+        return static_cast<int8_t>((i * 13) % (2 * range + 1) - range);
+    }
+
+    void check(memory::dim dhc) {
+        const memory::dim L = 1, D = 1, T = 3, N = 2, G = 4, C = 16;
+        const auto f32 = data_type::f32;
+        const auto u8 = data_type::u8;
+
+        const memory::dims layer_dims {T, N, C}, iter_dims {L, D, N, C},
+                iter_c_dims {L, D, N, dhc}, wei_dims {L, D, C, G, dhc},
+                wei_proj_dims {L, D, dhc, C}, bias_dims {L, D, G, dhc};
+
+        const memory::desc wei_f32_md {wei_dims, f32, tag::ldigo};
+        const memory::desc wei_proj_f32_md {wei_proj_dims, f32, tag::ldio};
+        const memory::desc bias_md {bias_dims, f32, tag::ldgo};
+        const memory::desc iter_c_md {iter_c_dims, f32, tag::ldnc};
+        const memory::desc dst_layer_md {layer_dims, f32, tag::tnc};
+
+        auto weights_layer = test::make_memory(wei_f32_md, eng);
+        auto weights_iter = test::make_memory(wei_f32_md, eng);
+        auto weights_proj = test::make_memory(wei_proj_f32_md, eng);
+        auto bias = test::make_memory(bias_md, eng);
+        auto src_iter_c = test::make_memory(iter_c_md, eng);
+        fill_data<float>(L * D * G * dhc, bias, 0.f, 0.25f);
+        fill_data<float>(L * D * N * dhc, src_iter_c, 0.f, 0.5f);
+        {
+            auto wl = map_memory<float>(weights_layer);
+            auto wi = map_memory<float>(weights_iter);
+            for (memory::dim i = 0; i < L * D * C * G * dhc; i++) {
+                wl[i] = wei_val(i, 4) / data_scale;
+                wi[i] = wei_val(i + 7, 4) / data_scale;
+            }
+            auto wp = map_memory<float>(weights_proj);
+            for (memory::dim i = 0; i < L * D * dhc * C; i++)
+                wp[i] = wei_val(i, 2) / data_scale;
+        }
+
+        // f32 reference
+        std::vector<float> dst_ref;
+        {
+            const memory::desc src_layer_md {layer_dims, f32, tag::tnc};
+            const memory::desc iter_md {iter_dims, f32, tag::ldnc};
+            auto src_layer = test::make_memory(src_layer_md, eng);
+            auto src_iter = test::make_memory(iter_md, eng);
+            {
+                auto sl = map_memory<float>(src_layer);
+                for (memory::dim i = 0; i < T * N * C; i++)
+                    sl[i] = (src_val(i) - data_shift) / data_scale;
+                auto si = map_memory<float>(src_iter);
+                for (memory::dim i = 0; i < L * D * N * C; i++)
+                    si[i] = (src_val(i + 3) - data_shift) / data_scale;
+            }
+            lstm_forward::primitive_desc pd;
+            ASSERT_NO_THROW(pd = lstm_forward::primitive_desc(eng,
+                                    prop_kind::forward_inference,
+                                    rnn_direction::unidirectional_left2right,
+                                    src_layer_md, iter_md, iter_c_md,
+                                    wei_f32_md, wei_f32_md, memory::desc(),
+                                    wei_proj_f32_md, bias_md, dst_layer_md,
+                                    iter_md, iter_c_md));
+            auto dst_layer = test::make_memory(dst_layer_md, eng);
+            lstm_forward(pd).execute(strm,
+                    {{DNNL_ARG_SRC_LAYER, src_layer},
+                            {DNNL_ARG_SRC_ITER, src_iter},
+                            {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                            {DNNL_ARG_WEIGHTS_LAYER, weights_layer},
+                            {DNNL_ARG_WEIGHTS_ITER, weights_iter},
+                            {DNNL_ARG_WEIGHTS_PROJECTION, weights_proj},
+                            {DNNL_ARG_BIAS, bias},
+                            {DNNL_ARG_DST_LAYER, dst_layer},
+                            {DNNL_ARG_DST_ITER,
+                                    test::make_memory(iter_md, eng)},
+                            {DNNL_ARG_DST_ITER_C,
+                                    test::make_memory(iter_c_md, eng)}});
+            strm.wait();
+            auto dst_ptr = map_memory<float>(dst_layer);
+            for (memory::dim i = 0; i < T * N * C; i++)
+                dst_ref.push_back(dst_ptr[i]);
+        }
+
+        // int8 (u8u8u8f32)
+        primitive_attr attr;
+        attr.set_rnn_data_qparams(data_scale, data_shift);
+        attr.set_rnn_weights_qparams(0, {data_scale});
+        attr.set_rnn_weights_projection_qparams(0, {data_scale});
+
+        const memory::desc src_layer_md {layer_dims, u8, tag::tnc};
+        const memory::desc iter_md {iter_dims, u8, tag::ldnc};
+        lstm_forward::primitive_desc pd;
+        ASSERT_NO_THROW(pd = lstm_forward::primitive_desc(eng,
+                                prop_kind::forward_inference,
+                                rnn_direction::unidirectional_left2right,
+                                src_layer_md, iter_md, iter_c_md,
+                                {wei_dims, data_type::s8, tag::any},
+                                {wei_dims, data_type::s8, tag::any},
+                                memory::desc(),
+                                {wei_proj_dims, data_type::s8, tag::any},
+                                bias_md, dst_layer_md, iter_md, iter_c_md,
+                                attr));
+
+        auto src_layer = test::make_memory(src_layer_md, eng);
+        auto src_iter = test::make_memory(iter_md, eng);
+        {
+            auto sl = map_memory<uint8_t>(src_layer);
+            for (memory::dim i = 0; i < T * N * C; i++)
+                sl[i] = src_val(i);
+            auto si = map_memory<uint8_t>(src_iter);
+            for (memory::dim i = 0; i < L * D * N * C; i++)
+                si[i] = src_val(i + 3);
+        }
+        auto quantize = [&](memory m, const memory::desc &md) {
+            auto q = test::make_memory(md, eng);
+            reorder(reorder::primitive_desc(eng, m.get_desc(), eng, md, attr))
+                    .execute(strm, m, q);
+            return q;
+        };
+        auto weights_layer_q = quantize(weights_layer, pd.weights_layer_desc());
+        auto weights_iter_q = quantize(weights_iter, pd.weights_iter_desc());
+        auto weights_proj_q
+                = quantize(weights_proj, pd.weights_projection_desc());
+
+        auto dst_layer = test::make_memory(dst_layer_md, eng);
+        lstm_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC_LAYER, src_layer}, {DNNL_ARG_SRC_ITER, src_iter},
+                        {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                        {DNNL_ARG_WEIGHTS_LAYER, weights_layer_q},
+                        {DNNL_ARG_WEIGHTS_ITER, weights_iter_q},
+                        {DNNL_ARG_WEIGHTS_PROJECTION, weights_proj_q},
+                        {DNNL_ARG_BIAS, bias}, {DNNL_ARG_DST_LAYER, dst_layer},
+                        {DNNL_ARG_DST_ITER, test::make_memory(iter_md, eng)},
+                        {DNNL_ARG_DST_ITER_C,
+                                test::make_memory(iter_c_md, eng)}});
+        strm.wait();
+
+        auto dst_ptr = map_memory<float>(dst_layer);
+        for (memory::dim i = 0; i < T * N * C; i++)
+            ASSERT_NEAR(dst_ptr[i], dst_ref[i], 2e-2f);
+    }
+};
+
+TEST_F(rnn_projection_test_t, TestInt8) {
+    // Int8 RNN relies on packed API solely which is available only for X64.
+#if !DNNL_X64
+    return;
+#endif
+    SKIP_IF(DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL,
+            "Threadpool does not have working packed API");
+    for (memory::dim dhc : {32, 34})
+        ASSERT_NO_FATAL_FAILURE(check(dhc));
+}
+
+} // namespace dnnl
@@ -0,0 +1,199 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+// short names for brevity
+using data_type = memory::data_type;
+using tag = memory::format_tag;
+
+class rnn_seq_lengths_test_t : public ::testing::Test {
+protected:
+    engine eng = get_test_engine();
+    stream strm = make_stream(eng);
+
+    const memory::dim L = 2, C = 8;
+
+    memory weights_layer, weights_iter, bias;
+
+    void SetUp() override {
+        const memory::dim G = 4; // number of LSTM gates
+        weights_layer = test::make_memory(
+                {{L, 1, C, G, C}, data_type::f32, tag::ldigo}, eng);
+        weights_iter = test::make_memory(
+                {{L, 1, C, G, C}, data_type::f32, tag::ldigo}, eng);
+        bias = test::make_memory(
+                {{L, 1, G, C}, data_type::f32, tag::ldgo}, eng);
+        fill_data<float>(L * C * G * C, weights_layer, 0.f, 0.5f);
+        fill_data<float>(L * C * G * C, weights_iter, 0.f, 0.5f);
+        fill_data<float>(L * G * C, bias, 0.f, 0.5f);
+    }
+
+    lstm_forward::primitive_desc make_pd(memory::dim T, memory::dim N) const {
+        memory::desc layer_md {{T, N, C}, data_type::f32, tag::tnc};
+        memory::desc iter_md {{L, 1, N, C}, data_type::f32, tag::ldnc};
+        return lstm_forward::primitive_desc(eng, prop_kind::forward_inference,
+                rnn_direction::unidirectional_left2right, layer_md, iter_md,
+                iter_md, weights_layer.get_desc(), weights_iter.get_desc(),
+                bias.get_desc(), layer_md, iter_md, iter_md);
+    }
+
+    void execute(const lstm_forward::primitive_desc &pd,
+            const memory &src_layer, const memory &src_iter,
+            const memory &src_iter_c, const memory &dst_layer,
+            const memory &dst_iter, const memory &dst_iter_c,
+            const memory *seq_lengths = nullptr) {
+        std::unordered_map<int, memory> args = {
+                {DNNL_ARG_SRC_LAYER, src_layer},
+                {DNNL_ARG_SRC_ITER, src_iter},
+                {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                {DNNL_ARG_WEIGHTS_LAYER, weights_layer},
+                {DNNL_ARG_WEIGHTS_ITER, weights_iter},
+                {DNNL_ARG_BIAS, bias}, {DNNL_ARG_DST_LAYER, dst_layer},
+                {DNNL_ARG_DST_ITER, dst_iter},
+                {DNNL_ARG_DST_ITER_C, dst_iter_c}};
+        if (seq_lengths) args.insert({DNNL_ARG_SEQ_LENGTHS, *seq_lengths});
+        lstm_forward(pd).execute(strm, args);
+        strm.wait();
+    }
+};
+
+TEST_F(rnn_seq_lengths_test_t, TestLSTM) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support variable-length sequences.");
+
+    const memory::dim T = 5, N = 3;
+    const std::vector<int32_t> lengths = {5, 3, 1};
+
+    lstm_forward::primitive_desc pd;
+    ASSERT_NO_THROW(pd = make_pd(T, N));
+    const auto seq_lengths_md
+            = pd.query_md(query::exec_arg_md, DNNL_ARG_SEQ_LENGTHS);
+    ASSERT_EQ(seq_lengths_md, memory::desc({N}, data_type::s32, tag::a));
+
+    auto src_layer = test::make_memory(pd.src_layer_desc(), eng);
+    auto src_iter = test::make_memory(pd.src_iter_desc(), eng);
+    auto src_iter_c = test::make_memory(pd.src_iter_c_desc(), eng);
+    auto dst_layer = test::make_memory(pd.dst_layer_desc(), eng);
+    auto dst_iter = test::make_memory(pd.dst_iter_desc(), eng);
+    auto dst_iter_c = test::make_memory(pd.dst_iter_c_desc(), eng);
+    auto seq_lengths = test::make_memory(seq_lengths_md, eng);
+    fill_data<float>(T * N * C, src_layer);
+    fill_data<float>(L * N * C, src_iter);
+    fill_data<float>(L * N * C, src_iter_c);
+    {
+        auto ptr = map_memory<int32_t>(seq_lengths);
+        for (memory::dim n = 0; n < N; n++)
+            ptr[n] = lengths[n];
+    }
+
+    execute(pd, src_layer, src_iter, src_iter_c, dst_layer, dst_iter,
+            dst_iter_c, &seq_lengths);
+
+    auto src_layer_ptr = map_memory<float>(src_layer);
+    auto src_iter_ptr = map_memory<float>(src_iter);
+    auto src_iter_c_ptr = map_memory<float>(src_iter_c);
+    auto dst_layer_ptr = map_memory<float>(dst_layer);
+    auto dst_iter_ptr = map_memory<float>(dst_iter);
+    auto dst_iter_c_ptr = map_memory<float>(dst_iter_c);
+
+    // Every sequence has to match a separate execution with its own length.
+    for (memory::dim n = 0; n < N; n++) {
+        const memory::dim len = lengths[n];
+        auto ref_pd = make_pd(len, 1);
+        auto ref_src_layer = test::make_memory(ref_pd.src_layer_desc(), eng);
+        auto ref_src_iter = test::make_memory(ref_pd.src_iter_desc(), eng);
+        auto ref_src_iter_c = test::make_memory(ref_pd.src_iter_c_desc(), eng);
+        auto ref_dst_layer = test::make_memory(ref_pd.dst_layer_desc(), eng);
+        auto ref_dst_iter = test::make_memory(ref_pd.dst_iter_desc(), eng);
+        auto ref_dst_iter_c = test::make_memory(ref_pd.dst_iter_c_desc(), eng);
+        {
+            auto sl = map_memory<float>(ref_src_layer);
+            auto si = map_memory<float>(ref_src_iter);
+            auto sc = map_memory<float>(ref_src_iter_c);
+            for_(memory::dim t = 0; t < len; t++)
+            for (memory::dim c = 0; c < C; c++)
+                sl[t * C + c] = src_layer_ptr[(t * N + n) * C + c];
+            for_(memory::dim l = 0; l < L; l++)
+            for (memory::dim c = 0; c < C; c++) {
+                si[l * C + c] = src_iter_ptr[(l * N + n) * C + c];
+                sc[l * C + c] = src_iter_c_ptr[(l * N + n) * C + c];
+            }
+        }
+
+        execute(ref_pd, ref_src_layer, ref_src_iter, ref_src_iter_c,
+                ref_dst_layer, ref_dst_iter, ref_dst_iter_c);
+
+        auto dl = map_memory<float>(ref_dst_layer);
+        auto di = map_memory<float>(ref_dst_iter);
+        auto dc = map_memory<float>(ref_dst_iter_c);
+        for_(memory::dim t = 0; t < T; t++)
+        for (memory::dim c = 0; c < C; c++) {
+            const float ref = t < len ? dl[t * C + c] : 0.f;
+            ASSERT_NEAR(dst_layer_ptr[(t * N + n) * C + c], ref, 1e-4f);
+        }
+        for_(memory::dim l = 0; l < L; l++)
+        for (memory::dim c = 0; c < C; c++) {
+            ASSERT_NEAR(dst_iter_ptr[(l * N + n) * C + c], di[l * C + c],
+                    1e-4f);
+            ASSERT_NEAR(dst_iter_c_ptr[(l * N + n) * C + c], dc[l * C + c],
+                    1e-4f);
+        }
+    }
+}
+
+TEST_F(rnn_seq_lengths_test_t, TestInvalidLengths) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support variable-length sequences.");
+
+    const memory::dim T = 4, N = 2;
+    lstm_forward::primitive_desc pd;
+    ASSERT_NO_THROW(pd = make_pd(T, N));
+
+    auto src_layer = test::make_memory(pd.src_layer_desc(), eng);
+    auto src_iter = test::make_memory(pd.src_iter_desc(), eng);
+    auto src_iter_c = test::make_memory(pd.src_iter_c_desc(), eng);
+    auto dst_layer = test::make_memory(pd.dst_layer_desc(), eng);
+    auto dst_iter = test::make_memory(pd.dst_iter_desc(), eng);
+    auto dst_iter_c = test::make_memory(pd.dst_iter_c_desc(), eng);
+    auto seq_lengths = test::make_memory(
+            pd.query_md(query::exec_arg_md, DNNL_ARG_SEQ_LENGTHS), eng);
+    fill_data<float>(T * N * C, src_layer);
+    fill_data<float>(L * N * C, src_iter);
+    fill_data<float>(L * N * C, src_iter_c);
+
+    // Lengths have to be sorted in decreasing order and lie in [1, T].
+    for (const auto &lengths : std::vector<std::vector<int32_t>> {
+                 {2, 3}, {5, 1}, {1, 0}}) {
+        {
+            auto ptr = map_memory<int32_t>(seq_lengths);
+            for (memory::dim n = 0; n < N; n++)
+                ptr[n] = lengths[n];
+        }
+        EXPECT_ANY_THROW(execute(pd, src_layer, src_iter, src_iter_c,
+                dst_layer, dst_iter, dst_iter_c, &seq_lengths));
+    }
+}
+
+} // namespace dnnl
@@ -0,0 +1,170 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+// short names for brevity
+using data_type = memory::data_type;
+using tag = memory::format_tag;
+
+class rnn_stateful_test_t : public ::testing::Test {
+protected:
+    engine eng = get_test_engine();
+    stream strm = make_stream(eng);
+
+    const memory::dim L = 2, C = 8, N = 2;
+
+    memory weights_layer, weights_iter, bias;
+
+    void SetUp() override { init_weights(4); } // number of LSTM gates
+
+    void init_weights(memory::dim G) {
+        weights_layer = test::make_memory(
+                {{L, 1, C, G, C}, data_type::f32, tag::ldigo}, eng);
+        weights_iter = test::make_memory(
+                {{L, 1, C, G, C}, data_type::f32, tag::ldigo}, eng);
+        bias = test::make_memory(
+                {{L, 1, G, C}, data_type::f32, tag::ldgo}, eng);
+        fill_data<float>(L * C * G * C, weights_layer, 0.f, 0.5f);
+        fill_data<float>(L * C * G * C, weights_iter, 0.f, 0.5f);
+        fill_data<float>(L * G * C, bias, 0.f, 0.5f);
+    }
+
+    memory::desc layer_md(memory::dim T) const {
+        return {{T, N, C}, data_type::f32, tag::tnc};
+    }
+
+    template <typename pd_t = lstm_forward::primitive_desc>
+    pd_t make_stateful_pd(memory::dim T, prop_kind aprop_kind) const {
+        return pd_t(eng, aprop_kind, rnn_direction::unidirectional_left2right,
+                layer_md(T), weights_layer.get_desc(), weights_iter.get_desc(),
+                bias.get_desc(), layer_md(T), rnn_flags::stateful);
+    }
+
+    void execute(const primitive &prim, const memory &src_layer,
+            const memory &dst_layer,
+            const memory *workspace = nullptr) {
+        std::unordered_map<int, memory> args
+                = {{DNNL_ARG_SRC_LAYER, src_layer},
+                        {DNNL_ARG_WEIGHTS_LAYER, weights_layer},
+                        {DNNL_ARG_WEIGHTS_ITER, weights_iter},
+                        {DNNL_ARG_BIAS, bias}, {DNNL_ARG_DST_LAYER, dst_layer}};
+        if (workspace) args.insert({DNNL_ARG_WORKSPACE, *workspace});
+        prim.execute(strm, args);
+        strm.wait();
+    }
+
+    static void zero_memory(const memory &mem) {
+        auto ptr = map_memory<uint8_t>(mem);
+        std::memset(ptr, 0, mem.get_desc().get_size());
+    }
+
+    // Runs the sequence of length T by chunks of length S through the
+    // stateful primitive and compares the result to the reference one that
+    // processes the whole sequence at once starting from zero states.
+    template <typename prim_t>
+    void check_streaming(const typename prim_t::primitive_desc &ref_pd,
+            memory::dim T, memory::dim S) {
+        auto src_layer = test::make_memory(layer_md(T), eng);
+        auto ref_dst_layer = test::make_memory(layer_md(T), eng);
+        fill_data<float>(T * N * C, src_layer);
+        execute(prim_t(ref_pd), src_layer, ref_dst_layer);
+
+        typename prim_t::primitive_desc pd;
+        ASSERT_NO_THROW(pd = make_stateful_pd<typename prim_t::primitive_desc>(
+                                S, prop_kind::forward_inference));
+        const prim_t prim(pd);
+        auto workspace = test::make_memory(pd.workspace_desc(), eng);
+        auto src_chunk = test::make_memory(layer_md(S), eng);
+        auto dst_chunk = test::make_memory(layer_md(S), eng);
+
+        auto src_ptr = map_memory<float>(src_layer);
+        auto ref_ptr = map_memory<float>(ref_dst_layer);
+        const memory::dim chunk_size = S * N * C;
+
+        // The same workspace is processed twice to check that zeroing it
+        // resets the states.
+        for (int pass = 0; pass < 2; pass++) {
+            zero_memory(workspace);
+            for (memory::dim t = 0; t < T; t += S) {
+                {
+                    auto ptr = map_memory<float>(src_chunk);
+                    for (memory::dim i = 0; i < chunk_size; i++)
+                        ptr[i] = src_ptr[t * N * C + i];
+                }
+                execute(prim, src_chunk, dst_chunk, &workspace);
+
+                auto dst_ptr = map_memory<float>(dst_chunk);
+                for (memory::dim i = 0; i < chunk_size; i++)
+                    ASSERT_NEAR(dst_ptr[i], ref_ptr[t * N * C + i], 1e-4f);
+            }
+        }
+    }
+};
+
+TEST_F(rnn_stateful_test_t, TestStreaming) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support stateful execution.");
+
+    const memory::dim T = 6;
+    auto ref_pd = lstm_forward::primitive_desc(eng,
+            prop_kind::forward_inference,
+            rnn_direction::unidirectional_left2right, layer_md(T), {}, {},
+            weights_layer.get_desc(), weights_iter.get_desc(),
+            bias.get_desc(), layer_md(T), {}, {});
+    check_streaming<lstm_forward>(ref_pd, T, 2);
+}
+
+TEST_F(rnn_stateful_test_t, TestStreamingGru) {
+    SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+            "GPU engine does not support stateful execution.");
+
+    init_weights(3); // number of GRU gates
+    const memory::dim T = 6;
+    auto ref_pd = gru_forward::primitive_desc(eng,
+            prop_kind::forward_inference,
+            rnn_direction::unidirectional_left2right, layer_md(T), {},
+            weights_layer.get_desc(), weights_iter.get_desc(),
+            bias.get_desc(), layer_md(T), {});
+    check_streaming<gru_forward>(ref_pd, T, 2);
+}
+
+TEST_F(rnn_stateful_test_t, TestUnsupported) {
+    // Stateful execution is limited to inference and does not take the
+    // states explicitly.
+    EXPECT_ANY_THROW(make_stateful_pd(2, prop_kind::forward_training));
+
+    const memory::desc layer = layer_md(2);
+    const memory::desc iter {{L, 1, N, C}, data_type::f32, tag::ldnc};
+    dnnl_primitive_desc_t c_pd = nullptr;
+    EXPECT_EQ(dnnl_lstm_forward_primitive_desc_create(&c_pd, eng.get(),
+                      dnnl_forward_inference, dnnl_unidirectional_left2right,
+                      layer.get(), iter.get(), iter.get(),
+                      weights_layer.get_desc().get(),
+                      weights_iter.get_desc().get(), nullptr, nullptr,
+                      bias.get_desc().get(), layer.get(), iter.get(),
+                      iter.get(), dnnl_rnn_flags_stateful, nullptr),
+            dnnl_invalid_arguments);
+}
+
+} // namespace dnnl
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+// short names for brevity
+using data_type = memory::data_type;
+using tag = memory::format_tag;
+
+// Small-minibatch inference computes the cells of an anti-diagonal of the
+// (layer, iteration) grid concurrently, and splits the minibatch of a cell
+// between several threads when there are more threads than cells. Training
+// computes the cells one by one, so both have to give the same results.
+class rnn_wavefront_test_t : public ::testing::Test {
+protected:
+    engine eng = get_test_engine();
+    stream strm = make_stream(eng);
+
+    // G is the number of gates, n_bias the number of bias gates
+    template <typename rnn_prim_t>
+    void check(memory::dim G, memory::dim n_bias) {
+        const memory::dim L = 3, D = 2, T = 5, N = 6, C = 16;
+        const memory::desc layer_md {{T, N, C}, data_type::f32, tag::tnc};
+        const memory::desc iter_md {{L, D, N, C}, data_type::f32, tag::ldnc};
+        const memory::desc wei_md {
+                {L, D, C, G, C}, data_type::f32, tag::ldigo};
+        const memory::desc bias_md {
+                {L, D, n_bias, C}, data_type::f32, tag::ldgo};
+
+        auto weights_layer = test::make_memory(wei_md, eng);
+        auto weights_iter = test::make_memory(wei_md, eng);
+        auto bias = test::make_memory(bias_md, eng);
+        auto src_layer = test::make_memory(layer_md, eng);
+        auto src_iter = test::make_memory(iter_md, eng);
+        fill_data<float>(L * D * C * G * C, weights_layer, 0.f, 0.5f);
+        fill_data<float>(L * D * C * G * C, weights_iter, 0.f, 0.5f);
+        fill_data<float>(L * D * n_bias * C, bias, 0.f, 0.5f);
+        fill_data<float>(T * N * C, src_layer);
+        fill_data<float>(L * D * N * C, src_iter);
+
+        std::vector<float> dst_layer_res[2], dst_iter_res[2];
+        const prop_kind props[2]
+                = {prop_kind::forward_inference, prop_kind::forward_training};
+        for (int p = 0; p < 2; p++) {
+            typename rnn_prim_t::primitive_desc pd;
+            ASSERT_NO_THROW(pd = typename rnn_prim_t::primitive_desc(eng,
+                                    props[p], rnn_direction::bidirectional_sum,
+                                    layer_md, iter_md, wei_md, wei_md, bias_md,
+                                    layer_md, iter_md));
+            auto dst_layer = test::make_memory(pd.dst_layer_desc(), eng);
+            auto dst_iter = test::make_memory(pd.dst_iter_desc(), eng);
+            std::unordered_map<int, memory> args = {
+                    {DNNL_ARG_SRC_LAYER, src_layer},
+                    {DNNL_ARG_SRC_ITER, src_iter},
+                    {DNNL_ARG_WEIGHTS_LAYER, weights_layer},
+                    {DNNL_ARG_WEIGHTS_ITER, weights_iter},
+                    {DNNL_ARG_BIAS, bias}, {DNNL_ARG_DST_LAYER, dst_layer},
+                    {DNNL_ARG_DST_ITER, dst_iter}};
+            if (props[p] == prop_kind::forward_training) {
+                args.insert({DNNL_ARG_WORKSPACE,
+                        test::make_memory(pd.workspace_desc(), eng)});
+            }
+            rnn_prim_t(pd).execute(strm, args);
+            strm.wait();
+
+            auto dst_layer_ptr = map_memory<float>(dst_layer);
+            auto dst_iter_ptr = map_memory<float>(dst_iter);
+            for (memory::dim i = 0; i < T * N * C; i++)
+                dst_layer_res[p].push_back(dst_layer_ptr[i]);
+            for (memory::dim i = 0; i < L * D * N * C; i++)
+                dst_iter_res[p].push_back(dst_iter_ptr[i]);
+        }
+
+        for (size_t i = 0; i < dst_layer_res[0].size(); i++)
+            ASSERT_NEAR(dst_layer_res[0][i], dst_layer_res[1][i], 1e-5f);
+        for (size_t i = 0; i < dst_iter_res[0].size(); i++)
+            ASSERT_NEAR(dst_iter_res[0][i], dst_iter_res[1][i], 1e-5f);
+    }
+};
+
+TEST_F(rnn_wavefront_test_t, TestGRU) {
+    check<gru_forward>(3, 3);
+}
+
+TEST_F(rnn_wavefront_test_t, TestGRUlbr) {
+    check<lbr_gru_forward>(3, 4);
+}
+
+} // namespace dnnl
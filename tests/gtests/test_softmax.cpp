@@ -14,6 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cfloat>
+#include <cmath>
+
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
@@ -537,4 +540,107 @@ INSTANTIATE_TEST_SUITE_P(Test_Softmax_Forward_S8, softmax_test_t,
                         tag::nhwc, tag::nhwc, tag::undef, {2, 1011, 32, 1},
                         2}));
 
+// Checks softmax with the src pre-scale and mask attributes against a naive
+// reference. Long rows exercise the online max/sum algorithm.
+TEST(softmax_src_ops_test_t, TestPrescaleMask) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Src pre-scale and mask are supported only by CPU.");
+
+    struct case_t {
+        algorithm alg;
+        memory::dims dims; // N, H, S, S
+        memory::dims mask_dims;
+        float prescale;
+    };
+    const std::vector<case_t> cases = {
+            {algorithm::softmax_accurate, {2, 3, 5, 37}, {1, 1, 5, 37},
+                    0.25f},
+            {algorithm::softmax_accurate, {2, 3, 4, 37}, {2, 1, 4, 1}, 1.f},
+            {algorithm::softmax_accurate, {1, 2, 3, 20000}, {1, 1, 1, 20000},
+                    0.125f},
+            {algorithm::softmax_log, {2, 2, 3, 100}, {1, 2, 1, 100}, 2.f},
+            // Long rows without src ops go through the online algorithm.
+            {algorithm::softmax_accurate, {1, 1, 3, 20001}, {}, 1.f},
+    };
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    for (const auto &c : cases) {
+        const memory::desc data_md(c.dims, dt::f32, tag::abcd);
+        primitive_attr attr;
+        attr.set_src_prescale(c.prescale);
+        const bool with_mask = !c.mask_dims.empty();
+        memory::desc mask_md;
+        if (with_mask) {
+            mask_md = memory::desc(c.mask_dims, dt::f32, tag::abcd);
+            attr.set_src_mask(mask_md);
+        }
+        auto pd = softmax_forward::primitive_desc(eng,
+                prop_kind::forward_inference, c.alg, data_md, data_md, 3,
+                attr);
+        ASSERT_EQ(pd.get_primitive_attr().get_src_prescale(), c.prescale);
+        ASSERT_TRUE(pd.get_primitive_attr().get_src_mask() == mask_md);
+
+        auto src = test::make_memory(data_md, eng);
+        auto dst = test::make_memory(data_md, eng);
+        std::unordered_map<int, memory> args
+                = {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}};
+        memory mask;
+        std::vector<float> m;
+        if (with_mask) {
+            mask = test::make_memory(mask_md, eng);
+            args.insert({DNNL_ARG_ATTR_SRC_MASK, mask});
+            m.resize(mask_md.get_size() / sizeof(float));
+            auto m_ptr = map_memory<float>(mask);
+            for (size_t i = 0; i < m.size(); i++) {
+                m[i] = (i % 5 == 3) ? -10000.f : (i % 7 - 3) / 4.f;
+                m_ptr[i] = m[i];
+            }
+        }
+        {
+            auto s = map_memory<float>(src);
+            for (size_t i = 0; i < data_md.get_size() / sizeof(float); i++)
+                s[i] = (i % 13 - 6) / 2.f;
+        }
+
+        softmax_forward(pd).execute(strm, args);
+        strm.wait();
+
+        auto s = map_memory<float>(src);
+        auto d = map_memory<float>(dst);
+        const memory::dim H = c.dims[1], SQ = c.dims[2], S = c.dims[3];
+        const memory::dim rows = c.dims[0] * H * SQ;
+        std::vector<float> x(S);
+        for (memory::dim r = 0; r < rows; r++) {
+            memory::dim mask_off = 0;
+            if (with_mask) {
+                const memory::dim pos[3] = {r / (H * SQ), r / SQ % H, r % SQ};
+                for (int k = 0; k < 3; k++)
+                    mask_off = mask_off * c.mask_dims[k]
+                            + (c.mask_dims[k] == 1 ? 0 : pos[k]);
+                mask_off *= c.mask_dims[3];
+            }
+            const bool bcast_axis = with_mask && c.mask_dims[3] == 1;
+            float max = -FLT_MAX;
+            for (memory::dim i = 0; i < S; i++) {
+                x[i] = s[r * S + i] * c.prescale;
+                if (with_mask) x[i] += m[mask_off + (bcast_axis ? 0 : i)];
+                max = std::max(max, x[i]);
+            }
+            double sum = 0;
+            for (memory::dim i = 0; i < S; i++)
+                sum += std::exp(x[i] - max);
+            for (memory::dim i = 0; i < S; i++) {
+                const float ref = c.alg == algorithm::softmax_accurate
+                        ? std::exp(x[i] - max) / sum
+                        : x[i] - max - std::log(sum);
+                const float tol = 1e-5f * std::max(1.f, std::fabs(ref));
+                ASSERT_NEAR(d[r * S + i], ref, tol)
+                        << "at row " << r << " elem " << i;
+            }
+        }
+    }
+}
+
 } // namespace dnnl